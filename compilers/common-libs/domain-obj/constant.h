@@ -5,6 +5,14 @@ enum ReductionOperator	{       SUM, PRODUCT, MAX, MIN, MAX_ENTRY, MIN_ENTRY,
                                 LAND, LOR,                                              // logical reductions    
                                 BAND, BOR };                                            // bitwise reductions
 
+// a reduction can be turned into a parallel prefix scan; in that case each LPU gets either the reduction of the
+// contributions of all LPUs up to and including itself or those strictly preceding it
+enum ScanMode		{	NO_SCAN, INCLUSIVE_SCAN, EXCLUSIVE_SCAN };
+
+// the maximum number of indexes a parallel loop doing an index reduction (maxEntry, minEntry) can have; the result
+// of an index reduction holds one index entry for each index of the loop
+const int MAX_INDEX_REDUCTION_DIMENSIONS = 4;
+
 enum ArithmaticOperator {       ADD, SUBTRACT, MULTIPLY, DIVIDE, MODULUS, POWER,	// regular arithmatic
                                 LEFT_SHIFT, RIGHT_SHIFT,				// shift arithmatic
                                 BITWISE_AND, BITWISE_XOR, BITWISE_OR };			// bitwise arithmatic
@@ -10,11 +10,11 @@
 
 //------------------------------------------- Dimension -------------------------------------------------/
 
-int Dimension::getLength() {
+GlobalIndex Dimension::getLength() {
 	return abs(range.max - range.min) + 1;
 }
 
-void Dimension::setLength(int length) {
+void Dimension::setLength(GlobalIndex length) {
 	range.min = 0;
 	range.max = length - 1;	
 	this->length = length;
@@ -45,7 +45,7 @@ Range Dimension::adjustPositiveSubRange(Range positiveSubRange) {
 }
 
 Dimension Dimension::getNormalizedDimension() {
-	int length = getLength();
+	GlobalIndex length = getLength();
 	Range normalRange;
 	normalRange.min = 0;
 	normalRange.max = length - 1;
@@ -82,7 +82,7 @@ void PartDimension::print(std::ofstream &stream, int indentLevel) {
 	stream << std::endl;
 }
 
-bool PartDimension::isIncluded(int index) {
+bool PartDimension::isIncluded(GlobalIndex index) {
 	if (partition.range.min > partition.range.max) {
 		return index >= partition.range.max 
 				&& index <= partition.range.min;
@@ -92,20 +92,20 @@ bool PartDimension::isIncluded(int index) {
 	}
 }
 
-int PartDimension::adjustIndex(int index) {
+GlobalIndex PartDimension::adjustIndex(GlobalIndex index) {
 	if (partition.range.min > partition.range.max)
 		return partition.range.min - index;
 	else return index + partition.range.min;
 }
 
-int PartDimension::safeNormalizeIndex(int index, bool matchToMin) {
-	int normalIndex = index - partition.range.min;
-	int length = partition.getLength();	
+GlobalIndex PartDimension::safeNormalizeIndex(GlobalIndex index, bool matchToMin) {
+	GlobalIndex normalIndex = index - partition.range.min;
+	GlobalIndex length = partition.getLength();	
 	if (normalIndex >= 0 && normalIndex < length) return normalIndex;
 	return (matchToMin) ? 0 : length - 1;	
 }
 
-PartDimension PartDimension::getSubrange(int begin, int end) {
+PartDimension PartDimension::getSubrange(GlobalIndex begin, GlobalIndex end) {
 	PartDimension subDimension = PartDimension();
 	subDimension.storage = this->storage;
 	subDimension.partition.range.min = begin;
@@ -126,6 +126,9 @@ void PPU_Ids::print(std::ofstream &stream) {
 	stream << "\t\tGroup Id: " << groupId << std::endl;
 	stream << "\t\tGroup Size: " << groupSize << std::endl;
 	stream << "\t\tPPU Count: " << ppuCount << std::endl;
+	if (ppuWeights != NULL) {
+		stream << "\t\tPPU Weight: " << ppuWeights[groupId % weightCount] << std::endl;
+	}
 	if (id != INVALID_ID) {
 		stream << "\t\tId: " << id << std::endl;
 	}
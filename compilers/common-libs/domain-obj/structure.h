@@ -4,9 +4,30 @@
 #include <iostream>
 #include <fstream>
 #include <stdlib.h>
+#include <climits>
 
 #include "../utils/list.h"
 
+/* Type of the indexes of array dimensions. Indexes are 32-bit by default. Arrays having more than 2^31 elements along
+   any dimension, or in total, need 64-bit indexes; the mode is selected by defining LARGE_INDEX_SPACE in the build of
+   the generated program (see INDEX_MODE in the makefile of the executable). The index mode should be the same for all
+   segments of a program run as index ranges and interval descriptions are exchanged among them. The MPI datatype
+   macro should be used when indexes are communicated. */
+#ifdef LARGE_INDEX_SPACE
+typedef long int GlobalIndex;
+#define MPI_GLOBAL_INDEX MPI_LONG
+#else
+typedef int GlobalIndex;
+#define MPI_GLOBAL_INDEX MPI_INT
+#endif
+
+/* Type of the index offsets relative to the beginning of a data part along a dimension. Offsets stay 32-bit in both
+   index modes so that the index arithmetic in the inner loops of compute stages does not widen. The memory allocator
+   rejects any part having a dimension longer than the offset limit; hence a local offset is always safe. Note that
+   the linearized address of an element within a part is computed in 64-bit arithmetic regardless. */
+typedef int LocalOffset;
+#define LOCAL_OFFSET_LIMIT INT_MAX
+
 /* default invalid value for any LPU or PPU id */
 #define INVALID_ID -1
 
@@ -18,33 +39,33 @@
 
 class Range {
   public:
-	int min;
-	int max;
+	GlobalIndex min;
+	GlobalIndex max;
 	Range() {
         	min = 0;
         	max = 0;
         }
-        Range(int index) {
+        Range(GlobalIndex index) {
         	min = index;
         	max = index;
         }
-        Range(int min, int max) {
+        Range(GlobalIndex min, GlobalIndex max) {
         	this->min = min;
         	this->max = max;
         }
         bool isEqual(Range other) {
         	return (this->min == other.min && this->max == other.max);
         }
-	bool contains(int value) { return (min <= value && max >= value); }
+	bool contains(GlobalIndex value) { return (min <= value && max >= value); }
 };
 
 class Dimension {	
   public:
 	Range range;
-	int length; // for quick access to length information
+	GlobalIndex length; // for quick access to length information
 	
-	int getLength();
-	void setLength(int length);
+	GlobalIndex getLength();
+	void setLength(GlobalIndex length);
 	bool isIncreasing();
 	void setLength();
 
@@ -82,13 +103,13 @@ class PartDimension {
 		index = 0;
 		parent = NULL;
 	}
-	bool isIncluded(int index);	// This function is included only to save time in implementation of the 
+	bool isIncluded(GlobalIndex index);	// This function is included only to save time in implementation of the 
 					// prototype compiler. Ideally we should not have function calls for checking 
 					// if an index is included within a range; rather we should have boolean 
 					// expressions directly been applied in underlying context. TODO so we should 
 					// avoid using this function in our later optimized implementation.
 
-	int adjustIndex(int index);  	// This is again a time saving implementation of index adjustment when the
+	GlobalIndex adjustIndex(GlobalIndex index);  	// This is again a time saving implementation of index adjustment when the
 					// index under concern is generated from a representative range that starts 
 					// from 0 but the original range starts at some non-zero value. We have 
 					// such cases when some dimension reordering partition function in some LPS
@@ -97,21 +118,21 @@ class PartDimension {
 					// the reordering partition functions to take into account non-zero range 
 					// beginnings. 
 	
-	inline int normalizeIndex(int index) {
+	inline GlobalIndex normalizeIndex(GlobalIndex index) {
 		return index - partition.range.min;
 	}				// Similar to the above, this function is a time saving implementation for
 					// shifting index to be relative to the zero based, normalized, beginning 
 					// if order preserving partition functions are combined with reordering part-
 					// ition functions.
 
-	int safeNormalizeIndex(int index, bool matchToMin); // This function can be used when we are not sure if 
+	GlobalIndex safeNormalizeIndex(GlobalIndex index, bool matchToMin); // This function can be used when we are not sure if 
 					// the compared index is inside an LPU partition range. When such uncertain
 					// transformation is made, we need to ensure that invalid use of the normalized
 					// index has not been made. To safeguard against invalid index transformation
 					// we should use this function during normalization and specified what value
 					// to choose among the min and max as the normalized safety value.
 
-	PartDimension getSubrange(int begin, int end); // This function generate a new part-dimension object that 
+	PartDimension getSubrange(GlobalIndex begin, GlobalIndex end); // This function generate a new part-dimension object that 
 					// represent a sub-range of the current object. The storage dimension is copied
 					// as it is and the new partition dimension is determined from the arguments. 
 
@@ -141,7 +162,12 @@ class PPU_Ids {
 	int groupSize;		// sometimes used for setting up synchronization parameters appropriately
 		      		// this represents the total number of leaf level PPUs under the hierarchy
 		      		// rooted in PPU of this PPS
+	const int *ppuWeights;	// relative throughput weights of sibling PPUs when they are not equally
+				// capable; the weight of the PPU group at index i is found at index
+				// (i % weightCount); it is NULL for symmetric spaces
+	int weightCount;
 
+	PPU_Ids() { ppuWeights = NULL; weightCount = 0; }
 	void print(std::ofstream &stream);			
 };
 
@@ -172,6 +198,7 @@ class LPU {
         bool valid;
 
         LPU() { id = 0; valid = false; }
+        virtual ~LPU() {}
         void setId(int id) { this->id = id; }
         void setValidBit(bool valid) { this->valid = valid; }
         bool isValid() { return valid; }
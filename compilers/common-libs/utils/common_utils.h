@@ -10,16 +10,18 @@ inline int min(int x, int y) { return x < y ? x : y; }
 
 inline int max(int x, int y) { return x > y ? x : y; }
 
-inline int gcd(int a, int b) {
-	while (a != b) {
-		if (a > b) a = a - b;
-		else b = b - a;
+inline long int gcd(long int a, long int b) {
+	while (b != 0) {
+		long int remainder = a % b;
+		a = b;
+		b = remainder;
 	}
 	return a;
 }
 
-inline int lcm(int a, int b) {
-	return (a * b) / gcd(a, b);
+// the product is divided before the multiplication so that the result does not overflow when the LCM itself fits
+inline long int lcm(long int a, long int b) {
+	return (a / gcd(a, b)) * b;
 }
 
 inline int countDigits (int n) {
@@ -27,7 +27,7 @@ void DrawingLine::reset() {
 	for (int i = 0; i < dim.length; i++) line->Append(EXCLUSION_CHAR);
 }
 
-void DrawingLine::setIndexToOne(int index) {
+void DrawingLine::setIndexToOne(GlobalIndex index) {
 	int positionOfUpdate = index - dim.range.min;
 	line->RemoveAt(positionOfUpdate);
 	line->InsertAt(INCLUSION_CHAR, positionOfUpdate);
@@ -89,7 +89,7 @@ void DrawingLine::draw(int indentation, std::ostream &stream) {
 
 //--------------------------------------------------------- 1D Interval Sequence --------------------------------------------------------/
 
-IntervalSeq::IntervalSeq(int b, int l, int p, int c) {
+IntervalSeq::IntervalSeq(GlobalIndex b, GlobalIndex l, GlobalIndex p, GlobalIndex c) {
 	begin = b;
 	length = l;
 	period = p;
@@ -97,10 +97,10 @@ IntervalSeq::IntervalSeq(int b, int l, int p, int c) {
 }
 
 void IntervalSeq::draw(DrawingLine *drawingLine) {
-	for (int interval = 0; interval < count; interval++) {
-		int intervalBegin = begin + period * interval;
-		int intervalEnd = intervalBegin + length - 1;
-		for (int position = intervalBegin; position <= intervalEnd; position++) {
+	for (GlobalIndex interval = 0; interval < count; interval++) {
+		GlobalIndex intervalBegin = begin + period * interval;
+		GlobalIndex intervalEnd = intervalBegin + length - 1;
+		for (GlobalIndex position = intervalBegin; position <= intervalEnd; position++) {
 			drawingLine->setIndexToOne(position);
 		}
 	}
@@ -112,17 +112,17 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 	if (subInterval->count == 1) {
 
 		List<IntervalSeq*> *intervalList = new List<IntervalSeq*>;
-		int elementsToCover = subInterval->length;
-		int currentSubHead = subInterval->begin;
+		GlobalIndex elementsToCover = subInterval->length;
+		GlobalIndex currentSubHead = subInterval->begin;
 
 		// find the drift of the sub-interval beginning from the beginning of any iteration of the current interval
-		int frontDrift = subInterval->begin % this->length;
+		GlobalIndex frontDrift = subInterval->begin % this->length;
 		// if there is a front drift then add a partial iteration of the current sequence in the interval list
 		if (frontDrift > 0) {
 			// the end of the partial sub-iteration happens at the end of the overlapped iteration of this sequence
 			// or at the end of the sub-interval, whichever comes earlier
-			int partIterLength = std::min(this->length - frontDrift, subInterval->length);
-			int pieceBegin = this->begin + (currentSubHead / this->length) * this->period + frontDrift;
+			GlobalIndex partIterLength = std::min(this->length - frontDrift, subInterval->length);
+			GlobalIndex pieceBegin = this->begin + (currentSubHead / this->length) * this->period + frontDrift;
 			IntervalSeq *partialIteration = new IntervalSeq(pieceBegin, partIterLength, partIterLength, 1);
 			intervalList->Append(partialIteration);
 			currentSubHead += partIterLength;
@@ -131,9 +131,9 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 
 		// then we check how many full iterations of the current sequence can happen for the spread of the remaining
 		// portion of the subinterval
-		int fullIterations = elementsToCover / this->length;
+		GlobalIndex fullIterations = elementsToCover / this->length;
 		if (fullIterations > 0) {
-			int pieceBegin = this->begin + (currentSubHead / this->length) * this->period;
+			GlobalIndex pieceBegin = this->begin + (currentSubHead / this->length) * this->period;
 			IntervalSeq *fullIterSequence = new IntervalSeq(pieceBegin, length, period, fullIterations);
 			intervalList->Append(fullIterSequence);
 			currentSubHead += fullIterations * length;
@@ -143,7 +143,7 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 		// finally, we add any remaining entries from the sub-interval as an incomplete partial iteration of the
 		// current sequence
 		if (elementsToCover > 0) {
-			int pieceBegin = this->begin + (currentSubHead / this->length) * this->period;
+			GlobalIndex pieceBegin = this->begin + (currentSubHead / this->length) * this->period;
 			IntervalSeq *partialIteration = new IntervalSeq(pieceBegin, elementsToCover, elementsToCover, 1);
 			intervalList->Append(partialIteration);
 		}
@@ -154,20 +154,20 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 	// interval of the current sequence; we stop as we identify a re-occurrence of an existing piece; then we generate
 	// a set of interval sequences for the sub-interval by determining how many times a single piece can appear
 	List<Range> *uniqueRangeList = new List<Range>;
-	List<int> *uniqueIntervalBeginnings = new List<int>;
+	List<GlobalIndex> *uniqueIntervalBeginnings = new List<GlobalIndex>;
 
-	int subLineSpanEnd = subInterval->begin + (subInterval->count - 1) * subInterval->period
+	GlobalIndex subLineSpanEnd = subInterval->begin + (subInterval->count - 1) * subInterval->period
 			+ subInterval->length - 1;
-	int subIntervalEndingIndex = this->begin + (subLineSpanEnd / this->length) * this->period
+	GlobalIndex subIntervalEndingIndex = this->begin + (subLineSpanEnd / this->length) * this->period
 			+ subLineSpanEnd % this->length;
-	int piecePeriod = subIntervalEndingIndex + 1;
+	GlobalIndex piecePeriod = subIntervalEndingIndex + 1;
 
 	// iterate over the intervals of the sub-sequence
-	for (int i = 0; i < subInterval->count; i++) {
+	for (GlobalIndex i = 0; i < subInterval->count; i++) {
 
 		// determine where in the current sequence's iteration the beginning of the iteration of the sub-sequence lies
-		int localBegin = subInterval->begin + subInterval->period * i;
-		int parentBegin = localBegin % this->length;
+		GlobalIndex localBegin = subInterval->begin + subInterval->period * i;
+		GlobalIndex parentBegin = localBegin % this->length;
 
 		// if the beginning of this piece has been observed before than there are no more new pieces to consider and we
 		// should determine the period to be used for the pieces found so far.
@@ -180,10 +180,10 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 		}
 		// the period is the distance from the first piece to the current piece
 		if (alreadyObserved) {
-			int firstOccurance = uniqueRangeList->Nth(0).min;
-			int firstHolderBlock = firstOccurance / this->length;
-			int currentHolderBlock = localBegin / this->length;
-			int blockAdvance = (currentHolderBlock - firstHolderBlock);
+			GlobalIndex firstOccurance = uniqueRangeList->Nth(0).min;
+			GlobalIndex firstHolderBlock = firstOccurance / this->length;
+			GlobalIndex currentHolderBlock = localBegin / this->length;
+			GlobalIndex blockAdvance = (currentHolderBlock - firstHolderBlock);
 			piecePeriod = blockAdvance * this->period;
 			break;
 		}
@@ -193,11 +193,11 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 
 		// in case one iteration of the sub-sequence is larger than that of the current sequence, there will be several
 		// broken pieces for the current sub-sequence iteration; we record all of that
-		int rangeMin = localBegin;
-		int lengthYetToCover = subInterval->length;
+		GlobalIndex rangeMin = localBegin;
+		GlobalIndex lengthYetToCover = subInterval->length;
 		while (lengthYetToCover > 0) {
-			int remainingInCurrentInterval = this->length - parentBegin;
-			int subLength = min(remainingInCurrentInterval, lengthYetToCover);
+			GlobalIndex remainingInCurrentInterval = this->length - parentBegin;
+			GlobalIndex subLength = min(remainingInCurrentInterval, lengthYetToCover);
 			Range range;
 			range.min = rangeMin;
 			range.max = rangeMin + subLength - 1;
@@ -212,11 +212,11 @@ List<IntervalSeq*> *IntervalSeq::transformSubInterval(IntervalSeq *subInterval)
 	List<IntervalSeq*> *intervalList = new List<IntervalSeq*>;
 	for (int i = 0; i < uniqueRangeList->NumElements(); i++) {
 		Range range = uniqueRangeList->Nth(i);
-		int pieceBegin = this->begin + (range.min / this->length) * this->period
+		GlobalIndex pieceBegin = this->begin + (range.min / this->length) * this->period
 				+ range.min % this->length;
-		int pieceCount = ((subIntervalEndingIndex - pieceBegin + 1)
+		GlobalIndex pieceCount = ((subIntervalEndingIndex - pieceBegin + 1)
 				+ piecePeriod - 1) / piecePeriod;
-		int pieceLength = range.max - range.min + 1;
+		GlobalIndex pieceLength = range.max - range.min + 1;
 
 		// if there is just one iteration of the current piece then adjust the piece-period to piece-length that may
 		// simplify future calculations involving this sequence
@@ -243,27 +243,27 @@ List<IntervalSeq*> *IntervalSeq::computeIntersection(IntervalSeq *other) {
 	if (other->count == 1) { first = other; second = this; }
 
 	// declare short-hand variables for interval properties
-	int c1 = first->count;
-	int c2 = second->count;
-	int p1 = first->period;
-	int p2 = second->period;
-	int l1 = first->length;
-	int l2 = second->length;
-	int b1 = first->begin;
-	int b2 = second->begin;
+	GlobalIndex c1 = first->count;
+	GlobalIndex c2 = second->count;
+	GlobalIndex p1 = first->period;
+	GlobalIndex p2 = second->period;
+	GlobalIndex l1 = first->length;
+	GlobalIndex l2 = second->length;
+	GlobalIndex b1 = first->begin;
+	GlobalIndex b2 = second->begin;
 
 	// find the ending index for both intervals
-	int e1 = b1 + p1 * (c1 - 1) + l1 - 1;
-	int e2 = b2 + p2 * (c2 - 1) + l2 - 1;
+	GlobalIndex e1 = b1 + p1 * (c1 - 1) + l1 - 1;
+	GlobalIndex e2 = b2 + p2 * (c2 - 1) + l2 - 1;
 
 	// one interval begins after the other ends then there is no intersection
 	if (b1 > e2 || b2 > e1) return NULL;
 
 	// skip iterations from one sequence that finishes before the beginning of the other
-	int i1 = (b2 >= (b1 + l1)) ? (b2 - b1) / p1 : 0;
-	int i2 = (b1 >= (b2 + l2)) ? (b1 - b2) / p2 : 0;
-	int bi1 = i1 * p1 + b1;
-	int bi2 = i2 * p2 + b2;
+	GlobalIndex i1 = (b2 >= (b1 + l1)) ? (b2 - b1) / p1 : 0;
+	GlobalIndex i2 = (b1 >= (b2 + l2)) ? (b1 - b2) / p2 : 0;
+	GlobalIndex bi1 = i1 * p1 + b1;
+	GlobalIndex bi2 = i2 * p2 + b2;
 	if (b2 >= bi1 + l1) {
 		bi1 += p1;
 		i1++;
@@ -274,7 +274,7 @@ List<IntervalSeq*> *IntervalSeq::computeIntersection(IntervalSeq *other) {
 
 	// if the two periods are the same and one is drifted from the other by a sufficient margin then the
 	// two interval sequences never intersect
-	int drift = abs(bi1 - bi2);
+	GlobalIndex drift = abs(bi1 - bi2);
 	if ((p1 == p2)
 			&& ((bi1 > bi2 && l2 < drift)
 					|| (bi2 > bi1 && l1 < drift))) return NULL;
@@ -284,29 +284,29 @@ List<IntervalSeq*> *IntervalSeq::computeIntersection(IntervalSeq *other) {
 
 		// describe the partial overlapping between the two interval beginnings, if exists
 		if (bi2 < bi1 && bi2 + l2 > bi1) {
-			int overlapLength = min(bi2 + l2, bi1 + l1) - bi1;
+			GlobalIndex overlapLength = min(bi2 + l2, bi1 + l1) - bi1;
 			IntervalSeq *startingOverlap = new IntervalSeq(bi1, overlapLength, overlapLength, 1);
 			intersect->Append(startingOverlap);
 		}
 
 		// describe iterations of the second sequence that complete within the confinement of the first
-		int fullIntervalStart = (bi2 >= bi1) ? i2 : i2 + 1;
-		int fullIntervalEnd = min((int) floor((e1 - (b2 + l2 - 1)) * 1.0 / p2), c2 - 1);
-		int intervalCount = max(fullIntervalEnd - fullIntervalStart + 1, 0);
+		GlobalIndex fullIntervalStart = (bi2 >= bi1) ? i2 : i2 + 1;
+		GlobalIndex fullIntervalEnd = min((GlobalIndex) floor((e1 - (b2 + l2 - 1)) * 1.0 / p2), c2 - 1);
+		GlobalIndex intervalCount = max(fullIntervalEnd - fullIntervalStart + 1, (GlobalIndex) 0);
 		if (intervalCount > 0) {
-			int begin = fullIntervalStart * p2 + b2;
+			GlobalIndex begin = fullIntervalStart * p2 + b2;
 			IntervalSeq *fullIterations = new IntervalSeq(begin, l2, p2, intervalCount);
 			intersect->Append(fullIterations);
 		}
 
 		// describe the partial overlapping between the ending of the first one with some iteration
 		// of the second, if exists
-		int endIntervalNo = (e1 - b2) / p2;
-		int endIntervalBegin = endIntervalNo * p2 + b2;
+		GlobalIndex endIntervalNo = (e1 - b2) / p2;
+		GlobalIndex endIntervalBegin = endIntervalNo * p2 + b2;
 		if (endIntervalNo < c2
                 		&& endIntervalBegin >= b1 && endIntervalBegin <= e1
                 		&& endIntervalBegin + l2 - 1 > e1) {
-			int overlapLength = e1 - max(b1, endIntervalBegin) + 1;
+			GlobalIndex overlapLength = e1 - max(b1, endIntervalBegin) + 1;
 			IntervalSeq *endingOverlap = new IntervalSeq(endIntervalBegin,
 					overlapLength, overlapLength, 1);
 			intersect->Append(endingOverlap);
@@ -322,18 +322,18 @@ List<IntervalSeq*> *IntervalSeq::computeIntersection(IntervalSeq *other) {
 	// after LCM number of iterations the drift between the beginnings of the next intervals of the
 	// two sequences will be the same; so the intersection calculation algorithm needs to consider
 	// only those intervals that may appear within the LCM
-	int LCM = lcm(p1, p2);
-	int c1L = LCM / p1;
-	int c2L = LCM / p2;
+	GlobalIndex LCM = lcm(p1, p2);
+	GlobalIndex c1L = LCM / p1;
+	GlobalIndex c2L = LCM / p2;
 
 	// we need to keep track of the intersecting ranges to later from sequences
 	List<Range> *ranges = new List<Range>;
 
 	// initiate counters and interval starting indexes for overlapping range detection process
-	int b1i = bi1;
-	int ci1 = 0;
-	int b2i = bi2;
-	int ci2 = 0;
+	GlobalIndex b1i = bi1;
+	GlobalIndex ci1 = 0;
+	GlobalIndex b2i = bi2;
+	GlobalIndex ci2 = 0;
 
 	while (ci1 < c1L || ci2 < c2L) {
 		// record any possible overlapping in current iterations
@@ -358,15 +358,15 @@ List<IntervalSeq*> *IntervalSeq::computeIntersection(IntervalSeq *other) {
 
 	// generate interval sequences from the range list by determining how many time an overlapping
 	// range can appear before the first interval sequence ends
-	int earlierEnding = min(e1, e2);
-	int period = LCM;
+	GlobalIndex earlierEnding = min(e1, e2);
+	GlobalIndex period = LCM;
 	for (int i = 0; i < ranges->NumElements(); i++) {
 		Range range = ranges->Nth(i);
-		int begin = range.min;
-		int length = range.max - range.min + 1;
-		int count = (earlierEnding - range.max) / period + 1;
+		GlobalIndex begin = range.min;
+		GlobalIndex length = range.max - range.min + 1;
+		GlobalIndex count = (earlierEnding - range.max) / period + 1;
 		if (count > 0) {
-			int partPeriod = (count == 1) ? length : period;
+			GlobalIndex partPeriod = (count == 1) ? length : period;
 			IntervalSeq *interval = new IntervalSeq(begin, length, partPeriod, count);
 			intersect->Append(interval);
 		}
@@ -379,10 +379,10 @@ List<IntervalSeq*> *IntervalSeq::computeIntersection(IntervalSeq *other) {
 	return intersect;
 }
 
-int IntervalSeq::getNextIndex(IntervalState *state) {
+GlobalIndex IntervalSeq::getNextIndex(IntervalState *state) {
 
-	int interval = state->getIteration();
-	int index = state->getIndex();
+	GlobalIndex interval = state->getIteration();
+	GlobalIndex index = state->getIndex();
 
 	if (index < length - 1) {
 		state->step();
@@ -407,12 +407,12 @@ bool IntervalSeq::isEqual(IntervalSeq *other) {
 			&& this->count 	== other->count);
 }
 
-bool IntervalSeq::contains(int point) {
+bool IntervalSeq::contains(GlobalIndex point) {
 	if (point < begin) return false;
-	int interval = (point - begin) / period;
+	GlobalIndex interval = (point - begin) / period;
 	if (count <= interval) return false;
-	int intervalBegin = interval * period + begin;
-	int intervalEnd = intervalBegin + length - 1;
+	GlobalIndex intervalBegin = interval * period + begin;
+	GlobalIndex intervalEnd = intervalBegin + length - 1;
 	return (intervalBegin <= point) && (point <= intervalEnd);
 }
 
@@ -428,10 +428,10 @@ char *IntervalSeq::toString() {
 IntervalSeq *IntervalSeq::fromString(std::string desc) {
 	string delim("|");
 	List<string> *elems = string_utils::tokenizeString(desc, delim);
-	int b = atoi(elems->Nth(0).c_str());
-	int l = atoi(elems->Nth(1).c_str());
-	int p = atoi(elems->Nth(2).c_str());
-	int c = atoi(elems->Nth(3).c_str());
+	GlobalIndex b = atol(elems->Nth(0).c_str());
+	GlobalIndex l = atol(elems->Nth(1).c_str());
+	GlobalIndex p = atol(elems->Nth(2).c_str());
+	GlobalIndex c = atol(elems->Nth(3).c_str());
 	delete elems;
 	return new IntervalSeq(b, l, p, c);
 }
@@ -563,8 +563,8 @@ void MultidimensionalIntervalSeq::draw(int indentation, std::ostream &stream) {
 	for (int i = 0; i < dimensionality; i++) {
 		
 		IntervalSeq *interval = intervals[i];
-		int begin = 0;
-		int end = interval->begin + interval->period * interval->count;
+		GlobalIndex begin = 0;
+		GlobalIndex end = interval->begin + interval->period * interval->count;
 		Dimension dim = Dimension();
 		dim.range.min = begin;
 		dim.range.max = end;
@@ -577,10 +577,10 @@ void MultidimensionalIntervalSeq::draw(int indentation, std::ostream &stream) {
 	}
 }
 
-bool MultidimensionalIntervalSeq::contains(List<int> *point) {
+bool MultidimensionalIntervalSeq::contains(List<GlobalIndex> *point) {
 	for (int i = 0; i < dimensionality; i++) {
 		IntervalSeq *dimensionalSeq = intervals[i];
-		int indexAlongDimension = point->Nth(i);
+		GlobalIndex indexAlongDimension = point->Nth(i);
 		if (!dimensionalSeq->contains(indexAlongDimension)) return false;
 	}
 	return true;
@@ -654,7 +654,7 @@ bool MultidimensionalIntervalSeq::areSetsEqual(List<MultidimensionalIntervalSeq*
 SequenceIterator::SequenceIterator(MultidimensionalIntervalSeq *sequence) {
 	this->sequence = sequence;
 	dimensionality = sequence->getDimensionality();
-	index = new vector<int>;
+	index = new vector<GlobalIndex>;
 	index->reserve(dimensionality);
 	elementCount = sequence->getNumOfElements();
 	currentElementNo = 0;
@@ -669,11 +669,11 @@ SequenceIterator::~SequenceIterator() {
 	delete index;
 }
 
-vector<int> *SequenceIterator::getNextElement() {
+vector<GlobalIndex> *SequenceIterator::getNextElement() {
 
 	int lastDim = dimensionality - 1;
 	IntervalSeq *lastLinearSeq = sequence->getIntervalForDim(lastDim);
-	int lastDimIndex = lastLinearSeq->getNextIndex(cursors.top());
+	GlobalIndex lastDimIndex = lastLinearSeq->getNextIndex(cursors.top());
 	index->at(lastDim) = lastDimIndex;
 
 	if (lastDimIndex == INVALID_INDEX) {
@@ -698,7 +698,7 @@ vector<int> *SequenceIterator::getNextElement() {
 			// try to move further on an earlier dimension
 			int dimNo = cursors.size() - 1;
 			IntervalSeq *linearSeq = sequence->getIntervalForDim(dimNo);
-			int dimIndex = linearSeq->getNextIndex(cursors.top());
+			GlobalIndex dimIndex = linearSeq->getNextIndex(cursors.top());
 
 			if (dimIndex != INVALID_INDEX) {
 				index->at(dimNo) = dimIndex;
@@ -727,7 +727,7 @@ void SequenceIterator::reset() {
 }
 
 void SequenceIterator::printNextElement(std::ostream &stream) {
-	vector<int> *element = getNextElement();
+	vector<GlobalIndex> *element = getNextElement();
 	for (int i = 0; i < dimensionality; i++) {
 		stream << element->at(i);
 		if (i < dimensionality - 1) {
@@ -25,7 +25,7 @@ static const char INCLUSION_CHAR = '|';
 static const char EXCLUSION_CHAR = '_';
 
 // constant to indicate that the index point returned for an interval sequence is invalid
-static const int INVALID_INDEX = INT_MIN;
+static const GlobalIndex INVALID_INDEX = INT_MIN;
 
 /* A supporting class to be used to visualize an interval sequence
  * */
@@ -40,7 +40,7 @@ class DrawingLine {
 	List<char> *line;
   public:
 	DrawingLine(Dimension dim, int labelGap);
-	void setIndexToOne(int index);
+	void setIndexToOne(GlobalIndex index);
 	void draw();
 	void draw(int indentation, std::ostream &stream);
 
@@ -53,16 +53,16 @@ class DrawingLine {
 class IntervalSeq {
   public:
 	// the starting point of the first interval in the sequence
-	int begin;
+	GlobalIndex begin;
 	// the length within a period the interval is 1
-	int length;
+	GlobalIndex length;
 	// the period of the interval sequence
-	int period;
+	GlobalIndex period;
 	// the number of interval in the sequence
-	int count;
+	GlobalIndex count;
   public:
-	IntervalSeq(int b, int l, int p, int c);
-	void increaseCount(int amount) {
+	IntervalSeq(GlobalIndex b, GlobalIndex l, GlobalIndex p, GlobalIndex c);
+	void increaseCount(GlobalIndex amount) {
 		count += amount;
 	}
 	void draw(DrawingLine *drawingLine);
@@ -84,18 +84,18 @@ class IntervalSeq {
 	List<IntervalSeq*> *computeIntersection(IntervalSeq *other);
 
 	// returns the total number of 1's included in the interval sequence
-	int getNumOfElements() { return length * count; }
+	long int getNumOfElements() { return ((long int) length) * count; }
 
 	/* returns the next index in the sequence based on the current state of the interval sequence traversal cursor; it
 	 * also updates the state cursor passed as argument; if the end of the sequence has been reached, it resets the
 	 * cursor and returns an invalid-index
 	 * */
-	int getNextIndex(IntervalState *state);
+	GlobalIndex getNextIndex(IntervalState *state);
 
 	bool isEqual(IntervalSeq *other);
 
 	// returns true if the interval sequence contains the point; otherwise returns false
-	bool contains(int point);
+	bool contains(GlobalIndex point);
 
 	// three functions for conversion between an interval sequence and its character string representation; the string
 	// representation is needed to transfer the interval description over the network
@@ -135,7 +135,7 @@ class MultidimensionalIntervalSeq {
 	int compareTo(MultidimensionalIntervalSeq *other);
 
 	// returns true if the interval sequence contains the multidimensional point; otherwise returns false
-	bool contains(List<int> *point);
+	bool contains(List<GlobalIndex> *point);
 
 	// function to generate a list of multidimensional interval sequences as a cross-product of lists of one-
 	// dimensional interval sequences
@@ -169,15 +169,15 @@ class MultidimensionalIntervalSeq {
  * */
 class IntervalState {
   private:
-	int iteration;
-	int index;
+	GlobalIndex iteration;
+	GlobalIndex index;
   public:
 	// index is initialized to -1 as the cursor will be used as a next pointer that moves the index to 0th position
 	// at the beginning of the sequence access
 	IntervalState() { iteration = 0; index = -1; }
-	inline int getIteration() { return iteration; }
+	inline GlobalIndex getIteration() { return iteration; }
 	inline void jumpToNextIteration() { iteration++; index = 0; }
-	inline int getIndex() { return index; }
+	inline GlobalIndex getIndex() { return index; }
 	inline void step() { index++; }
 	inline void reset() { iteration = 0; index = -1; }
 };
@@ -187,7 +187,7 @@ class IntervalState {
  * */
 class SequenceIterator {
   private:
-	std::vector<int> *index;
+	std::vector<GlobalIndex> *index;
 	int dimensionality;
 	MultidimensionalIntervalSeq *sequence;
 	std::stack<IntervalState*> cursors;
@@ -199,7 +199,7 @@ class SequenceIterator {
 	bool hasMoreElements() { return currentElementNo < elementCount; }
 
 	// returns the next index element in the sequence; it returns NULL if there are no more elements and reset its state
-	std::vector<int> *getNextElement();
+	std::vector<GlobalIndex> *getNextElement();
 
 	void reset();
 	void printNextElement(std::ostream &stream);
@@ -130,7 +130,7 @@ void yyerror(const char *msg); // standard error-handling routine
 /* epoch version access token */
 %token Current
 /* expression and statement related tokens */
-%token If Else Range Local Index Do Sequence Reduce Return
+%token If Else Range Local Index Do Sequence Reduce Scan Return
 /* extern code block importing tokens */
 %token Extern Language Header_Includes Library_Links
 /* environment linkage type tokens */
@@ -426,6 +426,14 @@ stmt		: parallel_loop
 return_stmt	: Return expr					{ $$ = new ReturnStmt($2, Join(@1, @2)); };
 reduction	: Reduce '(' Variable_Name 
 			',' String ',' expr ')'          	{ $$ = new ReductionStmt(new Identifier(@3, $3), $5, $7, Join(@1, @8)); }	
+		| Scan '(' Variable_Name
+			',' String ',' expr ')'			{ ReductionStmt *scan = new ReductionStmt(new Identifier(@3, $3), $5, $7, Join(@1, @8));
+								  scan->setScanMode("inclusive", @1);
+								  $$ = scan; }
+		| Scan '(' Variable_Name
+			',' String ',' expr ',' String ')'	{ ReductionStmt *scan = new ReductionStmt(new Identifier(@3, $3), $5, $7, Join(@1, @10));
+								  scan->setScanMode($9, @9);
+								  $$ = scan; };
 sequencial_loop : Do In Sequence '{' stmt_block '}'
                 For id In sloop_attr                            { $$ = new SLoopStmt($8, $10, new StmtBlock($5), @1); };
 sloop_attr      : field step_expr                               { $$ = new SLoopAttribute($1, $2, NULL); }
@@ -61,10 +61,15 @@ void ArrayAccess::translate(std::ostringstream &stream, int indentLevel, int cur
 void ArrayAccess::generateXformedIndex(std::ostringstream &stream, int indentLevel,
 		const char *indexExpr,
 		const char *arrayName, int dimensionNo, Space *space) {}
+bool ArrayAccess::isSoaLayoutElementAccess() { return false; }
+void ArrayAccess::translateSoaFieldAccess(std::ostringstream &stream, int indentLevel,
+		const char *fieldName, Space *space) {}
 
 void FunctionCall::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {}
 
 void TaskInvocation::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
+void TaskInvocation::generateConcurrentLaunch(std::ostringstream &stream, 
+		int indentLevel, Space *space, List<TaskInvocation*> *invocations) {}
 
 void NamedArgument::generateAssignment(Expr *object, std::ostringstream &stream, int indentLevel) {}
 
@@ -4,6 +4,7 @@
 
 void Root::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {}
 void Random::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {}
+void Scatter::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {}
 
 void LoadArray::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
 void StoreArray::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
@@ -10,6 +10,7 @@ void StmtBlock::generateCode(std::ostringstream &stream, int indentLevel, Space
 void ConditionalStmt::generateCode(std::ostringstream &stream, int indentLevel, bool first, Space *space) {}
 void IfStmt::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
 void PLoopStmt::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
+bool PLoopStmt::generateMatrixMultiplyCall(std::ostringstream &stream, int indentLevel, Space *space) { return false; }
 void SLoopStmt::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
 void WhileStmt::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
 void ReductionStmt::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {}
@@ -26,6 +26,9 @@ void RepeatControlBlock::generateInvocationCode(std::ofstream &stream, int inden
 void ConditionalExecutionBlock::generateInvocationCode(std::ofstream &stream, int indentation, Space *containerSpace) {}
 
 void LpsTransitionBlock::genReductionResultPreprocessingCode(std::ofstream &stream, int indentation) {}
+void LpsTransitionBlock::genScanCompletionCode(std::ofstream &stream, int indentation) {}
+void LpsTransitionBlock::genScatterCompletionCode(std::ofstream &stream, int indentation) {}
+RangeExpr *LpsTransitionBlock::getIndexOwnerCondition(Space *containerSpace) { return NULL; }
 void LpsTransitionBlock::generateInvocationCode(std::ofstream &stream, int indentation, Space *containerSpace) {}
 
 void EpochBoundaryBlock::genCodeForScalarVarEpochUpdates(std::ofstream &stream, 
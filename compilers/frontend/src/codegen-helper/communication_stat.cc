@@ -28,6 +28,7 @@ CommunicationCharacteristics::CommunicationCharacteristics(const char *varName)
 	waitSignalMayDifferFromSyncLpses = false;
 	signalerSpace = NULL;
 	waitingSpace = NULL;
+	batchedComms = new List<CommunicationCharacteristics*>;
 }
 
 void CommunicationCharacteristics::setSyncRequirement(SyncRequirement *syncRequirement) {
@@ -42,6 +42,11 @@ class CommunicationCharacteristics {
 	bool waitSignalMayDifferFromSyncLpses;
 	Space *signalerSpace;
 	Space *waitingSpace;
+
+	// Synchronizations of several scalar variables that happen for the same pair of updater and waiting stages can
+	// be done with a single message. Then the characteristics of the first of those synchronizations holds the rest
+	// in this list and no separate communication is done for the latter.
+	List<CommunicationCharacteristics*> *batchedComms;
   public:
 	CommunicationCharacteristics(const char *varName);
 	const char *getVarName() { return varName; }
@@ -70,6 +75,8 @@ class CommunicationCharacteristics {
 	Space *getSignalerSpace() { return signalerSpace; }
 	void setWaitingSpace(Space *waitingSpace) { this->waitingSpace = waitingSpace; } 
 	Space *getWaitingSpace() { return waitingSpace; }
+	void addBatchedComm(CommunicationCharacteristics *other) { batchedComms->Append(other); }
+	List<CommunicationCharacteristics*> *getBatchedComms() { return batchedComms; }
 	
 	// indicates if the underlying communication mechanism implementing the characteristics specified here
 	// can be benefited from allocating group resources (for example, the groups of segments interacting 
@@ -1,4 +1,5 @@
 #include "errors.h"
+#include "constant.h"
 #include <iostream>
 #include <sstream>
 #include <stdarg.h>
@@ -258,7 +259,27 @@ void ReportError::ReductionOutsideForLoop(yyltype *loc, bool suppressFailure) {
 }
 
 void ReportError::IndexReductionOnMultiIndexLoop(yyltype *loc, bool suppressFailure) {
-	OptionalErrorReport(loc, suppressFailure, "Currently multi-dimensional indexes are not supported for index based reductions");
+	OptionalErrorReport(loc, suppressFailure, 
+			"index based reductions are supported in loops of at most %d indexes", MAX_INDEX_REDUCTION_DIMENSIONS);
+}
+
+void ReportError::UnknownScanMode(yyltype *loc, const char *modeName, bool suppressFailure) {
+	OptionalErrorReport(loc, suppressFailure, 
+			"unknown scan mode '%s'; a scan can only be \"inclusive\" or \"exclusive\"", modeName);
+}
+
+void ReportError::IndexReductionInScan(yyltype *loc, bool suppressFailure) {
+	OptionalErrorReport(loc, suppressFailure, "index based reductions cannot be used in a scan");
+}
+
+void ReportError::UnsupportedScatterTarget(yyltype *loc, Type *actualType, bool suppressFailure) {
+	OptionalErrorReport(loc, suppressFailure, 
+			"scatter target of type '%s' is not a one-dimensional array", actualType->getName());
+}
+
+void ReportError::ScatterOnReorderedArray(yyltype *loc, const char *arrayName, const char *spaceName, bool suppressFailure) {
+	OptionalErrorReport(loc, suppressFailure, 
+			"scatter target '%s' is partitioned by an index reordering function in Space %s", arrayName, spaceName);
 }
 
 void ReportError::InvalidReductionRange(yyltype *loc, const char *executingLps, const char *rootLps, bool suppressFailure) {
@@ -279,6 +300,12 @@ void ReportError::ReductionVarUsedBeforeReady(yyltype *loc, const char *rdVar, c
                         rdVar, rootLps);
 }
 
+void ReportError::InvalidScanRange(yyltype *loc, const char *rdVar, const char *rootLps, bool suppressFailure) {
+	OptionalErrorReport(loc, suppressFailure,
+                        "scan of variable '%s' should span a partitioned Space right below the root Space, not Space %s",
+                        rdVar, rootLps);
+}
+
 void ReportError::NotAnEnvironment(yyltype *loc, Type *type, bool suppressFailure) {
 	OptionalErrorReport(loc, suppressFailure, "'%s' is not an environment type", type->getName());
 }
@@ -431,6 +458,16 @@ void ReportError::PaddingArgumentsNotSupported(yyltype *loc, const char *functio
 	Formatted(loc, "Partition function %s does not support padding arguments", functionName);
 }
 
+void ReportError::InvalidPartitionWeights(yyltype *loc, const char *functionName) {
+	Formatted(loc, "Partition function %s needs a block count followed by a weight array for each partitioned dimension", 
+			functionName);
+}
+
+void ReportError::InvalidPartitionWeightArray(Identifier *id) {
+	Formatted(id->GetLocation(), "Weight array '%s' must be a one dimensional integer array of the task", 
+			id->getName());
+}
+
 void ReportError::NotLValueinAssignment(yyltype *loc) {
 	Formatted(loc, "Left side of an assignment must be a field or array access");
 }
@@ -59,6 +59,10 @@ class ReportError
 	static void CouplingOfReductionWithOtherExpr(yyltype *loc, bool suppressFailure);	
 	static void ReductionOutsideForLoop(yyltype *loc, bool suppressFailure);
 	static void IndexReductionOnMultiIndexLoop(yyltype *loc, bool suppressFailure);
+	static void UnknownScanMode(yyltype *loc, const char *modeName, bool suppressFailure);
+	static void IndexReductionInScan(yyltype *loc, bool suppressFailure);
+	static void UnsupportedScatterTarget(yyltype *loc, Type *actualType, bool suppressFailure);
+	static void ScatterOnReorderedArray(yyltype *loc, const char *arrayName, const char *spaceName, bool suppressFailure);
 	
 	//------------------------------------------------------------------------------- Polymorphic Type/stage Resolution Errors
 
@@ -82,6 +86,7 @@ class ReportError
 	static void InvalidReductionRange(yyltype *loc, const char *executingLps, const char *rootLps, bool suppressFailure);
 	static void ReductionEscapingRepeatCycle(yyltype *loc, const char *rdVar, const char *rootLps, bool suppressFailure);
 	static void ReductionVarUsedBeforeReady(yyltype *loc, const char *rdVar, const char *rootLps, bool suppressFailure);
+	static void InvalidScanRange(yyltype *loc, const char *rdVar, const char *rootLps, bool suppressFailure);
 	static void ArrayPartitionUnknown(yyltype *loc, const char *arrayName, const char *stageName, const char *spaceId);
 	static void ArrayPartitionUnknown(yyltype *loc, const char *arrayName, const char *spaceId);
 
@@ -114,6 +119,8 @@ class ReportError
 	static void InvalidPadding(yyltype *loc, const char *functionName);
 	static void PartitionArgumentsNotSupported(yyltype *loc, const char *functionName);
 	static void PaddingArgumentsNotSupported(yyltype *loc, const char *functionName);
+	static void InvalidPartitionWeights(yyltype *loc, const char *functionName);
+	static void InvalidPartitionWeightArray(Identifier *id);
 
 	// Errors discovered during static analysis	
 	static void NotLValueinAssignment(yyltype *loc);
@@ -24,6 +24,7 @@ class StageSyncReqs;
 class StageSyncDependencies;
 class CommunicationCharacteristics;
 class IncludesAndLinksMap;
+class Scatter;
 
 /*	Base class for representing a stage in the execution flow of a task. Instead of directly using the compute and 
 	meta-compute stages that we get from the abstract syntax tree, we derive a modified set of flow stages that are 
@@ -296,6 +297,10 @@ class StageInstanciation : public FlowStage {
 	// metadata processing during code generation in any back-end architecture. This attribute holds a list of
 	// arguments with such special metadata processing need.
 	List<ArrayPartConfig*> *arrayPartArgConfList;
+
+	// a back-end may decide while translating the code of the stage that each LPU needs its own random number 
+	// stream for the stage; this flag records that decision for generating the invocation code of the stage
+	bool randomStreamUsed;
   public:
 	StageInstanciation(Space *space);
 	void setCode(Stmt *code) { this->code = code; }
@@ -350,6 +355,13 @@ class StageInstanciation : public FlowStage {
 
 	bool hasNestedReductions();	
 	
+	//-------------------------------------------------------------------------------------------------------------
+
+	// functions for aiding implementing scatters -----------------------------------------------------------------
+
+	// returns the scatter library function calls found within the code of the compute stage
+	List<Scatter*> *getNestedScatters();
+	
 	//-------------------------------------------------------------------------------------------------------------
 	
 	// functions for determining extern linking requirements ------------------------------------------------------
@@ -369,6 +381,7 @@ class StageInstanciation : public FlowStage {
 
 	void translateCode(std::ofstream &stream);
         void generateInvocationCode(std::ofstream &stream, int indentation, Space *containerSpace);
+	bool usesRandomStream() { return randomStreamUsed; }
 };
 
 /*	A composite stage is a holder of other flow stages and control blocks as a sub-flow. */
@@ -560,6 +573,7 @@ class RepeatControlBlock : public CompositeStage {
 	RepeatControlBlock(Space *space, RepeatCycleType type, Expr *executeCond);
 	void performDataAccessChecking(Scope *taskScope);
 	void print(int indent);
+	Expr *getCondition() { return condition; }
 	
 	//------------------------------------------------------------------------ Helper functions for Static Analysis
 	
@@ -619,6 +633,7 @@ class ConditionalExecutionBlock : public CompositeStage {
 	ConditionalExecutionBlock(Space *space, Expr *executeCond);
 	void print(int indent);
 	void performDataAccessChecking(Scope *taskScope);
+	Expr *getCondition() { return condition; }
 	
 	//------------------------------------------------------------------------ Helper functions for Static Analysis
 	
@@ -675,6 +690,14 @@ class LpsTransitionBlock : public CompositeStage {
         **************************************************************************************************************/
 
 	void genReductionResultPreprocessingCode(std::ofstream &stream, int indentation);
+	void genScanCompletionCode(std::ofstream &stream, int indentation);
+	// generates code for applying the buffered writes of all scatters done in the compute stages that execute
+	// in the current LPS
+	void genScatterCompletionCode(std::ofstream &stream, int indentation);
+	// If the LPUs of the LPS are entered only to execute a sub-flow activated by a condition of the form 'index
+	// in array.local.dimension.range' then this returns that condition; otherwise it returns NULL. The LPU that
+	// can satisfy such a condition can be found directly from the index, without computing the other LPUs.
+	RangeExpr *getIndexOwnerCondition(Space *containerSpace);
 	void generateInvocationCode(std::ofstream &stream, int indentation, Space *containerSpace);
 };
 
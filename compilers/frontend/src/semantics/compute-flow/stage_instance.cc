@@ -10,6 +10,7 @@
 #include "../../syntax/ast_expr.h"
 #include "../../syntax/ast_stmt.h"
 #include "../../syntax/ast_task.h"
+#include "../../syntax/ast_library_fn.h"
 #include "../../static-analysis/reduction_info.h"
 #include "../../static-analysis/data_dependency.h"
 #include "../../codegen-helper/extern_config.h"
@@ -26,10 +27,25 @@ StageInstanciation::StageInstanciation(Space *space) : FlowStage(space) {
 	this->code = NULL;
 	this->nestedReductions = new List<ReductionMetadata*>;
 	this->arrayPartArgConfList = NULL;
+	this->randomStreamUsed = false;
 }
 
 void StageInstanciation::performDataAccessChecking(Scope *taskScope) {
 	accessMap = validateDataAccess(taskScope, NULL, code);
+
+	// the runtime locates the owner of a scattered index from the contiguous index ranges of the data parts; so the
+	// target array must not be reordered by any partition function down to the LPS of the stage
+	List<Scatter*> *scatterList = getNestedScatters();
+	for (int i = 0; i < scatterList->NumElements(); i++) {
+		Scatter *scatter = scatterList->Nth(i);
+		const char *arrayName = scatter->getTargetArrayName();
+		if (arrayName == NULL) continue;
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(space->getStructure(arrayName));
+		if (array != NULL && array->isReordered(space->getRoot())) {
+			ReportError::ScatterOnReorderedArray(scatter->GetLocation(), arrayName, space->getName(), false);
+		}
+	}
+	delete scatterList;
 }
 
 void StageInstanciation::print(int indentLevel) {
@@ -111,6 +127,18 @@ FlowStage *StageInstanciation::getLastAccessorStage(const char *varName) {
 
 bool StageInstanciation::hasNestedReductions() { return (nestedReductions->NumElements() > 0); }
 
+List<Scatter*> *StageInstanciation::getNestedScatters() {
+	List<Expr*> *fnCallList = new List<Expr*>;
+	code->retrieveExprByType(fnCallList, LIB_FN_CALL);
+	List<Scatter*> *scatterList = new List<Scatter*>;
+	for (int i = 0; i < fnCallList->NumElements(); i++) {
+		Scatter *scatter = dynamic_cast<Scatter*>(fnCallList->Nth(i));
+		if (scatter != NULL) scatterList->Append(scatter);
+	}
+	delete fnCallList;
+	return scatterList;
+}
+
 void StageInstanciation::retriveExternCodeBlocksConfigs(IncludesAndLinksMap *externConfigMap) {
 	code->retrieveExternHeaderAndLibraries(externConfigMap);
 }
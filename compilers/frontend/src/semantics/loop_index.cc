@@ -62,11 +62,13 @@ void IndexArrayAssociation::generateTransform(std::ostringstream &stream, int in
 	ArrayDataStructure *structure = (ArrayDataStructure*) space->getStructure(array);
 	int dimensionCount = structure->getDimensionality();
 	std::ostringstream xform;
-	xform << "((long) (" << index;
+	// the offset of the index within the part fits in a local offset as no part dimension is longer than that; only
+	// the linearized offset needs the 64-bit multiplication
+	xform << "((long) ((LocalOffset) (" << index;
 	if (structure->isDimensionReordered(dimensionNo + 1, space->getRoot())) {
 		xform << "Xformed";
 	}
-	xform << " - " << array << "StoreDims[" << dimensionNo << "].range.min" << "))";
+	xform << " - " << array << "StoreDims[" << dimensionNo << "].range.min" << ")))";
 	bool firstEntry = true;
 	for (int i = dimensionCount - 1; i > dimensionNo; i--) {
 		if (!firstEntry) {
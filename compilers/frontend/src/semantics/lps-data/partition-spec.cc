@@ -83,6 +83,10 @@ PartitionFunctionConfig *PartitionFunctionConfig::generateConfig(yyltype *locati
 		config = new BlockSize(location);
 	} else if (strcmp(functionName, BlockCount::name) == 0) {
 		config = new BlockCount(location);
+	} else if (strcmp(functionName, WeightedBlock::name) == 0) {
+		config = new WeightedBlock(location);
+	} else if (strcmp(functionName, PrefixWeightedBlock::name) == 0) {
+		config = new PrefixWeightedBlock(location);
 	} else if (strcmp(functionName, StridedBlock::name) == 0) {
 		config = new StridedBlock(location);
 	} else if (strcmp(functionName, Strided::name) == 0) {
@@ -102,6 +102,55 @@ List<int> *BlockCount::getBlockedDimensions(Type *structureType) {
 	return new List<int>;
 }
 
+//-------------------------------------------------- Weighted Block ----------------------------------------------/
+
+const char *WeightedBlock::name = "weighted_block";
+
+WeightedBlock::WeightedBlock(yyltype *location) : SingleArgumentPartitionFunction(location, name) {
+	weightArrays = new List<Identifier*>;
+}
+
+WeightedBlock::WeightedBlock(yyltype *location, 
+		const char *functionName) : SingleArgumentPartitionFunction(location, functionName) {
+	weightArrays = new List<Identifier*>;
+}
+
+void WeightedBlock::processArguments(List<PartitionArg*> *dividingArgs, 
+		List<PartitionArg*> *paddingArgs, const char *argumentName) {
+	
+	// separate the block counts from the weight arrays as the former are processed the same way they are for the
+	// block-count function
+	List<PartitionArg*> *countArgs = new List<PartitionArg*>;
+	if (dividingArgs != NULL) {
+		if (dividingArgs->NumElements() % 2 != 0) {
+			ReportError::InvalidPartitionWeights(location, functionName);
+		}
+		for (int i = 0; i + 1 < dividingArgs->NumElements(); i += 2) {
+			countArgs->Append(dividingArgs->Nth(i));
+			Identifier *weights = dynamic_cast<Identifier*>(dividingArgs->Nth(i + 1)->getContent());
+			if (weights == NULL) {
+				ReportError::InvalidPartitionWeights(location, functionName);
+			}
+			weightArrays->Append(weights);
+		}
+	}
+	SingleArgumentPartitionFunction::processArguments(countArgs, paddingArgs, "block count and weights");
+	delete countArgs;
+}
+
+Identifier *WeightedBlock::getWeightArrayForDimension(int dimensionNo) {
+	for (int i = 0; i < arguments->NumElements(); i++) {
+		if (arguments->Nth(i)->getDimensionNo() == dimensionNo) {
+			return (i < weightArrays->NumElements()) ? weightArrays->Nth(i) : NULL;
+		}
+	}
+	return NULL;
+}
+
+//----------------------------------------------- Prefix Weighted Block -------------------------------------------/
+
+const char *PrefixWeightedBlock::name = "weighted_block_prefix";
+
 //--------------------------------------------------- Strided Block ----------------------------------------------/
 
 const char *StridedBlock::name = "block_stride";
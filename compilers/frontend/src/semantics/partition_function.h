@@ -59,6 +59,44 @@ class BlockCount : public SingleArgumentPartitionFunction {
 	const char *getDimensionConfigClassName() { return "BlockCountConfig"; }
 };
 
+/* 'weighted_block' divides a dimension into a given number of blocks like 'block_count' does; but instead of making
+   the blocks equal in length, it makes them equal in total weight. The weights come from a one-dimensional integer 
+   array of the task that holds one weight per index of the partitioned dimension, e.g., the number of non-zeros in each 
+   row of a CSR sparse matrix. So a dimension is specified by a pair of arguments: the block count followed by the name 
+   of the weight array. */
+class WeightedBlock : public SingleArgumentPartitionFunction {
+  protected:
+	// weight arrays in the order of the partitioned dimensions
+	List<Identifier*> *weightArrays;
+	WeightedBlock(yyltype *location, const char *functionName);
+  public:
+	static const char *name;
+	WeightedBlock(yyltype *location);
+	// tells if the weight arrays hold running totals of the weights instead of the weights themselves
+	virtual bool hasPrefixSumWeights() { return false; }
+	void processArguments(List<PartitionArg*> *dividingArgs, 
+			List<PartitionArg*> *paddingArgs, const char *argumentName);
+	List<int> *getBlockedDimensions(Type *structureType) { return new List<int>; }
+	bool doesSupportGhostRegion() { return true; }
+	List<Identifier*> *getWeightArrays() { return weightArrays; }
+	Identifier *getWeightArrayForDimension(int dimensionNo);
+
+	//------------------------------------------------------------- Common helper functions for Code Generation
+
+	const char *getDimensionConfigClassName() { return "WeightedBlockConfig"; }
+};
+
+/* 'weighted_block_prefix' is the same as 'weighted_block' except that the weight array holds the prefix sums of the 
+   weights, like the row_ptr array of a CSR sparse matrix does: the weight of an index is the difference between the 
+   entry after the index's position and the entry at its position. So the array has one entry more than the indices 
+   of the partitioned dimension, and the offsets array a sparse matrix already has can be used as is. */
+class PrefixWeightedBlock : public WeightedBlock {
+  public:
+	static const char *name;
+	PrefixWeightedBlock(yyltype *location) : WeightedBlock(location, name) {}
+	bool hasPrefixSumWeights() { return true; }
+};
+
 class StridedBlock : public SingleArgumentPartitionFunction {
   public:
 	static const char *name;
@@ -26,6 +26,13 @@ class ReductionMetadata {
 
 	// this is another attribute needed for reduction validation and error reporting
 	StageInstanciation *executorStage;
+
+	// a reduction whose result is a prefix scan over the LPUs of the root LPS has a scan mode other than NO_SCAN
+	ScanMode scanMode;
+
+	// an index reduction (maxEntry, minEntry) has as many dimensions in its result as the number of indexes
+	// of the loop doing the reduction; this is 1 for all other reductions
+	int indexDimensions;
   public:
         ReductionMetadata(const char *resultVar,
                         ReductionOperator opCode,
@@ -38,6 +45,8 @@ class ReductionMetadata {
 		this->reductionRootLps = reductionRootLps;
 		this->reductionExecutorLps = reductionExecutorLps;
 		this->location = location;
+		this->scanMode = NO_SCAN;
+		this->indexDimensions = 1;
 	}
         const char *getResultVar() { return resultVar; }
         ReductionOperator getOpCode() { return opCode; }
@@ -47,6 +56,12 @@ class ReductionMetadata {
         yyltype *getLocation() { return location; }
 	void setExecutorStage(StageInstanciation *stage) { this->executorStage = stage; }
 	StageInstanciation *getExecutorStage() { return executorStage; }
+	void setScanMode(ScanMode scanMode) { this->scanMode = scanMode; }
+	ScanMode getScanMode() { return scanMode; }
+	bool isScan() { return scanMode != NO_SCAN; }
+	void setIndexDimensions(int indexDimensions) { this->indexDimensions = indexDimensions; }
+	int getIndexDimensions() { return indexDimensions; }
+	bool isIndexReduction() { return opCode == MAX_ENTRY || opCode == MIN_ENTRY; }
 
         // A reduction is singleton when there is just a single global result instance of the reduction operation. 
         // Result handling for such a reduction is much easier than that of a normal reduction. In the former case we
@@ -157,6 +157,7 @@ class FloatConstant : public Expr {
     	FloatConstant(yyltype loc, float val);
     	const char *GetPrintNameForNode() { return "Float-Constant"; }
     	void PrintChildren(int indentLevel);
+	float getValue() { return value; }
 
 	//------------------------------------------------------------------ Helper functions for Semantic Analysis
 
@@ -182,6 +183,7 @@ class DoubleConstant : public Expr {
     	DoubleConstant(yyltype loc, double val);
     	const char *GetPrintNameForNode() { return "Double-Constant"; }
     	void PrintChildren(int indentLevel);
+	double getValue() { return value; }
 
 	//------------------------------------------------------------------ Helper functions for Semantic Analysis
 
@@ -329,6 +331,9 @@ class ArithmaticExpr : public Expr {
 
         Node *clone();
 	ExprTypeId getExprTypeId() { return ARITH_EXPR; };
+	Expr *getLeft() { return left; }
+	ArithmaticOperator getOp() { return op; }
+	Expr *getRight() { return right; }
 	void retrieveExprByType(List<Expr*> *exprList, ExprTypeId typeId);
 	int resolveExprTypes(Scope *scope);
 	int inferExprTypes(Scope *scope, Type *assignedType);
@@ -518,6 +523,7 @@ class FieldAccess : public Expr {
         
 	void setEpochVersions(Space *space, int epoch);
 	void setEpochVersion(int epoch) { this->epochVersion = epoch; }
+	int getEpochVersion() { return epochVersion; }
 	
 	//------------------------------------------------------------- Common helper functions for Code Generation
 
@@ -774,6 +780,11 @@ class ArrayAccess : public Expr {
         void generateXformedIndex(std::ostringstream &stream, int indentLevel,
                         const char *indexExpr,
                         const char *arrayName, int dimensionNo, Space *space);
+	// tells if the expression accesses an element of an array of objects stored in the structure-of-arrays
+	// layout; such an element is translated into a view of the sub-arrays of its fields
+	bool isSoaLayoutElementAccess();
+	void translateSoaFieldAccess(std::ostringstream &stream, int indentLevel, 
+			const char *fieldName, Space *space);
 };
 
 class FunctionCall : public Expr {
@@ -885,6 +896,7 @@ class TaskInvocation : public Expr {
                         Hashtable<ParamReplacementConfig*> *arrayAccXformInstrMap);
 
 	// helper functions to retrieve different types of task invocation arguments 
+	TaskDef *getTaskDef() { return taskDef; }
 	const char *getTaskName();
 	FieldAccess *getEnvArgument();
 	List<Expr*> *getInitArguments();
@@ -904,6 +916,9 @@ class TaskInvocation : public Expr {
         **********************************************************************************************************/
         
 	void generateCode(std::ostringstream &stream, int indentLevel, Space *space);
+	// generates the code for a run of consecutive independent invocations to be launched concurrently
+	static void generateConcurrentLaunch(std::ostringstream &stream, 
+			int indentLevel, Space *space, List<TaskInvocation*> *invocations);
 };
 
 class ObjectCreate : public Expr {
@@ -43,6 +43,7 @@ class LibraryFunction : public Expr {
 
 	const char *GetPrintNameForNode() { return functionName->getName(); }
         void PrintChildren(int indentLevel);
+	List<Expr*> *getArguments() { return arguments; }
 
         //-------------------------------------------------------------- Helper functions for Semantic Analysis
 
@@ -120,6 +121,49 @@ class Random : public LibraryFunction {
 	void translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space);
 };
 
+/*------------------------------------------------------------------------------------------------------------- 
+	   		Index-driven writes to distributed arrays from compute stages
+-------------------------------------------------------------------------------------------------------------*/
+
+/* scatter(array, index, value) writes the value at the index of a one-dimensional array. Unlike an ordinary 
+   assignment the index may refer to an element of some other LPU, even one held by another segment. The writes
+   are buffered and take effect together when all LPUs of the LPS executing the compute stage are done. 
+*/
+class Scatter : public LibraryFunction {
+  protected:
+	// a program-wide counter to give each scatter call site its own identity; two scatters writing the same array
+	// from different places of the program must not share buffers at runtime
+	static int callSiteCount;
+	int callSiteId;
+  public:
+	static const char *Name;
+	Scatter(Identifier *id, List<Expr*> *arguments, yyltype loc) 
+		: LibraryFunction(3, id, arguments, loc) { callSiteId = callSiteCount++; }
+
+        //-------------------------------------------------------------- Helper functions for Semantic Analysis
+
+	int resolveExprTypes(Scope *scope);
+	int emitErrorsInArguments(Scope *scope);
+	Hashtable<VariableAccess*> *getAccessedGlobalVariables(TaskGlobalReferences *globalRefs);
+
+	// returns the name of the array the scatter writes to
+	const char *getTargetArrayName() { return arguments->Nth(0)->getBaseVarName(); }
+	// returns the element type of the target array
+	Type *getElementType();
+	int getCallSiteId() { return callSiteId; }
+
+        //-------------------------------------------------------------------------- Code Generation Hack Functions
+        /**********************************************************************************************************
+          The code generation related function definitions that are placed here are platform specific. So ideally 
+          they should not be included here and the frontend compiler should be oblivious of them. However, as we
+          ran out of time in overhauling the old compilers, instead of redesigning the code generation process, we 
+          decided to keep the union of old function definitions in the frontend and put their implementations in
+          relevent backend compilers.   
+        **********************************************************************************************************/
+
+	void translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space);
+};
+
 /*------------------------------------------------------------------------------------------------------------- 
 	       Functions for loading or storing arrays directly in the coordinator program
 -------------------------------------------------------------------------------------------------------------*/
@@ -12,6 +12,7 @@ class IntConstant;
 class ArrayDataStructure;
 class PartitionHierarchy;
 class PartitionFunctionConfig;
+class WeightedBlock;
 
 class SpaceLinkage : public Node {
   protected:
@@ -100,6 +101,9 @@ class DataConfigurationSpec : public Node {
 	ArrayDataStructure *addPartitionConfiguration(Space *space,
                 	Scope *partitionScope, 
 			PartitionHierarchy *partitionHierarchy);
+  private:
+	// checks that the weight arrays of a weighted-block partition are one dimensional integer arrays of the task
+	void validatePartitionWeights(WeightedBlock *config, PartitionHierarchy *partitionHierarchy);
 };
 
 class SubpartitionSpec : public Node {
@@ -128,6 +128,7 @@ class StmtBlock : public Stmt {
 	
 	//------------------------------------------------------------- Common helper functions for Code Generation
 	
+	List<Stmt*> *getStmts() { return stmts; }
         void retrieveExternHeaderAndLibraries(IncludesAndLinksMap *includesAndLinksMap);
 
 	//-------------------------------------------------------------------------- Code Generation Hack Functions
@@ -150,6 +151,7 @@ class ConditionalStmt: public Stmt {
 	ConditionalStmt(Expr *condition, Stmt *stmt, yyltype loc);	
     	const char *GetPrintNameForNode() { return "Conditional-Stmt"; }
     	void PrintChildren(int indentLevel);
+	Stmt *getStmt() { return stmt; }
 
         //------------------------------------------------------------------ Helper functions for Semantic Analysis
 
@@ -192,6 +194,7 @@ class IfStmt: public Stmt {
 	IfStmt(List<ConditionalStmt*> *ifBlocks, yyltype loc);	
     	const char *GetPrintNameForNode() { return "If-Block"; }
     	void PrintChildren(int indentLevel);
+	List<ConditionalStmt*> *getIfBlocks() { return ifBlocks; }
 
         //------------------------------------------------------------------ Helper functions for Semantic Analysis
 
@@ -279,6 +282,7 @@ class LoopStmt: public Stmt {
   public:
 	LoopStmt();
      	LoopStmt(Stmt *body, yyltype loc);
+	Stmt *getBody() { return body; }
 	virtual void extractReductionInfo(List<ReductionMetadata*> *infoSet,
 			PartitionHierarchy *lpsHierarchy, 
 			Space *executingLps);
@@ -345,6 +349,10 @@ class PLoopStmt: public LoopStmt {
         **********************************************************************************************************/
 	
 	void generateCode(std::ostringstream &stream, int indentLevel, Space *space);
+	// If the loop computes a matrix-matrix product of parts of task global arrays then this generates a call
+	// to the runtime's blocked multiplication kernel in place of the loop and returns true; otherwise it 
+	// generates nothing and returns false.
+	bool generateMatrixMultiplyCall(std::ostringstream &stream, int indentLevel, Space *space);
 };
 
 class SLoopAttribute {
@@ -418,6 +426,7 @@ class WhileStmt: public Stmt {
 	WhileStmt(Expr *condition, Stmt *body, yyltype loc);	
 	const char *GetPrintNameForNode() { return "While-Loop"; }
     	void PrintChildren(int indentLevel);
+	Stmt *getBody() { return body; }
 
         //------------------------------------------------------------------ Helper functions for Semantic Analysis
 
@@ -468,10 +477,15 @@ class ReductionStmt: public Stmt {
 	// A reduction statement must be placed inside a parallel for loop to be meaningful. This is the
 	// reference to that loop.
 	PLoopStmt *enclosingLoop;
+
+	// A scan statement is a reduction statement whose result for an LPU only combines the contributions
+	// of the LPUs preceding it (and itself, for an inclusive scan) in the LPU ID order.
+	ScanMode scanMode;
   public:
         ReductionStmt(Identifier *left, char *opName, Expr *right, yyltype loc);
         const char *GetPrintNameForNode() { return "Reduction-Statement"; }
         void PrintChildren(int indentLevel);
+	void setScanMode(const char *modeName, yyltype modeLoc);
 
         //------------------------------------------------------------------ Helper functions for Semantic Analysis
 
@@ -496,6 +510,10 @@ class ReductionStmt: public Stmt {
 	// logic of inferring a result variable type given the reduced expression type as an argument.
 	Type *inferResultTypeFromOpAndExprType(Type *exprType);
 
+	// the result of an index reduction is an integer or an integer array depending on the number of indexes
+	// of the enclosing loop
+	Type *getIndexResultType();
+
   public:	
 	//-------------------------------------------------------------------- Helper functions for Static Analysis
 
@@ -16,6 +16,8 @@
 
 const char *Root::Name = "root";
 const char *Random::Name = "random";
+const char *Scatter::Name = "scatter";
+int Scatter::callSiteCount = 0;
 const char *LoadArray::Name = "load_array";
 const char *StoreArray::Name = "store_array";
 const char *BindInput::Name = "bind_input";
@@ -40,6 +42,7 @@ bool LibraryFunction::isLibraryFunction(Identifier *id) {
         const char* name = id->getName();
         return (strcmp(name, Root::Name) == 0 
 		|| strcmp(name, Random::Name) == 0
+		|| strcmp(name, Scatter::Name) == 0
                 || strcmp(name, LoadArray::Name) == 0 
                 || strcmp(name, StoreArray::Name) == 0
                 || strcmp(name, BindInput::Name) == 0
@@ -57,6 +60,8 @@ LibraryFunction *LibraryFunction::getFunctionExpr(Identifier *id, List<Expr*> *a
                 function = new Root(id, arguments, loc);
         } else if (strcmp(name, Random::Name) == 0) {
                 function = new Random(id, arguments, loc);
+        } else if (strcmp(name, Scatter::Name) == 0) {
+                function = new Scatter(id, arguments, loc);
         } else if (strcmp(name, LoadArray::Name) == 0) {
                 function = new LoadArray(id, arguments, loc);
         } else if (strcmp(name, StoreArray::Name) == 0) {
@@ -196,6 +201,92 @@ int Root::emitErrorsInArguments(Scope *scope) {
 	return errors;
 }
 
+//------------------------------------------------------------- Scatter ---------------------------------------------------------/
+
+int Scatter::resolveExprTypes(Scope *scope) {
+
+	int resolvedExprs = 0;
+	Expr *arg1 = arguments->Nth(0);
+	resolvedExprs += arg1->resolveExprTypesAndScopes(scope);
+
+	Expr *arg2 = arguments->Nth(1);
+	resolvedExprs += arg2->resolveExprTypesAndScopes(scope);
+	resolvedExprs += arg2->performTypeInference(scope, Type::intType);
+
+	// the value to be written should have the element type of the target array
+	Expr *arg3 = arguments->Nth(2);
+	resolvedExprs += arg3->resolveExprTypesAndScopes(scope);
+	Type *elementType = getElementType();
+	if (elementType != NULL) {
+		resolvedExprs += arg3->performTypeInference(scope, elementType);
+	}
+
+	if (arg1->getType() != NULL && arg2->getType() != NULL && arg3->getType() != NULL) {
+		this->type = Type::voidType;
+		resolvedExprs++;
+	}
+	return resolvedExprs;
+}
+
+int Scatter::emitErrorsInArguments(Scope *scope) {
+
+	int errors = 0;
+	Expr *arg1 = arguments->Nth(0);
+	errors += arg1->emitScopeAndTypeErrors(scope);
+	Type *arg1Type = arg1->getType();
+	if (arg1Type != NULL && arg1Type != Type::errorType) {
+		ArrayType *arrayType = dynamic_cast<ArrayType*>(arg1Type);
+		if (arrayType == NULL) {
+			ReportError::InvalidArrayAccess(arg1->GetLocation(), arg1Type, false);
+			errors++;
+		} else if (arrayType->getDimensions() != 1) {
+			ReportError::UnsupportedScatterTarget(arg1->GetLocation(), arg1Type, false);
+			errors++;
+		}
+	}
+
+	Expr *arg2 = arguments->Nth(1);
+	errors += arg2->emitScopeAndTypeErrors(scope);
+	Type *arg2Type = arg2->getType();
+	if (arg2Type != NULL && arg2Type != Type::intType && arg2Type != Type::errorType) {
+		ReportError::IncompatibleTypes(arg2->GetLocation(), arg2Type, Type::intType, false);
+		errors++;
+	}
+
+	Expr *arg3 = arguments->Nth(2);
+	errors += arg3->emitScopeAndTypeErrors(scope);
+	Type *arg3Type = arg3->getType();
+	Type *elementType = getElementType();
+	if (arg3Type != NULL && elementType != NULL 
+			&& arg3Type != Type::errorType
+			&& !elementType->isAssignableFrom(arg3Type)) {
+		ReportError::IncompatibleTypes(arg3->GetLocation(), arg3Type, elementType, false);
+		errors++;
+	}
+	return errors;
+}
+
+Hashtable<VariableAccess*> *Scatter::getAccessedGlobalVariables(TaskGlobalReferences *globalReferences) {
+	
+	// all arguments are read like in any other library function, except that the content of the target array
+	// is written
+	Hashtable<VariableAccess*> *table = LibraryFunction::getAccessedGlobalVariables(globalReferences);
+	const char *targetArray = getTargetArrayName();
+	if (targetArray != NULL && table->Lookup(targetArray) != NULL) {
+		VariableAccess *accessLog = table->Lookup(targetArray);
+		accessLog->markContentAccess();
+		accessLog->getContentAccessFlags()->flagAsWritten();
+	}
+	return table;
+}
+
+Type *Scatter::getElementType() {
+	Type *arg1Type = arguments->Nth(0)->getType();
+	ArrayType *arrayType = dynamic_cast<ArrayType*>(arg1Type);
+	if (arrayType == NULL) return NULL;
+	return arrayType->getTerminalElementType();
+}
+
 //--------------------------------------------------------- Array Operation -----------------------------------------------------/
 
 int ArrayOperation::resolveExprTypes(Scope *scope) {
@@ -45,6 +45,7 @@ ReductionStmt::ReductionStmt(Identifier *l, char *o, Expr *r, yyltype loc) : Stm
         right->SetParent(this);
 	reductionVar = NULL;
 	enclosingLoop = NULL;
+	scanMode = NO_SCAN;
 }
 
 ReductionStmt::ReductionStmt(Identifier *l, ReductionOperator o, Expr *r, yyltype loc) : Stmt(loc) {
@@ -55,8 +56,18 @@ ReductionStmt::ReductionStmt(Identifier *l, ReductionOperator o, Expr *r, yyltyp
         right->SetParent(this);
 	reductionVar = NULL;
 	enclosingLoop = NULL;
+	scanMode = NO_SCAN;
 }	
 
+void ReductionStmt::setScanMode(const char *modeName, yyltype modeLoc) {
+	if (strcmp(modeName, "inclusive") == 0) scanMode = INCLUSIVE_SCAN;
+	else if (strcmp(modeName, "exclusive") == 0) scanMode = EXCLUSIVE_SCAN;
+	else {
+		ReportError::UnknownScanMode(&modeLoc, modeName, false);
+		scanMode = INCLUSIVE_SCAN;
+	}
+}
+
 void ReductionStmt::PrintChildren(int indentLevel) {
         left->Print(indentLevel + 1);
         PrintLabel(indentLevel + 1, "Operator");
@@ -72,13 +83,19 @@ void ReductionStmt::PrintChildren(int indentLevel) {
                 case BOR: printf("Bitwise OR"); break;
                 case BAND: printf("Bitwise AND"); break;
         }
+	if (scanMode != NO_SCAN) {
+        	PrintLabel(indentLevel + 1, "Scan");
+		printf((scanMode == INCLUSIVE_SCAN) ? "Inclusive" : "Exclusive");
+	}
         right->Print(indentLevel + 1);
 }
 
 Node *ReductionStmt::clone() {
 	Identifier *newLeft = (Identifier*) left->clone();
 	Expr *newRight = (Expr*) right->clone();
-	return new ReductionStmt(newLeft, op, newRight, *GetLocation());	
+	ReductionStmt *newStmt = new ReductionStmt(newLeft, op, newRight, *GetLocation());
+	newStmt->scanMode = scanMode;
+	return newStmt;	
 }
 
 void ReductionStmt::retrieveExprByType(List<Expr*> *exprList, ExprTypeId typeId) {
@@ -92,6 +109,9 @@ int ReductionStmt::resolveExprTypesAndScopes(Scope *executionScope, int iteratio
 		resolvedExprs += right->performTypeInference(executionScope, Type::boolType);
 	}
 
+	// the result type of an index reduction depends on the number of indexes of the enclosing loop
+	enclosingLoop = getEnclosingLoop();
+
 	// resolve the result type from the reduced expression type
 	Type *rightType = right->getType();
 	Type *resultType = inferResultTypeFromOpAndExprType(rightType);	
@@ -104,8 +124,6 @@ int ReductionStmt::resolveExprTypesAndScopes(Scope *executionScope, int iteratio
 		}
 	}
 
-	enclosingLoop = getEnclosingLoop();
-
 	return resolvedExprs;
 }
 
@@ -118,8 +136,8 @@ Type *ReductionStmt::inferResultTypeFromOpAndExprType(Type *exprType) {
                 case PRODUCT: return exprType;
                 case MAX: return exprType;
                 case MIN: return exprType;
-                case MIN_ENTRY: return Type::intType;
-                case MAX_ENTRY: return Type::intType;
+                case MIN_ENTRY: return getIndexResultType();
+                case MAX_ENTRY: return getIndexResultType();
                 case LOR: return Type::boolType;
                 case LAND: return Type::boolType;
                 case BOR: return exprType;
@@ -129,6 +147,19 @@ Type *ReductionStmt::inferResultTypeFromOpAndExprType(Type *exprType) {
 	return NULL;
 }
 
+Type *ReductionStmt::getIndexResultType() {
+	
+	// an index reduction in a loop over a single index results in an integer; otherwise, the result is an array
+	// holding one entry per index of the loop  
+	int indexCount = (enclosingLoop == NULL) ? 1 : enclosingLoop->getAllIndexNames()->NumElements();
+	if (indexCount <= 1) return Type::intType;
+	StaticArrayType *type = new StaticArrayType(*GetLocation(), Type::intType, 1);
+	List<int> *dimLengths = new List<int>;
+	dimLengths->Append(indexCount);
+	type->setLengths(dimLengths);
+	return type;
+}
+
 int ReductionStmt::emitScopeAndTypeErrors(Scope *scope) {
 	int errorCount = 0;
 	if (enclosingLoop == NULL) {
@@ -136,9 +167,12 @@ int ReductionStmt::emitScopeAndTypeErrors(Scope *scope) {
 		errorCount++;
 	} else if (op == MIN_ENTRY || op == MAX_ENTRY) {
 	List<const char*> *indexList = enclosingLoop->getAllIndexNames();
-		if (indexList->NumElements() != 1) {
+		if (indexList->NumElements() > MAX_INDEX_REDUCTION_DIMENSIONS) {
 			ReportError::IndexReductionOnMultiIndexLoop(GetLocation(), false);	
 			errorCount++;
+		} else if (scanMode != NO_SCAN) {
+			ReportError::IndexReductionInScan(GetLocation(), false);
+			errorCount++;
 		}
 	}
 	errorCount += right->emitScopeAndTypeErrors(scope);
@@ -249,8 +283,23 @@ void ReductionStmt::extractReductionInfo(List<ReductionMetadata*> *infoSet,
 		return;
 	}
 
+	// The per-LPU results of a scan are ordered by the LPU IDs of the root LPS. LPU IDs are only globally
+	// ordered for an LPS whose parent is the root LPS; so a scan cannot be rooted anywhere else.
+	if (scanMode != NO_SCAN) {
+		Space *parentLps = reductionRootLps->getParent();
+		if (parentLps == NULL || !parentLps->isRoot() || reductionRootLps->isSingletonLps()) {
+			ReportError::InvalidScanRange(GetLocation(), 
+					resultVar, reductionRootLps->getName(), false);
+			return;
+		}
+	}
+
 	Type *exprType = right->getType();
         ReductionMetadata *metadata = new ReductionMetadata(resultVar,
                         op, exprType, reductionRootLps, executingLps, GetLocation());
+	metadata->setScanMode(scanMode);
+	if (op == MIN_ENTRY || op == MAX_ENTRY) {
+		metadata->setIndexDimensions(enclosingLoop->getAllIndexNames()->NumElements());
+	}
         infoSet->Append(metadata);
 }
@@ -5,6 +5,7 @@
 #include "../../common/constant.h"
 #include "../../semantics/symbol.h"
 #include "../../semantics/task_space.h"
+#include "../../semantics/partition_function.h"
 #include "../../../../common-libs/utils/list.h"
 
 //----------------------------------------- Linking Spaces Together ---------------------------------------------/
@@ -119,7 +120,12 @@ void PartitionInstr::PrintChildren(int indentLevel) {
 PartitionFunctionConfig *PartitionInstr::generateConfiguration(List<int> *dataDimensions,
                         int dimensionAccessStartIndex, Scope *partitionScope) {
 
+        // the weight arrays of a weighted-block function are task arrays, not partition parameters; they are validated
+        // along with the data structure being partitioned 
+        bool weighted = (strcmp(partitionFn->getName(), WeightedBlock::name) == 0 
+                        || strcmp(partitionFn->getName(), PrefixWeightedBlock::name) == 0);
         for (int i = 0; i < dividingArgs->NumElements(); i++) {
+                if (weighted && i % 2 == 1) continue;
                 PartitionArg *arg = dividingArgs->Nth(i);
                 arg->validateScope(partitionScope);
         }
@@ -310,6 +316,10 @@ ArrayDataStructure* DataConfigurationSpec::addPartitionConfiguration(Space *spac
 				space->storeToken(currentCoordinate, token);
 				currentCoordinate++;
 			}
+			WeightedBlock *weightedBlock = dynamic_cast<WeightedBlock*>(pFnConfig);
+			if (weightedBlock != NULL) {
+				validatePartitionWeights(weightedBlock, partitionHierarchy);
+			}
 			blockedDimensions->AppendAll(pFnConfig->getBlockedDimensions(type));
 			currentDataDimensionIndex += dimsFurtherPartitioned->NumElements();
 			newDef->addPartitionSpec(pFnConfig);
@@ -341,6 +351,26 @@ ArrayDataStructure* DataConfigurationSpec::addPartitionConfiguration(Space *spac
 	return newDef;
 }
 
+void DataConfigurationSpec::validatePartitionWeights(WeightedBlock *config, PartitionHierarchy *partitionHierarchy) {
+	Space *rootSpace = partitionHierarchy->getRootSpace();
+	List<Identifier*> *weightArrays = config->getWeightArrays();
+	for (int i = 0; i < weightArrays->NumElements(); i++) {
+		Identifier *weights = weightArrays->Nth(i);
+		if (weights == NULL) continue;
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(
+				rootSpace->getStructure(weights->getName()));
+		if (array == NULL) {
+			ReportError::InvalidPartitionWeightArray(weights);
+			continue;
+		}
+		ArrayType *arrayType = dynamic_cast<ArrayType*>(array->getType());
+		if (arrayType == NULL || arrayType->getDimensions() != 1 
+				|| arrayType->getTerminalElementType() != Type::intType) {
+			ReportError::InvalidPartitionWeightArray(weights);
+		}
+	}
+}
+
 //----------------------------------- Subpartitioning Space Configuration ---------------------------------------/
 
 SubpartitionSpec::SubpartitionSpec(int d, bool o, List<DataConfigurationSpec*> *sl, yyltype loc) : Node(loc) {
@@ -0,0 +1,325 @@
+/* This is a standalone benchmark for the different communication buffer types of the segmented-memory runtime. It
+ * constructs the parts of a synthetic two dimensional array of doubles for one or two LPSes, generates the confinements
+ * and data exchanges of a synchronization between them the same way the generated code does, and then times buffer
+ * setup and read/write transfers for each buffer type. Finally, it lets an adaptive communication buffer pick a type
+ * for each data exchange to show what the runtime selection would do for the configuration.
+ *
+ * The benchmark supports two synchronization scenarios
+ *   ghost    : ghost region synchronization among block_size partitioned parts of a single LPS having paddings
+ *   reorder  : data movement from block_size partitioned parts of one LPS to block_count partitioned parts of another
+ * All parts belong to the same segment. So the virtual buffers do direct part-to-part copies and the physical buffers
+ * measure the cost of moving data between the operating memory and the buffer on both ends of a transfer, i.e., the
+ * communication cost excluding the MPI transfer.
+ *
+ * Usage: comm_buffer_benchmark [ghost|reorder] [array dimension] [block size] [padding] [transfer count]
+ * */
+
+#include "../src/runtime/communication/part_config.h"
+#include "../src/runtime/communication/part_distribution.h"
+#include "../src/runtime/communication/confinement_mgmt.h"
+#include "../src/runtime/communication/comm_buffer.h"
+#include "../src/runtime/communication/comm_statistics.h"
+#include "../src/runtime/communication/adaptive_comm_buffer.h"
+#include "../src/runtime/memory-management/allocation.h"
+#include "../src/runtime/memory-management/part_tracking.h"
+#include "../src/runtime/memory-management/part_generation.h"
+
+#include "../../common-libs/utils/list.h"
+#include "../../common-libs/domain-obj/structure.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+
+// LPS identifiers of the synthetic partition hierarchy; the root LPS must have the identifier 0
+const int ROOT_LPS = 0;
+const int SENDER_LPS = 1;
+const int RECEIVER_LPS = 2;
+
+// the segment all parts belong to
+const int LOCAL_SEGMENT = 0;
+
+/* holds everything created for the parts of the array in a single LPS */
+class LpsArrayParts {
+  public:
+	DataPartitionConfig *partConfig;
+	PartIdContainer *partContainer;
+	DataPartsList *partsList;
+};
+
+double getElapsedTime(struct timeval &start, struct timeval &end) {
+	return ((end.tv_sec - start.tv_sec) + ((end.tv_usec - start.tv_usec) / 1000000.0));
+}
+
+// generates the partition configuration for the array in an LPS; when the block count is positive the array is
+// divided using the block_count function, otherwise, the block_size function is used
+DataPartitionConfig *generatePartitionConfig(int lpsId, int arrayDimension,
+		int blockSize, int blockCount, int padding) {
+
+	List<DimPartitionConfig*> *dimensionConfigs = new List<DimPartitionConfig*>;
+	for (int i = 0; i < 2; i++) {
+		Dimension dimension;
+		dimension.range.min = 0;
+		dimension.range.max = arrayDimension - 1;
+		dimension.setLength();
+		int *arguments = new int[1];
+		int paddings[2];
+		paddings[0] = padding;
+		paddings[1] = padding;
+		if (blockCount > 0) {
+			arguments[0] = blockCount;
+			dimensionConfigs->Append(new BlockCountConfig(dimension, arguments, paddings, 1, i));
+		} else {
+			arguments[0] = blockSize;
+			dimensionConfigs->Append(new BlockSizeConfig(dimension, arguments, paddings, 1, i));
+		}
+	}
+	DataPartitionConfig *config = new DataPartitionConfig(2, dimensionConfigs);
+	config->configureDimensionOrder();
+	config->setLpsId(lpsId);
+	return config;
+}
+
+// generates and allocates all parts of the array for an LPS and registers them in the distribution tree
+LpsArrayParts *generateParts(DataPartitionConfig *partConfig, BranchingContainer *distributionTree) {
+
+	LpsArrayParts *parts = new LpsArrayParts();
+	parts->partConfig = partConfig;
+	parts->partsList = partConfig->generatePartList(1);
+	std::vector<DimConfig> dimOrder = *(partConfig->getDimensionOrder());
+	parts->partContainer = new PartListContainer(dimOrder[0]);
+
+	List<int*> *partId = partConfig->generatePartIdTemplate();
+	DataItemConfig *dataItemConfig = partConfig->generateStateFulVersion();
+	std::vector<LpsDimConfig> *distributionOrder = dataItemConfig->generateDimOrderVector();
+	int rows = partConfig->getPartsCountAlongDimension(0);
+	int cols = partConfig->getPartsCountAlongDimension(1);
+	int *lpuId = new int[2];
+	List<int*> *lpuIdChain = new List<int*>;
+	lpuIdChain->Append(lpuId);
+	for (int i = 0; i < rows; i++) {
+		for (int j = 0; j < cols; j++) {
+			lpuId[0] = i;
+			lpuId[1] = j;
+			partConfig->generatePartId(lpuIdChain, partId);
+			parts->partContainer->insertPartId(partId, 2, dimOrder);
+			distributionTree->insertPart(*distributionOrder, LOCAL_SEGMENT, partId);
+		}
+	}
+	parts->partsList->initializePartsList(partConfig, parts->partContainer, sizeof(double));
+	parts->partsList->allocateParts();
+	return parts;
+}
+
+// fills the parts with a pattern that depends on the iteration so that each transfer moves new content
+void fillParts(LpsArrayParts *parts, int iteration) {
+	List<DataPart*> *partList = parts->partsList->getPartList();
+	for (int i = 0; i < partList->NumElements(); i++) {
+		DataPart *part = partList->Nth(i);
+		double *data = reinterpret_cast<double*>(part->getData());
+		long int size = part->getMetadata()->getSize();
+		for (long int j = 0; j < size; j++) {
+			data[j] = iteration * 1000000.0 + i * 1000.0 + j;
+		}
+	}
+}
+
+// sums up the parts' content to compare the outcome of different buffer types
+double checksumParts(LpsArrayParts *parts) {
+	double checksum = 0;
+	List<DataPart*> *partList = parts->partsList->getPartList();
+	for (int i = 0; i < partList->NumElements(); i++) {
+		DataPart *part = partList->Nth(i);
+		double *data = reinterpret_cast<double*>(part->getData());
+		long int size = part->getMetadata()->getSize();
+		for (long int j = 0; j < size; j++) {
+			checksum += data[j] * ((i + j) % 7 + 1);
+		}
+	}
+	return checksum;
+}
+
+ConfinementConstructionConfig *generateConfinementConfig(LpsArrayParts *senderParts,
+		int senderLps,
+		LpsArrayParts *receiverParts,
+		int receiverLps, BranchingContainer *distributionTree) {
+
+	return new ConfinementConstructionConfig(LOCAL_SEGMENT,
+			senderLps, senderParts->partConfig->generateStateFulVersion(),
+			receiverLps, receiverParts->partConfig->generateStateFulVersion(),
+			ROOT_LPS,
+			senderParts->partContainer, receiverParts->partContainer,
+			distributionTree);
+}
+
+// instantiates buffers of a particular type for all data exchanges and times their setup
+List<CommBuffer*> *createBuffers(List<DataExchange*> *exchangeList,
+		SyncConfig *syncConfig,
+		CommBufferType type, bool intraSegment, double *setupTime) {
+
+	struct timeval start;
+	gettimeofday(&start, NULL);
+	List<CommBuffer*> *bufferList = new List<CommBuffer*>;
+	for (int i = 0; i < exchangeList->NumElements(); i++) {
+		DataExchange *exchange = exchangeList->Nth(i);
+		bufferList->Append(CommBufferFactory::createBuffer(type, exchange, syncConfig, intraSegment));
+	}
+	struct timeval end;
+	gettimeofday(&end, NULL);
+	*setupTime = getElapsedTime(start, end);
+	return bufferList;
+}
+
+// executes a number of transfers through the buffers and returns the average time per transfer excluding the first
+double runTransfers(List<CommBuffer*> *bufferList,
+		LpsArrayParts *senderParts, int transferCount) {
+
+	double totalTime = 0;
+	for (int t = 0; t <= transferCount; t++) {
+		fillParts(senderParts, t);
+		struct timeval start;
+		gettimeofday(&start, NULL);
+		for (int i = 0; i < bufferList->NumElements(); i++) {
+			CommBuffer *buffer = bufferList->Nth(i);
+			buffer->readData(false, std::cout);
+			buffer->writeData(false, std::cout);
+		}
+		struct timeval end;
+		gettimeofday(&end, NULL);
+		if (t > 0) totalTime += getElapsedTime(start, end);
+	}
+	return totalTime / transferCount;
+}
+
+int main(int argc, char *argv[]) {
+
+	const char *scenario = "ghost";
+	int arrayDimension = 1024;
+	int blockSize = 64;
+	int padding = 2;
+	int transferCount = 10;
+	if (argc > 1) scenario = argv[1];
+	if (argc > 2) arrayDimension = atoi(argv[2]);
+	if (argc > 3) blockSize = atoi(argv[3]);
+	if (argc > 4) padding = atoi(argv[4]);
+	if (argc > 5) transferCount = atoi(argv[5]);
+	bool ghostSync = (strcmp(scenario, "ghost") == 0);
+	if (!ghostSync && strcmp(scenario, "reorder") != 0) {
+		std::cout << "Usage: comm_buffer_benchmark [ghost|reorder] ";
+		std::cout << "[array dimension] [block size] [padding] [transfer count]\n";
+		std::exit(EXIT_FAILURE);
+	}
+	if (arrayDimension <= 0 || blockSize <= 0 || padding < 0 || transferCount <= 0) {
+		std::cout << "array dimension, block size, and transfer count must be positive\n";
+		std::exit(EXIT_FAILURE);
+	}
+
+	std::cout << "Communication buffer benchmark\n";
+	std::cout << "\tscenario: " << scenario << "\n";
+	std::cout << "\tarray: " << arrayDimension << " x " << arrayDimension << " doubles\n";
+	std::cout << "\tblock size: " << blockSize << ", padding: " << padding << "\n";
+	std::cout << "\ttransfers per buffer type: " << transferCount << "\n";
+
+	// generate the parts of the array for the LPSes involved in the synchronization
+	BranchingContainer *distributionTree = new BranchingContainer(0, LpsDimConfig());
+	DataPartitionConfig *senderConfig = generatePartitionConfig(SENDER_LPS,
+			arrayDimension, blockSize, 0, padding);
+	LpsArrayParts *senderParts = generateParts(senderConfig, distributionTree);
+	LpsArrayParts *receiverParts = senderParts;
+	int receiverLps = SENDER_LPS;
+	if (!ghostSync) {
+		// the receiver LPS has fewer but larger parts than the sender LPS
+		int blockCount = arrayDimension / (blockSize * 2);
+		if (blockCount < 1) blockCount = 1;
+		DataPartitionConfig *receiverConfig = generatePartitionConfig(RECEIVER_LPS,
+				arrayDimension, 0, blockCount, 0);
+		receiverParts = generateParts(receiverConfig, distributionTree);
+		receiverLps = RECEIVER_LPS;
+	}
+
+	// construct the data exchanges the same way the generated code does
+	struct timeval start;
+	gettimeofday(&start, NULL);
+	ConfinementConstructionConfig *exchangeConfig = generateConfinementConfig(senderParts, SENDER_LPS,
+			receiverParts, receiverLps, distributionTree);
+	List<Confinement*> *confinementList = Confinement::generateAllConfinements(exchangeConfig, ROOT_LPS);
+	List<DataExchange*> *exchangeList = new List<DataExchange*>;
+	if (confinementList != NULL) {
+		for (int i = 0; i < confinementList->NumElements(); i++) {
+			List<DataExchange*> *confinementExchanges = confinementList->Nth(i)->getAllDataExchanges();
+			if (confinementExchanges != NULL) {
+				exchangeList->AppendAll(confinementExchanges);
+				delete confinementExchanges;
+			}
+		}
+	}
+	struct timeval end;
+	gettimeofday(&end, NULL);
+	if (exchangeList->NumElements() == 0) {
+		std::cout << "the configuration does not need any data exchange\n";
+		std::exit(EXIT_FAILURE);
+	}
+	long int totalElements = 0;
+	for (int i = 0; i < exchangeList->NumElements(); i++) {
+		totalElements += exchangeList->Nth(i)->getTotalElementsCount();
+	}
+	std::cout << "\tdata exchanges: " << exchangeList->NumElements();
+	std::cout << " (" << totalElements << " elements)\n";
+	std::cout << "\tconfinement processing time: " << getElapsedTime(start, end) << " Seconds\n\n";
+
+	ConfinementConstructionConfig *bufferConfig = generateConfinementConfig(senderParts, SENDER_LPS,
+			receiverParts, receiverLps, distributionTree);
+	bufferConfig->configurePaddingInPartitionConfigsForReadWrite();
+	SyncConfig *syncConfig = new SyncConfig(bufferConfig,
+			senderParts->partsList, receiverParts->partsList, sizeof(double));
+
+	// run the transfers for each buffer type, physical and virtual, and report the timings
+	CommBufferType types[] = { PLAIN_BUFFER, PREPROCESSED_BUFFER, INDEX_MAPPED_BUFFER, SWIFT_INDEX_MAPPED_BUFFER };
+	std::cout << "buffer-type\tsetup-time\ttransfer-time\tchecksum\n";
+	for (int v = 0; v < 2; v++) {
+		bool intraSegment = (v == 1);
+		for (int t = 0; t < 4; t++) {
+			double setupTime = 0;
+			List<CommBuffer*> *bufferList = createBuffers(exchangeList,
+					syncConfig, types[t], intraSegment, &setupTime);
+			double transferTime = runTransfers(bufferList, senderParts, transferCount);
+			std::cout << CommBufferFactory::getTypeName(types[t]);
+			std::cout << (intraSegment ? "Virtual" : "Physical") << '\t';
+			std::cout << setupTime << '\t' << transferTime << '\t';
+			std::cout << checksumParts(receiverParts) << "\n";
+			while (bufferList->NumElements() > 0) {
+				delete bufferList->Nth(0);
+				bufferList->RemoveAt(0);
+			}
+			delete bufferList;
+		}
+	}
+
+	// finally let adaptive buffers choose types for the data exchanges
+	const char *dependency = "benchmark";
+	CommStatistics *commStat = new CommStatistics();
+	commStat->enlistDependency(dependency);
+	gettimeofday(&start, NULL);
+	List<CommBuffer*> *adaptiveBuffers = new List<CommBuffer*>;
+	for (int i = 0; i < exchangeList->NumElements(); i++) {
+		adaptiveBuffers->Append(new AdaptiveCommBuffer(exchangeList->Nth(i),
+				syncConfig, false, commStat, dependency));
+	}
+	gettimeofday(&end, NULL);
+	double adaptiveSetupTime = getElapsedTime(start, end);
+	double adaptiveTransferTime = runTransfers(adaptiveBuffers, senderParts, transferCount);
+	double settledTransferTime = runTransfers(adaptiveBuffers, senderParts, transferCount);
+	std::cout << "\nAdaptive\t" << adaptiveSetupTime << '\t' << adaptiveTransferTime;
+	std::cout << " (after selection " << settledTransferTime << ")\t";
+	std::cout << checksumParts(receiverParts) << "\n\n";
+	std::cout.flush();
+	std::ofstream statFile;
+	statFile.open("/dev/stdout", std::ofstream::out | std::ofstream::app);
+	commStat->logStatistics(0, statFile);
+	statFile.close();
+
+	return 0;
+}
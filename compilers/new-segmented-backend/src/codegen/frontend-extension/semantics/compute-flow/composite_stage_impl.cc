@@ -1,10 +1,18 @@
 #include "../../../utils/code_constant.h"
 #include "../../../../../../common-libs/utils/list.h"
+#include "../../../../../../frontend/src/semantics/task_space.h"
 #include "../../../../../../frontend/src/semantics/computation_flow.h"
+#include "../../../../../../frontend/src/semantics/partition_function.h"
 #include "../../../../../../frontend/src/static-analysis/sync_stat.h"
 #include "../../../../../../frontend/src/static-analysis/data_dependency.h"
+#include "../../../../../../frontend/src/syntax/ast.h"
+#include "../../../../../../frontend/src/syntax/ast_expr.h"
+#include "../../../../../../frontend/src/syntax/ast_type.h"
+#include "../../../../../../frontend/src/syntax/ast_library_fn.h"
 
 #include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -310,6 +318,90 @@ Space *CompositeStage::genSimplifiedSignalsForGroupTransitionsCode(std::ostream
 	return lastWaitingLps;
 }
 
+// A replicated data item may be updated only within a sub-flow activated by a condition of the form 'index in 
+// array.local.dimension.range' where the array dimension is divided by block_stride for the first time in the LPS
+// of the sub-flow. If the index is the loop index of a repeat cycle enclosing the communication then, in each 
+// iteration, a single LPU does the update and every segment can derive the segment of its PPU from the index. The 
+// communicator can then skip discovering the sender. This returns the activation condition when that is the case
+// and NULL otherwise.
+static RangeExpr *getUpdaterOwnerCondition(CompositeStage *communicatingStage, SyncRequirement *comm) {
+
+	// only the communicators of replicated data may have a different sender each time
+	if (dynamic_cast<ReplicationSync*>(comm) == NULL && dynamic_cast<DownPropagationSync*>(comm) == NULL) {
+		return NULL;
+	}
+
+	// the PPUs setting the sender before the send should be the same PPUs that receive the data; otherwise a
+	// PPU may change the sender while the data from the last update is still being received
+	FlowStage *source = comm->getDependencyArc()->getSource();
+	Space *signalingLps = source->getSpace();
+	if (strcmp(signalingLps->getName(), comm->getDependentLps()->getName()) != 0) return NULL;
+
+	// locate the conditional sub-flow doing the update
+	FlowStage *stage = source;
+	ConditionalExecutionBlock *conditionalBlock = NULL;
+	while (stage != NULL && stage != communicatingStage) {
+		conditionalBlock = dynamic_cast<ConditionalExecutionBlock*>(stage);
+		if (conditionalBlock != NULL) break;
+		stage = stage->getParent();
+	}
+	if (conditionalBlock == NULL || conditionalBlock->getSpace() != signalingLps) return NULL;
+	
+	// the condition should check an integer scalar against the local range of a dimension of an array
+	RangeExpr *condition = dynamic_cast<RangeExpr*>(conditionalBlock->getCondition());
+	if (condition == NULL) return NULL;
+	FieldAccess *index = condition->getIndex();
+	if (index == NULL || !index->isTerminalField() || index->getType() != Type::intType) return NULL;
+	FieldAccess *range = dynamic_cast<FieldAccess*>(condition->getRange());
+	if (range == NULL || range->isTerminalField() || strcmp(range->getField()->getName(), "range") != 0) {
+		return NULL;
+	}
+	FieldAccess *dimension = dynamic_cast<FieldAccess*>(range->getBase());
+	if (dimension == NULL || dynamic_cast<DimensionIdentifier*>(dimension->getField()) == NULL) return NULL;
+	const char *arrayName = condition->getBaseArrayForRange(signalingLps);
+	if (arrayName == NULL) return NULL;
+	bool localRange = false;
+	List<FieldAccess*> *fieldAccessList = new List<FieldAccess*>;
+	range->retrieveTerminalFieldAccesses(fieldAccessList);
+	for (int i = 0; i < fieldAccessList->NumElements(); i++) {
+		FieldAccess *fieldAccess = fieldAccessList->Nth(i);
+		if (strcmp(fieldAccess->getField()->getName(), arrayName) == 0) {
+			localRange = fieldAccess->isLocal();
+			break;
+		}
+	}
+	delete fieldAccessList;
+	if (!localRange) return NULL;
+
+	// the array dimension should be divided by block_stride in the LPS of the sub-flow and nowhere above it 
+	int dimensionNo = condition->getDimensionForRange(signalingLps);
+	ArrayDataStructure *array = (ArrayDataStructure*) signalingLps->getLocalStructure(arrayName);
+	PartitionFunctionConfig *partitionFn = array->getPartitionSpecForDimension(dimensionNo);
+	if (partitionFn == NULL || strcmp(partitionFn->getName(), StridedBlock::name) != 0) return NULL;
+	if (array->isPartitionedAlongDimensionEarlier(dimensionNo)) return NULL;
+
+	// the index should be the loop index of a repeat cycle enclosing both the update and the communication
+	const char *indexName = index->getField()->getName();
+	RepeatControlBlock *repeatBlock = NULL;
+	stage = communicatingStage;
+	while (stage != NULL) {
+		repeatBlock = dynamic_cast<RepeatControlBlock*>(stage);
+		if (repeatBlock != NULL) {
+			RangeExpr *loopRange = dynamic_cast<RangeExpr*>(repeatBlock->getCondition());
+			if (loopRange != NULL && loopRange->getIndex() != NULL 
+					&& strcmp(loopRange->getIndex()->getField()->getName(), indexName) == 0) break;
+			repeatBlock = NULL;
+		}
+		stage = stage->getParent();
+	}
+	if (repeatBlock == NULL) return NULL;
+	stage = conditionalBlock;
+	while (stage != NULL && stage != repeatBlock) stage = stage->getParent();
+	if (stage == NULL) return NULL;
+
+	return condition;
+}
+
 void CompositeStage::generateDataSendsForGroup(std::ofstream &stream, int indentation, 
 		List<SyncRequirement*> *commRequirements) {
 	
@@ -363,6 +455,20 @@ void CompositeStage::generateDataSendsForGroup(std::ofstream &stream, int indent
 		stream << "Communicator *communicator = threadState->getCommunicator(\"";
 		stream << currentComm->getDependencyArc()->getArcName() << "\")" << stmtSeparator;
 		stream << indentStr.str() << indent << "if (communicator != NULL) {\n";
+
+		// if the segment doing the update can be derived from the program state then let the communicator know it;
+		// the data is received before the next update so the setting remains valid until then
+		RangeExpr *ownerCondition = getUpdaterOwnerCondition(this, currentComm);
+		if (ownerCondition != NULL) {
+			const char *arrayName = ownerCondition->getBaseArrayForRange(signalingLps);
+			int dimensionNo = ownerCondition->getDimensionForRange(signalingLps);
+			stream << indentStr.str() << doubleIndent << "communicator->setKnownSender(";
+			stream << "threadState->getSegmentOfIndexOwner(Space_" << signalingLps->getName();
+			stream << paramSeparator << '\n' << indentStr.str() << doubleIndent << doubleIndent;
+			stream << "partConfigMap->Lookup(\"" << arrayName << "Space" << signalingLps->getName() << "Config\")";
+			stream << paramSeparator << dimensionNo - 1 << paramSeparator << ownerCondition->getIndexExpr();
+			stream << paramSeparator << "Threads_Per_Segment))" << stmtSeparator;
+		}
 		
 		// Check if the current communication is conditional, i.e., it only gets signaled by threads that
 		// executed a certain execution flow-stage. In that case, there will be a counter variable set to a
@@ -397,12 +503,70 @@ void CompositeStage::generateDataSendsForGroup(std::ofstream &stream, int indent
 	}
 }
 
+// Scatter writes are applied only after the PPU controllers are done with all LPUs of the scattering LPS. Update
+// signals for a scattered array whose readers are outside that LPS are uplifted to a composite stage enclosing the
+// LPU iteration, so they fire after the writes are applied. If the readers are within the same LPU iteration, 
+// however, the signals are issued before the writes and the readers would see stale data; so we reject such flows.
+static void checkScatteredArraySignals(CompositeStage *composite,
+		List<FlowStage*> *group, List<SyncRequirement*> *updateSignals) {
+
+	if (updateSignals->NumElements() == 0) return;
+	List<StageInstanciation*> *computeStages = new List<StageInstanciation*>;
+	List<FlowStage*> *pendingStages = new List<FlowStage*>;
+	pendingStages->AppendAll(group);
+	while (pendingStages->NumElements() > 0) {
+		FlowStage *stage = pendingStages->Nth(0);
+		pendingStages->RemoveAt(0);
+		StageInstanciation *computeStage = dynamic_cast<StageInstanciation*>(stage);
+		if (computeStage != NULL) {
+			computeStages->Append(computeStage);
+			continue;
+		}
+		CompositeStage *nestedComposite = dynamic_cast<CompositeStage*>(stage);
+		if (nestedComposite != NULL) pendingStages->AppendAll(nestedComposite->getStageList());
+	}
+	delete pendingStages;
+
+	for (int i = 0; i < computeStages->NumElements(); i++) {
+		StageInstanciation *computeStage = computeStages->Nth(i);
+		Space *scatterLps = computeStage->getSpace();
+
+		// the signals are issued within the LPU iteration of the scattering LPS only if the composite stage or
+		// one of its ancestors is the transition block of that LPS
+		bool withinLpuIteration = false;
+		for (FlowStage *stage = composite; stage != NULL; stage = stage->getParent()) {
+			if (dynamic_cast<LpsTransitionBlock*>(stage) != NULL && stage->getSpace() == scatterLps) {
+				withinLpuIteration = true;
+				break;
+			}
+		}
+		if (!withinLpuIteration) continue;
+
+		List<Scatter*> *scatterList = computeStage->getNestedScatters();
+		for (int j = 0; j < scatterList->NumElements(); j++) {
+			const char *arrayName = scatterList->Nth(j)->getTargetArrayName();
+			for (int k = 0; k < updateSignals->NumElements(); k++) {
+				const char *varName = updateSignals->Nth(k)->getVariableName();
+				if (strcmp(varName, arrayName) != 0) continue;
+				std::cout << "array '" << arrayName << "' is scattered in Space " << scatterLps->getName();
+				std::cout << " and read within the same LPU iteration before the scatter completes\n";
+				std::exit(EXIT_FAILURE);
+			}
+		}
+		delete scatterList;
+	}
+	delete computeStages;
+}
+
 void CompositeStage::generateInvocationCode(std::ofstream &stream, int indentation, Space *containerSpace) {
 
         // if the index is 0 then it is the first composite stage representing the entire compution. We declare any 
 	// synchronization counter that is applicable outside all repeat-control-block boundaries
         if (this->index == 0) {
                 declareSynchronizationCounters(stream, indentation, this->repeatIndex + 1);
+		// compute stages outside all repeat loops get their random streams for the iteration key 0
+		for (int i = 0; i < indentation; i++) stream << indent;
+		stream << "uint64_t iterationKey = 0" << stmtSeparator;
         }
 
 	// Iterate over groups of flow stages where each group executes within a single LPS. This scheme has the
@@ -436,6 +600,7 @@ void CompositeStage::generateInvocationCode(std::ofstream &stream, int indentati
 
 		// retrieve all shared data update signals that need to be activated if stages in the group execute
                 List<SyncRequirement*> *updateSignals = getUpdateSignalsOfGroup(currentGroup);
+                checkScatteredArraySignals(this, currentGroup, updateSignals);
                 // mark these signals as signaled so that they are not reactivated within the nested code
                 for (int j = 0; j < updateSignals->NumElements(); j++) {
                         updateSignals->Nth(j)->signal();
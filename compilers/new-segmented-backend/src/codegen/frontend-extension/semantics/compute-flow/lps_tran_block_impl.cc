@@ -5,6 +5,11 @@
 #include "../../../../../../frontend/src/semantics/task_space.h"
 #include "../../../../../../frontend/src/semantics/computation_flow.h"
 #include "../../../../../../frontend/src/static-analysis/reduction_info.h"
+#include "../../../../../../frontend/src/syntax/ast.h"
+#include "../../../../../../frontend/src/syntax/ast_expr.h"
+#include "../../../../../../frontend/src/syntax/ast_type.h"
+#include "../../../../../../frontend/src/syntax/ast_library_fn.h"
+#include "../../../../../../common-libs/utils/string_utils.h"
 
 #include <iostream>
 #include <fstream>
@@ -45,10 +50,22 @@ void LpsTransitionBlock::genReductionResultPreprocessingCode(std::ofstream &stre
 		stream << "lpuIdChain)" << stmtSeparator;
 
 		// assign the value of the reduction variable to proper thread-state property
-		ReductionOperator reductionOp = metadata->getOpCode();
-		if (reductionOp == MAX_ENTRY || reductionOp == MIN_ENTRY) {
-			std::cout << "Sorry, index reductions haven't been implemented yet.\n";
-			std::exit(EXIT_FAILURE);
+		ntransform::NameTransformer *transformer = ntransform::NameTransformer::transformer;
+		if (metadata->isIndexReduction()) {
+			// the property is an integer for a loop over a single index and an integer array otherwise; the
+			// result index is a global index that is checked to fit in the property in the large index mode
+			const char *propertyName = transformer->getTransformedName(resultVar, false, false);
+			int indexDimensions = metadata->getIndexDimensions();
+			if (indexDimensions == 1) {
+				stream << indentStr << propertyName << " = reduction::toIntegerIndex(";
+				stream << resultVar << "->index[0])" << stmtSeparator;
+			} else {
+				for (int d = 0; d < indexDimensions; d++) {
+					stream << indentStr << propertyName << "[" << d << "] = reduction::toIntegerIndex(";
+					stream << resultVar << "->index[" << d << "])" << stmtSeparator;
+				}
+			}
+			continue;
 		}
 		std::ostringstream resultPropertyStr;
                 resultPropertyStr << "data." << resultType->getCType() << "Value";
@@ -56,7 +73,6 @@ void LpsTransitionBlock::genReductionResultPreprocessingCode(std::ofstream &stre
                 std::ostringstream outputFieldStream;
                 outputFieldStream << resultVar << "->" << resultProperty;
                 std::string outputField = outputFieldStream.str();
-		ntransform::NameTransformer *transformer = ntransform::NameTransformer::transformer;
                 const char *propertyName = transformer->getTransformedName(resultVar, false, false);
                 stream << indentStr << propertyName << " = " << outputField << stmtSeparator;	
 	}
@@ -64,6 +80,143 @@ void LpsTransitionBlock::genReductionResultPreprocessingCode(std::ofstream &stre
 	stream << std::endl << indentStr << "} // scope exit for reduction result preparation\n";
 }
 
+void LpsTransitionBlock::genScanCompletionCode(std::ofstream &stream, int indentation) {
+
+	std::ostringstream indentStream;
+        for (int i = 0; i < indentation; i++) indentStream << indent;
+        std::string indentStr = indentStream.str();
+	List<ReductionMetadata*> *reductionInfoSet = space->getAllReductionConfigs();
+
+	for (int i = 0; i < reductionInfoSet->NumElements(); i++) {
+		ReductionMetadata *metadata = reductionInfoSet->Nth(i);
+		if (!metadata->isScan()) continue;
+
+		// the same LPS can be entered many times in the computation flow; only the transition block that
+		// holds the stage doing the scan should finish it 
+		bool scanNested = false;
+		FlowStage *ancestor = metadata->getExecutorStage();
+		while (ancestor != NULL) {
+			if (ancestor == this) {
+				scanNested = true;
+				break;
+			}
+			ancestor = ancestor->getParent();
+		}
+		if (!scanNested) continue;
+
+		// all PPU controllers participating in the scan should call the scan primitive after they are done
+		// with all their LPUs
+		const char *resultVar = metadata->getResultVar();
+		const char *execLpsName = metadata->getReductionExecutorLps()->getName();
+		stream << indentStr << "// finishing the scan of '" << resultVar << "'\n";
+		stream << indentStr << "if(threadState->isValidPpu(Space_" << execLpsName << ")) {\n";
+		stream << indentStr << indent << "ScanPrimitive *scanPrimitive = (ScanPrimitive*) ";
+		stream << "rdPrimitiveMap->Lookup(\"" << resultVar << "Scanner\")" << stmtSeparator;
+		stream << indentStr << indent << "scanPrimitive->completeScan()" << stmtSeparator;
+		stream << indentStr << "}\n";
+	}
+}
+
+// collects the compute stages nested within a composite stage, at any depth, that execute in the argument LPS
+static void collectStagesOfLps(CompositeStage *container, Space *lps, List<StageInstanciation*> *stageList) {
+	List<FlowStage*> *nestedStages = container->getStageList();
+	for (int i = 0; i < nestedStages->NumElements(); i++) {
+		FlowStage *stage = nestedStages->Nth(i);
+		StageInstanciation *computeStage = dynamic_cast<StageInstanciation*>(stage);
+		if (computeStage != NULL) {
+			if (computeStage->getSpace() == lps) stageList->Append(computeStage);
+			continue;
+		}
+		CompositeStage *composite = dynamic_cast<CompositeStage*>(stage);
+		if (composite != NULL) collectStagesOfLps(composite, lps, stageList);
+	}
+}
+
+void LpsTransitionBlock::genScatterCompletionCode(std::ofstream &stream, int indentation) {
+
+	std::ostringstream indentStream;
+        for (int i = 0; i < indentation; i++) indentStream << indent;
+        std::string indentStr = indentStream.str();
+	const char *spaceName = space->getName();
+
+	List<StageInstanciation*> *stageList = new List<StageInstanciation*>;
+	collectStagesOfLps(this, space, stageList);
+	for (int i = 0; i < stageList->NumElements(); i++) {
+		List<Scatter*> *scatterList = stageList->Nth(i)->getNestedScatters();
+		for (int j = 0; j < scatterList->NumElements(); j++) {
+			Scatter *scatter = scatterList->Nth(j);
+			const char *arrayName = scatter->getTargetArrayName();
+
+			// all PPU controllers that might have recorded elements at the call site should take part in the
+			// exchange; the elements are written to the parts of the array in the LPS allocating it
+			DataStructure *allocation = space->getStructure(arrayName)->getClosestAllocation();
+			const char *allocatorLpsName = allocation->getSpace()->getName();
+			stream << indentStr << "// applying the elements scattered into '" << arrayName << "'\n";
+			stream << indentStr << "if(threadState->isValidPpu(Space_" << spaceName << ")) {\n";
+			stream << indentStr << indent << arrayName << "Scatterer" << scatter->getCallSiteId();
+			stream << "->completeScatter(threadState->getTaskData()";
+			stream << "->getDataItemsOfLps(\"" << allocatorLpsName << "\"" << paramSeparator;
+			stream << "\"" << arrayName << "\"))" << stmtSeparator;
+			stream << indentStr << "}\n";
+		}
+		delete scatterList;
+	}
+	delete stageList;
+}
+
+RangeExpr *LpsTransitionBlock::getIndexOwnerCondition(Space *containerSpace) {
+
+	// the LPUs should be generated directly within the LPU of the container LPS; further, the results of the 
+	// reductions rooted at the LPS are prepared in each LPU regardless of any condition 
+	if (space->getDimensionCount() == 0 || space->getParent() != containerSpace) return NULL;
+	if (space->isRootOfSomeReduction()) return NULL;
+
+	// the conditional sub-flow should be the only thing to do in an LPU and no synchronization or communication
+	// should happen outside it
+	List<FlowStage*> *stages = filterOutSyncStages(stageList);
+	if (stages->NumElements() != 1) return NULL;
+	ConditionalExecutionBlock *conditionalBlock = dynamic_cast<ConditionalExecutionBlock*>(stages->Nth(0));
+	if (conditionalBlock == NULL || conditionalBlock->getSpace() != space) return NULL;
+	if (getDataDependeciesOfGroup(stageList)->NumElements() > 0) return NULL;
+	if (getUpdateSignalsOfGroup(stageList)->NumElements() > 0) return NULL;
+
+	// the condition should check an integer scalar, which is the same for all LPUs, against a dimension range
+	RangeExpr *condition = dynamic_cast<RangeExpr*>(conditionalBlock->getCondition());
+	if (condition == NULL) return NULL;
+	FieldAccess *index = condition->getIndex();
+	if (index == NULL || !index->isTerminalField() || index->getType() != Type::intType) return NULL;
+	FieldAccess *range = dynamic_cast<FieldAccess*>(condition->getRange());
+	if (range == NULL || range->isTerminalField() || strcmp(range->getField()->getName(), "range") != 0) {
+		return NULL;
+	}
+	FieldAccess *dimension = dynamic_cast<FieldAccess*>(range->getBase());
+	if (dimension == NULL || dynamic_cast<DimensionIdentifier*>(dimension->getField()) == NULL) return NULL;
+	const char *arrayName = condition->getBaseArrayForRange(space);
+	if (arrayName == NULL) return NULL;
+
+	// the range should be the local range of the dimension in the LPU, not the range of the whole dimension
+	bool localRange = false;
+	List<FieldAccess*> *fieldAccessList = new List<FieldAccess*>;
+	range->retrieveTerminalFieldAccesses(fieldAccessList);
+	for (int i = 0; i < fieldAccessList->NumElements(); i++) {
+		FieldAccess *fieldAccess = fieldAccessList->Nth(i);
+		if (strcmp(fieldAccess->getField()->getName(), arrayName) == 0) {
+			localRange = fieldAccess->isLocal();
+			break;
+		}
+	}
+	delete fieldAccessList;
+	if (!localRange) return NULL;
+
+	// the runtime can locate the part holding an index only if the dimension is divided for the first time in
+	// the current LPS 
+	int dimensionNo = condition->getDimensionForRange(space);
+	ArrayDataStructure *array = (ArrayDataStructure*) space->getLocalStructure(arrayName);
+	if (!array->isPartitionedAlongDimension(dimensionNo)) return NULL;
+	if (array->isPartitionedAlongDimensionEarlier(dimensionNo)) return NULL;
+	return condition;
+}
+
 void LpsTransitionBlock::generateInvocationCode(std::ofstream &stream, int indentation, Space *containerSpace) {
 
 	const char *spaceName = space->getName();
@@ -84,6 +237,18 @@ void LpsTransitionBlock::generateInvocationCode(std::ofstream &stream, int inden
 	stream << stmtSeparator;
 	// declare another variable to assign the value of get-Next-LPU call
 	stream << indentStr << "LPU *lpu = NULL" << stmtSeparator;
+	// if only the LPUs holding a particular index of some array can do anything then let the get-Next-LPU call
+	// skip the remaining LPUs without computing them
+	RangeExpr *ownerCondition = getIndexOwnerCondition(containerSpace);
+	if (ownerCondition != NULL) {
+		const char *arrayName = ownerCondition->getBaseArrayForRange(space);
+		int dimensionNo = ownerCondition->getDimensionForRange(space);
+		stream << indentStr << "threadState->restrictLpusToIndexOwner(Space_" << spaceName << paramSeparator;
+		stream << '\n' << indentStr << doubleIndent;
+		stream << "partConfigMap->Lookup(\"" << arrayName << "Space" << spaceName << "Config\")";
+		stream << paramSeparator << dimensionNo - 1;
+		stream << paramSeparator << ownerCondition->getIndexExpr() << ")" << stmtSeparator;
+	}
 	stream << indentStr << "while((lpu = threadState->getNextLpu(";
 	stream << "Space_" << spaceName << paramSeparator << "Space_" << containerSpace->getName();
 	stream << paramSeparator << "space" << spaceName << "LpuId)) != NULL) {\n";
@@ -105,6 +270,18 @@ void LpsTransitionBlock::generateInvocationCode(std::ofstream &stream, int inden
 	stream << "Lpu->id" << stmtSeparator;
 	stream << indentStr << indent << "space" << spaceName << "Iteration++" << stmtSeparator;
 	stream << indentStr << "}\n";
+	if (ownerCondition != NULL) {
+		stream << indentStr << "threadState->removeLpuRestriction(Space_" << spaceName << ")" << stmtSeparator;
+	}
+
+	// if some scans are rooted at the current LPS then their results can only be finalized after all LPUs are done
+	if (!space->isSingletonLps() && space->isRootOfSomeReduction()) {
+		genScanCompletionCode(stream, indentation);
+	}
+
+	// the writes of scatters done in the LPS are applied after all LPUs are done so that they do not interfere with
+	// the reads of any LPU 
+	genScatterCompletionCode(stream, indentation);
 
 	// at the end, remove LPS entry checkpoint checkpoint if the container LPS is not the root LPS
 	if (!containerSpace->isRoot()) {
@@ -101,6 +101,16 @@ void ReductionBoundaryBlock::generateInvocationCode(std::ofstream &stream, int i
 			stream << "rdPrimitive->reduce(localResult" << paramSeparator << "target" << paramSeparator;
 			stream << resultVar << ")" << stmtSeparator;
 
+			// for a scan, the reduced result of the LPU is only its contribution; it gets replaced by the
+			// scanned value when all LPUs of the LPS are done
+			if (reduction->isScan()) {
+				stream << indents.str() << indent;
+				stream << "ScanPrimitive *scanPrimitive = (ScanPrimitive*) rdPrimitiveMap->Lookup(\"";
+				stream << resultVar << "Scanner\")" << stmtSeparator;
+				stream << indents.str() << indent;
+				stream << "scanPrimitive->recordContribution(space" << space->getName() << "Lpu->id";
+				stream << paramSeparator << resultVar << ")" << stmtSeparator;
+			}
 		}
 		stream << indents.str() << "}\n";
         }
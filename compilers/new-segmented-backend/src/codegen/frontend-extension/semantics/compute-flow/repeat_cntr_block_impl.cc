@@ -21,6 +21,8 @@ void RepeatControlBlock::generateInvocationCode(std::ofstream &stream, int inden
 
 	// declare a repeat iteration number tracking variable
 	stream << indentStr << "int repeatIteration = 0" << stmtSeparator;
+	// keep the key of the iteration of enclosing repeat loops to derive keys for the iterations of this loop
+	stream << indentStr << "uint64_t enclosingIterationKey = iterationKey" << stmtSeparator;
 
 	// get the name of the lpu for the execution LPS
 	std::ostringstream lpuName;
@@ -63,6 +65,9 @@ void RepeatControlBlock::generateInvocationCode(std::ofstream &stream, int inden
 		rangeExpr->generateLoopForRangeExpr(rangeLoop, indentation, space);
 		stream << rangeLoop.str();
 	}
+	// the key of the current iteration identifies the random streams of the compute stages within the loop
+	stream << indentStr << indent << "uint64_t iterationKey = rng::nextIterationKey(";
+	stream << "enclosingIterationKey" << paramSeparator << "repeatIteration)" << stmtSeparator;
 	// declare all synchronization counter variables here that will be updated inside repeat loop 
 	declareSynchronizationCounters(stream, indentation + 1, this->repeatIndex + 1);
 
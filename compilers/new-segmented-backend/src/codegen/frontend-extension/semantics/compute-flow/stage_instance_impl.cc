@@ -2,6 +2,7 @@
 #include "../../../utils/name_transformer.h"
 #include "../../../../../../frontend/src/syntax/ast_expr.h"
 #include "../../../../../../frontend/src/syntax/ast_stmt.h"
+#include "../../../../../../frontend/src/syntax/ast_library_fn.h"
 #include "../../../../../../frontend/src/semantics/scope.h"
 #include "../../../../../../frontend/src/semantics/symbol.h"
 #include "../../../../../../frontend/src/semantics/task_space.h"
@@ -10,6 +11,7 @@
 #include "../../../../../../frontend/src/static-analysis/sync_stat.h"
 #include "../../../../../../frontend/src/static-analysis/reduction_info.h"
 #include "../../../../../../frontend/src/static-analysis/data_dependency.h"
+#include "../../../../../../common-libs/utils/string_utils.h"
 
 #include <fstream>
 #include <sstream>
@@ -58,7 +60,7 @@ void StageInstanciation::translateCode(std::ofstream &stream) {
 	
 	// create a local integer for holding intermediate values of transformed index during inclusion testing
 	stream << "\n\t// create a local transformed index variable for later use\n";
-        stream << indent << "int xformIndex" << stmtSeparator;
+        stream << indent << "GlobalIndex xformIndex" << stmtSeparator;
 
 	// if there is any array part argument with dimension range being limited with an index-range expression
 	// then adjust the metadata for the array
@@ -114,10 +116,39 @@ void StageInstanciation::translateCode(std::ofstream &stream) {
 	ntransform::NameTransformer::transformer->setLocalScalars(localVarList);
 
         // translate statements into C++ code
-	stream <<  computeHd;
 	std::ostringstream codeStream;
+	ntransform::NameTransformer *transformer = ntransform::NameTransformer::transformer;
+	transformer->setLpuRandomStreamAvailable(true);
+	transformer->resetLpuRandomStreamUsage();
 	code->generateCode(codeStream, 1, space);
-	stream << codeStream.str();
+	transformer->setLpuRandomStreamAvailable(false);
+	randomStreamUsed = transformer->isLpuRandomStreamUsed();
+
+	// if the computation uses random numbers, either through the random() library function or directly in some
+	// external code block, then retrieve the random stream of the current LPU for the current execution of the stage;
+	// the invocation code sets the LPU in the stream source of the thread before calling the stage
+	std::string translatedCode = codeStream.str();
+	if (randomStreamUsed) {
+		stream << "\n\t// retrieve the random number stream of the LPU\n";
+		stream << indent << "rng::RandomStream lpuRandomStream = threadLocals->randomStreams.getStream(";
+		stream << index << ")" << stmtSeparator;
+	}
+
+	// if the computation scatters elements into some arrays then retrieve the thread's buffers for recording them
+	List<Scatter*> *scatterList = getNestedScatters();
+	for (int i = 0; i < scatterList->NumElements(); i++) {
+		Scatter *scatter = scatterList->Nth(i);
+		const char *arrayName = scatter->getTargetArrayName();
+		if (i == 0) {
+			stream << "\n\t// retrieve the buffers for recording scattered elements\n";
+		}
+		stream << indent << "ScatterBuffer *" << arrayName << "ScatterBuffer" << scatter->getCallSiteId() << " = ";
+		stream << arrayName << "Scatterer" << scatter->getCallSiteId() << "->getThreadBuffer()" << stmtSeparator;
+	}
+	delete scatterList;
+
+	stream <<  computeHd;
+	stream << translatedCode;
 
         // finally return a successfull run indicator
 	stream <<  returnHd;
@@ -140,6 +171,15 @@ void StageInstanciation::generateInvocationCode(std::ofstream &stream, int inden
 	stream << indentStr.str() << "if (threadState->isValidPpu(Space_" << space->getName();
 	stream << ")) {\n";
 	
+	// if the stage uses random numbers then identify the LPU and the iteration of the enclosing repeat loops to
+	// select the random stream of the current execution of the stage
+	if (randomStreamUsed) {
+		stream << nextIndent.str() << "threadLocals->randomStreams.setCurrentLpu(Space_" << space->getName();
+		stream << paramSeparator << "threadState->getLpuIdChainKey(Space_" << space->getName();
+		stream << paramSeparator << "Space_" << space->getRoot()->getName() << ")";
+		stream << paramSeparator << "iterationKey)" << stmtSeparator;
+	}
+
 	// invoke the related method with current LPU parameter ...
 	stream << nextIndent.str() << "// invoking user computation\n";
 	stream << nextIndent.str();
@@ -1,10 +1,12 @@
 #include "../../../utils/array_assignment.h"
+#include "../../../utils/task_dependency.h"
 #include "../../../../../../frontend/src/syntax/ast_def.h"
 #include "../../../../../../frontend/src/syntax/ast_stmt.h"
 #include "../../../../../../frontend/src/semantics/scope.h"
 #include "../../../../../../frontend/src/semantics/data_access.h"
 
 #include <sstream>
+#include <iostream>
 
 void CoordinatorDef::declareVariablesInScope(std::ostringstream &stream, int indent) {
         executionScope->declareVariables(stream, indent);
@@ -21,6 +23,14 @@ void CoordinatorDef::generateCode(std::ostringstream &stream, Scope *scope) {
         TaskGlobalReferences *references = new TaskGlobalReferences(execScope);
 	code->getAccessedGlobalVariables(references);
 
+        // determine which task invocations depend on which others through the environmental data structures they
+	// share; the result is reported and each invocation's dependencies are noted in the generated code
+	TaskDependencyAnalyzer *analysis = new TaskDependencyAnalyzer();
+	analysis->analyzeProgram(code);
+	std::cout << "\tTask invocation dependencies in the coordinator program:\n";
+	analysis->describe(std::cout);
+	TaskDependencyAnalyzer::coordinatorAnalysis = analysis;
+
         // set the context for code translation to coordinator function
         codecntx::enterCoordinatorContext();
 
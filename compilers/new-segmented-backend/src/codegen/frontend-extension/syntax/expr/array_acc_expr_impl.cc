@@ -9,6 +9,17 @@
 #include <cstdlib>
 #include <stack>
 
+// writes the number of elements in the part of an array the current LPU refers to; the sub-arrays of the fields in
+// the structure-of-arrays layout are as long as that
+static void generateSoaPartLength(std::ostringstream &stream, const char *arrayName, ArrayType *arrayType) {
+	stream << '(';
+	for (int i = 0; i < arrayType->getDimensions(); i++) {
+		if (i > 0) stream << " * ";
+		stream << "((long) (" << arrayName << "StoreDims[" << i << "].length))";
+	}
+	stream << ')';
+}
+
 void ArrayAccess::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {
 	Type *baseType = base->getType();
 	if (dynamic_cast<StaticArrayType*>(baseType) != NULL) {
@@ -21,18 +32,54 @@ void ArrayAccess::translate(std::ostringstream &stream, int indentLevel, int cur
 		// an access to a dynamic task global variable. Therefore we can assume that the base of this array
 		// access has the name of that variable and its type is an array type.
 		Expr *endpoint = getEndpointOfArrayAccess();
-		endpoint->translate(stream, indentLevel, currentLineLength, space);
 		std::ostringstream indexStream;
 		ArrayType *arrayType = (ArrayType*) endpoint->getType();
 		const char *arrayName = endpoint->getBaseVarName();
 		// we now translate a possibly multidimensional array access into a unidimensional access as arrays
 		// are stored as 1D memory blocks in the back-end
 		generate1DIndexAccess(indexStream, indentLevel, arrayName, arrayType, space);
+		
+		// an element of an array in the structure-of-arrays layout is accessed through a view object that
+		// refers to the fields of the element in their sub-arrays
+		if (isSoaLayoutElementAccess()) {
+			std::ostringstream partStream;
+			endpoint->translate(partStream, indentLevel, currentLineLength, space);
+			stream << type->getCType() << "_SoaView((char*) " << partStream.str() << paramSeparator;
+			generateSoaPartLength(stream, arrayName, arrayType);
+			stream << paramSeparator << indexStream.str() << ")";
+			return;
+		}
+		endpoint->translate(stream, indentLevel, currentLineLength, space);
 		// then we write the index access logic in the array
 		stream << '[' << indexStream.str() << ']';
 	}
 }
 
+bool ArrayAccess::isSoaLayoutElementAccess() {
+	if (dynamic_cast<StaticArrayType*>(base->getType()) != NULL) return false;
+	Expr *endpoint = getEndpointOfArrayAccess();
+	ArrayType *arrayType = dynamic_cast<ArrayType*>(endpoint->getType());
+	if (arrayType == NULL || getIndexPosition() != arrayType->getDimensions() - 1) return false;
+	ntransform::NameTransformer *transformer = ntransform::NameTransformer::transformer;
+	return transformer->hasSoaLayout(endpoint->getBaseVarName());
+}
+
+void ArrayAccess::translateSoaFieldAccess(std::ostringstream &stream, int indentLevel, 
+		const char *fieldName, Space *space) {
+	
+	// a field access directly indexes the sub-array of the field without creating a view of the whole element
+	Expr *endpoint = getEndpointOfArrayAccess();
+	ArrayType *arrayType = (ArrayType*) endpoint->getType();
+	const char *arrayName = endpoint->getBaseVarName();
+	std::ostringstream indexStream;
+	generate1DIndexAccess(indexStream, indentLevel, arrayName, arrayType, space);
+	stream << type->getCType() << "_SoaView::" << fieldName << "Field((char*) ";
+	endpoint->translate(stream, indentLevel, 0, space);
+	stream << paramSeparator;
+	generateSoaPartLength(stream, arrayName, arrayType);
+	stream << ")[" << indexStream.str() << ']';
+}
+
 void ArrayAccess::generate1DIndexAccess(std::ostringstream &stream, int indentLevel, 
 		const char *array, ArrayType *type, Space *space) {
 	
@@ -54,7 +101,7 @@ void ArrayAccess::generate1DIndexAccess(std::ostringstream &stream, int indentLe
 	} else {
 		std::ostringstream indexStream;
 		index->translate(indexStream, 0, 0, space);
-		stream << "((long) (";
+		stream << "((long) ((LocalOffset) (";
 		// if the current dimension is reordered at any point then we need an elaborate original to transformed
 		// index conversion to be able to locate the storage address for the array index
 		ArrayDataStructure *structure = (ArrayDataStructure*) space->getLocalStructure(array);
@@ -65,7 +112,7 @@ void ArrayAccess::generate1DIndexAccess(std::ostringstream &stream, int indentLe
 			stream << indexStream.str();
 		}
                 stream << " - " << array << "StoreDims[" << dimension << "].range.min";
-		stream << "))";
+		stream << ")))";
 		std::ostringstream xform;
                 for (int i = dimensionCount - 1; i > dimension; i--) {
                         stream << " * ((long) (" << array << "StoreDims[" << i << "].length))";
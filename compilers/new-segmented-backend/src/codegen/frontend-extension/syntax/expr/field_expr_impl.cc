@@ -20,6 +20,14 @@ void FieldAccess::translate(std::ostringstream &stream, int indentLevel, int cur
 			return;
 		}
 
+		// a field of an element of an array in the structure-of-arrays layout is accessed in its sub-array
+		ArrayAccess *elementAccess = dynamic_cast<ArrayAccess*>(base);
+		if (elementAccess != NULL && elementAccess->isSoaLayoutElementAccess()) {
+			elementAccess->translateSoaFieldAccess(stream, 
+					indentLevel, field->getName(), space);
+			return;
+		}
+
 		// call the translate function recursively on base if it is not null
 		base->translate(stream, indentLevel, currentLineLength, space);
 		
@@ -2,6 +2,7 @@
 #include "../../../../../../frontend/src/syntax/ast_expr.h"
 #include "../../../../../../frontend/src/semantics/task_space.h"
 #include "../../../utils/code_constant.h"
+#include "../../../utils/name_transformer.h"
 
 #include <sstream>
 #include <cstdlib>
@@ -22,7 +23,29 @@ void Root::translate(std::ostringstream &stream, int indentLevel, int currentLin
 }
 
 void Random::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {
-	stream << "rand()";
+	
+	// within a compute stage, random numbers come from the counter-based random stream of the current LPU so that
+	// they are reproducible regardless of the mapping; elsewhere they come from a stream private to the thread 
+	if (ntransform::NameTransformer::transformer->isLpuRandomStreamAvailable()) {
+		ntransform::NameTransformer::transformer->markLpuRandomStreamUsed();
+		stream << "lpuRandomStream.nextInt()";
+	} else {
+		stream << "rng::nextThreadLocalInt()";
+	}
+}
+
+void Scatter::translate(std::ostringstream &stream, int indentLevel, int currentLineLength, Space *space) {
+	
+	// the write only gets recorded in the scatter buffer of the PPU controller; it is applied to the array when
+	// all LPUs of the LPS are done
+	Expr *indexArg = arguments->Nth(1);
+	Expr *valueArg = arguments->Nth(2);
+	stream << getTargetArrayName() << "ScatterBuffer" << callSiteId << "->addElement";
+	stream << '<' << getElementType()->getCType() << ">(";
+	indexArg->translate(stream, indentLevel);
+	stream << paramSeparator;
+	valueArg->translate(stream, indentLevel);
+	stream << ")";
 }
 
 void LoadArray::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {
@@ -161,6 +184,7 @@ void BindInput::generateCode(std::ostringstream &stream, int indentLevel, Space
 	stream << indents << "instr->setFileName(";
 	arg3->translate(stream, indentLevel);
 	stream << ")" << stmtSeparator;
+	stream << indents << "instr->startPrefetch()" << stmtSeparator;
 	stream << indents; 
 	arg1->translate(stream, indentLevel);
 	stream << "->addInitEnvInstruction(instr)" << stmtSeparator;
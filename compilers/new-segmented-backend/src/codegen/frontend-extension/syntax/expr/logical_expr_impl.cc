@@ -132,8 +132,8 @@ List<LogicalExpr*> *LogicalExpr::getIndexRestrictExpr(List<LogicalExpr*> *exprLi
 
 		// initially assign the index start and end bounds that are applied by default to some
 		// local variables
-		stream << indent.str() << "int localIterationStart = iterationStart" << stmtSeparator; 	
-		stream << indent.str() << "int localIterationBound = iterationBound" << stmtSeparator;
+		stream << indent.str() << "GlobalIndex localIterationStart = iterationStart" << stmtSeparator; 	
+		stream << indent.str() << "GlobalIndex localIterationBound = iterationBound" << stmtSeparator;
 
 		// generate an if else block that will check if the index is increasing or decreasing
 		// and based on that apply appropriate restrictions
@@ -150,9 +150,9 @@ void RangeExpr::generateLoopForRangeExpr(std::ostringstream &stream,
 
         // create three new variables for setting appropriate loop  condition checking and index 
         // increment, and one variable to multiply index properly during looping
-        stream << indent.str() << "int iterationStart = " << rangeCond << ".min";
+        stream << indent.str() << "GlobalIndex iterationStart = " << rangeCond << ".min";
         stream << stmtSeparator;
-        stream << indent.str() << "int iterationBound = " << rangeCond << ".max";
+        stream << indent.str() << "GlobalIndex iterationBound = " << rangeCond << ".max";
         stream << stmtSeparator;
         stream << indent.str() << "int indexIncrement = " << stepCond << stmtSeparator;
         stream << indent.str() << "int indexMultiplier = 1" << stmtSeparator;
@@ -166,7 +166,7 @@ void RangeExpr::generateLoopForRangeExpr(std::ostringstream &stream,
         std::ostringstream indexVarUsed;
         if (involveIndexXform) {
         	indexVarUsed << getIndexExpr() << "Xformed";
-                stream << indent.str() << "int " << indexVarUsed.str() << stmtSeparator;
+                stream << indent.str() << "GlobalIndex " << indexVarUsed.str() << stmtSeparator;
         } else indexVarUsed << indexVar;
 
 	// if there is a loop restriction condition passed by the caller then apply it before creating the for loop
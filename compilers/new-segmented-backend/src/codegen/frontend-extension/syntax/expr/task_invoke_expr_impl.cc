@@ -4,41 +4,76 @@
 #include "../../../../../../frontend/src/semantics/task_space.h"
 #include "../../../utils/code_constant.h"
 #include "../../../utils/task_generator.h"
+#include "../../../utils/task_dependency.h"
 
 #include <sstream>
 #include <iostream>
 #include <cstdlib>
 
+// translates the environment argument of an invocation into the name of the environment object
+static const char *getEnvObjectName(TaskInvocation *invocation, Space *space) {
+	std::ostringstream envStream;
+	FieldAccess *envArg = invocation->getEnvArgument();
+	envArg->translate(envStream, 0, 0, space);
+	return strdup(envStream.str().c_str());
+}
+
+// generates the statements that prepare the task environment and the partition object of an invocation right before
+// the task gets executed
+static void generateInvocationSetup(std::ostringstream &stream, 
+		const char *indent, TaskInvocation *invocation, const char *envName) {
+
+	TupleDef *partitionTuple = invocation->getTaskDef()->getPartitionTuple();
+
+	// first invoke the task environment's linked arrays' dimensions initialization function as the dimension
+	// lengths will be needed to construct task's partition hierarchy
+	stream << indent << envName << "->setupItemsDimensions()" << stmtSeparator;        
+
+	// assign a task invocation Id to the environment for the upcoming task and increase the inocation id for
+	// later usage
+	stream << indent << envName << "->setTaskId(taskId)" << stmtSeparator;
+	stream << indent << "taskId++" << stmtSeparator;
+	
+	// create a partition object for the task
+	stream << indent << partitionTuple->getId()->getName() << " partition" << stmtSeparator;
+
+	// populate properties of the partition tuple
+	List<Expr*> *partitionArgs = invocation->getPartitionArguments();
+	if (partitionArgs != NULL && partitionArgs->NumElements() > 0) {
+
+		List<VariableDef*> *tupleParts = partitionTuple->getComponents();
+		for (int i = 0; i < partitionArgs->NumElements(); i++) {
+			stream << indent;
+			const char *propertyName = tupleParts->Nth(i)->getId()->getName();
+			stream << "partition." << propertyName;
+			stream << " = ";
+			partitionArgs->Nth(i)->translate(stream, 0);
+			stream << stmtSeparator;
+		}
+	}
+}
+
 void TaskInvocation::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {
 	
-	TupleDef *partitionTuple = taskDef->getPartitionTuple();
         std::ostringstream indent;
         for (int i = 0; i < indentLevel; i++) indent << '\t';
 
 	const char *taskName = getTaskName();
         stream << indent.str() << "{ // scope starts for invoking: " << taskName << "\n";
+
+	// note the invocations the current one depends on according to the coordinator program's dependency analysis
+	TaskDependencyAnalyzer *analysis = TaskDependencyAnalyzer::coordinatorAnalysis;
+	if (analysis != NULL) {
+		analysis->generateDependencyComment(stream, this, indentLevel);
+	}
 	/*
 	stream << indent.str() << "logFile << \"going to execute task: " << taskName;
 	stream << "\\n\"" << stmtSeparator;
 	stream << indent.str() << "logFile.flush()" << stmtSeparator;
 	*/
 
-	std::ostringstream envStream;
-	FieldAccess *envArg = getEnvArgument();
-	envArg->translate(envStream, 0, 0, space);
-	const char *envName = strdup(envStream.str().c_str());
-
-	// first invoke the task environment's linked arrays' dimensions initialization function as the dimension
-	// lengths will be needed to construct task's partition hierarchy
-	stream << indent.str() << envName << "->setupItemsDimensions()" << stmtSeparator;        
-
-	// assign a task invocation Id to the environment for the upcoming task and increase the inocation id for
-	// later usage
-	stream << indent.str() << envName << "->setTaskId(taskId)" << stmtSeparator;
-	stream << indent.str() << "taskId++" << stmtSeparator;
-	
-	// create a partition object for the task
-	stream << indent.str() << partitionTuple->getId()->getName() << " partition" << stmtSeparator;
+	const char *envName = getEnvObjectName(this, space);
+	generateInvocationSetup(stream, indent.str().c_str(), this, envName);
 
 	// collect initialization arguments into a stream, if exist
 	std::ostringstream initParams;
@@ -53,21 +88,6 @@ void TaskInvocation::generateCode(std::ostringstream &stream, int indentLevel, S
 		}
 	}
 
-	// populate properties of the partition tuple
-	List<Expr*> *partitionArgs = getPartitionArguments();
-	if (partitionArgs != NULL && partitionArgs->NumElements() > 0) {
-
-		List<VariableDef*> *tupleParts = partitionTuple->getComponents();
-		for (int i = 0; i < partitionArgs->NumElements(); i++) {
-			stream << indent.str();
-			const char *propertyName = tupleParts->Nth(i)->getId()->getName();
-			stream << "partition." << propertyName;
-			stream << " = ";
-			partitionArgs->Nth(i)->translate(stream, 0);
-			stream << stmtSeparator;
-		}
-	}
-
 	// then invoke the task with appropriate parameters
 	stream << indent.str();
 	stream << TaskGenerator::getNamespace(taskDef) << "::execute(";
@@ -82,3 +102,70 @@ void TaskInvocation::generateCode(std::ostringstream &stream, int indentLevel, S
 
 	stream << indent.str() << "} // scope ends for task invocation\n";
 }
+
+void TaskInvocation::generateConcurrentLaunch(std::ostringstream &stream, 
+		int indentLevel, Space *space, List<TaskInvocation*> *invocations) {
+
+        std::ostringstream indent;
+        for (int i = 0; i < indentLevel; i++) indent << '\t';
+	std::ostringstream nextIndent;
+	nextIndent << indent.str() << '\t';
+	std::ostringstream innerIndent;
+	innerIndent << nextIndent.str() << '\t';
+
+	stream << indent.str() << "{ // scope starts for the concurrent launch of independent task invocations\n";
+	stream << nextIndent.str() << "TaskLaunchGroup launchGroup(segmentId" << paramSeparator;
+	stream << "logFile)" << stmtSeparator;
+
+	TaskDependencyAnalyzer *analysis = TaskDependencyAnalyzer::coordinatorAnalysis;
+	List<const char*> *envNames = new List<const char*>;
+	for (int i = 0; i < invocations->NumElements(); i++) {
+
+		TaskInvocation *invocation = invocations->Nth(i);
+		TaskDef *taskDef = invocation->getTaskDef();
+		const char *taskNamespace = TaskGenerator::getNamespace(taskDef);
+		stream << nextIndent.str() << "{ // scope starts for launching: " << invocation->getTaskName() << "\n";
+		if (analysis != NULL) {
+			analysis->generateDependencyComment(stream, invocation, indentLevel + 1);
+		}
+
+		// reserve processors for the PPU controller threads of the task that do not overlap with those of the
+		// invocations still running; this waits for the earlier invocations to finish if they cannot be found
+		stream << innerIndent.str() << "TaskPlacement placement" << stmtSeparator;
+		stream << innerIndent.str() << taskNamespace << "::describePlacement(segmentId";
+		stream << paramSeparator << "&placement)" << stmtSeparator;
+		stream << innerIndent.str() << "launchGroup.prepareLaunch(&placement)" << stmtSeparator;
+
+		const char *envName = getEnvObjectName(invocation, space);
+		envNames->Append(envName);
+		generateInvocationSetup(stream, innerIndent.str().c_str(), invocation, envName);
+
+		// the arguments of the execute function are handed over to the thread that runs it
+		stream << innerIndent.str() << taskNamespace << "::ExecuteArgs *executeArgs = new ";
+		stream << taskNamespace << "::ExecuteArgs" << stmtSeparator;
+		stream << innerIndent.str() << "executeArgs->environment = " << envName << stmtSeparator;
+		List<Expr*> *initArgs = invocation->getInitArguments();
+		if (initArgs != NULL && initArgs->NumElements() > 0) {
+			List<const char*> *argNames = taskDef->getInitSection()->getArguments();
+			for (int j = 0; j < initArgs->NumElements(); j++) {
+				stream << innerIndent.str() << "executeArgs->" << argNames->Nth(j) << " = ";
+				initArgs->Nth(j)->translate(stream, 0);
+				stream << stmtSeparator;
+			}
+		}
+		stream << innerIndent.str() << "executeArgs->partition = partition" << stmtSeparator;
+		stream << innerIndent.str() << "executeArgs->segmentId = segmentId" << stmtSeparator;
+		stream << innerIndent.str() << "launchGroup.launch(" << taskNamespace << "::executeInLaunchSlot";
+		stream << paramSeparator << "executeArgs)" << stmtSeparator;
+		stream << nextIndent.str() << "} // scope ends for launching: " << invocation->getTaskName() << "\n";
+	}
+
+	// wait for all invocations to finish then reset the environment update instructions of all of them
+	stream << nextIndent.str() << "launchGroup.waitForAll()" << stmtSeparator;
+	for (int i = 0; i < envNames->NumElements(); i++) {
+		stream << nextIndent.str() << envNames->Nth(i) << "->resetEnvInstructions()" << stmtSeparator;
+	}
+	delete envNames;
+
+	stream << indent.str() << "} // scope ends for the concurrent launch\n";
+}
@@ -1,5 +1,6 @@
 #include "../../../utils/task_global.h"
 #include "../../../utils/code_constant.h"
+#include "../../../utils/name_transformer.h"
 #include "../../../../../../common-libs/utils/list.h"
 #include "../../../../../../frontend/src/syntax/ast_stmt.h"
 #include "../../../../../../frontend/src/syntax/ast_task.h"
@@ -86,6 +87,12 @@ void ExternCodeBlock::generateCode(std::ostringstream &stream, int indentLevel,
 		declareReplacementVars(stream, indents, space);
 	}
 
+	// the external code may use the random stream of the LPU within a compute stage; as the code is opaque to the
+	// compiler, the stream is always made available to it
+	if (ntransform::NameTransformer::transformer->isLpuRandomStreamAvailable()) {
+		ntransform::NameTransformer::transformer->markLpuRandomStreamUsed();
+	}
+
 	// jumping into the external code block within a further nested block
 	stream << '\n' << indents << "{ // external code block starts\n";
 	stream << codeBlock;
@@ -51,7 +51,7 @@ void LoopStmt::generateIndexLoops(std::ostringstream &stream, int indentLevel,
 			forbiddenIndexes->Append(index);
 			forbidden = true;
 			// declare the initialized index variable
-			stream << indent.str() << "int " << association->getIndex() << " = ";
+			stream << indent.str() << "GlobalIndex " << association->getIndex() << " = ";
 			ntransform::NameTransformer *transformer = ntransform::NameTransformer::transformer;
 			stream << transformer->getTransformedName(arrayName, true, true);
 			stream << '[' << dimensionNo << "].range.min;\n"; 
@@ -75,7 +75,7 @@ void LoopStmt::generateIndexLoops(std::ostringstream &stream, int indentLevel,
 
 		if (!forbidden) {
 			// declare the uninitialized index variable
-			stream << indent.str() << "int " << index << ";\n"; 
+			stream << indent.str() << "GlobalIndex " << index << ";\n"; 
 			// convert the index access to a range loop iteration and generate code for that
 			DataStructure *structure = space->getLocalStructure(association->getArray());
 			RangeExpr *rangeExpr = association->convertToRangeExpr(structure->getType());
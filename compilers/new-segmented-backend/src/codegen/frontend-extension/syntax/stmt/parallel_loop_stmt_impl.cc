@@ -1,9 +1,343 @@
+#include "../../../utils/code_constant.h"
 #include "../../../../../../common-libs/utils/list.h"
+#include "../../../../../../frontend/src/common/constant.h"
 #include "../../../../../../frontend/src/syntax/ast_stmt.h"
+#include "../../../../../../frontend/src/syntax/ast_expr.h"
+#include "../../../../../../frontend/src/syntax/ast_type.h"
 #include "../../../../../../frontend/src/semantics/task_space.h"
+#include "../../../../../../frontend/src/semantics/loop_index.h"
+
 #include <sstream>
+#include <cstring>
 
 void PLoopStmt::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {
+	if (generateMatrixMultiplyCall(stream, indentLevel, space)) return;
 	List<LogicalExpr*> *restrictions = getIndexRestrictions();
         LoopStmt::generateIndexLoops(stream, indentLevel, space, body, restrictions);
 }
+
+// If the argument expression is an element access of the form 'x[r][c]' on a dynamic two dimensional array where
+// both r and c are plain loop indexes then returns the terminal field access for the array and sets the names of the
+// two indexes in the output parameters; otherwise returns NULL.
+static FieldAccess *getTwoIndexAccess(Expr *expr, const char **rowIndex, const char **columnIndex) {
+
+	ArrayAccess *columnAccess = dynamic_cast<ArrayAccess*>(expr);
+	if (columnAccess == NULL) return NULL;
+	ArrayAccess *rowAccess = dynamic_cast<ArrayAccess*>(columnAccess->getBase());
+	if (rowAccess == NULL) return NULL;
+	FieldAccess *array = dynamic_cast<FieldAccess*>(rowAccess->getBase());
+	if (array == NULL || !array->isTerminalField()) return NULL;
+	ArrayType *arrayType = dynamic_cast<ArrayType*>(array->getType());
+	if (arrayType == NULL || dynamic_cast<StaticArrayType*>(arrayType) != NULL) return NULL;
+	if (arrayType->getDimensions() != 2) return NULL;
+
+	FieldAccess *row = dynamic_cast<FieldAccess*>(rowAccess->getIndex());
+	FieldAccess *column = dynamic_cast<FieldAccess*>(columnAccess->getIndex());
+	if (row == NULL || !row->isTerminalField() || !row->isIndex()) return NULL;
+	if (column == NULL || !column->isTerminalField() || !column->isIndex()) return NULL;
+	*rowIndex = row->getField()->getName();
+	*columnIndex = column->getField()->getName();
+	return array;
+}
+
+// checks if the two argument terminal field accesses refer to the same version of the same array
+static bool isSameArray(FieldAccess *first, FieldAccess *second) {
+	return strcmp(first->getField()->getName(), second->getField()->getName()) == 0
+			&& first->getEpochVersion() == second->getEpochVersion();
+}
+
+// if the argument statement is a single statement or a statement block having a single statement then returns that
+// statement as an assignment if it is one; otherwise returns NULL
+static AssignmentExpr *getSingleAssignment(Stmt *stmt) {
+	StmtBlock *block = dynamic_cast<StmtBlock*>(stmt);
+	if (block != NULL) {
+		List<Stmt*> *stmts = block->getStmts();
+		if (stmts->NumElements() != 1) return NULL;
+		stmt = stmts->Nth(0);
+	}
+	Expr *expr = dynamic_cast<Expr*>(stmt);
+	if (expr == NULL || expr->getExprTypeId() != ASSIGN_EXPR) return NULL;
+	return (AssignmentExpr*) expr;
+}
+
+// if the argument expression is a terminal access to a scalar variable that is not a loop index then returns it;
+// otherwise returns NULL
+static FieldAccess *getScalarAccess(Expr *expr) {
+	FieldAccess *scalar = dynamic_cast<FieldAccess*>(expr);
+	if (scalar == NULL || !scalar->isTerminalField() || scalar->isIndex()) return NULL;
+	if (dynamic_cast<ArrayType*>(scalar->getType()) != NULL) return NULL;
+	return scalar;
+}
+
+// checks if the argument expression is a numeric constant zero
+static bool isZeroConstant(Expr *expr) {
+	IntConstant *intConstant = dynamic_cast<IntConstant*>(expr);
+	if (intConstant != NULL) return intConstant->getValue() == 0;
+	FloatConstant *floatConstant = dynamic_cast<FloatConstant*>(expr);
+	if (floatConstant != NULL) return floatConstant->getValue() == 0;
+	DoubleConstant *doubleConstant = dynamic_cast<DoubleConstant*>(expr);
+	if (doubleConstant != NULL) return doubleConstant->getValue() == 0;
+	return false;
+}
+
+// If the argument expression is 'c[i][j] + x', 'x + c[i][j]', or 'c[i][j] - x' for the argument array and indexes
+// then returns x and sets the sign x contributes to c[i][j] with in the output parameter; otherwise returns NULL.
+static Expr *getArrayUpdateOperand(Expr *expr, FieldAccess *c, const char *i, const char *j, int *alpha) {
+
+	if (expr->getExprTypeId() != ARITH_EXPR) return NULL;
+	ArithmaticExpr *update = (ArithmaticExpr*) expr;
+	if (update->getOp() != ADD && update->getOp() != SUBTRACT) return NULL;
+	const char *updateRow, *updateColumn;
+	Expr *operand = update->getRight();
+	FieldAccess *updated = getTwoIndexAccess(update->getLeft(), &updateRow, &updateColumn);
+	if (updated == NULL && update->getOp() == ADD) {
+		updated = getTwoIndexAccess(update->getRight(), &updateRow, &updateColumn);
+		operand = update->getLeft();
+	}
+	if (updated == NULL || !isSameArray(c, updated)) return NULL;
+	if (strcmp(updateRow, i) != 0 || strcmp(updateColumn, j) != 0) return NULL;
+	*alpha = (update->getOp() == SUBTRACT) ? -1 : 1;
+	return operand;
+}
+
+// If the argument expression is 'total + x' or 'x + total' for the argument scalar total then returns x; otherwise
+// returns NULL.
+static Expr *getScalarUpdateOperand(Expr *expr, FieldAccess *total) {
+
+	if (expr->getExprTypeId() != ARITH_EXPR) return NULL;
+	ArithmaticExpr *update = (ArithmaticExpr*) expr;
+	if (update->getOp() != ADD) return NULL;
+	const char *totalName = total->getField()->getName();
+	FieldAccess *updated = getScalarAccess(update->getLeft());
+	if (updated != NULL && strcmp(updated->getField()->getName(), totalName) == 0) return update->getRight();
+	updated = getScalarAccess(update->getRight());
+	if (updated != NULL && strcmp(updated->getField()->getName(), totalName) == 0) return update->getLeft();
+	return NULL;
+}
+
+// If the argument expression is 'a[i][k] * b[k][j]', with the operands in any order, for the argument i and j
+// indexes then sets a, b, and the index k in the output parameters and returns true; otherwise returns false.
+static bool getProductOperands(Expr *expr, const char *i, const char *j,
+		FieldAccess **a, FieldAccess **b, const char **k) {
+
+	if (expr == NULL || expr->getExprTypeId() != ARITH_EXPR) return false;
+	ArithmaticExpr *product = (ArithmaticExpr*) expr;
+	if (product->getOp() != MULTIPLY) return false;
+
+	const char *aRow, *aColumn, *bRow, *bColumn;
+	FieldAccess *first = getTwoIndexAccess(product->getLeft(), &aRow, &aColumn);
+	FieldAccess *second = getTwoIndexAccess(product->getRight(), &bRow, &bColumn);
+	if (first == NULL || second == NULL) return false;
+	if (strcmp(aRow, i) != 0) {
+		FieldAccess *temp = first; first = second; second = temp;
+		const char *tempIndex = aRow; aRow = bRow; bRow = tempIndex;
+		tempIndex = aColumn; aColumn = bColumn; bColumn = tempIndex;
+	}
+	if (strcmp(aRow, i) != 0 || strcmp(bRow, aColumn) != 0 || strcmp(bColumn, j) != 0) return false;
+	if (strcmp(aColumn, i) == 0 || strcmp(aColumn, j) == 0) return false;
+	*a = first;
+	*b = second;
+	*k = aColumn;
+	return true;
+}
+
+bool PLoopStmt::generateMatrixMultiplyCall(std::ostringstream &stream, int indentLevel, Space *space) {
+
+	// There are two forms of the loop that qualify. The first is a loop over three indexes whose body is the single
+	// assignment 'c[i][j] = c[i][j] + a[i][k] * b[k][j]'. The second is a loop over two indexes that accumulates the
+	// product in a scalar before updating c, as in
+	//		do {	total = 0
+	//			do { total = total + a[i][k] * b[k][j] } for k in a
+	//			c[i][j] = c[i][j] + total
+	//		} for i, j in c
+	// In both forms the update of c may be a subtraction and the operands of the additions and the multiplication
+	// can be in any order.
+	List<const char*> *indexNames = getAllIndexNames();
+	const char *i, *j, *k;
+	FieldAccess *c, *a, *b;
+	FieldAccess *total = NULL;
+	int alpha = 1;
+
+	// the k index is traversed by the loop itself in the first form and by the inner loop in the second
+	IndexScope *depthIndexScope = indexScope;
+	if (indexNames->NumElements() == 3) {
+		AssignmentExpr *assignment = getSingleAssignment(body);
+		if (assignment == NULL) return false;
+		c = getTwoIndexAccess(assignment->getLeft(), &i, &j);
+		if (c == NULL) return false;
+		Expr *product = getArrayUpdateOperand(assignment->getRight(), c, i, j, &alpha);
+		if (!getProductOperands(product, i, j, &a, &b, &k)) return false;
+	} else if (indexNames->NumElements() == 2) {
+		StmtBlock *block = dynamic_cast<StmtBlock*>(body);
+		if (block == NULL || block->getStmts()->NumElements() != 3) return false;
+		List<Stmt*> *stmts = block->getStmts();
+
+		// the scalar should be reset to zero before the inner loop
+		AssignmentExpr *reset = getSingleAssignment(stmts->Nth(0));
+		if (reset == NULL) return false;
+		total = getScalarAccess(reset->getLeft());
+		if (total == NULL || !isZeroConstant(reset->getRight())) return false;
+
+		// c[i][j] should then be updated with the scalar
+		AssignmentExpr *store = getSingleAssignment(stmts->Nth(2));
+		if (store == NULL) return false;
+		c = getTwoIndexAccess(store->getLeft(), &i, &j);
+		if (c == NULL) return false;
+		FieldAccess *addend = getScalarAccess(getArrayUpdateOperand(store->getRight(), c, i, j, &alpha));
+		if (addend == NULL || strcmp(addend->getField()->getName(), total->getField()->getName()) != 0) {
+			return false;
+		}
+
+		// the inner loop should traverse a single unrestricted index and only accumulate the products
+		PLoopStmt *innerLoop = dynamic_cast<PLoopStmt*>(stmts->Nth(1));
+		if (innerLoop == NULL || innerLoop->getAllIndexNames()->NumElements() != 1) return false;
+		List<LogicalExpr*> *innerRestrictions = innerLoop->getIndexRestrictions();
+		if (innerRestrictions != NULL && innerRestrictions->NumElements() > 0) return false;
+		AssignmentExpr *accumulation = getSingleAssignment(innerLoop->getBody());
+		if (accumulation == NULL) return false;
+		FieldAccess *accumulator = getScalarAccess(accumulation->getLeft());
+		if (accumulator == NULL
+				|| strcmp(accumulator->getField()->getName(), total->getField()->getName()) != 0) {
+			return false;
+		}
+		Expr *product = getScalarUpdateOperand(accumulation->getRight(), total);
+		if (!getProductOperands(product, i, j, &a, &b, &k)) return false;
+		if (strcmp(k, innerLoop->getAllIndexNames()->Nth(0)) != 0) return false;
+		depthIndexScope = innerLoop->indexScope;
+	} else return false;
+	if (c->getEpochVersion() != 0 || strcmp(i, j) == 0) return false;
+
+	// the kernel updates c in place; so it should not be an operand of the product
+	const char *cName = c->getField()->getName();
+	const char *aName = a->getField()->getName();
+	const char *bName = b->getField()->getName();
+	if (strcmp(cName, aName) == 0 || strcmp(cName, bName) == 0) return false;
+
+	// all three arrays should hold elements of the same numeric type the kernel has been instantiated for; the
+	// scalar accumulating the product should be of that type too to not change the precision of the summation
+	Type *elementType = ((ArrayType*) c->getType())->getTerminalElementType();
+	if (elementType != Type::intType && elementType != Type::floatType && elementType != Type::doubleType) {
+		return false;
+	}
+	if (((ArrayType*) a->getType())->getTerminalElementType() != elementType) return false;
+	if (((ArrayType*) b->getType())->getTerminalElementType() != elementType) return false;
+	if (total != NULL && total->getType() != elementType) return false;
+
+	// the kernel assumes the indexes traverse the storage of the parts directly; so no dimension of the arrays
+	// can be reordered by the partition functions or be single entry in the LPUs
+	Space *rootSpace = space->getRoot();
+	FieldAccess *arrays[] = {c, a, b};
+	for (int n = 0; n < 3; n++) {
+		const char *arrayName = arrays[n]->getField()->getName();
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(space->getLocalStructure(arrayName));
+		if (array == NULL) return false;
+		for (int d = 1; d <= 2; d++) {
+			if (array->isDimensionReordered(d, rootSpace)) return false;
+			if (array->isSingleEntryInDimension(d)) return false;
+		}
+	}
+
+	std::ostringstream indent;
+	for (int n = 0; n < indentLevel; n++) indent << '\t';
+
+	// The index ranges are those the index loops would have traversed. Restrictions on the i and j indexes are
+	// applied on their range boundaries the same way the index loops apply them; a restriction that cannot be
+	// applied precisely that way would need a check on every iteration, which disqualifies the loop.
+	List<LogicalExpr*> *restrictions = getIndexRestrictions();
+	if (restrictions == NULL) restrictions = new List<LogicalExpr*>;
+	const char *loopIndexes[] = {i, j, k};
+	std::ostringstream rangeStreams[3];
+	for (int n = 0; n < 3; n++) {
+		IndexScope *currentIndexScope = (n < 2) ? indexScope : depthIndexScope;
+		IndexScope::currentScope->enterScope(currentIndexScope);
+		IndexArrayAssociation *association = currentIndexScope->getPreferredAssociation(loopIndexes[n]);
+		const char *arrayName = (association == NULL) ? NULL : association->getArray();
+		DataStructure *structure = (arrayName == NULL) ? NULL : space->getLocalStructure(arrayName);
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(structure);
+		int dimensionNo = (association == NULL) ? 0 : association->getDimensionNo() + 1;
+		if (array == NULL || array->isSingleEntryInDimension(dimensionNo)
+				|| array->isDimensionReordered(dimensionNo, rootSpace)) {
+			IndexScope::currentScope->goBackToOldScope();
+			return false;
+		}
+		RangeExpr *rangeExpr = association->convertToRangeExpr(structure->getType());
+		const char *rangeCond = rangeExpr->getRangeExpr(space);
+
+		std::ostringstream restrictStream;
+		if (n < 2 && restrictions->NumElements() > 0) {
+			Hashtable<const char*> *invisibleIndexes = new Hashtable<const char*>;
+			for (int m = 0; m < 3; m++) {
+				if (m != n) invisibleIndexes->Enter(loopIndexes[m], loopIndexes[m], true);
+			}
+			List<LogicalExpr*> *remainingRestrictions = new List<LogicalExpr*>;
+			List<LogicalExpr*> *applicableRestrictions = getApplicableExprs(invisibleIndexes,
+					restrictions, remainingRestrictions);
+			restrictions = remainingRestrictions;
+			if (applicableRestrictions->NumElements() > 0) {
+				applicableRestrictions = LogicalExpr::getIndexRestrictExpr(applicableRestrictions,
+						restrictStream, loopIndexes[n], rangeCond, indentLevel + 2, space,
+						false, arrayName, dimensionNo);
+				if (applicableRestrictions->NumElements() > 0) {
+					IndexScope::currentScope->goBackToOldScope();
+					return false;
+				}
+			}
+		}
+		IndexScope::currentScope->goBackToOldScope();
+
+		std::ostringstream &rangeStream = rangeStreams[n];
+		if (restrictStream.str().length() == 0) {
+			rangeStream << indent.str() << "\tmatMulRanges[" << n << "] = " << rangeCond << stmtSeparator;
+			continue;
+		}
+		rangeStream << indent.str() << "\t{// restricted range of index " << loopIndexes[n] << "\n";
+		rangeStream << indent.str() << doubleIndent;
+		rangeStream << "GlobalIndex iterationStart = " << rangeCond << ".min" << stmtSeparator;
+		rangeStream << indent.str() << doubleIndent;
+		rangeStream << "GlobalIndex iterationBound = " << rangeCond << ".max" << stmtSeparator;
+		rangeStream << restrictStream.str();
+		rangeStream << indent.str() << doubleIndent;
+		rangeStream << "matMulRanges[" << n << "] = Range(iterationStart, iterationBound)" << stmtSeparator;
+		// a restriction leaves nothing to traverse when it flips the direction of the range
+		rangeStream << indent.str() << doubleIndent;
+		rangeStream << "if (" << rangeCond << ".min > " << rangeCond << ".max) ";
+		rangeStream << "matMulNonEmpty = matMulNonEmpty && iterationStart >= iterationBound" << stmtSeparator;
+		rangeStream << indent.str() << doubleIndent;
+		rangeStream << "else matMulNonEmpty = matMulNonEmpty && iterationStart <= iterationBound";
+		rangeStream << stmtSeparator;
+		rangeStream << indent.str() << "\t}\n";
+	}
+	if (restrictions->NumElements() > 0) return false;
+
+	stream << indent.str() << "{// matrix-matrix multiplication on " << cName << "\n";
+	stream << indent.str() << "\tRange matMulRanges[3]" << stmtSeparator;
+	stream << indent.str() << "\tbool matMulNonEmpty = true" << stmtSeparator;
+	for (int n = 0; n < 3; n++) stream << rangeStreams[n].str();
+	stream << indent.str() << "\tif (matMulNonEmpty) {\n";
+	stream << indent.str() << doubleIndent << "gemm::multiplyAndAdd(";
+	c->translate(stream, indentLevel, 0, space);
+	stream << paramSeparator << cName << "StoreDims" << paramSeparator;
+	a->translate(stream, indentLevel, 0, space);
+	stream << paramSeparator << aName << "StoreDims" << paramSeparator;
+	b->translate(stream, indentLevel, 0, space);
+	stream << paramSeparator << bName << "StoreDims" << paramSeparator;
+	stream << "\n" << indent.str() << doubleIndent << doubleIndent;
+	stream << "matMulRanges[0]" << paramSeparator << "matMulRanges[1]" << paramSeparator << "matMulRanges[2]";
+	stream << paramSeparator << '(' << elementType->getCType() << ") " << alpha << ")" << stmtSeparator;
+	// the scalar is left holding the product of the last iteration of the index loops, as it would be after them
+	if (total != NULL) {
+		stream << indent.str() << doubleIndent;
+		total->translate(stream, indentLevel, 0, space);
+		stream << " = gemm::dotProduct(";
+		a->translate(stream, indentLevel, 0, space);
+		stream << paramSeparator << aName << "StoreDims" << paramSeparator;
+		b->translate(stream, indentLevel, 0, space);
+		stream << paramSeparator << bName << "StoreDims" << paramSeparator;
+		stream << "\n" << indent.str() << doubleIndent << doubleIndent;
+		stream << "matMulRanges[0].max" << paramSeparator << "matMulRanges[1].max";
+		stream << paramSeparator << "matMulRanges[2])" << stmtSeparator;
+	}
+	stream << indent.str() << "\t}\n";
+	stream << indent.str() << "}\n";
+	return true;
+}
@@ -55,35 +55,35 @@ void ReductionStmt::generateCode(std::ostringstream &stream, int indentLevel, Sp
 		stream << indents.str() << outputField << " *= ";
                 right->translate(stream, indentLevel, 0, space);
                 stream << stmtSeparator;
-	} else if (op == MAX || op == MAX_ENTRY) {
+	} else if (op == MAX || op == MIN) {
+		const char *comparison = (op == MAX) ? " < " : " > ";
 		stream << indents.str() << "if (" << outputField;
-		stream << " < ";
+		stream << comparison;
                 right->translate(stream, indentLevel, 0, space);
 		stream << ") {\n";
 		stream << indents.str() << indent;
 		stream << outputField << " = ";
                 right->translate(stream, indentLevel, 0, space);
                 stream << stmtSeparator;
-		if (op == MAX_ENTRY) {
-			List<const char*> *indexFields = enclosingLoop->getAllIndexNames();
-			stream << indents.str() << indent;
-			stream << resultName << "->index = " << indexFields->Nth(0) << stmtSeparator;
-		}
 		stream << indents.str() << "}\n";	
-	} else if (op == MIN || op == MIN_ENTRY) {
-		stream << indents.str() << "if (" << outputField;
-		stream << " > ";
-                right->translate(stream, indentLevel, 0, space);
-		stream << ") {\n";
-		stream << indents.str() << indent;
-		stream << outputField << " = ";
-                right->translate(stream, indentLevel, 0, space);
+	} else if (op == MAX_ENTRY || op == MIN_ENTRY) {
+		// The reduced expression is evaluated once into a local candidate and the best candidate's index is
+		// only written when the candidate wins. This keeps the comparison free of repeated loads through the 
+		// result pointer so that the compiler can keep the running best value in a register.
+		const char *comparison = (op == MAX_ENTRY) ? " < " : " > ";
+		Type *exprType = right->getType();
+		stream << indents.str() << "{\n";
+		stream << indents.str() << indent << exprType->getCType() << " candidate = ";
+                right->translate(stream, indentLevel + 1, 0, space);
                 stream << stmtSeparator;
-		if (op == MIN_ENTRY) {
-			List<const char*> *indexFields = enclosingLoop->getAllIndexNames();
-                        stream << indents.str() << indent;
-                        stream << resultName << "->index = " << indexFields->Nth(0) << stmtSeparator;
+		stream << indents.str() << indent << "if (" << outputField << comparison << "candidate) {\n";
+		stream << indents.str() << doubleIndent << outputField << " = candidate" << stmtSeparator;
+		List<const char*> *indexFields = enclosingLoop->getAllIndexNames();
+		for (int i = 0; i < indexFields->NumElements(); i++) {
+			stream << indents.str() << doubleIndent;
+			stream << resultName << "->index[" << i << "] = " << indexFields->Nth(i) << stmtSeparator;
 		}
+		stream << indents.str() << indent << "}\n";
 		stream << indents.str() << "}\n";
 	} else if (op == LAND) {
 		stream << indents.str() << outputField << " = ";
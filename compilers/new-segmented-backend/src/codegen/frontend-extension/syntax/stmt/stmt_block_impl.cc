@@ -1,10 +1,24 @@
 #include "../../../../../../common-libs/utils/list.h"
 #include "../../../../../../frontend/src/syntax/ast_stmt.h"
+#include "../../../../../../frontend/src/syntax/ast_expr.h"
 #include "../../../../../../frontend/src/semantics/task_space.h"
+#include "../../../utils/task_dependency.h"
 #include <sstream>
 
 void StmtBlock::generateCode(std::ostringstream &stream, int indentLevel, Space *space) {
+	TaskDependencyAnalyzer *analysis = TaskDependencyAnalyzer::coordinatorAnalysis;
 	for (int i = 0; i < stmts->NumElements(); i++) {
+
+		// consecutive independent task invocations of the coordinator program are launched together
+		if (analysis != NULL) {
+			List<TaskInvocation*> *concurrentRun = analysis->getConcurrentRun(stmts, i);
+			if (concurrentRun != NULL) {
+				TaskInvocation::generateConcurrentLaunch(stream, indentLevel, space, concurrentRun);
+				i += concurrentRun->NumElements() - 1;
+				delete concurrentRun;
+				continue;
+			}
+		}
                 Stmt *stmt = stmts->Nth(i);
                 stmt->generateCode(stream, indentLevel, space);
         }
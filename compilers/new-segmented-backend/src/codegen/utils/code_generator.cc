@@ -3,6 +3,7 @@
 #include "name_transformer.h"
 #include "code_constant.h"
 #include "task_global.h"
+#include "memory_mgmt.h"
 
 #include "../../../../frontend/src/syntax/ast_def.h"
 #include "../../../../frontend/src/syntax/ast_task.h"
@@ -436,6 +437,17 @@ void generateFnForThreadIdsAllocation(const char *headerFileName,
 		functionBody  << varName << ".groupSize = groupSize";
 		functionBody << stmtSeparator;
 
+		// if the PPUs of the PPS have different capabilities then let the LPU distribution know their 
+		// relative weights; the groups cycle through the weights when the LPS spans multiple PPSes
+		if (pps->isWeighted()) {
+			functionBody << indent;
+			functionBody << varName << ".ppuWeights = Space_" << pps->id << "_PPU_Weights";
+			functionBody << stmtSeparator;
+			functionBody << indent;
+			functionBody << varName << ".weightCount = " << pps->units;
+			functionBody << stmtSeparator;
+		}
+
 		// assign PPU Id to the thread depending on its groupThreadId
 		functionBody << indent;
 		functionBody << "if (groupThreadId == 0) " << varName << ".id\n"; 
@@ -891,10 +903,83 @@ void generateClassesForTuples(const char *filePath, List<TupleDef*> *tupleDefLis
 		headerFile << "};\n\n";
 	}
 
+	// generate a view class for each class whose arrays may use the structure-of-arrays layout; the view binds
+	// references to the fields of an element in their sub-arrays of a data part so that the translated code of
+	// compute stages can treat the element as an object of the original class
+	for (int i = 0; i < tupleDefList->NumElements(); i++) {
+		TupleDef *tupleDef = tupleDefList->Nth(i);
+		if (!isSoaLayoutClass(tupleDef)) continue;
+		generateSoaViewClass(headerFile, tupleDef);
+	}
+
 	headerFile << "#endif\n";
 	headerFile.close();
 }
 
+void generateSoaViewClass(std::ofstream &headerFile, TupleDef *tupleDef) {
+
+	const char *className = tupleDef->getId()->getName();
+	List<VariableDef*> *fields = getSoaLayoutFieldOrder(tupleDef);
+	headerFile << "class " << className << "_SoaView {\n";
+	headerFile << "  public:\n";
+
+	// the sub-array of a field begins at the part length times the total size of the fields placed before it
+	int soaOffset = 0;
+	for (int j = 0; j < fields->NumElements(); j++) {
+		VariableDef *field = fields->Nth(j);
+		headerFile << "\tstatic const int " << field->getId()->getName() << "SoaOffset = ";
+		headerFile << soaOffset << ";\n";
+		soaOffset += getSoaLayoutFieldSize(field->getType());
+	}
+	for (int j = 0; j < fields->NumElements(); j++) {
+		VariableDef *field = fields->Nth(j);
+		const char *fieldName = field->getId()->getName();
+		const char *cType = field->getType()->getCType();
+		headerFile << "\tstatic inline " << cType << " *" << fieldName << "Field";
+		headerFile << "(char *part, long partLength) {\n";
+		headerFile << "\t\treturn (" << cType << "*) (part + partLength * " << fieldName << "SoaOffset);\n";
+		headerFile << "\t}\n";
+	}
+
+	// references to the fields of the element and the constructor that binds them 
+	for (int j = 0; j < fields->NumElements(); j++) {
+		VariableDef *field = fields->Nth(j);
+		headerFile << "\t" << field->getType()->getCType() << " &" << field->getId()->getName() << ";\n";
+	}
+	headerFile << "\t" << className << "_SoaView(char *part, long partLength, long index)\n";
+	for (int j = 0; j < fields->NumElements(); j++) {
+		const char *fieldName = fields->Nth(j)->getId()->getName();
+		headerFile << "\t\t\t" << ((j == 0) ? ": " : ", ");
+		headerFile << fieldName << "(" << fieldName << "Field(part, partLength)[index])\n";
+	}
+	headerFile << "\t{}\n";
+
+	// conversion to and assignment from an object of the class for reading and writing the whole element
+	headerFile << "\toperator " << className << "() const {\n";
+	headerFile << "\t\t" << className << " object;\n";
+	for (int j = 0; j < fields->NumElements(); j++) {
+		const char *fieldName = fields->Nth(j)->getId()->getName();
+		headerFile << "\t\tobject." << fieldName << " = " << fieldName << ";\n";
+	}
+	headerFile << "\t\treturn object;\n";
+	headerFile << "\t}\n";
+	headerFile << "\t" << className << "_SoaView &operator=(const " << className << " &object) {\n";
+	for (int j = 0; j < fields->NumElements(); j++) {
+		const char *fieldName = fields->Nth(j)->getId()->getName();
+		headerFile << "\t\t" << fieldName << " = object." << fieldName << ";\n";
+	}
+	headerFile << "\t\treturn *this;\n";
+	headerFile << "\t}\n";
+	headerFile << "\t" << className << "_SoaView &operator=(const " << className << "_SoaView &other) {\n";
+	for (int j = 0; j < fields->NumElements(); j++) {
+		const char *fieldName = fields->Nth(j)->getId()->getName();
+		headerFile << "\t\t" << fieldName << " = other." << fieldName << ";\n";
+	}
+	headerFile << "\t\treturn *this;\n";
+	headerFile << "\t}\n";
+	headerFile << "};\n\n";
+}
+
 void generateClassesForGlobalScalars(const char *filePath, List<TaskGlobalScalar*> *globalList, Space *rootLps) {
 	
 	std::cout << "Generating structures holding task global and thread local scalar\n";
@@ -943,6 +1028,9 @@ void generateClassesForGlobalScalars(const char *filePath, List<TaskGlobalScalar
 		}
 	}
 	
+	// each thread also has a source for the random number streams of the LPUs it executes
+	threadLocals << indent << "rng::StreamSource randomStreams" << stmtSeparator;
+
 	taskGlobals << "};\n\n";
 	threadLocals << "};\n";
 
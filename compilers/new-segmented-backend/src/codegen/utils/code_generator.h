@@ -3,6 +3,8 @@
 
 #include "../../../../common-libs/utils/list.h"
 
+#include <fstream>
+
 class Definition;
 class TaskGlobalScalar;
 class TupleDef;
@@ -70,6 +72,10 @@ void generatePrintFnForLpuDataStructures(const char *initials,
 /* function definition to generate classes for all tuple definitions found in the source code */
 void generateClassesForTuples(const char *filePath, List<TupleDef*> *tupleDefList);
 
+/* function definition to generate the class that presents an element of an array of the argument class stored in
+   the structure-of-arrays layout as an object of the class */
+void generateSoaViewClass(std::ofstream &headerFile, TupleDef *tupleDef);
+
 /* function definition to generate classes for storing task global and thread local variables */
 void generateClassesForGlobalScalars(const char *filePath, 
 		List<TaskGlobalScalar*> *globalList,
@@ -2,16 +2,21 @@
 #include "space_mapping.h"
 #include "code_constant.h"
 #include "task_global.h"
+#include "memory_mgmt.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/string_utils.h"
 #include "../../../../common-libs/utils/common_utils.h"
 #include "../../../../common-libs/utils/decorator_utils.h"
+#include "../../../../common-libs/utils/properties.h"
 
 #include "../../../../frontend/src/syntax/ast_def.h"
 #include "../../../../frontend/src/syntax/ast_task.h"
 #include "../../../../frontend/src/syntax/ast_type.h"
+#include "../../../../frontend/src/syntax/ast_library_fn.h"
 #include "../../../../frontend/src/semantics/task_space.h"
+#include "../../../../frontend/src/semantics/computation_flow.h"
+#include "../../../../frontend/src/semantics/partition_function.h"
 #include "../../../../frontend/src/static-analysis/sync_stat.h"
 #include "../../../../frontend/src/codegen-helper/communication_stat.h"
 
@@ -25,10 +30,107 @@
 #include <queue>
 
 
+// Returns true if the parts of a variable a thread holds in an LPS can be identified from the range of linear LPU Ids the
+// thread gets from the LPS, without enumerating the LPUs. That is the case when the LPS lies directly under the root and
+// divides the variable, not partitioned in any ancestor LPS, only by block_size and block_count functions. Then the range
+// is known from the PPU Ids of the thread alone and the regions of consecutive parts are consecutive.
+static bool isPartRangeDerivable(Space *lps, const char *varName) {
+	
+	Space *parent = lps->getParent();
+	if (parent == NULL || !parent->isRoot() || lps->isSubpartitionSpace()) return false;
+	if (lps->getDimensionCount() == 0) return false;
+
+	ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(lps->getStructure(varName));
+	if (array == NULL) return false;
+	DataStructure *source = array->getSource();
+	if (source != NULL && !source->getSpace()->isRoot()) return false;
+	for (int i = 0; i < array->getDimensionality(); i++) {
+		PartitionFunctionConfig *partitionConfig = array->getPartitionSpecForDimension(i + 1);
+		if (partitionConfig != NULL 
+				&& dynamic_cast<BlockSize*>(partitionConfig) == NULL
+				&& dynamic_cast<BlockCount*>(partitionConfig) == NULL) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// a helper for the distribution tree function generator that writes the code for enumerating the parts of a variable a
+// segment holds in the LPSes that allocate the variable; the part action is written inside the loop once the part Id of
+// the current LPU has been generated, and the enumeration stops early when the continue condition, if any, fails. If a
+// range action is given, it replaces the enumeration for the LPSes where the parts of a thread can be identified from 
+// its LPU Id range; the range action can access the range and the LPU counts of the LPS.
+static void generatePartEnumerationCode(std::ostringstream &fnBody, 
+		const char *varName, 
+		Space *rootLps, List<Space*> *lpses, 
+		const char *partAction, 
+		const char *continueCondition = NULL, 
+		const char *rangeAction = NULL) {
+	
+	std::string extraCondition;
+	if (continueCondition != NULL) {
+		extraCondition = std::string(" && ") + continueCondition;
+	}
+	fnBody << doubleIndent << "List<ThreadState*> *threadList = segment->getParticipantList()" << stmtSeparator;
+
+	// iterate over the threads of the current segments
+	fnBody << doubleIndent << "for (int j = 0; j < threadList->NumElements()" << extraCondition << "; j++) {\n";
+	fnBody << tripleIndent << "ThreadState *thread = threadList->Nth(j)" << stmtSeparator;
+
+	// iterator over the list of LPSes that allocate this structures
+	fnBody << tripleIndent << "int lpuId = INVALID_ID" << stmtSeparator;
+	fnBody << tripleIndent << "DataPartitionConfig *partConfig = NULL" << stmtSeparator;
+	fnBody << tripleIndent << "List<int*> *partId = NULL" << stmtSeparator;
+	fnBody << tripleIndent << "DataItemConfig *dataItemConfig = NULL" << stmtSeparator;
+	fnBody << tripleIndent << "std::vector<LpsDimConfig> *dimOrder = NULL" << stmtSeparator;
+	for (int i = 0; i < lpses->NumElements(); i++) {
+		Space *lps = lpses->Nth(i);
+		const char *lpsName = lps->getName();
+		fnBody << "\n";
+		fnBody << tripleIndent << "//generating parts for: " << lpsName << "\n";
+		fnBody << tripleIndent << "if (thread->isValidPpu(Space_" << lpsName << ")" << extraCondition << ") {\n";
+		fnBody << quadIndent << "partConfig = configMap->Lookup(\"";
+		fnBody << varName << "Space" << lpsName << "Config" << "\")" << stmtSeparator;
+		if (rangeAction != NULL && isPartRangeDerivable(lps, varName)) {
+			fnBody << quadIndent << "int lpsDimensions = " << lps->getDimensionCount() << stmtSeparator;
+			fnBody << quadIndent << "LpuIdRange lpuIdRange" << stmtSeparator;
+			fnBody << quadIndent << "if (thread->getLpuIdRangeUnderRoot(Space_" << lpsName << paramSeparator;
+			fnBody << "&lpuIdRange)) {\n";
+			fnBody << quadIndent << indent << "int *lpuCounts = thread->getLpuCounts(Space_" << lpsName << ")";
+			fnBody << stmtSeparator;
+			fnBody << rangeAction;
+			fnBody << quadIndent << "}\n";
+			fnBody << tripleIndent << "}\n";
+			continue;
+		}
+		fnBody << quadIndent << "partId = partConfig->generatePartIdTemplate()" << stmtSeparator;
+		fnBody << quadIndent << "dataItemConfig = partConfig->generateStateFulVersion()";
+		fnBody << stmtSeparator << quadIndent;
+		fnBody << "dimOrder = dataItemConfig->generateDimOrderVector()" << stmtSeparator;	
+		
+		// generate the LPU Ids for the current LPS and Thread combination and retrieve data part IDs from LPU IDs
+		fnBody << std::endl << quadIndent << "while((lpuId = thread->getNextLpuId(";
+		fnBody << "Space_" << lpsName << paramSeparator;
+		fnBody << std::endl << quadIndent << doubleIndent;
+		fnBody << "Space_" << rootLps->getName() << paramSeparator;
+		fnBody << "lpuId)) != INVALID_ID) {\n";
+		fnBody << quadIndent << indent << "List<int*> *lpuIdChain = thread->getLpuIdChainWithoutCopy(";
+		fnBody << std::endl << quadIndent << tripleIndent;
+		fnBody << "Space_" << lpsName << paramSeparator;
+		fnBody << "Space_" << rootLps->getName() << ")" << stmtSeparator;
+		fnBody << quadIndent << indent << "partConfig->generatePartId(lpuIdChain" << paramSeparator;
+		fnBody << "partId)"  << stmtSeparator;
+		fnBody << partAction;
+		fnBody << quadIndent << "}\n";
+		fnBody << tripleIndent << "}\n";
+	}	
+	fnBody << doubleIndent << "}\n";		
+}
+
 void generateDistributionTreeFnForStructure(const char *varName,
                 std::ofstream &headerFile,
                 std::ofstream &programFile,
-                const char *initials, Space *rootLps) {
+                const char *initials, Space *rootLps, bool neighbourFiltering) {
 
 	decorator::writeSubsectionHeader(headerFile, varName);
 	decorator::writeSubsectionHeader(programFile, varName);
@@ -38,6 +140,7 @@ void generateDistributionTreeFnForStructure(const char *varName,
 
 	fnHeader << "generateDistributionTreeFor_" << varName << "(";
 	fnHeader << "List<SegmentState*> *segmentList" << paramSeparator << '\n';
+	fnHeader << doubleIndent << "int localSegmentTag" << paramSeparator << '\n';
 	fnHeader << doubleIndent << "Hashtable<DataPartitionConfig*> *configMap)";
 
 	// find the list of LPSes that allocate the variable; the distribution tree should have branches for all those LPSes
@@ -67,56 +170,73 @@ void generateDistributionTreeFnForStructure(const char *varName,
 	fnBody << stmtSeparator;
 	fnBody << indent << "Assert(rootContainer != NULL)" << stmtSeparator;
 
-	// iterate over all segments
-	fnBody << indent << "for (int i = 0; i < segmentList->NumElements(); i++) {\n";
+	// when allowed, parts of other segments are only inserted in the tree if the segment is a neighbour of the local 
+	// segment; whether the parts' regions can be compared is decided at runtime as the partition configurations of the
+	// LPSes are only known then
+	std::ostringstream insertAction;
+	insertAction << quadIndent << indent << "rootContainer->insertPart(*dimOrder" << paramSeparator;
+	insertAction << "segmentTag" << paramSeparator << "partId)" << stmtSeparator;
+	std::ostringstream localInsertAction;
+	localInsertAction << insertAction.str();
+	if (neighbourFiltering) {
+		DataStructure *structure = rootLps->getStructure(varName);
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(structure);
+		fnBody << "\n" << indent << "// determining if parts of non-neighbouring segments can be left out\n";
+		fnBody << indent << "SegmentNeighbourhood *neighbourhood = new SegmentNeighbourhood(";
+		fnBody << array->getDimensionality() << ")" << stmtSeparator;
+		for (int i = 0; i < releventLpses->NumElements(); i++) {
+			const char *lpsName = releventLpses->Nth(i)->getName();
+			fnBody << indent << "neighbourhood->checkPartitionConfig(configMap->Lookup(\"";
+			fnBody << varName << "Space" << lpsName << "Config" << "\"))" << stmtSeparator;
+		}
+		fnBody << indent << "if (!neighbourhood->isFiltering()) {\n";
+		fnBody << doubleIndent << "delete neighbourhood" << stmtSeparator;
+		fnBody << doubleIndent << "neighbourhood = NULL" << stmtSeparator;
+		fnBody << indent << "}\n";
+		localInsertAction << quadIndent << indent << "if (neighbourhood != NULL) ";
+		localInsertAction << "neighbourhood->addLocalPart(partConfig" << paramSeparator << "partId)" << stmtSeparator;
+	}
+
+	// iterate over all segments; with neighbour filtering on, only the local segment is processed in this loop
+	fnBody << "\n" << indent << "for (int i = 0; i < segmentList->NumElements(); i++) {\n";
 	fnBody << doubleIndent << "SegmentState *segment = segmentList->Nth(i)" << stmtSeparator;
 	fnBody << doubleIndent << "int segmentTag = segment->getPhysicalId()" << stmtSeparator;
-	fnBody << doubleIndent << "List<ThreadState*> *threadList = segment->getParticipantList()" << stmtSeparator;
-
-	// iterate over the threads of the current segments
-	fnBody << doubleIndent << "for (int j = 0; j < threadList->NumElements(); j++) {\n";
-	fnBody << tripleIndent << "ThreadState *thread = threadList->Nth(j)" << stmtSeparator;
-
-	// iterator over the list of LPSes that allocate this structures
-	fnBody << tripleIndent << "int lpuId = INVALID_ID" << stmtSeparator;
-	fnBody << tripleIndent << "DataPartitionConfig *partConfig = NULL" << stmtSeparator;
-	fnBody << tripleIndent << "List<int*> *partId = NULL" << stmtSeparator;
-	fnBody << tripleIndent << "DataItemConfig *dataItemConfig = NULL" << stmtSeparator;
-	fnBody << tripleIndent << "std::vector<LpsDimConfig> *dimOrder = NULL" << stmtSeparator;
-	for (int i = 0; i < releventLpses->NumElements(); i++) {
-		Space *lps = releventLpses->Nth(i);
-		const char *lpsName = lps->getName();
-		fnBody << "\n";
-		fnBody << tripleIndent << "//generating parts for: " << lpsName << "\n";
-		fnBody << tripleIndent << "if (thread->isValidPpu(Space_" << lpsName << ")) {\n";
-		fnBody << quadIndent << "partConfig = configMap->Lookup(\"";
-		fnBody << varName << "Space" << lpsName << "Config" << "\")" << stmtSeparator;
-		fnBody << quadIndent << "partId = partConfig->generatePartIdTemplate()" << stmtSeparator;
-		fnBody << quadIndent << "dataItemConfig = partConfig->generateStateFulVersion()";
-		fnBody << stmtSeparator << quadIndent;
-		fnBody << "dimOrder = dataItemConfig->generateDimOrderVector()" << stmtSeparator;	
-		
-		// generate the LPU Ids for the current LPS and Thread combination and retrieve data part IDs from LPU IDs
-		fnBody << std::endl << quadIndent << "while((lpuId = thread->getNextLpuId(";
-		fnBody << "Space_" << lpsName << paramSeparator;
-		fnBody << std::endl << quadIndent << doubleIndent;
-		fnBody << "Space_" << rootLps->getName() << paramSeparator;
-		fnBody << "lpuId)) != INVALID_ID) {\n";
-		fnBody << quadIndent << indent << "List<int*> *lpuIdChain = thread->getLpuIdChainWithoutCopy(";
-		fnBody << std::endl << quadIndent << tripleIndent;
-		fnBody << "Space_" << lpsName << paramSeparator;
-		fnBody << "Space_" << rootLps->getName() << ")" << stmtSeparator;
-		fnBody << quadIndent << indent << "partConfig->generatePartId(lpuIdChain" << paramSeparator;
-		fnBody << "partId)"  << stmtSeparator;
-		fnBody << quadIndent << indent << "rootContainer->insertPart(*dimOrder" << paramSeparator;
-		fnBody << "segmentTag" << paramSeparator << "partId)" << stmtSeparator;
-		fnBody << quadIndent << "}\n";
-		fnBody << tripleIndent << "}\n";
-	}	
-
-	fnBody << doubleIndent << "}\n";		
+	if (neighbourFiltering) {
+		fnBody << doubleIndent << "if (neighbourhood != NULL && segmentTag != localSegmentTag) continue" << stmtSeparator;
+	}
+	generatePartEnumerationCode(fnBody, varName, rootLps, releventLpses, localInsertAction.str().c_str());
 	fnBody << indent << "}\n";
 
+	// then insert the parts of the segments having a part that overlaps some part of the local segment
+	if (neighbourFiltering) {
+		fnBody << "\n" << indent << "if (neighbourhood != NULL) {\n";
+		fnBody << indent << "for (int i = 0; i < segmentList->NumElements(); i++) {\n";
+		fnBody << doubleIndent << "SegmentState *segment = segmentList->Nth(i)" << stmtSeparator;
+		fnBody << doubleIndent << "int segmentTag = segment->getPhysicalId()" << stmtSeparator;
+		fnBody << doubleIndent << "if (segmentTag == localSegmentTag) continue" << stmtSeparator;
+		fnBody << doubleIndent << "bool neighbour = false" << stmtSeparator;
+		std::ostringstream checkAction;
+		checkAction << quadIndent << indent << "if (neighbourhood->overlapsLocalParts(partConfig";
+		checkAction << paramSeparator << "partId)) {\n";
+		checkAction << quadIndent << doubleIndent << "neighbour = true" << stmtSeparator;
+		checkAction << quadIndent << doubleIndent << "break" << stmtSeparator;
+		checkAction << quadIndent << indent << "}\n";
+		// the parts of a thread are checked together where they can be identified from its LPU Id range
+		std::ostringstream rangeCheckAction;
+		rangeCheckAction << quadIndent << indent << "neighbour = neighbourhood->overlapsLocalParts(partConfig";
+		rangeCheckAction << paramSeparator << "lpsDimensions" << paramSeparator << "lpuCounts" << paramSeparator;
+		rangeCheckAction << "lpuIdRange)" << stmtSeparator;
+		fnBody << doubleIndent << "{\n";
+		generatePartEnumerationCode(fnBody, varName, rootLps, releventLpses, 
+				checkAction.str().c_str(), "!neighbour", rangeCheckAction.str().c_str());
+		fnBody << doubleIndent << "}\n";
+		fnBody << doubleIndent << "if (!neighbour) continue" << stmtSeparator;
+		generatePartEnumerationCode(fnBody, varName, rootLps, releventLpses, insertAction.str().c_str());
+		fnBody << indent << "}\n";
+		fnBody << indent << "delete neighbourhood" << stmtSeparator;
+		fnBody << indent << "}\n";
+	}
+
 	fnBody << indent << "return rootContainer" << stmtSeparator;
 	fnBody << "}\n";
 
@@ -167,6 +287,14 @@ void generateFnsForDistributionTrees(const char *headerFileName,
 		if (array != NULL) syncArrays->Append(varName);
 	}
 
+	// scatter primitives locate the owners of scattered indices using the distribution trees of their target arrays
+	List<const char*> *scatterTargets = new List<const char*>;
+	collectScatterTargets(taskDef->getComputation(), scatterTargets);
+	for (int i = 0; i < scatterTargets->NumElements(); i++) {
+		const char *varName = scatterTargets->Nth(i);
+		if (!string_utils::contains(syncArrays, varName)) syncArrays->Append(varName);
+	}
+
 	if (syncArrays->NumElements() > 0) {
 
 		std::cout << "\tGenerating part distribution trees for communicated variables\n";
@@ -174,15 +302,43 @@ void generateFnsForDistributionTrees(const char *headerFileName,
 		const char *message = "functions to generate distribution trees for communicated variables";
 		decorator::writeSectionHeader(headerFile, message);
 		decorator::writeSectionHeader(programFile, message);
+
+		// unless the deployment asks for the complete trees, each segment only holds the parts of its neighbours in a
+		// variable's tree; up and down propagation synchronizations need the complete tree, however, as their group
+		// communicators are formed from all segments sharing a part; so do scatters as they may write anywhere
+		bool neighbourFiltering = true;
+		Properties *deploymentProps = PropertyReader::propertiesGroups->Lookup("deployment");
+		if (deploymentProps != NULL) {
+			const char *treeSetting = deploymentProps->getProperty("comm.distribution.tree");
+			if (treeSetting != NULL && strcmp(treeSetting, "full") == 0) {
+				neighbourFiltering = false;
+			}
+		}
+		List<CommunicationCharacteristics*> *commCharacterList
+				= taskDef->getComputation()->getCommCharacteristicsForSyncReqs(segmentedPPS);
+
 		for (int i = 0; i < syncArrays->NumElements(); i++) {
 			const char *varName = syncArrays->Nth(i);
-			generateDistributionTreeFnForStructure(varName, headerFile, programFile, initials, rootLps);
+			bool filteringApplicable = neighbourFiltering 
+					&& !string_utils::contains(scatterTargets, varName);
+			for (int j = 0; j < commCharacterList->NumElements() && filteringApplicable; j++) {
+				CommunicationCharacteristics *commCharacter = commCharacterList->Nth(j);
+				if (strcmp(commCharacter->getVarName(), varName) != 0) continue;
+				SyncRequirement *syncReq = commCharacter->getSyncRequirement();
+				if (dynamic_cast<UpPropagationSync*>(syncReq) != NULL 
+						|| dynamic_cast<DownPropagationSync*>(syncReq) != NULL) {
+					filteringApplicable = false;
+				}
+			}
+			generateDistributionTreeFnForStructure(varName, 
+					headerFile, programFile, initials, rootLps, filteringApplicable);
 		}
 		generateFnForDistributionMap(headerFile, programFile, initials, syncArrays);
 	} else {
 		// generate an empty part distribution map function
 		generateFnForDistributionMap(headerFile, programFile, initials, new List<const char*>);
 	}
+	delete scatterTargets;
 
 	headerFile.close();
 	programFile.close();
@@ -199,6 +355,7 @@ void generateFnForDistributionMap(std::ofstream &headerFile,
 	std::ostringstream fnHeader, fnBody;
 	fnHeader << "generateDistributionMap(";
 	fnHeader << "List<SegmentState*> *segmentList" << paramSeparator << '\n';
+	fnHeader << doubleIndent << "int localSegmentTag" << paramSeparator << '\n';
 	fnHeader << doubleIndent << "Hashtable<DataPartitionConfig*> *configMap)";
 	
 	fnBody << "{\n\n";
@@ -210,7 +367,7 @@ void generateFnForDistributionMap(std::ofstream &headerFile,
 		fnBody << varName << "\"" << paramSeparator << '\n';
 		fnBody << indent << doubleIndent;
 		fnBody << "generateDistributionTreeFor_" << varName << "(segmentList" << paramSeparator;
-		fnBody << "configMap))" << stmtSeparator;
+		fnBody << "localSegmentTag" << paramSeparator << "configMap))" << stmtSeparator;
 	}	
 	fnBody << indent << "return distributionMap" << stmtSeparator;
 	fnBody << "}\n";
@@ -365,6 +522,136 @@ List<CommunicationCharacteristics*> *generateFnsForConfinementConstrConfigs(cons
 	return commWithDataMovements;
 }
 
+// Returns true if the data exchanges of a dependency can be computed by a regular exchange schedule. That is the case for
+// a ghost region synchronization within a single LPS whose array has not been partitioned in any ancestor LPS and is
+// divided only by block_size and block_count functions. Then the owned and padded regions of each part follow directly
+// from the partition arguments. The deployment may ask for the generic confinement construction for all dependencies.
+static bool isExchangeScheduleApplicable(CommunicationCharacteristics *commCharacter) {
+
+	Properties *deploymentProps = PropertyReader::propertiesGroups->Lookup("deployment");
+	if (deploymentProps != NULL) {
+		const char *scheduleSetting = deploymentProps->getProperty("comm.exchange.schedule");
+		if (scheduleSetting != NULL && strcmp(scheduleSetting, "runtime") == 0) return false;
+	}
+
+	if (dynamic_cast<GhostRegionSync*>(commCharacter->getSyncRequirement()) == NULL) return false;
+	Space *lps = commCharacter->getSenderSyncSpace();
+	if (commCharacter->getReceiverSyncSpace() != lps
+			|| commCharacter->getSenderDataAllocatorSpace() != lps
+			|| commCharacter->getReceiverDataAllocatorSpace() != lps
+			|| !commCharacter->getConfinementSpace()->isRoot()) {
+		return false;
+	}
+	
+	ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(lps->getStructure(commCharacter->getVarName()));
+	if (array == NULL) return false;
+	DataStructure *source = array->getSource();
+	if (source != NULL && !source->getSpace()->isRoot()) return false;
+	for (int i = 0; i < array->getDimensionality(); i++) {
+		PartitionFunctionConfig *partitionConfig = array->getPartitionSpecForDimension(i + 1);
+		if (partitionConfig != NULL 
+				&& dynamic_cast<BlockSize*>(partitionConfig) == NULL
+				&& dynamic_cast<BlockCount*>(partitionConfig) == NULL) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// a helper for the data exchange function generator that writes the code for computing the exchanges of a dependency
+// by a regular exchange schedule; if some part of the array turns out to be shared by multiple segments, the generated
+// code abandons the schedule and falls through to the code that follows
+static void generateExchangeScheduleCode(std::ostringstream &fnBody, CommunicationCharacteristics *commCharacter) {
+
+	const char *varName = commCharacter->getVarName();
+	Space *lps = commCharacter->getSenderSyncSpace();
+	const char *lpsName = lps->getName();
+	ArrayDataStructure *array = (ArrayDataStructure*) lps->getStructure(varName);
+	int dimensionCount = array->getDimensionality();
+
+	// retrieve the dimensions, arguments, and paddings of the partition configuration
+	fnBody << indent << "DataPartitionConfig *partConfig = partConfigMap->Lookup(\"";
+	fnBody << varName << "Space" << lpsName << "Config\")" << stmtSeparator;
+	for (int i = 0; i < dimensionCount; i++) {
+		PartitionFunctionConfig *partitionConfig = array->getPartitionSpecForDimension(i + 1);
+		fnBody << indent << "DimPartitionConfig *dim" << i << "Config = ";
+		fnBody << "partConfig->getDimensionConfig(" << i << ")" << stmtSeparator;
+		fnBody << indent << "Dimension dim" << i << " = dim" << i << "Config->getDataDimension()" << stmtSeparator;
+		if (partitionConfig == NULL) continue;
+		if (dynamic_cast<BlockCount*>(partitionConfig) != NULL) {
+			fnBody << indent << "int dim" << i << "Count = std::max(1, (int) std::min(";
+			fnBody << "(GlobalIndex) dim" << i << "Config->getPartitionArgs()[0]" << paramSeparator;
+			fnBody << "dim" << i << ".length))" << stmtSeparator;
+			fnBody << indent << "GlobalIndex dim" << i << "Size = dim" << i << ".length / ";
+			fnBody << "dim" << i << "Count" << stmtSeparator;
+		} else {
+			fnBody << indent << "GlobalIndex dim" << i << "Size = dim" << i << "Config->getPartitionArgs()[0]";
+			fnBody << stmtSeparator;
+		}
+		fnBody << indent << "int dim" << i << "FrontPadding = dim" << i << "Config->getFrontPadding()";
+		fnBody << stmtSeparator;
+		fnBody << indent << "int dim" << i << "RearPadding = dim" << i << "Config->getRearPadding()";
+		fnBody << stmtSeparator;
+	}
+
+	// add the parts of the distribution tree to the schedule with their regions
+	fnBody << '\n' << indent << "RegularExchangeSchedule *schedule = new RegularExchangeSchedule(";
+	fnBody << dimensionCount << paramSeparator << "localSegmentTag)" << stmtSeparator;
+	fnBody << indent << "bool sharedParts = false" << stmtSeparator;
+	fnBody << indent << "BranchingContainer *distributionTree = ";
+	fnBody << "(BranchingContainer*) distributionMap->getDistrubutionTree(\"";
+	fnBody << varName << "\")" << stmtSeparator;
+	fnBody << indent << "List<Container*> *partContainers = distributionTree->listDescendantContainersForLps(";
+	fnBody << '\n' << indent << doubleIndent << "Space_" << lpsName << paramSeparator;
+	fnBody << "0" << paramSeparator << "false)" << stmtSeparator;
+	fnBody << indent << "for (int i = 0; i < partContainers->NumElements(); i++) {\n";
+	fnBody << doubleIndent << "Container *container = partContainers->Nth(i)" << stmtSeparator;
+	fnBody << doubleIndent << "std::vector<int> segmentTags = container->getSegmentTags()" << stmtSeparator;
+	fnBody << doubleIndent << "if (segmentTags.size() != 1) {\n";
+	fnBody << tripleIndent << "sharedParts = true" << stmtSeparator;
+	fnBody << tripleIndent << "break" << stmtSeparator;
+	fnBody << doubleIndent << "}\n";
+	fnBody << doubleIndent << "ScheduledPart *part = schedule->addPart(segmentTags[0]" << paramSeparator;
+	fnBody << "container)" << stmtSeparator;
+	fnBody << doubleIndent << "int *partId = part->partId->at(0)" << stmtSeparator;
+	for (int i = 0; i < dimensionCount; i++) {
+		PartitionFunctionConfig *partitionConfig = array->getPartitionSpecForDimension(i + 1);
+		std::ostringstream owned, padded;
+		owned << "part->ownedRegion[" << i << "]";
+		padded << "part->paddedRegion[" << i << "]";
+		if (partitionConfig == NULL) {
+			fnBody << doubleIndent << owned.str() << " = dim" << i << ".range" << stmtSeparator;
+			fnBody << doubleIndent << padded.str() << " = dim" << i << ".range" << stmtSeparator;
+			continue;
+		}
+		fnBody << doubleIndent << owned.str() << ".min = dim" << i << ".range.min + ";
+		fnBody << "partId[" << i << "] * dim" << i << "Size" << stmtSeparator;
+		if (dynamic_cast<BlockCount*>(partitionConfig) != NULL) {
+			// the last block takes the remainder of the dimension
+			fnBody << doubleIndent << owned.str() << ".max = (partId[" << i << "] < dim" << i << "Count - 1) ? ";
+			fnBody << owned.str() << ".min + dim" << i << "Size - 1 : dim" << i << ".range.max";
+		} else {
+			fnBody << doubleIndent << owned.str() << ".max = std::min(dim" << i << ".range.max" << paramSeparator;
+			fnBody << owned.str() << ".min + dim" << i << "Size - 1)";
+		}
+		fnBody << stmtSeparator;
+		fnBody << doubleIndent << padded.str() << ".min = std::max(dim" << i << ".range.min" << paramSeparator;
+		fnBody << owned.str() << ".min - dim" << i << "FrontPadding)" << stmtSeparator;
+		fnBody << doubleIndent << padded.str() << ".max = std::min(dim" << i << ".range.max" << paramSeparator;
+		fnBody << owned.str() << ".max + dim" << i << "RearPadding)" << stmtSeparator;
+	}
+	fnBody << indent << "}\n";
+	fnBody << indent << "delete partContainers" << stmtSeparator;
+
+	// return the exchanges of the schedule unless it has been abandoned
+	fnBody << indent << "if (!sharedParts) {\n";
+	fnBody << doubleIndent << "List<DataExchange*> *dataExchangeList = schedule->generateExchanges()" << stmtSeparator;
+	fnBody << doubleIndent << "delete schedule" << stmtSeparator;
+	fnBody << doubleIndent << "return dataExchangeList" << stmtSeparator;
+	fnBody << indent << "}\n";
+	fnBody << indent << "delete schedule" << stmtSeparator << '\n';
+}
+
 void generateFnForDataExchanges(std::ofstream &headerFile,
                 std::ofstream &programFile,
                 const char *initials, 
@@ -385,6 +672,12 @@ void generateFnForDataExchanges(std::ofstream &headerFile,
 
 	fnBody << "{\n\n";
 
+	// for regular ghost region synchronizations, the exchanges are computed from the part regions in closed form 
+	// instead of constructing confinements
+	if (isExchangeScheduleApplicable(commCharacter)) {
+		generateExchangeScheduleCode(fnBody, commCharacter);
+	}
+
 	// first instanciate a confinment construction configuration for the dependency arc by calling the designated function
 	// for the current dependency
 	fnBody << indent << "ConfinementConstructionConfig *ccConfig = ";
@@ -478,6 +771,95 @@ void generateAllDataExchangeFns(const char *headerFileName,
 	programFile.close();
 }
 
+// returns true if the synchronizations of the two argument scalar variable communications happen at exactly the same
+// points of the computation flow and can thus be done by the same communicator
+static bool areScalarCommsBatchable(CommunicationCharacteristics *first, CommunicationCharacteristics *second) {
+	
+	SyncRequirement *firstSync = first->getSyncRequirement();
+	SyncRequirement *secondSync = second->getSyncRequirement();
+	if ((dynamic_cast<ReplicationSync*>(firstSync) == NULL) != (dynamic_cast<ReplicationSync*>(secondSync) == NULL)
+			|| (dynamic_cast<UpPropagationSync*>(firstSync) == NULL) 
+					!= (dynamic_cast<UpPropagationSync*>(secondSync) == NULL)) {
+		return false;
+	}
+	if (first->getSenderSyncSpace() != second->getSenderSyncSpace()
+			|| first->getReceiverSyncSpace() != second->getReceiverSyncSpace()
+			|| firstSync->getDependentLps() != secondSync->getDependentLps()) {
+		return false;
+	}
+	DependencyArc *firstArc = firstSync->getDependencyArc();
+	DependencyArc *secondArc = secondSync->getDependencyArc();
+	return firstArc->getSource() == secondArc->getSource()
+			&& firstArc->getDestination() == secondArc->getDestination()
+			&& firstArc->getSignalSrc() == secondArc->getSignalSrc()
+			&& firstArc->getSignalSink() == secondArc->getSignalSink()
+			&& firstSync->getWaitingComputation() == secondSync->getWaitingComputation()
+			&& firstSync->getCounterRequirement() == secondSync->getCounterRequirement();
+}
+
+static bool isCommInList(CommunicationCharacteristics *comm, List<CommunicationCharacteristics*> *commList) {
+	for (int i = 0; i < commList->NumElements(); i++) {
+		if (commList->Nth(i) == comm) return true;
+	}
+	return false;
+}
+
+List<CommunicationCharacteristics*> *batchScalarCommunications(TaskDef *taskDef,
+		List<CommunicationCharacteristics*> *commCharacterList) {
+
+	Space *rootLps = taskDef->getPartitionHierarchy()->getRootSpace();
+
+	// A scalar synchronization qualifies for batching only when it is the sole communication for its variable and is
+	// not involved in any signal replacement. Otherwise the code generation for the sync stages may later expand its 
+	// receive to another communication or make some other communication's receive to use its communicator.
+	List<CommunicationCharacteristics*> *candidates = new List<CommunicationCharacteristics*>;
+	for (int i = 0; i < commCharacterList->NumElements(); i++) {
+		CommunicationCharacteristics *comm = commCharacterList->Nth(i);
+		const char *varName = comm->getVarName();
+		if (dynamic_cast<ArrayDataStructure*>(rootLps->getStructure(varName)) != NULL) continue;
+		SyncRequirement *sync = comm->getSyncRequirement();
+		if (!sync->isActive() || sync->getReplacementSync() != NULL) continue;
+		if (!sync->getDependencyArc()->doesRequireSignal()) continue;
+		bool qualified = true;
+		for (int j = 0; j < commCharacterList->NumElements() && qualified; j++) {
+			if (j == i) continue;
+			CommunicationCharacteristics *other = commCharacterList->Nth(j);
+			qualified = strcmp(other->getVarName(), varName) != 0 
+					&& other->getSyncRequirement()->getReplacementSync() != sync;
+		}
+		if (qualified) candidates->Append(comm);
+	}
+
+	List<CommunicationCharacteristics*> *batchedList = new List<CommunicationCharacteristics*>;
+	for (int i = 0; i < candidates->NumElements(); i++) {
+		CommunicationCharacteristics *comm = candidates->Nth(i);
+		if (isCommInList(comm, batchedList)) continue;
+		for (int j = i + 1; j < candidates->NumElements(); j++) {
+			CommunicationCharacteristics *other = candidates->Nth(j);
+			if (isCommInList(other, batchedList) || !areScalarCommsBatchable(comm, other)) continue;
+			
+			// the grouped synchronization is done through the communicator of the first one; so its arc is
+			// deactivated to skip its send and receive in the compute flow
+			comm->addBatchedComm(other);
+			other->getSyncRequirement()->deactivate();
+			batchedList->Append(other);
+		}
+	}
+	delete candidates;
+
+	List<CommunicationCharacteristics*> *filteredList = new List<CommunicationCharacteristics*>;
+	for (int i = 0; i < commCharacterList->NumElements(); i++) {
+		CommunicationCharacteristics *comm = commCharacterList->Nth(i);
+		if (!isCommInList(comm, batchedList)) filteredList->Append(comm);
+		else {
+			std::cout << "\tScalar synchronization " << comm->getSyncRequirement()->getDependencyArc()->getArcName();
+			std::cout << " will be batched with another\n";
+		}
+	}
+	delete batchedList;
+	return filteredList;
+}
+
 void generateScalarCommmunicatorFn(std::ofstream &headerFile,
                 std::ofstream &programFile,
                 const char *initials,
@@ -547,6 +929,15 @@ void generateScalarCommmunicatorFn(std::ofstream &headerFile,
 	// check if the allocation was successful and set up the data buffer reference in the communicator for the scalar
 	fnBody << indent << "Assert(communicator != NULL)" << stmtSeparator;
 	fnBody << indent << "communicator->setDataBufferReference(&(taskGlobals->" << varName << "))" << stmtSeparator;
+	
+	// add the other scalar variables whose synchronizations are batched with this one
+	List<CommunicationCharacteristics*> *batchedComms = commCharacter->getBatchedComms();
+	for (int i = 0; i < batchedComms->NumElements(); i++) {
+		const char *batchedVarName = batchedComms->Nth(i)->getVarName();
+		Type *batchedVarType = rootLps->getStructure(batchedVarName)->getType();
+		fnBody << indent << "communicator->addBatchedVariable(&(taskGlobals->" << batchedVarName << ")";
+		fnBody << paramSeparator << "sizeof(" << batchedVarType->getCType() << "))" << stmtSeparator;
+	}
 	fnBody << indent << "communicator->setCommStat(commStat)" << stmtSeparator;
 
 	fnBody << indent << "return communicator" << stmtSeparator;
@@ -655,6 +1046,17 @@ void generateArrayCommmunicatorFn(std::ofstream &headerFile,
 	int versionCount = structure->getVersionCount();
 	const char *bufferTypePrefix = (versionCount > 0) ? "SwiftIndexMapped" : "Preprocessed";
 
+	// by default, the buffer type for each data exchange is selected at runtime by measuring the performance of the
+	// applicable types; the deployment may, however, ask for the static selection above 
+	bool adaptiveBuffers = true;
+	Properties *deploymentProps = PropertyReader::propertiesGroups->Lookup("deployment");
+	if (deploymentProps != NULL) {
+		const char *selectionSetting = deploymentProps->getProperty("comm.buffer.selection");
+		if (selectionSetting != NULL && strcmp(selectionSetting, "static") == 0) {
+			adaptiveBuffers = false;
+		}
+	}
+
 	// instantiate a list of communication buffers to add virtual/physical communication buffers into it for data exchanges
 	// based on whether or not the exchange demands cross-segments communication 
 	fnBody << indent << "List<CommBuffer*> *bufferList = new List<CommBuffer*>" << stmtSeparator;
@@ -679,15 +1081,25 @@ void generateArrayCommmunicatorFn(std::ofstream &headerFile,
 	fnBody << stmtSeparator << "\n";
 	// otherwise continue and create an appropriate communication buffer for the exchange and add that in the list of buffers
 	fnBody << doubleIndent << "CommBuffer *buffer = NULL" << stmtSeparator;
-	fnBody << doubleIndent << "if (exchange->isIntraSegmentExchange(localSegmentTag)) {\n";
-	fnBody << tripleIndent << "buffer = new " << bufferTypePrefix << "VirtualCommBuffer(";
-	fnBody << "exchange" << paramSeparator;
-	fnBody << "syncConfig" << ")" << stmtSeparator;
-	fnBody << doubleIndent << "} else {\n";
-	fnBody << tripleIndent << "buffer = new " << bufferTypePrefix << "PhysicalCommBuffer(";
-	fnBody << "exchange" << paramSeparator;
-	fnBody << "syncConfig" << ")" << stmtSeparator;
-	fnBody << doubleIndent << "}\n";
+	if (adaptiveBuffers) {
+		// an adaptive buffer starts with the same buffer type the static selection would choose and then tries the
+		// other applicable types during the first few transfers
+		fnBody << doubleIndent << "buffer = new AdaptiveCommBuffer(exchange" << paramSeparator;
+		fnBody << "syncConfig" << paramSeparator;
+		fnBody << ((versionCount > 0) ? "true" : "false") << paramSeparator;
+		fnBody << "commStat" << paramSeparator;
+		fnBody << "\"" << dependencyName << "\")" << stmtSeparator;
+	} else {
+		fnBody << doubleIndent << "if (exchange->isIntraSegmentExchange(localSegmentTag)) {\n";
+		fnBody << tripleIndent << "buffer = new " << bufferTypePrefix << "VirtualCommBuffer(";
+		fnBody << "exchange" << paramSeparator;
+		fnBody << "syncConfig" << ")" << stmtSeparator;
+		fnBody << doubleIndent << "} else {\n";
+		fnBody << tripleIndent << "buffer = new " << bufferTypePrefix << "PhysicalCommBuffer(";
+		fnBody << "exchange" << paramSeparator;
+		fnBody << "syncConfig" << ")" << stmtSeparator;
+		fnBody << doubleIndent << "}\n";
+	}
 	fnBody << doubleIndent << "Assert(buffer != NULL)" << stmtSeparator;
 	fnBody << doubleIndent << "bufferList->Append(buffer)" << stmtSeparator;
 	fnBody << indent << "}\n";
@@ -817,8 +1229,8 @@ void generateCommunicatorMapFn(const char *headerFileName,
 	fnBody << "{\n\n";
 
 	// instantiate a communicator map
-	fnBody << indent << "Hashtable<Communicator*> *communicatorMap = new Hashtable<Communicator*>";
-	fnBody << stmtSeparator;
+	fnBody << indent << "Hashtable<Communicator*> *communicatorMap = ";
+	fnBody << "InvocationArena::track(new Hashtable<Communicator*>)" << stmtSeparator;
 	fnBody << indent << "Assert(communicatorMap != NULL)" << stmtSeparator;
 	
 	// determine the number of segments in the machine to be used for setting up communication buffer tags
@@ -855,6 +1267,10 @@ void generateCommunicatorMapFn(const char *headerFileName,
 		}
 		fnBody << ")" << stmtSeparator;
 		fnBody << indent << "if (communicator" << i << " != NULL) {\n";
+		// Communicators are registered with the invocation arena in the same order in all segments; as deleting a
+		// communicator may free an MPI communicator its segment group has created, which is a collective operation,
+		// that keeps the deletions in the same order everywhere.
+		fnBody << doubleIndent << "InvocationArena::track(communicator" << i << ")" << stmtSeparator;
 		fnBody << doubleIndent << "communicator" << i <<  "->setLogFile(&logFile)" << stmtSeparator;
 		fnBody << doubleIndent << "communicator" << i << "->setupBufferTags(" << i + 1;
 		fnBody << paramSeparator << "segmentCount)" << stmtSeparator;
@@ -958,3 +1374,89 @@ void generateCommunicationExcludeFn(const char *headerFileName,
 	programFile.close();
 	headerFile.close();
 }
+
+void generateScatterPrimitives(const char *headerFileName,
+                const char *programFileName,
+                TaskDef *taskDef) {
+
+	List<StageInstanciation*> *stageList = new List<StageInstanciation*>;
+	collectScatteringStages(taskDef->getComputation(), stageList);
+	if (stageList->NumElements() == 0) {
+		delete stageList;
+		return;
+	}
+
+	std::ofstream programFile, headerFile;
+        headerFile.open (headerFileName, std::ofstream::out | std::ofstream::app);
+        programFile.open (programFileName, std::ofstream::out | std::ofstream::app);
+        if (!programFile.is_open() || !headerFile.is_open()) {
+                std::cout << "Unable to open output file for generating scatter primitives";
+                std::exit(EXIT_FAILURE);
+        }
+
+	std::cout << "Generating scatter primitives\n";
+	const char *initials = string_utils::getInitials(taskDef->getName());
+        initials = string_utils::toLower(initials);
+
+	const char *message = "scatter primitives";
+	decorator::writeSectionHeader(headerFile, message);
+	decorator::writeSectionHeader(programFile, message);
+	headerFile << std::endl;
+
+	std::ostringstream fnHeader;
+	std::ostringstream fnBody;
+	fnHeader << "setupScatterPrimitives(SegmentGroup *participantGroup" << paramSeparator;
+	fnHeader << '\n' << doubleIndent << "PartDistributionMap *distributionMap" << paramSeparator;
+	fnHeader << '\n' << doubleIndent << "Hashtable<DataPartitionConfig*> *configMap)";
+	fnBody << "{\n\n";
+
+	// there is one primitive per scatter call site; the PPU controllers of the LPS executing the scatter record their
+	// elements in it and its exchange writes them to the parts of the target array in the LPS allocating the array
+	List<int> *callSiteIds = new List<int>;
+	for (int i = 0; i < stageList->NumElements(); i++) {
+		StageInstanciation *stage = stageList->Nth(i);
+		Space *scatterLps = stage->getSpace();
+		List<Scatter*> *scatterList = stage->getNestedScatters();
+		for (int j = 0; j < scatterList->NumElements(); j++) {
+			Scatter *scatter = scatterList->Nth(j);
+			int callSiteId = scatter->getCallSiteId();
+			bool alreadyDone = false;
+			for (int k = 0; k < callSiteIds->NumElements(); k++) {
+				if (callSiteIds->Nth(k) == callSiteId) alreadyDone = true;
+			}
+			if (alreadyDone) continue;
+			callSiteIds->Append(callSiteId);
+
+			const char *arrayName = scatter->getTargetArrayName();
+			DataStructure *allocation = scatterLps->getStructure(arrayName)->getClosestAllocation();
+			const char *allocatorLpsName = allocation->getSpace()->getName();
+			headerFile << "static ScatterPrimitive *" << arrayName << "Scatterer" << callSiteId;
+			headerFile << stmtSeparator;
+
+			fnBody << indent << arrayName << "Scatterer" << callSiteId << " = ";
+			fnBody << "InvocationArena::track(new ScatterPrimitive(";
+			fnBody << "\"" << arrayName << "\"" << paramSeparator;
+			fnBody << "sizeof(" << scatter->getElementType()->getCType() << ")" << paramSeparator;
+			fnBody << paramIndent << doubleIndent;
+			fnBody << "Space_" << scatterLps->getName() << "_Threads_Per_Segment" << paramSeparator;
+			fnBody << "participantGroup" << paramSeparator;
+			fnBody << paramIndent << doubleIndent;
+			fnBody << "distributionMap->getDistrubutionTree(\"" << arrayName << "\")" << paramSeparator;
+			fnBody << paramIndent << doubleIndent;
+			fnBody << "Space_" << allocatorLpsName << paramSeparator;
+			fnBody << "configMap->Lookup(\"" << arrayName << "Space" << allocatorLpsName << "Config\")))";
+			fnBody << stmtSeparator;
+		}
+		delete scatterList;
+	}
+	fnBody << "}\n";
+
+	headerFile << std::endl;
+	headerFile << "void " << fnHeader.str() << stmtSeparator;
+	programFile << "\nvoid " << initials << "::" << fnHeader.str() << " " << fnBody.str();
+
+	delete callSiteIds;
+	delete stageList;
+	programFile.close();
+	headerFile.close();
+}
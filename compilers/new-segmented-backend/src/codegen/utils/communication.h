@@ -19,11 +19,12 @@
 
 // This function generates a library function that creates and populates the distribution tree for a data structure.
 // Remember that a distribution tree holds information about all independent partitioning and location of data parts
-// in different segments.
+// in different segments. When the last argument is true, the generated function only inserts the parts of the local
+// segment and of the segments having parts overlapping the local segment's parts, if the partition allows that. 
 void generateDistributionTreeFnForStructure(const char *varName, 
 		std::ofstream &headerFile, 
 		std::ofstream &programFile, 
-		const char *initials, Space *rootLps);
+		const char *initials, Space *rootLps, bool neighbourFiltering);
 
 // This function determine what variables will need distribution trees and generate functions to create those trees
 // by invoking the function above.
@@ -63,6 +64,14 @@ void generateAllDataExchangeFns(const char *headerFile,
                 TaskDef *taskDef,
                 List<CommunicationCharacteristics*> *commCharacterList);
 
+// Scalar variable synchronizations are latency bound. So those that are signaled by the same updater stage and waited
+// on by the same stage of the same LPSes are done together by a single communicator that packs all the variables in one
+// message. This function groups such synchronizations under the first of them and deactivates the dependency arcs of 
+// the rest so that no separate send or receive is generated for the latter. It returns the communication list without
+// the grouped synchronizations.
+List<CommunicationCharacteristics*> *batchScalarCommunications(TaskDef *taskDef,
+		List<CommunicationCharacteristics*> *commCharacterList);
+
 // This function generates a functions to instantiating a communicator for synchronizing a scalar variable dependency
 void generateScalarCommmunicatorFn(std::ofstream &headerFile,
                 std::ofstream &programFile,
@@ -98,4 +107,12 @@ void generateCommunicationExcludeFn(const char *headerFile,
                 TaskDef *taskDef,
                 List<CommunicationCharacteristics*> *commCharacterList);	
 
+// This function generates the static pointers of the scatter primitives of all scatter call sites of a task and a 
+// routine that creates the primitives at the beginning of an invocation. A scatter primitive finds the owners of the 
+// indices of the array it writes to from the array's part distribution tree; so the distribution trees of scatter
+// targets are generated along with those of the communicated variables.
+void generateScatterPrimitives(const char *headerFile,
+                const char *programFile,
+                TaskDef *taskDef);
+
 #endif
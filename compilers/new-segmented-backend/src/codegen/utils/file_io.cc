@@ -51,13 +51,13 @@ void generatePartReaderForStructure(std::ofstream &headerFile, ArrayDataStructur
 	headerFile << doubleIndent << "stream->close()" << stmtSeparator;
 	headerFile << doubleIndent << "delete stream" << stmtSeparator;
 	headerFile << indent << "}\n";
-	headerFile << indent << "List<int> *getDataIndex(List<int> *partIndex) {";
+	headerFile << indent << "List<GlobalIndex> *getDataIndex(List<GlobalIndex> *partIndex) {";
 	if (array->isReordered(lps->getRoot())) {
 		headerFile << " return PartHandler::getDataIndex(partIndex)" << stmtTerminator << " }\n";
 	} else {
 		headerFile << " return partIndex" << stmtTerminator << " }\n";
 	}
-	headerFile << indent << "void readElement(List<int> *dataIndex, long int storeIndex, void *partStore) {\n";
+	headerFile << indent << "void readElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) {\n";
 	headerFile << doubleIndent << elementType->getCType();
 	headerFile << " *dataStore = (" << elementType->getCType() << "*) partStore" << stmtSeparator;
 	headerFile << doubleIndent << "dataStore[storeIndex] = stream->readElement(dataIndex)" << stmtSeparator;
@@ -121,13 +121,13 @@ void generatePartWriterForStructure(std::ofstream &headerFile, ArrayDataStructur
 	headerFile << doubleIndent << "stream->close()" << stmtSeparator;
 	headerFile << doubleIndent << "delete stream" << stmtSeparator;
 	headerFile << indent << "}\n";
-	headerFile << indent << "List<int> *getDataIndex(List<int> *partIndex) {";
+	headerFile << indent << "List<GlobalIndex> *getDataIndex(List<GlobalIndex> *partIndex) {";
 	if (array->isReordered(lps->getRoot())) {
 		headerFile << " return PartHandler::getDataIndex(partIndex)" << stmtTerminator << " }\n";
 	} else {
 		headerFile << " return partIndex" << stmtTerminator << " }\n";
 	}
-	headerFile << indent << "void writeElement(List<int> *dataIndex, long int storeIndex, void *partStore) {\n";
+	headerFile << indent << "void writeElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) {\n";
 	headerFile << doubleIndent << elementType->getCType();
 	headerFile << " *dataStore = (" << elementType->getCType() << "*) partStore" << stmtSeparator;
 	headerFile << doubleIndent << "stream->writeElement(dataStore[storeIndex]" <<  paramSeparator;
@@ -259,9 +259,9 @@ void generateWritersMap(const char *headerFileName,  const char *programFileName
 
 	// determine current segment's writer ID and the total number of active writers 
 	programFile << indent << "int writerId" << stmtSeparator;
-	programFile << indent << "MPI_Comm_rank(MPI_COMM_WORLD, &writerId)" << stmtSeparator;
+	programFile << indent << "MPI_Comm_rank(ExecutionContext::getCommunicator(), &writerId)" << stmtSeparator;
         programFile << indent << "int mpiProcessCount" << stmtSeparator;
-        programFile << indent << "MPI_Comm_size(MPI_COMM_WORLD" << paramSeparator;
+        programFile << indent << "MPI_Comm_size(ExecutionContext::getCommunicator()" << paramSeparator;
         programFile << "&mpiProcessCount)" << stmtSeparator;
         programFile << indent << "int writersCount = min(mpiProcessCount" << paramSeparator;
         programFile << "Max_Segments_Count)" << stmtSeparator;
@@ -328,12 +328,11 @@ void generateWritersMap(const char *headerFileName,  const char *programFileName
 			programFile << doubleIndent << "writer->setWritersCount(writersCount)" << stmtSeparator;
 			programFile << doubleIndent << "writersMap->Enter(\"" << writerClassName.str() << "\"";
 			programFile << paramSeparator << "writer)" << stmtSeparator;
-
-			// in case a writer should not be created, enter a NULL entry in the map
-			programFile << indent << "} else {\n";
-			programFile << doubleIndent << "writersMap->Enter(\"" << writerClassName.str() << "\"";
-			programFile << paramSeparator << "NULL)" << stmtSeparator;
 			programFile << indent << "}\n";
+
+			// no entry is made in the map when a writer should not be created as the lookup of a missing writer
+			// returns NULL anyway; the environment iterates over the writers of the map to release them later and a
+			// NULL entry would cut the iteration short
 		}
 	}
 
@@ -386,7 +385,10 @@ void generateReadersMap(const char *headerFileName,
 	}
 
 	programFile << " {\n\n";
-	programFile << indent << "Hashtable<PartReader*> *readersMap = new Hashtable<PartReader*>" << stmtSeparator;
+	// readers are needed only while the invocation sets up its environmental data structures; so they and their map are
+	// released with the invocation arena
+	programFile << indent << "Hashtable<PartReader*> *readersMap = ";
+	programFile << "InvocationArena::track(new Hashtable<PartReader*>)" << stmtSeparator;
         
 	std::deque<Space*> lpsQueue;
 	lpsQueue.push_back(rootLps);
@@ -431,10 +433,10 @@ void generateReadersMap(const char *headerFileName,
 
                         std::ostringstream readerClassName;
                         readerClassName << varName << "InSpace" << lpsName << "Reader";
-                        programFile << doubleIndent << readerClassName.str() << " *reader = new ";
-                        programFile << readerClassName.str();
+                        programFile << doubleIndent << readerClassName.str() << " *reader = ";
+                        programFile << "InvocationArena::track(new " << readerClassName.str();
                         programFile << "(" << "config" << paramSeparator; 
-                        programFile << dataItemName.str() << "->getPartsList())" << stmtSeparator;
+                        programFile << dataItemName.str() << "->getPartsList()))" << stmtSeparator;
                         programFile << doubleIndent << "Assert(reader != NULL)" << stmtSeparator;
 			programFile << doubleIndent << "readersMap->Enter(\"" << readerClassName.str() << "\"";
 			programFile << paramSeparator << "reader)" << stmtSeparator;
@@ -0,0 +1,592 @@
+#include "mapping_enumeration.h"
+#include "space_mapping.h"
+
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/hashtable.h"
+#include "../../../../common-libs/utils/string_utils.h"
+#include "../../../../frontend/src/semantics/task_space.h"
+#include "../../../../frontend/src/syntax/ast.h"
+#include "../../../../frontend/src/syntax/ast_expr.h"
+#include "../../../../frontend/src/syntax/ast_task.h"
+#include "../../../../frontend/src/semantics/partition_function.h"
+#include "../../../../frontend/src/semantics/computation_flow.h"
+#include "../../../../frontend/src/static-analysis/sync_stat.h"
+#include "../../../../frontend/src/codegen-helper/communication_stat.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string.h>
+#include <deque>
+#include <cmath>
+
+/* Relative weights of different kinds of synchronizations in the communication cost model. A ghost region sync
+   only moves the boundary regions of data parts between neighbors, while other synchronizations move entire data
+   parts or replicas. Scalars are cheap to move but still incur the latency of a message exchange. These weights
+   are intended to order mappings, not to predict the actual communication time.
+*/
+static const double GHOST_SYNC_WEIGHT = 0.25;
+static const double PROPAGATION_SYNC_WEIGHT = 0.5;
+static const double REPLICATION_SYNC_WEIGHT = 1.0;
+static const double SCALAR_SYNC_DISCOUNT = 0.25;
+
+//------------------------------------------------------------ LPU Count Hints ----------------------------------------------------------/
+
+LpuCountHints::LpuCountHints() {
+	hintMap = new Hashtable<int*>;
+	argumentMap = new Hashtable<int*>;
+}
+
+void LpuCountHints::readHintsFile(const char *filePath) {
+
+	std::string line;
+	std::ifstream hintsFile(filePath);
+	if (!hintsFile.is_open()) {
+		std::cout << "could not open the LPU count hints file\n";
+		std::exit(EXIT_FAILURE);
+	}
+
+	std::string commentsDelimiter = "//";
+	std::string countDelimiter = ":";
+	std::string argumentMarker = "Partition";
+	std::string taskName;
+	while (std::getline(hintsFile, line)) {
+		string_utils::trim(line);
+		if (line.length() == 0) continue;
+		if (string_utils::startsWith(line, commentsDelimiter)) continue;
+		List<std::string> *tokenList = string_utils::tokenizeString(line, commentsDelimiter);
+		line = tokenList->Nth(0);
+		string_utils::trim(line);
+
+		// a line starting with a quotation mark opens the hints block of a task
+		if (line[0] == '"') {
+			int nameEnd = line.find('"', 1);
+			taskName = line.substr(1, nameEnd - 1);
+			continue;
+		}
+		if (line[0] == '}' || line[0] == '{') continue;
+
+		// the remaining lines have the form 'Space X: LPU-Count' or 'Partition x: Argument-Value'
+		tokenList = string_utils::tokenizeString(line, countDelimiter);
+		if (tokenList->NumElements() < 2) continue;
+		std::string nameStr = tokenList->Nth(0);
+		string_utils::trim(nameStr);
+		std::string name = nameStr.substr(nameStr.rfind(' ') + 1);
+		std::ostringstream key;
+		key << taskName << '.' << name;
+		int *value = new int;
+		*value = atoi(tokenList->Nth(1).c_str());
+		if (string_utils::startsWith(nameStr, argumentMarker)) {
+			argumentMap->Enter(strdup(key.str().c_str()), value);
+		} else {
+			hintMap->Enter(strdup(key.str().c_str()), value);
+		}
+	}
+	hintsFile.close();
+}
+
+int LpuCountHints::getLpuCount(const char *taskName, const char *lpsName) {
+	std::ostringstream key;
+	key << taskName << '.' << lpsName;
+	int *count = hintMap->Lookup(key.str().c_str());
+	return (count == NULL) ? -1 : *count;
+}
+
+int LpuCountHints::getPartitionArgValue(const char *taskName, const char *argName) {
+	std::ostringstream key;
+	key << taskName << '.' << argName;
+	int *value = argumentMap->Lookup(key.str().c_str());
+	return (value == NULL) ? -1 : *value;
+}
+
+//---------------------------------------------------------- Mapping Candidate ----------------------------------------------------------/
+
+MappingCandidate::MappingCandidate(TaskDef *task) {
+	this->task = task;
+	this->lpsList = new List<Space*>;
+	this->ppsIdList = new List<int>;
+	this->estimatedCost = 0;
+}
+
+MappingCandidate *MappingCandidate::clone() {
+	MappingCandidate *copy = new MappingCandidate(task);
+	copy->lpsList->AppendAll(lpsList);
+	for (int i = 0; i < ppsIdList->NumElements(); i++) {
+		copy->ppsIdList->Append(ppsIdList->Nth(i));
+	}
+	copy->estimatedCost = estimatedCost;
+	return copy;
+}
+
+void MappingCandidate::addMapping(Space *lps, int ppsId) {
+	lpsList->Append(lps);
+	ppsIdList->Append(ppsId);
+}
+
+int MappingCandidate::getPpsId(Space *lps) {
+	for (int i = 0; i < lpsList->NumElements(); i++) {
+		if (lpsList->Nth(i) == lps) return ppsIdList->Nth(i);
+	}
+	return -1;
+}
+
+void MappingCandidate::writeMapping(std::ostream &stream, List<PPS_Definition*> *pcubesConfig) {
+	int totalPPSes = pcubesConfig->NumElements();
+	stream << '"' << task->getName() << "\" {\n";
+	stream << "\t// syntax LPS ':' PPS\n";
+	for (int i = 0; i < lpsList->NumElements(); i++) {
+		int ppsId = ppsIdList->Nth(i);
+		PPS_Definition *pps = pcubesConfig->Nth(totalPPSes - ppsId);
+		stream << "\tSpace " << lpsList->Nth(i)->getName() << ": " << ppsId;
+		stream << "\t// " << pps->name << "\n";
+	}
+	stream << "}\n";
+}
+
+void MappingCandidate::describe(std::ostream &stream) {
+	for (int i = 0; i < lpsList->NumElements(); i++) {
+		if (i > 0) stream << ' ';
+		stream << lpsList->Nth(i)->getName() << ':' << ppsIdList->Nth(i);
+	}
+}
+
+//-------------------------------------------------------- Enumeration Functions --------------------------------------------------------/
+
+int getTotalPpuCount(int ppsId, List<PPS_Definition*> *pcubesConfig) {
+	int ppuCount = 1;
+	for (int i = 0; i < pcubesConfig->NumElements(); i++) {
+		PPS_Definition *pps = pcubesConfig->Nth(i);
+		if (pps->id < ppsId) break;
+		ppuCount *= pps->units;
+	}
+	return ppuCount;
+}
+
+PPS_Definition *getCoreSpace(List<PPS_Definition*> *pcubesConfig) {
+	for (int i = 0; i < pcubesConfig->NumElements(); i++) {
+		PPS_Definition *pps = pcubesConfig->Nth(i);
+		if (pps->coreSpace) return pps;
+	}
+	// if no PPS has been flagged as the core space then the lowest PPS is treated as the core space
+	return pcubesConfig->Nth(pcubesConfig->NumElements() - 1);
+}
+
+// a recursive helper routine that extends a partially constructed mapping one LPS at a time
+void extendMappingCandidates(MappingCandidate *partialMapping,
+		List<Space*> *lpsOrder, int nextLpsIndex,
+		int rootPpsId,
+		List<MappingCandidate*> *candidateList) {
+
+	if (nextLpsIndex == lpsOrder->NumElements()) {
+		candidateList->Append(partialMapping);
+		return;
+	}
+	Space *lps = lpsOrder->Nth(nextLpsIndex);
+	Space *parentLps = lps->getParent();
+	if (parentLps->isSubpartitionSpace()) parentLps = parentLps->getParent();
+	int parentPpsId = (parentLps->isRoot()) ? rootPpsId : partialMapping->getPpsId(parentLps);
+	for (int ppsId = parentPpsId; ppsId >= 1; ppsId--) {
+		MappingCandidate *extension = partialMapping->clone();
+		extension->addMapping(lps, ppsId);
+		extendMappingCandidates(extension, lpsOrder, nextLpsIndex + 1, rootPpsId, candidateList);
+	}
+	delete partialMapping;
+}
+
+List<MappingCandidate*> *enumerateMappingCandidates(TaskDef *task, List<PPS_Definition*> *pcubesConfig) {
+
+	// list the LPSes of the task in a top-down order so that an LPS is always mapped after its parent
+	PartitionHierarchy *lpsHierarchy = task->getPartitionHierarchy();
+	Space *rootLps = lpsHierarchy->getRootSpace();
+	List<Space*> *lpsOrder = new List<Space*>;
+	std::deque<Space*> lpsQueue;
+	lpsQueue.push_back(rootLps);
+	while (!lpsQueue.empty()) {
+		Space *lps = lpsQueue.front();
+		lpsQueue.pop_front();
+		if (lps != rootLps) lpsOrder->Append(lps);
+		List<Space*> *children = lps->getChildrenSpaces();
+		for (int i = 0; i < children->NumElements(); i++) {
+			lpsQueue.push_back(children->Nth(i));
+		}
+		// LPSes dividing the sub-partitions of an LPS are children of the sub-partition space
+		Space *subpartition = lps->getSubpartition();
+		if (subpartition != NULL) {
+			children = subpartition->getChildrenSpaces();
+			for (int i = 0; i < children->NumElements(); i++) {
+				lpsQueue.push_back(children->Nth(i));
+			}
+		}
+	}
+
+	List<MappingCandidate*> *candidateList = new List<MappingCandidate*>;
+	int rootPpsId = pcubesConfig->Nth(0)->id;
+	extendMappingCandidates(new MappingCandidate(task), lpsOrder, 0, rootPpsId, candidateList);
+	return candidateList;
+}
+
+// a helper routine that returns the PPS id of an LPS in a mapping candidate taking care of the LPSes that are not
+// listed in the candidate, namely, the root and sub-partition LPSes
+int getCandidatePpsId(MappingCandidate *candidate, Space *lps, List<PPS_Definition*> *pcubesConfig) {
+	if (lps->isSubpartitionSpace()) lps = lps->getParent();
+	if (lps->isRoot()) return pcubesConfig->Nth(0)->id;
+	return candidate->getPpsId(lps);
+}
+
+// a helper routine that determines the PPS where memory segmentation occurs in the same way the task generator does
+int getSegmentedPpsId(List<PPS_Definition*> *pcubesConfig) {
+	for (int i = 0; i < pcubesConfig->NumElements(); i++) {
+		PPS_Definition *pps = pcubesConfig->Nth(i);
+		if (pps->segmented) return pps->id;
+	}
+	return pcubesConfig->Nth(0)->id;
+}
+
+// a helper routine that returns the value of a partition function argument when it is an integer constant or a
+// partition parameter whose value has been hinted; otherwise it returns -1
+int getPartitionArgValue(Node *argument, const char *taskName, LpuCountHints *hints) {
+	if (argument == NULL) return -1;
+	IntConstant *constant = dynamic_cast<IntConstant*>(argument);
+	if (constant != NULL) return constant->getValue();
+	Identifier *identifier = dynamic_cast<Identifier*>(argument);
+	if (identifier == NULL || hints == NULL) return -1;
+	return hints->getPartitionArgValue(taskName, identifier->getName());
+}
+
+// a helper routine that finds an array of an LPS partitioned along the dimension aligned with the argument dimension
+// of the LPS; the aligned array dimension is returned through the last argument
+ArrayDataStructure *getArrayAlignedWithLpsDimension(Space *lps, int lpsDimension, int *arrayDimension) {
+	Coordinate *coordinate = lps->getCoordinateSystem()->getCoordinate(lpsDimension);
+	List<const char*> *structureNames = lps->getLocalDataStructureNames();
+	for (int i = 0; i < structureNames->NumElements(); i++) {
+		const char *name = structureNames->Nth(i);
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(lps->getLocalStructure(name));
+		if (array == NULL || !array->isPartitioned()) continue;
+		Token *token = coordinate->getTokenForDataStructure(name);
+		if (token == NULL || token->isWildcard()) continue;
+		if (array->getPartitionSpecForDimension(token->getDimensionId()) == NULL) continue;
+		*arrayDimension = token->getDimensionId();
+		delete structureNames;
+		return array;
+	}
+	delete structureNames;
+	return NULL;
+}
+
+int estimateLpuCount(MappingCandidate *candidate,
+		Space *lps,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints) {
+
+	if (lps->getDimensionCount() == 0) return 1;
+	const char *taskName = candidate->getTask()->getName();
+	if (hints != NULL) {
+		int hintedCount = hints->getLpuCount(taskName, lps->getName());
+		if (hintedCount > 0) return hintedCount;
+	}
+
+	int lpuCount = 1;
+	for (int i = 1; i <= lps->getDimensionCount(); i++) {
+		int arrayDimension = 0;
+		ArrayDataStructure *array = getArrayAlignedWithLpsDimension(lps, i, &arrayDimension);
+		if (array == NULL) return -1;
+		PartitionFunctionConfig *function = array->getPartitionSpecForDimension(arrayDimension);
+		int partCount = -1;
+		if (dynamic_cast<Strided*>(function) != NULL || dynamic_cast<StridedBlock*>(function) != NULL) {
+			partCount = getUsablePpuCount(candidate, lps, pcubesConfig, hints);
+		} else if (dynamic_cast<BlockCount*>(function) != NULL || dynamic_cast<WeightedBlock*>(function) != NULL) {
+			Node *dividingArg = function->getArgsForDimension(arrayDimension)->getDividingArg();
+			partCount = getPartitionArgValue(dividingArg, taskName, hints);
+		}
+		if (partCount <= 0) return -1;
+		lpuCount *= partCount;
+	}
+	return lpuCount;
+}
+
+int getUsablePpuCount(MappingCandidate *candidate,
+		Space *lps,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints) {
+
+	int ppuCount = getTotalPpuCount(getCandidatePpsId(candidate, lps, pcubesConfig), pcubesConfig);
+	Space *parentLps = lps->getParent();
+	if (parentLps->isSubpartitionSpace()) parentLps = parentLps->getParent();
+	if (parentLps->isRoot()) return ppuCount;
+
+	// the PPUs of the parent LPS's PPS that get at least one parent LPU are the only ones whose descendent PPUs
+	// will get LPUs of the current LPS
+	int parentPpuCount = getTotalPpuCount(candidate->getPpsId(parentLps), pcubesConfig);
+	int parentUsablePpus = getUsablePpuCount(candidate, parentLps, pcubesConfig, hints);
+	int parentLpuCount = estimateLpuCount(candidate, parentLps, pcubesConfig, hints);
+	int activeParentPpus = parentUsablePpus;
+	if (parentLpuCount > 0 && parentLpuCount < activeParentPpus) activeParentPpus = parentLpuCount;
+	return (ppuCount / parentPpuCount) * activeParentPpus;
+}
+
+double estimateComputationCost(MappingCandidate *candidate,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints) {
+
+	const char *taskName = candidate->getTask()->getName();
+	int corePpuCount = getTotalPpuCount(getCoreSpace(pcubesConfig)->id, pcubesConfig);
+	List<Space*> *lpsList = candidate->getLpsList();
+	double cost = 0;
+	for (int i = 0; i < lpsList->NumElements(); i++) {
+
+		// an un-partitioned LPS always has a single LPU that runs in one PPU regardless of the mapping; so it
+		// does not contribute to the cost
+		Space *lps = lpsList->Nth(i);
+		if (!lps->doesExecuteCode() || lps->getDimensionCount() == 0) continue;
+
+		// PPUs below the core space, i.e., hyperthreads, share the execution units of the cores; so the effective
+		// parallelism is capped by the number of cores
+		int ppuCount = getUsablePpuCount(candidate, lps, pcubesConfig, hints);
+		int effectivePpus = (ppuCount < corePpuCount) ? ppuCount : corePpuCount;
+
+		int lpuCount = estimateLpuCount(candidate, lps, pcubesConfig, hints);
+		bool hinted = (hints != NULL && hints->getLpuCount(taskName, lps->getName()) > 0);
+		double efficiency = 0;
+		if (lpuCount < 0) {
+			efficiency = effectivePpus * 1.0 / corePpuCount;
+		} else {
+			// a mapping that leaves some PPUs without any LPU to process is wasteful
+			if (hinted && lpuCount < ppuCount) return -1;
+			int rounds = (lpuCount + ppuCount - 1) / ppuCount;
+			int busyPpus = (lpuCount < ppuCount) ? lpuCount : ppuCount;
+			double roundTime = (busyPpus > effectivePpus) ? busyPpus * 1.0 / effectivePpus : 1.0;
+			double idealTime = lpuCount * 1.0 / corePpuCount;
+			double actualTime = rounds * roundTime;
+			efficiency = idealTime / actualTime;
+		}
+		cost += 1.0 / efficiency;
+	}
+	return cost;
+}
+
+// a helper routine that counts the sides of the partitioned dimensions of an array that have padding; a padding given
+// by a partition parameter is assumed to be non-zero
+int getPaddedSideCount(ArrayDataStructure *array) {
+	int sides = 0;
+	for (int i = 1; i <= array->getDimensionality(); i++) {
+		PartitionFunctionConfig *function = array->getPartitionSpecForDimension(i);
+		if (function == NULL || !function->doesSupportGhostRegion()) continue;
+		DataDimensionConfig *dimensionConfig = function->getArgsForDimension(i);
+		Node *paddings[2] = { dimensionConfig->getFrontPaddingArg(), dimensionConfig->getBackPaddingArg() };
+		for (int j = 0; j < 2; j++) {
+			if (paddings[j] == NULL) continue;
+			IntConstant *constant = dynamic_cast<IntConstant*>(paddings[j]);
+			if (constant == NULL || constant->getValue() > 0) sides++;
+		}
+	}
+	return sides;
+}
+
+double estimateCommunicationCost(MappingCandidate *candidate,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints) {
+
+	int segmentedPPS = getSegmentedPpsId(pcubesConfig);
+	int segmentCount = getTotalPpuCount(segmentedPPS, pcubesConfig);
+	if (segmentCount <= 1) return 0;
+
+	// the confinement spaces and nature of synchronizations do not depend on the mapping; only whether or not
+	// they cross segment boundaries does
+	CompositeStage *computation = candidate->getTask()->getComputation();
+	List<CommunicationCharacteristics*> *commCharList = computation->getCommCharacteristicsForSyncReqs(segmentedPPS);
+	double cost = 0;
+	for (int i = 0; i < commCharList->NumElements(); i++) {
+		CommunicationCharacteristics *commCharacter = commCharList->Nth(i);
+		Space *confinementSpace = commCharacter->getConfinementSpace();
+		SyncRequirement *sync = commCharacter->getSyncRequirement();
+		delete commCharacter;
+
+		int confinementPpsId = getCandidatePpsId(candidate, confinementSpace, pcubesConfig);
+		if (confinementPpsId <= segmentedPPS) continue;
+
+		// data of the dependent LPS cannot be spread over more segments than the number of its LPUs; so there is
+		// no cross-segment communication if its partition functions generate a single LPU
+		Space *dependentLps = sync->getDependentLps();
+		int lpuCount = -1;
+		if (!dependentLps->isRoot() && !dependentLps->isSubpartitionSpace()) {
+			lpuCount = estimateLpuCount(candidate, dependentLps, pcubesConfig, hints);
+		}
+		if (lpuCount == 1) continue;
+
+		DataStructure *structure = dependentLps->getStructure(sync->getVariableName());
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(structure);
+		if (dynamic_cast<GhostRegionSync*>(sync) != NULL) {
+			int paddedSides = (array != NULL) ? getPaddedSideCount(array) : 0;
+			cost += GHOST_SYNC_WEIGHT * ((paddedSides > 0) ? paddedSides : 1);
+			continue;
+		}
+
+		double weight = REPLICATION_SYNC_WEIGHT;
+		if (dynamic_cast<UpPropagationSync*>(sync) != NULL
+				|| dynamic_cast<DownPropagationSync*>(sync) != NULL
+				|| dynamic_cast<CrossPropagationSync*>(sync) != NULL) {
+			weight = PROPAGATION_SYNC_WEIGHT;
+		}
+		if (array == NULL) weight *= SCALAR_SYNC_DISCOUNT;
+
+		// the number of segments a single LPU of the confinement space spans
+		int segmentsSpanned = segmentCount / getTotalPpuCount(confinementPpsId, pcubesConfig);
+		if (lpuCount > 1 && lpuCount < segmentsSpanned) segmentsSpanned = lpuCount;
+		if (segmentsSpanned < 2) segmentsSpanned = 2;
+		cost += weight * log2(segmentsSpanned);
+	}
+	delete commCharList;
+	return cost;
+}
+
+double estimateMappingCost(MappingCandidate *candidate,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints) {
+	double computationCost = estimateComputationCost(candidate, pcubesConfig, hints);
+	if (computationCost < 0) return computationCost;
+	return computationCost + estimateCommunicationCost(candidate, pcubesConfig, hints);
+}
+
+void synthesizeMappingConfiguration(TaskDef *task,
+		List<PPS_Definition*> *pcubesConfig,
+		const char *mappingFile) {
+
+	List<MappingCandidate*> *candidates = enumerateMappingCandidates(task, pcubesConfig);
+	MappingCandidate *bestCandidate = NULL;
+	for (int i = 0; i < candidates->NumElements(); i++) {
+		MappingCandidate *candidate = candidates->Nth(i);
+		double cost = estimateMappingCost(candidate, pcubesConfig, NULL);
+		if (cost < 0) continue;
+		candidate->setEstimatedCost(cost);
+		// candidates are enumerated from higher to lower PPSes; so on a tie, the mapping with LPSes placed in
+		// higher PPSes is retained as that results in fewer, larger LPUs that are cheaper to manage
+		if (bestCandidate == NULL || cost < bestCandidate->getEstimatedCost()) {
+			bestCandidate = candidate;
+		}
+	}
+	if (bestCandidate == NULL) {
+		std::cout << "Could not find a suitable mapping for task: " << task->getName() << "\n";
+		std::exit(EXIT_FAILURE);
+	}
+
+	std::ofstream stream;
+	stream.open(mappingFile, std::ofstream::out | std::ofstream::app);
+	if (!stream.is_open()) {
+		std::cout << "Unable to open the synthesized mapping file: " << mappingFile << "\n";
+		std::exit(EXIT_FAILURE);
+	}
+	bestCandidate->writeMapping(stream, pcubesConfig);
+	stream.close();
+
+	std::cout << "Synthesized mapping for task \"" << task->getName() << "\": ";
+	bestCandidate->describe(std::cout);
+	std::cout << " (estimated cost " << bestCandidate->getEstimatedCost() << ")\n";
+}
+
+// a helper routine to insert a candidate mapping into a list sorted by estimated costs
+void insertByCost(List<MappingCandidate*> *sortedList, MappingCandidate *candidate) {
+	int i = 0;
+	for (; i < sortedList->NumElements(); i++) {
+		if (sortedList->Nth(i)->getEstimatedCost() > candidate->getEstimatedCost()) break;
+	}
+	sortedList->InsertAt(candidate, i);
+}
+
+void generateMappingCandidates(List<Definition*> *taskDefs,
+		List<PPS_Definition*> *pcubesConfig,
+		const char *hintsFile,
+		const char *outputDir, int maxCandidates) {
+
+	std::cout << "Enumerating mapping candidates---------------------------------\n";
+
+	LpuCountHints *hints = NULL;
+	if (hintsFile != NULL) {
+		hints = new LpuCountHints();
+		hints->readHintsFile(hintsFile);
+	}
+
+	// Candidates for different tasks are combined into program level mapping configurations incrementally. Since
+	// the cost of a program level configuration is the sum of the costs of its task level mappings, keeping only
+	// the cheapest partial combinations after adding each task does not lose any of the best overall candidates.
+	List<List<MappingCandidate*>*> *combinations = new List<List<MappingCandidate*>*>;
+	List<double> *combinationCosts = new List<double>;
+	combinations->Append(new List<MappingCandidate*>);
+	combinationCosts->Append(0);
+
+	for (int i = 0; i < taskDefs->NumElements(); i++) {
+		TaskDef *task = (TaskDef*) taskDefs->Nth(i);
+		List<MappingCandidate*> *allCandidates = enumerateMappingCandidates(task, pcubesConfig);
+		List<MappingCandidate*> *survivors = new List<MappingCandidate*>;
+		for (int j = 0; j < allCandidates->NumElements(); j++) {
+			MappingCandidate *candidate = allCandidates->Nth(j);
+			double cost = estimateMappingCost(candidate, pcubesConfig, hints);
+			if (cost < 0) continue;
+			candidate->setEstimatedCost(cost);
+			insertByCost(survivors, candidate);
+		}
+		std::cout << "Task \"" << task->getName() << "\": " << allCandidates->NumElements();
+		std::cout << " valid mappings, " << survivors->NumElements() << " survived pruning\n";
+		if (survivors->NumElements() == 0) {
+			std::cout << "No mapping of the task can utilize the PPUs given the LPU count hints\n";
+			std::exit(EXIT_FAILURE);
+		}
+
+		List<List<MappingCandidate*>*> *extendedCombinations = new List<List<MappingCandidate*>*>;
+		List<double> *extendedCosts = new List<double>;
+		for (int c = 0; c < combinations->NumElements(); c++) {
+			for (int s = 0; s < survivors->NumElements(); s++) {
+				double cost = combinationCosts->Nth(c) + survivors->Nth(s)->getEstimatedCost();
+				int position = 0;
+				for (; position < extendedCosts->NumElements(); position++) {
+					if (extendedCosts->Nth(position) > cost) break;
+				}
+				if (position >= maxCandidates) continue;
+				List<MappingCandidate*> *combination = new List<MappingCandidate*>;
+				combination->AppendAll(combinations->Nth(c));
+				combination->Append(survivors->Nth(s));
+				extendedCombinations->InsertAt(combination, position);
+				extendedCosts->InsertAt(cost, position);
+				if (extendedCombinations->NumElements() > maxCandidates) {
+					extendedCombinations->RemoveAt(maxCandidates);
+					extendedCosts->RemoveAt(maxCandidates);
+				}
+			}
+		}
+		combinations = extendedCombinations;
+		combinationCosts = extendedCosts;
+	}
+
+	// write each program level configuration in a separate mapping file and list them in a summary file
+	std::ostringstream summaryFileName;
+	summaryFileName << outputDir << "/candidates.txt";
+	std::ofstream summaryFile(summaryFileName.str().c_str());
+	if (!summaryFile.is_open()) {
+		std::cout << "Unable to open the mapping candidates summary file\n";
+		std::exit(EXIT_FAILURE);
+	}
+	for (int c = 0; c < combinations->NumElements(); c++) {
+		std::ostringstream mappingFileName;
+		mappingFileName << "candidate_" << (c + 1) << ".map";
+		std::ostringstream mappingFilePath;
+		mappingFilePath << outputDir << "/" << mappingFileName.str();
+		std::ofstream mappingFile(mappingFilePath.str().c_str());
+		if (!mappingFile.is_open()) {
+			std::cout << "Unable to open mapping file: " << mappingFilePath.str() << "\n";
+			std::exit(EXIT_FAILURE);
+		}
+		summaryFile << mappingFileName.str() << '\t' << combinationCosts->Nth(c);
+		List<MappingCandidate*> *combination = combinations->Nth(c);
+		for (int t = 0; t < combination->NumElements(); t++) {
+			MappingCandidate *candidate = combination->Nth(t);
+			candidate->writeMapping(mappingFile, pcubesConfig);
+			summaryFile << "\t\"" << candidate->getTask()->getName() << "\" ";
+			candidate->describe(summaryFile);
+		}
+		summaryFile << '\n';
+		mappingFile.close();
+	}
+	summaryFile.close();
+	std::cout << combinations->NumElements() << " mapping candidates written in " << outputDir << "\n";
+}
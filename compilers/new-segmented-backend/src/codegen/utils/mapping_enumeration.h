@@ -0,0 +1,149 @@
+#ifndef _H_mapping_enumeration
+#define	_H_mapping_enumeration
+
+/* This header file contains classes and functions for enumerating the LPS-to-PPS mappings that are valid for a
+   task given the PCubeS description of a target machine. The enumeration is used by the mapping autotuner script
+   to get a set of candidate mapping configurations to compile and run. As the number of valid mappings grows
+   quickly with the depth of the PCubeS and LPS hierarchies, a simple cost model that compares the number of LPUs
+   expected to be generated for an LPS with the number of PPUs its LPUs will be distributed over is used to prune
+   mappings that have no chance of being competitive.
+*/
+
+#include "space_mapping.h"
+
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/hashtable.h"
+#include "../../../../frontend/src/semantics/task_space.h"
+#include "../../../../frontend/src/syntax/ast_task.h"
+
+#include <iostream>
+#include <fstream>
+
+/* An LPU count hint is an estimate of the total number of LPUs an LPS is going to have at runtime. That number
+   depends on partition arguments and array dimensions that are not known during compilation. So the user may
+   supply them in a file having the same syntax as the mapping file where the number after each LPS name is the
+   estimated LPU count of the LPS instead of a PPS id. Alternatively, the user may give the values of the partition
+   arguments of a task in lines of the form 'Partition x: Value' and let the LPU counts be derived from the partition
+   functions. In the absence of both, the LPS is assumed to have enough LPUs to keep all PPUs busy.
+*/
+class LpuCountHints {
+  protected:
+	// a map of LPU count hints of LPSes; the key is the task name followed by the LPS name
+	Hashtable<int*> *hintMap;
+	// a map of partition argument values; the key is the task name followed by the argument name
+	Hashtable<int*> *argumentMap;
+  public:
+	LpuCountHints();
+	void readHintsFile(const char *filePath);
+	// returns -1 if the hint is not available for the LPS
+	int getLpuCount(const char *taskName, const char *lpsName);
+	// returns -1 if the value of the partition argument has not been given
+	int getPartitionArgValue(const char *taskName, const char *argName);
+};
+
+/* An instance of this class represents one complete LPS-to-PPS mapping of a single task */
+class MappingCandidate {
+  protected:
+	TaskDef *task;
+	// the LPSes of the task in a top-down order (root excluded) and the PPS ids they are mapped to
+	List<Space*> *lpsList;
+	List<int> *ppsIdList;
+	// the value estimated by the cost model for this mapping; lower is better
+	double estimatedCost;
+  public:
+	MappingCandidate(TaskDef *task);
+	MappingCandidate *clone();
+	void addMapping(Space *lps, int ppsId);
+	int getPpsId(Space *lps);
+	List<Space*> *getLpsList() { return lpsList; }
+	TaskDef *getTask() { return task; }
+	void setEstimatedCost(double estimatedCost) { this->estimatedCost = estimatedCost; }
+	double getEstimatedCost() { return estimatedCost; }
+
+	// writes the mapping in the mapping configuration file syntax
+	void writeMapping(std::ostream &stream, List<PPS_Definition*> *pcubesConfig);
+	// writes a single line description of the mapping in the form A:4 B:2 C:1 for result tables
+	void describe(std::ostream &stream);
+};
+
+/* function that returns the total number of PPUs of a PPS in the entire hardware */
+int getTotalPpuCount(int ppsId, List<PPS_Definition*> *pcubesConfig);
+
+/* function that returns the PPS flagged as the core space in the PCubeS description */
+PPS_Definition *getCoreSpace(List<PPS_Definition*> *pcubesConfig);
+
+/* function that generates all valid mappings for a task; a mapping is valid if each LPS is mapped to the same PPS
+   as its parent LPS or to some PPS below it. Sub-partition LPSes are not listed separately as they are always
+   mapped to the PPS of their parent LPS.
+*/
+List<MappingCandidate*> *enumerateMappingCandidates(TaskDef *task, List<PPS_Definition*> *pcubesConfig);
+
+/* function that returns the number of PPUs that can receive LPUs of an LPS under a mapping; this is not always the
+   total PPU count of the mapped PPS as LPUs of an LPS are distributed only among the PPUs below the PPUs holding the
+   LPUs of the parent LPS. So an un-partitioned parent LPS restricts its children to a single PPU of its PPS.
+*/
+int getUsablePpuCount(MappingCandidate *candidate,
+		Space *lps,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints);
+
+/* function that estimates the number of LPUs of an LPS from the partition functions applied on its data structures.
+   Each dimension of the LPS contributes the number of parts its partition function divides the aligned dimensions
+   of the data structures into: 'block_count' and 'weighted_block' divide them into as many parts as their argument
+   says, when that is a constant or a hinted partition argument, while 'strided' and 'block_stride' create one part
+   per PPU. 'block_size' and un-hinted arguments make the count depend on runtime information; then the function
+   returns -1. An explicit LPU count hint for the LPS takes precedence over the partition functions.
+*/
+int estimateLpuCount(MappingCandidate *candidate,
+		Space *lps,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints);
+
+/* The computation part of the cost model estimates the relative execution time of a mapping by taking the LPSes
+   that execute code one by one and determining how well their LPUs can be distributed to the PPUs they can use. The
+   function returns a negative value if the mapping should be discarded altogether, which happens when an LPS is
+   hinted to have fewer LPUs than the PPUs it is mapped to, leaving some of them idle. LPU counts derived from the
+   partition functions are not used for pruning; they only lower the efficiency of mappings that leave PPUs idle.
+*/
+double estimateComputationCost(MappingCandidate *candidate,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints);
+
+/* The communication part of the cost model takes the synchronization requirements of the task from its static
+   analysis and determines which of them cross memory segment boundaries under the mapping. A synchronization
+   crosses segments when its confinement LPS is mapped above the PPS where memory segmentation occurs. Each such
+   synchronization contributes a cost weighted by the nature of the synchronization and the logarithm of the
+   number of segments it spans, as data movements are organized as trees of segment pairs. The segments spanned are
+   further limited by the number of LPUs the partition functions generate for the dependent LPS. Ghost region
+   synchronizations are exchanges between neighboring LPUs that proceed concurrently; so they contribute a cost
+   proportional to the number of padded sides of the partitioned dimensions instead.
+*/
+double estimateCommunicationCost(MappingCandidate *candidate,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints);
+
+/* the overall cost is the sum of the computation and communication costs; a negative value means the mapping has
+   been pruned */
+double estimateMappingCost(MappingCandidate *candidate,
+		List<PPS_Definition*> *pcubesConfig,
+		LpuCountHints *hints);
+
+/* When no mapping file is given for a program, the compiler synthesizes the mapping of each task by picking the
+   valid mapping with the lowest estimated cost. This function does that for a single task and appends the chosen
+   mapping to the file whose path is passed as the last argument, so that the regular mapping parser can process it
+   and the user can inspect, reuse, or modify the decision later.
+*/
+void synthesizeMappingConfiguration(TaskDef *task,
+		List<PPS_Definition*> *pcubesConfig,
+		const char *mappingFile);
+
+/* function that enumerates mappings of all tasks of the program, prune them using the cost model, and writes the
+   surviving candidates as separate mapping files in the output directory; at most maxCandidates mapping files are
+   generated. In addition, a summary file listing the candidates along with their estimated costs is generated.
+*/
+void generateMappingCandidates(List<Definition*> *taskDefs,
+		List<PPS_Definition*> *pcubesConfig,
+		const char *hintsFile,
+		const char *outputDir, int maxCandidates);
+
+#endif
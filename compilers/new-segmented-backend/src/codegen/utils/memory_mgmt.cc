@@ -7,16 +7,25 @@
 #include "../../../../common-libs/utils/hashtable.h"
 #include "../../../../common-libs/utils/decorator_utils.h"
 #include "../../../../common-libs/utils/string_utils.h"
+#include "../../../../common-libs/utils/properties.h"
 
 #include "../../../../frontend/src/syntax/ast.h"
+#include "../../../../frontend/src/syntax/ast_def.h"
 #include "../../../../frontend/src/syntax/ast_task.h"
+#include "../../../../frontend/src/syntax/ast_type.h"
+#include "../../../../frontend/src/syntax/ast_library_fn.h"
 #include "../../../../frontend/src/semantics/task_space.h"
+#include "../../../../frontend/src/semantics/partition_function.h"
+#include "../../../../frontend/src/semantics/computation_flow.h"
 #include "../../../../frontend/src/static-analysis/reduction_info.h"
+#include "../../../../frontend/src/static-analysis/sync_stat.h"
+#include "../../../../frontend/src/codegen-helper/communication_stat.h"
 
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
 #include <deque>
+#include <string>
 
 void genRoutineForDataPartConfig(std::ofstream &headerFile,
                 std::ofstream &programFile,
@@ -131,6 +140,19 @@ void genRoutineForDataPartConfig(std::ofstream &headerFile,
 			}
 			programFile << "ppuCount";
 			programFile << paramSeparator << matchingDim;
+			// a weighted-block configuration gets the weights loaded for the current invocation
+			WeightedBlock *weightedBlock = dynamic_cast<WeightedBlock*>(partitionConfig);
+			if (weightedBlock != NULL) {
+				Identifier *weights = weightedBlock->getWeightArrayForDimension(i + 1);
+				programFile << paramSeparator;
+				if (weights == NULL) {
+					programFile << "NULL";
+				} else {
+					programFile << "PartitionWeights::getCurrent(\"" << weights->getName() << "\"";
+					programFile << paramSeparator;
+					programFile << (weightedBlock->hasPrefixSumWeights() ? "true" : "false") << ")";
+				}
+			}
 			programFile << "))" << stmtSeparator;
 			
 			// reclaim the storage for padding configuration if applicable
@@ -173,6 +195,46 @@ void genRoutineForDataPartConfig(std::ofstream &headerFile,
 	programFile << "}\n";
 }
 
+void getPartitionWeightArrays(PartitionHierarchy *hierarchy, 
+		List<const char*> *weightArrays, List<const char*> *prefixSumArrays) {
+
+	Space *root = hierarchy->getRootSpace();
+	std::deque<Space*> lpsQueue;
+	List<Space*> *children = root->getChildrenSpaces();
+	for (int i = 0; i < children->NumElements(); i++) {
+		lpsQueue.push_back(children->Nth(i));
+	}
+        while (!lpsQueue.empty()) {
+                Space *lps = lpsQueue.front();
+                lpsQueue.pop_front();
+                children = lps->getChildrenSpaces();
+                for (int i = 0; i < children->NumElements(); i++) {
+                        lpsQueue.push_back(children->Nth(i));
+                }
+                if (lps->getSubpartition() != NULL) lpsQueue.push_back(lps->getSubpartition());
+
+		List<const char*> *structureList = lps->getLocalDataStructureNames();
+		for (int i = 0; i < structureList->NumElements(); i++) {
+			DataStructure *structure = lps->getLocalStructure(structureList->Nth(i));
+			ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(structure);
+			if (array == NULL) continue;
+			int dimensionCount = array->getDimensionality();
+			for (int d = 1; d <= dimensionCount; d++) {
+				WeightedBlock *weightedBlock = dynamic_cast<WeightedBlock*>(
+						array->getPartitionSpecForDimension(d));
+				if (weightedBlock == NULL) continue;
+				Identifier *weights = weightedBlock->getWeightArrayForDimension(d);
+				if (weights == NULL) continue;
+				List<const char*> *arrayList = weightedBlock->hasPrefixSumWeights() 
+						? prefixSumArrays : weightArrays;
+				if (!string_utils::contains(arrayList, weights->getName())) {
+					arrayList->Append(weights->getName());
+				}
+			}
+		}
+	}
+}
+
 void genRoutinesForTaskPartitionConfigs(const char *headerFileName,
                 const char *programFileName,
                 const char *initials,
@@ -698,3 +760,192 @@ void genTaskMemoryConfigRoutine(TaskDef *taskDef,
 	headerFile.close();
 	programFile.close();
 }
+
+int getSoaLayoutFieldSize(Type *type) {
+	if (type == Type::boolType) return sizeof(bool);
+	if (type == Type::charType) return sizeof(char);
+	if (type == Type::intType) return sizeof(int);
+	if (type == Type::floatType) return sizeof(float);
+	if (type == Type::doubleType) return sizeof(double);
+	return 0;
+}
+
+bool isSoaLayoutClass(TupleDef *tupleDef) {
+	
+	if (tupleDef->isEnvironment()) return false;
+	Properties *deploymentProps = PropertyReader::propertiesGroups->Lookup("deployment");
+	if (deploymentProps == NULL) return false;
+	const char *classSetting = deploymentProps->getProperty("soa.layout.classes");
+	if (classSetting == NULL) return false;
+	
+	std::string classListStr(classSetting);
+	std::string delim(",");
+	List<std::string> *classList = string_utils::tokenizeString(classListStr, delim);
+	bool listed = false;
+	for (int i = 0; i < classList->NumElements(); i++) {
+		if (classList->Nth(i).compare(tupleDef->getId()->getName()) == 0) {
+			listed = true;
+			break;
+		}
+	}
+	delete classList;
+	if (!listed) return false;
+
+	// a field that is itself an object, a list, or an array cannot be split into a sub-array of fixed sized entries
+	List<VariableDef*> *fields = tupleDef->getComponents();
+	for (int i = 0; i < fields->NumElements(); i++) {
+		if (getSoaLayoutFieldSize(fields->Nth(i)->getType()) == 0) {
+			std::cout << "Class " << tupleDef->getId()->getName() << " has non-primitive fields: ";
+			std::cout << "its arrays will not use the structure-of-arrays layout\n";
+			return false;
+		}
+	}
+	return fields->NumElements() > 0;
+}
+
+TupleDef *getSoaLayoutClass(Type *type) {
+	NamedType *namedType = dynamic_cast<NamedType*>(type);
+	if (namedType == NULL || namedType->isEnvironmentType()) return NULL;
+	List<TupleDef*> *classList = ProgramDef::program->getAllCustomTypes();
+	for (int i = 0; i < classList->NumElements(); i++) {
+		TupleDef *tupleDef = classList->Nth(i);
+		if (strcmp(tupleDef->getId()->getName(), namedType->getName()) == 0) {
+			return isSoaLayoutClass(tupleDef) ? tupleDef : NULL;
+		}
+	}
+	return NULL;
+}
+
+List<VariableDef*> *getSoaLayoutFieldOrder(TupleDef *tupleDef) {
+	List<VariableDef*> *orderedFields = new List<VariableDef*>;
+	List<VariableDef*> *fields = tupleDef->getComponents();
+	for (int i = 0; i < fields->NumElements(); i++) {
+		VariableDef *field = fields->Nth(i);
+		int size = getSoaLayoutFieldSize(field->getType());
+		int position = orderedFields->NumElements();
+		while (position > 0 
+				&& getSoaLayoutFieldSize(orderedFields->Nth(position - 1)->getType()) < size) {
+			position--;
+		}
+		orderedFields->InsertAt(field, position);
+	}
+	return orderedFields;
+}
+
+void collectScatteringStages(FlowStage *stage, List<StageInstanciation*> *stageList) {
+	StageInstanciation *computeStage = dynamic_cast<StageInstanciation*>(stage);
+	if (computeStage != NULL) {
+		List<Scatter*> *scatterList = computeStage->getNestedScatters();
+		if (scatterList->NumElements() > 0) stageList->Append(computeStage);
+		delete scatterList;
+		return;
+	}
+	CompositeStage *compositeStage = dynamic_cast<CompositeStage*>(stage);
+	if (compositeStage != NULL) {
+		List<FlowStage*> *nestedStages = compositeStage->getStageList();
+		for (int i = 0; i < nestedStages->NumElements(); i++) {
+			collectScatteringStages(nestedStages->Nth(i), stageList);
+		}
+	}
+}
+
+void collectScatterTargets(FlowStage *stage, List<const char*> *targetList) {
+	List<StageInstanciation*> *stageList = new List<StageInstanciation*>;
+	collectScatteringStages(stage, stageList);
+	for (int i = 0; i < stageList->NumElements(); i++) {
+		List<Scatter*> *scatterList = stageList->Nth(i)->getNestedScatters();
+		for (int j = 0; j < scatterList->NumElements(); j++) {
+			const char *arrayName = scatterList->Nth(j)->getTargetArrayName();
+			if (!string_utils::contains(targetList, arrayName)) {
+				targetList->Append(arrayName);
+			}
+		}
+		delete scatterList;
+	}
+	delete stageList;
+}
+
+List<const char*> *getSoaLayoutArrays(TaskDef *taskDef, int segmentedPPS) {
+	
+	List<const char*> *soaArrays = new List<const char*>;
+	Space *rootLps = taskDef->getPartitionHierarchy()->getRootSpace();
+	CompositeStage *computation = taskDef->getComputation();
+	List<const char*> *syncVars = new List<const char*>;
+	List<CommunicationCharacteristics*> *commCharList = computation->getCommCharacteristicsForSyncReqs(segmentedPPS);
+	for (int i = 0; i < commCharList->NumElements(); i++) {
+		CommunicationCharacteristics *commCharacter = commCharList->Nth(i);
+		const char *varName = commCharacter->getSyncRequirement()->getVariableName();
+		if (!string_utils::contains(syncVars, varName)) syncVars->Append(varName);
+		delete commCharacter;
+	}
+	delete commCharList;
+	List<const char*> *scatterTargets = new List<const char*>;
+	collectScatterTargets(computation, scatterTargets);
+
+	List<const char*> *structureNames = rootLps->getLocalDataStructureNames();
+	for (int i = 0; i < structureNames->NumElements(); i++) {
+		const char *varName = structureNames->Nth(i);
+		DataStructure *structure = rootLps->getLocalStructure(varName);
+		ArrayDataStructure *array = dynamic_cast<ArrayDataStructure*>(structure);
+		if (array == NULL || dynamic_cast<StaticArrayType*>(array->getType()) != NULL) continue;
+		Type *elementType = ((ArrayType*) array->getType())->getTerminalElementType();
+		if (getSoaLayoutClass(elementType) == NULL) continue;
+		
+		if (string_utils::contains(syncVars, varName)) {
+			std::cout << "\tArray " << varName << " has synchronization dependencies: ";
+			std::cout << "keeping it in the array-of-structures layout\n";
+			continue;
+		}
+		if (string_utils::contains(scatterTargets, varName)) {
+			std::cout << "\tArray " << varName << " is a scatter target: ";
+			std::cout << "keeping it in the array-of-structures layout\n";
+			continue;
+		}
+		soaArrays->Append(varName);
+	}
+	delete syncVars;
+	delete scatterTargets;
+	return soaArrays;
+}
+
+void genSoaLayoutSwitchCode(std::ofstream &stream, TaskDef *taskDef, List<const char*> *soaArrays, bool toSoa) {
+
+	if (soaArrays->NumElements() == 0) return;
+	Space *rootLps = taskDef->getPartitionHierarchy()->getRootSpace();
+	
+	if (toSoa) {
+		stream << std::endl << indent;
+		stream << "// switching arrays of classes to the structure-of-arrays layout for computation\n";
+	} else {
+		stream << std::endl << indent;
+		stream << "// switching arrays of classes back to the array-of-structures layout\n";
+	}
+	for (int i = 0; i < soaArrays->NumElements(); i++) {
+		const char *arrayName = soaArrays->Nth(i);
+		if (!toSoa) {
+			stream << indent << "taskData->switchToAosLayout(\"" << arrayName << "\"" << paramSeparator;
+			stream << arrayName << "SoaLayout)" << stmtSeparator;
+			stream << indent << "delete " << arrayName << "SoaLayout" << stmtSeparator;
+			continue;
+		}
+
+		// the layout object is created from the actual offsets and sizes the C++ compiler chooses for the fields
+		ArrayType *arrayType = (ArrayType*) rootLps->getLocalStructure(arrayName)->getType();
+		TupleDef *tupleDef = getSoaLayoutClass(arrayType->getTerminalElementType());
+		const char *className = tupleDef->getId()->getName();
+		List<VariableDef*> *fields = getSoaLayoutFieldOrder(tupleDef);
+		stream << indent << "SoaLayout *" << arrayName << "SoaLayout = new SoaLayout(";
+		stream << "sizeof(" << className << ")" << paramSeparator << fields->NumElements() << ")" << stmtSeparator;
+		for (int j = 0; j < fields->NumElements(); j++) {
+			VariableDef *field = fields->Nth(j);
+			const char *fieldName = field->getId()->getName();
+			stream << indent << arrayName << "SoaLayout->setField(" << j << paramSeparator;
+			stream << "offsetof(" << className << paramSeparator << fieldName << ")" << paramSeparator;
+			stream << "sizeof(" << field->getType()->getCType() << ")" << paramSeparator;
+			stream << '\n' << indent << doubleIndent;
+			stream << className << "_SoaView::" << fieldName << "SoaOffset)" << stmtSeparator;
+		}
+		stream << indent << "taskData->switchToSoaLayout(\"" << arrayName << "\"" << paramSeparator;
+		stream << arrayName << "SoaLayout)" << stmtSeparator;
+	}
+}
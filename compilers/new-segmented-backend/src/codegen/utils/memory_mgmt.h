@@ -14,6 +14,12 @@
 #include <fstream>
 #include <sstream>
 
+class Type;
+class TupleDef;
+class VariableDef;
+class FlowStage;
+class StageInstanciation;
+
 /* generates a function that will return the data-partition-config for an array for a particular LPS  */
 void genRoutineForDataPartConfig(std::ofstream &headerFile,
 		std::ofstream &programFile,
@@ -27,6 +33,12 @@ void genRoutinesForTaskPartitionConfigs(const char *headerFile,
                 const char *initials,
 		PartitionHierarchy *hierarchy);
 
+/* collects the names of the arrays that serve as weights of weighted-block partitions in any LPS of a task; arrays 
+   holding the weights of individual indices and those holding their prefix sums go to separate lists. The task executor 
+   loads their weights before the data-partition-configs are generated */
+void getPartitionWeightArrays(PartitionHierarchy *hierarchy, 
+		List<const char*> *weightArrays, List<const char*> *prefixSumArrays);
+
 /* generates a routine that collect data-partition-configs for different data structures within an LPS 
    to produce an LPS configuration that will be contacted during task execution to generate LPUs. To be
    effective there must be at least one data structure that will be allocated for the LPs. 
@@ -52,4 +64,33 @@ void genTaskMemoryConfigRoutine(TaskDef *taskDef,
                 const char *programFile,
                 const char *initials);
 
+/* Arrays of a user defined class can be stored in a structure-of-arrays layout during a task's computation when
+   the class is listed in the comma separated 'soa.layout.classes' deployment property and all its fields are of
+   primitive types. The following functions determine the eligible classes and arrays, and generate the code that
+   switches the layout of the arrays' data parts at the beginning and end of the computation.
+*/
+bool isSoaLayoutClass(TupleDef *tupleDef);
+
+/* returns the class definition if the argument type is a class eligible for the SoA layout, otherwise returns NULL */
+TupleDef *getSoaLayoutClass(Type *type);
+
+/* returns the size of a field of a class in the SoA layout; it is zero if the type of the field is not supported */
+int getSoaLayoutFieldSize(Type *type);
+
+/* returns the fields of a class in their SoA order; larger fields come first to keep the sub-arrays aligned */
+List<VariableDef*> *getSoaLayoutFieldOrder(TupleDef *tupleDef);
+
+/* collect the compute stages within a flow stage that have scatter library function calls and the names of the arrays
+   these scatters write to, respectively */
+void collectScatteringStages(FlowStage *stage, List<StageInstanciation*> *stageList);
+void collectScatterTargets(FlowStage *stage, List<const char*> *targetList);
+
+/* returns the names of the task global arrays that will be switched to the SoA layout; arrays having any synchroniz-
+   ation dependency and targets of scatters are kept in the default layout as the communication buffers and scatter
+   primitives copy whole elements, even when the synchronization does not cross segment boundaries */
+List<const char*> *getSoaLayoutArrays(TaskDef *taskDef, int segmentedPPS);
+
+/* generates code for the task executor function that switches the layout of the data parts of the listed arrays */
+void genSoaLayoutSwitchCode(std::ofstream &stream, TaskDef *taskDef, List<const char*> *soaArrays, bool toSoa);
+
 #endif
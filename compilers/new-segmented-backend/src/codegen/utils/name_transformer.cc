@@ -27,7 +27,10 @@ void NameTransformer::reset() {
 	globalArrays = new List<const char*>;
 	lpuPrefix = "lpu->";
 	localAccessDisabled = false;
+	lpuRandomStreamAvailable = false;
+	lpuRandomStreamUsed = false;
 	localScalars = new List<const char*>;		
+	soaLayoutArrays = new List<const char*>;
 }
 
 bool NameTransformer::isTaskGlobal(const char *varName) {
@@ -51,6 +54,13 @@ bool NameTransformer::isGlobalArray(const char *varName) {
 	return false;
 }
 
+bool NameTransformer::hasSoaLayout(const char *varName) {
+	for (int i = 0; i < soaLayoutArrays->NumElements(); i++) {
+		if (strcmp(varName, soaLayoutArrays->Nth(i)) == 0) return true;
+	}
+	return false;
+}
+
 void NameTransformer::setLocalScalars(List<const char*> *scalarList) {
 	this->localScalars = scalarList;
 }
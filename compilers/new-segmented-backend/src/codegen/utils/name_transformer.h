@@ -56,6 +56,18 @@ namespace ntransform {
 		// coordinator program and functions.
 		bool localAccessDisabled;
 
+		// This flag indicates that the code being translated has access to a random stream for the
+		// current LPU. It is only true during the translation of compute stage bodies.
+		bool lpuRandomStreamAvailable;
+		// This flag records that the translated code of a compute stage body needs the random stream
+		// of the LPU, either for random() calls or for external code blocks that may use it.
+		bool lpuRandomStreamUsed;
+
+		// Arrays of user defined classes may be stored in a structure-of-arrays layout during a
+		// task's computation. This list holds the names of such arrays. It is empty when the code 
+		// being translated is run while the arrays have their default layout.
+		List<const char*> *soaLayoutArrays;
+
 		NameTransformer();
 	  public:
 		static NameTransformer *transformer;
@@ -68,6 +80,14 @@ namespace ntransform {
 		std::string getLpuPrefix() { return lpuPrefix; }
 		void disableLocalAccess() { localAccessDisabled = true; }
 		void enableLocalAccess() { localAccessDisabled = false; }
+		void setLpuRandomStreamAvailable(bool available) { lpuRandomStreamAvailable = available; }
+		bool isLpuRandomStreamAvailable() { return lpuRandomStreamAvailable; }
+		void markLpuRandomStreamUsed() { lpuRandomStreamUsed = true; }
+		void resetLpuRandomStreamUsage() { lpuRandomStreamUsed = false; }
+		bool isLpuRandomStreamUsed() { return lpuRandomStreamUsed; }
+		void setSoaLayoutArrays(List<const char*> *arrayList) { soaLayoutArrays = arrayList; }
+		void resetSoaLayoutArrays() { soaLayoutArrays = new List<const char*>; }
+		bool hasSoaLayout(const char *varName);
 		void setLocalScalars(List<const char*> *scalarList);
 		void resetLocalScalars();
 		
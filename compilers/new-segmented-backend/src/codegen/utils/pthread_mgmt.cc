@@ -35,6 +35,7 @@ void generateArgStructForPthreadRunFn(const char *taskName, const char *fileName
 	programFile << stmtIndent << string_utils::getInitials(taskName);
 	programFile << "Partition partition" << stmtSeparator;
 	programFile << stmtIndent << "ThreadStateImpl *threadState" << stmtSeparator;
+	programFile << stmtIndent << "ExecutionContext *executionContext" << stmtSeparator;
 	programFile << "};\n";
 
 	programFile.close();
@@ -66,6 +67,8 @@ void generatePThreadRunFn(const char *headerFileName, const char *programFileNam
 	
 	programFile << stmtIndent << "PThreadArg *pthreadArg = (PThreadArg *) argument" << stmtSeparator;
 	programFile << stmtIndent << "ThreadStateImpl *threadState = pthreadArg->threadState" << stmtSeparator;
+	// the thread runs its share of the computation within the execution context of the task invocation
+	programFile << stmtIndent << "ExecutionContext::enter(pthreadArg->executionContext)" << stmtSeparator;
 	programFile << stmtIndent << "run(pthreadArg->metadata, \n";
 	programFile << stmtIndent << stmtIndent << stmtIndent << "pthreadArg->taskGlobals, \n";		
 	programFile << stmtIndent << stmtIndent << stmtIndent << "pthreadArg->threadLocals, \n";		
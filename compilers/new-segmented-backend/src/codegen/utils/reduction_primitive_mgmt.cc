@@ -40,7 +40,7 @@ const char *getMpiDataTypeStr(Type *type, ReductionOperator op) {
 
 const char *getMpiReductionOp(ReductionOperator op) {
 	if (op == SUM) return strdup("MPI_SUM");
-	if (op == PRODUCT) return strdup("MPI_PRODUCT");
+	if (op == PRODUCT) return strdup("MPI_PROD");
 	if (op == MAX) return strdup("MPI_MAX");
 	if (op == MIN) return strdup("MPI_MIN");
 	if (op == LAND) return strdup("MPI_LAND");
@@ -165,10 +165,8 @@ void generateUpdateCodeForMax(std::ofstream &programFile, std::string propertyNa
 void generateUpdateCodeForMaxEntry(std::ofstream &programFile, std::string propertyName) {
 	programFile << indent << "if (intermediateResult->data." << propertyName << " < ";
 	programFile << "localPartialResult->data." << propertyName << ") {\n";
-	programFile << doubleIndent << "intermediateResult->data." << propertyName;
-	programFile << " = localPartialResult->data." << propertyName;
-	programFile << stmtSeparator;
-	programFile << doubleIndent << "intermediateResult->index = localPartialResult->index" << stmtSeparator;	
+	// assigning the whole result copies the data along with all dimensions of the index
+	programFile << doubleIndent << "*intermediateResult = *localPartialResult" << stmtSeparator;	
 	programFile << indent << "}\n";
 }
 
@@ -184,10 +182,8 @@ void generateUpdateCodeForMin(std::ofstream &programFile, std::string propertyNa
 void generateUpdateCodeForMinEntry(std::ofstream &programFile, std::string propertyName) {
 	programFile << indent << "if (intermediateResult->data." << propertyName << " > ";
 	programFile << "localPartialResult->data." << propertyName << ") {\n";
-	programFile << doubleIndent << "intermediateResult->data." << propertyName;
-	programFile << " = localPartialResult->data." << propertyName;
-	programFile << stmtSeparator;	
-	programFile << doubleIndent << "intermediateResult->index = localPartialResult->index" << stmtSeparator;	
+	// assigning the whole result copies the data along with all dimensions of the index
+	programFile << doubleIndent << "*intermediateResult = *localPartialResult" << stmtSeparator;	
 	programFile << indent << "}\n";
 }
 
@@ -279,6 +275,39 @@ void generateCodeForDataReduction(std::ofstream &programFile, ReductionOperator
 	programFile << indent << "}\n";
 }
 
+void generateConstructorBody(std::ofstream &programFile, ReductionMetadata *rdMetadata) {
+	if (!rdMetadata->isIndexReduction()) {
+		programFile << " {}\n";
+		return;
+	}
+	programFile << " {\n";
+	programFile << indent << "setIndexDimensions(" << rdMetadata->getIndexDimensions() << ")" << stmtSeparator;
+	programFile << "}\n";
+}
+
+void generateCodeForIndexReduction(std::ofstream &programFile, ReductionOperator op, Type *varType) {
+	
+	programFile << indent << "MPI_Comm mpiComm = segmentGroup->getCommunicator()" << stmtSeparator;
+	programFile << indent << "int status = reduction::allreduceEntries(sendBuffer" << paramSeparator;
+	programFile << paramIndent << indent;
+	programFile << "receiveBuffer" << paramSeparator;
+
+	// the MPI data type of the value part of the result is needed, not that of the value and index pair
+	const char *mpiDataTypeName = getMpiDataTypeStr(varType, MAX);
+	programFile << paramIndent << indent;
+	programFile << mpiDataTypeName << paramSeparator;
+	programFile << paramIndent << indent;
+	programFile << getReductionOpString(op) << paramSeparator;
+	
+	programFile << paramIndent << indent;
+	programFile << "indexDimensions" << paramSeparator << "mpiComm)" << stmtSeparator;
+
+	programFile << indent << "if (status != MPI_SUCCESS) {\n";
+	programFile << doubleIndent << "std::cout << \"Reduction operation failed\\n\"" << stmtSeparator;
+	programFile << doubleIndent << "std::exit(EXIT_FAILURE)" << stmtSeparator;
+	programFile << indent << "}\n";
+}
+
 void generateIntraSegmentReductionPrimitive(std::ofstream &headerFile, 
                 std::ofstream &programFile,
                 const char *initials,
@@ -314,7 +343,7 @@ void generateIntraSegmentReductionPrimitive(std::ofstream &headerFile,
 	programFile << paramIndent << ": " << superclassName << "(";
 	programFile << "sizeof(" << exprType->getCType() << ")" << paramSeparator;
 	programFile << opStr << paramSeparator << "localParticipants)";
-	programFile << " {}\n"; 
+	generateConstructorBody(programFile, rdMetadata);
 	
 	// generate the definition of the result reset function in the program file
 	generateResultResetFn(programFile, initials, className, exprType, op);
@@ -367,7 +396,7 @@ void generateCrossSegmentReductionPrimitive(std::ofstream &headerFile,
 	programFile << opStr << paramSeparator;
 	programFile << paramIndent << doubleIndent;
 	programFile << "localParticipants" << paramSeparator << "segmentGroup)";
-	programFile << " {}\n"; 
+	generateConstructorBody(programFile, rdMetadata);
 
 	// generate the definition of the result reset function in the program file
 	generateResultResetFn(programFile, initials, className, exprType, op);
@@ -382,7 +411,89 @@ void generateCrossSegmentReductionPrimitive(std::ofstream &headerFile,
 	// generate the definition of terminal MPI reduction function in the program file 
 	programFile << std::endl;
 	programFile << "void " << initials << "::" << className << "::performCrossSegmentReduction() {\n";
-	generateCodeForDataReduction(programFile, op, exprType);
+	if (rdMetadata->isIndexReduction()) {
+		generateCodeForIndexReduction(programFile, op, exprType);
+	} else {
+		generateCodeForDataReduction(programFile, op, exprType);
+	}
+	programFile << "}\n";
+}
+
+void generateCodeForDataExscan(std::ofstream &programFile, ReductionOperator op, Type *varType) {
+	
+	programFile << indent << "int status = MPI_Exscan(sendBuffer" << paramSeparator;
+	programFile << paramIndent << indent;
+	programFile << "receiveBuffer" << paramSeparator;
+	programFile << paramIndent << indent;
+	programFile << 1 << paramSeparator;
+
+	const char *mpiDataTypeName = getMpiDataTypeStr(varType, op);
+	programFile << paramIndent << indent;
+	programFile << mpiDataTypeName << paramSeparator;
+
+	const char *mpiReductionOp = getMpiReductionOp(op);
+	programFile << paramIndent << indent;
+	programFile << mpiReductionOp << paramSeparator;
+	
+	programFile << paramIndent << indent;
+	programFile << "communicator)" << stmtSeparator;
+
+	programFile << indent << "if (status != MPI_SUCCESS) {\n";
+	programFile << doubleIndent << "std::cout << \"Scan operation failed\\n\"" << stmtSeparator;
+	programFile << doubleIndent << "std::exit(EXIT_FAILURE)" << stmtSeparator;
+	programFile << indent << "}\n";
+}
+
+void generateScanPrimitive(std::ofstream &headerFile,
+                std::ofstream &programFile, 
+                const char *initials,
+                ReductionMetadata *rdMetadata) {
+	
+	const char *resultVar = rdMetadata->getResultVar();
+	
+	std::ostringstream classNameStr;
+	classNameStr << "ScanPrimitive_" << resultVar;
+	const char *className = strdup(classNameStr.str().c_str());
+
+	// generate a subclass of the scan primitive for the variable in the header file
+	headerFile << "class " << className << " : public ScanPrimitive {\n";
+	headerFile << "  public: \n";
+	headerFile << indent << className << "(int localParticipants" << paramSeparator;
+	headerFile << "SegmentGroup *participantGroup)" << stmtSeparator;
+	headerFile << indent << "void resetPartialResult(reduction::Result *resultVar)" << stmtSeparator;
+	headerFile << "  protected: \n";
+	headerFile << indent << "void updateIntermediateResult(reduction::Result *localPartialResult)";
+	headerFile << stmtSeparator;
+	headerFile << indent << "void performCrossSegmentExscan()" << stmtSeparator;
+	headerFile << "}" << stmtSeparator << '\n'; 
+
+	// generate the definition of the constructor in the program file
+	Type *exprType = rdMetadata->getExprType();
+	ReductionOperator op = rdMetadata->getOpCode();
+	const char *opStr = getReductionOpString(op);
+	const char *modeStr = (rdMetadata->getScanMode() == EXCLUSIVE_SCAN) ? "EXCLUSIVE_SCAN" : "INCLUSIVE_SCAN";
+	programFile << initials << "::" << className << "::" << className << "(";
+	programFile << "int localParticipants" << paramSeparator;
+	programFile << paramIndent << "SegmentGroup *participantGroup)";
+	programFile << paramIndent << ": ScanPrimitive(";
+	programFile << "sizeof(" << exprType->getCType() << ")" << paramSeparator;
+	programFile << opStr << paramSeparator << modeStr << paramSeparator;
+	programFile << paramIndent << doubleIndent;
+	programFile << "localParticipants" << paramSeparator << "participantGroup)";
+	programFile << " {}\n"; 
+
+	// the result reset and intermediate result update functions are the same as those of reduction primitives
+	generateResultResetFn(programFile, initials, className, exprType, op);
+	programFile << std::endl;
+	programFile << "void " << initials << "::" << className << "::updateIntermediateResult(";
+	programFile << paramIndent << "reduction::Result *localPartialResult) {\n";
+	generateIntermediateResultUpdateFnBody(programFile, exprType, op);
+	programFile << "}\n";
+
+	// generate the definition of the cross-segment exclusive scan function in the program file 
+	programFile << std::endl;
+	programFile << "void " << initials << "::" << className << "::performCrossSegmentExscan() {\n";
+	generateCodeForDataExscan(programFile, op, exprType);
 	programFile << "}\n";
 }
 
@@ -434,6 +545,21 @@ void generateReductionPrimitiveClasses(const char *headerFileName,
 			generateIntraSegmentReductionPrimitive(headerFile,
                 			programFile, initials, reduction, rootLps);
 		}	
+
+		// A scan needs an additional primitive to combine the reduced results of different LPUs. An LPU
+		// shared by multiple segments would contribute to the scan multiple times; so the scan is only
+		// supported when the root LPS is mapped at or below the PPS of memory segmentation.
+		if (reduction->isScan()) {
+			if (ppsId > segmentedPpsId) {
+				std::cout << "Scan of '" << reduction->getResultVar() << "' is rooted at Space ";
+				std::cout << reductionRootLps->getName() << " that is mapped above the segmented PPS\n";
+				std::cout << "Map the scan's root LPS to the segmented PPS or to a lower PPS\n";
+				std::exit(EXIT_FAILURE);
+			}
+			headerFile << std::endl;
+			programFile << std::endl;
+			generateScanPrimitive(headerFile, programFile, initials, reduction);
+		}
 	}
        
 	headerFile.close();
@@ -464,6 +590,9 @@ void generateReductionPrimitiveDecls(const char *headerFileName, List<ReductionM
 		headerFile << "static " << classNamePrefix << "ReductionPrimitive *" << varName << "Reducer[";
 		headerFile << "Space_" << reductionRootLps->getName() << "_Threads_Per_Segment]";
 		headerFile << stmtSeparator;
+		if (reduction->isScan()) {
+			headerFile << "static ScanPrimitive *" << varName << "Scanner" << stmtSeparator;
+		}
 	}
 
 	headerFile.close();
@@ -491,14 +620,16 @@ void generateReductionPrimitiveInitFn(const char *headerFileName,
 	headerFile << std::endl;
 	programFile << std::endl;
 
-	headerFile << "void setupReductionPrimitives(std::ofstream &logFile)" << stmtSeparator;
-	programFile << "void " << initials << "::setupReductionPrimitives(std::ofstream &logFile) {\n";
+	headerFile << "void setupReductionPrimitives(SegmentGroup *participantGroup" << paramSeparator;
+	headerFile << "std::ofstream &logFile)" << stmtSeparator;
+	programFile << "void " << initials << "::setupReductionPrimitives(SegmentGroup *participantGroup" << paramSeparator;
+	programFile << paramIndent << "std::ofstream &logFile) {\n";
 
 	programFile << std::endl;
 	programFile << indent << "int segmentId " << paramSeparator << "segmentCount" << stmtSeparator;
-	programFile << indent << "MPI_Comm_rank(MPI_COMM_WORLD" << paramSeparator;
+	programFile << indent << "MPI_Comm_rank(ExecutionContext::getCommunicator()" << paramSeparator;
 	programFile << "&segmentId)" << stmtSeparator;
-	programFile << indent << "MPI_Comm_size(MPI_COMM_WORLD" << paramSeparator;
+	programFile << indent << "MPI_Comm_size(ExecutionContext::getCommunicator()" << paramSeparator;
 	programFile << "&segmentCount)" << stmtSeparator;
 
 	for (int i = 0; i < reductionInfos->NumElements(); i++) {
@@ -546,7 +677,7 @@ void generateReductionPrimitiveInitFn(const char *headerFileName,
 			// ticipation status
 			programFile << tripleIndent << "if(segmentId / " << varName;
 			programFile << "SegmentsPerPrim == i) {\n";
-			programFile << quadIndent << "segmentGroup = new SegmentGroup()";
+			programFile << quadIndent << "segmentGroup = InvocationArena::track(new SegmentGroup())";
 			programFile << stmtSeparator << quadIndent;
 			programFile << "segmentGroup->discoverGroupAndSetupCommunicator(logFile)";
 			programFile << stmtSeparator;
@@ -588,6 +719,17 @@ void generateReductionPrimitiveInitFn(const char *headerFileName,
 			programFile << indent << "}\n";
 
 		}
+
+		// a scan has a single scan primitive per segment that all PPU controllers of the executor LPS share; it 
+		// combines segment totals over the group of segments participating in the task
+		if (reduction->isScan()) {
+			programFile << indent << varName << "Scanner = InvocationArena::track(new ScanPrimitive_";
+			programFile << varName << "(";
+			programFile << paramIndent << indent;
+			programFile << "Space_" << rdExecLpsName << "_Threads_Per_Segment";
+			programFile << paramSeparator << "participantGroup))" << stmtSeparator;
+			programFile << indent << varName << "Scanner->setLogFile(&logFile)" << stmtSeparator;
+		}
 		
 		programFile << indent << "} // scope ends\n";
 	}
@@ -652,6 +794,10 @@ void generateReductionPrimitiveMapCreateFnForThread(const char *headerFileName,
 
 		programFile << doubleIndent << "rdPrimitiveMap->Enter(\"" << varName << "\"" << paramSeparator;
 		programFile << varName << "Reducer[space" << rdRootLpsName << "Group])" << stmtSeparator;
+		if (reduction->isScan()) {
+			programFile << doubleIndent << "rdPrimitiveMap->Enter(\"" << varName << "Scanner\"";
+			programFile << paramSeparator << varName << "Scanner)" << stmtSeparator;
+		}
 	
 		programFile << indent << "}\n";
 	}	
@@ -60,10 +60,22 @@ void generateIntermediateResultUpdateFnBody(std::ofstream &programFile,
 void generateCodeForDataReduction(std::ofstream &programFile, 
 		ReductionOperator op, Type *varType);
 
+// a scan uses an MPI_Exscan of segment totals in place of the MPI_Allreduce of a reduction
+void generateCodeForDataExscan(std::ofstream &programFile, 
+		ReductionOperator op, Type *varType);
+
+// index reductions exchange the value of the result along with all dimensions of its index
+void generateCodeForIndexReduction(std::ofstream &programFile, 
+		ReductionOperator op, Type *varType);
+
 /**********************************************************************************************************************
 					Reduction Primitive Class Generators
 ***********************************************************************************************************************/
 
+// generates the body of a reduction primitive's constructor; index reductions record the number of dimensions 
+// in their results there
+void generateConstructorBody(std::ofstream &programFile, ReductionMetadata *rdMetadata);
+
 void generateIntraSegmentReductionPrimitive(std::ofstream &headerFile, 
 		std::ofstream &programFile, 
 		const char *initials, 
@@ -76,6 +88,11 @@ void generateCrossSegmentReductionPrimitive(std::ofstream &headerFile,
 		ReductionMetadata *rdMetadata, 
 		Space *rootLps);
 
+void generateScanPrimitive(std::ofstream &headerFile,
+		std::ofstream &programFile,
+		const char *initials,
+		ReductionMetadata *rdMetadata);
+
 /* this function invokes the above to functions to create appropriate reduction primitive subclass for all 
    reduction operations found in the task */
 void generateReductionPrimitiveClasses(const char *headerFile,
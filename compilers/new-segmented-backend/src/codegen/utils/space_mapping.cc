@@ -10,6 +10,7 @@
 #include "../../../../frontend/src/static-analysis/usage_statistic.h"
 
 #include <cstdlib>
+#include <cctype>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -25,6 +26,99 @@ void PPS_Definition::print(int indentLevel) {
 	if (coreSpace) std::cout << indent.str() << "Computation Core\n";
 	if (segmented) std::cout << indent.str() << "Segmented Memory\n";	
 	if (physicalUnit) std::cout << indent.str() << "Physical Unit\n";
+	if (memorySize > 0) std::cout << indent.str() << "Memory: " << memorySize << " Bytes\n";
+	if (bandwidth > 0) std::cout << indent.str() << "Bandwidth: " << bandwidth << " GB/s\n";
+	if (latency > 0) std::cout << indent.str() << "Latency: " << latency << " ns\n";
+	if (weights != NULL) {
+		std::cout << indent.str() << "PPU Weights:";
+		for (int i = 0; i < weights->NumElements(); i++) {
+			std::cout << ' ' << weights->Nth(i);
+		}
+		std::cout << '\n';
+	}
+}
+
+List<int> *parsePpuWeights(std::string &description, const char *spaceName, int ppuCount) {
+
+	// drop any comment following the weights and check if there is a weight list at all
+	int commentStart = description.find("//");
+	if (commentStart != std::string::npos) description = description.substr(0, commentStart);
+	int listBegin = description.find('{');
+	if (listBegin == std::string::npos) return NULL;
+	int listEnd = description.find('}', listBegin);
+	if (listEnd == std::string::npos) {
+		std::cout << "unterminated PPU weight list for Space " << spaceName << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	// each comma separated entry is either a single weight or a 'weight*repetition' pair
+	std::string listStr = description.substr(listBegin + 1, listEnd - listBegin - 1);
+	std::string entrySeparator = ",";
+	std::string repeatSeparator = "*";
+	List<std::string> *entryList = string_utils::tokenizeString(listStr, entrySeparator);
+	List<int> *weights = new List<int>;
+	for (int i = 0; i < entryList->NumElements(); i++) {
+		std::string entry = entryList->Nth(i);
+		string_utils::trim(entry);
+		List<std::string> *parts = string_utils::tokenizeString(entry, repeatSeparator);
+		int weight = atoi(parts->Nth(0).c_str());
+		int repetition = (parts->NumElements() > 1) ? atoi(parts->Nth(1).c_str()) : 1;
+		if (weight <= 0 || repetition <= 0) {
+			std::cout << "invalid PPU weight entry '" << entry << "' for Space " << spaceName << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+		for (int j = 0; j < repetition; j++) weights->Append(weight);
+	}
+	if (weights->NumElements() != ppuCount) {
+		std::cout << "Space " << spaceName << " has " << ppuCount << " PPUs but ";
+		std::cout << weights->NumElements() << " PPU weights" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	// a weight list having the same weight for all PPUs is equivalent to having no weights
+	bool symmetric = true;
+	for (int i = 1; i < weights->NumElements(); i++) {
+		if (weights->Nth(i) != weights->Nth(0)) {
+			symmetric = false;
+			break;
+		}
+	}
+	if (symmetric) {
+		delete weights;
+		return NULL;
+	}
+	return weights;
+}
+
+void readMemoryAttributes(PPS_Definition *space, List<const char*> *attrList) {
+	space->memorySize = 0;
+	space->bandwidth = 0;
+	space->latency = 0;
+	for (int i = 0; i < attrList->NumElements(); i++) {
+		std::string attr = std::string(attrList->Nth(i));
+		int separator = attr.find('=');
+		if (separator == std::string::npos) continue;
+		std::string key = attr.substr(0, separator);
+		std::string value = attr.substr(separator + 1);
+		if (key.compare("memory") == 0) {
+			// sizes are written with an optional K, M, or G unit as in '48KB' or '24MB'
+			long int size = atol(value.c_str());
+			int unitStart = value.find_first_not_of("0123456789");
+			if (unitStart != std::string::npos) {
+				char unit = toupper(value[unitStart]);
+				if (unit == 'K') size *= 1024l;
+				else if (unit == 'M') size *= 1024l * 1024;
+				else if (unit == 'G') size *= 1024l * 1024 * 1024;
+			}
+			space->memorySize = size;
+		} else if (key.compare("bandwidth") == 0) {
+			space->bandwidth = atof(value.c_str());
+		} else if (key.compare("latency") == 0) {
+			space->latency = atof(value.c_str());
+		} else {
+			std::cout << "ignoring unknown attribute '" << attr << "' of Space " << space->id << std::endl;
+		}
+	}
 }
 
 List<PPS_Definition*> *parsePCubeSDescription(const char *filePath) {
@@ -74,6 +168,10 @@ List<PPS_Definition*> *parsePCubeSDescription(const char *filePath) {
 		int countEnd = ppuCountStr.find(')');
 		int ppuCount = atoi(ppuCountStr.substr(0, countEnd).c_str());
 
+		// read the relative throughput weights of the PPUs if the space is asymmetric
+		std::string weightsStr = ppuCountStr.substr(countEnd + 1);
+		List<int> *weights = parsePpuWeights(weightsStr, spaceName.c_str(), ppuCount);
+
 		// create a PPS definition
 		PPS_Definition *spaceDefinition = new PPS_Definition();
 		spaceDefinition->id = spaceId;
@@ -82,6 +180,8 @@ List<PPS_Definition*> *parsePCubeSDescription(const char *filePath) {
 		spaceDefinition->coreSpace = coreSpace;
 		spaceDefinition->segmented = segmented;
 		spaceDefinition->physicalUnit = physicalUnit;
+		spaceDefinition->weights = weights;
+		readMemoryAttributes(spaceDefinition, attrList);
 			
 		// store the space definition in the list in top-down order
 		int i = 0;	
@@ -295,6 +395,18 @@ void generatePPSCountConstants(const char *outputFile, List<PPS_Definition*> *pc
 			programFile << " = " << pps->units << stmtSeparator;
 			prevSpaceId = pps->id;
 		}
+
+		// generate arrays of relative PPU weights for spaces having asymmetric sibling PPUs
+		for (int i = 0; i < pcubesConfig->NumElements(); i++) {
+			pps = pcubesConfig->Nth(i);
+			if (!pps->isWeighted()) continue;
+			programFile << "const int Space_" << pps->id << "_PPU_Weights[] = {";
+			for (int j = 0; j < pps->weights->NumElements(); j++) {
+				if (j > 0) programFile << ", ";
+				programFile << pps->weights->Nth(j);
+			}
+			programFile << "}" << stmtSeparator;
+		}
     		programFile.close();
   	} else {
 		std::cout << "Unable to open output program file";
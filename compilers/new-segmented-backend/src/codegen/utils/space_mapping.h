@@ -8,6 +8,7 @@
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../frontend/src/semantics/task_space.h"
 #include <iostream>
+#include <string>
 
 /* object definition to keep track of the configuration of a PCubeS space (aka a PPS) */
 class PPS_Definition {
@@ -40,7 +41,25 @@ class PPS_Definition {
 	*/
 	bool physicalUnit;
 
+	/* Sibling PPUs of a space are not always equally capable. For example, a processor may have
+	   both performance and efficiency cores. An optional list of relative throughput weights,
+	   one per PPU under a parent PPU, can follow the PPU count in the description file as in
+	   'Core (20) {4*12, 3*8}', where 'w*n' repeats weight w for n PPUs. LPUs are then divided
+	   among the PPUs in proportion to their weights. This list is NULL for symmetric spaces.
+	*/
+	List<int> *weights;
+
+	/* Optional characteristics of the memory of a space are given as '<memory=size>', '<bandwidth=GB/s>', and 
+	   '<latency=ns>' attributes. The pcubes-discover tool generates them from cache/NUMA topology information 
+	   and short probes so that mapping and tiling decisions can take them into account. A value is zero when 
+	   the description does not mention it.  
+	*/
+	long int memorySize;
+	float bandwidth;
+	float latency;
+
 	void print(int indentLevel);
+	bool isWeighted() { return weights != NULL; }
 };
 
 /* object definition to identify an LPS-PPS mapping */
@@ -62,6 +81,13 @@ class MappingNode {
 /* function definition to read the PCubeS description of the hardware from a file */
 List<PPS_Definition*> *parsePCubeSDescription(const char *filePath);
 
+/* function definition to read the optional PPU weight list that follows the PPU count of a space; it 
+   returns NULL if there is no list or all PPUs have the same weight */
+List<int> *parsePpuWeights(std::string &description, const char *spaceName, int ppuCount);
+
+/* function definition to read the 'key=value' memory characteristics attributes of a space */
+void readMemoryAttributes(PPS_Definition *space, List<const char*> *attrList);
+
 /* function defintion to parse the mapping configuration file */
 MappingNode *parseMappingConfiguration(const char *taskName, 
 		const char *filePath, 
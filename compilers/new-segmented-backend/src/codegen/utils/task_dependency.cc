@@ -0,0 +1,544 @@
+#include "task_dependency.h"
+
+#include "../../../../frontend/src/syntax/ast.h"
+#include "../../../../frontend/src/syntax/ast_expr.h"
+#include "../../../../frontend/src/syntax/ast_stmt.h"
+#include "../../../../frontend/src/syntax/ast_task.h"
+#include "../../../../frontend/src/syntax/ast_type.h"
+#include "../../../../frontend/src/syntax/ast_library_fn.h"
+#include "../../../../frontend/src/semantics/task_space.h"
+#include "../../../../frontend/src/static-analysis/task_env_stat.h"
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/hashtable.h"
+#include "../../../../common-libs/utils/string_utils.h"
+#include "../../../../common-libs/utils/properties.h"
+
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+
+//------------------------------------------------------------- Invocation Node ----------------------------------------------------------/
+
+InvocationNode::InvocationNode(int index, TaskInvocation *invocation, const char *envName) {
+	this->index = index;
+	this->invocation = invocation;
+	this->envName = envName;
+	this->predecessors = new List<InvocationNode*>;
+	this->independents = new List<InvocationNode*>;
+}
+
+void InvocationNode::addPredecessor(InvocationNode *node) {
+	if (node == this) return;
+	for (int i = 0; i < predecessors->NumElements(); i++) {
+		if (predecessors->Nth(i) == node) return;
+	}
+	predecessors->Append(node);
+}
+
+bool InvocationNode::dependsOn(InvocationNode *node) {
+	for (int i = 0; i < predecessors->NumElements(); i++) {
+		InvocationNode *predecessor = predecessors->Nth(i);
+		if (predecessor == node || predecessor->dependsOn(node)) return true;
+	}
+	return false;
+}
+
+void InvocationNode::describe(std::ostream &stream, int indentLevel) {
+	for (int i = 0; i < indentLevel; i++) stream << '\t';
+	stream << "Invocation " << index << " (" << invocation->getTaskName() << " on " << envName << ")";
+	stream << ": depends on ";
+	if (predecessors->NumElements() == 0) stream << "none";
+	for (int i = 0; i < predecessors->NumElements(); i++) {
+		if (i > 0) stream << ", ";
+		stream << predecessors->Nth(i)->index;
+	}
+	stream << "; independent of ";
+	if (independents->NumElements() == 0) stream << "none";
+	for (int i = 0; i < independents->NumElements(); i++) {
+		if (i > 0) stream << ", ";
+		stream << independents->Nth(i)->index;
+	}
+	stream << "\n";
+}
+
+//--------------------------------------------------------------- Data Object ------------------------------------------------------------/
+
+DataObject::DataObject() {
+	producers = new List<InvocationNode*>;
+	readers = new List<InvocationNode*>;
+	mergedInto = NULL;
+}
+
+DataObject *DataObject::getRepresentative() {
+	DataObject *object = this;
+	while (object->mergedInto != NULL) object = object->mergedInto;
+	return object;
+}
+
+void DataObject::clearAccesses() {
+	producers->clear();
+	readers->clear();
+}
+
+//---------------------------------------------------------- Task Dependency Analyzer ----------------------------------------------------/
+
+TaskDependencyAnalyzer *TaskDependencyAnalyzer::coordinatorAnalysis = NULL;
+List<const char*> *TaskDependencyAnalyzer::exclusiveTasks = new List<const char*>;
+
+TaskDependencyAnalyzer::TaskDependencyAnalyzer() {
+	nodes = new List<InvocationNode*>;
+	sequenceNodes = new List<InvocationNode*>;
+	locationMap = new Hashtable<DataObject*>;
+	locationKeys = new List<const char*>;
+	maxConcurrency = 1;
+}
+
+void TaskDependencyAnalyzer::requireExclusiveLaunch(const char *taskName) {
+	if (!string_utils::contains(exclusiveTasks, taskName)) {
+		exclusiveTasks->Append(taskName);
+	}
+}
+
+void TaskDependencyAnalyzer::analyzeProgram(Stmt *coordinatorCode) {
+	analyzeStmt(coordinatorCode);
+}
+
+InvocationNode *TaskDependencyAnalyzer::getNode(TaskInvocation *invocation) {
+	for (int i = 0; i < nodes->NumElements(); i++) {
+		InvocationNode *node = nodes->Nth(i);
+		if (node->invocation == invocation) return node;
+	}
+	return NULL;
+}
+
+void TaskDependencyAnalyzer::describe(std::ostream &stream) {
+	for (int i = 0; i < nodes->NumElements(); i++) {
+		nodes->Nth(i)->describe(stream, 1);
+	}
+}
+
+void TaskDependencyAnalyzer::generateDependencyComment(std::ostringstream &stream,
+		TaskInvocation *invocation, int indentLevel) {
+	InvocationNode *node = getNode(invocation);
+	if (node == NULL) return;
+	for (int i = 0; i < indentLevel; i++) stream << '\t';
+	stream << "// ";
+	node->describe(stream, 0);
+}
+
+List<TaskInvocation*> *TaskDependencyAnalyzer::getConcurrentRun(List<Stmt*> *stmts, int startIndex) {
+
+	if (!isConcurrencyEnabled()) return NULL;
+	List<InvocationNode*> *run = new List<InvocationNode*>;
+	for (int i = startIndex; i < stmts->NumElements(); i++) {
+		TaskInvocation *invocation = dynamic_cast<TaskInvocation*>(stmts->Nth(i));
+		if (invocation == NULL) break;
+		InvocationNode *node = getNode(invocation);
+		if (node == NULL || string_utils::contains(exclusiveTasks, invocation->getTaskDef()->getName())) break;
+
+		// the invocation joins the run only if it is independent of all earlier members and does not share a task
+		// or an environment with any of them
+		bool joins = true;
+		for (int j = 0; j < run->NumElements(); j++) {
+			InvocationNode *member = run->Nth(j);
+			bool independent = false;
+			for (int k = 0; k < node->independents->NumElements(); k++) {
+				if (node->independents->Nth(k) == member) {
+					independent = true;
+					break;
+				}
+			}
+			if (!independent 
+					|| member->invocation->getTaskDef() == invocation->getTaskDef()
+					|| strcmp(member->envName, node->envName) == 0) {
+				joins = false;
+				break;
+			}
+		}
+		if (!joins) break;
+		run->Append(node);
+	}
+
+	List<TaskInvocation*> *invocations = NULL;
+	if (run->NumElements() > 1) {
+		invocations = new List<TaskInvocation*>;
+		for (int i = 0; i < run->NumElements(); i++) {
+			invocations->Append(run->Nth(i)->invocation);
+		}
+		if (run->NumElements() > maxConcurrency) maxConcurrency = run->NumElements();
+	}
+	delete run;
+	return invocations;
+}
+
+void TaskDependencyAnalyzer::analyzeStmt(Stmt *stmt) {
+
+	StmtBlock *block = dynamic_cast<StmtBlock*>(stmt);
+	if (block != NULL) {
+		List<Stmt*> *stmts = block->getStmts();
+		for (int i = 0; i < stmts->NumElements(); i++) {
+			analyzeStmt(stmts->Nth(i));
+		}
+		return;
+	}
+
+	TaskInvocation *invocation = dynamic_cast<TaskInvocation*>(stmt);
+	if (invocation != NULL) {
+		processInvocation(invocation);
+		return;
+	}
+	AssignmentExpr *assignment = dynamic_cast<AssignmentExpr*>(stmt);
+	if (assignment != NULL) {
+		processAssignment(assignment);
+		return;
+	}
+	BindOperation *binding = dynamic_cast<BindOperation*>(stmt);
+	if (binding != NULL) {
+		processBinding(binding);
+		return;
+	}
+
+	// other expressions in the coordinator program do not change any environment item or variable
+	if (dynamic_cast<Expr*>(stmt) != NULL) return;
+
+	// a loop or a conditional block without any task invocation within is treated as a set of assignments that may or
+	// may not take place
+	if (!containsTaskInvocation(stmt)) {
+		processConditionalAssignments(stmt);
+		return;
+	}
+
+	// Otherwise the statement acts as a barrier. The assignments inside may be repeated or skipped depending on the
+	// control flow; so the objects the assigned locations refer to before and after the statement should be treated as
+	// the same object. In addition, the objects assigned to each other inside a loop are merged before analyzing the
+	// loop body as an assignment at the end of one iteration is effective at the beginning of the next.
+	List<DataObject*> *snapshot = takeSnapshot();
+	processConditionalAssignments(stmt);
+	startNewSequence();
+
+	IfStmt *ifStmt = dynamic_cast<IfStmt*>(stmt);
+	LoopStmt *loopStmt = dynamic_cast<LoopStmt*>(stmt);
+	WhileStmt *whileStmt = dynamic_cast<WhileStmt*>(stmt);
+	if (ifStmt != NULL) {
+		List<ConditionalStmt*> *ifBlocks = ifStmt->getIfBlocks();
+		for (int i = 0; i < ifBlocks->NumElements(); i++) {
+			analyzeStmt(ifBlocks->Nth(i)->getStmt());
+			mergeWithSnapshot(snapshot);
+			startNewSequence();
+		}
+	} else if (loopStmt != NULL) {
+		analyzeStmt(loopStmt->getBody());
+	} else if (whileStmt != NULL) {
+		analyzeStmt(whileStmt->getBody());
+	}
+
+	mergeWithSnapshot(snapshot);
+	startNewSequence();
+	delete snapshot;
+}
+
+void TaskDependencyAnalyzer::processInvocation(TaskInvocation *invocation) {
+
+	const char *envName = getLocationKey(invocation->getEnvArgument());
+	if (envName == NULL) envName = invocation->getTaskName();
+	InvocationNode *node = new InvocationNode(nodes->NumElements() + 1, invocation, envName);
+
+	// the task depends on the producers of any coordinator value used in its initialization and partition arguments
+	List<Expr*> *arguments = new List<Expr*>;
+	List<Expr*> *initArgs = invocation->getInitArguments();
+	if (initArgs != NULL) arguments->AppendAll(initArgs);
+	List<Expr*> *partitionArgs = invocation->getPartitionArguments();
+	if (partitionArgs != NULL) arguments->AppendAll(partitionArgs);
+	for (int i = 0; i < arguments->NumElements(); i++) {
+		List<const char*> *readLocations = getReadLocations(arguments->Nth(i));
+		for (int j = 0; j < readLocations->NumElements(); j++) {
+			readObject(getObject(readLocations->Nth(j)), node);
+		}
+		delete readLocations;
+	}
+	delete arguments;
+
+	// then it depends on the environmental data structures it reads and updates
+	TaskDef *taskDef = invocation->getTaskDef();
+	TaskEnvStat *envStat = taskDef->getAfterExecutionEnvStat();
+	Space *rootLps = taskDef->getPartitionHierarchy()->getRootSpace();
+	List<EnvironmentLink*> *envLinks = taskDef->getEnvironmentLinks();
+	for (int i = 0; i < envLinks->NumElements(); i++) {
+
+		EnvironmentLink *link = envLinks->Nth(i);
+		const char *varName = link->getVariable()->getName();
+		std::ostringstream location;
+		location << envName << "." << varName;
+		const char *locationKey = strdup(location.str().c_str());
+
+		// a created item is a new object produced by the task
+		if (link->getMode() == TypeCreate) {
+			DataObject *object = new DataObject();
+			setObject(locationKey, object);
+			writeObject(object, node);
+			continue;
+		}
+
+		// The access statistics are gathered from the compute stages of a task. A scalar may be used in the task's
+		// initialize section or be an output as well; so scalars are conservatively treated as both read and updated.
+		// An array without any statistics is, similarly, treated as read.
+		DataObject *object = getObject(locationKey);
+		EnvVarStat *varStat = envStat->getVariableStat(varName);
+		DataStructure *structure = rootLps->getStructure(varName);
+		bool isArray = (dynamic_cast<ArrayDataStructure*>(structure) != NULL);
+		if (!isArray) {
+			readObject(object, node);
+			writeObject(object, node);
+		} else if (varStat == NULL) {
+			readObject(object, node);
+		} else {
+			if (varStat->isRead() || !varStat->isUpdated()) readObject(object, node);
+			if (varStat->isUpdated()) writeObject(object, node);
+		}
+	}
+
+	// all earlier invocations of the current straight-line sequence that the task does not depend on can run with it
+	for (int i = 0; i < sequenceNodes->NumElements(); i++) {
+		InvocationNode *earlierNode = sequenceNodes->Nth(i);
+		if (!node->dependsOn(earlierNode)) node->independents->Append(earlierNode);
+	}
+	sequenceNodes->Append(node);
+	nodes->Append(node);
+}
+
+DataObject *TaskDependencyAnalyzer::processAssignment(AssignmentExpr *assignment) {
+
+	Expr *left = assignment->getLeft();
+	Expr *right = assignment->getRight();
+
+	// resolve the chain of assignments, as in 'a = b = c', from the right
+	DataObject *source = NULL;
+	AssignmentExpr *rightAssignment = dynamic_cast<AssignmentExpr*>(right);
+	if (rightAssignment != NULL) {
+		source = processAssignment(rightAssignment);
+	}
+
+	// determine the invocations that produced the values being assigned
+	List<InvocationNode*> *producers = new List<InvocationNode*>;
+	if (source != NULL) {
+		producers->AppendAll(source->getRepresentative()->producers);
+	} else {
+		List<const char*> *readLocations = getReadLocations(right);
+		for (int i = 0; i < readLocations->NumElements(); i++) {
+			producers->AppendAll(getObject(readLocations->Nth(i))->producers);
+		}
+		delete readLocations;
+	}
+
+	// if only some elements of an item or variable are updated then the object it refers to gets new producers
+	const char *leftKey = getLocationKey(left);
+	if (leftKey == NULL) {
+		List<const char*> *leftLocations = getReadLocations(left);
+		for (int i = 0; i < leftLocations->NumElements(); i++) {
+			getObject(leftLocations->Nth(i))->producers->AppendAll(producers);
+		}
+		delete leftLocations;
+		delete producers;
+		return NULL;
+	}
+
+	// array assignments make both sides refer to the same object
+	Type *type = left->getType();
+	if (type != NULL && dynamic_cast<ArrayType*>(type) != NULL) {
+		if (source == NULL) {
+			const char *rightKey = getLocationKey(right);
+			if (rightKey != NULL) source = getObject(rightKey);
+		}
+		if (source != NULL) {
+			setObject(leftKey, source->getRepresentative());
+			delete producers;
+			return source->getRepresentative();
+		}
+	}
+
+	// other assignments give the left side a new object with the producers of the values assigned
+	DataObject *object = new DataObject();
+	object->producers->AppendAll(producers);
+	setObject(leftKey, object);
+	delete producers;
+	return object;
+}
+
+void TaskDependencyAnalyzer::processBinding(LibraryFunction *bindFn) {
+
+	// reading an environment item from a file gives the item a new object; writing an item to a file does not change it
+	if (dynamic_cast<BindInput*>(bindFn) == NULL) return;
+	List<Expr*> *arguments = bindFn->getArguments();
+	const char *envName = getLocationKey(arguments->Nth(0));
+	StringConstant *itemName = dynamic_cast<StringConstant*>(arguments->Nth(1));
+	if (envName == NULL || itemName == NULL) return;
+	std::ostringstream location;
+	location << envName << "." << itemName->getValue();
+	setObject(strdup(location.str().c_str()), new DataObject());
+}
+
+void TaskDependencyAnalyzer::processConditionalAssignments(Stmt *stmt) {
+
+	List<Expr*> *assignments = new List<Expr*>;
+	stmt->retrieveExprByType(assignments, ASSIGN_EXPR);
+	for (int i = 0; i < assignments->NumElements(); i++) {
+		AssignmentExpr *assignment = (AssignmentExpr*) assignments->Nth(i);
+		Expr *left = assignment->getLeft();
+		Expr *right = assignment->getRight();
+
+		// an assignment that may take place merges the objects of its two sides if they are arrays, and adds the
+		// producers of the right side to the object of the left side otherwise
+		List<const char*> *leftLocations = getReadLocations(left);
+		Type *type = left->getType();
+		const char *leftKey = getLocationKey(left);
+		const char *rightKey = getLocationKey(right);
+		if (type != NULL && dynamic_cast<ArrayType*>(type) != NULL && leftKey != NULL && rightKey != NULL) {
+			mergeObjects(getObject(leftKey), getObject(rightKey));
+		} else {
+			List<const char*> *readLocations = getReadLocations(right);
+			for (int j = 0; j < leftLocations->NumElements(); j++) {
+				DataObject *leftObject = getObject(leftLocations->Nth(j));
+				for (int k = 0; k < readLocations->NumElements(); k++) {
+					leftObject->producers->AppendAll(getObject(readLocations->Nth(k))->producers);
+				}
+			}
+			delete readLocations;
+		}
+		delete leftLocations;
+	}
+	delete assignments;
+}
+
+void TaskDependencyAnalyzer::startNewSequence() {
+	sequenceNodes->clear();
+	for (int i = 0; i < locationKeys->NumElements(); i++) {
+		getObject(locationKeys->Nth(i))->clearAccesses();
+	}
+}
+
+List<DataObject*> *TaskDependencyAnalyzer::takeSnapshot() {
+	List<DataObject*> *snapshot = new List<DataObject*>;
+	for (int i = 0; i < locationKeys->NumElements(); i++) {
+		snapshot->Append(getObject(locationKeys->Nth(i)));
+	}
+	return snapshot;
+}
+
+void TaskDependencyAnalyzer::mergeWithSnapshot(List<DataObject*> *snapshot) {
+	for (int i = 0; i < snapshot->NumElements(); i++) {
+		DataObject *current = getObject(locationKeys->Nth(i));
+		DataObject *earlier = snapshot->Nth(i)->getRepresentative();
+		if (current != earlier) {
+			setObject(locationKeys->Nth(i), mergeObjects(current, earlier));
+		}
+	}
+}
+
+DataObject *TaskDependencyAnalyzer::getObject(const char *location) {
+	DataObject *object = locationMap->Lookup(location);
+	if (object == NULL) {
+		object = new DataObject();
+		locationMap->Enter(location, object);
+		locationKeys->Append(strdup(location));
+	}
+	return object->getRepresentative();
+}
+
+void TaskDependencyAnalyzer::setObject(const char *location, DataObject *object) {
+	if (locationMap->Lookup(location) == NULL) {
+		locationKeys->Append(strdup(location));
+	}
+	locationMap->Enter(location, object);
+}
+
+DataObject *TaskDependencyAnalyzer::mergeObjects(DataObject *first, DataObject *second) {
+	first = first->getRepresentative();
+	second = second->getRepresentative();
+	if (first == second) return first;
+	first->producers->AppendAll(second->producers);
+	first->readers->AppendAll(second->readers);
+	second->mergedInto = first;
+	return first;
+}
+
+void TaskDependencyAnalyzer::readObject(DataObject *object, InvocationNode *reader) {
+	object = object->getRepresentative();
+	for (int i = 0; i < object->producers->NumElements(); i++) {
+		reader->addPredecessor(object->producers->Nth(i));
+	}
+	object->readers->Append(reader);
+}
+
+void TaskDependencyAnalyzer::writeObject(DataObject *object, InvocationNode *writer) {
+	object = object->getRepresentative();
+	for (int i = 0; i < object->producers->NumElements(); i++) {
+		writer->addPredecessor(object->producers->Nth(i));
+	}
+	for (int i = 0; i < object->readers->NumElements(); i++) {
+		writer->addPredecessor(object->readers->Nth(i));
+	}
+	object->producers->clear();
+	object->producers->Append(writer);
+	object->readers->clear();
+}
+
+const char *TaskDependencyAnalyzer::getLocationKey(Expr *expr) {
+	FieldAccess *field = dynamic_cast<FieldAccess*>(expr);
+	if (field == NULL) return NULL;
+	const char *fieldName = field->getField()->getName();
+	if (field->isTerminalField()) return fieldName;
+	FieldAccess *base = dynamic_cast<FieldAccess*>(field->getBase());
+	if (base == NULL || !base->isTerminalField()) return NULL;
+	std::ostringstream location;
+	location << base->getField()->getName() << "." << fieldName;
+	return strdup(location.str().c_str());
+}
+
+List<const char*> *TaskDependencyAnalyzer::getReadLocations(Expr *expr) {
+
+	List<Expr*> *fieldAccesses = new List<Expr*>;
+	expr->retrieveExprByType(fieldAccesses, FIELD_ACC);
+
+	// a field access that is the base of another field access is a part of the location of the latter
+	List<Expr*> *bases = new List<Expr*>;
+	for (int i = 0; i < fieldAccesses->NumElements(); i++) {
+		FieldAccess *field = (FieldAccess*) fieldAccesses->Nth(i);
+		if (!field->isTerminalField()) bases->Append(field->getBase());
+	}
+
+	List<const char*> *locations = new List<const char*>;
+	for (int i = 0; i < fieldAccesses->NumElements(); i++) {
+		Expr *field = fieldAccesses->Nth(i);
+		bool isBase = false;
+		for (int j = 0; j < bases->NumElements(); j++) {
+			if (bases->Nth(j) == field) {
+				isBase = true;
+				break;
+			}
+		}
+		if (isBase) continue;
+		const char *location = getLocationKey(field);
+		if (location != NULL && !string_utils::contains(locations, location)) {
+			locations->Append(location);
+		}
+	}
+	delete bases;
+	delete fieldAccesses;
+	return locations;
+}
+
+bool TaskDependencyAnalyzer::containsTaskInvocation(Stmt *stmt) {
+	List<Expr*> *invocations = new List<Expr*>;
+	stmt->retrieveExprByType(invocations, TASK_INVOKE);
+	bool found = invocations->NumElements() > 0;
+	delete invocations;
+	return found;
+}
+
+bool TaskDependencyAnalyzer::isConcurrencyEnabled() {
+	Properties *deploymentProps = PropertyReader::propertiesGroups->Lookup("deployment");
+	if (deploymentProps == NULL) return true;
+	const char *concurrencySetting = deploymentProps->getProperty("task.concurrency.enabled");
+	return (concurrencySetting == NULL || strcmp(concurrencySetting, "true") == 0);
+}
@@ -0,0 +1,125 @@
+#ifndef _H_task_dependency
+#define _H_task_dependency
+
+/* This header file holds the classes needed to build a dependency graph among the task invocations of the coordinator
+   program. Task invocations in the generated main function are executed one after another. Yet some invocations only
+   read data other invocations also read and could run concurrently with them. To identify such invocations, we follow
+   the flow of the environmental data structures from one invocation to the next using the task environment statistics
+   the frontend compiler gathers and the environmental assignments done in the coordinator program.
+
+   The analysis is done on straight-line sequences of coordinator statements. A loop or conditional block containing
+   task invocations acts as a barrier: all invocations before it are considered complete at the barrier and all
+   invocations inside it or after it start afresh. Environmental assignments are followed through the barriers, however,
+   as they decide which task environment items refer to the same data.
+
+   The generated main function launches a run of consecutive invocations of a straight-line sequence concurrently when
+   none of them depends on an earlier one of the run, they invoke different tasks on different environments, and none
+   of the tasks has been marked for exclusive launch. Setting the deployment property 'task.concurrency.enabled' to
+   anything other than 'true' keeps all invocations sequential.
+*/
+
+#include "../../../../frontend/src/syntax/ast_expr.h"
+#include "../../../../frontend/src/syntax/ast_stmt.h"
+#include "../../../../frontend/src/syntax/ast_task.h"
+#include "../../../../frontend/src/syntax/ast_library_fn.h"
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/hashtable.h"
+
+#include <iostream>
+#include <sstream>
+
+/* A node in the dependency graph representing a single task invocation */
+class InvocationNode {
+  public:
+	// invocations are numbered in the order they appear in the coordinator program starting from 1
+	int index;
+	TaskInvocation *invocation;
+	const char *envName;
+	// the invocations of the same straight-line sequence the current one directly depends on
+	List<InvocationNode*> *predecessors;
+	// the earlier invocations of the same straight-line sequence the current one does not depend on either directly
+	// or indirectly; these invocations could run concurrently with the current one
+	List<InvocationNode*> *independents;
+
+	InvocationNode(int index, TaskInvocation *invocation, const char *envName);
+	void addPredecessor(InvocationNode *node);
+	bool dependsOn(InvocationNode *node);
+	void describe(std::ostream &stream, int indentLevel);
+};
+
+/* Each environmental data structure or coordinator variable refers to a data object. Environmental array assignments
+   make two different task environment items refer to the same data object. Each object tracks the invocations that
+   produced its current content and the invocations that have read that content. When different objects may get
+   aliased depending on the control flow, they are merged into one.
+*/
+class DataObject {
+  public:
+	List<InvocationNode*> *producers;
+	List<InvocationNode*> *readers;
+	// forwarding reference set when the object has been merged into another object
+	DataObject *mergedInto;
+
+	DataObject();
+	DataObject *getRepresentative();
+	void clearAccesses();
+};
+
+class TaskDependencyAnalyzer {
+  protected:
+	List<InvocationNode*> *nodes;
+	// invocations of the straight-line sequence under analysis
+	List<InvocationNode*> *sequenceNodes;
+	// data objects for environment items and coordinator variables; the keys are in the 'env.item' or 'variable' form
+	Hashtable<DataObject*> *locationMap;
+	// the hashtable does not enumerate its keys; so the keys are also kept in a list
+	List<const char*> *locationKeys;
+	// the length of the longest run of invocations launched concurrently in the generated code
+	int maxConcurrency;
+
+	// names of the tasks that must not run along with any other task
+	static List<const char*> *exclusiveTasks;
+  public:
+	// a static reference to the analysis of the coordinator program to be consulted during code generation
+	static TaskDependencyAnalyzer *coordinatorAnalysis;
+	// marks a task whose invocations should never be launched concurrently with other invocations
+	static void requireExclusiveLaunch(const char *taskName);
+
+	TaskDependencyAnalyzer();
+	void analyzeProgram(Stmt *coordinatorCode);
+	InvocationNode *getNode(TaskInvocation *invocation);
+	List<InvocationNode*> *getNodes() { return nodes; }
+	void describe(std::ostream &stream);
+
+	// generates a comment listing the dependencies of an invocation to be put before its code
+	void generateDependencyComment(std::ostringstream &stream, TaskInvocation *invocation, int indentLevel);
+	// returns the run of invocations to be launched concurrently that starts at the given index of a statement list,
+	// if there is one with at least two invocations; otherwise returns NULL
+	List<TaskInvocation*> *getConcurrentRun(List<Stmt*> *stmts, int startIndex);
+	int getMaxConcurrency() { return maxConcurrency; }
+  private:
+	void analyzeStmt(Stmt *stmt);
+	void processInvocation(TaskInvocation *invocation);
+	DataObject *processAssignment(AssignmentExpr *assignment);
+	void processBinding(LibraryFunction *bindFn);
+	void processConditionalAssignments(Stmt *stmt);
+	void startNewSequence();
+	// a snapshot holds the current object of each location in the order of the location keys list
+	List<DataObject*> *takeSnapshot();
+	void mergeWithSnapshot(List<DataObject*> *snapshot);
+
+	DataObject *getObject(const char *location);
+	void setObject(const char *location, DataObject *object);
+	DataObject *mergeObjects(DataObject *first, DataObject *second);
+	void readObject(DataObject *object, InvocationNode *reader);
+	void writeObject(DataObject *object, InvocationNode *writer);
+
+	// returns the location key for an expression if the expression refers to a whole environment item or coordinator
+	// variable; otherwise returns NULL
+	static const char *getLocationKey(Expr *expr);
+	// lists the location keys of all environment items and coordinator variables an expression reads
+	static List<const char*> *getReadLocations(Expr *expr);
+	static bool containsTaskInvocation(Stmt *stmt);
+	static bool isConcurrencyEnabled();
+};
+
+#endif
@@ -15,6 +15,7 @@
 #include "environment_mgmt.h"
 #include "code_constant.h"
 #include "task_global.h"
+#include "task_dependency.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/hashtable.h"
@@ -29,6 +30,7 @@
 #include "../../../../frontend/src/syntax/ast_type.h"
 #include "../../../../frontend/src/semantics/task_space.h"
 #include "../../../../frontend/src/static-analysis/sync_stat.h"
+#include "../../../../frontend/src/static-analysis/reduction_info.h"
 #include "../../../../frontend/src/codegen-helper/extern_config.h"
 #include "../../../../frontend/src/codegen-helper/communication_stat.h"
 
@@ -68,6 +70,7 @@ TaskGenerator::TaskGenerator(TaskDef *taskDef,
 	mappingRoot = NULL;
 	segmentedPPS = 0;
 	involveReduction = false;
+	soaLayoutArrays = new List<const char*>;
 }
 
 const char *TaskGenerator::getHeaderFileName(TaskDef *taskDef) {
@@ -115,6 +118,12 @@ void TaskGenerator::generate(List<PPS_Definition*> *pcubesConfig) {
 
 	// do back-end architecture dependent static analyses of the task
 	lpsHierarchy->performAllocationAnalysis(segmentedPPS);
+	soaLayoutArrays = getSoaLayoutArrays(taskDef, segmentedPPS);
+	// switching to SoA layouts rearranges data parts shared with other tasks in place; so the task cannot run along
+	// with other task invocations
+	if (soaLayoutArrays->NumElements() > 0) {
+		TaskDependencyAnalyzer::requireExclusiveLaunch(taskDef->getName());
+	}
 
 	// generate a constant array for processor ordering in the hardware
 	generateProcessorOrderArray(headerFile, processorFile);
@@ -132,6 +141,14 @@ void TaskGenerator::generate(List<PPS_Definition*> *pcubesConfig) {
 	List<ReductionMetadata*> *reductionInfos = new List<ReductionMetadata*>;
 	taskDef->getComputation()->extractAllReductionInfo(reductionInfos);
 	this->involveReduction = (reductionInfos->NumElements() > 0); 
+	this->involveScan = false;
+	for (int i = 0; i < reductionInfos->NumElements(); i++) {
+		if (reductionInfos->Nth(i)->isScan()) involveScan = true;
+	}
+	List<StageInstanciation*> *scatteringStages = new List<StageInstanciation*>;
+	collectScatteringStages(taskDef->getComputation(), scatteringStages);
+	this->involveScatter = (scatteringStages->NumElements() > 0);
+	delete scatteringStages;
         generateLpuDataStructures(headerFile, mappingConfig, reductionInfos);
 	generatePrintFnForLpuDataStructures(initials, 
 			programFile, mappingConfig, reductionInfos);
@@ -175,6 +192,7 @@ void TaskGenerator::generate(List<PPS_Definition*> *pcubesConfig) {
 	List<CommunicationCharacteristics*> *commCharacterList 
 			= generateFnsForConfinementConstrConfigs(headerFile, 
 					programFile, taskDef, pcubesConfig);
+	commCharacterList = batchScalarCommunications(taskDef, commCharacterList);
 	int communicatorCount = commCharacterList->NumElements();
 	generateAllDataExchangeFns(headerFile, programFile, taskDef, commCharacterList);
 	if (communicatorCount > 0) {
@@ -198,6 +216,11 @@ void TaskGenerator::generate(List<PPS_Definition*> *pcubesConfig) {
 				programFile, initials, reductionInfos);
 	}
 
+	// generate the scatter primitives holders and their initialization function
+	if (involveScatter) {
+		generateScatterPrimitives(headerFile, programFile, taskDef);
+	}
+
 	// generate environment management data structures and functions
 	generateTaskEnvironmentClass(taskDef, initials, headerFile, programFile);
 	generateFnToInitEnvLinksFromEnvironment(taskDef, initials, headerFile, programFile);
@@ -215,7 +238,9 @@ void TaskGenerator::generate(List<PPS_Definition*> *pcubesConfig) {
 	generateInitializeFunction(headerFile, programFile, initials, 
         		envLinkList, taskDef, mappingConfig->mappingConfig->LPS);
 
-	// generate functions for all compute stages in the source code
+	// generate functions for all compute stages in the source code; the threads run them while the arrays opted-in
+	// for the structure-of-arrays layout have that layout
+	ntransform::NameTransformer::transformer->setSoaLayoutArrays(soaLayoutArrays);
 	generateFnsForComputation(taskDef, headerFile, programFile, initials);
 
 	// generate run function for threads
@@ -223,6 +248,7 @@ void TaskGenerator::generate(List<PPS_Definition*> *pcubesConfig) {
 			programFile, initials, mappingConfig, 
 			syncManager->involvesSynchronization(), 
 			involveReduction, communicatorCount);
+	ntransform::NameTransformer::transformer->resetSoaLayoutArrays();
 
 	// generate data structure and functions for Pthreads
 	generateArgStructForPthreadRunFn(taskDef->getName(), headerFile);
@@ -475,10 +501,12 @@ void TaskGenerator::initiateThreadStates(std::ofstream &stream) {
 	// declare an array of task-locals so that each thread can have its own copy for this for independent 
 	// updates
 	stream << indent << "ThreadLocals *threadLocalsList[Total_Threads]" << stmtSeparator;
-	// generate a loop copying the initialized task-local variable into entries of the array
+	// generate a loop copying the initialized task-local variable into entries of the array; all threads generate
+	// random numbers from streams derived from the seed of the task invocation
 	stream << indent << "for (int i = 0; i < Total_Threads; i++) {\n";
-	stream << indent << indent << "threadLocalsList[i] = new ThreadLocals" << stmtSeparator;
+	stream << indent << indent << "threadLocalsList[i] = InvocationArena::track(new ThreadLocals)" << stmtSeparator;
 	stream << indent << indent << "*threadLocalsList[i] = threadLocals" << stmtSeparator;
+	stream << indent << indent << "threadLocalsList[i]->randomStreams.setTaskSeed(taskRandomSeed)" << stmtSeparator;
 	stream << indent << "}\n";
 
 	// iterate over the mapping configuration and create an array of LPS dimensionality information
@@ -499,7 +527,9 @@ void TaskGenerator::initiateThreadStates(std::ofstream &stream) {
 	// create an array of thread IDs and initiate them
 	stream << indent << "ThreadIds *threadIdsList[Total_Threads]" << stmtSeparator;
 	stream << indent << "for (int i = 0; i < Total_Threads; i++) {\n";
-	stream << indent << indent << "threadIdsList[i] = getPpuIdsForThread(i)" << stmtSeparator;
+	stream << indent << indent << "threadIdsList[i] = InvocationArena::track(getPpuIdsForThread(i))" << stmtSeparator;
+	stream << indent << indent << "InvocationArena::trackArray(threadIdsList[i]->ppuIds" << paramSeparator;
+	stream << "Space_Count)" << stmtSeparator;
 	stream << indent << indent << "adjustPpuCountsAndGroupSizes(threadIdsList[i])" << stmtSeparator;
 	stream << indent << "}\n";
 
@@ -512,9 +542,9 @@ void TaskGenerator::initiateThreadStates(std::ofstream &stream) {
 	// finally create an array of Thread-State variables and initiate them	
 	stream << indent << "ThreadStateImpl *threadStateList[Total_Threads]" << stmtSeparator;
 	stream << indent << "for (int i = 0; i < Total_Threads; i++) {\n";
-	stream << indent << indent << "threadStateList[i] = new ThreadStateImpl(Space_Count, ";
+	stream << indent << indent << "threadStateList[i] = InvocationArena::track(new ThreadStateImpl(Space_Count, ";
 	stream << std::endl << indent << indent << indent << indent;
-	stream << "lpsDimensions, partitionArgs, threadIdsList[i])" << stmtSeparator;
+	stream << "lpsDimensions, partitionArgs, threadIdsList[i]))" << stmtSeparator;
 	stream << indent << indent << "threadStateList[i]->initializeLPUs()" << stmtSeparator;
 	stream << indent << indent << "threadStateList[i]->setLpsParentIndexMap()" << stmtSeparator;
 	stream << indent << indent << "threadStateList[i]->setPartConfigMap(configMap)" << stmtSeparator;	
@@ -528,13 +558,14 @@ void TaskGenerator::performSegmentGrouping(std::ofstream &stream, bool segmentId
 	stream << std::endl << indent << "// grouping threads into segments\n";	
 	
 	// declare a list of segments to hold the threads
-	stream << indent << "List<SegmentState*> *segmentList = new List<SegmentState*>" << stmtSeparator;
+	stream << indent << "List<SegmentState*> *segmentList = ";
+	stream << "InvocationArena::track(new List<SegmentState*>)" << stmtSeparator;
 
 	// add threads in proper segments
 	stream << indent << "int segmentCount = Total_Threads / Threads_Per_Segment" << stmtSeparator;
 	stream << indent << "int threadIndex = 0" << stmtSeparator;
 	stream << indent << "for (int s = 0; s < segmentCount; s++) {\n";
-	stream << doubleIndent << "SegmentState *segment = new SegmentState(s, s)" << stmtSeparator;
+	stream << doubleIndent << "SegmentState *segment = InvocationArena::track(new SegmentState(s, s))" << stmtSeparator;
 	stream << doubleIndent << "int participantCount = 0" << stmtSeparator;
 	stream << doubleIndent << "while (participantCount < Threads_Per_Segment) {\n";
 	stream << tripleIndent << "segment->addParticipant(threadStateList[threadIndex])" << stmtSeparator;
@@ -595,6 +626,19 @@ bool TaskGenerator::hasCommunicators() {
 	return syncVars != NULL && syncVars->NumElements() > 0;
 }
 
+bool TaskGenerator::generateDistributionMap(std::ofstream &stream) {
+
+	if (!hasCommunicators() && !involveScatter) return false;
+
+	// generate a distribution map for data shared among multiple segments
+	stream << std::endl << indent << "// generating part distribution trees\n";
+	stream << indent << "PartDistributionMap *distributionMap = InvocationArena::track(generateDistributionMap(";
+	stream << "segmentList" << paramSeparator;
+	stream << '\n' << indent << doubleIndent;
+	stream << "mySegment->getPhysicalId()" << paramSeparator << "configMap))" << stmtSeparator;
+	return true;
+}
+
 bool TaskGenerator::generateCommunicators(std::ofstream &stream) {	
 
 	// first check if communicator setup is needed for this task, if NO then return false
@@ -607,13 +651,10 @@ bool TaskGenerator::generateCommunicators(std::ofstream &stream) {
 	stream << std::endl << indent << "// initializing communicators map\n";	
 
 	// create a communication statistics object to record time spent on different aspects of communication
-	stream << indent << "CommStatistics *commStat = new CommStatistics()" << stmtSeparator;
-	
-	// first generate a distribution map for data shared among multiple segments
-	stream << indent << "PartDistributionMap *distributionMap = generateDistributionMap(";
-	stream << "segmentList" << paramSeparator << "configMap)" << stmtSeparator;
+	stream << indent << "CommStatistics *commStat = InvocationArena::track(new CommStatistics())" << stmtSeparator;
 
-	// then use that map to create communicators for shared arrays; the same function creates communicator for scalars
+	// use the distribution map to create communicators for shared arrays; the same function creates communicator for
+	// scalars; the communicators and their map are released with the invocation arena
 	stream << indent << "Hashtable<Communicator*> *communicatorMap = generateCommunicators(";
 	stream << "mySegment" << paramSeparator;
 	stream << '\n' << indent << doubleIndent;
@@ -633,6 +674,13 @@ bool TaskGenerator::generateCommunicators(std::ofstream &stream) {
 	return true;
 }
 
+void TaskGenerator::setupScatterPrimitives(std::ofstream &stream) {
+	if (!involveScatter) return;
+	stream << std::endl << indent << "// creating the scatter primitives of the invocation\n";
+	stream << indent << "setupScatterPrimitives(participantGroup" << paramSeparator;
+	stream << "distributionMap" << paramSeparator << "configMap)" << stmtSeparator;
+}
+
 void TaskGenerator::startThreads(std::ofstream &stream) {
 	
 	std::cout << "\tGenerating code for starting threads\n";
@@ -649,13 +697,14 @@ void TaskGenerator::startThreads(std::ofstream &stream) {
 	
 	// initialize the argument list first
 	stream << indent << "for (int i = 0; i < Total_Threads; i++) {\n";
-	stream << indent << indent << "threadArgs[i] = new PThreadArg" << stmtSeparator;
+	stream << indent << indent << "threadArgs[i] = InvocationArena::track(new PThreadArg)" << stmtSeparator;
 	stream << indent << indent << "threadArgs[i]->taskName = \"" << taskDef->getName() << "\"" << stmtSeparator;
 	stream << indent << indent << "threadArgs[i]->metadata = metadata" << stmtSeparator;
 	stream << indent << indent << "threadArgs[i]->taskGlobals = &taskGlobals" << stmtSeparator;
 	stream << indent << indent << "threadArgs[i]->threadLocals = threadLocalsList[i]" << stmtSeparator;
 	stream << indent << indent << "threadArgs[i]->partition = partition" << stmtSeparator;
 	stream << indent << indent << "threadArgs[i]->threadState = threadStateList[i]" << stmtSeparator;
+	stream << indent << indent << "threadArgs[i]->executionContext = ExecutionContext::getCurrent()" << stmtSeparator;
 	stream << indent << "}\n";
 	
 	// declare attributes that will be needed to set the thread affinity masks properly
@@ -666,8 +715,10 @@ void TaskGenerator::startThreads(std::ofstream &stream) {
 	// then create the threads one by one
 	stream << indent << "int state" << stmtSeparator;
 	stream << indent << "for (int i = participantStart; i <= participantEnd; i++) {\n";
-	// determine the cpu-id for the thread
-	stream << indent << indent << "int cpuId = (i * Core_Jump / Threads_Per_Core) % Processors_Per_Phy_Unit";
+	// determine the cpu-id for the thread; the processor offset of a concurrently launched invocation keeps its
+	// threads off the processors of the other invocations running with it
+	stream << indent << indent << "int cpuId = (i * Core_Jump / Threads_Per_Core";
+	stream << " + ExecutionContext::getProcessorOffset()) % Processors_Per_Phy_Unit";
 	stream << stmtSeparator;
 	stream << indent << indent << "int physicalId = Processor_Order[cpuId]" << stmtSeparator;
 
@@ -713,6 +764,17 @@ void TaskGenerator::startThreads(std::ofstream &stream) {
 	stream << indent << "}\n\n";
 }
 
+void TaskGenerator::switchToSoaLayouts(std::ofstream &stream) {
+	if (soaLayoutArrays->NumElements() > 0) {
+		std::cout << "\tGenerating code for switching arrays to the structure-of-arrays layout\n";
+	}
+	genSoaLayoutSwitchCode(stream, taskDef, soaLayoutArrays, true);
+}
+
+void TaskGenerator::switchToAosLayouts(std::ofstream &stream) {
+	genSoaLayoutSwitchCode(stream, taskDef, soaLayoutArrays, false);
+}
+
 void TaskGenerator::writeResults(std::ofstream &stream) {
 
         PartitionHierarchy *lpsHierarchy = taskDef->getPartitionHierarchy();
@@ -32,6 +32,10 @@ class TaskGenerator {
 	SyncManager *syncManager;
 	int segmentedPPS;
 	bool involveReduction;
+	bool involveScan;
+	bool involveScatter;
+	// names of the arrays of user defined classes that use the structure-of-arrays layout in computation
+	List<const char*> *soaLayoutArrays;
   public:
 	TaskGenerator(TaskDef *taskDef, 
 		const char *outputDirectory, 
@@ -48,6 +52,10 @@ class TaskGenerator {
 	SyncManager *getSyncManager() { return syncManager; }
 	bool hasCommunicators();
 	bool hasReductions() { return involveReduction; }
+	bool hasScatters() { return involveScatter; }
+	// scans and scatters need a communicator over only the segments participating in the task; so the task's execute
+	// function creates a group of these segments for them
+	bool needsParticipantGroup() { return involveScan || involveScatter; }
 
 	// function to generate all data structures and methods that are relevant to this task 
 	// including a thread run function to run the task as a parallel program in multiple threads
@@ -80,12 +88,21 @@ class TaskGenerator {
 	// a supporting function to initialize all data parts of different structures that will be 
 	// needed in computations carried by the threads of the segment managed by the current process 
 	void initializeSegmentMemory(std::ofstream &stream);
+	// a supporting function to create the map of part distribution trees of the arrays that need communication
+	// or are targets of scatters; it returns false if there is no such array
+	bool generateDistributionMap(std::ofstream &stream);
 	// a supporting function to create a map of data communicators that will be used to resolve
 	// data dependencies within the task that requires communications between segments
 	bool generateCommunicators(std::ofstream &stream);
+	// a supporting function to create the scatter primitives of the invocation
+	void setupScatterPrimitives(std::ofstream &stream);
 	// a supporting function that starts threads once initialization is done for all necessary 
 	// data	structures
 	void startThreads(std::ofstream &stream);
+	// supporting functions that switch the arrays of classes opted-in for the structure-of-arrays layout to
+	// that layout before the threads start and back to the default layout after they finish
+	void switchToSoaLayouts(std::ofstream &stream);
+	void switchToAosLayouts(std::ofstream &stream);
 	// a supporting function that generates prompts and codes for writing results of computations
 	// to external files 
 	void writeResults(std::ofstream &stream); 		
@@ -4,6 +4,8 @@
 #include "sync_mgmt.h"
 #include "code_constant.h"
 #include "name_transformer.h"
+#include "memory_mgmt.h"
+#include "task_dependency.h"
 
 #include "../../../../frontend/src/syntax/ast_def.h"
 #include "../../../../frontend/src/syntax/ast_type.h"
@@ -15,12 +17,14 @@
 #include "../../../../common-libs/utils/string_utils.h"
 #include "../../../../common-libs/utils/common_utils.h"
 #include "../../../../common-libs/utils/decorator_utils.h"
+#include "../../../../common-libs/utils/properties.h"
 #include "../../../../common-libs/domain-obj/constant.h"
 
 #include <sstream>
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 
 void initiateProgramHeaders(const char *headerFileName, const char *programFileName, ProgramDef *programDef) {
 
@@ -290,6 +294,14 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	// open function definition
 	programFile << " {\n\n";
 
+	// an invocation launched along with other independent invocations prepares its environment in its turn
+	programFile << indent << "// waiting for the turn to prepare the task environment\n";
+	programFile << indent << "ExecutionContext::beginSerialPhase()" << stmtSeparator << std::endl;
+
+	// every segment, participating or not, advances the sequence of task seeds so that all segments agree on the 
+	// seed of each invocation
+	programFile << indent << "uint64_t taskRandomSeed = rng::getNextTaskSeed()" << stmtSeparator;
+
 	// set up the log file handle to the task environment reference
 	programFile << indent << "environment->setLogFile(&logFile)" << stmtSeparator;
 
@@ -298,18 +310,59 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	programFile << indent << "if (segmentId >= Max_Segments_Count) {\n";
 	programFile << doubleIndent << "logFile << \"Current segment does not participate in: ";
 	programFile << taskGenerator->getTaskName() << "\\n\"" << stmtSeparator;
+	if (taskGenerator->needsParticipantGroup()) {
+		programFile << doubleIndent << "SegmentGroup::excludeSegmentFromGroupSetup(";
+		programFile << "segmentId" << paramSeparator << "logFile)" << stmtSeparator;
+	}
 	if (taskGenerator->hasCommunicators()) {
 		programFile << doubleIndent << "excludeFromAllCommunication(";
 		programFile << "segmentId" << paramSeparator << "logFile)" << stmtSeparator;
 	}	
+	programFile << doubleIndent << "ExecutionContext::endSerialPhase()" << stmtSeparator;
 	programFile << doubleIndent << "return" << stmtSeparator;
 	programFile << indent << "}\n\n";
 
+	// start an invocation arena to collect the runtime objects that are needed only during this invocation 
+	programFile << indent << "// starting the memory arena of the invocation\n";
+	programFile << indent << "InvocationArena::beginInvocation()" << stmtSeparator;
+	programFile << "\n";
+
+	// form the group of participating segments first as the non-participating segments exclude themselves from it 
+	// before anything else
+	if (taskGenerator->needsParticipantGroup()) {
+		programFile << indent << "// forming the group of segments participating in the task\n";
+		programFile << indent << "SegmentGroup *participantGroup = InvocationArena::track(new SegmentGroup())";
+		programFile << stmtSeparator;
+		programFile << indent << "participantGroup->discoverGroupAndSetupCommunicator(logFile)" << stmtSeparator;
+		programFile << "\n";
+	}
+
+	// load the weights of any weighted-block partition before the partition configurations are generated
+	List<const char*> *weightArrays = new List<const char*>;
+	List<const char*> *prefixSumArrays = new List<const char*>;
+	getPartitionWeightArrays(taskDef->getPartitionHierarchy(), weightArrays, prefixSumArrays);
+	if (weightArrays->NumElements() > 0 || prefixSumArrays->NumElements() > 0) {
+		programFile << indent << "// loading weights for weighted-block partitions\n";
+		for (int i = 0; i < weightArrays->NumElements(); i++) {
+			programFile << indent << "PartitionWeights::loadForInvocation(environment->getEnvId()";
+			programFile << paramSeparator << "\"" << weightArrays->Nth(i) << "\"";
+			programFile << paramSeparator << "false" << paramSeparator << "logFile)" << stmtSeparator;
+		}
+		for (int i = 0; i < prefixSumArrays->NumElements(); i++) {
+			programFile << indent << "PartitionWeights::loadForInvocation(environment->getEnvId()";
+			programFile << paramSeparator << "\"" << prefixSumArrays->Nth(i) << "\"";
+			programFile << paramSeparator << "true" << paramSeparator << "logFile)" << stmtSeparator;
+		}
+		programFile << "\n";
+	}
+	delete weightArrays;
+	delete prefixSumArrays;
+
 	// determine the active segment count and update the static variable keeping track of the total number 
 	// of threads to be used for the task's execution
 	programFile << indent << "// setting the total-number-of-threads static variable\n";
 	programFile << indent << "int mpiProcessCount" << stmtSeparator;
-	programFile << indent << "MPI_Comm_size(MPI_COMM_WORLD" << paramSeparator;
+	programFile << indent << "MPI_Comm_size(ExecutionContext::getCommunicator()" << paramSeparator;
 	programFile << "&mpiProcessCount)" << stmtSeparator;
 	programFile << indent << "int activeSegments = min(mpiProcessCount" << paramSeparator;
 	programFile << "Max_Segments_Count)" << stmtSeparator;
@@ -325,7 +378,7 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	programFile << indent << "// declaring other task related common variables\n";
         programFile << indent << "TaskGlobals taskGlobals" << stmtSeparator;
         programFile << indent << "ThreadLocals threadLocals" << stmtSeparator;
-        programFile << indent << "ArrayMetadata *metadata = new ArrayMetadata" << stmtSeparator;
+        programFile << indent << "ArrayMetadata *metadata = InvocationArena::track(new ArrayMetadata)" << stmtSeparator;
 
 	// create a start timer to record running time of different parts of the task
 	programFile << std::endl;
@@ -346,7 +399,9 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	// check if the task has some reduction operations; if YES then initialize reduction primitives
 	if (taskGenerator->hasReductions()) {
                 programFile << std::endl << indent << "// initializing reduction primitives\n";
-                programFile << indent << "setupReductionPrimitives(logFile)" << stmtSeparator;
+                programFile << indent << "setupReductionPrimitives(";
+		programFile << (taskGenerator->needsParticipantGroup() ? "participantGroup" : "NULL");
+		programFile << paramSeparator << "logFile)" << stmtSeparator;
 	}
 
 	// get the list of external environment-links then invoke the task initializer function
@@ -375,6 +430,7 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	// group threads into segments; then allocate and initialize the segment memory for current process
         taskGenerator->performSegmentGrouping(programFile, true);
         taskGenerator->initializeSegmentMemory(programFile);
+	taskGenerator->switchToSoaLayouts(programFile);
 
 
 	// log time spent on memory allocation
@@ -391,8 +447,11 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	programFile << indent << "logFile.flush()" << stmtSeparator;
 	
 
-	// generate list of communicators that will be used for resolving data dependencies involving communications
+	// generate list of communicators that will be used for resolving data dependencies involving communications and
+	// the scatter primitives, both of which use the part distribution trees of the arrays they deal with
+	taskGenerator->generateDistributionMap(programFile);
 	bool communicatorsGenerated = taskGenerator->generateCommunicators(programFile);
+	taskGenerator->setupScatterPrimitives(programFile);
 	if (communicatorsGenerated) {
 		/*
 		// log time spent on communicator setup
@@ -409,8 +468,12 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 		*/
 	}
 
-	// start threads and wait for them to finish execution of the task 
+	// start threads and wait for them to finish execution of the task; the computations of other invocations
+	// launched along with the current one may proceed meanwhile but their cleanups should wait for the turn
+	programFile << std::endl << indent << "ExecutionContext::endSerialPhase()" << stmtSeparator;
         taskGenerator->startThreads(programFile);
+	programFile << indent << "ExecutionContext::beginSerialPhase()" << stmtSeparator;
+	taskGenerator->switchToAosLayouts(programFile);
 
 	
 	// log time spent on task's computation
@@ -458,14 +521,84 @@ void generateTaskExecutor(TaskGenerator *taskGenerator) {
 	programFile << "&taskGlobals)" << stmtSeparator;
 	programFile << indent << "environment->executeTaskCompletionInstructions()" << stmtSeparator;
 	programFile << indent << "delete taskData" << stmtSeparator;
+	programFile << indent << "environment->setReadersMap(NULL)" << stmtSeparator;
+	programFile << indent << "InvocationArena::endInvocation(logFile)" << stmtSeparator;
+	programFile << indent << "ExecutionContext::endSerialPhase()" << stmtSeparator;
 	
 	// close function definition
 	programFile << "}\n\n";
+
+	generateLaunchSupport(taskGenerator, headerFile, programFile);
 	
 	headerFile.close();
 	programFile.close();
 }
 
+void generateLaunchSupport(TaskGenerator *taskGenerator, std::ofstream &headerFile, std::ofstream &programFile) {
+
+	TaskDef *taskDef = taskGenerator->getTaskDef();
+	const char *initials = taskGenerator->getInitials();
+	const char *message = "support for concurrent launches";
+	decorator::writeSectionHeader(headerFile, message);
+	headerFile << std::endl;
+	decorator::writeSectionHeader(programFile, message);
+	programFile << std::endl;
+
+	// a launch group runs the execute function in a separate thread; so its arguments are packed in an object
+	headerFile << "class ExecuteArgs {\n";
+	headerFile << "  public:\n";
+	headerFile << indent << "TaskEnvironment *environment" << stmtSeparator;
+	InitializeSection *initSection = taskDef->getInitSection();
+	if (initSection != NULL) {
+		List<const char*> *arguments = initSection->getArguments();
+		if (arguments != NULL) {
+			List<Type*> *argTypes = initSection->getArgumentTypes();
+			for (int i = 0; i < arguments->NumElements(); i++) {
+				Type *type = argTypes->Nth(i);
+				headerFile << indent << type->getCppDeclaration(arguments->Nth(i)) << stmtSeparator;
+			}
+		}
+	}
+	headerFile << indent << taskDef->getPartitionTuple()->getId()->getName() << " partition" << stmtSeparator;
+	headerFile << indent << "int segmentId" << stmtSeparator;
+	headerFile << "};\n\n";
+
+	// the runner function of the task a launch group calls in the invocation's thread
+	headerFile << "void *executeInLaunchSlot(void *argument)" << stmtSeparator;
+	programFile << "void *" << initials << "::executeInLaunchSlot(void *argument) {\n";
+	programFile << indent << "ExecuteArgs *args = (ExecuteArgs*) argument" << stmtSeparator;
+	programFile << indent << "execute(args->environment";
+	if (initSection != NULL) {
+		List<const char*> *arguments = initSection->getArguments();
+		if (arguments != NULL) {
+			for (int i = 0; i < arguments->NumElements(); i++) {
+				programFile << paramSeparator << "args->" << arguments->Nth(i);
+			}
+		}
+	}
+	programFile << paramSeparator << "args->partition" << paramSeparator << "args->segmentId";
+	programFile << paramSeparator << "*ExecutionContext::getLogFile())" << stmtSeparator;
+	programFile << indent << "delete args" << stmtSeparator;
+	programFile << indent << "return NULL" << stmtSeparator;
+	programFile << "}\n\n";
+
+	// the function telling which processors of the segment the PPU controller threads of the task will be pinned to;
+	// this should follow the thread pinning logic of the execute function
+	headerFile << "void describePlacement(int segmentId" << paramSeparator;
+	headerFile << "TaskPlacement *placement)" << stmtSeparator;
+	programFile << "void " << initials << "::describePlacement(int segmentId" << paramSeparator;
+	programFile << "TaskPlacement *placement) {\n";
+	programFile << indent << "if (segmentId >= Max_Segments_Count) return" << stmtSeparator;
+	programFile << indent << "placement->processorCount = Processors_Per_Phy_Unit" << stmtSeparator;
+	programFile << indent << "int participantStart = segmentId * Threads_Per_Segment" << stmtSeparator;
+	programFile << indent << "int participantEnd = participantStart + Threads_Per_Segment - 1" << stmtSeparator;
+	programFile << indent << "for (int i = participantStart; i <= participantEnd; i++) {\n";
+	programFile << doubleIndent << "placement->addProcessor(";
+	programFile << "(i * Core_Jump / Threads_Per_Core) % Processors_Per_Phy_Unit)" << stmtSeparator;
+	programFile << indent << "}\n";
+	programFile << "}\n\n";
+}
+
 void generateMain(ProgramDef *programDef, const char *programFile) {
 	
 	std::cout << "Generating main function for the program\n";
@@ -483,8 +616,23 @@ void generateMain(ProgramDef *programDef, const char *programFile) {
         // write the function signature
         stream << "\nint main(int argc, char *argv[]) {\n\n";
 
-	// do MPI initialization
-	stream << indent << "MPI_Init(&argc, &argv)" << stmtSeparator << std::endl;
+	// do MPI initialization; unless disabled, request MPI to support concurrent calls from multiple threads so that
+	// the PPU controller threads can divide data transfers of communicators among themselves
+	bool parallelTransferEnabled = true;
+	Properties *deploymentProps = PropertyReader::propertiesGroups->Lookup("deployment");
+	if (deploymentProps != NULL) {
+		const char *transferSetting = deploymentProps->getProperty("comm.parallel.transfer");
+		if (transferSetting != NULL && strcmp(transferSetting, "false") == 0) {
+			parallelTransferEnabled = false;
+		}
+	}
+	if (parallelTransferEnabled) {
+		stream << indent << "int mpiThreadSupport = MPI_THREAD_SINGLE" << stmtSeparator;
+		stream << indent << "MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &mpiThreadSupport)" << stmtSeparator;
+		stream << indent << "MpiThreadSupport::setProvidedLevel(mpiThreadSupport)" << stmtSeparator << std::endl;
+	} else {
+		stream << indent << "MPI_Init(&argc, &argv)" << stmtSeparator << std::endl;
+	}
 
 	// create a program environment variable to coordinate environmental exchanges among tasks
 	stream << indent << "// program environment management structure\n";
@@ -512,6 +660,39 @@ void generateMain(ProgramDef *programDef, const char *programFile) {
         stream << indent << "std::ofstream logFile" << stmtSeparator;
         stream << indent << "logFile.open(logFileName.str().c_str())" << stmtSeparator << std::endl;
 
+	// unless disabled, determine which segments run in the same node so that they can exchange data through shared 
+	// memory instead of MPI messages
+	bool shmTransportEnabled = true;
+	if (deploymentProps != NULL) {
+		const char *shmSetting = deploymentProps->getProperty("shm.transport.enabled");
+		if (shmSetting != NULL && strcmp(shmSetting, "false") == 0) {
+			shmTransportEnabled = false;
+		}
+	}
+	if (shmTransportEnabled) {
+		stream << indent << "// discovering co-located segments for node-local data exchanges\n";
+		stream << indent << "NodeTopology::discoverCoLocatedSegments(logFile)" << stmtSeparator << std::endl;
+	}
+
+	// output instructions are processed by a background I/O thread unless that has been disabled
+	if (deploymentProps != NULL) {
+		const char *asyncOutputSetting = deploymentProps->getProperty("async.output.enabled");
+		if (asyncOutputSetting != NULL && strcmp(asyncOutputSetting, "false") == 0) {
+			stream << indent << "// writing program output in place\n";
+			stream << indent << "AsyncOutputWriter::disable()" << stmtSeparator << std::endl;
+		}
+	}
+
+	// files bound as input are read whole in the background from the point of binding only if enabled, as each segment
+	// then holds the entire file in memory
+	if (deploymentProps != NULL) {
+		const char *prefetchSetting = deploymentProps->getProperty("input.prefetch.enabled");
+		if (prefetchSetting != NULL && strcmp(prefetchSetting, "true") == 0) {
+			stream << indent << "// prefetching program input in the background\n";
+			stream << indent << "InputPrefetcher::enable()" << stmtSeparator << std::endl;
+		}
+	}
+
 	// read all command line arguments as key, value pairs
 	const char *argName = coordDef->getArgumentName();
 	stream << indent << "// reading command line inputs\n";
@@ -531,8 +712,21 @@ void generateMain(ProgramDef *programDef, const char *programFile) {
 	// translate the code found inside the coordinator function
 	std::ostringstream codeStream;
 	coordDef->generateCode(codeStream, programDef->getScope());
+
+	// if the coordinator program launches some independent task invocations concurrently then prepare the resources
+	// those invocations need for running together
+	int maxConcurrency = TaskDependencyAnalyzer::coordinatorAnalysis->getMaxConcurrency();
+	if (maxConcurrency > 1) {
+		stream << indent << "// preparing for concurrent launches of independent task invocations\n";
+		stream << indent << "TaskLaunchGroup::initialize(" << maxConcurrency << paramSeparator;
+		stream << "logFile)" << stmtSeparator << std::endl;
+	}
 	stream << codeStream.str() << std::endl;
 
+	// wait for any output still being written in the background before the program ends
+	stream << indent << "// waiting for pending output jobs to finish\n";
+	stream << indent << "AsyncOutputWriter::finishAll()" << stmtSeparator << std::endl;
+
 	// calculate running time
         stream << indent << "// calculating task running time\n";
         stream << indent << "struct timeval end" << stmtSeparator;
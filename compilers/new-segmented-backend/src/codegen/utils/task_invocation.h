@@ -38,6 +38,12 @@ void generateRoutineToReadProgramArgs(TupleDef *programArg,
 // processing of tasks.
 void generateTaskExecutor(TaskGenerator *taskGenerator);
 
+// generate the argument class, runner and placement functions a launch group needs to run the execute function of a
+// task concurrently with those of other tasks
+void generateLaunchSupport(TaskGenerator *taskGenerator, 
+		std::ofstream &headerFile, 
+		std::ofstream &programFile);
+
 // generate a main function based on the configuration of the coordinator program in IT source code
 void generateMain(ProgramDef *programDef, const char *programFile);	
 
@@ -39,8 +39,11 @@ void generateRootLpuComputeRoutine(std::ofstream &programFile, MappingNode *mapp
 	functionBody << stmtSeparator;
 	functionBody << std::endl;
 
-	// allocate an LPU for the root
+	// allocate an LPU for the root after releasing the one set by any earlier call
 	Space *rootLps = mappingRoot->mappingConfig->LPS;
+	functionBody << indent << "if (lpsStates[Space_" << rootLps->getName() << "]->lpu != NULL) {\n";
+	functionBody << doubleIndent << "delete lpsStates[Space_" << rootLps->getName() << "]->lpu" << stmtSeparator;
+	functionBody << indent << "}\n";
 	functionBody << indent;
 	functionBody << "Space" << rootLps->getName() << "_LPU *lpu = new Space";
 	functionBody  << rootLps->getName() << "_LPU";
@@ -1,15 +1,18 @@
 #include <iostream>
 #include <sstream>
+#include <fstream>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <cstdlib>
 
 #include "codegen/utils/space_mapping.h"
 #include "codegen/utils/code_generator.h"
 #include "codegen/utils/task_invocation.h"
 #include "codegen/utils/fn_generator.h"
+#include "codegen/utils/mapping_enumeration.h"
 
 #include "../../common-libs/utils/list.h"
 #include "../../common-libs/utils/properties.h"
@@ -25,6 +28,46 @@
 int main(int argc, const char *argv[]) {
 
 	//********************************************************* Command Line Arguments Reader
+	// The compiler can be invoked in a mapping enumeration mode to list candidate LPS-to-PPS mappings for the
+	// program in a target machine instead of generating code. This mode is used by the mapping autotuner.
+	if (argc > 1 && strcmp(argv[1], "--enumerate-mappings") == 0) {
+		if (argc < 5) {
+			std::cout << "Mapping enumeration needs at least three more input arguments" << std::endl;
+			std::cout << "\t" << "1. The input IT program file" << std::endl;
+			std::cout << "\t" << "2. The PCubeS model of the machine" << std::endl;
+			std::cout << "\t" << "3. The output directory for mapping candidates" << std::endl;
+			std::cout << "\t" << "4. (optional) The maximum number of candidates" << std::endl;
+			std::cout << "\t" << "5. (optional) An LPU count hints file" << std::endl;
+			return -1;
+		}
+		const char *sourceFile = argv[2];
+		const char *pcubesFile = argv[3];
+		const char *candidatesDir = argv[4];
+		int maxCandidates = (argc > 5) ? atoi(argv[5]) : 16;
+		const char *hintsFile = (argc > 6) ? argv[6] : NULL;
+		mkdir(candidatesDir, 0700);
+		int fileDescriptor = open(sourceFile, O_RDONLY);
+		if (fileDescriptor < 0) {
+			std::cout << "Could not open the source program file" << std::endl;
+			return -1;
+		}
+		dup2(fileDescriptor, STDIN_FILENO);
+		close(fileDescriptor);
+		InitScanner();
+		InitParser();
+		yyparse();
+		if (ReportError::NumErrors() > 0) return -1;
+		ProgramDef::program->performScopeAndTypeChecking();
+		if (ReportError::NumErrors() > 0) return -1;
+		ProgramDef::program->performStaticAnalysis();
+		if (ReportError::NumErrors() > 0) return -1;
+		ProgramDef::program->prepareForCodegen();
+		List<PPS_Definition*> *pcubesConfig = parsePCubeSDescription(pcubesFile);
+		List<Definition*> *taskDefs = ProgramDef::program->getComponentsByType(TASK_DEF);
+		generateMappingCandidates(taskDefs, pcubesConfig, hintsFile, candidatesDir, maxCandidates);
+		return 0;
+	}
+
 	// read the input arguments and keep track of the appropriate files
 	const char *sourceFile, *pcubesFile, *processorFile, *mappingFile;
 	if (argc < 5) {
@@ -33,6 +76,7 @@ int main(int argc, const char *argv[]) {
 		std::cout << "\t" << "2. The PCubeS model of the machine" << std::endl;
 		std::cout << "\t" << "3. A processor description file for the machine\n";
 		std::cout << "\t" << "4. The mapping configuration file" << std::endl;
+		std::cout << "\t" << "   (pass 'auto' to let the compiler synthesize the mapping)" << std::endl;
 		return -1;
 	} else {
 		std::cout << "Compilation config---------------------------------------\n";
@@ -119,8 +163,23 @@ int main(int argc, const char *argv[]) {
 	//********************************************************************* Back End Compiler
 	// parse PCubeS description of the multicore hardware
         List<PPS_Definition*> *pcubesConfig = parsePCubeSDescription(pcubesFile);
-	// iterate over list of tasks and generate code for each of them in separate files
 	List<Definition*> *taskDefs = ProgramDef::program->getComponentsByType(TASK_DEF);
+	// if the user did not provide a mapping configuration then synthesize one using the mapping cost model and
+	// write it in the build directory so that it can be inspected and reused later
+	if (strcmp(mappingFile, "auto") == 0) {
+		std::cout << "Mapping synthesis------------------------------------------\n";
+		std::ostringstream synthesizedMappingStr;
+		synthesizedMappingStr << buildDir << buildSubDir << "/mapping.map";
+		mappingFile = strdup(synthesizedMappingStr.str().c_str());
+		std::ofstream synthesizedMapping(mappingFile);
+		synthesizedMapping.close();
+		for (int i = 0; i < taskDefs->NumElements(); i++) {
+			TaskDef *taskDef = (TaskDef*) taskDefs->Nth(i);
+			synthesizeMappingConfiguration(taskDef, pcubesConfig, mappingFile);
+		}
+		std::cout << "Synthesized mapping configuration: " << mappingFile << std::endl;
+	}
+	// iterate over list of tasks and generate code for each of them in separate files
         for (int i = 0; i < taskDefs->NumElements(); i++) {
                 TaskDef *taskDef = (TaskDef*) taskDefs->Nth(i);
                 // update the static reference to get to the task definition from anywhere 
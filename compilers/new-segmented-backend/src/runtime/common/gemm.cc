@@ -0,0 +1,195 @@
+#include "gemm.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+
+using namespace gemm;
+
+// The packing buffers of a PPU controller thread; they are allocated the first time the thread does a multiplication
+// and are large enough for the largest element type the kernel is instantiated for. The PPU controller threads are
+// created anew for each task invocation; so the buffers are released through a thread-specific key when the thread
+// exits.
+typedef struct {
+	char *rowBlock;
+	char *columnBlock;
+} PackingBuffers;
+
+static __thread PackingBuffers *packingBuffers = NULL;
+static pthread_key_t packingBuffersKey;
+static pthread_once_t packingBuffersKeyOnce = PTHREAD_ONCE_INIT;
+
+static void releasePackingBuffers(void *buffers) {
+	PackingBuffers *threadBuffers = (PackingBuffers *) buffers;
+	free(threadBuffers->rowBlock);
+	free(threadBuffers->columnBlock);
+	delete threadBuffers;
+}
+
+static void createPackingBuffersKey() {
+	if (pthread_key_create(&packingBuffersKey, releasePackingBuffers) != 0) {
+		std::cout << "could not create the key for matrix multiplication packing buffers\n";
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+static void allocatePackingBuffers() {
+	pthread_once(&packingBuffersKeyOnce, createPackingBuffersKey);
+	packingBuffers = new PackingBuffers;
+	packingBuffers->rowBlock = (char *) malloc(sizeof(double) * ROW_BLOCK_SIZE * DEPTH_BLOCK_SIZE);
+	packingBuffers->columnBlock = (char *) malloc(sizeof(double) * DEPTH_BLOCK_SIZE * COLUMN_BLOCK_SIZE);
+	if (packingBuffers->rowBlock == NULL || packingBuffers->columnBlock == NULL) {
+		std::cout << "could not allocate packing buffers for matrix multiplication\n";
+		std::exit(EXIT_FAILURE);
+	}
+	pthread_setspecific(packingBuffersKey, packingBuffers);
+}
+
+// Packs a rows x depth block of a into panels of MICRO_TILE_ROWS rows. Within a panel, the elements of a column are
+// consecutive so that the micro-kernel reads them with unit stride. Rows beyond the block are filled with zeros.
+template <class Type> static void packRowBlock(int rows, int depth, const Type *a, long int aStride, Type *packed) {
+	for (int panelStart = 0; panelStart < rows; panelStart += MICRO_TILE_ROWS) {
+		for (int p = 0; p < depth; p++) {
+			for (int r = 0; r < MICRO_TILE_ROWS; r++) {
+				int row = panelStart + r;
+				*packed++ = (row < rows) ? a[row * aStride + p] : 0;
+			}
+		}
+	}
+}
+
+// packs a depth x columns block of b into panels of MICRO_TILE_COLUMNS columns in the same fashion
+template <class Type> static void packColumnBlock(int depth, int columns,
+		const Type *b, long int bStride, Type *packed) {
+	for (int panelStart = 0; panelStart < columns; panelStart += MICRO_TILE_COLUMNS) {
+		for (int p = 0; p < depth; p++) {
+			const Type *bRow = b + p * bStride + panelStart;
+			for (int col = 0; col < MICRO_TILE_COLUMNS; col++) {
+				*packed++ = (panelStart + col < columns) ? bRow[col] : 0;
+			}
+		}
+	}
+}
+
+// updates a rows x columns tile of c, which is at most a full micro-tile, from a packed panel of a and of b
+template <class Type> static void updateMicroTile(int depth, Type alpha,
+		const Type *aPanel, const Type *bPanel,
+		Type *c, long int cStride, int rows, int columns) {
+
+	Type tile[MICRO_TILE_ROWS][MICRO_TILE_COLUMNS];
+	for (int r = 0; r < MICRO_TILE_ROWS; r++) {
+		for (int col = 0; col < MICRO_TILE_COLUMNS; col++) tile[r][col] = 0;
+	}
+	for (int p = 0; p < depth; p++) {
+		const Type *aColumn = aPanel + p * MICRO_TILE_ROWS;
+		const Type *bRow = bPanel + p * MICRO_TILE_COLUMNS;
+		for (int r = 0; r < MICRO_TILE_ROWS; r++) {
+			Type aElement = aColumn[r];
+			for (int col = 0; col < MICRO_TILE_COLUMNS; col++) {
+				tile[r][col] += aElement * bRow[col];
+			}
+		}
+	}
+	for (int r = 0; r < rows; r++) {
+		Type *cRow = c + r * cStride;
+		for (int col = 0; col < columns; col++) {
+			cRow[col] += alpha * tile[r][col];
+		}
+	}
+}
+
+template <class Type> void gemm::multiplyBlocks(int m, int n, int k, Type alpha,
+		const Type *a, long int aStride,
+		const Type *b, long int bStride,
+		Type *c, long int cStride) {
+
+	if (m <= 0 || n <= 0 || k <= 0) return;
+	if (packingBuffers == NULL) allocatePackingBuffers();
+	Type *packedA = (Type *) packingBuffers->rowBlock;
+	Type *packedB = (Type *) packingBuffers->columnBlock;
+
+	for (int jc = 0; jc < n; jc += COLUMN_BLOCK_SIZE) {
+		int columns = (n - jc < COLUMN_BLOCK_SIZE) ? n - jc : COLUMN_BLOCK_SIZE;
+		for (int pc = 0; pc < k; pc += DEPTH_BLOCK_SIZE) {
+			int depth = (k - pc < DEPTH_BLOCK_SIZE) ? k - pc : DEPTH_BLOCK_SIZE;
+			packColumnBlock(depth, columns, b + pc * bStride + jc, bStride, packedB);
+			for (int ic = 0; ic < m; ic += ROW_BLOCK_SIZE) {
+				int rows = (m - ic < ROW_BLOCK_SIZE) ? m - ic : ROW_BLOCK_SIZE;
+				packRowBlock(rows, depth, a + ic * aStride + pc, aStride, packedA);
+				for (int jr = 0; jr < columns; jr += MICRO_TILE_COLUMNS) {
+					int tileColumns = (columns - jr < MICRO_TILE_COLUMNS)
+							? columns - jr : MICRO_TILE_COLUMNS;
+					const Type *bPanel = packedB + jr * depth;
+					for (int ir = 0; ir < rows; ir += MICRO_TILE_ROWS) {
+						int tileRows = (rows - ir < MICRO_TILE_ROWS)
+								? rows - ir : MICRO_TILE_ROWS;
+						const Type *aPanel = packedA + ir * depth;
+						Type *cTile = c + (ic + ir) * cStride + jc + jr;
+						updateMicroTile(depth, alpha, aPanel, bPanel,
+								cTile, cStride, tileRows, tileColumns);
+					}
+				}
+			}
+		}
+	}
+}
+
+// returns the argument range in the increasing order
+static Range getIncreasingRange(Range range) {
+	if (range.min <= range.max) return range;
+	return Range(range.max, range.min);
+}
+
+template <class Type> void gemm::multiplyAndAdd(Type *c, Dimension *cStoreDims,
+		Type *a, Dimension *aStoreDims,
+		Type *b, Dimension *bStoreDims,
+		Range iRange, Range jRange, Range kRange, Type alpha) {
+
+	Range rows = getIncreasingRange(iRange);
+	Range columns = getIncreasingRange(jRange);
+	Range depth = getIncreasingRange(kRange);
+
+	// locate the first element of each matrix involved in the multiplication within its part storage
+	long int cStride = cStoreDims[1].length;
+	long int aStride = aStoreDims[1].length;
+	long int bStride = bStoreDims[1].length;
+	Type *cStart = c + (rows.min - cStoreDims[0].range.min) * cStride + (columns.min - cStoreDims[1].range.min);
+	Type *aStart = a + (rows.min - aStoreDims[0].range.min) * aStride + (depth.min - aStoreDims[1].range.min);
+	Type *bStart = b + (depth.min - bStoreDims[0].range.min) * bStride + (columns.min - bStoreDims[1].range.min);
+
+	multiplyBlocks(rows.max - rows.min + 1,
+			columns.max - columns.min + 1,
+			depth.max - depth.min + 1,
+			alpha, aStart, aStride, bStart, bStride, cStart, cStride);
+}
+
+template <class Type> Type gemm::dotProduct(Type *a, Dimension *aStoreDims,
+		Type *b, Dimension *bStoreDims,
+		GlobalIndex i, GlobalIndex j, Range kRange) {
+
+	long int aStride = aStoreDims[1].length;
+	long int bStride = bStoreDims[1].length;
+	long int aRowStart = (i - aStoreDims[0].range.min) * aStride;
+	long int bColumn = j - bStoreDims[1].range.min;
+	int step = (kRange.min <= kRange.max) ? 1 : -1;
+	Type sum = 0;
+	for (GlobalIndex k = kRange.min; ; k += step) {
+		sum = sum + a[aRowStart + k - aStoreDims[1].range.min]
+				* b[(k - bStoreDims[0].range.min) * bStride + bColumn];
+		if (k == kRange.max) break;
+	}
+	return sum;
+}
+
+// the kernel is instantiated for the numeric element types an IT array may have
+template void gemm::multiplyAndAdd<int>(int*, Dimension*, int*, Dimension*, int*, Dimension*,
+		Range, Range, Range, int);
+template void gemm::multiplyAndAdd<float>(float*, Dimension*, float*, Dimension*, float*, Dimension*,
+		Range, Range, Range, float);
+template void gemm::multiplyAndAdd<double>(double*, Dimension*, double*, Dimension*, double*, Dimension*,
+		Range, Range, Range, double);
+template int gemm::dotProduct<int>(int*, Dimension*, int*, Dimension*, GlobalIndex, GlobalIndex, Range);
+template float gemm::dotProduct<float>(float*, Dimension*, float*, Dimension*, GlobalIndex, GlobalIndex, Range);
+template double gemm::dotProduct<double>(double*, Dimension*, double*, Dimension*,
+		GlobalIndex, GlobalIndex, Range);
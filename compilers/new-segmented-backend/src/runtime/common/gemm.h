@@ -0,0 +1,55 @@
+#ifndef _H_gemm
+#define _H_gemm
+
+/* This header provides the matrix-matrix multiplication kernel the compiler substitutes for a parallel loop of the
+ * form 'do { c[i][j] = c[i][j] + a[i][k] * b[k][j] } for i, j in c; k in a' when it recognizes one in a compute
+ * stage. A loop over i and j that first sums the products over k in a scalar using an inner loop and then adds the
+ * scalar to c[i][j] is recognized too, as are restrictions on i and j that the index loops would have applied on
+ * their range boundaries. The generic translation of such a loop is a scalar triple loop that recomputes the storage index of all
+ * three array accesses in the innermost iteration and walks b along its columns. The kernel instead follows the
+ * well-known organization of high performance GEMM implementations [Goto and van de Geijn, Anatomy of High-
+ * Performance Matrix Multiplication; TOMS 2008]: blocks of a and b that fit in the caches are packed into contiguous
+ * panels and a micro-kernel updates a small tile of c that is held in registers. The micro-kernel loops have fixed
+ * trip counts and no dependencies among their iterations so that the C++ compiler can unroll and vectorize them.
+ *
+ * The kernel operates directly on the LPU's part storage. A part is stored in row-major order with its storage
+ * dimensions as given by the part dimension objects. The index ranges are those the loop iterates over; a range in
+ * the decreasing order is treated as the same range traversed in the increasing order as the order of updates does
+ * not change the product beyond floating point rounding.
+ */
+
+#include "../../../../common-libs/domain-obj/structure.h"
+
+namespace gemm {
+
+	// the dimensions of a micro-tile of c held in registers
+	const int MICRO_TILE_ROWS = 4;
+	const int MICRO_TILE_COLUMNS = 8;
+
+	// the dimensions of the blocks of a and b packed at a time; a packed block of a should fit in the L2 cache
+	// and a panel of a packed block of b in the L1 cache
+	const int ROW_BLOCK_SIZE = 128;
+	const int DEPTH_BLOCK_SIZE = 256;
+	const int COLUMN_BLOCK_SIZE = 1024;
+
+	// computes c[i][j] += alpha * sum over k of a[i][k] * b[k][j] for all i, j, and k in the argument ranges
+	template <class Type> void multiplyAndAdd(Type *c, Dimension *cStoreDims,
+			Type *a, Dimension *aStoreDims,
+			Type *b, Dimension *bStoreDims,
+			Range iRange, Range jRange, Range kRange, Type alpha);
+
+	// returns the sum over k of a[i][k] * b[k][j] accumulated in the order of the argument range; this gives the
+	// value a scalar accumulating the product holds after the last iteration of the replaced index loops
+	template <class Type> Type dotProduct(Type *a, Dimension *aStoreDims,
+			Type *b, Dimension *bStoreDims,
+			GlobalIndex i, GlobalIndex j, Range kRange);
+
+	// The blocked multiplication over row-major matrices of m x k, k x n, and m x n elements with the argument
+	// row strides; the previous function translates the part storage and index ranges into a call to this one.
+	template <class Type> void multiplyBlocks(int m, int n, int k, Type alpha,
+			const Type *a, long int aStride,
+			const Type *b, long int bStride,
+			Type *c, long int cStride);
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <cstdlib>
 
 #include "lpu_management.h"
+#include "random.h"
 #include "../memory-management/allocation.h"
 #include "../memory-management/part_tracking.h"
 #include "../memory-management/part_generation.h"
@@ -23,6 +24,8 @@ LpuCounter::LpuCounter() {
 	currentLpuId = NULL;
 	currentRange = NULL;
 	currentLinearLpuId = INVALID_ID;
+	restrictedDimension = INVALID_ID;
+	restrictedPartId = INVALID_ID;
 }
 
 LpuCounter::LpuCounter(int lpsDimensions) {
@@ -37,6 +40,16 @@ LpuCounter::LpuCounter(int lpsDimensions) {
 	currentRange = new LpuIdRange;
 	currentRange->startId = INVALID_ID;
 	currentRange->endId = INVALID_ID;
+
+	restrictedDimension = INVALID_ID;
+	restrictedPartId = INVALID_ID;
+}
+
+LpuCounter::~LpuCounter() {
+	if (lpuCounts != NULL) delete[] lpuCounts;
+	if (lpusUnderDimensions != NULL) delete[] lpusUnderDimensions;
+	if (currentLpuId != NULL) delete[] currentLpuId;
+	if (currentRange != NULL) delete currentRange;
 }
 
 void LpuCounter::setLpuCounts(int lpuCounts[]) {
@@ -52,30 +65,67 @@ void LpuCounter::setLpuCounts(int lpuCounts[]) {
 }
 
 void LpuCounter::setCurrentRange(PPU_Ids ppuIds) {	
+	getRangeOfGroup(ppuIds, ppuIds.groupId, currentRange);
+}
+
+void LpuCounter::getRangeOfGroup(PPU_Ids ppuIds, int groupId, LpuIdRange *range) {
 	int totalLpus = 1;
 	for (int i = 0; i < lpsDimensions; i++) {
 		totalLpus *= lpuCounts[i];
 	}
 
 	int ppuCount = ppuIds.ppuCount;
-	int groupId = ppuIds.groupId;
+
+	// when sibling PPUs have different capabilities, each PPU group gets a share of the LPUs that is 
+	// proportional to its weight; a group whose share rounds down to nothing gets no LPU
+	if (ppuIds.ppuWeights != NULL) {
+		long int totalWeight = 0;
+		long int weightBefore = 0;
+		for (int i = 0; i < ppuCount; i++) {
+			if (i == groupId) weightBefore = totalWeight;
+			totalWeight += ppuIds.ppuWeights[i % ppuIds.weightCount];
+		}
+		long int weightUpto = weightBefore + ppuIds.ppuWeights[groupId % ppuIds.weightCount];
+		int startId = (int) ((totalLpus * weightBefore) / totalWeight);
+		int endId = (int) ((totalLpus * weightUpto) / totalWeight) - 1;
+		if (endId < startId) {
+			range->startId = INVALID_ID;
+			range->endId = INVALID_ID;
+		} else {
+			range->startId = startId;
+			range->endId = endId;
+		}
+		return;
+	}
+
 	if (ppuCount > totalLpus) {
 		if (groupId < totalLpus) {
-			currentRange->startId = groupId;
-			currentRange->endId = groupId;
+			range->startId = groupId;
+			range->endId = groupId;
 		} else {
-			currentRange->startId = INVALID_ID;
-			currentRange->endId = INVALID_ID;
+			range->startId = INVALID_ID;
+			range->endId = INVALID_ID;
 		}
 	} else {
 		int lpusPerPpu = totalLpus / ppuCount;
 		int extraLpus = totalLpus % ppuCount;
-		currentRange->startId = lpusPerPpu * groupId;
-		currentRange->endId = currentRange->startId + lpusPerPpu - 1;
+		range->startId = lpusPerPpu * groupId;
+		range->endId = range->startId + lpusPerPpu - 1;
 		if (groupId == ppuCount - 1) {
-			currentRange->endId = currentRange->endId + extraLpus; 
+			range->endId = range->endId + extraLpus; 
+		}
+	}
+}
+
+int LpuCounter::getGroupOfLpu(PPU_Ids ppuIds, int linearLpuId) {
+	LpuIdRange range;
+	for (int groupId = 0; groupId < ppuIds.ppuCount; groupId++) {
+		getRangeOfGroup(ppuIds, groupId, &range);
+		if (range.startId != INVALID_ID && range.startId <= linearLpuId && range.endId >= linearLpuId) {
+			return groupId;
 		}
 	}
+	return INVALID_ID;
 }
 
 int *LpuCounter::setCurrentCompositeLpuId(int linearId) {
@@ -98,6 +148,9 @@ int *LpuCounter::copyCompositeLpuId() {
 } 
 
 int LpuCounter::getNextLpuId(int previousLpuId) {
+	if (restrictedDimension != INVALID_ID) {
+		return getNextRestrictedLpuId(previousLpuId);
+	}
 	if (previousLpuId == INVALID_ID) {
 		return currentRange->startId;
 	} else {
@@ -107,6 +160,32 @@ int LpuCounter::getNextLpuId(int previousLpuId) {
 	}
 }
 
+void LpuCounter::restrictDimension(int dimension, int partId) {
+	restrictedDimension = dimension;
+	restrictedPartId = partId;
+}
+
+int LpuCounter::getNextRestrictedLpuId(int previousLpuId) {
+	
+	if (currentRange->startId == INVALID_ID) return INVALID_ID;
+	int partsCount = lpuCounts[restrictedDimension];
+	if (restrictedPartId >= partsCount) return INVALID_ID;
+
+	// LPUs having the same part Id along the restricted dimension form blocks of consecutive linear Ids; so 
+	// whenever the candidate Id falls outside such a block, we can jump to the beginning of the next block
+	int blockSize = lpusUnderDimensions[restrictedDimension];
+	int strideLength = blockSize * partsCount;
+	int candidate = (previousLpuId == INVALID_ID) ? currentRange->startId : previousLpuId + 1;
+	while (candidate <= currentRange->endId) {
+		int partId = (candidate / blockSize) % partsCount;
+		if (partId == restrictedPartId) return candidate;
+		int strideStart = (candidate / strideLength) * strideLength;
+		if (partId > restrictedPartId) strideStart += strideLength;
+		candidate = strideStart + restrictedPartId * blockSize;
+	}
+	return INVALID_ID;
+}
+
 void LpuCounter::resetCounter() {
 	currentRange->startId = INVALID_ID;
 	currentRange->endId = INVALID_ID;
@@ -187,6 +266,11 @@ LpsState::LpsState(int lpsDimensions, PPU_Ids ppuIds) {
 	lpu = NULL;
 }
 
+LpsState::~LpsState() {
+	delete counter;
+	if (lpu != NULL) delete lpu;
+}
+
 LPU *LpsState::getCurrentLpu(bool allowInvalid) {
 	if (allowInvalid) return lpu;
 	if (lpu != NULL && lpu->isValid()) {
@@ -211,9 +295,35 @@ ThreadState::ThreadState(int lpsCount, int *lpsDimensions, int *partitionArgs, T
 	this->taskData = NULL;
 	this->partConfigMap = NULL;
 	this->partIteratorMap = NULL;
+	this->localReductionResultMap = NULL;
 	this->loggingEnabled = false;
 }
 
+ThreadState::~ThreadState() {
+	for (int i = 0; i < lpsCount; i++) {
+		delete lpsStates[i];
+	}
+	delete[] lpsStates;
+	if (lpsParentIndexMap != NULL) delete[] lpsParentIndexMap;
+	delete lpuIdChain;
+	if (partIteratorMap != NULL) {
+		Iterator<PartIterator*> iterator = partIteratorMap->GetIterator();
+		PartIterator *partIterator = NULL;
+		while ((partIterator = iterator.GetNextValue()) != NULL) {
+			delete partIterator;
+		}
+		delete partIteratorMap;
+	}
+	if (localReductionResultMap != NULL) {
+		Iterator<reduction::Result*> iterator = localReductionResultMap->GetIterator();
+		reduction::Result *result = NULL;
+		while ((result = iterator.GetNextValue()) != NULL) {
+			delete result;
+		}
+		delete localReductionResultMap;
+	}
+}
+
 PartIterator *ThreadState::getIterator(int lpsId, const char *varName) {
 	if (partIteratorMap == NULL) {
 		std::cout << "Data-part iterator map has not been set in thread-state\n";
@@ -417,6 +527,61 @@ int ThreadState::getNextLpuId(int lpsId, int containerLpsId, int currentLpuId) {
 	else return lpu->id;
 }
 
+void ThreadState::restrictLpusToIndexOwner(int lpsId, DataPartitionConfig *config, int dimensionNo, int index) {
+	DimPartitionConfig *dimConfig = config->getDimensionConfig(dimensionNo);
+	int lpsDimension = dimConfig->getLpsAlignment();
+	if (lpsDimension == INVALID_ID) return;
+	int partId = dimConfig->getPartIdOfIndex(index);
+	if (partId == INVALID_ID) return;
+	lpsStates[lpsId]->getCounter()->restrictDimension(lpsDimension, partId);
+}
+
+void ThreadState::removeLpuRestriction(int lpsId) {
+	lpsStates[lpsId]->getCounter()->removeRestriction();
+}
+
+int ThreadState::getSegmentOfIndexOwner(int lpsId, DataPartitionConfig *config, 
+		int dimensionNo, int index, int threadsPerSegment) {
+	
+	DimPartitionConfig *dimConfig = config->getDimensionConfig(dimensionNo);
+	int lpsDimension = dimConfig->getLpsAlignment();
+	if (lpsDimension == INVALID_ID) return INVALID_ID;
+	int partId = dimConfig->getPartIdOfIndex(index);
+	if (partId == INVALID_ID) return INVALID_ID;
+
+	// the index should be held by a single LPU; so the LPS should not be divided along any other dimension
+	LpuCounter *counter = lpsStates[lpsId]->getCounter();
+	int *lpuCounts = counter->getLpuCounts();
+	if (lpuCounts == NULL) return INVALID_ID;
+	int lpsDimensions = counter->getLpsDimensions();
+	for (int i = 0; i < lpsDimensions; i++) {
+		if (i != lpsDimension && lpuCounts[i] > 1) return INVALID_ID;
+	}
+	if (partId >= lpuCounts[lpsDimension]) return INVALID_ID;
+	
+	// Sibling PPU groups of an LPS occupy consecutive blocks of threads of their group size. So the first thread of
+	// the group executing the LPU is found by moving from the current thread's group to the owner group. 
+	PPU_Ids ppuIds = threadIds->ppuIds[lpsId];
+	if (ppuIds.groupSize > threadsPerSegment) return INVALID_ID;
+	int ownerGroup = counter->getGroupOfLpu(ppuIds, partId);
+	if (ownerGroup == INVALID_ID) return INVALID_ID;
+	int groupSize = ppuIds.groupSize;
+	int ownerThread = (threadIds->threadNo / groupSize - ppuIds.groupId + ownerGroup) * groupSize;
+	return ownerThread / threadsPerSegment;
+}
+
+bool ThreadState::getLpuIdRangeUnderRoot(int lpsId, LpuIdRange *range) {
+	LpuCounter *counter = lpsStates[lpsId]->getCounter();
+	int *lpuCounts = computeLpuCounts(lpsId);
+	counter->setLpuCounts(lpuCounts);
+	delete[] lpuCounts;
+	counter->setCurrentRange(threadIds->ppuIds[lpsId]);
+	*range = *(counter->getCurrentRange());
+	// the counter is left as it would be after a traversal of the LPUs is over
+	counter->resetCounter();
+	return range->startId != INVALID_ID;
+}
+
 int *ThreadState::getCurrentLpuId(int lpsId) {
 	LpsState *state = lpsStates[lpsId];
 	LpuCounter *counter = state->getCounter();
@@ -444,6 +609,7 @@ List<int*> *ThreadState::getLpuIdChain(int lpsId, int rootLpsId) {
 		chain->Append(counter->copyCompositeLpuId());
 	}
 
+	delete relevantLpsIds;
 	return chain;
 }
 
@@ -463,6 +629,17 @@ List<int*> *ThreadState::getLpuIdChainWithoutCopy(int lpsId, int rootLpsId) {
 	return lpuIdChain;	
 }
 
+uint64_t ThreadState::getLpuIdChainKey(int lpsId, int rootLpsId) {
+	uint64_t key = 0;
+	int currentLpsId = lpsId;
+	while (currentLpsId != rootLpsId) {
+		LpuCounter *counter = lpsStates[currentLpsId]->getCounter();
+		key = rng::combineKey(key, (uint64_t) (uint32_t) counter->getCurrentLpuId());
+		currentLpsId = lpsParentIndexMap[currentLpsId];
+	}
+	return key;
+}
+
 int *ThreadState::getLpuCounts(int lpsId) {
 	LpsState *state = lpsStates[lpsId];
 	LpuCounter *counter = state->getCounter();
@@ -531,6 +708,11 @@ SegmentState::SegmentState(int segmentId, int physicalId) {
 	this->partConfigMap = NULL;
 }
 
+SegmentState::~SegmentState() {
+	// the participant thread-states are not owned by the segment; they are deleted by whoever created them
+	delete participantList;
+}
+
 int SegmentState::getPpuCountForLps(int lpsId) {
 	int count = 0;
 	for (int i = 0; i < participantList->NumElements(); i++) {
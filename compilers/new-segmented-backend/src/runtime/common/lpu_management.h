@@ -12,6 +12,7 @@
 #include "../../../../common-libs/domain-obj/structure.h"
 
 #include <fstream>
+#include <stdint.h>
 
 /* Remember that there is a partial ordering of logical processing spaces (LPS). Thereby, the number of
    LPUs for a child LPS at a particular point of computation depends on the size of the data structure
@@ -48,18 +49,35 @@ class LpuCounter {
 	int *currentLpuId;
 	// linear equivalent of the multidimensional id
 	int currentLinearLpuId;
+	// When an LPS dimension is restricted, only the LPUs having the restricted part Id along that dimension are
+	// returned by the get-next-LPU-Id routine. The restricted dimension is INVALID_ID when there is no
+	// restriction.
+	int restrictedDimension;
+	int restrictedPartId;
 	// a constructor to be utilized by subclasses
 	LpuCounter();
+	// the get-next-LPU-Id routine applicable when an LPS dimension is restricted
+	int getNextRestrictedLpuId(int previousLpuId);
   public:
 	LpuCounter(int lpsDimensions);
+	virtual ~LpuCounter();
 	virtual void setLpuCounts(int *lpuCounts);
 	virtual int *getLpuCounts() { return lpuCounts; }
+	int getLpsDimensions() { return lpsDimensions; }
 	virtual void setCurrentRange(PPU_Ids ppuIds);
+	LpuIdRange *getCurrentRange() { return currentRange; }
+	// computes the range of linear LPU Ids a sibling PPU group gets from the current LPU counts; the range is
+	// invalid if the group gets no LPU
+	void getRangeOfGroup(PPU_Ids ppuIds, int groupId, LpuIdRange *range);
+	// the reverse of the above; returns the Id of the sibling PPU group that gets the argument LPU
+	int getGroupOfLpu(PPU_Ids ppuIds, int linearLpuId);
 	virtual int *getCompositeLpuId() { return currentLpuId; }
 	virtual int *copyCompositeLpuId();
 	virtual int *setCurrentCompositeLpuId(int linearId);
 	int getCurrentLpuId() { return currentLinearLpuId; }
 	virtual int getNextLpuId(int previousLpuId);
+	void restrictDimension(int dimension, int partId);
+	void removeRestriction() { restrictedDimension = INVALID_ID; }
 	virtual void resetCounter();
 	virtual void logLpuRange(std::ofstream &log, int indent);
 	virtual void logLpuCount(std::ofstream &log, int indent);
@@ -107,6 +125,7 @@ class LpsState {
 	LPU *lpu;
 
 	LpsState(int lpsDimensions, PPU_Ids ppuIds);
+	~LpsState();
 	void markAsIterationBound() { iterationBound = true; }
 	bool isIterationBound() { return iterationBound; }
 	void removeIterationBound() { iterationBound = false; }
@@ -192,6 +211,30 @@ class ThreadState {
 	// backends.
 	int getNextLpuId(int lpsId, int containerLpsId, int currentLpuId);
 
+	// An activation condition of the form 'index in array.local.dimension.range' on the sub-flow of an LPS is
+	// satisfied only by the LPUs holding the part of the array that contains the index. The first function below
+	// locates that part from the index, by inverting the partition function of the array dimension, and lets the 
+	// get-Next-LPU routine skip all LPUs that do not hold it without computing them. So a PPU that holds none of 
+	// those LPUs leaves the LPS immediately. The restriction is applied only if the dimension has not been 
+	// divided in any ancestor LPS and the part can be located directly; otherwise the LPUs are traversed as usual. 
+	void restrictLpusToIndexOwner(int lpsId, DataPartitionConfig *config, int dimensionNo, int index);
+	void removeLpuRestriction(int lpsId);
+
+	// For the same kind of activation condition, the PPU of the LPU holding the index is the only one that executes
+	// the sub-flow. So when a replicated data item is updated in the sub-flow, the segment doing the update can be 
+	// derived in all segments from the index, and communicators need not discover it with a collective operation.
+	// This function returns the Id of that segment. It assumes that the LPU counts of the LPS have been computed 
+	// for the current container LPU; it returns INVALID_ID if the LPU cannot be located directly, if more than one 
+	// LPU holds the index, or if the PPU of the LPU spans multiple segments. 
+	int getSegmentOfIndexOwner(int lpsId, DataPartitionConfig *config, 
+			int dimensionNo, int index, int threadsPerSegment);
+
+	// For an LPS lying directly under the root, the LPUs a thread gets form a single range of linear LPU Ids that
+	// depends only on the LPU counts of the LPS and the PPU Ids of the thread. This function computes that range
+	// without traversing the LPUs; afterwards the LPU counts of the LPS are available through the get-LPU-counts
+	// function below. It returns false if the thread gets no LPU from the LPS.
+	bool getLpuIdRangeUnderRoot(int lpsId, LpuIdRange *range);
+
 	// function to be used at runtime to propel LPU creation from ID; this is a makeshift operation to
 	// reduce the amount of changes we need to make in our transition from multicore to segmented-memory
 	// backends; there should be some better way to generate the LPUs hierarchically from configurations
@@ -207,6 +250,9 @@ class ThreadState {
 	// rather it just return a list formed by ids taken from different LPS counters; it should be used 
 	// with caution
 	List<int*> *getLpuIdChainWithoutCopy(int lpsId, int rootLpsId);
+	// returns a key combining the linear ids of the current LPUs of the argument LPS and all its ancestors below
+	// the root; the key identifies the current LPU of the LPS uniquely within the task, for random streams
+	uint64_t getLpuIdChainKey(int lpsId, int rootLpsId);
 	
 
 	// returns the current multidimensional LPU count stored in the state-counter of the LPS indicated by 
@@ -218,7 +264,9 @@ class ThreadState {
 	ThreadIds *getThreadIds() { return threadIds; }
 	bool isValidPpu(int lpsId);
 	int getThreadNo() { return threadIds->threadNo; }
-	virtual ~ThreadState() {}
+	// the LPS states, LPUs, and part iterators belong to the thread-state; but the partition configurations, task
+	// data, and communicators are shared among threads and are not deleted here
+	virtual ~ThreadState();
 	
 	// a log file for diagnostics and corresponding methods
 	std::ofstream threadLog;
@@ -244,6 +292,7 @@ class SegmentState {
 	Hashtable<DataPartitionConfig*> *partConfigMap;
   public:
 	SegmentState(int segmentId, int physicalId);
+	~SegmentState();
 	int getSegmentId() { return segmentId; }
 	int getPhysicalId() { return physicalId; }
 	void setPartConfigMap(Hashtable<DataPartitionConfig*> *partConfigMap) { 
@@ -0,0 +1,182 @@
+#include "random.h"
+
+#include <cstdlib>
+#include <stdint.h>
+#include <pthread.h>
+
+using namespace rng;
+
+// the default seed of program runs; any fixed value serves the purpose of reproducibility
+static const uint64_t DEFAULT_PROGRAM_SEED = 0x5DEECE66DULL;
+
+// the multiplier used to scale the upper 53 bits of a 64 bit random integer into [0, 1)
+static const double DOUBLE_WORD_TO_UNIFORM = 1.0 / 9007199254740992.0;
+
+// mixes the bits of a 64 bit integer (the finalizer of the SplitMix64 generator) to derive independent keys
+static uint64_t mixBits(uint64_t value) {
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+//-------------------------------------------------------------- Random Stream ---------------------------------------------------------------/
+
+RandomStream::RandomStream() {
+	key[0] = key[1] = 0;
+	counter[0] = counter[1] = counter[2] = counter[3] = 0;
+	nextInBlock = 4;
+}
+
+RandomStream::RandomStream(uint64_t seed, uint32_t streamId0, uint32_t streamId1, uint32_t streamId2) {
+	uint64_t mixedSeed = mixBits(seed);
+	key[0] = (uint32_t) mixedSeed;
+	key[1] = (uint32_t) (mixedSeed >> 32);
+	counter[0] = 0;
+	counter[1] = streamId0;
+	counter[2] = streamId1;
+	counter[3] = streamId2;
+	nextInBlock = 4;
+}
+
+uint32_t RandomStream::nextWord() {
+	if (nextInBlock == 4) {
+		philox4x32(counter, key, block);
+		counter[0]++;
+		nextInBlock = 0;
+	}
+	return block[nextInBlock++];
+}
+
+double RandomStream::nextUniform() {
+	uint64_t upper = nextWord();
+	uint64_t lower = nextWord();
+	return (((upper << 32) | lower) >> 11) * DOUBLE_WORD_TO_UNIFORM;
+}
+
+void RandomStream::fillInts(int *values, int count) {
+
+	// first use up what is left in the current block
+	int index = 0;
+	while (index < count && nextInBlock < 4) {
+		values[index++] = nextInt();
+	}
+
+	// then generate whole blocks directly into the output array; there is no dependency between iterations of this
+	// loop
+	int blocks = (count - index) / 4;
+	uint32_t firstBlock = counter[0];
+	for (int b = 0; b < blocks; b++) {
+		uint32_t blockCounter[4] = { firstBlock + b, counter[1], counter[2], counter[3] };
+		uint32_t output[4];
+		philox4x32(blockCounter, key, output);
+		for (int i = 0; i < 4; i++) {
+			values[index + b * 4 + i] = (int) (output[i] >> 1);
+		}
+	}
+	counter[0] = firstBlock + blocks;
+	index += blocks * 4;
+
+	// finally generate the remaining numbers one by one
+	while (index < count) {
+		values[index++] = nextInt();
+	}
+}
+
+void RandomStream::fillUniforms(double *values, int count) {
+
+	// a uniform needs two words, i.e., half a block; so an odd position within the current block is skipped
+	if (nextInBlock % 2 == 1) nextInBlock++;
+	int index = 0;
+	while (index < count && nextInBlock < 4) {
+		values[index++] = nextUniform();
+	}
+
+	int pairs = (count - index) / 2;
+	uint32_t firstBlock = counter[0];
+	for (int b = 0; b < pairs; b++) {
+		uint32_t blockCounter[4] = { firstBlock + b, counter[1], counter[2], counter[3] };
+		uint32_t output[4];
+		philox4x32(blockCounter, key, output);
+		for (int i = 0; i < 2; i++) {
+			uint64_t word = ((uint64_t) output[i * 2] << 32) | output[i * 2 + 1];
+			values[index + b * 2 + i] = (word >> 11) * DOUBLE_WORD_TO_UNIFORM;
+		}
+	}
+	counter[0] = firstBlock + pairs;
+	index += pairs * 2;
+
+	while (index < count) {
+		values[index++] = nextUniform();
+	}
+}
+
+//-------------------------------------------------------------- Stream Source ---------------------------------------------------------------/
+
+StreamSource::StreamSource() {
+	taskSeed = 0;
+	lpsId = 0;
+	lpuChainKey = 0;
+	iterationKey = 0;
+}
+
+void StreamSource::setCurrentLpu(int lpsId, uint64_t lpuChainKey, uint64_t iterationKey) {
+	this->lpsId = lpsId;
+	this->lpuChainKey = lpuChainKey;
+	this->iterationKey = iterationKey;
+}
+
+RandomStream StreamSource::getStream(int stageIndex) {
+	// the loop iterations are folded into the key and the LPS, the stage, and the LPU into the counter words
+	uint64_t seed = combineKey(taskSeed, iterationKey);
+	uint32_t stageId = ((uint32_t) lpsId << 16) | ((uint32_t) stageIndex & 0xFFFF);
+	return RandomStream(seed, stageId, (uint32_t) lpuChainKey, (uint32_t) (lpuChainKey >> 32));
+}
+
+uint64_t rng::combineKey(uint64_t key, uint64_t value) {
+	return mixBits(key ^ mixBits(value));
+}
+
+//------------------------------------------------------------ Program Level Seeds -----------------------------------------------------------/
+
+static uint64_t programSeed = 0;
+static bool programSeedRead = false;
+static uint64_t taskInvocations = 0;
+
+uint64_t rng::getProgramSeed() {
+	if (!programSeedRead) {
+		const char *seedSetting = getenv("IT_RANDOM_SEED");
+		if (seedSetting != NULL) {
+			programSeed = strtoull(seedSetting, NULL, 10);
+		} else {
+			programSeed = DEFAULT_PROGRAM_SEED;
+		}
+		programSeedRead = true;
+	}
+	return programSeed;
+}
+
+uint64_t rng::getNextTaskSeed() {
+	// concurrently launched invocations take their seeds in their serial phases; the atomic increment only guards 
+	// against the counter being corrupted should that ever not be the case
+	uint64_t invocationNo = __sync_add_and_fetch(&taskInvocations, 1);
+	return mixBits(getProgramSeed() ^ mixBits(invocationNo));
+}
+
+//------------------------------------------------------------ Thread Local Stream -----------------------------------------------------------/
+
+static __thread RandomStream *threadLocalStream = NULL;
+static uint32_t threadStreams = 0;
+static pthread_mutex_t threadStreamLock = PTHREAD_MUTEX_INITIALIZER;
+
+int rng::nextThreadLocalInt() {
+
+	// a thread takes the lock only once to get its stream number
+	if (threadLocalStream == NULL) {
+		pthread_mutex_lock(&threadStreamLock);
+		uint32_t streamNo = threadStreams++;
+		pthread_mutex_unlock(&threadStreamLock);
+		threadLocalStream = new RandomStream(getProgramSeed(), 0xFFFFFFFF, streamNo, 0);
+	}
+	return threadLocalStream->nextInt();
+}
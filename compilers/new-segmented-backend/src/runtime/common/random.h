@@ -0,0 +1,116 @@
+#ifndef _H_random
+#define _H_random
+
+/* This header provides the random number generator used by the translated code of IT's random() library function.
+ * The generator is a counter-based one: the Philox-4x32-10 generator of Salmon et al. [Parallel Random Numbers: As
+ * Easy as 1, 2, 3; SC 2011]. A counter-based generator has no shared state; the i-th random number of a stream is a
+ * pure function of the stream key and i. So PPU threads generate random numbers without any locking and the numbers
+ * an LPU gets do not depend on which PPU executes it or on how many PPUs there are.
+ *
+ * The stream of an LPU for a compute stage is identified by the task invocation, the LPS and the compute stage, the
+ * chain of LPU ids leading to the LPU from the root LPS, and the iterations of the enclosing repeat loops. None of
+ * these depends on which thread executes the LPU or on what that thread has executed before. So re-running a program
+ * with the same seed reproduces the same random numbers regardless of the thread count and the mapping.
+ * */
+
+#include <stdint.h>
+
+namespace rng {
+
+	// the largest integer returned by random(); it is the same as the RAND_MAX of glibc for compatibility
+	const int RANDOM_INT_MAX = 2147483647;
+
+	// Philox-4x32 constants
+	const uint32_t PHILOX_M0 = 0xD2511F53;
+	const uint32_t PHILOX_M1 = 0xCD9E8D57;
+	const uint32_t PHILOX_W0 = 0x9E3779B9;
+	const uint32_t PHILOX_W1 = 0xBB67AE85;
+	const int PHILOX_ROUNDS = 10;
+
+	// generates four 32 bit random numbers from a 128 bit counter and a 64 bit key; the function has no branches
+	// so that loops generating random numbers for consecutive counters can be vectorized
+	inline void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t output[4]) {
+		uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+		uint32_t k0 = key[0], k1 = key[1];
+		for (int r = 0; r < PHILOX_ROUNDS; r++) {
+			uint64_t p0 = (uint64_t) PHILOX_M0 * c0;
+			uint64_t p1 = (uint64_t) PHILOX_M1 * c2;
+			c0 = (uint32_t) (p1 >> 32) ^ c1 ^ k0;
+			c1 = (uint32_t) p1;
+			c2 = (uint32_t) (p0 >> 32) ^ c3 ^ k1;
+			c3 = (uint32_t) p0;
+			k0 += PHILOX_W0;
+			k1 += PHILOX_W1;
+		}
+		output[0] = c0; output[1] = c1; output[2] = c2; output[3] = c3;
+	}
+
+	/* A random stream hands out the random numbers of a single stream key in order. The first counter word is the
+	 * block index within the stream and the other three words identify the stream. Each block gives four numbers.
+	 * */
+	class RandomStream {
+	  private:
+		uint32_t key[2];
+		uint32_t counter[4];
+		uint32_t block[4];
+		int nextInBlock;
+	  public:
+		RandomStream();
+		RandomStream(uint64_t seed, uint32_t streamId0, uint32_t streamId1, uint32_t streamId2);
+
+		// returns a non-negative integer in the range [0, RANDOM_INT_MAX]
+		int nextInt() { return (int) (nextWord() >> 1); }
+		// returns a double-precision number uniformly distributed in [0, 1)
+		double nextUniform();
+
+		// These functions generate a batch of random numbers at once. They are meant for sampling loops that need
+		// many random numbers as the generation loop over independent counters can be vectorized by the compiler.
+		// The stream advances past the generated numbers.
+		void fillInts(int *values, int count);
+		void fillUniforms(double *values, int count);
+	  private:
+		uint32_t nextWord();
+	};
+
+	/* Each PPU thread keeps the identity of the LPU it is about to execute a compute stage for in a stream source.
+	 * The thread sets the LPU before invoking a compute stage that uses random numbers; then the stage gets the
+	 * stream of that LPU from the source. The source holds no execution history; so the stream of an LPU does not
+	 * depend on the LPUs the thread executed before.
+	 * */
+	class StreamSource {
+	  private:
+		uint64_t taskSeed;
+		int lpsId;
+		uint64_t lpuChainKey;
+		uint64_t iterationKey;
+	  public:
+		StreamSource();
+		void setTaskSeed(uint64_t taskSeed) { this->taskSeed = taskSeed; }
+		void setCurrentLpu(int lpsId, uint64_t lpuChainKey, uint64_t iterationKey);
+		RandomStream getStream(int stageIndex);
+	};
+
+	// combines a key with a value into a new key; this is used to fold LPU ids and loop iterations into stream keys
+	uint64_t combineKey(uint64_t key, uint64_t value);
+
+	// returns the key identifying an iteration of a repeat loop nested within the iteration of the enclosing loops
+	// that the argument key identifies; the key outside all repeat loops is 0
+	inline uint64_t nextIterationKey(uint64_t enclosingKey, int iteration) {
+		return combineKey(enclosingKey, (uint64_t) iteration + 1);
+	}
+
+	// the seed for the whole program run; it can be changed by setting the IT_RANDOM_SEED environment variable
+	uint64_t getProgramSeed();
+
+	// Returns the seed for the next task invocation. All segments invoke the tasks of a program in the same order;
+	// so this gives the same seed to the same task invocation in all segments. This should be called exactly once 
+	// per task invocation in every segment, including the segments that do not participate in the task, and within
+	// the preparation phase of the invocation so that concurrently launched invocations take seeds in launch order.
+	uint64_t getNextTaskSeed();
+
+	// random() calls that happen outside compute stages, e.g., in user defined functions, use this lock-free stream
+	// that is private to the calling thread; these numbers are not reproducible across different mappings
+	int nextThreadLocalInt();
+}
+
+#endif
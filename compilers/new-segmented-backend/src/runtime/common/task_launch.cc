@@ -0,0 +1,257 @@
+#include "task_launch.h"
+#include "../communication/mpi_group.h"
+
+#include <mpi.h>
+#include <pthread.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+
+//---------------------------------------------------------- Execution Context ----------------------------------------------------------/
+
+__thread ExecutionContext *ExecutionContext::current = NULL;
+
+ExecutionContext::ExecutionContext(TaskLaunchGroup *group, int slot,
+		int processorOffset,
+		MPI_Comm communicator, std::ofstream *logFile) {
+	this->group = group;
+	this->slot = slot;
+	this->processorOffset = processorOffset;
+	this->communicator = communicator;
+	this->logFile = logFile;
+	this->serialPhasesPassed = 0;
+	this->runner = NULL;
+	this->runnerArgs = NULL;
+}
+
+void ExecutionContext::beginSerialPhase() {
+	if (current == NULL || current->group == NULL) return;
+	current->group->waitForTurn(current);
+}
+
+void ExecutionContext::endSerialPhase() {
+	if (current == NULL || current->group == NULL) return;
+	current->group->passTurn(current);
+}
+
+//---------------------------------------------------------- Task Launch Group -----------------------------------------------------------/
+
+int TaskLaunchGroup::concurrency = 1;
+std::vector<MPI_Comm> TaskLaunchGroup::communicators;
+
+void TaskLaunchGroup::initialize(int maxConcurrency, std::ofstream &logFile) {
+
+	// all segments should agree on the number of invocations that may run together
+	int localConcurrency = MpiThreadSupport::isMultithreaded() ? maxConcurrency : 1;
+	int status = MPI_Allreduce(&localConcurrency, &concurrency, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+	if (status != MPI_SUCCESS) {
+		std::cout << "could not agree on the number of concurrent task invocations\n";
+		std::exit(EXIT_FAILURE);
+	}
+	if (concurrency < 2) {
+		concurrency = 1;
+		logFile << "Independent task invocations will run one after another as MPI does not support ";
+		logFile << "concurrent calls from multiple threads\n";
+		logFile.flush();
+		return;
+	}
+	for (int i = 0; i < concurrency; i++) {
+		MPI_Comm communicator;
+		status = MPI_Comm_dup(MPI_COMM_WORLD, &communicator);
+		if (status != MPI_SUCCESS) {
+			std::cout << "could not create communicators for concurrent task invocations\n";
+			std::exit(EXIT_FAILURE);
+		}
+		communicators.push_back(communicator);
+	}
+	logFile << "Up to " << concurrency << " independent task invocations may run concurrently\n";
+	logFile.flush();
+}
+
+TaskLaunchGroup::TaskLaunchGroup(int segmentId, std::ofstream &logFile) {
+	this->segmentId = segmentId;
+	this->logFile = &logFile;
+	this->processorCount = 0;
+	this->turn = 0;
+	this->closed = false;
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&condition, NULL);
+}
+
+TaskLaunchGroup::~TaskLaunchGroup() {
+	waitForAll();
+	pthread_mutex_destroy(&mutex);
+	pthread_cond_destroy(&condition);
+}
+
+void TaskLaunchGroup::prepareLaunch(TaskPlacement *placement) {
+
+	// in the absence of concurrency each invocation runs alone
+	int offset = 0;
+	bool fits = false;
+	if (concurrency > 1 && slots.size() < (unsigned int) concurrency) {
+		fits = findProcessorOffset(placement, &offset);
+		int localFit = fits ? 1 : 0;
+		int globalFit = 0;
+		int status = MPI_Allreduce(&localFit, &globalFit, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+		if (status != MPI_SUCCESS) {
+			std::cout << "could not agree on the placement of a task invocation\n";
+			std::exit(EXIT_FAILURE);
+		}
+		fits = (globalFit == 1);
+	}
+	if (!fits) {
+		waitForAll();
+		offset = 0;
+		findProcessorOffset(placement, &offset);
+	}
+	occupyProcessors(placement, offset);
+
+	int slot = slots.size();
+	MPI_Comm communicator = MPI_COMM_WORLD;
+	std::ofstream *slotLog = logFile;
+	if (concurrency > 1) {
+		communicator = communicators.at(slot);
+		std::ostringstream logFileName;
+		logFileName << "segment_" << segmentId << "_slot_" << slot << ".log";
+		slotLog = new std::ofstream(logFileName.str().c_str());
+	}
+	ExecutionContext *context = new ExecutionContext(this, slot, offset, communicator, slotLog);
+	slots.push_back(context);
+
+	// the coordinator prepares the invocation in its turn to not interfere with the preparations of the earlier ones
+	waitForTurn(context);
+}
+
+void TaskLaunchGroup::launch(void *(*runner)(void*), void *arguments) {
+	ExecutionContext *context = slots.back();
+	context->runner = runner;
+	context->runnerArgs = arguments;
+	if (concurrency == 1) {
+		pthread_mutex_lock(&mutex);
+		closed = true;
+		pthread_mutex_unlock(&mutex);
+		runSlot(context);
+		return;
+	}
+	if (pthread_create(&(context->thread), NULL, runSlot, context) != 0) {
+		std::cout << "Could not start a thread for a concurrent task invocation\n";
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+void TaskLaunchGroup::waitForAll() {
+
+	pthread_mutex_lock(&mutex);
+	closed = true;
+	pthread_cond_broadcast(&condition);
+	pthread_mutex_unlock(&mutex);
+
+	for (unsigned int i = 0; i < slots.size(); i++) {
+		ExecutionContext *context = slots.at(i);
+		if (concurrency > 1) {
+			pthread_join(context->thread, NULL);
+			// append the log of the invocation to the program log and remove it
+			context->logFile->close();
+			delete context->logFile;
+			std::ostringstream logFileName;
+			logFileName << "segment_" << segmentId << "_slot_" << i << ".log";
+			std::ifstream slotLog(logFileName.str().c_str());
+			*logFile << "---------------- concurrently launched invocation " << i << "\n";
+			if (slotLog.is_open() && slotLog.peek() != std::ifstream::traits_type::eof()) {
+				*logFile << slotLog.rdbuf();
+			}
+			slotLog.close();
+			std::remove(logFileName.str().c_str());
+		}
+		delete context;
+	}
+	if (concurrency > 1 && slots.size() > 0) {
+		*logFile << "---------------- end of concurrently launched invocations\n";
+		logFile->flush();
+	}
+
+	slots.clear();
+	occupiedProcessors.clear();
+	processorCount = 0;
+	turn = 0;
+	closed = false;
+}
+
+bool TaskLaunchGroup::findProcessorOffset(TaskPlacement *placement, int *offset) {
+
+	*offset = 0;
+	if (placement->processors.empty()) return true;
+	if (processorCount == 0) return true;
+	if (placement->processorCount != processorCount) return false;
+	for (int shift = 0; shift < processorCount; shift++) {
+		bool free = true;
+		for (unsigned int i = 0; i < placement->processors.size(); i++) {
+			int position = (placement->processors.at(i) + shift) % processorCount;
+			if (occupiedProcessors.at(position)) {
+				free = false;
+				break;
+			}
+		}
+		if (free) {
+			*offset = shift;
+			return true;
+		}
+	}
+	return false;
+}
+
+void TaskLaunchGroup::occupyProcessors(TaskPlacement *placement, int offset) {
+	if (placement->processors.empty()) return;
+	if (processorCount == 0) {
+		processorCount = placement->processorCount;
+		occupiedProcessors.assign(processorCount, false);
+	}
+	for (unsigned int i = 0; i < placement->processors.size(); i++) {
+		int position = (placement->processors.at(i) + offset) % processorCount;
+		occupiedProcessors.at(position) = true;
+	}
+}
+
+void TaskLaunchGroup::waitForTurn(ExecutionContext *context) {
+	pthread_mutex_lock(&mutex);
+	while (true) {
+		int phase = -1;
+		if (context->serialPhasesPassed == 0) {
+			phase = context->slot;
+		} else if (closed) {
+			phase = slots.size() + context->slot;
+		}
+		if (phase == turn) break;
+		pthread_cond_wait(&condition, &mutex);
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+void TaskLaunchGroup::passTurn(ExecutionContext *context) {
+	pthread_mutex_lock(&mutex);
+	context->serialPhasesPassed++;
+	turn++;
+	pthread_cond_broadcast(&condition);
+	pthread_mutex_unlock(&mutex);
+}
+
+void *TaskLaunchGroup::runSlot(void *argument) {
+
+	ExecutionContext *context = (ExecutionContext*) argument;
+	ExecutionContext *enclosing = ExecutionContext::getCurrent();
+	ExecutionContext::enter(context);
+	context->runner(context->runnerArgs);
+
+	// a segment that does not participate in the task returns from its execute function before the completion phase;
+	// the turns of the phases it skipped are passed here so that the other invocations can proceed
+	while (context->serialPhasesPassed < 2) {
+		ExecutionContext::beginSerialPhase();
+		ExecutionContext::endSerialPhase();
+	}
+	ExecutionContext::enter(enclosing);
+	return NULL;
+}
@@ -0,0 +1,139 @@
+#ifndef _H_task_launch
+#define _H_task_launch
+
+/* When consecutive task invocations of the coordinator program do not depend on one another through the environment,
+ * the generated main function launches them concurrently using a launch group instead of calling the execute function
+ * of one task after another. Each concurrently launched invocation runs its task's execute function in a separate host
+ * thread of the segment process and has
+ *
+ *   1. its own MPI communicator, a duplicate of the world communicator, that all collective and point-to-point MPI
+ *      operations of the invocation use in place of the world communicator; so the messages of different invocations
+ *      never match one another, and
+ *   2. a processor offset that shifts the processors its PPU controller threads are pinned to so that they do not
+ *      overlap the processors of the other invocations running with it; the relative placement of the threads the
+ *      task's mapping dictates remains the same.
+ *
+ * An invocation that cannot be placed on processors disjoint from those of the invocations already running in any of
+ * the segments waits for them to finish, and so does one for which there is no free communicator. Whether to wait is
+ * agreed upon by all segments so that every segment runs the same set of invocations together.
+ *
+ * The program environment is not thread-safe and the preparation and cleanup of a task's environment involve
+ * collective communications. So the execute function of a task marks the part before its PPU controller threads start
+ * and the part after they finish as serial phases. The serial phases of concurrently launched invocations take turns
+ * in a fixed order: the preparation phases in the launch order, then the completion phases in the launch order. Only
+ * the computations of the invocations overlap, therefore; but the order of the serial phases is the same in all
+ * segments and the collective operations they perform cannot deadlock.
+ *
+ * Concurrent launches require MPI to support concurrent calls from multiple threads. Without that, a launch group runs
+ * the invocations one after another in the coordinator's thread, which is the same as calling their execute functions
+ * directly.
+ * */
+
+#include <mpi.h>
+#include <pthread.h>
+#include <vector>
+#include <fstream>
+
+class TaskLaunchGroup;
+
+/* The processors the PPU controller threads of a task are pinned to in the current segment, given as positions within
+ * a physical unit of the given number of processors. A segment that does not participate in the task has none.
+ * */
+class TaskPlacement {
+  public:
+	int processorCount;
+	std::vector<int> processors;
+	TaskPlacement() { processorCount = 0; }
+	void addProcessor(int position) { processors.push_back(position); }
+};
+
+/* The context of a task invocation launched by a launch group. The thread running the task's execute function enters
+ * it and the PPU controller threads of the task inherit it from that thread. Code running outside any context, such as
+ * an invocation launched directly by the coordinator, gets the world communicator and no processor offset.
+ * */
+class ExecutionContext {
+  protected:
+	TaskLaunchGroup *group;
+	// index of the invocation among those running together; the same in all segments
+	int slot;
+	int processorOffset;
+	MPI_Comm communicator;
+	std::ofstream *logFile;
+	// the number of serial phases of the execute function that are over; there are two: preparation and completion
+	int serialPhasesPassed;
+	void *(*runner)(void*);
+	void *runnerArgs;
+	pthread_t thread;
+
+	static __thread ExecutionContext *current;
+  public:
+	ExecutionContext(TaskLaunchGroup *group, int slot,
+			int processorOffset,
+			MPI_Comm communicator, std::ofstream *logFile);
+	int getSlot() { return slot; }
+	int getSerialPhasesPassed() { return serialPhasesPassed; }
+
+	static ExecutionContext *getCurrent() { return current; }
+	static void enter(ExecutionContext *context) { current = context; }
+	static MPI_Comm getCommunicator() { return (current == NULL) ? MPI_COMM_WORLD : current->communicator; }
+	static int getProcessorOffset() { return (current == NULL) ? 0 : current->processorOffset; }
+	// a number distinguishing the resources, such as shared memory regions, of concurrently running invocations
+	static int getSlotId() { return (current == NULL) ? 0 : current->slot; }
+	// the log file the launched invocation should write into
+	static std::ofstream *getLogFile() { return (current == NULL) ? NULL : current->logFile; }
+
+	// functions the execute function of a task calls at the beginning and end of its serial phases; they do nothing
+	// outside a launch group
+	static void beginSerialPhase();
+	static void endSerialPhase();
+
+	friend class TaskLaunchGroup;
+};
+
+class TaskLaunchGroup {
+  protected:
+	int segmentId;
+	std::ofstream *logFile;
+	// contexts of the invocations currently running together
+	std::vector<ExecutionContext*> slots;
+	// processors occupied by those invocations in the current segment
+	int processorCount;
+	std::vector<bool> occupiedProcessors;
+	// serial phases are numbered 0, 1, 2... in the order they should take place and the turn is the number of the
+	// phase that may proceed; the numbers of the completion phases are known only after the last invocation of the
+	// running set has been launched, which is when the set gets closed
+	int turn;
+	bool closed;
+	pthread_mutex_t mutex;
+	pthread_cond_t condition;
+
+	// the number of invocations that may run together and a communicator for each of them
+	static int concurrency;
+	static std::vector<MPI_Comm> communicators;
+  public:
+	// sets up the communicators for concurrently launched invocations; this is a collective operation over all
+	// segments and should be done once at the beginning of the program
+	static void initialize(int maxConcurrency, std::ofstream &logFile);
+
+	TaskLaunchGroup(int segmentId, std::ofstream &logFile);
+	~TaskLaunchGroup();
+
+	// Reserves a slot for the next invocation of the group, waiting for the invocations already running to finish if
+	// the new one cannot run with them. On return, the preparation phases of the earlier invocations are over and the
+	// coordinator may set up the invocation's environment and then launch it.
+	void prepareLaunch(TaskPlacement *placement);
+	// starts the execute function of the invocation through the runner the task provides for the launch groups
+	void launch(void *(*runner)(void*), void *arguments);
+	// waits for all launched invocations to finish and appends their logs to the program log
+	void waitForAll();
+  protected:
+	bool findProcessorOffset(TaskPlacement *placement, int *offset);
+	void occupyProcessors(TaskPlacement *placement, int offset);
+	void waitForTurn(ExecutionContext *context);
+	void passTurn(ExecutionContext *context);
+	static void *runSlot(void *argument);
+
+	friend class ExecutionContext;
+};
+
+#endif
@@ -0,0 +1,250 @@
+#include "adaptive_comm_buffer.h"
+#include "comm_buffer.h"
+#include "comm_statistics.h"
+#include "confinement_mgmt.h"
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <sys/time.h>
+
+//---------------------------------------------------------- Comm Buffer Factory ----------------------------------------------------------/
+
+CommBuffer *CommBufferFactory::createBuffer(CommBufferType type,
+		DataExchange *exchange,
+		SyncConfig *syncConfig, bool intraSegment) {
+
+	if (intraSegment) {
+		switch (type) {
+			case PLAIN_BUFFER: return new VirtualCommBuffer(exchange, syncConfig);
+			case PREPROCESSED_BUFFER: return new PreprocessedVirtualCommBuffer(exchange, syncConfig);
+			case INDEX_MAPPED_BUFFER: return new IndexMappedVirtualCommBuffer(exchange, syncConfig);
+			case SWIFT_INDEX_MAPPED_BUFFER: return new SwiftIndexMappedVirtualCommBuffer(exchange, syncConfig);
+		}
+	} else {
+		switch (type) {
+			case PLAIN_BUFFER: return new PhysicalCommBuffer(exchange, syncConfig);
+			case PREPROCESSED_BUFFER: return new PreprocessedPhysicalCommBuffer(exchange, syncConfig);
+			case INDEX_MAPPED_BUFFER: return new IndexMappedPhysicalCommBuffer(exchange, syncConfig);
+			case SWIFT_INDEX_MAPPED_BUFFER: return new SwiftIndexMappedPhysicalCommBuffer(exchange, syncConfig);
+		}
+	}
+	std::cout << "unknown communication buffer type requested\n";
+	std::exit(EXIT_FAILURE);
+}
+
+const char *CommBufferFactory::getTypeName(CommBufferType type) {
+	switch (type) {
+		case PLAIN_BUFFER: return "Plain";
+		case PREPROCESSED_BUFFER: return "Preprocessed";
+		case INDEX_MAPPED_BUFFER: return "IndexMapped";
+		case SWIFT_INDEX_MAPPED_BUFFER: return "SwiftIndexMapped";
+	}
+	return "Unknown";
+}
+
+std::vector<CommBufferType> *CommBufferFactory::getApplicableTypes(long int elementCount,
+		SyncConfig *syncConfig, bool multiversioned) {
+
+	std::vector<CommBufferType> *types = new std::vector<CommBufferType>;
+
+	// the type the compiler used to choose statically is always tried first so that the program falls back to the
+	// old behavior when the adaptation is not worthwhile
+	if (multiversioned) {
+		types->push_back(SWIFT_INDEX_MAPPED_BUFFER);
+	} else {
+		types->push_back(PREPROCESSED_BUFFER);
+	}
+
+	// small exchanges do not benefit from any trial
+	if (elementCount < ADAPTIVE_BUFFER_ELEMENT_THRESHOLD) return types;
+
+	if (multiversioned) {
+		types->push_back(INDEX_MAPPED_BUFFER);
+	} else {
+		types->push_back(SWIFT_INDEX_MAPPED_BUFFER);
+		types->push_back(INDEX_MAPPED_BUFFER);
+	}
+
+	// A plain buffer does not restrict its search for data items to the confinement container. That is fine as long
+	// as the sender and receiver sides use different data parts lists. When both sides share the same parts list,
+	// as in ghost region synchronizations, a plain buffer may pick a padded copy of a data item instead of the item
+	// from its owner part. So it is not considered in that case.
+	bool intraContainer = syncConfig->getConfinementConfig()->isIntraContrainerSync();
+	if (!intraContainer) {
+		types->push_back(PLAIN_BUFFER);
+	}
+	return types;
+}
+
+//--------------------------------------------------------- Adaptive Comm Buffer ----------------------------------------------------------/
+
+AdaptiveCommBuffer::AdaptiveCommBuffer(DataExchange *exchange,
+		SyncConfig *syncConfig,
+		bool multiversioned,
+		CommStatistics *commStat,
+		const char *dependencyName) : CommBuffer(exchange, syncConfig) {
+
+	this->syncConfig = syncConfig;
+	this->intraSegment = exchange->isIntraSegmentExchange(localSegmentTag);
+	this->commStat = commStat;
+	this->dependencyName = dependencyName;
+
+	candidateTypes = CommBufferFactory::getApplicableTypes(elementCount, syncConfig, multiversioned);
+	trialIndex = 0;
+	settled = false;
+	bestBuffer = NULL;
+	bestCost = 0;
+	externalData = NULL;
+	activeBuffer = NULL;
+	setupTrialBuffer();
+
+	// there is nothing to adapt when only the default buffer type is applicable
+	if (candidateTypes->size() == 1) {
+		settled = true;
+		commStat->recordBufferSelection(dependencyName, CommBufferFactory::getTypeName(activeType));
+	}
+}
+
+AdaptiveCommBuffer::~AdaptiveCommBuffer() {
+	disposeBuffer(activeBuffer);
+	if (bestBuffer != NULL && bestBuffer != activeBuffer) {
+		disposeBuffer(bestBuffer);
+	}
+	delete candidateTypes;
+}
+
+void AdaptiveCommBuffer::setData(char *data) {
+	externalData = data;
+	activeBuffer->setData(data);
+	if (bestBuffer != NULL && bestBuffer != activeBuffer) {
+		bestBuffer->setData(data);
+	}
+}
+
+void AdaptiveCommBuffer::readData(bool loggingEnabled, std::ostream &logFile) {
+
+	// a physical buffer used only for sending can be replaced only before the next read as its content is in use
+	// for the send until then
+	if (replacementPending) {
+		replaceTrialBuffer();
+	}
+
+	if (settled) {
+		activeBuffer->readData(loggingEnabled, logFile);
+		return;
+	}
+
+	struct timeval start;
+	gettimeofday(&start, NULL);
+	activeBuffer->readData(loggingEnabled, logFile);
+	struct timeval end;
+	gettimeofday(&end, NULL);
+
+	// for intra-segment buffers, the read completes the transfer; for physical buffers, the transfer is complete
+	// after the read only when the local segment does not receive any data from the exchange
+	if (intraSegment) {
+		recordTransfer(start, end);
+		if (replacementPending) replaceTrialBuffer();
+	} else if (!isReceiveActivated()) {
+		recordTransfer(start, end);
+	} else {
+		transferTime += ((end.tv_sec - start.tv_sec) + ((end.tv_usec - start.tv_usec) / 1000000.0));
+	}
+}
+
+void AdaptiveCommBuffer::writeData(bool loggingEnabled, std::ostream &logFile) {
+
+	if (settled || intraSegment) {
+		activeBuffer->writeData(loggingEnabled, logFile);
+		return;
+	}
+
+	struct timeval start;
+	gettimeofday(&start, NULL);
+	activeBuffer->writeData(loggingEnabled, logFile);
+	struct timeval end;
+	gettimeofday(&end, NULL);
+
+	// once the data has been written to the operating memory, the receiving buffer can be replaced right away
+	recordTransfer(start, end);
+	if (replacementPending) replaceTrialBuffer();
+}
+
+void AdaptiveCommBuffer::setupTrialBuffer() {
+
+	struct timeval start;
+	gettimeofday(&start, NULL);
+	activeType = candidateTypes->at(trialIndex);
+	activeBuffer = CommBufferFactory::createBuffer(activeType, dataExchange, syncConfig, intraSegment);
+	struct timeval end;
+	gettimeofday(&end, NULL);
+
+	// if the communicator has supplied the storage for data then the new buffer should use that storage instead of
+	// what it allocated for itself
+	if (!intraSegment && externalData != NULL) {
+		delete[] activeBuffer->getData();
+		activeBuffer->setData(externalData);
+	}
+
+	// the default buffer type's setup is already accounted for in the buffer setup time of the dependency by the
+	// generated code; so only the setups of the subsequent trial buffers are recorded separately
+	setupTime = ((end.tv_sec - start.tv_sec) + ((end.tv_usec - start.tv_usec) / 1000000.0));
+	if (trialIndex > 0) {
+		commStat->addBufferSetupTime(dependencyName, start, end);
+	}
+	transferTime = 0;
+	transfersDone = 0;
+	replacementPending = false;
+}
+
+void AdaptiveCommBuffer::recordTransfer(struct timeval &start, struct timeval &end) {
+
+	transfersDone++;
+
+	// the first transfer warms up the caches; so it is excluded from the timing
+	if (transfersDone == 1) {
+		transferTime = 0;
+		return;
+	}
+	transferTime += ((end.tv_sec - start.tv_sec) + ((end.tv_usec - start.tv_usec) / 1000000.0));
+	if (transfersDone < BUFFER_TRIAL_TRANSFERS) return;
+
+	double averageTransferTime = transferTime / (transfersDone - 1);
+	double cost = setupTime / BUFFER_SETUP_AMORTIZATION_TRANSFERS + averageTransferTime;
+	if (bestBuffer == NULL || cost < bestCost) {
+		if (bestBuffer != NULL) disposeBuffer(bestBuffer);
+		bestBuffer = activeBuffer;
+		bestType = activeType;
+		bestCost = cost;
+	}
+	replacementPending = true;
+}
+
+void AdaptiveCommBuffer::replaceTrialBuffer() {
+
+	// the current buffer may have been retained as the best so far; otherwise it is not needed anymore
+	if (activeBuffer != bestBuffer) {
+		disposeBuffer(activeBuffer);
+	}
+	trialIndex++;
+	if (trialIndex < candidateTypes->size()) {
+		setupTrialBuffer();
+	} else {
+		activeBuffer = bestBuffer;
+		activeType = bestType;
+		bestBuffer = NULL;
+		settled = true;
+		replacementPending = false;
+		commStat->recordBufferSelection(dependencyName, CommBufferFactory::getTypeName(activeType));
+	}
+}
+
+void AdaptiveCommBuffer::disposeBuffer(CommBuffer *buffer) {
+
+	// a buffer must not free the storage it does not own
+	if (!intraSegment && externalData != NULL) {
+		buffer->setData(NULL);
+	}
+	delete buffer;
+}
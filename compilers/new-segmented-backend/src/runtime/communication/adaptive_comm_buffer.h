@@ -0,0 +1,116 @@
+#ifndef _H_adaptive_comm_buffer
+#define _H_adaptive_comm_buffer
+
+/* The communication buffer variants of the comm_buffer.h library trade setup cost for transfer cost differently. A
+ * plain buffer needs no setup but searches the part hierarchy for each data item in each transfer. A preprocessed
+ * buffer saves the memory locations of data items upfront and an index-mapped buffer saves their part indexes; the
+ * swift index-mapped variant further groups consecutive items of the same part. Which option is the best depends on
+ * the size and shape of an exchange and on the number of times the exchange occurs, neither of which is known when
+ * the code is generated. So this library provides an adaptive communication buffer that tries the applicable buffer
+ * variants on the first few transfers of an exchange at runtime and settles on the cheapest one for the rest of the
+ * execution.
+ * */
+
+#include "comm_buffer.h"
+#include "comm_statistics.h"
+#include "confinement_mgmt.h"
+
+#include <iostream>
+#include <vector>
+
+// the variants of communication buffers; each variant has a virtual and a physical implementation in comm_buffer.h
+enum CommBufferType { PLAIN_BUFFER, PREPROCESSED_BUFFER, INDEX_MAPPED_BUFFER, SWIFT_INDEX_MAPPED_BUFFER };
+
+// the number of transfers each buffer variant is tried for before it is compared with others; the first transfer is
+// kept out of the average as it warms up the caches for the operating memory data parts
+const int BUFFER_TRIAL_TRANSFERS = 3;
+
+// buffer setup time is amortized over this many transfers when comparing buffer variants as the setup is done once
+// but transfers happen repeatedly in a typical IT program
+const int BUFFER_SETUP_AMORTIZATION_TRANSFERS = 100;
+
+// exchanges having fewer elements than this threshold are not worth the trial overhead; they stick to the default
+const int ADAPTIVE_BUFFER_ELEMENT_THRESHOLD = 64;
+
+/* a factory class for instantiating communication buffers of different variants */
+class CommBufferFactory {
+  public:
+	static CommBuffer *createBuffer(CommBufferType type,
+			DataExchange *exchange,
+			SyncConfig *syncConfig, bool intraSegment);
+	static const char *getTypeName(CommBufferType type);
+
+	// returns the buffer variants that are applicable for a data exchange in the preferred order of trial; data
+	// structures having multiple versions cannot use preprocessed buffers as they save locations of one version
+	static std::vector<CommBufferType> *getApplicableTypes(long int elementCount,
+			SyncConfig *syncConfig, bool multiversioned);
+};
+
+/* An adaptive communication buffer wraps an actual communication buffer and forwards all read/write requests to it.
+ * Until it settles on a buffer variant, it measures the setup time of the current variant and the time spent on its
+ * reads and writes; then replaces it with the next variant under trial. Note that a buffer variant can only be
+ * replaced when the data it holds is no longer needed, i.e., after the data has been written to the operating memory
+ * on the receiving side and before the next read on the sending side.
+ * */
+class AdaptiveCommBuffer : public CommBuffer {
+  protected:
+	SyncConfig *syncConfig;
+	bool intraSegment;
+
+	// the buffer variants to try and the index of the variant currently under trial
+	std::vector<CommBufferType> *candidateTypes;
+	int trialIndex;
+	bool settled;
+
+	// the buffer currently used for data transfers and the best buffer found so far
+	CommBuffer *activeBuffer;
+	CommBufferType activeType;
+	CommBuffer *bestBuffer;
+	CommBufferType bestType;
+	double bestCost;
+
+	// timing information for the buffer under trial
+	double setupTime;
+	double transferTime;
+	int transfersDone;
+	bool replacementPending;
+
+	// communicators that gather or scatter data for multiple buffers may provide the storage for a buffer; that
+	// storage should be passed on to each new buffer variant that replaces the current one
+	char *externalData;
+
+	// buffer selection decision and extra setup times are recorded in the communication statistics
+	CommStatistics *commStat;
+	const char *dependencyName;
+  public:
+	AdaptiveCommBuffer(DataExchange *exchange,
+			SyncConfig *syncConfig,
+			bool multiversioned,
+			CommStatistics *commStat, const char *dependencyName);
+	~AdaptiveCommBuffer();
+
+	char *getData() { return activeBuffer->getData(); }
+	void setData(char *data);
+	void readData(bool loggingEnabled, std::ostream &logFile);
+	void writeData(bool loggingEnabled, std::ostream &logFile);
+	bool intraSegmentBufferType() { return intraSegment; }
+
+	// partial writes would escape the timing of the buffer variants under trial; so they are allowed only after the
+	// buffer has settled on a variant
+	bool isPartialWriteSupported() { return settled && activeBuffer->isPartialWriteSupported(); }
+	void writeElements(long int firstElement, long int lastElement) {
+		activeBuffer->writeElements(firstElement, lastElement);
+	}
+	bool isSettled() { return settled; }
+	CommBufferType getActiveType() { return activeType; }
+  private:
+	// creates the buffer for the variant at the current trial index and times its setup
+	void setupTrialBuffer();
+	// concludes the trial of the current buffer variant when it has done enough transfers
+	void recordTransfer(struct timeval &start, struct timeval &end);
+	// moves on to the next variant or, if there is none left, settles on the best variant found
+	void replaceTrialBuffer();
+	void disposeBuffer(CommBuffer *buffer);
+};
+
+#endif
@@ -8,10 +8,30 @@
 
 #include <vector>
 #include <climits>
+#include <cstring>
 #include <mpi.h>
 
 using namespace std;
 
+//------------------------------------------------------- Incremental Buffer Writer -------------------------------------------------------/
+
+IncrementalBufferWriter::IncrementalBufferWriter(CommBuffer *buffer) {
+	this->buffer = buffer;
+	long int elementCount = buffer->getElementCount();
+	this->elementSize = (elementCount > 0) ? buffer->getBufferSize() / elementCount : 1;
+	this->elementsWritten = 0;
+}
+
+void IncrementalBufferWriter::processReceivedPrefix(long int bytesReceived) {
+	
+	// an element straddling the chunk boundary is written after the next chunk has arrived
+	long int elementsReceived = bytesReceived / elementSize;
+	if (elementsReceived > elementsWritten) {
+		buffer->writeElements(elementsWritten, elementsReceived);
+		elementsWritten = elementsReceived;
+	}
+}
+
 //------------------------------------------------------- Replication Sync Communicator -------------------------------------------------------/
 
 ReplicationSyncCommunicator::ReplicationSyncCommunicator(int localSegmentTag,
@@ -26,7 +46,9 @@ ReplicationSyncCommunicator::ReplicationSyncCommunicator(int localSegmentTag,
 	// segment to do communication for. Consequently, there should be exactly one communication buffer.
 	Assert(bufferList->NumElements() == 1);
 
-	this->commBufferList = bufferList;
+	setCommBufferList(bufferList);
+	this->knownSenderTag = INVALID_ID;
+	this->receivedDataWritten = false;
 }
 
 void ReplicationSyncCommunicator::sendData() {
@@ -38,21 +60,29 @@ void ReplicationSyncCommunicator::sendData() {
         int participants = segmentGroup->getParticipantsCount();
         int myRank = segmentGroup->getRank(localSegmentTag);
 
-        int bcastStatus = 1;
-        int bcastStatusList[participants];
-        int status = MPI_Allgather(&bcastStatus, 1, MPI_INT, bcastStatusList, 1, MPI_INT, mpiComm);
-        if (status != MPI_SUCCESS) {
-                cout << "Segment " << localSegmentTag << ": ";
-                cout << "could not inform others about being the broadcast source\n";
-                exit(EXIT_FAILURE);
-        }
+	// the other segments need to be informed about who is the broadcast source unless the program has already 
+	// supplied that information to all of them
+	if (knownSenderTag == INVALID_ID) {
+		int bcastStatus = 1;
+		int bcastStatusList[participants];
+		int status = MPI_Allgather(&bcastStatus, 1, MPI_INT, bcastStatusList, 1, MPI_INT, mpiComm);
+		if (status != MPI_SUCCESS) {
+			cout << "Segment " << localSegmentTag << ": ";
+			cout << "could not inform others about being the broadcast source\n";
+			exit(EXIT_FAILURE);
+		}
+	} else if (knownSenderTag != localSegmentTag) {
+		cout << "Segment " << localSegmentTag << ": sending replicated update while the known sender is ";
+		cout << "Segment " << knownSenderTag << "\n";
+		exit(EXIT_FAILURE);
+	}
 
 	CommBuffer *buffer = commBufferList->Nth(0);
 	long int bufferSize = buffer->getBufferSize();
 	char *data = buffer->getData();
 
-	status = MPI_Bcast(data, bufferSize, MPI_CHAR, myRank, mpiComm);
-        if (status != MPI_SUCCESS) {
+	PipelinedBroadcast broadcast(mpiComm, participants, myRank);
+	if (!broadcast.broadcast(data, bufferSize, myRank)) {
                 cout << "Segment " << localSegmentTag << ": could not broadcast replicated update\n";
                 exit(EXIT_FAILURE);
         }
@@ -68,22 +98,27 @@ void ReplicationSyncCommunicator::receiveData() {
 
 	MPI_Comm mpiComm = segmentGroup->getCommunicator();
         int participants = segmentGroup->getParticipantsCount();
-
-        int bcastStatus = 0;
-        int bcastStatusList[participants];
-        int status = MPI_Allgather(&bcastStatus, 1, MPI_INT, bcastStatusList, 1, MPI_INT, mpiComm);
-        if (status != MPI_SUCCESS) {
-                cout << "Segment " << localSegmentTag << ": could not find the broadcast source\n";
-                exit(EXIT_FAILURE);
-        }
+        int myRank = segmentGroup->getRank(localSegmentTag);
+	receivedDataWritten = false;
 
         int broadcaster = -1;
-        for (int i = 0; i < participants; i++) {
-                if (bcastStatusList[i] == 1) {
-                        broadcaster = i;
-                        break;
-                }
-        }
+	if (knownSenderTag != INVALID_ID) {
+		broadcaster = segmentGroup->getRank(knownSenderTag);
+	} else {
+		int bcastStatus = 0;
+		int bcastStatusList[participants];
+		int status = MPI_Allgather(&bcastStatus, 1, MPI_INT, bcastStatusList, 1, MPI_INT, mpiComm);
+		if (status != MPI_SUCCESS) {
+			cout << "Segment " << localSegmentTag << ": could not find the broadcast source\n";
+			exit(EXIT_FAILURE);
+		}
+		for (int i = 0; i < participants; i++) {
+			if (bcastStatusList[i] == 1) {
+				broadcaster = i;
+				break;
+			}
+		}
+	}
         if (broadcaster == -1) {
                 cout << "Segment " << localSegmentTag << ": none is making the broadcast\n";
 	} else {
@@ -91,11 +126,20 @@ void ReplicationSyncCommunicator::receiveData() {
 		long int bufferSize = buffer->getBufferSize();
 		char *data = buffer->getData();
 
-		status = MPI_Bcast(data, bufferSize, MPI_CHAR, broadcaster, mpiComm);
-		if (status != MPI_SUCCESS) {
+		// if the buffer allows then its elements are written to the operating memory as they arrive
+		IncrementalBufferWriter *writer = NULL;
+		if (buffer->isPartialWriteSupported()) {
+			writer = new IncrementalBufferWriter(buffer);
+		}
+		PipelinedBroadcast broadcast(mpiComm, participants, myRank);
+		if (!broadcast.broadcast(data, bufferSize, broadcaster, writer)) {
 			cout << "Segment " << localSegmentTag << ": did not receive broadcast of replicated data\n";
 			exit(EXIT_FAILURE);
 		}
+		if (writer != NULL) {
+			receivedDataWritten = true;
+			delete writer;
+		}
 	}
 	
 	//*logFile << "\tReplication-sync communicator received data for " << dependencyName << "\n";
@@ -129,7 +173,44 @@ GhostRegionSyncCommunicator::GhostRegionSyncCommunicator(int localSegmentTag,
 		}
 	}
 
-	this->commBufferList = bufferList;
+	setCommBufferList(bufferList);
+	this->intraSegmentCommunicator = false;
+	this->transportConfigured = false;
+	this->offNodeSendBuffers = NULL;
+	this->offNodeReceiveBuffers = NULL;
+	this->nodeLocalSendBuffers = NULL;
+	this->nodeLocalReceiveBuffers = NULL;
+	this->sendChannels = NULL;
+	this->receiveChannels = NULL;
+	this->channelNamesUnlinked = false;
+	this->offNodeTransferInParallel = false;
+	this->offNodePeerCount = 0;
+}
+
+GhostRegionSyncCommunicator::~GhostRegionSyncCommunicator() {
+	if (!transportConfigured) return;
+
+	// the contents of the buffers received through shared memory live in the regions of the channels; so they are
+	// detached from the buffers before the regions are unmapped
+	for (int i = 0; i < nodeLocalReceiveBuffers->NumElements(); i++) {
+		nodeLocalReceiveBuffers->Nth(i)->setData(NULL);
+	}
+	while (receiveChannels->NumElements() > 0) {
+		SharedMemoryChannel *channel = receiveChannels->Nth(0);
+		receiveChannels->RemoveAt(0);
+		delete channel;
+	}
+	while (sendChannels->NumElements() > 0) {
+		SharedMemoryChannel *channel = sendChannels->Nth(0);
+		sendChannels->RemoveAt(0);
+		delete channel;
+	}
+	delete receiveChannels;
+	delete sendChannels;
+	delete offNodeSendBuffers;
+	delete offNodeReceiveBuffers;
+	delete nodeLocalSendBuffers;
+	delete nodeLocalReceiveBuffers;
 }
 
 void GhostRegionSyncCommunicator::setupCommunicator(bool includeNonInteractingSegments) {
@@ -147,37 +228,21 @@ void GhostRegionSyncCommunicator::performTransfer() {
 	//*logFile << "\tGhost-sync communicator is communicating data for " << dependencyName << "\n";
 	//logFile->flush();
 
-	// retrieve all buffers holding data for cross-segment communication	
-	List<CommBuffer*> *localBufferList = new List<CommBuffer*>;
-	List<CommBuffer*> *remoteBufferList = new List<CommBuffer*>;
-	seperateLocalAndRemoteBuffers(localSegmentTag, localBufferList, remoteBufferList);
-	delete localBufferList;
-
 	// if there is no cross-segment communication buffer then there is nothing to do here
-	if (remoteBufferList->NumElements() == 0) {
-                delete remoteBufferList;
-		intraSegmentCommunicator = true;
-                return;
-        }
+	if (!prepareTransport()) return;
 
 	MPI_Comm mpiComm = segmentGroup->getCommunicator();
-        int participants = segmentGroup->getParticipantsCount();
-        int myRank = segmentGroup->getRank(localSegmentTag);
 
-	// first set up the receiver buffers
-	List<CommBuffer*> *remoteReceiveBuffers = getSortedList(true, remoteBufferList);
-	int remoteRecvs = remoteReceiveBuffers->NumElements();
+	// first set up the receiver buffers; note that if the sender PPUs have already exchanged the off-node buffers in 
+	// parallel then only the node-local transfers remain to be done here
+	List<CommBuffer*> *remoteReceiveBuffers = offNodeReceiveBuffers;
+	int remoteRecvs = (offNodeTransferInParallel) ? 0 : remoteReceiveBuffers->NumElements();
 	MPI_Request *recvRequests = new MPI_Request[remoteRecvs];
 	for (int i = 0; i < remoteRecvs ; i++) {
 		CommBuffer *buffer = remoteReceiveBuffers->Nth(i);
 		long int bufferSize = buffer->getBufferSize();
 		char *data = buffer->getData();
-		DataExchange *exchange = buffer->getExchange();
-		Participant *sender = exchange->getSender();
-		vector<int> senderTags = sender->getSegmentTags();
-		Assert(senderTags.size() == 1);
-		int senderSegment = senderTags[0];
-		Assert(senderSegment != localSegmentTag);
+		int senderSegment = getPeerSegment(buffer, true);
 		int senderRank = segmentGroup->getRank(senderSegment);	
 		int status = MPI_Irecv(data, bufferSize, MPI_CHAR, senderRank, 0, mpiComm, &recvRequests[i]);
                 if (status != MPI_SUCCESS) {
@@ -186,21 +251,35 @@ void GhostRegionSyncCommunicator::performTransfer() {
 		}
 	}
 
+	// Co-located senders write directly into the shared memory regions of the receive buffers. Before they can do
+	// that, the current segment must tell them that the regions' content from the last transfer has already been 
+	// written to the operating memory. Then the current segment waits for the senders' notification that the new
+	// content is in place. 
+	int localRecvs = nodeLocalReceiveBuffers->NumElements();
+	MPI_Request *readyRequests = new MPI_Request[localRecvs];
+	MPI_Request *doneRequests = new MPI_Request[localRecvs];
+	for (int i = 0; i < localRecvs; i++) {
+		CommBuffer *buffer = nodeLocalReceiveBuffers->Nth(i);
+		int senderRank = segmentGroup->getRank(getPeerSegment(buffer, true));
+		int status = MPI_Irecv(NULL, 0, MPI_CHAR, senderRank, SHM_DONE_TAG, mpiComm, &doneRequests[i]);
+		if (status == MPI_SUCCESS) {
+			status = MPI_Isend(NULL, 0, MPI_CHAR, senderRank, SHM_READY_TAG, mpiComm, &readyRequests[i]);
+		}
+                if (status != MPI_SUCCESS) {
+                	cout << "Segment " << localSegmentTag << ": could not initiate a shared memory transfer\n";
+			exit(EXIT_FAILURE);
+		}
+	}
 
 	// then do the sends
-	List<CommBuffer*> *remoteSendBuffers = getSortedList(false, remoteBufferList);
-	int remoteSends = remoteSendBuffers->NumElements();
+	List<CommBuffer*> *remoteSendBuffers = offNodeSendBuffers;
+	int remoteSends = (offNodeTransferInParallel) ? 0 : remoteSendBuffers->NumElements();
 	MPI_Request *sendRequests = new MPI_Request[remoteSends];
 	for (int i = 0; i < remoteSends; i++) {
 		CommBuffer *buffer = remoteSendBuffers->Nth(i);
 		long int bufferSize = buffer->getBufferSize();
 		char *data = buffer->getData();
-		DataExchange *exchange = buffer->getExchange();
-		Participant *receiver = exchange->getReceiver();
-		vector<int> receiverTags = receiver->getSegmentTags();
-		Assert(receiverTags.size() == 1);
-		int receiverSegment = receiverTags[0];
-		Assert(receiverSegment != localSegmentTag);
+		int receiverSegment = getPeerSegment(buffer, false);
 		int receiverRank = segmentGroup->getRank(receiverSegment);	
 		int status = MPI_Isend(data, bufferSize, MPI_CHAR, receiverRank, 0, mpiComm, &sendRequests[i]);
                 if (status != MPI_SUCCESS) {
@@ -209,6 +288,50 @@ void GhostRegionSyncCommunicator::performTransfer() {
 		}
 	}
 
+	// copy the content of send buffers into co-located receivers' shared memory regions as they become ready
+	int localSends = nodeLocalSendBuffers->NumElements();
+	if (localSends > 0) {
+		MPI_Request *readyWaits = new MPI_Request[localSends];
+		MPI_Request *notifications = new MPI_Request[localSends];
+		for (int i = 0; i < localSends; i++) {
+			CommBuffer *buffer = nodeLocalSendBuffers->Nth(i);
+			int receiverRank = segmentGroup->getRank(getPeerSegment(buffer, false));
+			int status = MPI_Irecv(NULL, 0, MPI_CHAR, 
+					receiverRank, SHM_READY_TAG, mpiComm, &readyWaits[i]);
+			if (status != MPI_SUCCESS) {
+				cout << "Segment " << localSegmentTag << ": could not wait for a shared memory region\n";
+				exit(EXIT_FAILURE);
+			}
+		}
+		for (int i = 0; i < localSends; i++) {
+			int index;
+			int status = MPI_Waitany(localSends, readyWaits, &index, MPI_STATUS_IGNORE);
+			if (status != MPI_SUCCESS || index == MPI_UNDEFINED) {
+				cout << "Segment " << localSegmentTag << ": shared memory handshake failed\n";
+				exit(EXIT_FAILURE);
+			}
+			CommBuffer *buffer = nodeLocalSendBuffers->Nth(index);
+			SharedMemoryChannel *channel = sendChannels->Nth(index);
+			char *region = channel->getRegion();
+			if (region == NULL) region = channel->attach();
+			memcpy(region, buffer->getData(), buffer->getBufferSize());
+			__sync_synchronize();
+			int receiverRank = segmentGroup->getRank(getPeerSegment(buffer, false));
+			status = MPI_Isend(NULL, 0, MPI_CHAR, receiverRank, SHM_DONE_TAG, mpiComm, &notifications[index]);
+			if (status != MPI_SUCCESS) {
+				cout << "Segment " << localSegmentTag << ": could not notify a shared memory transfer\n";
+				exit(EXIT_FAILURE);
+			}
+		}
+		int status = MPI_Waitall(localSends, notifications, MPI_STATUSES_IGNORE);
+		if (status != MPI_SUCCESS) {
+			cout << "Segment " << localSegmentTag << ": some shared memory notifications failed\n";
+			exit(EXIT_FAILURE);
+		}
+		delete[] readyWaits;
+		delete[] notifications;
+	}
+
 	// wait for all receives to finish and write data back to operating memory from receive buffers
 	int status = MPI_Waitall(remoteRecvs, recvRequests, MPI_STATUSES_IGNORE);
 	if (status != MPI_SUCCESS) {
@@ -216,6 +339,25 @@ void GhostRegionSyncCommunicator::performTransfer() {
 		exit(EXIT_FAILURE);
 	}
 
+	// wait for the co-located senders to finish updating the shared memory regions
+	if (localRecvs > 0) {
+		status = MPI_Waitall(localRecvs, doneRequests, MPI_STATUSES_IGNORE);
+		if (status == MPI_SUCCESS) {
+			status = MPI_Waitall(localRecvs, readyRequests, MPI_STATUSES_IGNORE);
+		}
+		if (status != MPI_SUCCESS) {
+			cout << "Segment "<< localSegmentTag << ": some of the shared memory transfers failed\n";
+			exit(EXIT_FAILURE);
+		}
+		__sync_synchronize();
+		if (!channelNamesUnlinked) {
+			for (int i = 0; i < receiveChannels->NumElements(); i++) {
+				receiveChannels->Nth(i)->unlinkName();
+			}
+			channelNamesUnlinked = true;
+		}
+	}
+
 	// wait for all sends to finish
 	status = MPI_Waitall(remoteSends, sendRequests, MPI_STATUSES_IGNORE);
 	if (status != MPI_SUCCESS) {
@@ -224,16 +366,204 @@ void GhostRegionSyncCommunicator::performTransfer() {
 	}
 
 	// cleanup data structures before returning
- 	delete remoteBufferList;
-	delete remoteSendBuffers;
-	delete remoteReceiveBuffers;
 	delete[] recvRequests;
 	delete[] sendRequests;
+	delete[] readyRequests;
+	delete[] doneRequests;
 	
 	//*logFile << "\tGhost-sync communicator sent-received data for " << dependencyName << "\n";
 	//logFile->flush();
 }	
 
+bool GhostRegionSyncCommunicator::shouldSendInParallel(int participantsCount) {
+	if (!prepareTransport()) return false;
+	offNodeTransferInParallel = MpiThreadSupport::isMultithreaded() 
+			&& participantsCount > 1 && offNodePeerCount > 1;
+	return offNodeTransferInParallel;
+}
+
+void GhostRegionSyncCommunicator::sendDataInParallel(int currentPpuOrder, int participantsCount) {
+
+	MPI_Comm mpiComm = segmentGroup->getCommunicator();
+
+	// issue receives for the buffers coming from the peers assigned to the current PPU
+	List<MPI_Request> *requests = new List<MPI_Request>;
+	for (int i = 0; i < offNodeReceiveBuffers->NumElements(); i++) {
+		if (offNodeReceivePeerOrders[i] % participantsCount != currentPpuOrder) continue;
+		CommBuffer *buffer = offNodeReceiveBuffers->Nth(i);
+		int senderRank = segmentGroup->getRank(getPeerSegment(buffer, true));
+		MPI_Request request;	
+		int status = MPI_Irecv(buffer->getData(), buffer->getBufferSize(), 
+				MPI_CHAR, senderRank, 0, mpiComm, &request);
+                if (status != MPI_SUCCESS) {
+                	cout << "Segment " << localSegmentTag << ": could not issue asynchronous receive\n";
+			exit(EXIT_FAILURE);
+		}
+		requests->Append(request);
+	}
+
+	// then issue the sends to those peers
+	for (int i = 0; i < offNodeSendBuffers->NumElements(); i++) {
+		if (offNodeSendPeerOrders[i] % participantsCount != currentPpuOrder) continue;
+		CommBuffer *buffer = offNodeSendBuffers->Nth(i);
+		int receiverRank = segmentGroup->getRank(getPeerSegment(buffer, false));
+		MPI_Request request;	
+		int status = MPI_Isend(buffer->getData(), buffer->getBufferSize(), 
+				MPI_CHAR, receiverRank, 0, mpiComm, &request);
+                if (status != MPI_SUCCESS) {
+                	cout << "Segment " << localSegmentTag << ": could not issue asynchronous send\n";
+			exit(EXIT_FAILURE);
+		}
+		requests->Append(request);
+	}
+
+	int requestCount = requests->NumElements();
+	if (requestCount > 0) {
+		MPI_Request *requestArray = new MPI_Request[requestCount];
+		for (int i = 0; i < requestCount; i++) requestArray[i] = requests->Nth(i);
+		int status = MPI_Waitall(requestCount, requestArray, MPI_STATUSES_IGNORE);
+		if (status != MPI_SUCCESS) {
+			cout << "Segment " << localSegmentTag << ": some of the asynchronous transfers failed\n";
+			exit(EXIT_FAILURE);
+		}
+		delete[] requestArray;
+	}
+	delete requests;
+}
+
+bool GhostRegionSyncCommunicator::prepareTransport() {
+
+	if (intraSegmentCommunicator) return false;
+	if (transportConfigured) return true;
+
+	// retrieve all buffers holding data for cross-segment communication	
+	List<CommBuffer*> *localBufferList = new List<CommBuffer*>;
+	List<CommBuffer*> *remoteBufferList = new List<CommBuffer*>;
+	seperateLocalAndRemoteBuffers(localSegmentTag, localBufferList, remoteBufferList);
+	delete localBufferList;
+
+	if (remoteBufferList->NumElements() == 0) {
+                delete remoteBufferList;
+		intraSegmentCommunicator = true;
+                return false;
+        }
+
+	// the division of buffers between MPI and shared memory transports does not change from one use of the 
+	// communicator to the next
+	configureTransport(remoteBufferList);
+	delete remoteBufferList;
+	return true;
+}
+
+void GhostRegionSyncCommunicator::configureTransport(List<CommBuffer*> *remoteBufferList) {
+
+	List<CommBuffer*> *remoteReceiveBuffers = getSortedList(true, remoteBufferList);
+	List<CommBuffer*> *remoteSendBuffers = getSortedList(false, remoteBufferList);
+	offNodeReceiveBuffers = new List<CommBuffer*>;
+	offNodeSendBuffers = new List<CommBuffer*>;
+	nodeLocalReceiveBuffers = new List<CommBuffer*>;
+	nodeLocalSendBuffers = new List<CommBuffer*>;
+	receiveChannels = new List<SharedMemoryChannel*>;
+	sendChannels = new List<SharedMemoryChannel*>;
+
+	// Shared memory regions are identified by the sender-receiver pair and the order of the buffer among the buffers
+	// exchanged by the pair. This order is the same in both segments as the MPI message matching relies on it too.
+	std::vector<int> peers;
+	std::vector<int> peerBufferCounts;
+	bool useSharedMemory = NodeTopology::isEnabled();
+
+	for (int i = 0; i < remoteReceiveBuffers->NumElements(); i++) {
+		CommBuffer *buffer = remoteReceiveBuffers->Nth(i);
+		int senderSegment = getPeerSegment(buffer, true);
+		if (!useSharedMemory || !NodeTopology::isCoLocated(senderSegment)) {
+			offNodeReceiveBuffers->Append(buffer);
+			continue;
+		}
+		int peerIndex = binsearch::locateKey(peers, senderSegment);
+		if (peerIndex == KEY_NOT_FOUND) {
+			peerIndex = binsearch::locatePointOfInsert(peers, senderSegment);
+			peers.insert(peers.begin() + peerIndex, senderSegment);
+			peerBufferCounts.insert(peerBufferCounts.begin() + peerIndex, 0);
+		}
+		int bufferIndex = peerBufferCounts[peerIndex];
+		peerBufferCounts[peerIndex] = bufferIndex + 1;
+
+		// the receive buffer's content lives in the shared memory region so that the sender can update it directly;
+		// the buffer's own allocation is therefore released before it is bound to the region
+		SharedMemoryChannel *channel = new SharedMemoryChannel(communicatorId,
+				senderSegment, localSegmentTag, bufferIndex, buffer->getBufferSize());
+		delete[] buffer->getData();
+		buffer->setData(channel->create());
+		nodeLocalReceiveBuffers->Append(buffer);
+		receiveChannels->Append(channel);
+	}
+
+	peers.clear();
+	peerBufferCounts.clear();
+	for (int i = 0; i < remoteSendBuffers->NumElements(); i++) {
+		CommBuffer *buffer = remoteSendBuffers->Nth(i);
+		int receiverSegment = getPeerSegment(buffer, false);
+		if (!useSharedMemory || !NodeTopology::isCoLocated(receiverSegment)) {
+			offNodeSendBuffers->Append(buffer);
+			continue;
+		}
+		int peerIndex = binsearch::locateKey(peers, receiverSegment);
+		if (peerIndex == KEY_NOT_FOUND) {
+			peerIndex = binsearch::locatePointOfInsert(peers, receiverSegment);
+			peers.insert(peers.begin() + peerIndex, receiverSegment);
+			peerBufferCounts.insert(peerBufferCounts.begin() + peerIndex, 0);
+		}
+		int bufferIndex = peerBufferCounts[peerIndex];
+		peerBufferCounts[peerIndex] = bufferIndex + 1;
+
+		// the sender attaches to the receiver's region when the receiver signals for the first time that the region
+		// is ready to be updated
+		SharedMemoryChannel *channel = new SharedMemoryChannel(communicatorId, 
+				localSegmentTag, receiverSegment, bufferIndex, buffer->getBufferSize());
+		nodeLocalSendBuffers->Append(buffer);
+		sendChannels->Append(channel);
+	}
+
+	// determine the ordinals of the off-node peers for dividing MPI transfers among PPUs
+	std::vector<int> offNodePeers;
+	for (int i = 0; i < offNodeReceiveBuffers->NumElements(); i++) {
+		binsearch::insertIfNotExist(&offNodePeers, getPeerSegment(offNodeReceiveBuffers->Nth(i), true));
+	}
+	for (int i = 0; i < offNodeSendBuffers->NumElements(); i++) {
+		binsearch::insertIfNotExist(&offNodePeers, getPeerSegment(offNodeSendBuffers->Nth(i), false));
+	}
+	offNodePeerCount = offNodePeers.size();
+	for (int i = 0; i < offNodeReceiveBuffers->NumElements(); i++) {
+		int peer = getPeerSegment(offNodeReceiveBuffers->Nth(i), true);
+		offNodeReceivePeerOrders.push_back(binsearch::locateKey(offNodePeers, peer));
+	}
+	for (int i = 0; i < offNodeSendBuffers->NumElements(); i++) {
+		int peer = getPeerSegment(offNodeSendBuffers->Nth(i), false);
+		offNodeSendPeerOrders.push_back(binsearch::locateKey(offNodePeers, peer));
+	}
+
+	if (nodeLocalReceiveBuffers->NumElements() > 0 || nodeLocalSendBuffers->NumElements() > 0) {
+		*logFile << "\tGhost-sync communicator for " << dependencyName << " uses shared memory for ";
+		*logFile << nodeLocalSendBuffers->NumElements() << " sends and ";
+		*logFile << nodeLocalReceiveBuffers->NumElements() << " receives\n";
+		logFile->flush();
+	}
+
+	delete remoteReceiveBuffers;
+	delete remoteSendBuffers;
+	transportConfigured = true;
+}
+
+int GhostRegionSyncCommunicator::getPeerSegment(CommBuffer *buffer, bool forReceive) {
+	DataExchange *exchange = buffer->getExchange();
+	Participant *peer = (forReceive) ? exchange->getSender() : exchange->getReceiver();
+	vector<int> peerTags = peer->getSegmentTags();
+	Assert(peerTags.size() == 1);
+	int peerSegment = peerTags[0];
+	Assert(peerSegment != localSegmentTag);
+	return peerSegment;
+}
+
 //----------------------------------------------------------- Up Sync Communicator ------------------------------------------------------------/
 
 UpSyncCommunicator::UpSyncCommunicator(int localSegmentTag,
@@ -259,7 +589,7 @@ UpSyncCommunicator::UpSyncCommunicator(int localSegmentTag,
 	displacements = NULL;
 	receiveCounts = NULL;
 
-	this->commBufferList = bufferList;
+	setCommBufferList(bufferList);
 }
 
 UpSyncCommunicator::~UpSyncCommunicator() {
@@ -447,6 +777,8 @@ DownSyncCommunicator::DownSyncCommunicator(int localSegmentTag,
 			dependencyName, localSenderPpus, localReceiverPpus) {
 
 	this->replicated = false;	
+	this->knownSenderTag = INVALID_ID;
+	this->receivedDataWritten = false;
 	for (int i = 0; i < bufferList->NumElements(); i++) {
 		CommBuffer *buffer = bufferList->Nth(i);
 		Participant *sender = buffer->getExchange()->getSender();
@@ -461,7 +793,7 @@ DownSyncCommunicator::DownSyncCommunicator(int localSegmentTag,
 	sendCounts = NULL;
 	displacements = NULL;
 
-	this->commBufferList = bufferList;
+	setCommBufferList(bufferList);
 }
 
 DownSyncCommunicator::~DownSyncCommunicator() {
@@ -527,20 +859,22 @@ void DownSyncCommunicator::sendData() {
 	int myRank = segmentGroup->getRank(localSegmentTag);
 
 	// in the replicated mode, set up the broadcaster ID in the receivers before the actual data communication can take place
-	if (replicated) discoverSender(true);
+	// unless the program has supplied the current sender to all segments
+	if (replicated && knownSenderTag == INVALID_ID) discoverSender(true);
 
 	if (commMode == BROADCAST) {
 
 		// in the broadcast transfer mode there is just one buffer content to communicate
 		CommBuffer *buffer = commBufferList->Nth(0);
 
-		// issue the MPI broadcast only when there are some other segments waiting to receive the data
+		// issue the broadcast only when there are some other segments waiting to receive the data
 		DataExchange *exchange = buffer->getExchange();
 		if (!exchange->isIntraSegmentExchange(localSegmentTag)) {
 			char *data = buffer->getData();
 			long int bufferSize = buffer->getBufferSize();
-			int status = MPI_Bcast(data, bufferSize, MPI_CHAR, myRank, mpiComm);
-			if (status != MPI_SUCCESS) {
+			int participants = segmentGroup->getParticipantsCount();
+			PipelinedBroadcast broadcast(mpiComm, participants, myRank);
+			if (!broadcast.broadcast(data, bufferSize, myRank)) {
 				cout << "Segment " << localSegmentTag;
 				cout << ": could not broadcast update to lower level LPS\n";
 				exit(EXIT_FAILURE);
@@ -578,15 +912,29 @@ void DownSyncCommunicator::receiveData() {
 	
 	// in the replicated mode, retrieve the broadcaster ID before the actual data communication can take place
 	if (replicated) {
-		sender = discoverSender(false);
+		if (knownSenderTag != INVALID_ID) {
+			sender = segmentGroup->getRank(knownSenderTag);
+		} else sender = discoverSender(false);
 	}
 	
+	receivedDataWritten = false;
 	if (commMode == BROADCAST) {
-		int status = MPI_Bcast(data, bufferSize, MPI_CHAR, sender, mpiComm);
-		if (status != MPI_SUCCESS) {
+		// if the buffer allows then its elements are written to the operating memory as they arrive
+		IncrementalBufferWriter *writer = NULL;
+		if (buffer->isPartialWriteSupported()) {
+			writer = new IncrementalBufferWriter(buffer);
+		}
+		int participants = segmentGroup->getParticipantsCount();
+		int myRank = segmentGroup->getRank(localSegmentTag);
+		PipelinedBroadcast broadcast(mpiComm, participants, myRank);
+		if (!broadcast.broadcast(data, bufferSize, sender, writer)) {
 			cout << "Segment " << localSegmentTag << ": did not receive broadcast update on down-sync\n";
 			exit(EXIT_FAILURE);
 		}
+		if (writer != NULL) {
+			receivedDataWritten = true;
+			delete writer;
+		}
 	} else {
 		int status = MPI_Scatterv(NULL, NULL, NULL, MPI_CHAR, data, bufferSize, MPI_CHAR, sender, mpiComm);
                 if (status != MPI_SUCCESS) {
@@ -735,7 +1083,9 @@ CrossSyncCommunicator::CrossSyncCommunicator(int localSegmentTag,
 		: Communicator(localSegmentTag, 
 			dependencyName, localSenderPpus, localReceiverPpus) {
 
-	this->commBufferList = bufferList;
+	setCommBufferList(bufferList);
+	this->sendInParallel = false;
+	this->receiveInParallel = false;
 }
 
 void CrossSyncCommunicator::setupCommunicator(bool includeNonInteractingSegments) {
@@ -746,7 +1096,19 @@ void CrossSyncCommunicator::setupCommunicator(bool includeNonInteractingSegments
 	logFile->flush();
 }
  
-void CrossSyncCommunicator::sendData() {
+bool CrossSyncCommunicator::shouldSendInParallel(int participantsCount) {
+	sendInParallel = MpiThreadSupport::isMultithreaded() 
+			&& participantsCount > 1 && getDistinctBufferTagsCount() > 1;
+	return sendInParallel;
+}
+
+bool CrossSyncCommunicator::shouldReceiveInParallel(int participantsCount) {
+	receiveInParallel = MpiThreadSupport::isMultithreaded() 
+			&& participantsCount > 1 && getDistinctBufferTagsCount() > 1;
+	return receiveInParallel;
+}
+
+void CrossSyncCommunicator::sendData(int currentPpuOrder, int participantsCount) {
 
 	//*logFile << "\tCross-sync communicator is sending (and receiving) data for " << dependencyName << "\n";
 	//logFile->flush();
@@ -759,6 +1121,11 @@ void CrossSyncCommunicator::sendData() {
 	// local buffers' content will be written into the operating memory during the post processing operation
 	delete localBuffers;
 
+	// only retain the remote buffers the current PPU is responsible for
+	List<CommBuffer*> *allRemoteBuffers = remoteBuffers;
+	remoteBuffers = getAssignedBuffers(allRemoteBuffers, currentPpuOrder, participantsCount);
+	delete allRemoteBuffers;
+
 	// issue asynchronous receives first, when applicable
 	MPI_Request *receiveRequests = NULL;
 	// Note that in some receiver buffers, the current segment may be listed as sender among the group of possible senders. This 
@@ -849,7 +1216,7 @@ void CrossSyncCommunicator::sendData() {
 	//logFile->flush();
 }
 
-void CrossSyncCommunicator::receiveData() {
+void CrossSyncCommunicator::receiveData(int currentPpuOrder, int participantsCount) {
 
 	//*logFile << "\tCross-sync communicator is waiting for data for " << dependencyName << "\n";
 	//logFile->flush();
@@ -860,6 +1227,11 @@ void CrossSyncCommunicator::receiveData() {
 	
 	// local buffers has been taken care of in the sendData() function
 	delete localBuffers;
+
+	// only retain the remote buffers the current PPU is responsible for
+	List<CommBuffer*> *allRemoteBuffers = remoteBuffers;
+	remoteBuffers = getAssignedBuffers(allRemoteBuffers, currentPpuOrder, participantsCount);
+	delete allRemoteBuffers;
 	
 	// issue asynchronous receives
 	MPI_Request *receiveRequests = NULL;
@@ -907,3 +1279,32 @@ MPI_Request *CrossSyncCommunicator::issueAsyncReceives(List<CommBuffer*> *remote
 	return receiveRequests;
 }
 
+List<CommBuffer*> *CrossSyncCommunicator::getAssignedBuffers(List<CommBuffer*> *bufferList,
+		int currentPpuOrder, int participantsCount) {
+	
+	List<CommBuffer*> *assignedBuffers = new List<CommBuffer*>;
+	if (participantsCount == 1) {
+		assignedBuffers->AppendAll(bufferList);
+		return assignedBuffers;
+	}
+	getDistinctBufferTagsCount();
+	for (int i = 0; i < bufferList->NumElements(); i++) {
+		CommBuffer *buffer = bufferList->Nth(i);
+		int tagOrder = binsearch::locateKey(distinctBufferTags, buffer->getBufferTag());
+		if (tagOrder % participantsCount == currentPpuOrder) {
+			assignedBuffers->Append(buffer);
+		}
+	}
+	return assignedBuffers;
+}
+
+int CrossSyncCommunicator::getDistinctBufferTagsCount() {
+	
+	// buffer tags are assigned after the communicator has been created; so the distinct tags are determined lazily
+	if (distinctBufferTags.empty()) {
+		for (int i = 0; i < commBufferList->NumElements(); i++) {
+			binsearch::insertIfNotExist(&distinctBufferTags, commBufferList->Nth(i)->getBufferTag());
+		}
+	}
+	return distinctBufferTags.size();
+}
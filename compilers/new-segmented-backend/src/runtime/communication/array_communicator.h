@@ -6,6 +6,8 @@
 
 #include "comm_buffer.h"
 #include "communicator.h"
+#include "shm_transport.h"
+#include "pipelined_broadcast.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/binary_search.h"
@@ -19,8 +21,25 @@ enum CommMode {	BROADCAST,
 		UNKNOWN_COLLECTIVE
 };
 
+// a chunk handler for pipelined broadcasts that writes the elements of a communication buffer to the operating memory
+// as soon as they have been received
+class IncrementalBufferWriter : public BroadcastChunkHandler {
+  private:
+	CommBuffer *buffer;
+	long int elementSize;
+	long int elementsWritten;
+  public:
+	IncrementalBufferWriter(CommBuffer *buffer);
+	void processReceivedPrefix(long int bytesReceived);
+};
+
 // communicator class for the scenario of synchronization a replicated data among the LPUs for a single LPS 
 class ReplicationSyncCommunicator : public Communicator {
+  private:
+	// the sender segment supplied by the program for the subsequent transfers, if known
+	int knownSenderTag;
+	// a flag indicating that the received data has already been written to the operating memory during the broadcast
+	bool receivedDataWritten;
   public:
 	ReplicationSyncCommunicator(int localSegmentTag, 
 		const char *dependencyName, 
@@ -28,6 +47,12 @@ class ReplicationSyncCommunicator : public Communicator {
 
 	void sendData();
         void receiveData();
+	void setKnownSender(int senderSegmentTag) { knownSenderTag = senderSegmentTag; }
+
+	// the receive buffer is written only if that has not been done while the data was arriving
+	void perfromRecvPostprocessing(int currentPpuOrder, int participantsCount) {
+		if (!receivedDataWritten) processBuffersAfterReceive(currentPpuOrder, participantsCount);
+	}
 	
 	// sender should not wait on receive; this override ensures that
 	void afterSend() { iterationNo++; }
@@ -39,10 +64,32 @@ class GhostRegionSyncCommunicator : public Communicator {
 	// some ineffective computations can be skipped if the communicator only exchanges data among parts local to the
 	// current segment
 	bool intraSegmentCommunicator;	
+
+	// Buffers exchanged with segments running in the same node use shared memory channels instead of MPI messages.
+	// These lists are populated the first time the communicator transfers data; the lists for buffers exchanged
+	// with other nodes retain the sorted order needed to match MPI sends and receives.
+	bool transportConfigured;
+	List<CommBuffer*> *offNodeSendBuffers;
+	List<CommBuffer*> *offNodeReceiveBuffers;
+	List<CommBuffer*> *nodeLocalSendBuffers;
+	List<CommBuffer*> *nodeLocalReceiveBuffers;
+	List<SharedMemoryChannel*> *sendChannels;
+	List<SharedMemoryChannel*> *receiveChannels;
+	// the names of the shared memory regions are removed after the first transfer as the peers have attached them
+	bool channelNamesUnlinked;
+
+	// When MPI allows concurrent calls from multiple threads, the buffers exchanged with other nodes are divided among 
+	// the sender PPUs. All buffers exchanged with a particular segment are assigned to the same PPU as the MPI message
+	// matching relies on their order. So the division is done on the ordinals of the peer segments.
+	bool offNodeTransferInParallel;
+	int offNodePeerCount;
+	std::vector<int> offNodeSendPeerOrders;
+	std::vector<int> offNodeReceivePeerOrders;
   public:
 	GhostRegionSyncCommunicator(int localSegmentTag, 
 		const char *dependencyName, 
 		int localSenderPpus, int localReceiverPpus, List<CommBuffer*> *bufferList);
+	~GhostRegionSyncCommunicator();
 
 	// ghost region sync does not need a new MPI communicator; this this override is given to just register the segments
 	// as participants and use the default MPI communicator
@@ -51,6 +98,10 @@ class GhostRegionSyncCommunicator : public Communicator {
 	void sendData() { if (!intraSegmentCommunicator) performTransfer(); }
         void receiveData() {}
 
+	// off-node MPI transfers can be divided among the sender PPUs while the node-local transfers remain sequential
+	bool shouldSendInParallel(int participantsCount);
+	void sendDataInParallel(int currentPpuOrder, int participantsCount);
+
 	// ghost region communicators do sending-receiving asynchronously at the same time; so after the data transfer is
 	// done for send; the receiver buffers' contents should be written to operating memory.
 	void performSendPostprocessing(int currentPpuOrder, int participantsCount) {
@@ -62,6 +113,15 @@ class GhostRegionSyncCommunicator : public Communicator {
 	// within a single function and let the later receive call to be non-halting 
 	void afterSend() { iterationNo++; }
 	void performTransfer();
+  private:
+	// determines if the communicator exchanges data with other segments and configures the transport the first time
+	// it does; returns false if there is no cross-segment communication in the communicator 
+	bool prepareTransport();
+	// separates the buffers exchanged with co-located segments from others and creates shared memory channels for
+	// the former
+	void configureTransport(List<CommBuffer*> *remoteBufferList);
+	// finds the sender or receiver segment of a buffer for a ghost region exchange
+	int getPeerSegment(CommBuffer *buffer, bool forReceive);
 };
 
 // communictor class for the scenario of propagating update to a data from LPUs of a lower level LPS to the LPU of a higher 
@@ -108,6 +168,10 @@ class DownSyncCommunicator : public Communicator {
 	// a flag denoting if the sender side of the communicator is replicated; if YES then one of many will do the data 
 	// send each time the communicator is used and there will be an extra step to determine who is the current sender
 	bool replicated;
+	// the current sender supplied by the program for a replicated sender side; the discovery step is skipped if known
+	int knownSenderTag;
+	// a flag indicating that the received data has already been written to the operating memory during the broadcast
+	bool receivedDataWritten;
 	
 	// three variables to be used for scatter_v communication  
 	char *scatterBuffer;
@@ -124,10 +188,16 @@ class DownSyncCommunicator : public Communicator {
 
 	void sendData();
         void receiveData();
+	void setKnownSender(int senderSegmentTag) { knownSenderTag = senderSegmentTag; }
 	
 	// the sender segment should not wait on its own update 
 	void afterSend() { iterationNo++; }
 
+	// the receive buffer is written only if that has not been done while the data was arriving
+	void perfromRecvPostprocessing(int currentPpuOrder, int participantsCount) {
+		if (!receivedDataWritten) processBuffersAfterReceive(currentPpuOrder, participantsCount);
+	}
+
 	// since the sender is also the receiver, it can immediately transfer content from the receiver buffer to the data
 	// parts in the part container tree
 	void performSendPostprocessing(int currentPpuOrder, int participantsCount);
@@ -152,6 +222,13 @@ class DownSyncCommunicator : public Communicator {
 // communicator class for the scenario where LPUs of two different LPSes that are not hierarchically related needs to be
 // synchronized after an update done on one LPS	 
 class CrossSyncCommunicator : public Communicator {
+  private:
+	// When MPI allows concurrent calls from multiple threads, MPI sends and receives are divided among the PPUs. Buffers
+	// sharing the same tag must be handled by the same PPU as the MPI message matching relies on their order. So the
+	// division is done on the ordinals of distinct buffer tags.
+	bool sendInParallel;
+	bool receiveInParallel;
+	std::vector<int> distinctBufferTags;
   public:
 	CrossSyncCommunicator(int localSegmentTag,
                 const char *dependencyName,
@@ -161,8 +238,18 @@ class CrossSyncCommunicator : public Communicator {
 	// communicator
 	void setupCommunicator(bool includeNonInteractingSegments);
 
-	void sendData();
-        void receiveData();
+	void sendData() { if (!sendInParallel) sendData(0, 1); }
+        void receiveData() { if (!receiveInParallel) receiveData(0, 1); }
+
+	// parallel transfer functions' overrides
+	bool shouldSendInParallel(int participantsCount);
+	bool shouldReceiveInParallel(int participantsCount);
+	void sendDataInParallel(int currentPpuOrder, int participantsCount) { 
+		sendData(currentPpuOrder, participantsCount); 
+	}
+	void receiveDataInParallel(int currentPpuOrder, int participantsCount) {
+		receiveData(currentPpuOrder, participantsCount);
+	}
 
 	// Send and receive is done at the same time if the current segment has something to send in this communicator. 
 	// Hence, receiver buffers' content must be written back to proper data parts after the send is done. 
@@ -180,6 +267,14 @@ class CrossSyncCommunicator : public Communicator {
 	
 	// due to the asynchronous receive setup; if send is invoked no subsequent receive is needed for the same iteration
 	void afterSend() { iterationNo++; }
+  private:
+	// the send and receive functions that only handle the buffers assigned to a particular PPU
+	void sendData(int currentPpuOrder, int participantsCount);
+	void receiveData(int currentPpuOrder, int participantsCount);
+	// filters the buffers of a list to retain only those that are assigned to a particular PPU
+	List<CommBuffer*> *getAssignedBuffers(List<CommBuffer*> *bufferList, 
+			int currentPpuOrder, int participantsCount);
+	int getDistinctBufferTagsCount();
 };
 
 #endif
@@ -118,7 +118,7 @@ void PreprocessedCommBuffer::setupMappingBuffer(char **buffer,
 	long int elementIndex = 0;
 	TransferLocationSpec *transferSpec = new TransferLocationSpec(elementSize);
 	while (iterator->hasMoreElements()) {
-		vector<int> *dataItemIndex = iterator->getNextElement();
+		vector<GlobalIndex> *dataItemIndex = iterator->getNextElement();
 		dataPartSpec->initPartTraversalReference(dataItemIndex, transformVector);
 		transferSpec->setBufferLocation(&buffer[elementIndex]);
 		partContainerTree->transferData(transformVector, 
@@ -190,7 +190,7 @@ void IndexMappedCommBuffer::setupMappingBuffer(DataPartIndexList *indexMappingBu
 	ExchangeIterator *iterator = getIterator();
 	long int elementIndex = 0;
 	while (iterator->hasMoreElements()) {
-		vector<int> *dataItemIndex = iterator->getNextElement();
+		vector<GlobalIndex> *dataItemIndex = iterator->getNextElement();
 		dataPartSpec->initPartTraversalReference(dataItemIndex, transformVector);
 		transferSpec->setPartIndexListReference(&indexMappingBuffer[elementIndex]);
 		partContainerTree->transferData(transformVector, 
@@ -263,7 +263,7 @@ void PhysicalCommBuffer::transferData(TransferSpec *transferSpec,
 	long int transferRequests = 0;
 	long int transferCount = 0;
 	while (iterator->hasMoreElements()) {
-		vector<int> *dataItemIndex = iterator->getNextElement();
+		vector<GlobalIndex> *dataItemIndex = iterator->getNextElement();
 		if (loggingEnabled) {
 			logFile << "\t\tTransfer Request for: (";
 			for (int i = 0; i < dataItemIndex->size(); i++) {
@@ -315,7 +315,11 @@ void PreprocessedPhysicalCommBuffer::readData(bool loggingEnabled, std::ostream
 }
 
 void PreprocessedPhysicalCommBuffer::writeData(bool loggingEnabled, std::ostream &logFile) {
-	for (long int i = 0; i < elementCount; i++) {
+	writeElements(0, elementCount);
+}
+
+void PreprocessedPhysicalCommBuffer::writeElements(long int firstElement, long int lastElement) {
+	for (long int i = firstElement; i < lastElement; i++) {
 		char *readLocation = data + i * elementSize;
 		char *writeLocation = receiverTransferMapping[i];
 		memcpy(writeLocation, readLocation, elementSize);
@@ -350,8 +354,12 @@ void IndexMappedPhysicalCommBuffer::readData(bool loggingEnabled, std::ostream &
 }
         
 void IndexMappedPhysicalCommBuffer::writeData(bool loggingEnabled, std::ostream &logFile) {
+	writeElements(0, elementCount);
+}
+
+void IndexMappedPhysicalCommBuffer::writeElements(long int firstElement, long int lastElement) {
 	
-	for (long int i = 0; i < elementCount; i++) {
+	for (long int i = firstElement; i < lastElement; i++) {
                 char *readLocation = data + i * elementSize;
 		List<DataPartIndex> *partIndexList = receiverTransferIndexMapping[i].getPartIndexList();
 
@@ -494,7 +502,7 @@ void VirtualCommBuffer::readData(bool loggingEnabled, std::ostream &logFile) {
 		while (iterator->hasMoreElements()) {
 
 			// get the next data item index from the iterator
-			vector<int> *dataItemIndex = iterator->getNextElement();
+			vector<GlobalIndex> *dataItemIndex = iterator->getNextElement();
 			if (loggingEnabled) {
 				logFile << "\t\tTransfer Request for: (";
 				for (int i = 0; i < dataItemIndex->size(); i++) {
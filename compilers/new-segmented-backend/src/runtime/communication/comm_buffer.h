@@ -106,6 +106,12 @@ class CommBuffer {
 	// doing computation.
 	virtual void readData(bool loggingEnabled, std::ostream &logFile) = 0;
 	virtual void writeData(bool loggingEnabled, std::ostream &logFile) = 0;
+
+	// Buffer types that can write a range of their elements to the operating memory independent of the rest should
+	// override these two functions. Then a communicator can write the elements that have already been received while
+	// the rest of the buffer is still in transit. The range includes the first element but excludes the last.
+	virtual bool isPartialWriteSupported() { return false; }
+	virtual void writeElements(long int firstElement, long int lastElement) {}
 	
 	// these two functions tell if the current segment is sending data, receiving data, or both
 	bool isSendActivated();
@@ -225,6 +231,8 @@ class PreprocessedPhysicalCommBuffer : public PreprocessedCommBuffer {
 	~PreprocessedPhysicalCommBuffer() { delete[] data; }
 	void readData(bool loggingEnabled, std::ostream &logFile);
 	void writeData(bool loggingEnabled, std::ostream &logFile);
+	bool isPartialWriteSupported() { return true; }
+	void writeElements(long int firstElement, long int lastElement);
 	void setData(char *data) { this->data = data; }
 	char *getData() { return data; }
 	virtual bool intraSegmentBufferType() { return false; }
@@ -240,6 +248,8 @@ class IndexMappedPhysicalCommBuffer : public IndexMappedCommBuffer {
 	virtual ~IndexMappedPhysicalCommBuffer() { delete[] data; }
 	virtual void readData(bool loggingEnabled, std::ostream &logFile);
         virtual void writeData(bool loggingEnabled, std::ostream &logFile);
+	virtual bool isPartialWriteSupported() { return true; }
+	virtual void writeElements(long int firstElement, long int lastElement);
 	void setData(char *data) { this->data = data; }
         char *getData() { return data; } 	
 	virtual bool intraSegmentBufferType() { return false; }
@@ -257,6 +267,8 @@ class SwiftIndexMappedPhysicalCommBuffer : public IndexMappedPhysicalCommBuffer
 	~SwiftIndexMappedPhysicalCommBuffer();
 	void readData(bool loggingEnabled, std::ostream &logFile);
         void writeData(bool loggingEnabled, std::ostream &logFile);
+	// the element-wise writing of the superclass would forgo the grouping of indexes this class is there for
+	bool isPartialWriteSupported() { return false; }
 	virtual bool intraSegmentBufferType() { return false; }
   private:
 	void setupSwiftIndexMapping(DataPartIndexList *transferIndexMapping,
@@ -335,8 +347,12 @@ class CommBufferManager {
 	List<CommBuffer*> *commBufferList;
   public:
 	CommBufferManager(const char *dependencyName);
-	~CommBufferManager();
-	void setCommBufferList(List<CommBuffer*> *commBufferList) { this->commBufferList = commBufferList; }
+	virtual ~CommBufferManager();
+	// replaces the empty buffer list the manager starts with by a list already populated with buffers
+	void setCommBufferList(List<CommBuffer*> *commBufferList) {
+		delete this->commBufferList;
+		this->commBufferList = commBufferList;
+	}
 	void addCommBuffer(CommBuffer *buffer) { commBufferList->Append(buffer); }
 	const char *getName() { return dependencyName; }
 
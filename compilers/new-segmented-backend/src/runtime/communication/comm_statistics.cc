@@ -3,6 +3,7 @@
 #include <sstream>
 #include <string>
 #include <cstdlib>
+#include <cstring>
 #include <stdio.h>
 #include <time.h>
 #include <sys/time.h>
@@ -22,6 +23,7 @@ CommStatistics::CommStatistics() {
         bufferReadTimeMap = new Hashtable<double*>;
         communicationTimeMap = new Hashtable<double*>;
         bufferWriteTimeMap = new Hashtable<double*>;
+	bufferSelectionMap = new Hashtable<List<const char*>*>;
 	pthread_mutex_init(&mutex, NULL);
 }
 
@@ -33,6 +35,7 @@ CommStatistics::~CommStatistics() {
 	delete bufferReadTimeMap;
         delete communicationTimeMap;
 	delete bufferWriteTimeMap;
+	delete bufferSelectionMap;
 	pthread_mutex_destroy(&mutex);
 }
 
@@ -59,6 +62,7 @@ void CommStatistics::enlistDependency(const char *dependency) {
 	double *bWTime = new double;
 	*bWTime = 0.0;
         bufferWriteTimeMap->Enter(dependency, bWTime);
+	bufferSelectionMap->Enter(dependency, new List<const char*>);
 
 	pthread_mutex_unlock(&mutex);
 }
@@ -87,6 +91,14 @@ void CommStatistics::addBufferWriteTime(const char *dependency, struct timeval &
 	recordTiming(bufferWriteTimeMap, dependency, start, end);
 }
 
+void CommStatistics::recordBufferSelection(const char *dependency, const char *bufferType) {
+	pthread_mutex_lock(&mutex);
+	List<const char*> *selections = bufferSelectionMap->Lookup(dependency);
+	Assert(selections != NULL);
+	selections->Append(bufferType);
+	pthread_mutex_unlock(&mutex);
+}
+
 void CommStatistics::logStatistics(int indentation, std::ofstream &logFile) {
 	std::ostringstream indent;
 	for (int i = 0; i < indentation; i++) indent << '\t';
@@ -102,6 +114,32 @@ void CommStatistics::logStatistics(int indentation, std::ofstream &logFile) {
 		logFile << indent.str() << '\t' << "Communication resources setup time: ";
 		logFile << *(commResourcesSetupTimeMap->Lookup(dependency)) << "\n";
 
+		// buffer types chosen by adaptive communication buffers, if there are any
+		List<const char*> *selections = bufferSelectionMap->Lookup(dependency);
+		if (selections->NumElements() > 0) {
+			logFile << indent.str() << '\t' << "Buffer selection:";
+			List<const char*> *distinctTypes = new List<const char*>;
+			for (int j = 0; j < selections->NumElements(); j++) {
+				const char *type = selections->Nth(j);
+				bool counted = false;
+				for (int k = 0; k < distinctTypes->NumElements(); k++) {
+					if (strcmp(distinctTypes->Nth(k), type) == 0) {
+						counted = true;
+						break;
+					}
+				}
+				if (counted) continue;
+				distinctTypes->Append(type);
+				int count = 0;
+				for (int k = j; k < selections->NumElements(); k++) {
+					if (strcmp(selections->Nth(k), type) == 0) count++;
+				}
+				logFile << ' ' << type << " (" << count << ")";
+			}
+			logFile << "\n";
+			delete distinctTypes;
+		}
+
 		// different parts of communication
 		logFile << indent.str() << '\t' << "Communication time: \n";
 		logFile << indent.str() << "\t\t" << "Buffer reading: ";
@@ -29,6 +29,9 @@ class CommStatistics {
 	Hashtable<double*> *communicationTimeMap;
 	Hashtable<double*> *bufferWriteTimeMap;
 
+	// the types of communication buffers adaptive buffers of a dependency have settled on
+	Hashtable<List<const char*>*> *bufferSelectionMap;
+
 	// a mutex to protect the stat object from being corrupted if multiple threads try to enter timing data 
 	//into it at the same time
 	pthread_mutex_t mutex;
@@ -46,6 +49,9 @@ class CommStatistics {
 	void addBufferReadTime(const char *dependency, struct timeval &start, struct timeval &end);
 	void addCommunicationTime(const char *dependency, struct timeval &start, struct timeval &end);
 	void addBufferWriteTime(const char *dependency, struct timeval &start, struct timeval &end);
+
+	// function for recording the buffer type an adaptive communication buffer of a dependency has selected
+	void recordBufferSelection(const char *dependency, const char *bufferType);
 	
 	// function to be used at program's end to log the total time spent on different communication dependencies
 	void logStatistics(int indentation, std::ofstream &logFile);
@@ -35,6 +35,14 @@ void SendBarrier::transferFunction() {
 	communicator->afterSend();
 }
         
+bool SendBarrier::isTransferParallel() {
+	return communicator->shouldSendInParallel(_size);
+}
+
+void SendBarrier::parallelTransferFunction(int order, int participants) {
+	communicator->sendDataInParallel(order, participants);
+}
+        
 void SendBarrier::afterTransfer(int order, int participants) {
 	communicator->performSendPostprocessing(order, participants);
 }
@@ -86,6 +94,14 @@ void ReceiveBarrier::transferFunction() {
 	communicator->afterReceive();
 }
 
+bool ReceiveBarrier::isTransferParallel() {
+	return communicator->shouldReceiveInParallel(_size);
+}
+
+void ReceiveBarrier::parallelTransferFunction(int order, int participants) {
+	communicator->receiveDataInParallel(order, participants);
+}
+
 void ReceiveBarrier::afterTransfer(int order, int participants) {
 	communicator->perfromRecvPostprocessing(order, participants);
 }
@@ -134,6 +150,15 @@ Communicator::Communicator(int localSegmentTag,
 	iterationNo = 0;
 	communicatorId = 0;
 	commStat = NULL;
+	segmentGroup = NULL;
+	participantSegments = NULL;
+}
+
+Communicator::~Communicator() {
+	delete sendBarrier;
+	delete receiveBarrier;
+	delete segmentGroup;
+	delete participantSegments;
 }
 
 void Communicator::describe(int indentation) {
@@ -41,6 +41,8 @@ class SendBarrier : public ParallelCommBarrier {
 	bool shouldPerformTransfer(int activeSignalsCount, int callerIterationNo);
 	void beforeTransfer(int order, int participants);
         void transferFunction();
+	bool isTransferParallel();
+	void parallelTransferFunction(int order, int participants);
         void afterTransfer(int order, int participants);
 	void recordTimingLog(TimingLogType logType, struct timeval &start, struct timeval &end);
 
@@ -61,6 +63,8 @@ class ReceiveBarrier : public ParallelCommBarrier {
 	bool shouldPerformTransfer(int activeSignalsCount, int callerIterationNo);
         void beforeTransfer(int order, int participants);
         void transferFunction();
+	bool isTransferParallel();
+	void parallelTransferFunction(int order, int participants);
         void afterTransfer(int order, int participants);	
 	void recordTimingLog(TimingLogType logType, struct timeval &start, struct timeval &end);
 
@@ -93,6 +97,9 @@ class Communicator : public CommBufferManager {
 	CommStatistics *commStat;
   public:
 	Communicator(int localSegmentTag, const char *dependencyName, int localSenderPpus, int localReceiverPpus);
+	// deleting a communicator deletes its barriers, its participants list, and the segment group releasing the MPI
+	// communicator the group has created, if any, along with the communication buffers
+	virtual ~Communicator();
 	void setLogFile(std::ofstream *logFile) { this->logFile = logFile; }
 	void setParticipants(std::vector<int> *participants) { this->participantSegments = participants; }
 	void setCommStat(CommStatistics *commStat) { this->commStat = commStat; }
@@ -150,6 +157,17 @@ class Communicator : public CommBufferManager {
 	virtual void sendData() = 0;
 	virtual void receiveData() = 0;
 
+	//------------------------------------------------------------------------------------------- Parallel Transfer Functions
+	// When MPI supports concurrent calls from multiple threads, a subclass can divide its MPI sends and receives among the
+	// participating PPUs by overriding these functions. The first two functions are invoked once per transfer, before the
+	// participants are released for the preprocessing step, to decide if the transfer should be divided. If a function 
+	// returns true then the corresponding parallel function is invoked by all participants after the preprocessing and the 
+	// regular send/receive function is invoked after that to do any remaining sequential part of the transfer. 
+	virtual bool shouldSendInParallel(int participantsCount) { return false; }
+	virtual bool shouldReceiveInParallel(int participantsCount) { return false; }
+	virtual void sendDataInParallel(int currentPpuOrder, int participantsCount) {}
+	virtual void receiveDataInParallel(int currentPpuOrder, int participantsCount) {}
+
 	//------------------------------------------------------------------------- Parallel Postprocessing Functions for Transfer 
 	virtual void performSendPostprocessing(int currentPpuOrder, int participantsCount) {}
 	virtual void perfromRecvPostprocessing(int currentPpuOrder, int participantsCount) {
@@ -163,6 +181,13 @@ class Communicator : public CommBufferManager {
 	// halted on the receive-barrier.
 	virtual void afterReceive() { iterationNo++; }
 
+	// Communicators whose sender changes from one use to the next have to discover the current sender with an extra
+	// collective operation before each transfer. When the sender can be derived from the program state, e.g., from
+	// the loop index that selects the updater LPU, all participating segments can instead supply the sender segment
+	// through this function and the discovery is skipped. The setting remains in effect until it is changed; passing
+	// INVALID_ID reverts to the discovery. Communicators having a fixed sender ignore the setting.
+	virtual void setKnownSender(int senderSegmentTag) {}
+
 	// Some communication mechanisms, for example MPI, requires that even the non-participating segments should explicitly say
 	// that they will not be communicating for proper communication resources (e.g., groups, channel) setup. Therefore, this
 	// function is provided to exclude the current segment when other segments that will interact calls the setupCommunicator
@@ -465,6 +465,8 @@ CrossSegmentInteractionSpec::CrossSegmentInteractionSpec(Container *container, C
 	generateParticipantList(container,
 				dataDimensions, RECEIVE, *receiverPath, receiverConfig, confinementLevel);
 
+	delete senderPath;
+	delete receiverPath;
 	this->localInteractionAllowed = !config->isIntraContrainerSync();
 }
 
@@ -472,21 +474,27 @@ List<DataExchange*> *CrossSegmentInteractionSpec::generateSendExchanges() {
 	if (localSender == NULL) return NULL;
 	List<Participant*> *localSenderList = new List<Participant*>;
 	localSenderList->Append(localSender);
+	List<DataExchange*> *exchangeList = NULL;
 	if (localReceiver == NULL || !localInteractionAllowed) {
-		return Confinement::generateDataExchangeList(localSenderList, remoteReceivers);
+		exchangeList = Confinement::generateDataExchangeList(localSenderList, remoteReceivers);
 	} else {
 		List<Participant*> *receiverList = new List<Participant*>;
 		receiverList->AppendAll(remoteReceivers);
 		receiverList->Append(localReceiver);
-		return Confinement::generateDataExchangeList(localSenderList, receiverList);
+		exchangeList = Confinement::generateDataExchangeList(localSenderList, receiverList);
+		delete receiverList;
 	}
+	delete localSenderList;
+	return exchangeList;
 }
 
 List<DataExchange*> *CrossSegmentInteractionSpec::generateReceiveExchanges() {
 	if (localReceiver == NULL) return NULL;
 	List<Participant*> *localReceiverList = new List<Participant*>;
 	localReceiverList->Append(localReceiver);
-	return Confinement::generateDataExchangeList(remoteSenders, localReceiverList);
+	List<DataExchange*> *exchangeList = Confinement::generateDataExchangeList(remoteSenders, localReceiverList);
+	delete localReceiverList;
+	return exchangeList;
 }
 
 List<DataExchange*> *CrossSegmentInteractionSpec::generateRemoteExchanges() {
@@ -552,6 +560,7 @@ void CrossSegmentInteractionSpec::generateParticipantList(Container *confinement
 				localParticipant = new Participant(role, containerId, dataDesc);
 				localParticipant->addSegmentTag(localSegmentTag);
 			}
+			delete folding;
 			continue;
 		}
 
@@ -574,6 +583,7 @@ void CrossSegmentInteractionSpec::generateParticipantList(Container *confinement
 				participant->addSegmentTag(segmentTag);
 				remoteParticipants->Append(participant);
 			}
+			delete folding;
 		} else {
 			Participant *participant = remoteParticipants->Nth(matchingIndex);
 			participant->addSegmentTag(segmentTag);
@@ -620,6 +630,12 @@ IntraContainerInteractionSpec::IntraContainerInteractionSpec(BranchingContainer
 	int receiverBranchLevel = receiverPath->at(0).getLevel();
 	receiverList = generateParticipantList(receiverBranches,
 			RECEIVE, *receiverPath, config->getReceiverConfig(), receiverBranchLevel);
+
+	// the branch lists are just views of the distribution tree; the containers themselves remain in the tree
+	if (receiverBranches != senderBranches) delete receiverBranches;
+	delete senderBranches;
+	delete senderPath;
+	delete receiverPath;
 }
 
 List<Participant*> *IntraContainerInteractionSpec::generateParticipantList(List<Container*> *participantBranches,
@@ -644,7 +660,8 @@ List<Participant*> *IntraContainerInteractionSpec::generateParticipantList(List<
 			participant->setId(senderCountSoFar);
 			participant->addSegmentTag(localSegmentTag);
 			participantList->Append(participant);
-		}
+		} else delete containerId;
+		delete folding;
 	}
 
 	while (foldingList->NumElements() > 0) {
@@ -805,6 +822,7 @@ List<Confinement*> *Confinement::generateAllConfinements(ConfinementConstruction
 			Confinement *confinement = new Confinement(dataDimensions, branchContainer, config);
 			confinementList->Append(confinement);
 		}
+		deletePartIdList(partIdList);
 	}
 
 	// if the underlying synchronization is intended for the parts of the same part-tracking-tree then the sender
@@ -834,11 +852,28 @@ List<Confinement*> *Confinement::generateAllConfinements(ConfinementConstruction
 				confinementList->Append(confinement);
 			}
 		}
+		deletePartIdList(partIdList);
 	}
 
+	delete senderVector;
+	delete confinementVector;
 	return confinementList;
 }
 
+void Confinement::deletePartIdList(List<List<int*>*> *partIdList) {
+	while (partIdList->NumElements() > 0) {
+		List<int*> *partId = partIdList->Nth(0);
+		partIdList->RemoveAt(0);
+		while (partId->NumElements() > 0) {
+			int *idAtLevel = partId->Nth(0);
+			partId->RemoveAt(0);
+			delete[] idAtLevel;
+		}
+		delete partId;
+	}
+	delete partIdList;
+}
+
 List<DataExchange*> *Confinement::generateDataExchangeList(List<Participant*> *senderList,
 		List<Participant*> *receiverList) {
 
@@ -859,7 +894,7 @@ List<DataExchange*> *Confinement::generateDataExchangeList(List<Participant*> *s
 			}
 		}
 	}
-	if (dataExchangeList == NULL) {
+	if (dataExchangeList->NumElements() == 0) {
 		delete dataExchangeList;
 		return NULL;
 	}
@@ -880,7 +915,7 @@ ExchangeIterator::~ExchangeIterator() {
 	if (iterator != NULL) delete iterator;
 }
 
-vector<int> *ExchangeIterator::getNextElement() {
+vector<GlobalIndex> *ExchangeIterator::getNextElement() {
 	if (!iterator->hasMoreElements()) {
 		delete iterator;
 		currentSequence++;
@@ -893,7 +928,7 @@ vector<int> *ExchangeIterator::getNextElement() {
 }
 
 void ExchangeIterator::printNextElement(std::ostream &stream) {
-	vector<int> *element = getNextElement();
+	vector<GlobalIndex> *element = getNextElement();
 	int dimensionality = sequences->Nth(0)->getDimensionality();
 	for (int i = 0; i < dimensionality; i++) {
 		stream << element->at(i);
@@ -333,6 +333,9 @@ class Confinement {
 	// an utility method to be used by cross-segment and within-container interaction specification classes
 	static List<DataExchange*> *generateDataExchangeList(List<Participant*> *senderList,
 			List<Participant*> *receiverList);
+  private:
+	// deletes a list of part Ids retrieved from a part-tracking tree along with the Ids themselves
+	static void deletePartIdList(List<List<int*>*> *partIdList);
 };
 
 /* An iterator to traverse through the data points of a data exchange
@@ -350,7 +353,7 @@ class ExchangeIterator {
 	bool hasMoreElements() { return currentElement < totalElementsCount; }
 
 	// returns the next index point in the data exchange; returns NULL if it reaches the end of the exchange
-	std::vector<int> *getNextElement();
+	std::vector<GlobalIndex> *getNextElement();
 
 	void printNextElement(std::ostream &stream);
 };
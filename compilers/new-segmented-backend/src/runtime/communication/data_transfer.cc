@@ -172,7 +172,7 @@ TransferSpec::TransferSpec(TransferDirection direction, int elementSize) {
 	this->confinementContainerId = NULL;
 }
 
-void TransferSpec::setBufferEntry(char *bufferEntry, vector<int> *dataIndex) {
+void TransferSpec::setBufferEntry(char *bufferEntry, vector<GlobalIndex> *dataIndex) {
 	this->bufferEntry = bufferEntry;
 	this->dataIndex = dataIndex;
 }
@@ -206,7 +206,7 @@ DataPartSpec::DataPartSpec(List<DataPart*> *partList, DataItemConfig *dataConfig
 	}
 }
 
-void DataPartSpec::initPartTraversalReference(vector<int> *dataIndex, vector<XformedIndexInfo*> *transformVector) {
+void DataPartSpec::initPartTraversalReference(vector<GlobalIndex> *dataIndex, vector<XformedIndexInfo*> *transformVector) {
 	for (int i = 0; i < dimensionality; i++) {
 		XformedIndexInfo *dimIndex = transformVector->at(i);
 		dimIndex->index = dataIndex->at(i);
@@ -215,14 +215,14 @@ void DataPartSpec::initPartTraversalReference(vector<int> *dataIndex, vector<Xfo
 	}
 }
 
-char *DataPartSpec::getUpdateLocation(PartLocator *partLocator, vector<int> *partIndex, int dataItemSize) {
+char *DataPartSpec::getUpdateLocation(PartLocator *partLocator, vector<GlobalIndex> *partIndex, int dataItemSize) {
 
 	DataPartIndex dataPartIndex = getDataPartUpdateIndex(partLocator, partIndex, dataItemSize);
 	return dataPartIndex.getLocation();
 }
 
 DataPartIndex DataPartSpec::getDataPartUpdateIndex(PartLocator *partLocator, 
-		vector<int> *partIndex, int dataItemSize) {
+		vector<GlobalIndex> *partIndex, int dataItemSize) {
 
 	int partNo = partLocator->getPartListIndex();
         DataPart *dataPart = partList->Nth(partNo);
@@ -233,9 +233,9 @@ DataPartIndex DataPartSpec::getDataPartUpdateIndex(PartLocator *partLocator,
         long int multiplier = 1;
         for (int i = partIndex->size() - 1; i >= 0; i--) {
 
-                int firstIndex = partDimensions[i].range.min;
-                int lastIndex = partDimensions[i].range.max;
-                int dimensionIndex = partIndex->at(i);
+                GlobalIndex firstIndex = partDimensions[i].range.min;
+                GlobalIndex lastIndex = partDimensions[i].range.max;
+                GlobalIndex dimensionIndex = partIndex->at(i);
 
                 Assert(firstIndex <= dimensionIndex && dimensionIndex <= lastIndex);
 
@@ -128,7 +128,7 @@ class TransferSpec {
 	// address in the communication buffer for read/write
 	char *bufferEntry;
 	// the actual index of the data-point retrieved from the interval representation of the communication buffer
-	std::vector<int> *dataIndex;
+	std::vector<GlobalIndex> *dataIndex;
 
 	// This field is used to avoid unwanted updates in data parts that contain a to be updated element index but
 	// not intended to be updated as part of the dependency resolution process the transfer spec is intended for.
@@ -156,8 +156,8 @@ class TransferSpec {
 	TransferDirection getDirection() { return direction; }
 	virtual ~TransferSpec() {}
 	void setConfinementContainerId(std::vector<int*> *containerId) { confinementContainerId = containerId; }
-	void setBufferEntry(char *bufferEntry, std::vector<int> *dataIndex);
-	inline std::vector<int> *getDataIndex() { return dataIndex; }
+	void setBufferEntry(char *bufferEntry, std::vector<GlobalIndex> *dataIndex);
+	inline std::vector<GlobalIndex> *getDataIndex() { return dataIndex; }
 	inline int getStepSize() { return elementSize; }
 
 	// function to be used to do the data transfer once the participating location in the operating memory has been
@@ -234,16 +234,16 @@ class DataPartSpec {
 	// The process needs to keep track of the current state of the index to proceed to the next step. To avoid
 	// creating a new index tracker object for each data transfer, we maintain a single tracker object (represented
 	// by the second parameter) and initiate/reset it before starting the tree traversal.
-	void initPartTraversalReference(std::vector<int> *dataIndex,
+	void initPartTraversalReference(std::vector<GlobalIndex> *dataIndex,
 			std::vector<XformedIndexInfo*> *transformVector);
 
 	// function to be used at the end of part-container tree hierarchy traversal to get the memory location that
 	// should participate in a data transfer
-	char *getUpdateLocation(PartLocator *partLocator, std::vector<int> *partIndex, int dataItemSize);
+	char *getUpdateLocation(PartLocator *partLocator, std::vector<GlobalIndex> *partIndex, int dataItemSize);
 
 	// function to be used at the end of part-container tree hierarchy traversal to get the data part index that
 	// should participate in a data transfer
-	DataPartIndex getDataPartUpdateIndex(PartLocator *partLocator, std::vector<int> *partIndex, int dataItemSize);
+	DataPartIndex getDataPartUpdateIndex(PartLocator *partLocator, std::vector<GlobalIndex> *partIndex, int dataItemSize);
 };
 
 #endif /* DATA_TRANSFER_H_ */
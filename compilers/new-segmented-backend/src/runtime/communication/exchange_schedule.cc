@@ -0,0 +1,257 @@
+#include "exchange_schedule.h"
+#include "confinement_mgmt.h"
+#include "part_distribution.h"
+
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/interval.h"
+#include "../../../../common-libs/utils/binary_search.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+//---------------------------------------------------- Scheduled Part --------------------------------------------------------/
+
+ScheduledPart::ScheduledPart(int segmentTag, std::vector<int*> *partId, int dataDimensions) {
+	this->segmentTag = segmentTag;
+	this->partId = partId;
+	this->ownedRegion = new Range[dataDimensions];
+	this->paddedRegion = new Range[dataDimensions];
+}
+
+ScheduledPart::~ScheduledPart() {
+	for (unsigned int i = 0; i < partId->size(); i++) {
+		delete[] partId->at(i);
+	}
+	delete partId;
+	delete[] ownedRegion;
+	delete[] paddedRegion;
+}
+
+//----------------------------------------------- Regular Exchange Schedule --------------------------------------------------/
+
+RegularExchangeSchedule::RegularExchangeSchedule(int dataDimensions, int localSegmentTag) {
+	this->dataDimensions = dataDimensions;
+	this->localSegmentTag = localSegmentTag;
+	this->partList = new List<ScheduledPart*>;
+}
+
+RegularExchangeSchedule::~RegularExchangeSchedule() {
+	while (partList->NumElements() > 0) {
+		ScheduledPart *part = partList->Nth(0);
+		partList->RemoveAt(0);
+		delete part;
+	}
+	delete partList;
+}
+
+ScheduledPart *RegularExchangeSchedule::addPart(int segmentTag, Container *partContainer) {
+	ScheduledPart *part = new ScheduledPart(segmentTag, partContainer->getPartId(dataDimensions), dataDimensions);
+	partList->Append(part);
+	binsearch::insertIfNotExist(&segmentTags, segmentTag);
+	return part;
+}
+
+List<DataExchange*> *RegularExchangeSchedule::generateExchanges() {
+
+	List<DataExchange*> *exchangeList = new List<DataExchange*>;
+
+	// exchanges between the local segment and each of the others; the participants of the local segment are shared
+	// by all its exchanges just as they are in a confinement
+	Participant *localSender = NULL;
+	Participant *localReceiver = NULL;
+	for (unsigned int i = 0; i < segmentTags.size(); i++) {
+		int remoteTag = segmentTags[i];
+		if (remoteTag == localSegmentTag) continue;
+		List<MultidimensionalIntervalSeq*> *sendDesc = getSegmentExchangeDesc(localSegmentTag, remoteTag);
+		if (sendDesc != NULL) {
+			if (localSender == NULL) localSender = generateParticipant(localSegmentTag, SEND);
+			Participant *remoteReceiver = generateParticipant(remoteTag, RECEIVE);
+			exchangeList->Append(new DataExchange(localSender, remoteReceiver, sendDesc));
+			delete sendDesc;
+		}
+		List<MultidimensionalIntervalSeq*> *receiveDesc = getSegmentExchangeDesc(remoteTag, localSegmentTag);
+		if (receiveDesc != NULL) {
+			if (localReceiver == NULL) localReceiver = generateParticipant(localSegmentTag, RECEIVE);
+			Participant *remoteSender = generateParticipant(remoteTag, SEND);
+			exchangeList->Append(new DataExchange(remoteSender, localReceiver, receiveDesc));
+			delete receiveDesc;
+		}
+	}
+
+	// exchanges among the local parts; the owned regions of parts are disjoint; so each pair's exchange is a single
+	// region
+	List<ScheduledPart*> *localParts = new List<ScheduledPart*>;
+	for (int i = 0; i < partList->NumElements(); i++) {
+		ScheduledPart *part = partList->Nth(i);
+		if (part->segmentTag == localSegmentTag) localParts->Append(part);
+	}
+	int localPartCount = localParts->NumElements();
+	Participant **senders = new Participant*[localPartCount];
+	Participant **receivers = new Participant*[localPartCount];
+	for (int i = 0; i < localPartCount; i++) {
+		senders[i] = NULL;
+		receivers[i] = NULL;
+	}
+	Range *overlap = new Range[dataDimensions];
+	for (int i = 0; i < localPartCount; i++) {
+		ScheduledPart *senderPart = localParts->Nth(i);
+		for (int j = 0; j < localPartCount; j++) {
+			if (i == j) continue;
+			ScheduledPart *receiverPart = localParts->Nth(j);
+			if (!intersect(senderPart->ownedRegion, receiverPart->paddedRegion, overlap)) continue;
+			if (senders[i] == NULL) senders[i] = generateParticipant(senderPart, SEND, i);
+			if (receivers[j] == NULL) receivers[j] = generateParticipant(receiverPart, RECEIVE, j);
+			List<MultidimensionalIntervalSeq*> *exchangeDesc = new List<MultidimensionalIntervalSeq*>;
+			exchangeDesc->Append(generateRegionSeq(overlap));
+			exchangeList->Append(new DataExchange(senders[i], receivers[j], exchangeDesc));
+			delete exchangeDesc;
+		}
+	}
+	delete[] overlap;
+	delete[] senders;
+	delete[] receivers;
+	delete localParts;
+
+	if (exchangeList->NumElements() == 0) {
+		delete exchangeList;
+		return NULL;
+	}
+	return exchangeList;
+}
+
+List<MultidimensionalIntervalSeq*> *RegularExchangeSchedule::getSegmentExchangeDesc(int senderTag, int receiverTag) {
+
+	// The padded regions of different receiver parts may overlap; so the intersections of a sender part with them
+	// are made disjoint before they are added to the exchange. The owned regions of sender parts never overlap; so
+	// the pieces of a sender part need only be checked against earlier pieces of the same part.
+	List<Range*> *pieces = new List<Range*>;
+	Range *overlap = new Range[dataDimensions];
+	for (int i = 0; i < partList->NumElements(); i++) {
+		ScheduledPart *senderPart = partList->Nth(i);
+		if (senderPart->segmentTag != senderTag) continue;
+		int firstPieceOfPart = pieces->NumElements();
+		for (int j = 0; j < partList->NumElements(); j++) {
+			ScheduledPart *receiverPart = partList->Nth(j);
+			if (receiverPart->segmentTag != receiverTag) continue;
+			if (!intersect(senderPart->ownedRegion, receiverPart->paddedRegion, overlap)) continue;
+
+			List<Range*> *fragments = new List<Range*>;
+			Range *region = new Range[dataDimensions];
+			std::copy(overlap, overlap + dataDimensions, region);
+			fragments->Append(region);
+			for (int k = firstPieceOfPart; k < pieces->NumElements() && fragments->NumElements() > 0; k++) {
+				List<Range*> *remainder = new List<Range*>;
+				for (int f = 0; f < fragments->NumElements(); f++) {
+					Range *fragment = fragments->Nth(f);
+					subtract(fragment, pieces->Nth(k), remainder);
+					delete[] fragment;
+				}
+				delete fragments;
+				fragments = remainder;
+			}
+			pieces->AppendAll(fragments);
+			delete fragments;
+		}
+	}
+	delete[] overlap;
+
+	if (pieces->NumElements() == 0) {
+		delete pieces;
+		return NULL;
+	}
+	List<MultidimensionalIntervalSeq*> *exchangeDesc = new List<MultidimensionalIntervalSeq*>;
+	for (int i = 0; i < pieces->NumElements(); i++) {
+		Range *piece = pieces->Nth(i);
+		exchangeDesc->Append(generateRegionSeq(piece));
+		delete[] piece;
+	}
+	delete pieces;
+	return exchangeDesc;
+}
+
+Participant *RegularExchangeSchedule::generateParticipant(int segmentTag, CommRole role) {
+	List<MultidimensionalIntervalSeq*> *dataDesc = new List<MultidimensionalIntervalSeq*>;
+	for (int i = 0; i < partList->NumElements(); i++) {
+		ScheduledPart *part = partList->Nth(i);
+		if (part->segmentTag != segmentTag) continue;
+		Range *region = (role == SEND) ? part->ownedRegion : part->paddedRegion;
+		dataDesc->Append(generateRegionSeq(region));
+	}
+	// cross-segment participants are confined by the root of the distribution tree that has an empty Id
+	Participant *participant = new Participant(role, new vector<int*>, dataDesc);
+	participant->addSegmentTag(segmentTag);
+	return participant;
+}
+
+Participant *RegularExchangeSchedule::generateParticipant(ScheduledPart *part, CommRole role, int id) {
+	List<MultidimensionalIntervalSeq*> *dataDesc = new List<MultidimensionalIntervalSeq*>;
+	Range *region = (role == SEND) ? part->ownedRegion : part->paddedRegion;
+	dataDesc->Append(generateRegionSeq(region));
+
+	// the participant gets its own copy of the part Id as it may outlive the schedule
+	vector<int*> *containerId = new vector<int*>;
+	for (unsigned int level = 0; level < part->partId->size(); level++) {
+		int *idAtLevel = new int[dataDimensions];
+		std::copy(part->partId->at(level), part->partId->at(level) + dataDimensions, idAtLevel);
+		containerId->push_back(idAtLevel);
+	}
+	Participant *participant = new Participant(role, containerId, dataDesc);
+	participant->setId(id);
+	participant->addSegmentTag(part->segmentTag);
+	return participant;
+}
+
+bool RegularExchangeSchedule::intersect(Range *first, Range *second, Range *intersection) {
+	for (int d = 0; d < dataDimensions; d++) {
+		intersection[d].min = max(first[d].min, second[d].min);
+		intersection[d].max = min(first[d].max, second[d].max);
+		if (intersection[d].min > intersection[d].max) return false;
+	}
+	return true;
+}
+
+void RegularExchangeSchedule::subtract(Range *region, Range *cut, List<Range*> *remainder) {
+
+	Range *overlap = new Range[dataDimensions];
+	if (!intersect(region, cut, overlap)) {
+		Range *copy = new Range[dataDimensions];
+		std::copy(region, region + dataDimensions, copy);
+		remainder->Append(copy);
+		delete[] overlap;
+		return;
+	}
+
+	// slice off the parts of the region below and above the cut one dimension at a time; the dimensions already
+	// processed are restricted to the cut's extent for subsequent slices so that the slices do not overlap
+	Range *core = new Range[dataDimensions];
+	std::copy(region, region + dataDimensions, core);
+	for (int d = 0; d < dataDimensions; d++) {
+		if (core[d].min < overlap[d].min) {
+			Range *slice = new Range[dataDimensions];
+			std::copy(core, core + dataDimensions, slice);
+			slice[d].max = overlap[d].min - 1;
+			remainder->Append(slice);
+		}
+		if (core[d].max > overlap[d].max) {
+			Range *slice = new Range[dataDimensions];
+			std::copy(core, core + dataDimensions, slice);
+			slice[d].min = overlap[d].max + 1;
+			remainder->Append(slice);
+		}
+		core[d] = overlap[d];
+	}
+	delete[] core;
+	delete[] overlap;
+}
+
+MultidimensionalIntervalSeq *RegularExchangeSchedule::generateRegionSeq(Range *region) {
+	MultidimensionalIntervalSeq *seq = new MultidimensionalIntervalSeq(dataDimensions);
+	for (int d = 0; d < dataDimensions; d++) {
+		GlobalIndex length = region[d].max - region[d].min + 1;
+		seq->setIntervalForDim(d, new IntervalSeq(region[d].min, length, length, 1));
+	}
+	return seq;
+}
@@ -0,0 +1,75 @@
+#ifndef _H_exchange_schedule
+#define _H_exchange_schedule
+
+/* For a ghost region synchronization of an array that is divided only once, by block_size and/or block_count partition
+ * functions, the data each pair of parts exchanges is simply the intersection of two rectangles: the owned region of
+ * the sender part and the padded region of the receiver part. Both regions follow directly from the partition
+ * arguments, paddings, and part Ids. So for such dependencies the compiler generates a schedule function that computes
+ * the regions of the parts in closed form and feeds them into the class of this header. This replaces the folding of
+ * distribution tree branches and the intersection of interval sequences that confinement construction otherwise does
+ * at runtime. The distribution tree is still consulted to learn which segment holds which part.
+ *
+ * The resulting data exchanges are equivalent to those the confinements generate: one exchange from the local segment
+ * to each neighbour segment and one in the reverse direction, and one exchange for each pair of local parts having an
+ * overlap. The exchange between two segments is computed only from the parts of those two segments in the same order
+ * on both sides; so the sender and the receiver agree on the sequence of elements in the communication buffer. Note
+ * that exchanges between pairs of remote segments are not generated as no communicator of a ghost region
+ * synchronization needs them.
+ * */
+
+#include "confinement_mgmt.h"
+#include "part_distribution.h"
+
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/interval.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <vector>
+
+/* a data part of the synchronized array with the regions relevant for the exchanges */
+class ScheduledPart {
+  public:
+	int segmentTag;
+	std::vector<int*> *partId;
+	// one range per data dimension for each region
+	Range *ownedRegion;
+	Range *paddedRegion;
+
+	ScheduledPart(int segmentTag, std::vector<int*> *partId, int dataDimensions);
+	~ScheduledPart();
+};
+
+class RegularExchangeSchedule {
+  protected:
+	int dataDimensions;
+	int localSegmentTag;
+	// parts in the order they have been added; the order should be the same in all segments
+	List<ScheduledPart*> *partList;
+	std::vector<int> segmentTags;
+  public:
+	RegularExchangeSchedule(int dataDimensions, int localSegmentTag);
+	~RegularExchangeSchedule();
+
+	// Adds a part held by a segment; the caller should fill in the regions of the returned part. The part Id is
+	// taken from the distribution tree container of the part.
+	ScheduledPart *addPart(int segmentTag, Container *partContainer);
+
+	// generates all data exchanges the local segment participates in; returns NULL if there is none
+	List<DataExchange*> *generateExchanges();
+  private:
+	// determines the data the parts of the sender segment should send to the parts of the receiver segment as a
+	// list of disjoint regions; returns NULL if the segments do not interact
+	List<MultidimensionalIntervalSeq*> *getSegmentExchangeDesc(int senderTag, int receiverTag);
+	// participant representing all parts of a segment in cross-segment exchanges
+	Participant *generateParticipant(int segmentTag, CommRole role);
+	// participant representing a single local part in intra-segment exchanges
+	Participant *generateParticipant(ScheduledPart *part, CommRole role, int id);
+
+	// returns false if the two regions do not intersect; otherwise writes their intersection on the third argument
+	bool intersect(Range *first, Range *second, Range *intersection);
+	// appends the pieces of a region that are outside another region in the list
+	void subtract(Range *region, Range *cut, List<Range*> *remainder);
+	MultidimensionalIntervalSeq *generateRegionSeq(Range *region);
+};
+
+#endif
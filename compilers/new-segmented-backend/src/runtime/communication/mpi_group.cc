@@ -6,28 +6,34 @@
 #include <vector>
 
 #include "mpi_group.h"
+#include "../common/task_launch.h"
 
 using namespace std;
 
+// MPI is assumed to be used by only one thread at a time unless the program's main function says otherwise
+int MpiThreadSupport::providedLevel = MPI_THREAD_SINGLE;
+
 SegmentGroup::SegmentGroup() {
         mpiCommunicator = MPI_COMM_NULL;
+	ownsCommunicator = false;
 }
 
 void SegmentGroup::discoverGroupAndSetupCommunicator(std::ofstream &log) {
 	
 	// determine the global process rank of the current segment
 	int segmentRank;
-        MPI_Comm_rank(MPI_COMM_WORLD, &segmentRank);
+        MPI_Comm_rank(ExecutionContext::getCommunicator(), &segmentRank);
 	
 	// first try to create a new communicator by having all participating segments trying to split the default
 	// communicator using a single color; non-participating segments will call the exclude function
 	int color = 0;
-	int status = MPI_Comm_split(MPI_COMM_WORLD, color, segmentRank, &mpiCommunicator);
+	int status = MPI_Comm_split(ExecutionContext::getCommunicator(), color, segmentRank, &mpiCommunicator);
 	if (status != MPI_SUCCESS) {
 		log << "\tcould not create a new communicator for the group\n";
 		log.flush();
 		exit(EXIT_FAILURE);
 	}
+	ownsCommunicator = true;
 	
         int groupRank, groupSize;
         MPI_Comm_rank(mpiCommunicator, &groupRank);
@@ -52,26 +58,34 @@ void SegmentGroup::discoverGroupAndSetupCommunicator(std::ofstream &log) {
 SegmentGroup::SegmentGroup(vector<int> segments) {
         this->segments = vector<int>(segments);
         this->segmentRanks = vector<int>(segments);
-        mpiCommunicator = MPI_COMM_WORLD;
+        mpiCommunicator = ExecutionContext::getCommunicator();
+	ownsCommunicator = false;
+}
+
+SegmentGroup::~SegmentGroup() {
+	if (ownsCommunicator && mpiCommunicator != MPI_COMM_NULL) {
+		MPI_Comm_free(&mpiCommunicator);
+	}
 }
 
 void SegmentGroup::setupCommunicator(std::ofstream &log) {
 
         int segmentRank, segmentCount;
-        MPI_Comm_rank(MPI_COMM_WORLD, &segmentRank);
-	MPI_Comm_size(MPI_COMM_WORLD, &segmentCount);
+        MPI_Comm_rank(ExecutionContext::getCommunicator(), &segmentRank);
+	MPI_Comm_size(ExecutionContext::getCommunicator(), &segmentCount);
         
 	int participants = segments.size();
 	if (participants == segmentCount) return;
 
 	// the ID of the communicator group is the ID of the first segment; this gives individual groups their unique IDs
 	int color = segments.at(0);
-	int status = MPI_Comm_split(MPI_COMM_WORLD, color, segmentRank, &mpiCommunicator);
+	int status = MPI_Comm_split(ExecutionContext::getCommunicator(), color, segmentRank, &mpiCommunicator);
 	if (status != MPI_SUCCESS) {
 		log << "\tcould not create a new communicator for the group\n";
 		log.flush();
 		exit(EXIT_FAILURE);
 	}
+	ownsCommunicator = true;
 
         int groupRank;
         MPI_Comm_rank(mpiCommunicator, &groupRank);
@@ -116,7 +130,7 @@ void SegmentGroup::describe(std::ostream &stream) {
 
 void SegmentGroup::excludeSegmentFromGroupSetup(int segmentId, std::ofstream &log) {
 	MPI_Comm nullComm;
-	int status = MPI_Comm_split(MPI_COMM_WORLD, MPI_UNDEFINED, segmentId, &nullComm);
+	int status = MPI_Comm_split(ExecutionContext::getCommunicator(), MPI_UNDEFINED, segmentId, &nullComm);
 	if (status != MPI_SUCCESS) {
 		log << '\t' << segmentId << ": could not exclude myself from the restricted communicator\n";
 		log.flush();
@@ -1,7 +1,7 @@
 #ifndef _H_mpi_group
 #define _H_mpi_group
 
-// this sole class in this header is used to manage an exclusive MPI-communicator per dependency arc for interacting segments
+// the main class in this header is used to manage an exclusive MPI-communicator per dependency arc for interacting segments
 
 #include <mpi.h>
 #include <cstdlib>
@@ -14,6 +14,8 @@ class SegmentGroup {
         std::vector<int> segments;
         std::vector<int> segmentRanks;
         MPI_Comm mpiCommunicator;
+	// a group that has split a communicator of its own out of the invocation's communicator frees it when deleted
+	bool ownsCommunicator;
   public:
 	// constructor and setup function to be used when the current segment is unaware who else will be interacting with it
 	SegmentGroup();
@@ -24,6 +26,10 @@ class SegmentGroup {
         SegmentGroup(std::vector<int> segments);
 	void setupCommunicator(std::ofstream &log);
 
+	// freeing the communicator is a collective operation over the group; so all participants should delete their
+	// group objects in the same order relative to the deletion of other groups
+	~SegmentGroup();
+
         MPI_Comm getCommunicator() { return mpiCommunicator; }
         int getRank(int segmentId);
 	int getSegment(int rank) { return segments.at(rank); }
@@ -32,4 +38,16 @@ class SegmentGroup {
 	static void excludeSegmentFromGroupSetup(int segmentId, std::ofstream &log);
 };
 
+/* The thread support level MPI provides is determined at MPI initialization in the program's main function. Communicators
+ * consult this class to decide if multiple PPU threads can issue MPI calls for them concurrently.
+ * */
+class MpiThreadSupport {
+  private:
+	static int providedLevel;
+  public:
+	static void setProvidedLevel(int level) { providedLevel = level; }
+	static int getProvidedLevel() { return providedLevel; }
+	static bool isMultithreaded() { return providedLevel == MPI_THREAD_MULTIPLE; }
+};
+
 #endif
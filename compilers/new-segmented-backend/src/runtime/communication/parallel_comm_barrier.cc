@@ -14,6 +14,7 @@ ParallelCommBarrier::ParallelCommBarrier(int size) {
         _signalList = new List<SignalType>;
 	_activeSignals = 0;
         _iterationNo = 0;
+	_parallelTransfer = false;
 	pthread_barrier_init(&_barrier, NULL, _size);	
 }
 
@@ -51,6 +52,12 @@ void ParallelCommBarrier::wait(SignalType signal, int callerIterationNo) {
                         }
                 }
 
+		// determine if the data transfer should be divided among the participants before releasing them
+		_parallelTransfer = false;
+		if (_size > 1 && shouldPerformTransfer(_activeSignals, callerIterationNo)) {
+			_parallelTransfer = isTransferParallel();
+		}
+
 		// join the barrier to let all participants determine if a transfer should take place 
 		pthread_barrier_wait(&_barrier);
 		if (shouldPerformTransfer(_activeSignals, callerIterationNo)) {
@@ -66,8 +73,13 @@ void ParallelCommBarrier::wait(SignalType signal, int callerIterationNo) {
 			gettimeofday(&end, NULL);
 			recordTimingLog(BEFORE_TRANSFER_TIMING, start, end);
 
-			// perform data transfer
+			// perform data transfer; if the transfer is parallel then do the current thread's share of it
+			// and wait for other participants to finish theirs before doing any remaining sequential part
 			gettimeofday(&start, NULL);
+			if (_parallelTransfer) {
+				parallelTransferFunction(order, _size);
+				pthread_barrier_wait(&_barrier);
+			}
 			transferFunction();
 			gettimeofday(&end, NULL);
 			recordTimingLog(TRANSFER_TIMING, start, end);
@@ -104,6 +116,12 @@ void ParallelCommBarrier::wait(SignalType signal, int callerIterationNo) {
 			// wait on the barrier again to indicate that processing is done for the current thread
 			pthread_barrier_wait(&_barrier);
 
+			// participate in the parallel data transfer, if applicable
+			if (_parallelTransfer) {
+				parallelTransferFunction(order, _size);
+				pthread_barrier_wait(&_barrier);
+			}
+
 			// wait again on the barrier for the last thread to complete data transfer so that 
 			// after-transfer processing can be started
 			pthread_barrier_wait(&_barrier);
@@ -133,6 +151,12 @@ bool ParallelCommBarrier::shouldWait(SignalType signal, int callerIterationNo) {
 // There is no before transfer operation by default
 void ParallelCommBarrier::beforeTransfer(int order, int participants) {}
 
+// By default the data transfer is done by a single thread
+bool ParallelCommBarrier::isTransferParallel() { return false; }
+
+// Hence there is no parallel data transfer operation by default
+void ParallelCommBarrier::parallelTransferFunction(int order, int participants) {}
+
 // There is no after transfer operation by default either
 void ParallelCommBarrier::afterTransfer(int order, int participants) {}
 
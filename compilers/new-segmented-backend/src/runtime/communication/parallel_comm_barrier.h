@@ -9,6 +9,11 @@
  * proper parts in the receiver side part-container tree. Among these three broad operations, the first and 
  * the last are parallelizable. This extension allows subclasses to provide parallel implementations for those
  * two steps that are called at proper time during the waiting process.
+ *
+ * When the MPI library supports concurrent calls from multiple threads, the MPI communication itself can be divided
+ * among the participants too. A subclass can opt for that by overriding the isTransferParallel() function. Then all 
+ * participants invoke the parallelTransferFunction() before the last participant invokes the transferFunction() to 
+ * do any remaining sequential part of the transfer.
  */
 
 #include "comm_barrier.h"
@@ -30,6 +35,7 @@ class ParallelCommBarrier {
 	int _activeSignals;		// How many of the received signals requesting a communication
         int _iterationNo;               // How many times the barrier has been reset/reused so far
 	pthread_barrier_t _barrier;	// Internal barrier needed for stepping through different phases
+	bool _parallelTransfer;		// Indicates if the participants should split the current data transfer 
   public:	
 	ParallelCommBarrier(int size);
         virtual ~ParallelCommBarrier();
@@ -58,6 +64,14 @@ class ParallelCommBarrier {
 	// function to be extended by subclasses to do the data transfer
 	virtual void transferFunction() = 0;
 
+	// function to be extended by subclasses that can divide the data transfer among the participants; it is invoked
+	// once per transfer by the last participant before others are released for the before-transfer processing
+	virtual bool isTransferParallel();
+
+	// function to be extended by subclasses to do the part of the data transfer assigned to a participant; it is 
+	// invoked by all participants after the before-transfer processing when the transfer is parallel
+	virtual void parallelTransferFunction(int order, int participants);
+
 	// function to be extended by subclasses to distribute any parallelizable post processing step
 	virtual void afterTransfer(int order, int participants);
 
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 
 using namespace std;
 
@@ -469,3 +470,173 @@ void HybridBranchingContainer::addSegmentTag(int segmentTag, bool leafLevelTag)
 	if (leafLevelTag) leaf->addSegmentTag(segmentTag);
 	Container::addSegmentTag(segmentTag);
 }
+
+//-------------------------------------------------- Segment Neighbourhood ---------------------------------------------------/
+
+SegmentNeighbourhood::SegmentNeighbourhood(int dimensionality) {
+	this->dimensionality = dimensionality;
+	this->localRegions = new List<Range*>;
+	this->localHull = NULL;
+	this->filtering = true;
+	this->scratchRegion = new Range[dimensionality];
+	this->scratchDimIds = new List<int>;
+	this->scratchLpsDimensions = 0;
+	this->scratchLpuMin = NULL;
+	this->scratchLpuMax = NULL;
+}
+
+SegmentNeighbourhood::~SegmentNeighbourhood() {
+	while (localRegions->NumElements() > 0) {
+		Range *region = localRegions->Nth(0);
+		localRegions->RemoveAt(0);
+		delete[] region;
+	}
+	delete localRegions;
+	if (localHull != NULL) delete[] localHull;
+	delete[] scratchRegion;
+	delete scratchDimIds;
+	if (scratchLpuMin != NULL) delete[] scratchLpuMin;
+	if (scratchLpuMax != NULL) delete[] scratchLpuMax;
+}
+
+void SegmentNeighbourhood::checkPartitionConfig(DataPartitionConfig *partConfig) {
+	int lastLevel = partConfig->getPartIdLevels() - 1;
+	for (int d = 0; d < dimensionality; d++) {
+		if (partConfig->getDimensionConfig(d)->hasReorderedIndices(lastLevel)) {
+			filtering = false;
+			return;
+		}
+	}
+}
+
+void SegmentNeighbourhood::addLocalPart(DataPartitionConfig *partConfig, List<int*> *partId) {
+	Range *region = new Range[dimensionality];
+	getPartRegion(partConfig, partId, region);
+	localRegions->Append(region);
+	if (localHull == NULL) {
+		localHull = new Range[dimensionality];
+		for (int d = 0; d < dimensionality; d++) localHull[d] = region[d];
+		return;
+	}
+	for (int d = 0; d < dimensionality; d++) {
+		localHull[d].min = std::min(localHull[d].min, region[d].min);
+		localHull[d].max = std::max(localHull[d].max, region[d].max);
+	}
+}
+
+bool SegmentNeighbourhood::overlapsLocalParts(DataPartitionConfig *partConfig, List<int*> *partId) {
+	if (localHull == NULL) return false;
+	getPartRegion(partConfig, partId, scratchRegion);
+	return overlapsLocalRegions(scratchRegion);
+}
+
+bool SegmentNeighbourhood::overlapsLocalParts(DataPartitionConfig *partConfig, 
+		int lpsDimensions, int *lpuCounts, LpuIdRange lpuIdRange) {
+	if (localHull == NULL || lpuIdRange.startId == INVALID_ID) return false;
+	if (lpsDimensions > scratchLpsDimensions) {
+		if (scratchLpuMin != NULL) delete[] scratchLpuMin;
+		if (scratchLpuMax != NULL) delete[] scratchLpuMax;
+		scratchLpuMin = new int[lpsDimensions];
+		scratchLpuMax = new int[lpsDimensions];
+		scratchLpsDimensions = lpsDimensions;
+	}
+	return overlapsLocalParts(partConfig, lpsDimensions, lpuCounts, 0, lpuIdRange.startId, lpuIdRange.endId);
+}
+
+void SegmentNeighbourhood::getPartRegion(DataPartitionConfig *partConfig, List<int*> *partId, Range *region) {
+	int levels = partId->NumElements();
+	for (int d = 0; d < dimensionality; d++) {
+		scratchDimIds->clear();
+		for (int l = 0; l < levels; l++) {
+			scratchDimIds->Append(partId->Nth(l)[d]);
+		}
+		Range range = partConfig->getDimensionConfig(d)->getPartDimension(scratchDimIds).range;
+		// dimensions may be decreasing; the region is kept in increasing order for the overlap checks
+		region[d].min = std::min(range.min, range.max);
+		region[d].max = std::max(range.min, range.max);
+	}
+}
+
+bool SegmentNeighbourhood::overlapsLocalRegions(Range *region) {
+	for (int d = 0; d < dimensionality; d++) {
+		if (region[d].max < localHull[d].min || region[d].min > localHull[d].max) return false;
+	}
+	for (int i = 0; i < localRegions->NumElements(); i++) {
+		Range *localRegion = localRegions->Nth(i);
+		bool regionOverlaps = true;
+		for (int d = 0; d < dimensionality; d++) {
+			if (region[d].max < localRegion[d].min || region[d].min > localRegion[d].max) {
+				regionOverlaps = false;
+				break;
+			}
+		}
+		if (regionOverlaps) return true;
+	}
+	return false;
+}
+
+bool SegmentNeighbourhood::overlapsLocalParts(DataPartitionConfig *partConfig, 
+		int lpsDimensions, int *lpuCounts, 
+		int dimension, int startId, int endId) {
+
+	// along the last dimension, the LPUs of the range form a single box 
+	if (dimension == lpsDimensions - 1) {
+		scratchLpuMin[dimension] = startId;
+		scratchLpuMax[dimension] = endId;
+		return lpuBoxOverlapsLocalParts(partConfig);
+	}
+
+	// otherwise, the range spans one or more slices along the current dimension
+	int lpusPerSlice = 1;
+	for (int d = dimension + 1; d < lpsDimensions; d++) lpusPerSlice *= lpuCounts[d];
+	int firstSlice = startId / lpusPerSlice;
+	int lastSlice = endId / lpusPerSlice;
+	int startInSlice = startId % lpusPerSlice;
+	int endInSlice = endId % lpusPerSlice;
+	if (firstSlice == lastSlice) {
+		scratchLpuMin[dimension] = firstSlice;
+		scratchLpuMax[dimension] = firstSlice;
+		return overlapsLocalParts(partConfig, lpsDimensions, lpuCounts, dimension + 1, startInSlice, endInSlice);
+	}
+
+	// the first and the last slices may be covered partially; they are broken further
+	if (startInSlice != 0) {
+		scratchLpuMin[dimension] = firstSlice;
+		scratchLpuMax[dimension] = firstSlice;
+		if (overlapsLocalParts(partConfig, lpsDimensions, lpuCounts, 
+				dimension + 1, startInSlice, lpusPerSlice - 1)) {
+			return true;
+		}
+		firstSlice++;
+	}
+	if (endInSlice != lpusPerSlice - 1) {
+		scratchLpuMin[dimension] = lastSlice;
+		scratchLpuMax[dimension] = lastSlice;
+		if (overlapsLocalParts(partConfig, lpsDimensions, lpuCounts, dimension + 1, 0, endInSlice)) {
+			return true;
+		}
+		lastSlice--;
+	}
+
+	// the slices in between are covered in full and form a single box
+	if (firstSlice > lastSlice) return false;
+	scratchLpuMin[dimension] = firstSlice;
+	scratchLpuMax[dimension] = lastSlice;
+	for (int d = dimension + 1; d < lpsDimensions; d++) {
+		scratchLpuMin[d] = 0;
+		scratchLpuMax[d] = lpuCounts[d] - 1;
+	}
+	return lpuBoxOverlapsLocalParts(partConfig);
+}
+
+bool SegmentNeighbourhood::lpuBoxOverlapsLocalParts(DataPartitionConfig *partConfig) {
+	for (int d = 0; d < dimensionality; d++) {
+		DimPartitionConfig *dimConfig = partConfig->getDimensionConfig(d);
+		Dimension dataDimension = dimConfig->getDataDimension();
+		Range first = dimConfig->getPartDimension(dimConfig->pickPartId(scratchLpuMin), dataDimension).range;
+		Range last = dimConfig->getPartDimension(dimConfig->pickPartId(scratchLpuMax), dataDimension).range;
+		scratchRegion[d].min = std::min(std::min(first.min, first.max), std::min(last.min, last.max));
+		scratchRegion[d].max = std::max(std::max(first.min, first.max), std::max(last.min, last.max));
+	}
+	return overlapsLocalRegions(scratchRegion);
+}
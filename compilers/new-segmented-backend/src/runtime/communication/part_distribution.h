@@ -12,6 +12,7 @@
 
 #include "part_folding.h"
 #include "../memory-management/part_tracking.h"
+#include "../memory-management/part_generation.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/hashtable.h"
@@ -182,6 +183,65 @@ class HybridBranchingContainer : public BranchingContainer {
 	void addSegmentTag(int segmentTag, bool leafLevelTag);
 };
 
+/* A distribution tree holding the parts of all segments grows with the total number of parts in the machine; and so does
+ * the work of intersecting its branches during confinement construction. Yet a segment exchanges data only with segments
+ * holding a part whose (padded) region overlaps the region of one of its own parts. This class records the regions of
+ * the local segment's parts so that the distribution tree generator can skip the parts of all other segments. As the
+ * overlap relation is symmetric, two neighbouring segments still find each other in their trees; and since a neighbour's
+ * parts are inserted in full, their exchanges are the same as they would be in the complete tree.
+ *
+ * The regions are computed in the original index space; so the filtering is not possible when a partition function in
+ * the hierarchy reorders the indices of a dimension. The generator should further not use a neighbourhood for variables
+ * having up or down propagation synchronizations as the communicators for those need all participants of the tree.
+ * */
+class SegmentNeighbourhood {
+  protected:
+	int dimensionality;
+	// padded regions of the local segment's parts, one range per data dimension for each part
+	List<Range*> *localRegions;
+	// the bounding box of all local regions to quickly discard parts lying far away from the segment
+	Range *localHull;
+	bool filtering;
+	// scratch space for the overlap checks, which are done for many parts of other segments
+	Range *scratchRegion;
+	List<int> *scratchDimIds;
+	int scratchLpsDimensions;
+	int *scratchLpuMin;
+	int *scratchLpuMax;
+  public:
+	SegmentNeighbourhood(int dimensionality);
+	~SegmentNeighbourhood();
+
+	// disables the filtering if the partition configuration of any LPS reorders data indices
+	void checkPartitionConfig(DataPartitionConfig *partConfig);
+	bool isFiltering() { return filtering; }
+
+	// records the region of a part of the local segment
+	void addLocalPart(DataPartitionConfig *partConfig, List<int*> *partId);
+	// tells if the region of a part of some other segment overlaps the region of any local part
+	bool overlapsLocalParts(DataPartitionConfig *partConfig, List<int*> *partId);
+
+	// Tells if any part a thread of some other segment holds in an LPS overlaps the region of a local part. The parts
+	// are given by the range of linear LPU Ids the thread gets from the LPS and the LPU counts of the LPS, and are 
+	// checked without generating their Ids one by one. The range is broken into boxes of LPUs and, as the regions of
+	// consecutive parts are consecutive, the union of the regions of the parts of a box is a single region that 
+	// follows from the parts at the corners of the box. So this function is only applicable when the LPS divides the
+	// variable once, i.e., the variable has not been partitioned in any ancestor LPS, without reordering indices.
+	bool overlapsLocalParts(DataPartitionConfig *partConfig, 
+			int lpsDimensions, int *lpuCounts, LpuIdRange lpuIdRange);
+  private:
+	void getPartRegion(DataPartitionConfig *partConfig, List<int*> *partId, Range *region);
+	bool overlapsLocalRegions(Range *region);
+	// a recursive helper for the LPU Id range based check above; it breaks the part of the range that lies in the
+	// sub-space of the LPS dimensions from the argument dimension onward into boxes and checks them one by one; the
+	// box limits along the earlier dimensions should already be set
+	bool overlapsLocalParts(DataPartitionConfig *partConfig, 
+			int lpsDimensions, int *lpuCounts, 
+			int dimension, int startId, int endId);
+	// checks the union of the regions of the parts in the current box of LPUs
+	bool lpuBoxOverlapsLocalParts(DataPartitionConfig *partConfig);
+};
+
 /* This is a holder class to be used at runtime to save and access part distribution trees of all data structures for a task 
 */
 class PartDistributionMap {
@@ -192,6 +252,11 @@ class PartDistributionMap {
 		distributionMap = new Hashtable<Container*>; 
 	}
 	~PartDistributionMap() { 
+		Iterator<Container*> iterator = distributionMap->GetIterator();
+		Container *distributionTree;
+		while ((distributionTree = iterator.GetNextValue()) != NULL) {
+			delete distributionTree;
+		}
 		delete distributionMap; 
 	}
 	void setupNewDistributionForVariable(const char *varName) {
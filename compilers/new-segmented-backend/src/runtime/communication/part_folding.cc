@@ -371,11 +371,11 @@ List<DimensionFold*> *DimensionFold::branchOut(DataItemConfig *dataConfig, vecto
 		PartitionInstr *instr = dataConfig->getInstruction(updatePoint, dimNo);
 		instr->setPartId(idRange.min);
 		int minId = idRange.min;
-		int lastDimensionLength = instr->getDimension().length;
+		GlobalIndex lastDimensionLength = instr->getDimension().length;
 		// go over the individual parts and see if the dimension lengths are the same
 		for (int i = minId + 1; i <= idRange.max; i++) {
 			instr->setPartId(i);
-			int currDimensionLength = instr->getDimension().length;
+			GlobalIndex currDimensionLength = instr->getDimension().length;
 			// if there is a change in the dimension length at the id then all previously encountered ids since last sub-
 			// group formation should constitute a new sub-group
 			if (currDimensionLength != lastDimensionLength) {
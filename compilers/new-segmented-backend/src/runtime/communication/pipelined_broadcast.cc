@@ -0,0 +1,83 @@
+#include "pipelined_broadcast.h"
+
+#include <vector>
+#include <mpi.h>
+
+using namespace std;
+
+PipelinedBroadcast::PipelinedBroadcast(MPI_Comm mpiComm, int participants, int myRank) {
+	this->mpiComm = mpiComm;
+	this->participants = participants;
+	this->myRank = myRank;
+}
+
+bool PipelinedBroadcast::broadcast(char *data, long int size, int root, BroadcastChunkHandler *handler) {
+
+	if (size <= PIPELINED_BCAST_CHUNK_SIZE) {
+		int status = MPI_Bcast(data, size, MPI_CHAR, root, mpiComm);
+		if (status != MPI_SUCCESS) return false;
+		if (handler != NULL && myRank != root) handler->processReceivedPrefix(size);
+		return true;
+	}
+
+	// In a binomial tree the parent of a participant is found by clearing the lowest set bit of its tree rank and its
+	// children are at the distances of the lower powers of two. The root has no set bit; so all powers of two below
+	// the participants count are children distances for it. The farthest child is served first as it heads the
+	// largest subtree.
+	int treeRank = getTreeRank(myRank, root);
+	int lowestBit = 1;
+	while (lowestBit < participants && (treeRank & lowestBit) == 0) lowestBit <<= 1;
+	int parent = (treeRank == 0) ? -1 : getMpiRank(treeRank - lowestBit, root);
+	vector<int> children;
+	for (int distance = lowestBit >> 1; distance > 0; distance >>= 1) {
+		if (treeRank + distance < participants) {
+			children.push_back(getMpiRank(treeRank + distance, root));
+		}
+	}
+
+	int chunkCount = (size + PIPELINED_BCAST_CHUNK_SIZE - 1) / PIPELINED_BCAST_CHUNK_SIZE;
+
+	// receives for all chunks are posted upfront so that the chunks can arrive while earlier ones are forwarded and
+	// processed; MPI's non-overtaking rule ensures the chunks are matched with the receives in order
+	vector<MPI_Request> receiveRequests;
+	if (parent != -1) {
+		receiveRequests.resize(chunkCount);
+		for (int i = 0; i < chunkCount; i++) {
+			long int offset = i * PIPELINED_BCAST_CHUNK_SIZE;
+			int chunkSize = (size - offset < PIPELINED_BCAST_CHUNK_SIZE)
+					? size - offset : PIPELINED_BCAST_CHUNK_SIZE;
+			int status = MPI_Irecv(data + offset, chunkSize, MPI_CHAR,
+					parent, PIPELINED_BCAST_TAG, mpiComm, &receiveRequests[i]);
+			if (status != MPI_SUCCESS) return false;
+		}
+	}
+
+	vector<MPI_Request> sendRequests;
+	sendRequests.reserve(chunkCount * children.size());
+	for (int i = 0; i < chunkCount; i++) {
+		long int offset = i * PIPELINED_BCAST_CHUNK_SIZE;
+		int chunkSize = (size - offset < PIPELINED_BCAST_CHUNK_SIZE) ? size - offset : PIPELINED_BCAST_CHUNK_SIZE;
+		if (parent != -1) {
+			int status = MPI_Wait(&receiveRequests[i], MPI_STATUS_IGNORE);
+			if (status != MPI_SUCCESS) return false;
+		}
+		for (unsigned int j = 0; j < children.size(); j++) {
+			MPI_Request request;
+			int status = MPI_Isend(data + offset, chunkSize, MPI_CHAR,
+					children[j], PIPELINED_BCAST_TAG, mpiComm, &request);
+			if (status != MPI_SUCCESS) return false;
+			sendRequests.push_back(request);
+		}
+
+		// the chunk is processed only after it has been forwarded so that the children do not wait on it
+		if (parent != -1 && handler != NULL) {
+			handler->processReceivedPrefix(offset + chunkSize);
+		}
+	}
+
+	if (sendRequests.size() > 0) {
+		int status = MPI_Waitall(sendRequests.size(), &sendRequests[0], MPI_STATUSES_IGNORE);
+		if (status != MPI_SUCCESS) return false;
+	}
+	return true;
+}
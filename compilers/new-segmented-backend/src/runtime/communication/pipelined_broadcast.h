@@ -0,0 +1,50 @@
+#ifndef _H_pipelined_broadcast
+#define _H_pipelined_broadcast
+
+/* A single MPI_Bcast of a large communication buffer leaves the receivers idle until the whole buffer has arrived and
+ * only then they can start writing its content into the operating memory data parts. Furthermore, the intermediate
+ * segments of the broadcast tree cannot forward any part of the buffer before they have received all of it in many
+ * MPI implementations. This header provides a segmented broadcast that splits the buffer into fixed size chunks and
+ * sends them down a binomial tree rooted at the broadcasting segment. A segment forwards a chunk to its children as
+ * soon as it has received it; so successive chunks flow through different levels of the tree at the same time. A
+ * receiver can further have the chunks that have already arrived processed while the rest are still in transit.
+ * */
+
+#include <mpi.h>
+
+// tag used for the chunk messages of a pipelined broadcast; like the shared memory handshake tags this is kept at the
+// higher end of the tag range MPI guarantees to be valid
+const int PIPELINED_BCAST_TAG = 32003;
+
+// the size of the chunks of a pipelined broadcast in bytes; buffers that fit in a single chunk are broadcast with a
+// regular MPI_Bcast as there is nothing to pipeline then
+const long int PIPELINED_BCAST_CHUNK_SIZE = 64 * 1024;
+
+/* Interface for the receiver side processing of a pipelined broadcast. The broadcast calls the function in this class
+ * each time a new chunk has arrived with the number of bytes at the beginning of the buffer received so far.
+ * */
+class BroadcastChunkHandler {
+  public:
+	virtual ~BroadcastChunkHandler() {}
+	virtual void processReceivedPrefix(long int bytesReceived) = 0;
+};
+
+class PipelinedBroadcast {
+  private:
+	MPI_Comm mpiComm;
+	int participants;
+	int myRank;
+  public:
+	PipelinedBroadcast(MPI_Comm mpiComm, int participants, int myRank);
+
+	// Broadcasts the argument buffer from the root rank to all other ranks in the communicator. All participants
+	// should call this function with the same buffer size and root. The handler, if provided, is invoked only in the
+	// receivers; it returns false if the broadcast failed.
+	bool broadcast(char *data, long int size, int root, BroadcastChunkHandler *handler = NULL);
+  private:
+	// the rank of a participant in the binomial tree rooted at the broadcaster and the reverse translation
+	int getTreeRank(int rank, int root) { return (rank - root + participants) % participants; }
+	int getMpiRank(int treeRank, int root) { return (treeRank + root) % participants; }
+};
+
+#endif
@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <iostream>
+#include <cstring>
 #include <mpi.h>
 
 using namespace std;
@@ -24,6 +25,46 @@ ScalarCommunicator::ScalarCommunicator(int localSegmentTag,
 	this->hasLocalSender = localSenderPpus > 0;
 	this->hasLocalReceiver = localReceiverPpus > 0;
 	this->active = false;
+	this->packedBuffer = NULL;
+}
+
+void ScalarCommunicator::setDataBufferReference(void *dataBuffer) {
+	if (variableReferences.size() == 0) {
+		variableReferences.push_back(reinterpret_cast<char*>(dataBuffer));
+		variableSizes.push_back(dataSize);
+	} else variableReferences[0] = reinterpret_cast<char*>(dataBuffer);
+	if (packedBuffer == NULL) this->dataBuffer = reinterpret_cast<char*>(dataBuffer);
+}
+
+void ScalarCommunicator::addBatchedVariable(void *variableReference, int variableSize) {
+	
+	Assert(variableReferences.size() > 0);
+	variableReferences.push_back(reinterpret_cast<char*>(variableReference));
+	variableSizes.push_back(variableSize);
+
+	// the transfer now goes through a packed buffer large enough for all variables
+	dataSize += variableSize;
+	if (packedBuffer != NULL) delete[] packedBuffer;
+	packedBuffer = new char[dataSize];
+	dataBuffer = packedBuffer;
+}
+
+void ScalarCommunicator::packVariables() {
+	if (packedBuffer == NULL) return;
+	int offset = 0;
+	for (unsigned int i = 0; i < variableReferences.size(); i++) {
+		memcpy(packedBuffer + offset, variableReferences[i], variableSizes[i]);
+		offset += variableSizes[i];
+	}
+}
+
+void ScalarCommunicator::unpackVariables() {
+	if (packedBuffer == NULL) return;
+	int offset = 0;
+	for (unsigned int i = 0; i < variableReferences.size(); i++) {
+		memcpy(variableReferences[i], packedBuffer + offset, variableSizes[i]);
+		offset += variableSizes[i];
+	}
 }
 
 void ScalarCommunicator::setupCommunicator(bool includeNonInteractingSegments) {
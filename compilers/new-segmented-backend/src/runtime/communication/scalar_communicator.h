@@ -13,10 +13,18 @@
 
 class ScalarCommunicator : public Communicator {
   protected:
-	// property holding memory reference of the scalar variable 
+	// property holding memory reference of the scalar variable or the packed buffer of a batch of variables
 	char *dataBuffer;
-	// size of the scalar variable in terms of number of characters
+	// size of the scalar variable or the batch in terms of number of characters
 	int dataSize;
+
+	// The compiler may have the communicator synchronize several scalar variables that are updated and waited on at
+	// the same places in a single message. Then the properties above refer to a packed buffer holding the content of
+	// all variables and the following properties refer to the variables themselves. The first variable is the one
+	// the communicator has been created for.
+	std::vector<char*> variableReferences;
+	std::vector<int> variableSizes;
+	char *packedBuffer;
 	// the communicator is not active when there is none except the current segment participating in synchronization
 	bool active;
 	// tags of sender and receiver segments
@@ -31,11 +39,14 @@ class ScalarCommunicator : public Communicator {
 		int localSenderPpus,
 		int localReceiverPpus, 
 		int dataSize);
-	virtual ~ScalarCommunicator() {}
+	virtual ~ScalarCommunicator() { if (packedBuffer != NULL) delete[] packedBuffer; }
 
 	// before a data send/receive the memory address of the scalar variable should be copied into the communicator
 	// using this funtion
-	void setDataBufferReference(void *dataBuffer) { this->dataBuffer = reinterpret_cast<char*>(dataBuffer); }
+	void setDataBufferReference(void *dataBuffer);
+
+	// adds another scalar variable to be synchronized along with the one the communicator has been created for
+	void addBatchedVariable(void *variableReference, int variableSize);
 
 	// MPI communicator setup process should be updated for scaler IT communicators as they do not involve processing
 	// of communication buffers in search of participating segments  
@@ -48,8 +59,8 @@ class ScalarCommunicator : public Communicator {
 	// since there is just one instance of each scalar variable; local data interchange is inapplicable for them; the
 	// send and receive data functions should only be used when there are other participating segments (when the 
 	// active flag is true); so override has been provided to do actual transfers only in multi-party situations. 
-	void sendData() { if (active) send(); }
-	void receiveData() { if (active) receive(); }
+	void sendData() { if (active) { packVariables(); send(); } }
+	void receiveData() { if (active) { receive(); unpackVariables(); } }
 
 	// for scalar variables only one of send and receive is enough for synchronization; therefore, the after send
 	// functions increases the iteration number of the communicator to let any subsequent receive request from PPUs
@@ -63,6 +74,10 @@ class ScalarCommunicator : public Communicator {
 	// functions subclasses should override to implement specific forms of scalar synchronization
 	virtual void send() = 0;
 	virtual void receive() = 0;
+  private:
+	// copy the content of a batch of variables to and from the packed buffer; these are no-ops for a single variable
+	void packVariables();
+	void unpackVariables();
 };
 
 // Note that scalar variables are replicated throughout the partition hierarchy. So every update is supposed to be syn-
@@ -0,0 +1,321 @@
+#include "scatter_primitive.h"
+#include "../memory-management/allocation.h"
+#include "../common/task_launch.h"
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <mpi.h>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <semaphore.h>
+
+using namespace std;
+
+// the index range of a data part in the local segment along with the part itself
+class LocalPartRange {
+  public:
+	GlobalIndex min;
+	GlobalIndex max;
+	DataPart *part;
+	bool operator<(const LocalPartRange &other) const { return min < other.min; }
+};
+
+// returns the storage index ranges of the local data parts of the array sorted by their lower bounds
+static vector<LocalPartRange> getLocalPartRanges(DataItems *targetItems) {
+	vector<LocalPartRange> ranges;
+	if (targetItems == NULL || targetItems->isEmpty()) return ranges;
+	List<DataPart*> *partList = targetItems->getAllDataParts();
+	for (int i = 0; i < partList->NumElements(); i++) {
+		DataPart *part = partList->Nth(i);
+		Dimension *boundary = part->getMetadata()->getBoundary();
+		LocalPartRange range;
+		range.min = boundary[0].range.min;
+		range.max = boundary[0].range.max;
+		range.part = part;
+		ranges.push_back(range);
+	}
+	sort(ranges.begin(), ranges.end());
+	return ranges;
+}
+
+// collects the containers of the parts of an LPS from a distribution tree; the LPS's branch may be found below the
+// branches of ancestor LPSes allocating the same array
+static void collectPartContainers(BranchingContainer *container, int lpsId, List<Container*> *containerList) {
+	if (container->getBranch(lpsId) != NULL) {
+		List<Container*> *partContainers = container->listDescendantContainersForLps(lpsId, 0, false);
+		containerList->AppendAll(partContainers);
+		delete partContainers;
+		return;
+	}
+	List<Branch*> *branches = container->getBranches();
+	for (int i = 0; i < branches->NumElements(); i++) {
+		List<Container*> *entries = branches->Nth(i)->getContainerList();
+		for (int j = 0; j < entries->NumElements(); j++) {
+			BranchingContainer *entry = dynamic_cast<BranchingContainer*>(entries->Nth(j));
+			if (entry != NULL) collectPartContainers(entry, lpsId, containerList);
+		}
+		delete entries;
+	}
+}
+
+// returns the position of the last range in a list sorted by lower bounds that starts at or before the index; if
+// there is none then returns -1
+template <class RangeType> static int findLastRangeStartingBy(vector<RangeType> &ranges, GlobalIndex index) {
+	int low = 0, high = ranges.size() - 1, last = -1;
+	while (low <= high) {
+		int mid = (low + high) / 2;
+		if (ranges.at(mid).min <= index) {
+			last = mid;
+			low = mid + 1;
+		} else high = mid - 1;
+	}
+	return last;
+}
+
+//------------------------------------------------------------- Scatter Primitive -------------------------------------------------------------/
+
+ScatterPrimitive::ScatterPrimitive(const char *arrayName, 
+		int elementSize, 
+		int participants,
+		SegmentGroup *participantGroup, 
+		Container *distributionTree, 
+		int lpsId, DataPartitionConfig *partConfig) {
+
+	this->arrayName = arrayName;
+	this->elementSize = elementSize;
+	this->recordSize = sizeof(GlobalIndex) + elementSize;
+	_size = participants;
+	_count = participants;
+	sem_init(&mutex, 0, 1);
+	sem_init(&throttle, 0, 0);
+	sem_init(&waitq, 0, 0);
+	writeBarrier = new Barrier(participants);
+	pthread_key_create(&bufferKey, NULL);
+	pthread_mutex_init(&bufferLock, NULL);
+	receivedCount = 0;
+
+	segmentCount = (participantGroup == NULL) ? 1 : participantGroup->getParticipantsCount();
+	communicator = (segmentCount > 1) ? participantGroup->getCommunicator() : MPI_COMM_NULL;
+	if (segmentCount == 1) return;
+
+	// determine the index ranges of the parts of all segments from the distribution tree; a part shared by several
+	// segments gives a range for each of them
+	BranchingContainer *treeRoot = dynamic_cast<BranchingContainer*>(distributionTree);
+	if (treeRoot == NULL) {
+		cout << "There is no part distribution tree for the scatter on " << arrayName << "\n";
+		exit(EXIT_FAILURE);
+	}
+	List<Container*> *partContainers = new List<Container*>;
+	collectPartContainers(treeRoot, lpsId, partContainers);
+	DimPartitionConfig *dimConfig = partConfig->getDimensionConfig(0);
+	List<int> *partIdList = new List<int>;
+	for (int i = 0; i < partContainers->NumElements(); i++) {
+		Container *container = partContainers->Nth(i);
+		vector<int*> *partId = container->getPartId(1);
+		partIdList->clear();
+		for (unsigned int l = 0; l < partId->size(); l++) {
+			partIdList->Append(partId->at(l)[0]);
+			delete[] partId->at(l);
+		}
+		delete partId;
+		Range partRange = dimConfig->getPartDimension(partIdList).range;
+		vector<int> segmentTags = container->getSegmentTags();
+		for (unsigned int t = 0; t < segmentTags.size(); t++) {
+			SegmentPartRange range;
+			range.min = std::min(partRange.min, partRange.max);
+			range.max = std::max(partRange.min, partRange.max);
+			range.segment = participantGroup->getRank(segmentTags.at(t));
+			if (range.segment < 0) continue;
+			ownerRanges.push_back(range);
+		}
+	}
+	delete partIdList;
+	delete partContainers;
+	sort(ownerRanges.begin(), ownerRanges.end());
+}
+
+ScatterPrimitive::~ScatterPrimitive() {
+	for (unsigned int i = 0; i < threadBuffers.size(); i++) {
+		delete threadBuffers.at(i);
+	}
+	pthread_key_delete(bufferKey);
+	pthread_mutex_destroy(&bufferLock);
+	sem_destroy(&mutex);
+	sem_destroy(&throttle);
+	sem_destroy(&waitq);
+	delete writeBarrier;
+}
+
+ScatterBuffer *ScatterPrimitive::getThreadBuffer() {
+	ScatterBuffer *buffer = (ScatterBuffer*) pthread_getspecific(bufferKey);
+	if (buffer == NULL) {
+		buffer = new ScatterBuffer(elementSize);
+		pthread_setspecific(bufferKey, buffer);
+		pthread_mutex_lock(&bufferLock);
+		threadBuffers.push_back(buffer);
+		pthread_mutex_unlock(&bufferLock);
+	}
+	return buffer;
+}
+
+void ScatterPrimitive::completeScatter(DataItems *targetItems) {
+
+	// the threads get tickets in the order of their arrival that decide which received elements they should write
+	sem_wait(&mutex);
+	_count--;
+	int ticket = _count;
+	if (_count == 0) {
+		exchangeElements();
+		for (int i = 1; i < _size; i++) {
+			sem_post(&waitq);
+			sem_wait(&throttle);
+		}
+		_count = _size;
+		sem_post(&mutex);
+	} else {
+		sem_post(&mutex);
+		sem_wait(&waitq);
+		sem_post(&throttle);
+	}
+
+	writeElements(targetItems, ticket);
+	writeBarrier->wait();
+}
+
+void ScatterPrimitive::exchangeElements() {
+
+	// collect the elements recorded by all local threads
+	int localCount = 0;
+	for (unsigned int i = 0; i < threadBuffers.size(); i++) {
+		localCount += threadBuffers.at(i)->getElementCount();
+	}
+
+	// if there is only one segment then all elements are local and there is nothing to exchange
+	if (segmentCount == 1) {
+		receivedRecords.resize(localCount * recordSize);
+		int position = 0;
+		for (unsigned int i = 0; i < threadBuffers.size(); i++) {
+			ScatterBuffer *buffer = threadBuffers.at(i);
+			int bytes = buffer->getElementCount() * recordSize;
+			if (bytes > 0) memcpy(&receivedRecords[position], buffer->getRecords(), bytes);
+			position += bytes;
+			buffer->clear();
+		}
+		receivedCount = localCount;
+		return;
+	}
+	int segmentId;
+	MPI_Comm_rank(communicator, &segmentId);
+
+	// bucket the records by their destination segments; an index falling within the padding of several parts
+	// goes to all segments holding those parts, but only once to each segment
+	vector< vector<char> > buckets(segmentCount);
+	vector<int> lastDestination(segmentCount, -1);
+	int recordNo = 0;
+	for (unsigned int b = 0; b < threadBuffers.size(); b++) {
+		ScatterBuffer *buffer = threadBuffers.at(b);
+		char *records = buffer->getRecords();
+		int elements = buffer->getElementCount();
+		for (int e = 0; e < elements; e++) {
+			char *record = records + e * recordSize;
+			GlobalIndex index;
+			memcpy(&index, record, sizeof(GlobalIndex));
+
+			// find the last range starting at or before the index then walk backward over the ranges that
+			// contain it; there are more than one such ranges only if the parts have padding
+			int last = findLastRangeStartingBy(ownerRanges, index);
+			bool found = false;
+			for (int r = last; r >= 0; r--) {
+				SegmentPartRange &range = ownerRanges.at(r);
+				if (range.max < index) break;
+				found = true;
+				if (lastDestination[range.segment] == recordNo) continue;
+				lastDestination[range.segment] = recordNo;
+				vector<char> &bucket = buckets[range.segment];
+				bucket.insert(bucket.end(), record, record + recordSize);
+			}
+			if (!found) {
+				cout << "Segment " << segmentId << ": scatter index " << index;
+				cout << " is out of the range of array " << arrayName << "\n";
+				exit(EXIT_FAILURE);
+			}
+			recordNo++;
+		}
+		buffer->clear();
+	}
+
+	// exchange the element counts then the elements themselves
+	vector<int> sendCounts(segmentCount);
+	vector<int> sendDisplacements(segmentCount);
+	int totalSend = 0;
+	for (int s = 0; s < segmentCount; s++) {
+		sendCounts[s] = buckets[s].size();
+		sendDisplacements[s] = totalSend;
+		totalSend += sendCounts[s];
+	}
+	vector<int> receiveCounts(segmentCount);
+	int status = MPI_Alltoall(&sendCounts[0], 1, MPI_INT, &receiveCounts[0], 1, MPI_INT, communicator);
+	if (status != MPI_SUCCESS) {
+		cout << "Segment " << segmentId << ": could not exchange scatter counts for " << arrayName << "\n";
+		exit(EXIT_FAILURE);
+	}
+	vector<int> receiveDisplacements(segmentCount);
+	int totalReceive = 0;
+	for (int s = 0; s < segmentCount; s++) {
+		receiveDisplacements[s] = totalReceive;
+		totalReceive += receiveCounts[s];
+	}
+	vector<char> sendRecords(totalSend + 1);
+	for (int s = 0; s < segmentCount; s++) {
+		if (sendCounts[s] > 0) memcpy(&sendRecords[sendDisplacements[s]], &buckets[s][0], sendCounts[s]);
+	}
+	receivedRecords.resize(totalReceive + 1);
+	status = MPI_Alltoallv(&sendRecords[0], &sendCounts[0], &sendDisplacements[0], MPI_BYTE,
+			&receivedRecords[0], &receiveCounts[0], &receiveDisplacements[0], MPI_BYTE, communicator);
+	if (status != MPI_SUCCESS) {
+		cout << "Segment " << segmentId << ": could not exchange scatter elements for " << arrayName << "\n";
+		exit(EXIT_FAILURE);
+	}
+	receivedCount = totalReceive / recordSize;
+}
+
+void ScatterPrimitive::writeElements(DataItems *targetItems, int ticket) {
+
+	// each thread writes a contiguous block of the received elements
+	int blockSize = (receivedCount + _size - 1) / _size;
+	int begin = ticket * blockSize;
+	int end = min(receivedCount, begin + blockSize);
+	if (begin >= end) return;
+
+	vector<LocalPartRange> localRanges = getLocalPartRanges(targetItems);
+	for (int e = begin; e < end; e++) {
+		char *record = &receivedRecords[e * recordSize];
+		GlobalIndex index;
+		memcpy(&index, record, sizeof(GlobalIndex));
+
+		// an index may be in the padding of multiple local parts; all of them should be updated
+		int last = findLastRangeStartingBy(localRanges, index);
+		bool found = false;
+		for (int r = last; r >= 0; r--) {
+			LocalPartRange &range = localRanges.at(r);
+			if (range.max < index) break;
+			found = true;
+			char *data = reinterpret_cast<char*>(range.part->getData());
+			memcpy(data + (index - range.min) * elementSize, record + sizeof(GlobalIndex), elementSize);
+		}
+
+		// received elements have been routed to their owner segments already, so a miss is possible only when
+		// there is a single segment and the exchange did not check the indexes
+		if (!found) {
+			int segmentId;
+			MPI_Comm_rank(ExecutionContext::getCommunicator(), &segmentId);
+			cout << "Segment " << segmentId << ": scatter index " << index;
+			cout << " is out of the range of array " << arrayName << "\n";
+			exit(EXIT_FAILURE);
+		}
+	}
+}
@@ -0,0 +1,121 @@
+#ifndef _H_scatter_primitive
+#define _H_scatter_primitive
+
+/* This header provides the runtime support for IT's scatter(array, index, value) library function. A scatter is an
+ * index-driven write: the element to be updated is determined by a computed index, not by the LPU being executed. So
+ * the update may target a part of the array residing in another segment. Doing such writes one element at a time
+ * over MPI is hopeless. Rather, the translated code of a compute stage only records the (index, value) pairs of its
+ * scatters in a buffer private to the PPU controller thread. When all PPU controllers of a segment are done with the
+ * LPUs of the LPS the stage executes in, they call the completeScatter() function of the primitive. The last thread to
+ * enter buckets all recorded elements by the segments holding their destination indices and exchanges them with one
+ * MPI_Alltoallv. Then all participant threads write the received elements to the local data parts in parallel.
+ *
+ * As all writes happen after all reads of the stage are done, a scatter into the array the stage reads from, as it
+ * happens in a permutation, is safe. The order of writes to the same index is, however, undefined.
+ *
+ * The current implementation supports only one-dimensional arrays whose partition functions do not reorder indices, as
+ * a reordering partition function does not retain contiguous index ranges. The owners of the indices are determined
+ * from the index ranges of the parts in the array's part distribution tree when the primitive is created.
+ *
+ * The task's execute function creates a primitive for each scatter call site in every invocation and releases it with
+ * the invocation. Only the segments participating in the task take part in the exchange; so the primitive uses the
+ * communicator of the group of participating segments.
+ */
+
+#include "part_distribution.h"
+#include "mpi_group.h"
+#include "../memory-management/part_management.h"
+#include "../memory-management/part_generation.h"
+#include "../common/sync.h"
+
+#include <mpi.h>
+#include <vector>
+#include <cstring>
+#include <pthread.h>
+#include <semaphore.h>
+
+/* The buffer of scatter elements of a single PPU controller thread; each element is stored as a record of the index
+ * followed by the bytes of the value
+ */
+class ScatterBuffer {
+  private:
+	int elementSize;
+	std::vector<char> records;
+  public:
+	ScatterBuffer(int elementSize) { this->elementSize = elementSize; }
+	template <class T> void addElement(GlobalIndex index, T value) {
+		size_t position = records.size();
+		records.resize(position + sizeof(GlobalIndex) + elementSize);
+		memcpy(&records[position], &index, sizeof(GlobalIndex));
+		memcpy(&records[position + sizeof(GlobalIndex)], &value, elementSize);
+	}
+	int getElementCount() { return records.size() / (sizeof(GlobalIndex) + elementSize); }
+	char *getRecords() { return records.empty() ? NULL : &records[0]; }
+	void clear() { records.clear(); }
+};
+
+// the index range of a data part in some segment along with the rank of the segment in the participant group
+class SegmentPartRange {
+  public:
+	GlobalIndex min;
+	GlobalIndex max;
+	int segment;
+	bool operator<(const SegmentPartRange &other) const { return min < other.min; }
+};
+
+class ScatterPrimitive {
+  private:
+	const char *arrayName;
+	int elementSize;
+	int recordSize;
+
+	// the participant threads wait on these semaphores till the exchange of elements is done
+	int _size;
+	int _count;
+	sem_t mutex;
+	sem_t throttle;
+	sem_t waitq;
+	// this barrier holds the threads back till all received elements are written to the data parts
+	Barrier *writeBarrier;
+
+	// each PPU controller thread has its own buffer; the buffers are kept in the order of their creation
+	pthread_key_t bufferKey;
+	std::vector<ScatterBuffer*> threadBuffers;
+	pthread_mutex_t bufferLock;
+
+	// the communicator and size of the group of participating segments; the exchange is skipped when there is 
+	// only one participant
+	MPI_Comm communicator;
+	int segmentCount;
+	// the index ranges of the parts of all participating segments sorted by their lower bounds
+	std::vector<SegmentPartRange> ownerRanges;
+
+	// the elements received from all segments, including the current segment, that the local threads should write
+	std::vector<char> receivedRecords;
+	int receivedCount;
+  public:
+	// The distribution tree should have the parts of all segments, and the LPS ID and the partition configuration
+	// should be those of the LPS allocating the array the scatter writes to. The participants are the PPU controllers
+	// of the current segment that call completeScatter().
+	ScatterPrimitive(const char *arrayName, 
+			int elementSize, 
+			int participants,
+			SegmentGroup *participantGroup, 
+			Container *distributionTree, 
+			int lpsId, DataPartitionConfig *partConfig);
+	~ScatterPrimitive();
+
+	// returns the buffer the calling thread should record its scatter elements in
+	ScatterBuffer *getThreadBuffer();
+
+	// This is the barrier the PPU controllers call after they are done with all LPUs of the scattering LPS. The
+	// argument is the data items of the target array in its allocating LPS.
+	void completeScatter(DataItems *targetItems);
+  private:
+	// exchanges the recorded elements of all local threads with other segments and retains the received ones
+	void exchangeElements();
+	// writes the part of the received elements that corresponds to the ticket of the calling thread
+	void writeElements(DataItems *targetItems, int ticket);
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "shm_transport.h"
+#include "../common/task_launch.h"
+
+#include <mpi.h>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+//--------------------------------------------------------------- Node Topology ---------------------------------------------------------------/
+
+bool NodeTopology::enabled = false;
+vector<int> NodeTopology::coLocatedSegments;
+int NodeTopology::runToken = 0;
+
+void NodeTopology::discoverCoLocatedSegments(std::ofstream &logFile) {
+
+	int segmentRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &segmentRank);
+
+	// segments that can share memory with each other get into the same node communicator
+	MPI_Comm nodeComm;
+	int status = MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, segmentRank, MPI_INFO_NULL, &nodeComm);
+	if (status != MPI_SUCCESS) {
+		logFile << "\tcould not determine the co-located segments; node-local transport is disabled\n";
+		logFile.flush();
+		return;
+	}
+	int nodeSize;
+	MPI_Comm_size(nodeComm, &nodeSize);
+	int nodeRanks[nodeSize];
+	status = MPI_Allgather(&segmentRank, 1, MPI_INT, nodeRanks, 1, MPI_INT, nodeComm);
+	if (status != MPI_SUCCESS) {
+		cout << "Segment " << segmentRank << ": could not gather the ranks of co-located segments\n";
+		exit(EXIT_FAILURE);
+	}
+	MPI_Comm_free(&nodeComm);
+	coLocatedSegments.clear();
+	for (int i = 0; i < nodeSize; i++) {
+		coLocatedSegments.push_back(nodeRanks[i]);
+	}
+
+	// the process Id of the first segment is used as the run token
+	runToken = getpid();
+	status = MPI_Bcast(&runToken, 1, MPI_INT, 0, MPI_COMM_WORLD);
+	if (status != MPI_SUCCESS) {
+		cout << "Segment " << segmentRank << ": could not receive the shared memory run token\n";
+		exit(EXIT_FAILURE);
+	}
+
+	// there is no need for the node-local transport if the current segment is alone in its node
+	enabled = (nodeSize > 1);
+	logFile << "\tCo-located segments in the node:";
+	for (int i = 0; i < nodeSize; i++) logFile << ' ' << nodeRanks[i];
+	logFile << "\n";
+	logFile.flush();
+}
+
+bool NodeTopology::isCoLocated(int segmentTag) {
+	for (unsigned int i = 0; i < coLocatedSegments.size(); i++) {
+		if (coLocatedSegments.at(i) == segmentTag) return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------- Shared Memory Channel -----------------------------------------------------------/
+
+SharedMemoryChannel::SharedMemoryChannel(int communicatorId,
+		int senderSegment,
+		int receiverSegment, int bufferIndex, long int size) {
+	// communicator IDs restart from zero in each task; so concurrently running task invocations are told apart by
+	// the slots they have been launched into
+	std::ostringstream nameStr;
+	nameStr << "/it_" << NodeTopology::getRunToken() << "_" << ExecutionContext::getSlotId() << "_" << communicatorId;
+	nameStr << "_" << senderSegment << "_" << receiverSegment << "_" << bufferIndex;
+	this->name = strdup(nameStr.str().c_str());
+	this->size = size;
+	this->region = NULL;
+	this->creator = false;
+	this->unlinked = false;
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+	if (region != NULL) {
+		munmap(region, size);
+	}
+	if (creator) unlinkName();
+	free(name);
+}
+
+char *SharedMemoryChannel::create() {
+	creator = true;
+	int descriptor = shm_open(name, O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+	if (descriptor < 0) {
+		cout << "could not create shared memory region " << name << "\n";
+		exit(EXIT_FAILURE);
+	}
+	if (ftruncate(descriptor, size) != 0) {
+		cout << "could not resize shared memory region " << name << "\n";
+		exit(EXIT_FAILURE);
+	}
+	void *address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+	if (address == MAP_FAILED) {
+		cout << "could not map shared memory region " << name << "\n";
+		exit(EXIT_FAILURE);
+	}
+	region = reinterpret_cast<char*>(address);
+	return region;
+}
+
+char *SharedMemoryChannel::attach() {
+	int descriptor = shm_open(name, O_RDWR, S_IRUSR | S_IWUSR);
+	if (descriptor < 0) {
+		cout << "could not open shared memory region " << name << "\n";
+		exit(EXIT_FAILURE);
+	}
+	void *address = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	close(descriptor);
+	if (address == MAP_FAILED) {
+		cout << "could not map shared memory region " << name << "\n";
+		exit(EXIT_FAILURE);
+	}
+	region = reinterpret_cast<char*>(address);
+	return region;
+}
+
+void SharedMemoryChannel::unlinkName() {
+	if (unlinked) return;
+	shm_unlink(name);
+	unlinked = true;
+}
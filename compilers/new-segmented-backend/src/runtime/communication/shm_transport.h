@@ -0,0 +1,74 @@
+#ifndef _H_shm_transport
+#define _H_shm_transport
+
+/* When the segmentation of a PCubeS model happens below the node level, e.g., at the Socket level, multiple segments
+ * of a program run within the same node. Exchanging data among such co-located segments through regular MPI messages
+ * results in redundant copies of the data in the MPI layer. This header provides the building blocks for a node-local
+ * transport that let a sending segment copy the content of its communication buffer directly into a receiving
+ * segment's communication buffer that resides in a POSIX shared memory region.
+ *
+ * The transport does not require any collective resource allocation at communicator setup time. The receiver creates
+ * the shared region for a communication buffer the first time the buffer is used and then notifies the sender with a
+ * zero-byte message; the sender attaches to the region upon receiving that notification. So the transport can be used
+ * by communicators that only involve the interacting segments.
+ * */
+
+#include <mpi.h>
+#include <vector>
+#include <iostream>
+#include <fstream>
+
+// tags used for the zero-byte messages of the shared memory handshake; these are kept at the higher end of the tag
+// range MPI guarantees to be valid to avoid interfering with the tags of other data messages
+const int SHM_READY_TAG = 32001;
+const int SHM_DONE_TAG = 32002;
+
+/* This class holds the information about which segments of the program are running in the same node as the current
+ * segment. Discovery of co-located segments is a collective operation over all segments; so it should be done once
+ * at the beginning of the program. If discovery is never done, the node-local transport remains disabled.
+ * */
+class NodeTopology {
+  private:
+	static bool enabled;
+	// world ranks (that are the segment tags) of segments running in the current node
+	static std::vector<int> coLocatedSegments;
+	// a token that is the same for all segments of a single program run; this is used to generate unique names for
+	// shared memory regions
+	static int runToken;
+  public:
+	static void discoverCoLocatedSegments(std::ofstream &logFile);
+	static bool isEnabled() { return enabled; }
+	static bool isCoLocated(int segmentTag);
+	static int getRunToken() { return runToken; }
+	static int getCoLocatedSegmentCount() { return coLocatedSegments.size(); }
+};
+
+/* A shared memory channel is a communication buffer sized POSIX shared memory region that a receiver segment creates
+ * and a co-located sender segment attaches to.
+ * */
+class SharedMemoryChannel {
+  private:
+	char *name;
+	long int size;
+	char *region;
+	// the creator of the region is responsible for removing its name from the system once the peer has attached
+	bool creator;
+	bool unlinked;
+  public:
+	SharedMemoryChannel(int communicatorId,
+			int senderSegment,
+			int receiverSegment, int bufferIndex, long int size);
+	~SharedMemoryChannel();
+
+	// function to be used by the receiver to create the region
+	char *create();
+	// function to be used by the sender to map the region the receiver has already created
+	char *attach();
+	char *getRegion() { return region; }
+
+	// Once the sender has attached the region, its name is no longer needed. Removing the name early ensures that no
+	// stale region remains in the system even if the program terminates abnormally.
+	void unlinkName();
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "../communication/data_transfer.h"
 #include "../communication/confinement_mgmt.h"
 #include "../communication/part_config.h"
+#include "../common/task_launch.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/interval.h"
@@ -83,13 +84,14 @@ CommunicationReqFinder::CommunicationReqFinder(List<MultidimensionalIntervalSeq*
 
 bool CommunicationReqFinder::isCrossSegmentCommRequired(std::ofstream &logFile) {
 
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	bool localDataSufficient = ListReferenceAttributes::isSuperFold(localSourceFold, localTargetFold);
 	int transferReqValue = localDataSufficient ? 0 : 1;
 	int sum = -1;
 
 	int rank;
-	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-        int status = MPI_Allreduce(&transferReqValue, &sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+	MPI_Comm_rank(communicator, &rank);
+        int status = MPI_Allreduce(&transferReqValue, &sum, 1, MPI_INT, MPI_SUM, communicator);
         if (status != MPI_SUCCESS) {
                 cout << rank << ": could not participate in the all to all reduction to determine communication need\n";
                 exit(EXIT_FAILURE);
@@ -106,6 +108,7 @@ SegmentMappingPreparer::SegmentMappingPreparer(List<MultidimensionalIntervalSeq*
 
 List<SegmentDataContent*> *SegmentMappingPreparer::shareSegmentsContents(std::ofstream &logFile) {
 	
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	int foldSize = 0;
 	char *foldString = NULL;
 	if (localSegmentContent != NULL) {
@@ -114,11 +117,11 @@ List<SegmentDataContent*> *SegmentMappingPreparer::shareSegmentsContents(std::of
 	}
 	
 	int rank, segmentCount;
-	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-	MPI_Comm_size(MPI_COMM_WORLD, &segmentCount);
+	MPI_Comm_rank(communicator, &rank);
+	MPI_Comm_size(communicator, &segmentCount);
 
 	int *foldSizes = new int[segmentCount];
-	int status = MPI_Allgather(&foldSize, 1, MPI_INT, foldSizes, 1, MPI_INT, MPI_COMM_WORLD);
+	int status = MPI_Allgather(&foldSize, 1, MPI_INT, foldSizes, 1, MPI_INT, communicator);
         if (status != MPI_SUCCESS) {
                 cout << rank << ": could not determine the data content sizes of different segments\n";
                 exit(EXIT_FAILURE);
@@ -133,7 +136,7 @@ List<SegmentDataContent*> *SegmentMappingPreparer::shareSegmentsContents(std::of
 	char *foldDescBuffer = new char[currentIndex];
 
 	status = MPI_Allgatherv(foldString, foldSize, MPI_CHAR, 
-			foldDescBuffer, foldSizes, displacements, MPI_CHAR, MPI_COMM_WORLD);
+			foldDescBuffer, foldSizes, displacements, MPI_CHAR, communicator);
         if (status != MPI_SUCCESS) {
                 cout << rank << ": could not gather fold descriptions from all segments\n";
                 exit(EXIT_FAILURE);
@@ -214,7 +217,7 @@ void LocalTransferrer::transferData(std::ofstream &logFile) {
 	char *dataEntry = new char[elementSize];
 	while (iterator->hasMoreElements()) {
 
-		vector<int> *dataItemIndex = iterator->getNextElement();
+		vector<GlobalIndex> *dataItemIndex = iterator->getNextElement();
 
 		readTransferSpec->setBufferEntry(dataEntry, dataItemIndex);
 		readPartSpec->initPartTraversalReference(dataItemIndex, transformVector);
@@ -295,7 +298,7 @@ void TransferBuffer::processBuffer(std::ofstream &logFile) {
         long int transferRequests = 0;
         long int transferCount = 0;
         while (iterator.hasMoreElements()) {
-                vector<int> *dataItemIndex = iterator.getNextElement();
+                vector<GlobalIndex> *dataItemIndex = iterator.getNextElement();
                	partListSpec->initPartTraversalReference(dataItemIndex, transformVector);
                 char *dataLocation = data + elementIndex * elementSize;
                 transferSpec->setBufferEntry(dataLocation, dataItemIndex);
@@ -328,9 +331,10 @@ TransferBuffersPreparer::TransferBuffersPreparer(int elementSize,
 List<TransferBuffer*> *TransferBuffersPreparer::createBuffersForOutgoingTransfers(PartIdContainer *sourceContainer,
 		List<SegmentDataContent*> *targetContentMap, std::ofstream &logFile) {
 	
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	int senderId, segmentCount;
-	MPI_Comm_rank(MPI_COMM_WORLD, &senderId);
-	MPI_Comm_size(MPI_COMM_WORLD, &segmentCount);
+	MPI_Comm_rank(communicator, &senderId);
+	MPI_Comm_size(communicator, &segmentCount);
 	int digits = countDigits(segmentCount); 
 	
 	if (localSourceContent == NULL) return NULL;
@@ -367,12 +371,13 @@ List<TransferBuffer*> *TransferBuffersPreparer::createBuffersForOutgoingTransfer
 List<TransferBuffer*> *TransferBuffersPreparer::createBuffersForIncomingTransfers(PartIdContainer *targetContainer,
                         List<SegmentDataContent*> *sourceContentMap, std::ofstream &logFile) {
 
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	if (localTargetContent == NULL) return NULL;
 	if (sourceContentMap == NULL || sourceContentMap->NumElements() == 0) return NULL;
 	
 	int receiverId, segmentCount;
-	MPI_Comm_rank(MPI_COMM_WORLD, &receiverId);
-	MPI_Comm_size(MPI_COMM_WORLD, &segmentCount);
+	MPI_Comm_rank(communicator, &receiverId);
+	MPI_Comm_size(communicator, &segmentCount);
 	int digits = countDigits(segmentCount); 
 
 	Participant *receiver = new Participant(RECEIVE, NULL, localTargetContent);
@@ -419,6 +424,7 @@ BufferTransferrer::~BufferTransferrer() {
 
 void BufferTransferrer::sendDataAsync(std::ofstream &logFile) {
 	
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	if (!sendMode) {
 		cout << "cannot use a buffer transferrer that is configured for receive to send data\n";
 		exit(EXIT_FAILURE);
@@ -426,7 +432,7 @@ void BufferTransferrer::sendDataAsync(std::ofstream &logFile) {
 	if (bufferList == NULL || bufferList->NumElements() == 0) return;
 	
 	int rank;
-	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_rank(communicator, &rank);
 	transferRequests = new MPI_Request[bufferList->NumElements()];
 
 	for (int i = 0; i < bufferList->NumElements(); i++) {
@@ -436,7 +442,7 @@ void BufferTransferrer::sendDataAsync(std::ofstream &logFile) {
 		char *data = buffer->getData();
 		int receiver = buffer->getReceiver();
 		int tag = buffer->getBufferTag();
-		int status = MPI_Isend(data, size, MPI_CHAR, receiver, tag, MPI_COMM_WORLD, &transferRequests[i]);
+		int status = MPI_Isend(data, size, MPI_CHAR, receiver, tag, communicator, &transferRequests[i]);
 		if (status != MPI_SUCCESS) {
 			cout << "Segment " << rank << ": could not issue asynchronous send\n";
 			exit(EXIT_FAILURE);
@@ -446,6 +452,7 @@ void BufferTransferrer::sendDataAsync(std::ofstream &logFile) {
         
 void BufferTransferrer::receiveDataAsync(std::ofstream &logFile) {
 	
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	if (sendMode) {
 		cout << "cannot use a buffer transferrer that is configured for send to receive data\n";
 		exit(EXIT_FAILURE);
@@ -453,7 +460,7 @@ void BufferTransferrer::receiveDataAsync(std::ofstream &logFile) {
 	if (bufferList == NULL || bufferList->NumElements() == 0) return;
 	
 	int rank;
-	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_rank(communicator, &rank);
 	transferRequests = new MPI_Request[bufferList->NumElements()];
 
 	for (int i = 0; i < bufferList->NumElements(); i++) {
@@ -462,7 +469,7 @@ void BufferTransferrer::receiveDataAsync(std::ofstream &logFile) {
 		char *data = buffer->getData();
 		int sender = buffer->getSender();
 		int tag = buffer->getBufferTag();
-		int status = MPI_Irecv(data, size, MPI_CHAR, sender, tag, MPI_COMM_WORLD, &transferRequests[i]);
+		int status = MPI_Irecv(data, size, MPI_CHAR, sender, tag, communicator, &transferRequests[i]);
 		if (status != MPI_SUCCESS) {
 			cout << "Segment " << rank << ": could not issue asynchronous receive\n";
 			exit(EXIT_FAILURE);
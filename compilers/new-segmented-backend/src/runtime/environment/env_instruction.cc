@@ -6,6 +6,9 @@
 #include "../memory-management/allocation.h"
 #include "../memory-management/part_generation.h"
 #include "../file-io/stream.h"
+#include "../file-io/output_writer.h"
+#include "../file-io/input_prefetcher.h"
+#include "../partition-lib/partition_weights.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/hashtable.h"
@@ -51,6 +54,24 @@ void TaskInitEnvInstruction::removeOldPartsListReferences() {
 	}
 }
 
+void TaskInitEnvInstruction::waitForPendingOutputs() {
+
+	Hashtable<LpsAllocation*> *allocationMap = itemToUpdate->getAllAllocations();
+	Iterator<LpsAllocation*> iterator = allocationMap->GetIterator();
+	LpsAllocation *allocation = NULL;
+	while ((allocation = iterator.GetNextValue()) != NULL) {
+		PartsList *partsList = allocation->getPartsList();
+		if (partsList != NULL) AsyncOutputWriter::waitForPartsList(partsList->getAttributes());
+	}
+
+	char *sourceKey = itemToUpdate->getEnvLinkKey()->getSourceKey();
+	if (sourceKey != NULL) {
+		ProgramEnvironment *progEnv = itemToUpdate->getEnvironment()->getProgramEnvironment();
+		ObjectVersionManager *versionManager = progEnv->getVersionManager(sourceKey);
+		if (versionManager != NULL) versionManager->waitForPendingOutputs();
+	}
+}
+
 void TaskInitEnvInstruction::allocatePartsLists() {
 	
 	TaskEnvironment *taskEnv = itemToUpdate->getEnvironment();
@@ -372,6 +393,12 @@ void StaleRefreshInstruction::setupPartsList() {
 
 //---------------------------------------------------- CreateFreshInstruction -----------------------------------------------------
 
+void CreateFreshInstruction::setupDimensions() {
+	TaskEnvironment *environment = itemToUpdate->getEnvironment();
+	const char *itemName = itemToUpdate->getEnvLinkKey()->getVarName();
+	PartitionWeights::forgetOrigin(environment->getEnvId(), itemName);
+}
+
 void CreateFreshInstruction::setupPartsList() {
 	allocatePartsLists();
 	assignDataSourceKeyForItem();	
@@ -379,11 +406,23 @@ void CreateFreshInstruction::setupPartsList() {
 
 //--------------------------------------------------- ReadFromFileInstruction -----------------------------------------------------
 
+ReadFromFileInstruction::~ReadFromFileInstruction() {
+	if (prefetchIssued) InputPrefetcher::release(fileName);
+}
+
+void ReadFromFileInstruction::startPrefetch() {
+	InputPrefetcher::prefetch(fileName);
+	prefetchIssued = true;
+}
+
 void ReadFromFileInstruction::setupDimensions() {
 
 	TaskEnvironment *environment = itemToUpdate->getEnvironment();
 	EnvironmentLinkKey *envKey = itemToUpdate->getEnvLinkKey();
 	const char *itemName = envKey->getVarName();
+
+	// the file may be the target of an output job that has not finished yet
+	AsyncOutputWriter::waitForFile(fileName);
 	TypedInputStream<char> *stream = new TypedInputStream<char>(fileName);
 	List<Dimension*> *dimensionList = stream->getDimensionList();
 	for (int i = 0; i < dimensionList->NumElements(); i++) {
@@ -391,6 +430,9 @@ void ReadFromFileInstruction::setupDimensions() {
 		itemToUpdate->setDimension(i, *dimension);
 	}
 	delete stream;		
+
+	// remember the file in case the item is used as the weights of a weighted-block partition
+	PartitionWeights::recordFileOrigin(environment->getEnvId(), itemName, fileName);
 }
 
 void ReadFromFileInstruction::setupPartsList() {
@@ -415,6 +457,12 @@ void ReadFromFileInstruction::setupPartsList() {
 		partReader->setFileName(fileName);
 		partReader->processParts();
 	}
+
+	// the prefetched content of the file, if exists, is not needed anymore once all LPS allocations have been populated
+	if (prefetchIssued) {
+		InputPrefetcher::release(fileName);
+		prefetchIssued = false;
+	}
 	
 	assignDataSourceKeyForItem();	
 }
@@ -431,6 +479,16 @@ void DataTransferInstruction::setupDimensions() {
 		dimension.setLength();
 		itemToUpdate->setDimension(i, dimension);
 	}
+
+	// the item now holds the content of the source item; so it shares the source's file origin, if there is any 
+	ArrayTransferConfig *collapsedConfig = transferConfig->getCollapsed();
+	const char *sourceProperty = collapsedConfig->getPropertyName();
+	if (sourceProperty != NULL) {
+		TaskEnvironment *sourceEnv = (TaskEnvironment*) collapsedConfig->getSource();
+		TaskEnvironment *environment = itemToUpdate->getEnvironment();
+		const char *itemName = itemToUpdate->getEnvLinkKey()->getVarName();
+		PartitionWeights::copyOrigin(environment->getEnvId(), itemName, sourceEnv->getEnvId(), sourceProperty);
+	}
 }
 
 void DataTransferInstruction::setupPartsList() {
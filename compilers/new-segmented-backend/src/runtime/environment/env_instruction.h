@@ -33,6 +33,12 @@ class TaskInitEnvInstruction {
 	// stages can begin
 	virtual void setupPartsList() = 0;
 
+	// A background output job may still be reading the data parts of the item's parts lists, or of other versions of
+	// the item sharing memory with them. An instruction overwrites those parts in place when it clones or allocates, 
+	// and so does the task execution afterwards. So this function should be called before the parts list setup to 
+	// wait for such jobs to finish.
+	void waitForPendingOutputs();
+
 	// this function should be invoked to ensure any new/updated parts list for the data structure has been included in 
 	// the program environment
 	virtual void postprocessProgramEnv() = 0;		
@@ -110,8 +116,9 @@ class CreateFreshInstruction : public TaskInitEnvInstruction {
 	CreateFreshInstruction(TaskItem *itemToUpdate) : TaskInitEnvInstruction(itemToUpdate) {}
 	
 	// items created because of the task execution gets their dimension set-up by the task initializer section; there is
-	// no need for their dimensions to be initialized, neither there is any scope for it
-	void setupDimensions() {}
+	// no need for their dimensions to be initialized, neither there is any scope for it; but the item no longer holds 
+	// content from any file it may have been read from earlier, which matters if it serves as partition weights
+	void setupDimensions();
 
 	// if a new data item is going to be created for the underlying variable in the task then the task should let go of
 	// its reference for the parts list of the same variable that has been created during an earlier execution of the task 	
@@ -131,11 +138,20 @@ class CreateFreshInstruction : public TaskInitEnvInstruction {
 class ReadFromFileInstruction : public TaskInitEnvInstruction {
   protected:
 	const char *fileName;
+	// indicates that a background read of the file content has been started for this instruction and the content has
+	// not been consumed yet
+	bool prefetchIssued;
   public:	
 	ReadFromFileInstruction(TaskItem *itemToUpdate) : TaskInitEnvInstruction(itemToUpdate) {
 		this->fileName = NULL;
+		this->prefetchIssued = false;
 	}
+	~ReadFromFileInstruction();
 	void setFileName(const char *fileName) { this->fileName = fileName; }
+
+	// starts reading the file in the background so that the read overlaps with whatever the program does before the
+	// task using the item initializes its memory
+	void startPrefetch();
 	
 	// read the dimension metadata that appears at the beginning of the data file and copy back that information in the
 	// dimension properties of the task-item
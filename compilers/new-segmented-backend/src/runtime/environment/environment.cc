@@ -6,6 +6,7 @@
 #include "../memory-management/part_tracking.h"
 #include "../communication/part_folding.h"
 #include "../communication/part_config.h"
+#include "../file-io/output_writer.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/hashtable.h"
@@ -42,6 +43,7 @@ PartsListAttributes::PartsListAttributes() {
 	dirty = false;
 	segmentMappingKnown = false;
 	segmentsContents = NULL;
+	pendingOutputCount = 0;
 }
 
 PartsListAttributes::~PartsListAttributes() {
@@ -74,6 +76,8 @@ PartsList::PartsList(PartsListAttributes *attributes, List<DataPart*> *parts) {
 }
         
 PartsList::~PartsList() {
+	// a background output job may still be reading the data parts
+	AsyncOutputWriter::waitForPartsList(attributes);
 	delete attributes;
 	while (parts->NumElements() > 0) {
 		DataPart *part = parts->Nth(0);
@@ -370,6 +374,14 @@ int ObjectVersionManager::getVersionCount() {
 	return versionCount;
 }
 
+void ObjectVersionManager::waitForPendingOutputs() {
+	Iterator<PartsListReference*> iterator = dataVersions->GetIterator();
+	PartsListReference *version = NULL;
+	while ((version = iterator.GetNextValue()) != NULL) {
+		AsyncOutputWriter::waitForPartsList(version->getPartsList()->getAttributes());
+	}
+}
+
 //----------------------------------------------------------- Program Environment ------------------------------------------------------/
 
 ProgramEnvironment::ProgramEnvironment() {
@@ -554,6 +566,19 @@ void TaskEnvironment::setDefaultEnvInitInstrs() {
 	}
 }
 
+void TaskEnvironment::setWritersMap(Hashtable<PartWriter*> *writersMap) {
+	if (this->writersMap != NULL && this->writersMap != writersMap) {
+		Iterator<PartWriter*> iterator = this->writersMap->GetIterator();
+		PartWriter *writer;
+		while ((writer = iterator.GetNextValue()) != NULL) {
+			AsyncOutputWriter::waitForWriter(writer);
+			delete writer;
+		}
+		delete this->writersMap;
+	}
+	this->writersMap = writersMap;
+}
+
 void TaskEnvironment::writeItemToFile(const char *itemName, const char *filePath) {
 	
 	TaskItem *item = envItems->Lookup(itemName);
@@ -565,8 +590,11 @@ void TaskEnvironment::writeItemToFile(const char *itemName, const char *filePath
 	PartWriter *writer = writersMap->Lookup(writerId.str().c_str()); 
 	if (writer == NULL) return;
 
-	writer->setFileName(filePath);
-	writer->processParts();
+	// the parts list being written is pinned until the output job is done so that the coordinator can proceed to the
+	// next task invocation right away
+	LpsAllocation *allocation = item->getLpsAllocation(allocatorLps);
+	PartsListAttributes *partsListAttr = allocation->getPartsList()->getAttributes();
+	AsyncOutputWriter::write(writer, filePath, partsListAttr);
 }	
 
 void TaskEnvironment::addInitEnvInstruction(TaskInitEnvInstruction *instr) { 
@@ -589,6 +617,7 @@ void TaskEnvironment::addInitEnvInstruction(TaskInitEnvInstruction *instr) {
 	if (oldInstrIndex != -1) {
 		TaskInitEnvInstruction *oldInstr = initInstrs[oldInstrIndex];
 		initInstrs[oldInstrIndex] = instr;
+		delete oldInstr;
 	} else initInstrs.push_back(instr); 
 }
         
@@ -622,6 +651,7 @@ void TaskEnvironment::preprocessProgramEnvForItems() {
 
 void TaskEnvironment::setupItemsPartsLists() {
 	for (int i = 0; i < initInstrs.size(); i++) {
+		initInstrs.at(i)->waitForPendingOutputs();
 		initInstrs.at(i)->setupPartsList();
 	}
 }
@@ -64,6 +64,9 @@ class PartsListAttributes {
 	// YES what are the mappings
 	bool segmentMappingKnown;
 	List<SegmentDataContent*> *segmentsContents;
+	// the number of background output jobs that are yet to finish writing the content of the parts list; the list must
+	// not be reclaimed before this goes to zero. This count is protected by the lock of the AsyncOutputWriter 
+	int pendingOutputCount;
   public:
 	PartsListAttributes();
 	~PartsListAttributes();
@@ -78,6 +81,9 @@ class PartsListAttributes {
 	void setSegmentsContents(List<SegmentDataContent*> *segmentsContents);
 	bool isSegmentMappingKnown() { return segmentMappingKnown; }
 	List<SegmentDataContent*> *getSegmentMapping() { return segmentsContents; }
+	void pinForOutput() { pendingOutputCount++; }
+	void unpinAfterOutput() { pendingOutputCount--; }
+	int getPendingOutputCount() { return pendingOutputCount; }
 };
 
 /* This class represents a list of parts a segment holds for a data item for a particular partition configuration. Note
@@ -225,6 +231,9 @@ class ObjectVersionManager {
 	List<PartsListReference*> *getFreshVersions();
 	PartsListReference *getFirstFreshVersion();
 	int getVersionCount();
+	// versions of an item may share the memory of their data parts; so before a task may update any of them, the 
+	// background output jobs on all versions must finish
+	void waitForPendingOutputs();
 };
 
 /* The program environment is at the end a collection of object-version-managers for different data items 
@@ -361,7 +370,10 @@ class TaskEnvironment {
 	int getTaskId() { return taskId; } 
 	TaskItem *getItem(const char *itemName) { return envItems->Lookup(itemName); }
 	void setReadersMap(Hashtable<PartReader*> *readersMap) { this->readersMap = readersMap; }
-	void setWritersMap(Hashtable<PartWriter*> *writersMap) { this->writersMap = writersMap; }
+	// Writers are used by output bindings after the task invocation that has created them is over, possibly in the
+	// background; so the writers of an invocation are released when the next invocation of the environment replaces
+	// them, after any pending output jobs using them are done.
+	void setWritersMap(Hashtable<PartWriter*> *writersMap);
 	void setLogFile(std::ofstream *logFile) { this->logFile = logFile; }
 	std::ofstream *getLogFile() { return logFile; }
 	void setProgramEnvironment(ProgramEnvironment *progEnv) { this->progEnv = progEnv; }
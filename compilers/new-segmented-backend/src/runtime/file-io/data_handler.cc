@@ -5,6 +5,7 @@
 #include "../partition-lib/partition.h"
 #include "../memory-management/allocation.h"
 #include "../memory-management/part_generation.h"
+#include "../common/task_launch.h"
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/interval.h"
@@ -42,6 +43,7 @@ void PartInfo::clear() {
 			delete seq;
 		}
 		delete contentDescription;
+		contentDescription = NULL;
 	}
 }
 
@@ -80,6 +82,8 @@ void PartInfo::generateContentDescription(DataPartitionConfig *partConfig) {
 		// from other data parts (this can happens in partitions with multi-level paddings)
 		if (intervalSeqList->NumElements() == 0) {
 			generationFailed = true;
+			delete intervalSeqList;
+			delete idRangeList;
 			break;
 		}
 		
@@ -89,6 +93,13 @@ void PartInfo::generateContentDescription(DataPartitionConfig *partConfig) {
 	
 	if (generationFailed) {
 		contentDescription = NULL;
+		// the interval sequences of earlier dimensions are not parts of any description in this case
+		for (int i = 0; i < dimensionalIntervalDesc->NumElements(); i++) {
+			List<IntervalSeq*> *oneDSeqList = dimensionalIntervalDesc->Nth(i);
+			for (int j = 0; j < oneDSeqList->NumElements(); j++) {
+				delete oneDSeqList->Nth(j);
+			}
+		}
 	} else {
 		contentDescription = MultidimensionalIntervalSeq::generateIntervalSeqs(dimensionality, 
 				dimensionalIntervalDesc);
@@ -105,7 +116,7 @@ void PartInfo::generateContentDescription(DataPartitionConfig *partConfig) {
 	delete statefulConfig;
 }
 
-bool PartInfo::isDataIndexInCorePart(List<int> *dataIndex) { 
+bool PartInfo::isDataIndexInCorePart(List<GlobalIndex> *dataIndex) { 
 	for (int i = 0; i < contentDescription->NumElements(); i++) {
 		if (contentDescription->Nth(i)->contains(dataIndex)) return true;
 	}
@@ -120,7 +131,7 @@ PartHandler::PartHandler(DataPartsList *partsList, DataPartitionConfig *partConf
 	this->partConfig = partConfig;
 	this->currentPart = NULL;
 	this->currentPartInfo = NULL;
-	this->currentDataIndex = new List<int>;
+	this->currentDataIndex = new List<GlobalIndex>;
 	ListMetadata *metadata = partsList->getMetadata();
 	this->dataDimensionality = metadata->getDimensions();
 	this->dataDimensions = metadata->getBoundary();
@@ -133,7 +144,7 @@ List<Dimension*> *PartHandler::getDimensionList() {
 	return dimensionList;
 }
 
-List<int> *PartHandler::getDataIndex(List<int> *partIndex) {
+List<GlobalIndex> *PartHandler::getDataIndex(List<GlobalIndex> *partIndex) {
 	
 	while (currentDataIndex->NumElements() > 0) currentDataIndex->RemoveAt(0);
         
@@ -141,11 +152,11 @@ List<int> *PartHandler::getDataIndex(List<int> *partIndex) {
 	
 	for (int i = 0; i < dataDimensionality; i++) {
 		DimPartitionConfig *dimConfig = partConfig->getDimensionConfig(i);
-		int dimIndex = partIndex->Nth(i);
+		GlobalIndex dimIndex = partIndex->Nth(i);
 		List<int> *partIdList = currentPartInfo->partIdList->Nth(i);
 		List<int> *partCounts = currentPartInfo->partCounts->Nth(i);
 		List<Dimension*> *partDimensions = currentPartInfo->partDimensions->Nth(i);
-		int originalDimIndex = dimConfig->getOriginalIndex(dimIndex, position, 
+		GlobalIndex originalDimIndex = dimConfig->getOriginalIndex(dimIndex, position, 
 				partIdList, partCounts, partDimensions);
 
 		currentDataIndex->Append(originalDimIndex);				
@@ -153,7 +164,7 @@ List<int> *PartHandler::getDataIndex(List<int> *partIndex) {
 	return currentDataIndex;
 }
 
-int PartHandler::getDataIndexForDim(int dimNo, int dimIndex) {
+GlobalIndex PartHandler::getDataIndexForDim(int dimNo, GlobalIndex dimIndex) {
 	
 	int position = currentPart->getMetadata()->getIdList()->NumElements() - 1;
 	DimPartitionConfig *dimConfig = partConfig->getDimensionConfig(dimNo);
@@ -163,7 +174,7 @@ int PartHandler::getDataIndexForDim(int dimNo, int dimIndex) {
 	List<int> *partIdList = currentPartInfo->partIdList->Nth(dimNo);
 	List<int> *partCounts = currentPartInfo->partCounts->Nth(dimNo);
 	List<Dimension*> *partDimensions = currentPartInfo->partDimensions->Nth(dimNo);
-	int originalDimIndex = dimConfig->getOriginalIndex(dimIndex, position, 
+	GlobalIndex originalDimIndex = dimConfig->getOriginalIndex(dimIndex, position, 
 				partIdList, partCounts, partDimensions);
 	return originalDimIndex;
 }
@@ -181,7 +192,7 @@ void PartHandler::processParts() {
 	
 		PartMetadata *metadata = dataPart->getMetadata();
 		Dimension *partDimensions = metadata->getBoundary();
-		List<int> *partIndexList = new List<int>;
+		List<GlobalIndex> *partIndexList = new List<GlobalIndex>;
 		processPart(partDimensions, 0, partIndexList);
 		delete partIndexList;
 		postProcessPart(dataPart);
@@ -218,14 +229,14 @@ void PartHandler::calculateCurrentPartInfo() {
 	}
 }
 
-void PartHandler::processPart(Dimension *partDimensions, int currentDimNo, List<int> *partialIndex) {
+void PartHandler::processPart(Dimension *partDimensions, int currentDimNo, List<GlobalIndex> *partialIndex) {
 	
 	void *partStore = getCurrentPartData();
 	Dimension dimension = partDimensions[currentDimNo];
 	
 	if (currentDimNo < dataDimensionality - 1) {
-		for (int index = dimension.range.min; index <= dimension.range.max; index++) {
-			int dataIndex = getDataIndexForDim(currentDimNo, index);
+		for (GlobalIndex index = dimension.range.min; index <= dimension.range.max; index++) {
+			GlobalIndex dataIndex = getDataIndexForDim(currentDimNo, index);
 			currentDataIndex->Append(dataIndex);
 			partialIndex->Append(index);
 			processPart(partDimensions, currentDimNo + 1, partialIndex);
@@ -238,10 +249,10 @@ void PartHandler::processPart(Dimension *partDimensions, int currentDimNo, List<
 		int position = currentPart->getMetadata()->getIdList()->NumElements() - 1;
 
 		if (dimConfig->hasReorderedIndices(position) == true) {
-			for (int index = dimension.range.min; index <= dimension.range.max; index++) {
+			for (GlobalIndex index = dimension.range.min; index <= dimension.range.max; index++) {
 				partialIndex->Append(index);
 				long int storeIndex = getStorageIndex(partialIndex, partDimensions);
-				int dataIndex = getDataIndexForDim(currentDimNo, index);
+				GlobalIndex dataIndex = getDataIndexForDim(currentDimNo, index);
 				currentDataIndex->Append(dataIndex);
 				if (!needToExcludePadding || currentPartInfo->isDataIndexInCorePart(currentDataIndex)) {
 					processElement(currentDataIndex, storeIndex, partStore);
@@ -251,13 +262,13 @@ void PartHandler::processPart(Dimension *partDimensions, int currentDimNo, List<
 			}
 		
 		} else {
-			int startIndex = dimension.range.min;
-			int endIndex = dimension.range.max;
+			GlobalIndex startIndex = dimension.range.min;
+			GlobalIndex endIndex = dimension.range.max;
 			partialIndex->Append(startIndex);
 			long int storeIndex = getStorageIndex(partialIndex, partDimensions);
-	       		int elementsToProcess = endIndex - startIndex + 1;
-			int dataIndex = getDataIndexForDim(currentDimNo, startIndex);
-			int count = 0;
+	       		GlobalIndex elementsToProcess = endIndex - startIndex + 1;
+			GlobalIndex dataIndex = getDataIndexForDim(currentDimNo, startIndex);
+			GlobalIndex count = 0;
 			currentDataIndex->Append(dataIndex);
 			while (count < elementsToProcess) {
 				if (!needToExcludePadding || currentPartInfo->isDataIndexInCorePart(currentDataIndex)) {
@@ -291,12 +302,12 @@ void PartHandler::processPart(Dimension *partDimensions, int currentDimNo, List<
 	}  */
 }
 
-long int PartHandler::getStorageIndex(List<int> *partIndex, Dimension *partDimensions) {
+long int PartHandler::getStorageIndex(List<GlobalIndex> *partIndex, Dimension *partDimensions) {
 	long int storeIndex = 0;
 	long int multiplier = 1;
 	for (int i = partIndex->NumElements() - 1; i >= 0; i--) {
-		int firstIndex = partDimensions[i].range.min;
-		int dimensionIndex = partIndex->Nth(i);
+		GlobalIndex firstIndex = partDimensions[i].range.min;
+		GlobalIndex dimensionIndex = partIndex->Nth(i);
 		storeIndex += (dimensionIndex - firstIndex) * multiplier;
 		multiplier *= partDimensions[i].length;
 	}
@@ -307,20 +318,21 @@ long int PartHandler::getStorageIndex(List<int> *partIndex, Dimension *partDimen
 
 void PartWriter::processParts() {
 
+	MPI_Comm communicator = ExecutionContext::getCommunicator();
 	// wait for the previous writer to complete
 	if (writerId != 0) {
                 int predecessorDone = 0;
                 MPI_Status status;
-                MPI_Recv(&predecessorDone, 1, MPI_INT, writerId - 1, 0, MPI_COMM_WORLD, &status);
+                MPI_Recv(&predecessorDone, 1, MPI_INT, writerId - 1, WRITING_TURN_TAG, communicator, &status);
         }
 
 	// do the writing
 	PartHandler::processParts();
 	
-	// signal the next writer to begin writing
+	// signal the next writer to begin writing; the message buffer is a local variable, so the send should complete before
+	// the function returns
 	if (writerId < writersCount - 1) {
-		MPI_Request sendRequest;
 		int writingDone = 1;
-		MPI_Isend(&writingDone, 1, MPI_INT, writerId + 1, 0, MPI_COMM_WORLD, &sendRequest);
+		MPI_Send(&writingDone, 1, MPI_INT, writerId + 1, WRITING_TURN_TAG, communicator);
 	}
 }
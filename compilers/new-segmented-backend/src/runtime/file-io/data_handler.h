@@ -34,13 +34,18 @@ class PartInfo {
 		partIdList = new List<List<int>*>;
 		contentDescription = NULL;
 	}
-	~PartInfo() { clear(); }
+	~PartInfo() {
+		clear();
+		delete partDimensions;
+		delete partCounts;
+		delete partIdList;
+	}
 	void clear();
 	void generateContentDescription(DataPartitionConfig *partConfig);
 
 	// returns true if the data/cell index is not from an overlapped padding region of the data part; returns false
 	// otherwise
-	bool isDataIndexInCorePart(List<int> *dataIndex);
+	bool isDataIndexInCorePart(List<GlobalIndex> *dataIndex);
 };
 
 /* common base class that embodies routines needed for both reading and writing data parts */
@@ -58,7 +63,7 @@ class PartHandler {
 	
 	// a supporting variable that is used to represent a file location (actual data index) of a particular element
 	// in a data part to avoid creating a new list each time we do a data part to file location transformation
-	List<int> *currentDataIndex;
+	List<GlobalIndex> *currentDataIndex;
  
 	// Since some IT partition functions support boundary overlappings in terms of padding, data parts generated 
 	// using them may have regions that does not belong them originally. Particularly when writing content to a
@@ -68,6 +73,7 @@ class PartHandler {
 	bool needToExcludePadding;
   public:
 	PartHandler(DataPartsList *partsList, DataPartitionConfig *partConfig);
+	virtual ~PartHandler() { delete currentDataIndex; }
 	void setFileName(const char *fileName) { this->fileName = fileName; }
 	void setNeedToExcludePadding(bool stat) { needToExcludePadding = stat; }
 	bool doesNeedToExcludePadding() { return needToExcludePadding; }
@@ -80,7 +86,7 @@ class PartHandler {
 	// functions to be used to identify the memory for the part that will receive/send updates in the I/O process
 	void *getCurrentPartData() { return currentPart->getData(); }
 	// returns one dimensional update index for an element from its, possibly, multidimensional part index 
-	long int getStorageIndex(List<int> *partIndex, Dimension *partDimension);
+	long int getStorageIndex(List<GlobalIndex> *partIndex, Dimension *partDimension);
 	// returns the data dimension in a list format
 	List<Dimension*> *getDimensionList();
 
@@ -89,13 +95,13 @@ class PartHandler {
 	// indexes of an array dimension and, further, there can be multiple reordering applied on a data structure's 
 	// memory for a particular LPS; a mechanism is needed to reverse transform an element's part index into its 
 	// data index in a file.    
-	virtual List<int> *getDataIndex(List<int> *partIndex) = 0;
+	virtual List<GlobalIndex> *getDataIndex(List<GlobalIndex> *partIndex) = 0;
 
 	// This function is added to aid passing data index generation during recursive call of part processing
-	int getDataIndexForDim(int dimNo, int dimIndex);
+	GlobalIndex getDataIndexForDim(int dimNo, GlobalIndex dimIndex);
 	
 	// this functions are provided so that subclasses can use appropriate type while reading/writing data 
-	virtual void processElement(List<int> *dataIndex, long int storeIndex, void *partStore) = 0;
+	virtual void processElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) = 0;
 	virtual void processNextElement(long int storeIndex, void *partStore) = 0;	
 
 	// two functions to be used by subclasses to initialize and destroy any resource that may be created for the
@@ -108,7 +114,7 @@ class PartHandler {
 	virtual void postProcessPart(DataPart *dataPart) {}
   private:
 	// a recursive helper routines to aid the processParts() function
-	void processPart(Dimension *partDimensions, int currentDimNo, List<int> *partialIndex);
+	void processPart(Dimension *partDimensions, int currentDimNo, List<GlobalIndex> *partialIndex);
 };
 
 /* base class to be extended for the reading process */
@@ -118,17 +124,22 @@ class PartReader : public PartHandler {
 
 	// the process element method just call the virtual read element function; this conversion is done to make it
 	// explicit the reading process. Task specific subclasses should implement the readElement() function
-	void processElement(List<int> *dataIndex, long int storeIndex, void *partStore) {
+	void processElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) {
 		readElement(dataIndex, storeIndex, partStore);
 	}
 	// similarly to the above, task specific subclasses should implement the readNextElement() function
 	void processNextElement(long int storeIndex, void *partStore) {
 		readNextElement(storeIndex, partStore);
 	}	
-	virtual void readElement(List<int> *dataIndex, long int storeIndex, void *partStore) = 0;	
+	virtual void readElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) = 0;	
 	virtual void readNextElement(long int storeIndex, void *partStore) = 0;	
 };
 
+// tag used for the messages passing the writing turn from one segment's writer to the next; like the other runtime
+// library tags it is kept at the higher end of the tag range MPI guarantees to be valid to avoid mixing the messages 
+// with those of other MPI calls of the program 
+const int WRITING_TURN_TAG = 32004;
+
 /* base class to be extended for the writing process */
 class PartWriter : public PartHandler {
   protected:
@@ -154,14 +165,14 @@ class PartWriter : public PartHandler {
 
 	// like the PartReader, this class also override the processElement() method to make writing process explicit
 	// for task specific subclasses  
-	void processElement(List<int> *dataIndex, long int storeIndex, void *partStore) {
+	void processElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) {
 		writeElement(dataIndex, storeIndex, partStore);
 	}
 	// similarly to the above, task specific subclasses should implement the writeNextElement() function
 	void processNextElement(long int storeIndex, void *partStore) {
 		writeNextElement(storeIndex, partStore);
 	}	
-	virtual void writeElement(List<int> *dataIndex, long int storeIndex, void *partStore) = 0;	
+	virtual void writeElement(List<GlobalIndex> *dataIndex, long int storeIndex, void *partStore) = 0;	
 	virtual void writeNextElement(long int storeIndex, void *partStore) = 0;
 };
 
@@ -0,0 +1,93 @@
+#include "input_prefetcher.h"
+#include "output_writer.h"
+
+#include "../../../../common-libs/utils/hashtable.h"
+
+#include <pthread.h>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <iostream>
+
+//------------------------------------------------------------ Prefetched File -----------------------------------------------------------/
+
+PrefetchedFile::PrefetchedFile(const char *fileName) {
+	this->fileName = strdup(fileName);
+	this->joined = false;
+	this->referenceCount = 1;
+	this->content = NULL;
+	this->contentSize = 0;
+}
+
+PrefetchedFile::~PrefetchedFile() {
+	free(fileName);
+	if (content != NULL) delete[] content;
+}
+
+//------------------------------------------------------------ Input Prefetcher ----------------------------------------------------------/
+
+bool InputPrefetcher::enabled = false;
+Hashtable<PrefetchedFile*> *InputPrefetcher::prefetchMap = new Hashtable<PrefetchedFile*>;
+
+void InputPrefetcher::prefetch(const char *fileName) {
+	if (!enabled || fileName == NULL) return;
+	PrefetchedFile *file = prefetchMap->Lookup(fileName);
+	if (file != NULL) {
+		file->referenceCount++;
+		return;
+	}
+	file = new PrefetchedFile(fileName);
+	if (pthread_create(&(file->readerThread), NULL, readFile, file) != 0) {
+		// the file will be read in place by the data part readers if no thread is available for prefetching
+		delete file;
+		return;
+	}
+	prefetchMap->Enter(fileName, file);
+}
+
+PrefetchedFile *InputPrefetcher::getContent(const char *fileName) {
+	PrefetchedFile *file = prefetchMap->Lookup(fileName);
+	if (file == NULL) return NULL;
+	if (!file->joined) {
+		pthread_join(file->readerThread, NULL);
+		file->joined = true;
+	}
+	if (file->content == NULL) return NULL;
+	return file;
+}
+
+void InputPrefetcher::release(const char *fileName) {
+	PrefetchedFile *file = prefetchMap->Lookup(fileName);
+	if (file == NULL) return;
+	file->referenceCount--;
+	if (file->referenceCount > 0) return;
+	if (!file->joined) {
+		pthread_join(file->readerThread, NULL);
+	}
+	prefetchMap->Remove(fileName, file);
+	delete file;
+}
+
+void *InputPrefetcher::readFile(void *arg) {
+
+	PrefetchedFile *file = (PrefetchedFile*) arg;
+
+	// the file may be the target of an output job that has not finished yet
+	AsyncOutputWriter::waitForFile(file->fileName);
+
+	FILE *stream = fopen(file->fileName, "rb");
+	if (stream == NULL) return NULL;
+	fseek(stream, 0, SEEK_END);
+	long int size = ftell(stream);
+	fseek(stream, 0, SEEK_SET);
+	char *content = new char[size];
+	if (size > 0 && fread(content, 1, size, stream) != (size_t) size) {
+		delete[] content;
+		fclose(stream);
+		return NULL;
+	}
+	fclose(stream);
+	file->content = content;
+	file->contentSize = size;
+	return NULL;
+}
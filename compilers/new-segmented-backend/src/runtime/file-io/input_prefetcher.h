@@ -0,0 +1,58 @@
+#ifndef _H_input_prefetcher
+#define _H_input_prefetcher
+
+/* An input binding is resolved at the beginning of the first task that uses the bound item, after the partition config-
+ * uration of the item's data parts has been determined. If the file is read then, the PPU threads of the task sit idle
+ * for the whole duration of the read. The content of the file, however, does not depend on the partition configuration.
+ * So the input prefetcher starts reading the file in a background thread as soon as the binding instruction is issued;
+ * the reading then overlaps with any earlier task and the setup of the consuming task. The data part readers join the
+ * background read when they open the file and pick up elements from the prefetched content instead of seeking the file
+ * for each element.
+ *
+ * Note that every segment holds the entire file content in memory between the binding and the consuming task's memory 
+ * initialization, although it needs only the parts of its own segment; and it reads the entire file in the process. So 
+ * prefetching is off by default and should be enabled from the deployment configuration only when the input files are 
+ * small compared to the memory of a segment.
+ * */
+
+#include "../../../../common-libs/utils/hashtable.h"
+#include <pthread.h>
+
+class PrefetchedFile {
+  public:
+	char *fileName;
+	pthread_t readerThread;
+	bool joined;
+	// the number of binding instructions that are waiting to use the content
+	int referenceCount;
+	// content of the whole file; this remains NULL if the file could not be read
+	char *content;
+	long int contentSize;
+	PrefetchedFile(const char *fileName);
+	~PrefetchedFile();
+};
+
+/* All functions of the prefetcher are supposed to be called from the coordinator program's thread; only the background
+ * reader threads run concurrently to it and each of them only updates its own prefetched file object.
+ * */
+class InputPrefetcher {
+  private:
+	static bool enabled;
+	static Hashtable<PrefetchedFile*> *prefetchMap;
+  public:
+	static void enable() { enabled = true; }
+
+	// starts a background read of the file if it is not being read already
+	static void prefetch(const char *fileName);
+
+	// waits for the background read of the file to finish and returns the prefetched content; it returns NULL if the file
+	// has not been prefetched or the read has failed
+	static PrefetchedFile *getContent(const char *fileName);
+
+	// lets go of one binding instruction's interest in the file content; the content is deleted when no one else needs it
+	static void release(const char *fileName);
+  private:
+	static void *readFile(void *arg);
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "output_writer.h"
+#include "data_handler.h"
+
+#include "../environment/environment.h"
+#include "../communication/mpi_group.h"
+
+#include <pthread.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <list>
+
+//--------------------------------------------------------------- Output Job -------------------------------------------------------------/
+
+OutputJob::OutputJob(PartWriter *writer, const char *fileName, PartsListAttributes *pinnedList) {
+	this->writer = writer;
+	this->fileName = strdup(fileName);
+	this->pinnedList = pinnedList;
+}
+
+OutputJob::~OutputJob() {
+	free(fileName);
+}
+
+//---------------------------------------------------------- Async Output Writer ---------------------------------------------------------/
+
+bool AsyncOutputWriter::enabled = true;
+bool AsyncOutputWriter::threadStarted = false;
+pthread_t AsyncOutputWriter::ioThread;
+pthread_mutex_t AsyncOutputWriter::mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t AsyncOutputWriter::condition = PTHREAD_COND_INITIALIZER;
+std::list<OutputJob*> AsyncOutputWriter::jobQueue;
+OutputJob *AsyncOutputWriter::currentJob = NULL;
+bool AsyncOutputWriter::stopRequested = false;
+
+bool AsyncOutputWriter::isActive() {
+	return enabled && MpiThreadSupport::isMultithreaded();
+}
+
+void AsyncOutputWriter::write(PartWriter *writer, const char *fileName, PartsListAttributes *pinnedList) {
+
+	// in the absence of the I/O thread the writing is done in place as before
+	if (!isActive()) {
+		waitForFile(fileName);
+		writer->setFileName(fileName);
+		writer->processParts();
+		return;
+	}
+
+	pthread_mutex_lock(&mutex);
+	if (!threadStarted) {
+		stopRequested = false;
+		if (pthread_create(&ioThread, NULL, runIoThread, NULL) != 0) {
+			pthread_mutex_unlock(&mutex);
+			std::cout << "Could not start the output writer thread\n";
+			std::exit(EXIT_FAILURE);
+		}
+		threadStarted = true;
+	}
+	pinnedList->pinForOutput();
+	jobQueue.push_back(new OutputJob(writer, fileName, pinnedList));
+	pthread_cond_broadcast(&condition);
+	pthread_mutex_unlock(&mutex);
+}
+
+void AsyncOutputWriter::waitForPartsList(PartsListAttributes *partsList) {
+	pthread_mutex_lock(&mutex);
+	while (partsList->getPendingOutputCount() > 0) {
+		pthread_cond_wait(&condition, &mutex);
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+void AsyncOutputWriter::waitForFile(const char *fileName) {
+	pthread_mutex_lock(&mutex);
+	while (isFilePending(fileName)) {
+		pthread_cond_wait(&condition, &mutex);
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+void AsyncOutputWriter::waitForWriter(PartWriter *writer) {
+	pthread_mutex_lock(&mutex);
+	while (isWriterPending(writer)) {
+		pthread_cond_wait(&condition, &mutex);
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+void AsyncOutputWriter::finishAll() {
+	pthread_mutex_lock(&mutex);
+	if (!threadStarted) {
+		pthread_mutex_unlock(&mutex);
+		return;
+	}
+	while (!jobQueue.empty() || currentJob != NULL) {
+		pthread_cond_wait(&condition, &mutex);
+	}
+	stopRequested = true;
+	pthread_cond_broadcast(&condition);
+	pthread_mutex_unlock(&mutex);
+	pthread_join(ioThread, NULL);
+	threadStarted = false;
+}
+
+void *AsyncOutputWriter::runIoThread(void *arg) {
+	while (true) {
+		pthread_mutex_lock(&mutex);
+		while (jobQueue.empty() && !stopRequested) {
+			pthread_cond_wait(&condition, &mutex);
+		}
+		if (jobQueue.empty()) {
+			pthread_mutex_unlock(&mutex);
+			break;
+		}
+		currentJob = jobQueue.front();
+		jobQueue.pop_front();
+		pthread_mutex_unlock(&mutex);
+
+		// the jobs are processed in the order they have been issued in all segments; so the writing turn messages
+		// exchanged among the writers of different segments match in the same order. Further, a writer object keeps
+		// the state of the part being written; having a single I/O thread ensures no two jobs use it at once
+		PartWriter *writer = currentJob->writer;
+		writer->setFileName(currentJob->fileName);
+		writer->processParts();
+
+		pthread_mutex_lock(&mutex);
+		currentJob->pinnedList->unpinAfterOutput();
+		delete currentJob;
+		currentJob = NULL;
+		pthread_cond_broadcast(&condition);
+		pthread_mutex_unlock(&mutex);
+	}
+	return NULL;
+}
+
+bool AsyncOutputWriter::isFilePending(const char *fileName) {
+	if (currentJob != NULL && strcmp(currentJob->fileName, fileName) == 0) return true;
+	std::list<OutputJob*>::iterator it;
+	for (it = jobQueue.begin(); it != jobQueue.end(); ++it) {
+		if (strcmp((*it)->fileName, fileName) == 0) return true;
+	}
+	return false;
+}
+
+bool AsyncOutputWriter::isWriterPending(PartWriter *writer) {
+	if (currentJob != NULL && currentJob->writer == writer) return true;
+	std::list<OutputJob*>::iterator it;
+	for (it = jobQueue.begin(); it != jobQueue.end(); ++it) {
+		if ((*it)->writer == writer) return true;
+	}
+	return false;
+}
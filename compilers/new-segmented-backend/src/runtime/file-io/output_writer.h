@@ -0,0 +1,69 @@
+#ifndef _H_output_writer
+#define _H_output_writer
+
+/* Writing an environmental array to a file through a PartWriter is a sequential process across segments: a segment waits
+ * for its predecessor to finish before it can write its own parts. If the coordinator program does the writing itself then
+ * it stalls until all segments before it are done. This header provides a background writer that has a dedicated I/O thread
+ * per segment processing output jobs in the order they have been issued. The coordinator program only enqueues a job and
+ * moves on to the next task invocation.
+ *
+ * The parts list being written is pinned through its attributes for the duration of the job. The environment management
+ * waits for the pending jobs on a parts list before that list is reclaimed and before a task invocation sets up its parts
+ * lists for an item, as a re-executed environment reuses the memory of the parts being written. Input binding waits for
+ * pending jobs on the file it is going to read, and the program waits for all jobs at the end before it finalizes MPI.
+ * */
+
+#include "data_handler.h"
+
+#include <pthread.h>
+#include <list>
+
+class PartsListAttributes;
+
+class OutputJob {
+  public:
+	PartWriter *writer;
+	// the job keeps its own copy of the file name as the coordinator program may reuse the string
+	char *fileName;
+	PartsListAttributes *pinnedList;
+	OutputJob(PartWriter *writer, const char *fileName, PartsListAttributes *pinnedList);
+	~OutputJob();
+};
+
+class AsyncOutputWriter {
+  private:
+	// background writing can be turned off by the deployment configuration; it is also skipped when MPI does not allow
+	// the I/O thread to exchange the writing turn messages concurrently with the rest of the program
+	static bool enabled;
+	static bool threadStarted;
+	static pthread_t ioThread;
+	// the mutex protects the job queue and the pending output counts of pinned parts lists; the condition variable is
+	// signaled both when a new job is added and when a job is finished
+	static pthread_mutex_t mutex;
+	static pthread_cond_t condition;
+	static std::list<OutputJob*> jobQueue;
+	static OutputJob *currentJob;
+	static bool stopRequested;
+  public:
+	static void disable() { enabled = false; }
+	static bool isActive();
+
+	// issues a write of the parts the writer is associated with to the file; the function returns immediately when
+	// background writing is active and does the writing in place otherwise
+	static void write(PartWriter *writer, const char *fileName, PartsListAttributes *pinnedList);
+
+	// functions to wait until there is no pending job on a parts list and on a file respectively
+	static void waitForPartsList(PartsListAttributes *partsList);
+	static void waitForFile(const char *fileName);
+	// waits until there is no pending job using a writer so that the writer can be deleted
+	static void waitForWriter(PartWriter *writer);
+
+	// waits for all issued jobs to finish and stops the I/O thread
+	static void finishAll();
+  private:
+	static void *runIoThread(void *arg);
+	static bool isFilePending(const char *fileName);
+	static bool isWriterPending(PartWriter *writer);
+};
+
+#endif
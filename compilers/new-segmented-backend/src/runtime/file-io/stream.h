@@ -19,20 +19,27 @@
 #include "../../../../common-libs/utils/string_utils.h"
 #include "../../../../common-libs/domain-obj/structure.h"
 
+#include "input_prefetcher.h"
+
 using namespace std;
 
 template <class Type> class TypedInputStream {
   protected:
 	const char *fileName;
 	List<Dimension*> *dimLengths;
-	List<int> *dimMultiplier;
+	List<long int> *dimMultiplier;
 	int dataBegins;
 	int seekStepSize;
 	ifstream stream;
+	// if the file has been prefetched by the input prefetcher then elements are read from its content instead of the file
+	PrefetchedFile *prefetchedFile;
+	long int readPosition;
   public:
 	TypedInputStream(const char *fileName) {
 		this->fileName = fileName;
 		seekStepSize = sizeof(Type);
+		prefetchedFile = NULL;
+		readPosition = 0;
 		initialize();
 		
 	}
@@ -47,6 +54,11 @@ template <class Type> class TypedInputStream {
 	}
 
 	void open() {
+		prefetchedFile = InputPrefetcher::getContent(fileName);
+		if (prefetchedFile != NULL) {
+			readPosition = dataBegins;
+			return;
+		}
 		stream.open(fileName, ios_base::binary);
 		if (!stream.is_open()) {
 			cout << "could not open input file: " << fileName << "\n";
@@ -54,12 +66,19 @@ template <class Type> class TypedInputStream {
 		}
 		stream.seekg(dataBegins, ios_base::beg);
 	}
-	void close() { stream.close(); }
+	void close() { 
+		if (prefetchedFile == NULL) stream.close();
+		prefetchedFile = NULL; 
+	}
 	List<Dimension*> *getDimensionList() { return dimLengths; }
 
 	// read an element at a specific index of the array 
-	Type readElement(List<int> *index) {
+	Type readElement(List<GlobalIndex> *index) {
 		long int seekPosition = getSeekPosition(index);
+		if (prefetchedFile != NULL) {
+			readPosition = seekPosition;
+			return readNextElement();
+		}
 		stream.seekg(seekPosition, ios_base::beg);
 		Type element;
 		stream.read(reinterpret_cast<char*>(&element), seekStepSize);
@@ -69,6 +88,14 @@ template <class Type> class TypedInputStream {
 	// read the element from current file read pointer location; use this with care 
 	Type readNextElement() {
 		Type element;
+		if (prefetchedFile != NULL) {
+			// like a read past the end of the file, a read past the end of the content leaves the element unset 
+			if (readPosition + seekStepSize <= prefetchedFile->contentSize) {
+				memcpy(&element, prefetchedFile->content + readPosition, seekStepSize);
+			}
+			readPosition += seekStepSize;
+			return element;
+		}
 		stream.read(reinterpret_cast<char*>(&element), seekStepSize);
 		return element;
 	}
@@ -118,7 +145,7 @@ template <class Type> class TypedInputStream {
 			string token = tokenList->Nth(0);
 			tokenList->RemoveAt(0);
 			istringstream str(token);
-			int dimensionLength;
+			GlobalIndex dimensionLength;
 			str >> dimensionLength;
 			Dimension *dim = new Dimension;
 			dim->range.min = 0;
@@ -133,8 +160,8 @@ template <class Type> class TypedInputStream {
 		dataBegins = stream.tellg();
 
 		// initialize the dim-multiplier-list for random access
-		dimMultiplier = new List<int>;
-		int currentMultiplier = 1;
+		dimMultiplier = new List<long int>;
+		long int currentMultiplier = 1;
 		for (int i = dimLengths->NumElements() - 1; i >= 0; i--) {
 			dimMultiplier->InsertAt(currentMultiplier, 0);
 			currentMultiplier *= dimLengths->Nth(i)->length;
@@ -144,7 +171,7 @@ template <class Type> class TypedInputStream {
 		delete[] ch;
 	}
 
-	long int getSeekPosition(List<int> *elementIndex) {
+	long int getSeekPosition(List<GlobalIndex> *elementIndex) {
 		long int positionNo = 0;
 		for (int i = 0; i < elementIndex->NumElements(); i++) {
 			positionNo += elementIndex->Nth(i) * dimMultiplier->Nth(i);
@@ -157,7 +184,7 @@ template <class Type> class TypedOutputStream {
   protected:
 	const char *fileName;
 	List<Dimension*> *dimLengths;
-	List<int> *dimMultiplier;
+	List<long int> *dimMultiplier;
 	int dataBegins;
 	int seekStepSize;
 	ofstream stream;
@@ -186,7 +213,7 @@ template <class Type> class TypedOutputStream {
 	}
 	void close() { stream.close(); }
 
-	void writeElement(Type element, List<int> *index) {
+	void writeElement(Type element, List<GlobalIndex> *index) {
 		long int seekPosition = getSeekPosition(index);
 		stream.seekp(seekPosition, ios_base::beg);
 		stream.write(reinterpret_cast<char*>(&element), seekStepSize);
@@ -212,7 +239,7 @@ template <class Type> class TypedOutputStream {
 		for (int i = 0; i < dimLengths->NumElements(); i++) {
 			ostringstream str;
 			if (i > 0) str << "*";
-			int dimLength = dimLengths->Nth(i)->length;
+			GlobalIndex dimLength = dimLengths->Nth(i)->length;
 			str << dimLength;
 			totalElements *= dimLength;
 			int strLength = str.str().length();
@@ -224,7 +251,7 @@ template <class Type> class TypedOutputStream {
 
 		// zero fill the file to facilitate later update without facing the problem of crossing the end-of-file marker
 		Type zero = 0;
-		for (int i = 0; i < totalElements; i++) {
+		for (long int i = 0; i < totalElements; i++) {
 			stream.write(reinterpret_cast<char*>(&zero), seekStepSize);
 		}
 		stream.close();
@@ -250,15 +277,15 @@ template <class Type> class TypedOutputStream {
 		istream.close();
 
 		// initialize the dim-multiplier-list for later random access updates
-		dimMultiplier = new List<int>;
-		int currentMultiplier = 1;
+		dimMultiplier = new List<long int>;
+		long int currentMultiplier = 1;
 		for (int i = dimLengths->NumElements() - 1; i >= 0; i--) {
 			dimMultiplier->InsertAt(currentMultiplier, 0);
 			currentMultiplier *= dimLengths->Nth(i)->length;
 		}
 	}
 
-	long int getSeekPosition(List<int> *elementIndex) {
+	long int getSeekPosition(List<GlobalIndex> *elementIndex) {
 		long int positionNo = 0;
 		for (int i = 0; i < elementIndex->NumElements(); i++) {
 			positionNo += elementIndex->Nth(i) * dimMultiplier->Nth(i);
@@ -7,6 +7,8 @@
 
 #include <vector>
 #include <cstring>
+#include <iostream>
+#include <cstdlib>
 
 //---------------------------------------------------------------- Part Metadata ---------------------------------------------------------------/
 
@@ -18,6 +20,18 @@ PartMetadata::PartMetadata(int dimensionality, List<int*> *idList, Dimension *bo
 	this->boundary = boundary;
 	this->padding = padding;
 
+#ifdef LARGE_INDEX_SPACE
+	// the generated code indexes the elements of a part using 32-bit offsets relative to the part boundary; so no
+	// dimension of a part can be longer than the offset limit even when the array itself is
+	for (int d = 0; d < dimensionality; d++) {
+		if (boundary[d].getLength() > LOCAL_OFFSET_LIMIT) {
+			std::cout << "A data part has " << boundary[d].getLength() << " indexes along dimension " << d;
+			std::cout << ", which is beyond the limit of a part; use a finer partition for the array\n";
+			std::exit(EXIT_FAILURE);
+		}
+	}
+#endif
+
 	this->idList = new List<int*>;
         Assert(this->idList != NULL);
         for (int i = 0; i < idList->NumElements(); i++) {
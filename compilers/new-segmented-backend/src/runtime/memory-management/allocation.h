@@ -93,6 +93,7 @@ class DataPart {
 	void allocate(int versionThreshold = 0);
 	
 	inline PartMetadata *getMetadata() { return metadata; }
+	inline int getEpochCount() { return epochCount; }
 
 	// returns the memory reference of the allocation unit at the current epoch-head
 	void *getData();
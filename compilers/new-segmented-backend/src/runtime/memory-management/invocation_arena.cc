@@ -0,0 +1,87 @@
+#include "invocation_arena.h"
+
+#include "../../../../common-libs/utils/list.h"
+
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+//----------------------------------------------------------- Invocation Arena -----------------------------------------------------------/
+
+__thread InvocationArena *InvocationArena::current = NULL;
+int InvocationArena::invocationsCount = 0;
+long int InvocationArena::totalReleasedObjects = 0;
+long int InvocationArena::totalReleasedBytes = 0;
+
+InvocationArena::InvocationArena() {
+	entries = new List<ArenaEntry*>;
+	trackedBytes = 0;
+	residentAtStart = getResidentMemory();
+}
+
+InvocationArena::~InvocationArena() {
+	release();
+	delete entries;
+}
+
+void InvocationArena::beginInvocation() {
+	// an arena left open by an earlier invocation is released before the new one starts
+	if (current != NULL) delete current;
+	current = new InvocationArena();
+}
+
+void InvocationArena::endInvocation(std::ofstream &logFile) {
+	if (current == NULL) return;
+	InvocationArena *arena = current;
+	current = NULL;
+
+	int objectsCount = arena->entries->NumElements();
+	long int bytes = arena->trackedBytes;
+	long int residentAtStart = arena->residentAtStart;
+	delete arena;
+
+	invocationsCount++;
+	totalReleasedObjects += objectsCount;
+	totalReleasedBytes += bytes;
+
+	long int resident = getResidentMemory();
+	logFile << "Invocation arena released: " << objectsCount << " objects, " << bytes << " bytes\n";
+	logFile << "Live memory: " << resident << " KB resident (" << resident - residentAtStart;
+	logFile << " KB retained by the invocation), " << getPeakResidentMemory() << " KB peak\n";
+	logFile << "Arena totals over " << invocationsCount << " invocations: " << totalReleasedObjects;
+	logFile << " objects, " << totalReleasedBytes << " bytes\n";
+	logFile.flush();
+}
+
+long int InvocationArena::getResidentMemory() {
+	FILE *statm = fopen("/proc/self/statm", "r");
+	if (statm == NULL) return 0;
+	long int totalPages = 0;
+	long int residentPages = 0;
+	int fieldsRead = fscanf(statm, "%ld %ld", &totalPages, &residentPages);
+	fclose(statm);
+	if (fieldsRead != 2) return 0;
+	return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+long int InvocationArena::getPeakResidentMemory() {
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+	// Linux reports the maximum resident set size in kilobytes
+	return usage.ru_maxrss;
+}
+
+void InvocationArena::addEntry(ArenaEntry *entry) {
+	entries->Append(entry);
+	trackedBytes += entry->getSize();
+}
+
+void InvocationArena::release() {
+	// delete objects in the reverse order of their registration
+	for (int i = entries->NumElements() - 1; i >= 0; i--) {
+		delete entries->Nth(i);
+	}
+	entries->clear();
+}
@@ -0,0 +1,107 @@
+#ifndef _H_invocation_arena
+#define _H_invocation_arena
+
+/* A task's execute function creates a large number of small runtime objects for each invocation: thread states with
+   their LPS states and LPUs, thread IDs, task-locals copies, segment groupings, part iterators, and so on. None of them
+   is needed after the invocation finishes; but as they were never freed, a coordinator program that invokes its tasks
+   thousands of times -- an iterative solver, for example -- kept growing in memory until the machine stalled.
+
+   The invocation arena collects the objects created on behalf of the task invocation currently in progress and deletes
+   them all at once when the invocation ends. An object is registered with the arena at the point of its allocation, as
+   in 'ThreadIds *ids = InvocationArena::track(getPpuIdsForThread(i))', so the ownership is evident where the object is
+   created rather than being scattered among cleanup routines. Objects are deleted in the reverse order of registration;
+   so an object may safely refer to any object registered before it in its destructor.
+
+   The arena also keeps counters of the objects and bytes it has handled and reports them, along with the resident
+   memory of the segment process, in the task log at the end of each invocation. The resident memory at the end of
+   successive invocations of a task should stay flat; a steady growth indicates a leak the arena does not cover yet.
+
+   Objects should be registered from the thread running the task's execute function, before the PPU controller threads
+   are launched or after they have finished, as the arena is not protected against concurrent updates. Further, data
+   parts and everything else held by the program environment outlive task invocations and should never be registered
+   with the arena.
+*/
+
+#include "../../../../common-libs/utils/list.h"
+
+#include <fstream>
+
+/* type-erased entry for an object the arena should delete */
+class ArenaEntry {
+  public:
+	virtual ~ArenaEntry() {}
+	virtual long int getSize() = 0;
+};
+
+template <class Type> class ArenaObject : public ArenaEntry {
+  protected:
+	Type *object;
+  public:
+	ArenaObject(Type *object) { this->object = object; }
+	~ArenaObject() { delete object; }
+	long int getSize() { return sizeof(Type); }
+};
+
+template <class Type> class ArenaArray : public ArenaEntry {
+  protected:
+	Type *array;
+	long int length;
+  public:
+	ArenaArray(Type *array, long int length) {
+		this->array = array;
+		this->length = length;
+	}
+	~ArenaArray() { delete[] array; }
+	long int getSize() { return sizeof(Type) * length; }
+};
+
+class InvocationArena {
+  protected:
+	List<ArenaEntry*> *entries;
+	long int trackedBytes;
+	// resident memory of the process when the invocation started
+	long int residentAtStart;
+
+	// the arena of the task invocation in progress in the current thread; independent invocations launched together
+	// by the coordinator program run their execute functions in separate threads and each has its own arena
+	static __thread InvocationArena *current;
+
+	// counters accumulated over all invocations of the segment process
+	static int invocationsCount;
+	static long int totalReleasedObjects;
+	static long int totalReleasedBytes;
+  public:
+	InvocationArena();
+	~InvocationArena();
+
+	// functions to be called at the beginning and end of a task's execute function; the latter deletes all tracked
+	// objects and logs the memory counters
+	static void beginInvocation();
+	static void endInvocation(std::ofstream &logFile);
+
+	// Registers an object or an array for deletion at the end of the current invocation and returns it back. If no
+	// invocation is in progress, the object is returned untracked, which is the same as the behavior before there
+	// was an arena.
+	template <class Type> static Type *track(Type *object) {
+		if (current != NULL && object != NULL) {
+			current->addEntry(new ArenaObject<Type>(object));
+		}
+		return object;
+	}
+	template <class Type> static Type *trackArray(Type *array, long int length) {
+		if (current != NULL && array != NULL) {
+			current->addEntry(new ArenaArray<Type>(array, length));
+		}
+		return array;
+	}
+
+	// returns the resident set size and the peak resident set size of the current process in kilobytes; the value
+	// is 0 when it cannot be determined
+	static long int getResidentMemory();
+	static long int getPeakResidentMemory();
+  protected:
+	void addEntry(ArenaEntry *entry);
+	void release();
+};
+
+#endif
@@ -27,7 +27,7 @@ PartIntervalPattern::PartIntervalPattern() {
 	instances = 0;
 }
 
-PartIntervalPattern::PartIntervalPattern(int c, int p, int l, int o, int i) {
+PartIntervalPattern::PartIntervalPattern(GlobalIndex c, GlobalIndex p, GlobalIndex l, GlobalIndex o, int i) {
 	beginExpr = NULL;
 	count = c;
 	period = p;
@@ -53,7 +53,7 @@ bool PartIntervalPattern::isEqualIgnoringInstanceCount(PartIntervalPattern *othe
 			&& (overflow == other->overflow);
 }
 
-int PartIntervalPattern::getPartLength() {
+GlobalIndex PartIntervalPattern::getPartLength() {
 	return count * length + overflow;
 }
 
@@ -133,7 +133,7 @@ void DimPartitionConfig::getHierarchicalDimensionAndPartCountInfo(List<Dimension
 	}
 }
 
-int DimPartitionConfig::getOriginalIndex(int partIndex, int position, 
+GlobalIndex DimPartitionConfig::getOriginalIndex(GlobalIndex partIndex, int position, 
 		List<int> *partIdList,
 		List<int> *partCountList, 
 		List<Dimension*> *partDimensionList) {
@@ -167,18 +167,24 @@ List<PartIntervalPattern*> *DimPartitionConfig::getPartIntervalPatterns(Dimensio
 //------------------------------------------------------------ Block Size Config ----------------------------------------------------------/
 
 int BlockSizeConfig::getPartsCount(Dimension parentDimension) {
-	int size = partitionArgs[0];
-	int dimLength = parentDimension.length;
+	GlobalIndex size = partitionArgs[0];
+	GlobalIndex dimLength = parentDimension.length;
 	return (dimLength + size - 1) / size;
 }
 
+int BlockSizeConfig::getPartIdOfIndex(GlobalIndex index) {
+	if (hasPadding() || !dataDimension.range.contains(index)) return INVALID_ID;
+	GlobalIndex size = partitionArgs[0];
+	return (index - dataDimension.range.min) / size;
+}
+
 Dimension BlockSizeConfig::getPartDimension(int partId, Dimension parentDimension) {
 	
-	int size = partitionArgs[0];
+	GlobalIndex size = partitionArgs[0];
 	int partsCount = getPartsCount(parentDimension);
-	int begin = parentDimension.range.min + partId * size;
-	int remaining = parentDimension.range.max - begin + 1;
-	int intervalLength = (remaining >= size) ? size : remaining;
+	GlobalIndex begin = parentDimension.range.min + partId * size;
+	GlobalIndex remaining = parentDimension.range.max - begin + 1;
+	GlobalIndex intervalLength = (remaining >= size) ? size : remaining;
 
 	if (paddings[0] > 0) {
 		int frontPadding = getEffectiveFrontPadding(partId, parentDimension);
@@ -198,27 +204,27 @@ Dimension BlockSizeConfig::getPartDimension(int partId, Dimension parentDimensio
 
 int BlockSizeConfig::getEffectiveFrontPadding(int partId, Dimension parentDimension) {
 	if (paddings[0] == 0) return 0;
-	int size = partitionArgs[0];
+	GlobalIndex size = partitionArgs[0];
 	int partsCount = getPartsCount(parentDimension);
-	int begin = parentDimension.range.min + partId * size;
-	int paddedBegin = std::max(parentDimension.range.min, begin - paddings[0]);
+	GlobalIndex begin = parentDimension.range.min + partId * size;
+	GlobalIndex paddedBegin = std::max(parentDimension.range.min, begin - paddings[0]);
 	return begin - paddedBegin;
 }
 
 int BlockSizeConfig::getEffectiveRearPadding(int partId, Dimension parentDimension) {
 	if (paddings[1] == 0) return 0;
-	int size = partitionArgs[0];
+	GlobalIndex size = partitionArgs[0];
 	int partsCount = getPartsCount(parentDimension);
-	int begin = parentDimension.range.min + partId * size;
-	int remaining = parentDimension.range.max - begin + 1;
-	int length = (remaining >= size) ? size : remaining;
-	int end = begin + length - 1;
-	int paddedEnd = std::min(parentDimension.range.max, end + paddings[1]);
+	GlobalIndex begin = parentDimension.range.min + partId * size;
+	GlobalIndex remaining = parentDimension.range.max - begin + 1;
+	GlobalIndex length = (remaining >= size) ? size : remaining;
+	GlobalIndex end = begin + length - 1;
+	GlobalIndex paddedEnd = std::min(parentDimension.range.max, end + paddings[1]);
 	return paddedEnd - end;
 }
 
 PartitionInstr *BlockSizeConfig::getPartitionInstr() {
-	int size = partitionArgs[0];
+	GlobalIndex size = partitionArgs[0];
 	BlockSizeInstr *instr = new BlockSizeInstr(size);
 	Assert(instr != NULL);
 	instr->setPadding(paddings[0], paddings[1]);
@@ -238,7 +244,7 @@ List<PartIntervalPattern*> *BlockSizeConfig::getPartIntervalPatterns(Dimension o
 	int partsCount = getPartsCount(origDimension);
 	if (partsCount == 1) return DimPartitionConfig::getPartIntervalPatterns(origDimension);
 	
-	int size = partitionArgs[0];
+	GlobalIndex size = partitionArgs[0];
 	List<PartIntervalPattern*> *patternList = new List<PartIntervalPattern*>;
 	
 	// separately create a pattern description for the first part as it might differ from the rest if there is a
@@ -288,16 +294,23 @@ List<PartIntervalPattern*> *BlockSizeConfig::getPartIntervalPatterns(Dimension o
 
 int BlockCountConfig::getPartsCount(Dimension parentDimension) {
 	int count = partitionArgs[0];
-	int length = parentDimension.length;
-        return std::max(1, std::min(count, length));
+	GlobalIndex length = parentDimension.length;
+        return std::max(1, (int) std::min((GlobalIndex) count, length));
+}
+
+int BlockCountConfig::getPartIdOfIndex(GlobalIndex index) {
+	if (hasPadding() || !dataDimension.range.contains(index)) return INVALID_ID;
+	int count = getPartsCount(dataDimension);
+	GlobalIndex size = dataDimension.length / count;
+	return (int) std::min((index - dataDimension.range.min) / size, (GlobalIndex) count - 1);
 }
 
 Dimension BlockCountConfig::getPartDimension(int partId, Dimension parentDimension) {
 	
 	int count = getPartsCount(parentDimension);
-	int size = parentDimension.length / count;
-	int begin = parentDimension.range.min + partId * size;
-	int length = (partId < count - 1) ? size : parentDimension.range.max - begin + 1;
+	GlobalIndex size = parentDimension.length / count;
+	GlobalIndex begin = parentDimension.range.min + partId * size;
+	GlobalIndex length = (partId < count - 1) ? size : parentDimension.range.max - begin + 1;
 
 	if (paddings[0] > 0) {
 		int frontPadding = getEffectiveFrontPadding(partId, parentDimension);
@@ -318,20 +331,20 @@ Dimension BlockCountConfig::getPartDimension(int partId, Dimension parentDimensi
 int BlockCountConfig::getEffectiveFrontPadding(int partId, Dimension parentDimension) {
 	if (paddings[0] == 0) return 0;
 	int count = getPartsCount(parentDimension);
-	int size = parentDimension.length / count;
-	int begin = parentDimension.range.min + partId * size;
-	int paddedBegin = std::max(parentDimension.range.min, begin - paddings[0]);
+	GlobalIndex size = parentDimension.length / count;
+	GlobalIndex begin = parentDimension.range.min + partId * size;
+	GlobalIndex paddedBegin = std::max(parentDimension.range.min, begin - paddings[0]);
 	return begin - paddedBegin;
 }
                
 int BlockCountConfig::getEffectiveRearPadding(int partId, Dimension parentDimension) {
 	if (paddings[1] == 0) return 0;
 	int count = getPartsCount(parentDimension);
-	int size = parentDimension.length / count;
-	int begin = parentDimension.range.min + partId * size;
-	int length = (partId < count - 1) ? size : parentDimension.range.max - begin + 1;
-	int end = begin + length - 1;
-	int paddedEnd = std::min(parentDimension.range.max, end + paddings[1]);
+	GlobalIndex size = parentDimension.length / count;
+	GlobalIndex begin = parentDimension.range.min + partId * size;
+	GlobalIndex length = (partId < count - 1) ? size : parentDimension.range.max - begin + 1;
+	GlobalIndex end = begin + length - 1;
+	GlobalIndex paddedEnd = std::min(parentDimension.range.max, end + paddings[1]);
 	return paddedEnd - end;
 }
 
@@ -360,7 +373,7 @@ List<PartIntervalPattern*> *BlockCountConfig::getPartIntervalPatterns(Dimension
 
 	// calculation of the parts' size is the place where the logics for block-count and block-size configuration
 	// differs 
-	int size = origDimension.length / partsCount;
+	GlobalIndex size = origDimension.length / partsCount;
 
 	List<PartIntervalPattern*> *patternList = new List<PartIntervalPattern*>;
 	
@@ -407,20 +420,138 @@ List<PartIntervalPattern*> *BlockCountConfig::getPartIntervalPatterns(Dimension
 	return patternList;	
 }
 
+//--------------------------------------------------------- Weighted Block Config ---------------------------------------------------------/
+
+WeightedBlockConfig::WeightedBlockConfig(Dimension dimension, int *partitionArgs, int paddings[2], 
+		int ppuCount, int lpsAlignment, PartitionWeights *weights) 
+		: DimPartitionConfig(dimension, partitionArgs, paddings, ppuCount, lpsAlignment) {
+	this->weights = weights;
+	int count = getPartsCount(dimension);
+	if (weights == NULL) {
+		PartitionWeights::getUniformCuts(dimension.range, count, dataCuts);
+	} else {
+		weights->getCuts(dimension.range, dimension.range.min, count, dataCuts);
+	}
+}
+
+int WeightedBlockConfig::getPartsCount(Dimension parentDimension) {
+	int count = partitionArgs[0];
+	GlobalIndex length = parentDimension.length;
+        return std::max(1, (int) std::min((GlobalIndex) count, length));
+}
+
+int WeightedBlockConfig::getPartIdOfIndex(GlobalIndex index) {
+	if (hasPadding() || !dataDimension.range.contains(index)) return INVALID_ID;
+	return std::upper_bound(dataCuts.begin(), dataCuts.end(), index) - dataCuts.begin() - 1;
+}
+
+Range WeightedBlockConfig::getPartRange(int partId, Dimension parentDimension) {
+	if (parentDimension.range.min == dataDimension.range.min 
+			&& parentDimension.range.max == dataDimension.range.max) {
+		return Range(dataCuts[partId], dataCuts[partId + 1] - 1);
+	}
+	// a part of an already divided dimension is cut from the weights of its own indices only
+	std::vector<GlobalIndex> cuts;
+	int count = getPartsCount(parentDimension);
+	if (weights == NULL) {
+		PartitionWeights::getUniformCuts(parentDimension.range, count, cuts);
+	} else {
+		weights->getCuts(parentDimension.range, dataDimension.range.min, count, cuts);
+	}
+	return Range(cuts[partId], cuts[partId + 1] - 1);
+}
+
+Dimension WeightedBlockConfig::getPartDimension(int partId, Dimension parentDimension) {
+	
+	Range partRange = getPartRange(partId, parentDimension);
+	GlobalIndex begin = partRange.min;
+	GlobalIndex length = partRange.max - partRange.min + 1;
+
+	if (paddings[0] > 0) {
+		int frontPadding = getEffectiveFrontPadding(partId, parentDimension);
+		begin -= frontPadding;
+		length += frontPadding;
+	}
+	if (paddings[1] > 0) {
+		length += getEffectiveRearPadding(partId, parentDimension);
+	}
+
+	Dimension partDimension;
+	partDimension.range.min = begin;
+	partDimension.range.max = begin + length - 1;
+	partDimension.setLength();
+	return partDimension;
+}
+
+int WeightedBlockConfig::getEffectiveFrontPadding(int partId, Dimension parentDimension) {
+	if (paddings[0] == 0) return 0;
+	GlobalIndex begin = getPartRange(partId, parentDimension).min;
+	GlobalIndex paddedBegin = std::max(parentDimension.range.min, begin - paddings[0]);
+	return begin - paddedBegin;
+}
+               
+int WeightedBlockConfig::getEffectiveRearPadding(int partId, Dimension parentDimension) {
+	if (paddings[1] == 0) return 0;
+	GlobalIndex end = getPartRange(partId, parentDimension).max;
+	GlobalIndex paddedEnd = std::min(parentDimension.range.max, end + paddings[1]);
+	return paddedEnd - end;
+}
+
+PartitionInstr *WeightedBlockConfig::getPartitionInstr() {
+	int count = partitionArgs[0];
+	WeightedBlockInstr *instr = new WeightedBlockInstr(count, weights, dataDimension.range.min);
+	Assert(instr != NULL);
+	instr->setPadding(paddings[0], paddings[1]);
+	return instr;
+}
+
+bool WeightedBlockConfig::isEqual(DimPartitionConfig *otherConfig) {
+	WeightedBlockConfig *other = dynamic_cast<WeightedBlockConfig*>(otherConfig);
+	if (other == NULL) return false;
+	return (partitionArgs[0] == other->partitionArgs[0])
+			&& (paddings[0] == other->paddings[0])
+			&& (paddings[1] == other->paddings[1])
+			&& (weights == other->weights);
+}
+
+// unlike the other block partitions, the parts here differ in length; so each part gets its own pattern
+List<PartIntervalPattern*> *WeightedBlockConfig::getPartIntervalPatterns(Dimension origDimension) {
+	
+	int partsCount = getPartsCount(origDimension);
+	if (partsCount == 1) return DimPartitionConfig::getPartIntervalPatterns(origDimension);
+
+	List<PartIntervalPattern*> *patternList = new List<PartIntervalPattern*>;
+	for (int i = 0; i < partsCount; i++) {
+		Dimension partDim = getPartDimension(i, origDimension);
+		PartIntervalPattern *pattern = new PartIntervalPattern(1, partDim.length, partDim.length, 0, 1);
+		std::ostringstream stream;
+		stream << partDim.range.min;
+		pattern->beginExpr = strdup(stream.str().c_str());
+		patternList->Append(pattern);
+	}
+	return patternList;
+}
+
 //-------------------------------------------------------------- Stride Config ------------------------------------------------------------/
 
 int StrideConfig::getPartsCount(Dimension parentDimension) {
-	int length = parentDimension.length;
-        return std::max(1, std::min(ppuCount, length));
+	GlobalIndex length = parentDimension.length;
+        return std::max(1, (int) std::min((GlobalIndex) ppuCount, length));
+}
+
+int StrideConfig::getPartIdOfIndex(GlobalIndex index) {
+	if (!dataDimension.range.contains(index)) return INVALID_ID;
+	int partsCount = getPartsCount(dataDimension);
+	return (index - dataDimension.range.min) % partsCount;
 }
 
 Dimension StrideConfig::getPartDimension(int partId, Dimension parentDimension) {
 	int partsCount = getPartsCount(parentDimension);
-	int length = parentDimension.length;
-	int perStrideEntries = length / partsCount;
-        int myEntries = perStrideEntries;
-        int remainder = length % partsCount;
-        int extra = 0;
+	GlobalIndex length = parentDimension.length;
+	GlobalIndex perStrideEntries = length / partsCount;
+        GlobalIndex myEntries = perStrideEntries;
+        GlobalIndex remainder = length % partsCount;
+        GlobalIndex extra = 0;
         if (remainder > 0) extra = remainder;
         if (remainder > partId) {
                 myEntries++;
@@ -433,13 +564,13 @@ Dimension StrideConfig::getPartDimension(int partId, Dimension parentDimension)
 	return partDimension.getNormalizedDimension();
 }
 
-int StrideConfig::getOriginalIndex(int partIndex, int position, List<int> *partIdList,        
+GlobalIndex StrideConfig::getOriginalIndex(GlobalIndex partIndex, int position, List<int> *partIdList,        
 		List<int> *partCountList,
 		List<Dimension*> *partDimensionList) {
 
 	int partId = partIdList->Nth(position);
 	int partCount = partCountList->Nth(position);
-	int originalIndex = partId + partIndex * partCount;
+	GlobalIndex originalIndex = partId + partIndex * partCount;
 	
 	if (position > 0) {
 		Dimension *parentDimension = partDimensionList->Nth(position - 1);
@@ -464,8 +595,8 @@ List<PartIntervalPattern*> *StrideConfig::getPartIntervalPatterns(Dimension orig
 	if (partsCount == 1) return DimPartitionConfig::getPartIntervalPatterns(origDimension);
 
 	// determine if the number of stride steps and if the strides divide the original dimension evenly
-	int steps = origDimension.length / partsCount;
-	int remainder = origDimension.length % partsCount;
+	GlobalIndex steps = origDimension.length / partsCount;
+	GlobalIndex remainder = origDimension.length % partsCount;
 
 	List<PartIntervalPattern*> *patternList = new List<PartIntervalPattern*>;
 	
@@ -492,23 +623,30 @@ List<PartIntervalPattern*> *StrideConfig::getPartIntervalPatterns(Dimension orig
 //----------------------------------------------------------- Block Stride Config ---------------------------------------------------------/
 
 int BlockStrideConfig::getPartsCount(Dimension parentDimension) {
-	int blockSize = partitionArgs[0];
-	int length = parentDimension.length;
-        int strides = length / blockSize;
-        return std::max(1, std::min(strides, ppuCount));
+	GlobalIndex blockSize = partitionArgs[0];
+	GlobalIndex length = parentDimension.length;
+        GlobalIndex strides = length / blockSize;
+        return std::max(1, (int) std::min(strides, (GlobalIndex) ppuCount));
+}
+
+int BlockStrideConfig::getPartIdOfIndex(GlobalIndex index) {
+	if (!dataDimension.range.contains(index)) return INVALID_ID;
+	int partsCount = getPartsCount(dataDimension);
+	GlobalIndex blockSize = partitionArgs[0];
+	return ((index - dataDimension.range.min) / blockSize) % partsCount;
 }
 
 Dimension BlockStrideConfig::getPartDimension(int partId, Dimension parentDimension) {
 
 	int partsCount = getPartsCount(parentDimension);
-	int blockSize = partitionArgs[0];
-        int strideLength = blockSize * partsCount;
-        int strideCount = parentDimension.length / strideLength;
-        int myEntries = strideCount * blockSize;
+	GlobalIndex blockSize = partitionArgs[0];
+        GlobalIndex strideLength = blockSize * partsCount;
+        GlobalIndex strideCount = parentDimension.length / strideLength;
+        GlobalIndex myEntries = strideCount * blockSize;
         
-	int partialStrideElements = parentDimension.length % strideLength;
+	GlobalIndex partialStrideElements = parentDimension.length % strideLength;
         int blockCount = partialStrideElements / blockSize;
-        int extraEntriesBefore = partialStrideElements;
+        GlobalIndex extraEntriesBefore = partialStrideElements;
 
         // if extra entries fill up a complete new block in the stride of the current LPU then its number of 
 	// entries should increase by the size parameter and extra preceding entries should equal to 
@@ -531,14 +669,14 @@ Dimension BlockStrideConfig::getPartDimension(int partId, Dimension parentDimens
         return partDimension.getNormalizedDimension();
 }
 
-int BlockStrideConfig::getOriginalIndex(int partIndex, int position, List<int> *partIdList,
+GlobalIndex BlockStrideConfig::getOriginalIndex(GlobalIndex partIndex, int position, List<int> *partIdList,
 		List<int> *partCountList,
 		List<Dimension*> *partDimensionList) {
 	
 	int partId = partIdList->Nth(position);
 	int partCount = partCountList->Nth(position);
-	int blockSize = partitionArgs[0];
-	int originalIndex = ((partIndex / blockSize) * partCount + partId) * blockSize 
+	GlobalIndex blockSize = partitionArgs[0];
+	GlobalIndex originalIndex = ((partIndex / blockSize) * partCount + partId) * blockSize 
 			+ partIndex % blockSize;
 	
 	if (position > 0) {
@@ -553,7 +691,7 @@ int BlockStrideConfig::getOriginalIndex(int partIndex, int position, List<int> *
 }
 
 PartitionInstr *BlockStrideConfig::getPartitionInstr() {
-	int blockSize = partitionArgs[0];
+	GlobalIndex blockSize = partitionArgs[0];
 	PartitionInstr *instr = new BlockStrideInstr(ppuCount, blockSize);
 	Assert(instr != NULL);
 	return instr; 
@@ -570,17 +708,17 @@ List<PartIntervalPattern*> *BlockStrideConfig::getPartIntervalPatterns(Dimension
 	int partsCount = getPartsCount(origDimension);
 	if (partsCount == 1) return DimPartitionConfig::getPartIntervalPatterns(origDimension);
 	
-	int blockSize = partitionArgs[0];
+	GlobalIndex blockSize = partitionArgs[0];
 	List<PartIntervalPattern*> *patternList = new List<PartIntervalPattern*>;
 	
 	// There are three possible patterns for a block stride configuration. In the general case, most parts will
 	// have the same number of stride steps. In case the dimension is not partitioned evenly, however, some parts
 	// may have an extra steps; and at most one part may have an overflow, i.e., a partial steps.
-	int strideLength = blockSize * partsCount;
-	int steps = origDimension.length / strideLength;
-	int remainder = origDimension.length % strideLength;
+	GlobalIndex strideLength = blockSize * partsCount;
+	GlobalIndex steps = origDimension.length / strideLength;
+	GlobalIndex remainder = origDimension.length % strideLength;
 	int partialBlocks = remainder / blockSize;
-	int overflow = remainder % blockSize;
+	GlobalIndex overflow = remainder % blockSize;
 
 	// create a begin expression common to all parts
 	std::ostringstream stream;
@@ -768,7 +906,7 @@ List<int*> *DataPartitionConfig::generateSuperPartId(List<int*> *lpuIds, int bac
 	Assert(partId != NULL);
 
 	int position = lpuIds->NumElements() - 1;
-	int steps = 0;
+	GlobalIndex steps = 0;
 	DataPartitionConfig *lastConfig = this;
 	while (steps < backsteps) {
 		position -= lastConfig->parentJump;
@@ -1082,7 +1220,7 @@ bool DataPartitionConfig::generateSimilarParts(List<std::vector<DimPartitionConf
 		// Even if the patterns are similar at the current level, when they are divided at the subsequent levels
 		// by upcoming partition instructions, they can become different. Therefore, we need to roll the recursion
 		// for each parts of the pattern generated here
-		int partLength = firstPattern->getPartLength();
+		GlobalIndex partLength = firstPattern->getPartLength();
 		// The begining of a part's dimension does not influence how it should be divided by partition instructions.
 		// Thus, we can create a single dimension object of appropriate length for all parts
 		Dimension nextDimension;
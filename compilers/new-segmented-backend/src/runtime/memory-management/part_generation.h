@@ -55,23 +55,23 @@ class PartIntervalPattern {
 	// runtime arguments for the partition and padding parameters and setup the numerical values for the
 	// multiplier and the offset so that patterns comparison can be done effectively   
 	const char *beginExpr;
-	int count;
-	int period;
-	int length;
+	GlobalIndex count;
+	GlobalIndex period;
+	GlobalIndex length;
 	// Dometimes a partition instruction may not divide the dimension evenly among the generated parts. Then
 	// it may create some parts having some overflow indices from the trailing end of the dimension. The 
 	// following field retains the overflow amount. Note that a new pattern should be generated for each
 	// distinct overflow amount  
-	int overflow;
+	GlobalIndex overflow;
 	// the number of times the pattern occurs in the generated parts
 	int instances;
   public:
 	PartIntervalPattern();
 	// a second constructor for convenience that sets every field execpt the begin expression
-	PartIntervalPattern(int c, int p, int l, int o, int i);
+	PartIntervalPattern(GlobalIndex c, GlobalIndex p, GlobalIndex l, GlobalIndex o, int i);
 	bool isEqual(PartIntervalPattern *other);
 	bool isEqualIgnoringInstanceCount(PartIntervalPattern *other);
-	int getPartLength();	
+	GlobalIndex getPartLength();	
 };
 
 /* Superclass to represent the partition configuration applied for a particular dimension of an array for an LPS. 
@@ -115,6 +115,9 @@ class DimPartitionConfig {
 	virtual ~DimPartitionConfig() {}
 
 	bool hasPadding() { return paddings[0] > 0 || paddings[1] > 0; }
+	int getFrontPadding() { return paddings[0]; }
+	int getRearPadding() { return paddings[1]; }
+	int *getPartitionArgs() { return partitionArgs; }
 	Dimension getDataDimension() { return dataDimension; }
 	void setParentConfig(DimPartitionConfig *parentConfig) { this->parentConfig = parentConfig; }
 	int getLpsAlignment() { return lpsAlignment; }
@@ -144,7 +147,7 @@ class DimPartitionConfig {
 	// a data point along a dimension that might be reordered one or more time due to the use of reordering
 	// partition functions. The process of getting back the original index from a transformed one works 
 	// recursively backward from lower parts to upper parts.
-	virtual int getOriginalIndex(int partIndex, int position, List<int> *partIdList, 
+	virtual GlobalIndex getOriginalIndex(GlobalIndex partIndex, int position, List<int> *partIdList, 
 			List<int> *partCountList, 
 			List<Dimension*> *partDimensionList);
 
@@ -162,6 +165,13 @@ class DimPartitionConfig {
 	// dividing the parent dimension 
 	virtual int getPartsCount(Dimension parentDimension) = 0;
 
+	// Returns the Id of the part that holds the argument index of the data dimension when this configuration
+	// divides the whole data dimension, i.e., the dimension has not been divided in any ancestor LPS. This is
+	// the inverse of the part dimension calculation above. INVALID_ID is returned when the index is outside 
+	// the data dimension or when the part cannot be located without enumerating all the parts, e.g., because
+	// paddings make parts overlap.
+	virtual int getPartIdOfIndex(GlobalIndex index) { return INVALID_ID; }
+
 	// The DimPartitionConfig and its subclasses are designed state-free. So is the DataPartitionConfig 
 	// class that holds instances of these classes to specify the partition construction of a data structure
 	// for a particular LPS. For calculations related to communication, however, we need stateful versions
@@ -199,6 +209,7 @@ class ReplicationConfig : public DimPartitionConfig {
 	int pickPartId(int *lpsId) { return 0; } 		
 	int pickPartCount(int *lpuCount) { return 1; }
 	int getPartsCount(Dimension parentDimension) { return 1; }
+	int getPartIdOfIndex(GlobalIndex index) { return 0; }
 	Dimension getPartDimension(int partId, Dimension parentDimension) { return parentDimension; }		
 	PartitionInstr *getPartitionInstr() {
         	PartitionInstr *instr = new VoidInstr();
@@ -223,6 +234,7 @@ class BlockSizeConfig : public DimPartitionConfig {
 			partitionArgs, paddings, ppuCount, lpsAlignment) {}
 	
 	int getPartsCount(Dimension parentDimension);
+	int getPartIdOfIndex(GlobalIndex index);
 	Dimension getPartDimension(int partId, Dimension parentDimension);
 	PartitionInstr *getPartitionInstr();
 	bool isDegenerativeCase() { return false; }
@@ -242,6 +254,35 @@ class BlockCountConfig : public DimPartitionConfig {
 			partitionArgs, paddings, ppuCount, lpsAlignment) {}
 	
 	int getPartsCount(Dimension parentDimension);
+	int getPartIdOfIndex(GlobalIndex index);
+	Dimension getPartDimension(int partId, Dimension parentDimension);
+	PartitionInstr *getPartitionInstr();
+	bool isDegenerativeCase() { return partitionArgs[0] == 1; }
+	bool doesReorderIndices() { return false; }
+	bool isEqual(DimPartitionConfig *otherConfig);
+	List<PartIntervalPattern*> *getPartIntervalPatterns(Dimension origDimension);
+};
+
+/* configuration subclass corresponding to 'weighted_block' partition function; it takes a 'count' parameter like the 
+   block-count configuration, and the weights of the indices of the dimension that decide where the part boundaries are. 
+   When the weights are not available the parts are the same as that of the block-count configuration. */
+class WeightedBlockConfig : public DimPartitionConfig {
+  protected:
+	PartitionWeights *weights;
+	// first indices of the parts, plus one past the end of the last part, when the whole data dimension is divided;
+	// these are computed once as most parts are cut from the whole dimension  
+	std::vector<GlobalIndex> dataCuts;
+
+	// returns the paddingless range of a part
+	Range getPartRange(int partId, Dimension parentDimension);
+	int getEffectiveFrontPadding(int partId, Dimension parentDimension); 		
+	int getEffectiveRearPadding(int partId,  Dimension parentDimension);
+  public:
+	WeightedBlockConfig(Dimension dimension, int *partitionArgs, int paddings[2], 
+			int ppuCount, int lpsAlignment, PartitionWeights *weights);
+	
+	int getPartsCount(Dimension parentDimension);
+	int getPartIdOfIndex(GlobalIndex index);
 	Dimension getPartDimension(int partId, Dimension parentDimension);
 	PartitionInstr *getPartitionInstr();
 	bool isDegenerativeCase() { return partitionArgs[0] == 1; }
@@ -257,8 +298,9 @@ class StrideConfig : public DimPartitionConfig {
 			: DimPartitionConfig(dimension, NULL, ppuCount, lpsAlignment) {}
 	
 	int getPartsCount(Dimension parentDimension);
+	int getPartIdOfIndex(GlobalIndex index);
 	Dimension getPartDimension(int partId, Dimension parentDimension);
-	int getOriginalIndex(int partIndex, int position, List<int> *partIdList, 
+	GlobalIndex getOriginalIndex(GlobalIndex partIndex, int position, List<int> *partIdList, 
 			List<int> *partCountList, 
 			List<Dimension*> *partDimensionList);
 	bool hasReorderedIndices(int position) { return true; }
@@ -281,8 +323,9 @@ class BlockStrideConfig : public DimPartitionConfig {
 			partitionArgs, ppuCount, lpsAlignment) {}
 	
 	int getPartsCount(Dimension parentDimension);
+	int getPartIdOfIndex(GlobalIndex index);
 	Dimension getPartDimension(int partId, Dimension parentDimension);
-	int getOriginalIndex(int partIndex, int position, List<int> *partIdList, 
+	GlobalIndex getOriginalIndex(GlobalIndex partIndex, int position, List<int> *partIdList, 
 			List<int> *partCountList, 
 			List<Dimension*> *partDimensionList);
 	bool hasReorderedIndices(int position) { return true; }
@@ -326,6 +369,7 @@ class DataPartitionConfig {
 	~DataPartitionConfig();
 	void setParent(DataPartitionConfig *parent, int parentJump);
 	DimPartitionConfig *getDimensionConfig(int dimNo) { return dimensionConfigs->Nth(dimNo); }
+	int getDimensionCount() { return dimensionCount; }
 	void configureDimensionOrder();
 	std::vector<DimConfig> *getDimensionOrder();
 	void setLpsId(int lpsId) { this->lpsId = lpsId; }
@@ -2,6 +2,7 @@
 #include "part_tracking.h"
 #include "part_generation.h"
 #include "allocation.h"
+#include "soa_layout.h"
 #include "../reduction/reduction_barrier.h"
 #include "../reduction/reduction_result_tracking.h"
 
@@ -12,6 +13,7 @@
 
 #include <cstdlib>
 #include <sstream>
+#include <set>
 
 //--------------------------------------------------------------- Data Items ---------------------------------------------------------------/
 
@@ -187,4 +189,33 @@ bool TaskData::hasDataForLps(const char *lpsId) {
 	return lpsContent->hasValidDataItems();
 }
 
+void TaskData::switchToSoaLayout(const char *varName, SoaLayout *layout) {
+	switchLayout(varName, layout, true);
+}
+
+void TaskData::switchToAosLayout(const char *varName, SoaLayout *layout) {
+	switchLayout(varName, layout, false);
+}
 
+void TaskData::switchLayout(const char *varName, SoaLayout *layout, bool toSoa) {
+	
+	std::set<void*> rearrangedAllocations;
+	Iterator<LpsContent*> iterator = lpsContentMap->GetIterator();
+	LpsContent *lpsContent = NULL;
+	while ((lpsContent = iterator.GetNextValue()) != NULL) {
+		DataItems *dataItems = lpsContent->getDataItems(varName);
+		if (dataItems == NULL || dataItems->isEmpty()) continue;
+		List<DataPart*> *partList = dataItems->getAllDataParts();
+		for (int i = 0; i < partList->NumElements(); i++) {
+			DataPart *part = partList->Nth(i);
+			long int elementCount = part->getMetadata()->getSize();
+			for (int epoch = 0; epoch < part->getEpochCount(); epoch++) {
+				void *data = part->getData(epoch);
+				if (rearrangedAllocations.find(data) != rearrangedAllocations.end()) continue;
+				rearrangedAllocations.insert(data);
+				if (toSoa) layout->convertToSoa((char *) data, elementCount);
+				else layout->convertToAos((char *) data, elementCount);
+			}
+		}
+	}
+}
@@ -11,6 +11,7 @@
 */
 
 #include "allocation.h"
+#include "soa_layout.h"
 #include "part_tracking.h"
 #include "part_generation.h"
 #include "../reduction/reduction_barrier.h"
@@ -102,6 +103,14 @@ class TaskData {
 	// This tells if the current segment contains data to be used in computations of a particular LPS.
 	// If there is no data then there is no thread in the segment that does computation for that LPS.
 	bool hasDataForLps(const char *lpsId);
+
+	// These two functions rearrange all versions of all data parts of an array of a user defined class
+	// in all LPSes to and from the structure-of-arrays layout. A memory allocation shared by multiple data 
+	// parts is rearranged only once.
+	void switchToSoaLayout(const char *varName, SoaLayout *layout);
+	void switchToAosLayout(const char *varName, SoaLayout *layout);
+  protected:
+	void switchLayout(const char *varName, SoaLayout *layout, bool toSoa);
 };
 
 #endif
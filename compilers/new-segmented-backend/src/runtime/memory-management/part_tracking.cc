@@ -253,7 +253,7 @@ int PartContainer::transferData(vector<XformedIndexInfo*> *xformVector,
 			logFile << "Dimension: " << dimNo << " Part No: " << partNo << "\n";
 		}
 
-		vector<int> partIndex;
+		vector<GlobalIndex> partIndex;
 		partIndex.reserve(dataDimensions);
 		for (int i = 0; i < dataDimensions; i++) {
 			partIndex.push_back(xformVector->at(i)->index);
@@ -281,7 +281,7 @@ int PartContainer::transferData(vector<XformedIndexInfo*> *xformVector,
 				logFile << "Dimension: " << dimNo << " Padded Part No: " << partNo << "\n"; 
 			}
 
-			vector<int> partIndex;
+			vector<GlobalIndex> partIndex;
 			partIndex.reserve(dataDimensions);
 			for (int i = 0; i < dataDimensions; i++) {
 				partIndex.push_back(xformVector->at(i)->index);
@@ -541,6 +541,15 @@ PartIterator::PartIterator(int partIdSteps) {
 	this->stats = IteratorStatistics();
 }
 
+PartIterator::~PartIterator() {
+	if (partIdTemplate != NULL) {
+		for (int i = 0; i < partIdTemplate->NumElements(); i++) {
+			delete[] partIdTemplate->Nth(i);
+		}
+		delete partIdTemplate;
+	}
+}
+
 SuperPart *PartIterator::getCurrentPart() {
 	if (containerStack.size() < partIdSteps) return NULL;
 	PartContainer *container = (PartContainer*) containerStack[partIdSteps - 1];
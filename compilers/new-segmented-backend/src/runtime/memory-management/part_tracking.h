@@ -203,6 +203,7 @@ class PartIterator {
 	IteratorStatistics stats;
   public:
 	PartIterator(int partIdSteps);
+	~PartIterator();
 	SuperPart *getCurrentPart();
 	void replaceCurrentPart(SuperPart *replacement);
 	void initiate(PartIdContainer *topContainer);
@@ -0,0 +1,66 @@
+#include "soa_layout.h"
+
+#include "../../../../common-libs/utils/utility.h"
+
+#include <cstdlib>
+#include <cstring>
+
+SoaLayout::SoaLayout(int elementSize, int fieldCount) {
+	this->elementSize = elementSize;
+	this->fieldCount = fieldCount;
+	this->aosOffsets = new int[fieldCount];
+	this->fieldSizes = new int[fieldCount];
+	this->soaOffsets = new int[fieldCount];
+	Assert(aosOffsets != NULL && fieldSizes != NULL && soaOffsets != NULL);
+}
+
+SoaLayout::~SoaLayout() {
+	delete[] aosOffsets;
+	delete[] fieldSizes;
+	delete[] soaOffsets;
+}
+
+void SoaLayout::setField(int fieldNo, int aosOffset, int fieldSize, int soaOffset) {
+	Assert(fieldNo >= 0 && fieldNo < fieldCount);
+	aosOffsets[fieldNo] = aosOffset;
+	fieldSizes[fieldNo] = fieldSize;
+	soaOffsets[fieldNo] = soaOffset;
+}
+
+void SoaLayout::convertToSoa(char *data, long int elementCount) {
+
+	long int allocationSize = elementCount * elementSize;
+	char *scratch = (char *) malloc(sizeof(char) * allocationSize);
+	Assert(scratch != NULL);
+	memset(scratch, 0, allocationSize);
+
+	for (int f = 0; f < fieldCount; f++) {
+		int fieldSize = fieldSizes[f];
+		char *source = data + aosOffsets[f];
+		char *destination = scratch + elementCount * soaOffsets[f];
+		for (long int i = 0; i < elementCount; i++) {
+			memcpy(destination + i * fieldSize, source + i * elementSize, fieldSize);
+		}
+	}
+	memcpy(data, scratch, allocationSize);
+	free(scratch);
+}
+
+void SoaLayout::convertToAos(char *data, long int elementCount) {
+
+	long int allocationSize = elementCount * elementSize;
+	char *scratch = (char *) malloc(sizeof(char) * allocationSize);
+	Assert(scratch != NULL);
+	memset(scratch, 0, allocationSize);
+
+	for (int f = 0; f < fieldCount; f++) {
+		int fieldSize = fieldSizes[f];
+		char *source = data + elementCount * soaOffsets[f];
+		char *destination = scratch + aosOffsets[f];
+		for (long int i = 0; i < elementCount; i++) {
+			memcpy(destination + i * elementSize, source + i * fieldSize, fieldSize);
+		}
+	}
+	memcpy(data, scratch, allocationSize);
+	free(scratch);
+}
@@ -0,0 +1,42 @@
+#ifndef _H_soa_layout
+#define _H_soa_layout
+
+/* By default, the data parts of an array of a user defined class hold C++ objects of the class one after another,
+   i.e., they have an array-of-structures (AoS) layout. A compute stage that accesses only one field of the elements
+   then drags all other fields of the objects through the cache and the compiler cannot vectorize the loop over the
+   elements. When a class is opted-in for the structure-of-arrays (SoA) layout, the compiler translates the accesses
+   to the elements of its arrays inside compute stages into accesses to per-field sub-arrays of the data parts. The
+   sub-array of a field starts at the part length times the sum of the sizes of the fields that precede it in the
+   SoA order. So the part allocation stays the same in size and only the arrangement of the bytes differs.
+
+   The file I/O, environment management, and communication modules all assume that elements are stored one after
+   another. So the parts of an array are switched to the SoA layout just before the computation of a task starts
+   and switched back to the AoS layout once it is done. The class in this header does those switches.
+*/
+
+class SoaLayout {
+  protected:
+	// size of the C++ object of the class an array element is an instance of
+	int elementSize;
+	// the number of fields of the class
+	int fieldCount;
+	// the byte offset of each field within a C++ object
+	int *aosOffsets;
+	// the size of each field
+	int *fieldSizes;
+	// the sum of the sizes of the fields that precede each field in the SoA order; the sub-array of a field in
+	// a part starts at the part length times this offset
+	int *soaOffsets;
+  public:
+	SoaLayout(int elementSize, int fieldCount);
+	~SoaLayout();
+	void setField(int fieldNo, int aosOffset, int fieldSize, int soaOffset);
+	inline int getElementSize() { return elementSize; }
+
+	// rearrange the elements of an allocation unit having the argument number of elements from the AoS to the
+	// SoA layout and vice versa
+	void convertToSoa(char *data, long int elementCount);
+	void convertToAos(char *data, long int elementCount);
+};
+
+#endif
@@ -2,28 +2,28 @@
 
 #include "../../../../common-libs/domain-obj/structure.h"
 
-bool block_count_isIndexIncluded(int originalIndex,
+bool block_count_isIndexIncluded(GlobalIndex originalIndex,
                 int lpuId, int lpuCount, Dimension d, int count) {
-        int size = d.getLength() / lpuCount;
+        GlobalIndex size = d.getLength() / lpuCount;
         return (originalIndex >= size * lpuId && originalIndex < size * (lpuId + 1));
 }
 
-int block_stride_transformIndex(int originalIndex,
-                int lpuId, int lpuCount, Dimension d, int size) {
-        int strideNo = originalIndex / (lpuCount * size);
-        int strideIndex = originalIndex % (lpuCount * size) - lpuId * size;
+GlobalIndex block_stride_transformIndex(GlobalIndex originalIndex,
+                int lpuId, int lpuCount, Dimension d, GlobalIndex size) {
+        GlobalIndex strideNo = originalIndex / (lpuCount * size);
+        GlobalIndex strideIndex = originalIndex % (lpuCount * size) - lpuId * size;
         return strideNo * size + strideIndex;
 }
 
-int block_stride_revertIndex(int transformedIndex,
-                int lpuId, int lpuCount, Dimension d, int size) {
-        int strideNo = transformedIndex / size;
-        int strideIndex = transformedIndex % size;
+GlobalIndex block_stride_revertIndex(GlobalIndex transformedIndex,
+                int lpuId, int lpuCount, Dimension d, GlobalIndex size) {
+        GlobalIndex strideNo = transformedIndex / size;
+        GlobalIndex strideIndex = transformedIndex % size;
         return strideNo * (size * lpuCount) + lpuId * size + strideIndex;
 }
 
-bool block_stride_isIndexIncluded(int originalIndex,
-                int lpuId, int lpuCount, Dimension d, int size) {
-        int strideIndex = originalIndex % (size * lpuCount);
+bool block_stride_isIndexIncluded(GlobalIndex originalIndex,
+                int lpuId, int lpuCount, Dimension d, GlobalIndex size) {
+        GlobalIndex strideIndex = originalIndex % (size * lpuCount);
         return (strideIndex / size == lpuId);
 }
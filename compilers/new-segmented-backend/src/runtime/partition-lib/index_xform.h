@@ -26,8 +26,8 @@
 
 inline int block_size_xformationNeeded() { return false; }
 
-inline bool block_size_isIndexIncluded(int originalIndex, 
-		int lpuId, int lpuCount, Dimension d, int size) {
+inline bool block_size_isIndexIncluded(GlobalIndex originalIndex, 
+		int lpuId, int lpuCount, Dimension d, GlobalIndex size) {
 	return originalIndex / size == lpuId;
 }
 
@@ -35,35 +35,35 @@ inline bool block_size_isIndexIncluded(int originalIndex,
 
 inline int block_count_xformationNeeded() { return false; }
 
-bool block_count_isIndexIncluded(int originalIndex, 
+bool block_count_isIndexIncluded(GlobalIndex originalIndex, 
 		int lpuId, int lpuCount, Dimension d, int count);
 
 /************************************ definitions for block_stride partition function */
 
 inline int block_stride_xformationNeeded() { return true; }
 
-int block_stride_transformIndex(int originalIndex, 
-		int lpuId, int lpuCount, Dimension d, int size);
+GlobalIndex block_stride_transformIndex(GlobalIndex originalIndex, 
+		int lpuId, int lpuCount, Dimension d, GlobalIndex size);
 
-int block_stride_revertIndex(int transformedIndex, 
-		int lpuId, int lpuCount, Dimension d, int size);
+GlobalIndex block_stride_revertIndex(GlobalIndex transformedIndex, 
+		int lpuId, int lpuCount, Dimension d, GlobalIndex size);
 
-bool block_stride_isIndexIncluded(int originalIndex, 
-		int lpuId, int lpuCount, Dimension d, int size);
+bool block_stride_isIndexIncluded(GlobalIndex originalIndex, 
+		int lpuId, int lpuCount, Dimension d, GlobalIndex size);
 
 /****************************************** definitions for stride partition function */
 
 inline int stride_xformationNeeded() { return true; }
 
-inline int stride_transformIndex(int originalIndex, int strideId, Dimension d) {
+inline GlobalIndex stride_transformIndex(GlobalIndex originalIndex, int strideId, Dimension d) {
         return originalIndex * strideId;
 }
 
-inline int stride_revertIndex(int stridedIndex, int strideId, Dimension d) {
+inline GlobalIndex stride_revertIndex(GlobalIndex stridedIndex, int strideId, Dimension d) {
         return stridedIndex / strideId;
 }
 
-inline bool stride_isIndexIncluded(int originalIndex, int strideId, Dimension d) {
+inline bool stride_isIndexIncluded(GlobalIndex originalIndex, int strideId, Dimension d) {
         return (originalIndex % strideId == 0);
 }
 
@@ -111,9 +111,9 @@ int VoidInstr::calculatePartsCount(Dimension dimension, bool updateProperties) {
 
 List<IntervalSeq*> *VoidInstr::getIntervalDesc() {
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
-	int begin = parentDim.range.min;
-	int length = parentDim.length;
-	int period = length;
+	GlobalIndex begin = parentDim.range.min;
+	GlobalIndex length = parentDim.length;
+	GlobalIndex period = length;
 	int count = 1;
 	IntervalSeq *interval = new IntervalSeq(begin, length, period, count);
 	list->Append(interval);
@@ -137,14 +137,14 @@ XformedIndexInfo *VoidInstr::transformIndex(XformedIndexInfo *indexToXform) {
 
 //------------------------------------------------------ Block Size ------------------------------------------------------
 
-BlockSizeInstr::BlockSizeInstr(int size) : PartitionInstr("Block-Size", false) {
+BlockSizeInstr::BlockSizeInstr(GlobalIndex size) : PartitionInstr("Block-Size", false) {
 	this->size = size;
 	frontPadding = 0;
 	rearPadding = 0;
 }
 
-BlockSizeInstr::BlockSizeInstr(Dimension pd, int id, int size) : PartitionInstr("Block-Size", pd, id, 0, false) {
-	int dimLength = pd.length;
+BlockSizeInstr::BlockSizeInstr(Dimension pd, int id, GlobalIndex size) : PartitionInstr("Block-Size", pd, id, 0, false) {
+	GlobalIndex dimLength = pd.length;
 	this->partsCount = (dimLength + size - 1) / size;
 	this->size = size;
 	frontPadding = 0;
@@ -164,16 +164,16 @@ Dimension BlockSizeInstr::getDimension(bool includePadding) {
 }
 
 Dimension BlockSizeInstr::getDimension(Dimension parentDim, int partId, int partsCount, bool includePadding) {
-	int begin = parentDim.range.min + partId * size;
-	int remaining = parentDim.range.max - begin + 1;
-	int intervalLength = (remaining >= size) ? size : remaining;
+	GlobalIndex begin = parentDim.range.min + partId * size;
+	GlobalIndex remaining = parentDim.range.max - begin + 1;
+	GlobalIndex intervalLength = (remaining >= size) ? size : remaining;
 	Dimension partDimension;
 	if (includePadding) {
 		partDimension.range.min = max(begin - frontPadding, parentDim.range.min);
 	} else {
 		partDimension.range.min = begin;
 	}
-	int end = begin + intervalLength - 1;
+	GlobalIndex end = begin + intervalLength - 1;
 	if (includePadding) {
 		partDimension.range.max = min(end + rearPadding, parentDim.range.max);
 	} else {
@@ -186,9 +186,9 @@ Dimension BlockSizeInstr::getDimension(Dimension parentDim, int partId, int part
 List<IntervalSeq*> *BlockSizeInstr::getIntervalDesc() {
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
 	Dimension partDim = getDimension();
-	int begin = partDim.range.min;
-	int length = partDim.length;
-	int period = length;
+	GlobalIndex begin = partDim.range.min;
+	GlobalIndex length = partDim.length;
+	GlobalIndex period = length;
 	int count = 1;
 	IntervalSeq *interval = new IntervalSeq(begin, length, period, count);
 	list->Append(interval);
@@ -222,10 +222,10 @@ List<IntervalSeq*> *BlockSizeInstr::getIntervalDescForRange(Range idRange) {
 }
 
 IntervalSeq *BlockSizeInstr::getPaddinglessIntervalForRange(Range idRange) {
-	int begin = parentDim.range.min + idRange.min * size;
-	int supposedLength = (idRange.max - idRange.min + 1) * size;
-	int remaining = parentDim.range.max - begin + 1;
-	int intervalLength = (remaining >= supposedLength) ? supposedLength : remaining;
+	GlobalIndex begin = parentDim.range.min + idRange.min * size;
+	GlobalIndex supposedLength = (idRange.max - idRange.min + 1) * size;
+	GlobalIndex remaining = parentDim.range.max - begin + 1;
+	GlobalIndex intervalLength = (remaining >= supposedLength) ? supposedLength : remaining;
 	return new IntervalSeq(begin, intervalLength, intervalLength, 1);
 }
 
@@ -265,7 +265,7 @@ void BlockSizeInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, Li
 			int iterationCount = idRange.max - idRange.min + 1;
 			int partId = this->partId;
 			this->partId = idRange.min;
-			int period = getDimension(false).length;
+			GlobalIndex period = getDimension(false).length;
 			for (int i = 0; i < descInConstruct->NumElements(); i++) {
 				IntervalSeq *subInterval = descInConstruct->Nth(i);
 				// updating the existing sub-interval to iterate multiple times
@@ -276,7 +276,7 @@ void BlockSizeInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, Li
 				// generating new smaller intervals for each iteration of the sub-interval
 				} else {
 					for (int j = 0; j < subInterval->count; j++) {
-						int newBegin = subInterval->begin + subInterval->period * j;
+						GlobalIndex newBegin = subInterval->begin + subInterval->period * j;
 						IntervalSeq *newInterval = new IntervalSeq(newBegin, subInterval->length, period, iterationCount);
 						updatedList->Append(newInterval);
 					}
@@ -298,7 +298,7 @@ void BlockSizeInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, Li
 XformedIndexInfo *BlockSizeInstr::transformIndex(XformedIndexInfo *indexToXform) {
 
 	Dimension dimension = indexToXform->partDimension;
-	int index = indexToXform->index;
+	GlobalIndex index = indexToXform->index;
 	int count = calculatePartsCount(dimension, false);
 
 	bool includePadding = hasPadding && !excludePaddingInIntervalCalculation;
@@ -315,8 +315,8 @@ XformedIndexInfo *BlockSizeInstr::transformIndex(XformedIndexInfo *indexToXform)
 	// boggle your mind.
 	if (includePadding) {
 		Dimension paddinglessDim = getDimension(dimension, partNo, count, false);
-		int indexForwardDrift = index - paddinglessDim.range.min;
-		int indexBackwardDrift = paddinglessDim.range.max - index;
+		GlobalIndex indexForwardDrift = index - paddinglessDim.range.min;
+		GlobalIndex indexBackwardDrift = paddinglessDim.range.max - index;
 
 		// the first condition checks if the index originially belongs to the current part
 		// the second condition checks if the index is included in the padding region of a neigbor
@@ -344,8 +344,8 @@ BlockCountInstr::BlockCountInstr(int count) : PartitionInstr("Block-Count", fals
 }
 
 BlockCountInstr::BlockCountInstr(Dimension pd, int id, int count) : PartitionInstr("Block-Count", pd, id, 0, false) {
-	int length = pd.length;
-	this->partsCount = max(1, min(count, length));
+	GlobalIndex length = pd.length;
+	this->partsCount = max(1, (int) min((GlobalIndex) count, length));
 	this->count = count;
 	frontPadding = 0;
 	rearPadding = 0;
@@ -364,16 +364,16 @@ Dimension BlockCountInstr::getDimension(bool includePadding) {
 }
 
 Dimension BlockCountInstr::getDimension(Dimension parentDim, int partId, int partsCount, bool includePadding) {
-	int size = parentDim.length / partsCount;
-	int begin = parentDim.range.min + partId * size;
-	int length = (partId < partsCount - 1) ? size : parentDim.range.max - begin + 1;
+	GlobalIndex size = parentDim.length / partsCount;
+	GlobalIndex begin = parentDim.range.min + partId * size;
+	GlobalIndex length = (partId < partsCount - 1) ? size : parentDim.range.max - begin + 1;
 	Dimension partDimension;
 	if (includePadding) {
 		partDimension.range.min = max(begin - frontPadding, parentDim.range.min);
 	} else {
 		partDimension.range.min = begin;
 	}
-	int end = begin + length - 1;
+	GlobalIndex end = begin + length - 1;
 	if (includePadding) {
 		partDimension.range.max = min(end + rearPadding, parentDim.range.max);
 	} else {
@@ -386,9 +386,9 @@ Dimension BlockCountInstr::getDimension(Dimension parentDim, int partId, int par
 List<IntervalSeq*> *BlockCountInstr::getIntervalDesc() {
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
 	Dimension partDim = getDimension();
-	int begin = partDim.range.min;
-	int length = partDim.length;
-	int period = length;
+	GlobalIndex begin = partDim.range.min;
+	GlobalIndex length = partDim.length;
+	GlobalIndex period = length;
 	int count = 1;
 	IntervalSeq *interval = new IntervalSeq(begin, length, period, count);
 	list->Append(interval);
@@ -396,7 +396,7 @@ List<IntervalSeq*> *BlockCountInstr::getIntervalDesc() {
 }
 
 int BlockCountInstr::calculatePartsCount(Dimension dimension, bool updateProperties) {
-	int count = max(1, min(this->count, dimension.length));
+	int count = max(1, (int) min((GlobalIndex) this->count, dimension.length));
 	if (updateProperties) {
 		this->parentDim = dimension;
 		this->partsCount = count;
@@ -422,9 +422,9 @@ List<IntervalSeq*> *BlockCountInstr::getIntervalDescForRange(Range idRange) {
 }
 
 IntervalSeq *BlockCountInstr::getPaddinglessIntervalForRange(Range idRange) {
-	int size = parentDim.length / count;
-	int begin = parentDim.range.min + idRange.min * size;
-	int length = (idRange.max < count - 1)
+	GlobalIndex size = parentDim.length / count;
+	GlobalIndex begin = parentDim.range.min + idRange.min * size;
+	GlobalIndex length = (idRange.max < count - 1)
 			? size * (idRange.max - idRange.min + 1) : parentDim.range.max - begin + 1;
 	return new IntervalSeq(begin, length, length, 1);
 }
@@ -465,7 +465,7 @@ void BlockCountInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, L
 			int iterationCount = idRange.max - idRange.min + 1;
 			int partId = this->partId;
 			this->partId = idRange.min;
-			int period = getDimension(false).length;
+			GlobalIndex period = getDimension(false).length;
 			this->partId = partId;
 			for (int i = 0; i < descInConstruct->NumElements(); i++) {
 				IntervalSeq *subInterval = descInConstruct->Nth(i);
@@ -477,7 +477,7 @@ void BlockCountInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, L
 					// generating new smaller intervals for each iteration of the sub-interval
 				} else {
 					for (int j = 0; j < subInterval->count; j++) {
-						int newBegin = subInterval->begin + subInterval->period * j;
+						GlobalIndex newBegin = subInterval->begin + subInterval->period * j;
 						IntervalSeq *newInterval = new IntervalSeq(newBegin, subInterval->length, period, iterationCount);
 						updatedList->Append(newInterval);
 					}
@@ -498,12 +498,10 @@ void BlockCountInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, L
 XformedIndexInfo *BlockCountInstr::transformIndex(XformedIndexInfo *indexToXform) {
 
 	Dimension dimension = indexToXform->partDimension;
-	int index = indexToXform->index;
+	GlobalIndex index = indexToXform->index;
 	int count = calculatePartsCount(dimension, false);
 
-	int partSize = dimension.length / count;
-	int partNo = (index - dimension.range.min) / partSize;
-	if (partNo >= count) partNo = count - 1;
+	int partNo = getPartNoOfIndex(dimension, count, index);
 
 	bool includePadding = hasPadding && !excludePaddingInIntervalCalculation;
 	Dimension newDimension = getDimension(dimension, partNo, count, hasPadding);
@@ -518,8 +516,8 @@ XformedIndexInfo *BlockCountInstr::transformIndex(XformedIndexInfo *indexToXform
 	// boggle your mind.
 	if (includePadding) {
 		Dimension paddinglessDim = getDimension(dimension, partNo, count, false);
-		int indexForwardDrift = index - paddinglessDim.range.min;
-		int indexBackwardDrift = paddinglessDim.range.max - index;
+		GlobalIndex indexForwardDrift = index - paddinglessDim.range.min;
+		GlobalIndex indexBackwardDrift = paddinglessDim.range.max - index;
 
 		// the first condition checks if the index originially belongs to the current part
 		// the second condition checks if the index is included in the padding region of a neigbor
@@ -538,6 +536,65 @@ XformedIndexInfo *BlockCountInstr::transformIndex(XformedIndexInfo *indexToXform
 	return NULL;
 }
 
+int BlockCountInstr::getPartNoOfIndex(Dimension dimension, int partsCount, GlobalIndex index) {
+	GlobalIndex partSize = dimension.length / partsCount;
+	int partNo = (index - dimension.range.min) / partSize;
+	if (partNo >= partsCount) partNo = partsCount - 1;
+	return partNo;
+}
+
+//---------------------------------------------------- Weighted Block ----------------------------------------------------
+
+WeightedBlockInstr::WeightedBlockInstr(int count, PartitionWeights *weights, GlobalIndex origin) : BlockCountInstr(count) {
+	this->name = "Weighted-Block";
+	this->weights = weights;
+	this->origin = origin;
+	this->cutsRange = Range();
+	this->cutsCount = 0;
+}
+
+const vector<GlobalIndex> &WeightedBlockInstr::getCuts(Dimension dimension, int partsCount) {
+	if (cutsCount != partsCount || cutsRange.min != dimension.range.min || cutsRange.max != dimension.range.max) {
+		if (weights == NULL) {
+			PartitionWeights::getUniformCuts(dimension.range, partsCount, cuts);
+		} else {
+			weights->getCuts(dimension.range, origin, partsCount, cuts);
+		}
+		cutsRange = dimension.range;
+		cutsCount = partsCount;
+	}
+	return cuts;
+}
+
+int WeightedBlockInstr::getPartNoOfIndex(Dimension dimension, int partsCount, GlobalIndex index) {
+	const vector<GlobalIndex> &partCuts = getCuts(dimension, partsCount);
+	int partNo = upper_bound(partCuts.begin(), partCuts.end(), index) - partCuts.begin() - 1;
+	return max(0, min(partNo, partsCount - 1));
+}
+
+Dimension WeightedBlockInstr::getDimension(Dimension parentDim, int partId, int partsCount, bool includePadding) {
+	const vector<GlobalIndex> &partCuts = getCuts(parentDim, partsCount);
+	GlobalIndex begin = partCuts[partId];
+	GlobalIndex end = partCuts[partId + 1] - 1;
+	Dimension partDimension;
+	if (includePadding) {
+		partDimension.range.min = max(begin - frontPadding, parentDim.range.min);
+		partDimension.range.max = min(end + rearPadding, parentDim.range.max);
+	} else {
+		partDimension.range.min = begin;
+		partDimension.range.max = end;
+	}
+	partDimension.setLength();
+	return partDimension;
+}
+
+IntervalSeq *WeightedBlockInstr::getPaddinglessIntervalForRange(Range idRange) {
+	const vector<GlobalIndex> &partCuts = getCuts(parentDim, partsCount);
+	GlobalIndex begin = partCuts[idRange.min];
+	GlobalIndex length = partCuts[idRange.max + 1] - begin;
+	return new IntervalSeq(begin, length, length, 1);
+}
+
 //-------------------------------------------------------- Stride --------------------------------------------------------
 
 StrideInstr::StrideInstr(int ppuCount) : PartitionInstr("Stride", true) {
@@ -545,8 +602,8 @@ StrideInstr::StrideInstr(int ppuCount) : PartitionInstr("Stride", true) {
 }
 
 StrideInstr::StrideInstr(Dimension pd, int id, int ppuCount) : PartitionInstr("Stride", pd, id, 0, true) {
-	int length = pd.length;
-	this->partsCount = max(1, min(ppuCount, length));
+	GlobalIndex length = pd.length;
+	this->partsCount = max(1, (int) min((GlobalIndex) ppuCount, length));
 	this->ppuCount = ppuCount;
 }
 
@@ -555,10 +612,10 @@ Dimension StrideInstr::getDimension(bool includePadding) {
 }
 
 Dimension StrideInstr::getDimension(Dimension parentDimension, int partId, int partsCount, bool includePadding) {
-	int length = parentDimension.length;
-	int perStrideEntries = length / partsCount;
-	int myEntries = perStrideEntries;
-	int remainder = length % partsCount;
+	GlobalIndex length = parentDimension.length;
+	GlobalIndex perStrideEntries = length / partsCount;
+	GlobalIndex myEntries = perStrideEntries;
+	GlobalIndex remainder = length % partsCount;
 	if (remainder > partId) {
 		myEntries++;
 	}
@@ -571,11 +628,11 @@ Dimension StrideInstr::getDimension(Dimension parentDimension, int partId, int p
 
 List<IntervalSeq*> *StrideInstr::getIntervalDesc() {
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
-	int length = parentDim.length;
-	int strides = length / partsCount;
-	int remaining = length % partsCount;
+	GlobalIndex length = parentDim.length;
+	GlobalIndex strides = length / partsCount;
+	GlobalIndex remaining = length % partsCount;
 	if (remaining > partId) strides++;
-	int begin = parentDim.range.min + partId;
+	GlobalIndex begin = parentDim.range.min + partId;
 	IntervalSeq *interval = new IntervalSeq(begin, 1, partsCount, strides);
 	list->Append(interval);
 	return list;
@@ -603,7 +660,7 @@ void StrideInstr::getIntervalDesc(List<IntervalSeq*> *descInConstruct) {
 }
 
 int StrideInstr::calculatePartsCount(Dimension dimension, bool updateProperties) {
-	int count = max(1, min(ppuCount, dimension.length));
+	int count = max(1, (int) min((GlobalIndex) ppuCount, dimension.length));
 	if (updateProperties) {
 		this->parentDim = dimension;
 		this->partsCount = count;
@@ -616,26 +673,26 @@ List<IntervalSeq*> *StrideInstr::getIntervalDescForRange(Range idRange) {
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
 
 	if (partsCount == idRange.max - idRange.min + 1) {
-		int begin = parentDim.range.min;
-		int length = parentDim.length;
-		int period = length;
+		GlobalIndex begin = parentDim.range.min;
+		GlobalIndex length = parentDim.length;
+		GlobalIndex period = length;
 		IntervalSeq *interval = new IntervalSeq(begin, length, period, 1);
 		list->Append(interval);
 	} else {
-		int strides = parentDim.length / partsCount;
-		int remaining = parentDim.length % partsCount;
-		int spillOverEntries = 0;
+		GlobalIndex strides = parentDim.length / partsCount;
+		GlobalIndex remaining = parentDim.length % partsCount;
+		GlobalIndex spillOverEntries = 0;
 		if (remaining > idRange.max) strides++;
-		else if (remaining > 0) spillOverEntries = max(0, remaining - idRange.min);
+		else if (remaining > 0) spillOverEntries = max((GlobalIndex) 0, remaining - idRange.min);
 
-		int begin = parentDim.range.min + idRange.min;
-		int length = idRange.max - idRange.min + 1;
+		GlobalIndex begin = parentDim.range.min + idRange.min;
+		GlobalIndex length = idRange.max - idRange.min + 1;
 		IntervalSeq *mainInterval = new IntervalSeq(begin, length, partsCount, strides);
 		list->Append(mainInterval);
 
 		if (spillOverEntries > 0) {
-			int spillBegin = begin + partsCount * strides;
-			int spillLength = spillOverEntries;
+			GlobalIndex spillBegin = begin + partsCount * strides;
+			GlobalIndex spillLength = spillOverEntries;
 			IntervalSeq *spillInterval = new IntervalSeq(spillBegin, spillLength, spillLength, 1);
 			list->Append(spillInterval);
 		}
@@ -681,11 +738,11 @@ void StrideInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList, List<
 XformedIndexInfo *StrideInstr::transformIndex(XformedIndexInfo *indexToXform) {
 
 	Dimension dimension = indexToXform->partDimension;
-	int index = indexToXform->index;
+	GlobalIndex index = indexToXform->index;
 	int count = calculatePartsCount(dimension, false);
 
-	int zeroBasedIndex = index - dimension.range.min;
-	int xformedIndex = zeroBasedIndex / count;
+	GlobalIndex zeroBasedIndex = index - dimension.range.min;
+	GlobalIndex xformedIndex = zeroBasedIndex / count;
 	int partNo = zeroBasedIndex % count;
 	Dimension newDimension = getDimension(dimension, partNo, count, false);
 
@@ -698,18 +755,18 @@ XformedIndexInfo *StrideInstr::transformIndex(XformedIndexInfo *indexToXform) {
 
 //----------------------------------------------------- Block Stride -----------------------------------------------------
 
-BlockStrideInstr::BlockStrideInstr(int ppuCount, int size) : PartitionInstr("Block-Stride", true) {
+BlockStrideInstr::BlockStrideInstr(int ppuCount, GlobalIndex size) : PartitionInstr("Block-Stride", true) {
 	this->size = size;
 	this->ppuCount = ppuCount;
 }
 
 BlockStrideInstr::BlockStrideInstr(Dimension pd, int id,
-		int ppuCount, int size) : PartitionInstr("Block-Stride", pd, id, 0, true) {
+		int ppuCount, GlobalIndex size) : PartitionInstr("Block-Stride", pd, id, 0, true) {
 	this->size = size;
 	this->ppuCount = ppuCount;
-	int length = pd.length;
-	int strides = length / size;
-	partsCount = max(1, min(strides, ppuCount));
+	GlobalIndex length = pd.length;
+	GlobalIndex strides = length / size;
+	partsCount = max(1, (int) min(strides, (GlobalIndex) ppuCount));
 }
 
 Dimension BlockStrideInstr::getDimension(bool includePadding) {
@@ -717,13 +774,13 @@ Dimension BlockStrideInstr::getDimension(bool includePadding) {
 }
 
 Dimension BlockStrideInstr::getDimension(Dimension parentDim, int partId, int partsCount, bool includePadding) {
-	int strideLength = size * partsCount;
-	int strideCount = parentDim.length / strideLength;
-	int myEntries = strideCount * size;
+	GlobalIndex strideLength = size * partsCount;
+	GlobalIndex strideCount = parentDim.length / strideLength;
+	GlobalIndex myEntries = strideCount * size;
 
-	int partialStrideElements = parentDim.length % strideLength;
+	GlobalIndex partialStrideElements = parentDim.length % strideLength;
 	int blockCount = partialStrideElements / size;
-	int extraEntriesBefore = partialStrideElements;
+	GlobalIndex extraEntriesBefore = partialStrideElements;
 
 	if (blockCount > partId) {
 		myEntries += size;
@@ -743,24 +800,24 @@ Dimension BlockStrideInstr::getDimension(Dimension parentDim, int partId, int pa
 List<IntervalSeq*> *BlockStrideInstr::getIntervalDesc() {
 
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
-	int strideLength = size * partsCount;
-	int strideCount = parentDim.length / strideLength;
+	GlobalIndex strideLength = size * partsCount;
+	GlobalIndex strideCount = parentDim.length / strideLength;
 
-	int partialStrideElements = parentDim.length % strideLength;
+	GlobalIndex partialStrideElements = parentDim.length % strideLength;
 	int extraBlockCount = partialStrideElements / size;
 
 	if (extraBlockCount > partId) strideCount++;
 
-	int begin = parentDim.range.min + size * partId;
-	int length = size;
-	int count = strideCount;
-	int period = strideLength;
+	GlobalIndex begin = parentDim.range.min + size * partId;
+	GlobalIndex length = size;
+	GlobalIndex count = strideCount;
+	GlobalIndex period = strideLength;
 	IntervalSeq *iterativeInterval = new IntervalSeq(begin, length, period, count);
 	list->Append(iterativeInterval);
 
 	if (extraBlockCount == partId && partialStrideElements % size != 0) {
-		int spill = partialStrideElements % size;
-		int spillStarts = parentDim.range.min + strideCount * strideLength + extraBlockCount * size;
+		GlobalIndex spill = partialStrideElements % size;
+		GlobalIndex spillStarts = parentDim.range.min + strideCount * strideLength + extraBlockCount * size;
 		IntervalSeq *spillInterval = new IntervalSeq(spillStarts, spill, spill, 1);
 		list->Append(spillInterval);
 	}
@@ -794,8 +851,8 @@ void BlockStrideInstr::getIntervalDesc(List<IntervalSeq*> *descInConstruct) {
 }
 
 int BlockStrideInstr::calculatePartsCount(Dimension dimension, bool updateProperties) {
-	int strides = dimension.length / size;
-	int count = max(1, min(strides, ppuCount));
+	GlobalIndex strides = dimension.length / size;
+	int count = max(1, (int) min(strides, (GlobalIndex) ppuCount));
 	if (updateProperties) {
 		this->parentDim = dimension;
 		this->partsCount = count;
@@ -808,29 +865,29 @@ List<IntervalSeq*> *BlockStrideInstr::getIntervalDescForRange(Range idRange) {
 	List<IntervalSeq*> *list = new List<IntervalSeq*>;
 
 	if (partsCount == idRange.max - idRange.min + 1) {
-		int begin = parentDim.range.min;
-		int length = parentDim.length;
-		int period = length;
+		GlobalIndex begin = parentDim.range.min;
+		GlobalIndex length = parentDim.length;
+		GlobalIndex period = length;
 		IntervalSeq *interval = new IntervalSeq(begin, length, period, 1);
 		list->Append(interval);
 	} else {
-		int strideLength = size * partsCount;
-		int strideCount = parentDim.length / strideLength;
-		int partialStrideElements = parentDim.length % strideLength;
+		GlobalIndex strideLength = size * partsCount;
+		GlobalIndex strideCount = parentDim.length / strideLength;
+		GlobalIndex partialStrideElements = parentDim.length % strideLength;
 		int extraBlockCount = partialStrideElements / size;
-		int spillOver = 0;
+		GlobalIndex spillOver = 0;
 		if (extraBlockCount > idRange.max) strideCount++;
-		else spillOver = max(0, partialStrideElements - size * idRange.min);
+		else spillOver = max((GlobalIndex) 0, partialStrideElements - size * idRange.min);
 
-		int begin = parentDim.range.min + size * idRange.min;
-		int length = size * (idRange.max - idRange.min + 1);
-		int count = strideCount;
-		int period = strideLength;
+		GlobalIndex begin = parentDim.range.min + size * idRange.min;
+		GlobalIndex length = size * (idRange.max - idRange.min + 1);
+		GlobalIndex count = strideCount;
+		GlobalIndex period = strideLength;
 		IntervalSeq *iterativeInterval = new IntervalSeq(begin, length, period, count);
 		list->Append(iterativeInterval);
 
 		if (spillOver > 0) {
-			int spillStarts = begin + strideCount * strideLength;
+			GlobalIndex spillStarts = begin + strideCount * strideLength;
 			IntervalSeq *spillInterval = new IntervalSeq(spillStarts, spillOver, spillOver, 1);
 			list->Append(spillInterval);
 		}
@@ -879,14 +936,14 @@ void BlockStrideInstr::getIntervalDescForRangeHierarchy(List<Range> *rangeList,
 XformedIndexInfo *BlockStrideInstr::transformIndex(XformedIndexInfo *indexToXform) {
 
 	Dimension dimension = indexToXform->partDimension;
-	int index = indexToXform->index;
+	GlobalIndex index = indexToXform->index;
 	int count = calculatePartsCount(dimension, false);
 
-	int strideLength = size * count;
-	int zeroBasedIndex = index - dimension.range.min;
+	GlobalIndex strideLength = size * count;
+	GlobalIndex zeroBasedIndex = index - dimension.range.min;
 
 	int partNo = (zeroBasedIndex % strideLength) / size;
-	int xformedIndex = (zeroBasedIndex / strideLength) * size + zeroBasedIndex % size;
+	GlobalIndex xformedIndex = (zeroBasedIndex / strideLength) * size + zeroBasedIndex % size;
 	Dimension newDimension = getDimension(dimension, partNo, count, false);
 
 	indexToXform->partDimension = newDimension;
@@ -5,10 +5,12 @@
 #include <sstream>
 #include <cstdlib>
 #include <algorithm>
+#include <vector>
 
 #include "../../../../common-libs/utils/list.h"
 #include "../../../../common-libs/utils/interval.h"
 #include "../../../../common-libs/domain-obj/structure.h"
+#include "partition_weights.h"
 
 /* This is an auxiliary data structure definition to be used during transferring data in between communication buffer
  * and the operating memory data-parts. The data parts are stored as a part-hierarchy (see the part-tracking library)
@@ -19,7 +21,7 @@
  * */
 class XformedIndexInfo {
 public:
-	int index;
+	GlobalIndex index;
 	int partNo;
 	Dimension partDimension;
 public:
@@ -28,7 +30,7 @@ public:
 		this->partNo = 0;
 		this->partDimension = Dimension();
 	}
-	XformedIndexInfo(int index, int partNo, Dimension partDimension) {
+	XformedIndexInfo(GlobalIndex index, int partNo, Dimension partDimension) {
 		this->index = index;
 		this->partNo = partNo;
 		this->partDimension = partDimension;
@@ -130,12 +132,12 @@ public:
 
 class BlockSizeInstr : public PartitionInstr {
 protected:
-	int size;
+	GlobalIndex size;
 	int frontPadding;
 	int rearPadding;
 public:
-	BlockSizeInstr(int size);
-	BlockSizeInstr(Dimension pd, int id, int size);
+	BlockSizeInstr(GlobalIndex size);
+	BlockSizeInstr(Dimension pd, int id, GlobalIndex size);
 	Dimension getDimension(bool includePadding=true);
 	Dimension getDimension(Dimension parentDimension, int partId, int partsCount, bool includePadding);
 	List<IntervalSeq*> *getIntervalDesc();
@@ -152,6 +154,8 @@ protected:
 	int count;
 	int frontPadding;
 	int rearPadding;
+	// returns the part of the dimension that holds an index when the dimension is divided into the given number of parts
+	virtual int getPartNoOfIndex(Dimension dimension, int partsCount, GlobalIndex index);
 public:
 	BlockCountInstr(int count);
 	BlockCountInstr(Dimension pd, int id, int count);
@@ -161,11 +165,35 @@ public:
 	void setPadding(int frontPadding, int rearPadding);
 	int calculatePartsCount(Dimension dimension, bool updateProperties);
 	List<IntervalSeq*> *getIntervalDescForRange(Range idRange);
-	IntervalSeq *getPaddinglessIntervalForRange(Range idRange);
+	virtual IntervalSeq *getPaddinglessIntervalForRange(Range idRange);
 	void getIntervalDescForRangeHierarchy(List<Range> *rangeList, List<IntervalSeq*> *descInConstruct);
 	XformedIndexInfo *transformIndex(XformedIndexInfo *indexToXform);
 };
 
+/* Weighted-block partition makes the same number of parts as block-count partition does but places the part boundaries
+ * at cuts that balance the weights of the parts. So everything other than the part boundary calculation is inherited.
+ * Note that the interval description for a range of parts at an upper level of a part hierarchy assumes the parts have
+ * the same length; the dimension folding process of the communication library breaks up ranges of parts of different
+ * lengths before it asks for interval descriptions; so that assumption holds for the irregular parts too.   
+ * */
+class WeightedBlockInstr : public BlockCountInstr {
+protected:
+	PartitionWeights *weights;
+	// the index of the data dimension the first weight belongs to
+	GlobalIndex origin;
+	// the cuts for the last dimension divided by this instruction; cuts are recalculated only when the dimension changes
+	Range cutsRange;
+	int cutsCount;
+	std::vector<GlobalIndex> cuts;
+
+	const std::vector<GlobalIndex> &getCuts(Dimension dimension, int partsCount);
+	int getPartNoOfIndex(Dimension dimension, int partsCount, GlobalIndex index);
+public:
+	WeightedBlockInstr(int count, PartitionWeights *weights, GlobalIndex origin);
+	Dimension getDimension(Dimension parentDimension, int partId, int partsCount, bool includePadding);
+	IntervalSeq *getPaddinglessIntervalForRange(Range idRange);
+};
+
 class StrideInstr : public PartitionInstr {
 private:
 	int ppuCount;
@@ -184,11 +212,11 @@ public:
 
 class BlockStrideInstr : public PartitionInstr {
 private:
-	int size;
+	GlobalIndex size;
 	int ppuCount;
 public:
-	BlockStrideInstr(int ppuCount, int size);
-	BlockStrideInstr(Dimension pd, int id, int ppuCount, int size);
+	BlockStrideInstr(int ppuCount, GlobalIndex size);
+	BlockStrideInstr(Dimension pd, int id, int ppuCount, GlobalIndex size);
 	Dimension getDimension(bool includePadding=true);
 	Dimension getDimension(Dimension parentDimension, int partId, int partsCount, bool includePadding);
 	List<IntervalSeq*> *getIntervalDesc();
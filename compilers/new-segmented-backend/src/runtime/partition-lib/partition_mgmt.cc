@@ -8,24 +8,24 @@
 
 /******************************** partitionCount functions ****************************************/
 
-int block_size_partitionCount(Dimension d, int ppuCount, int size) {
+int block_size_partitionCount(Dimension d, int ppuCount, GlobalIndex size) {
         return (d.length + size - 1) / size;
 }
 
 int block_count_partitionCount(Dimension d, int ppuCount, int count) {
-	int length = d.length;
-        return std::max(1, std::min(count, length));
+	GlobalIndex length = d.length;
+        return std::max(1, (int) std::min((GlobalIndex) count, length));
 }
 
 int stride_partitionCount(Dimension d, int ppuCount) {
-	int length = d.length;
-        return std::max(1, std::min(ppuCount, length));
+	GlobalIndex length = d.length;
+        return std::max(1, (int) std::min((GlobalIndex) ppuCount, length));
 }
 
-int block_stride_partitionCount(Dimension d, int ppuCount, int size) {
-	int length = d.length;
-	int strides = length / size;
-        return std::max(1, std::min(strides, ppuCount));
+int block_stride_partitionCount(Dimension d, int ppuCount, GlobalIndex size) {
+	GlobalIndex length = d.length;
+	GlobalIndex strides = length / size;
+        return std::max(1, (int) std::min(strides, (GlobalIndex) ppuCount));
 }
 
 /*********************************** getRange functions *******************************************/
@@ -34,11 +34,11 @@ Dimension block_size_getRange(Dimension d,
 		int lpuCount, 
 		int lpuId, 
 		bool copyMode, 
-		int size, 
+		GlobalIndex size, 
 		int frontPadding, 
 		int backPadding) {
         
-	int begin = size * lpuId;
+	GlobalIndex begin = size * lpuId;
         Range range;
 	Range positiveRange = d.getPositiveRange();
         range.min = positiveRange.min + begin;
@@ -70,8 +70,8 @@ Dimension block_count_getRange(Dimension d,
 		int frontPadding, 
 		int backPadding) {
 	
-	int size = d.length / count;
-        int begin = size * lpuId;
+	GlobalIndex size = d.length / count;
+        GlobalIndex begin = size * lpuId;
         Range range;
 	Range positiveRange = d.getPositiveRange();
         range.min = positiveRange.min + begin;
@@ -98,10 +98,10 @@ Dimension block_count_getRange(Dimension d,
 
 Dimension stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode) {
 
-	int perStrideEntries = d.getLength() / lpuCount;
-	int myEntries = perStrideEntries;
-	int remainder = d.getLength() % lpuCount;
-	int extra = 0;
+	GlobalIndex perStrideEntries = d.getLength() / lpuCount;
+	GlobalIndex myEntries = perStrideEntries;
+	GlobalIndex remainder = d.getLength() % lpuCount;
+	GlobalIndex extra = 0;
 	if (remainder > 0) extra = remainder;
 	if (remainder > lpuId) {
 		myEntries++;
@@ -121,14 +121,14 @@ Dimension stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode) {
 	return dimension;
 }
               
-Dimension block_stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode, int size) {
+Dimension block_stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode, GlobalIndex size) {
 	
-	int stride = size * lpuCount;
-	int strideCount = d.getLength() / stride;
-	int partialStrideElements = d.getLength() % stride;
+	GlobalIndex stride = size * lpuCount;
+	GlobalIndex strideCount = d.getLength() / stride;
+	GlobalIndex partialStrideElements = d.getLength() % stride;
 	int blockCount = partialStrideElements / size;
-	int extraEntriesBefore = partialStrideElements;
-	int myEntries = strideCount * size;
+	GlobalIndex extraEntriesBefore = partialStrideElements;
+	GlobalIndex myEntries = strideCount * size;
 
 	// if extra entries fill up a complete new block in the stride of the current LPU then
 	// its number of entries should increase by the size parameter and extra preceeding
@@ -159,7 +159,7 @@ Dimension block_stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyM
 
 /********************************* getLPUIdRange functions ***************************************/
 
-LpuIdRange *block_size_getUpperRange(int index, Dimension d, int ppuCount, int size) {
+LpuIdRange *block_size_getUpperRange(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size) {
 	int cutoff = index / size;
 	int lpuCount = d.getLength() / size;
 	if (cutoff >= lpuCount - 1) return NULL;
@@ -169,7 +169,7 @@ LpuIdRange *block_size_getUpperRange(int index, Dimension d, int ppuCount, int s
 	return range;
 }
 
-LpuIdRange *block_size_getLowerRange(int index, Dimension d, int ppuCount, int size) {
+LpuIdRange *block_size_getLowerRange(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size) {
 	int cutoff = index / size;
 	if (cutoff == 0) return NULL; 	
 	LpuIdRange *range = new LpuIdRange();
@@ -178,12 +178,12 @@ LpuIdRange *block_size_getLowerRange(int index, Dimension d, int ppuCount, int s
 	return range;
 }
 
-int block_size_getInclusiveLpuId(int index, Dimension d, int ppuCount, int size) {
+int block_size_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size) {
 	return index / size;
 }
 
-LpuIdRange *block_count_getUpperRange(int index, Dimension d, int ppuCount, int count) {
-	int size = d.getLength() / count;
+LpuIdRange *block_count_getUpperRange(GlobalIndex index, Dimension d, int ppuCount, int count) {
+	GlobalIndex size = d.getLength() / count;
 	int cutoff = index / size;
 	if (cutoff >= count - 1) return NULL;
 	LpuIdRange *range = new LpuIdRange();
@@ -192,8 +192,8 @@ LpuIdRange *block_count_getUpperRange(int index, Dimension d, int ppuCount, int
 	return range;
 }
 
-LpuIdRange *block_count_getLowerRange(int index, Dimension d, int ppuCount, int count) {
-	int size = d.getLength() / count;
+LpuIdRange *block_count_getLowerRange(GlobalIndex index, Dimension d, int ppuCount, int count) {
+	GlobalIndex size = d.getLength() / count;
 	int cutoff = index / size;
 	if (cutoff == 0) return NULL;
 	LpuIdRange *range = new LpuIdRange();
@@ -202,24 +202,24 @@ LpuIdRange *block_count_getLowerRange(int index, Dimension d, int ppuCount, int
 	return range;
 }
 
-int block_count_getInclusiveLpuId(int index, Dimension d, int ppuCount, int count) {
-	int size = d.getLength() / count;
+int block_count_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount, int count) {
+	GlobalIndex size = d.getLength() / count;
 	return index / size;
 }
 
-LpuIdRange *stride_getUpperRange(int index, Dimension d, int ppuCount) { return NULL; }
-LpuIdRange *stride_getLowerRange(int index, Dimension d, int ppuCount) { return NULL; }
+LpuIdRange *stride_getUpperRange(GlobalIndex index, Dimension d, int ppuCount) { return NULL; }
+LpuIdRange *stride_getLowerRange(GlobalIndex index, Dimension d, int ppuCount) { return NULL; }
 
-int stride_getInclusiveLpuId(int index, Dimension d, int ppuCount) {
+int stride_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount) {
 	return index % ppuCount;
 }
-inline LpuIdRange *block_stride_getUpperRange(int index,
-                Dimension d, int ppuCount, int size) { return NULL; }
-inline LpuIdRange *block_stride_getLowerRange(int index,
-                Dimension d, int ppuCount, int size) { return NULL; }
+inline LpuIdRange *block_stride_getUpperRange(GlobalIndex index,
+                Dimension d, int ppuCount, GlobalIndex size) { return NULL; }
+inline LpuIdRange *block_stride_getLowerRange(GlobalIndex index,
+                Dimension d, int ppuCount, GlobalIndex size) { return NULL; }
 
-int block_stride_getInclusiveLpuId(int index, Dimension d, int ppuCount, int size) {
-	int stride = size * ppuCount;
-	int intraStrideIndex = index % stride;
+int block_stride_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size) {
+	GlobalIndex stride = size * ppuCount;
+	GlobalIndex intraStrideIndex = index % stride;
 	return intraStrideIndex / size;
 }
@@ -14,10 +14,10 @@
    their respective order.
 */
 
-int block_size_partitionCount(Dimension d, int ppuCount, int size);
+int block_size_partitionCount(Dimension d, int ppuCount, GlobalIndex size);
 int block_count_partitionCount(Dimension d, int ppuCount, int count);
 int stride_partitionCount(Dimension d, int ppuCount);
-int block_stride_partitionCount(Dimension d, int ppuCount, int size);
+int block_stride_partitionCount(Dimension d, int ppuCount, GlobalIndex size);
 	
 /*
    Furthermore, we need a mechanism to determine the portition of the dimension that 
@@ -44,12 +44,12 @@ int block_stride_partitionCount(Dimension d, int ppuCount, int size);
 */
 
 Dimension block_size_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode,
-		int size, int frontPadding, int backPadding); 
+		GlobalIndex size, int frontPadding, int backPadding); 
 Dimension block_count_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode,
 		int count, int frontPadding, int backPadding); 
 Dimension stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode); 
 Dimension block_stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyMode, 
-		int size); 
+		GlobalIndex size); 
 
 /*
    An alternative to the above approach of data re-ordering is to provide index 
@@ -76,23 +76,23 @@ Dimension block_stride_getRange(Dimension d, int lpuCount, int lpuId, bool copyM
    then it should return NULL in its implementation.	  	   
 */
 
-LpuIdRange *block_size_getUpperRange(int index, Dimension d, int ppuCount, int size);
-LpuIdRange *block_size_getLowerRange(int index, Dimension d, int ppuCount, int size);
-int block_size_getInclusiveLpuId(int index, Dimension d, int ppuCount, int size);
+LpuIdRange *block_size_getUpperRange(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size);
+LpuIdRange *block_size_getLowerRange(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size);
+int block_size_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size);
 
-LpuIdRange *block_count_getUpperRange(int index, Dimension d, int ppuCount, int count);
-LpuIdRange *block_count_getLowerRange(int index, Dimension d, int ppuCount, int count);
-int block_count_getInclusiveLpuId(int index, Dimension d, int ppuCount, int count);
+LpuIdRange *block_count_getUpperRange(GlobalIndex index, Dimension d, int ppuCount, int count);
+LpuIdRange *block_count_getLowerRange(GlobalIndex index, Dimension d, int ppuCount, int count);
+int block_count_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount, int count);
 
-LpuIdRange *stride_getUpperRange(int index, Dimension d, int ppuCount);
-LpuIdRange *stride_getLowerRange(int index, Dimension d, int ppuCount);
-int stride_getInclusiveLpuId(int index, Dimension d, int ppuCount);
+LpuIdRange *stride_getUpperRange(GlobalIndex index, Dimension d, int ppuCount);
+LpuIdRange *stride_getLowerRange(GlobalIndex index, Dimension d, int ppuCount);
+int stride_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount);
 
-inline LpuIdRange *block_stride_getUpperRange(int index, 
-		Dimension d, int ppuCount, int size);
-inline LpuIdRange *block_stride_getLowerRange(int index, 
-		Dimension d, int ppuCount, int size);
-int block_stride_getInclusiveLpuId(int index, Dimension d, int ppuCount, int size);
+inline LpuIdRange *block_stride_getUpperRange(GlobalIndex index, 
+		Dimension d, int ppuCount, GlobalIndex size);
+inline LpuIdRange *block_stride_getLowerRange(GlobalIndex index, 
+		Dimension d, int ppuCount, GlobalIndex size);
+int block_stride_getInclusiveLpuId(GlobalIndex index, Dimension d, int ppuCount, GlobalIndex size);
 
 
 #endif
@@ -0,0 +1,210 @@
+#include "partition_weights.h"
+#include "../file-io/stream.h"
+#include "../file-io/output_writer.h"
+
+#include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/utils/hashtable.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+
+Hashtable<const char*> *PartitionWeights::itemOriginMap = new Hashtable<const char*>;
+Hashtable<PartitionWeights*> *PartitionWeights::fileWeightsMap = new Hashtable<PartitionWeights*>;
+Hashtable<PartitionWeights*> *PartitionWeights::currentWeightsMap = new Hashtable<PartitionWeights*>;
+
+PartitionWeights::PartitionWeights(List<int> *values, bool prefixSums) {
+	if (prefixSums) {
+		// the prefix sums are rebased so that the total weight before the first index is zero
+		this->prefixSums.reserve(values->NumElements());
+		for (int i = 0; i < values->NumElements(); i++) {
+			this->prefixSums.push_back((long int) values->Nth(i) - values->Nth(0));
+		}
+		if (this->prefixSums.empty()) this->prefixSums.push_back(0);
+	} else {
+		this->prefixSums.reserve(values->NumElements() + 1);
+		this->prefixSums.push_back(0);
+		for (int i = 0; i < values->NumElements(); i++) {
+			this->prefixSums.push_back(this->prefixSums.back() + values->Nth(i));
+		}
+	}
+}
+
+void PartitionWeights::getCuts(Range range, GlobalIndex origin, int count, std::vector<GlobalIndex> &cuts) {
+
+	long int base = getPrefixSum(range.min - origin);
+	long int total = getPrefixSum(range.max + 1 - origin) - base;
+	if (total <= 0) {
+		getUniformCuts(range, count, cuts);
+		return;
+	}
+
+	cuts.resize(count + 1);
+	cuts[0] = range.min;
+	cuts[count] = range.max + 1;
+	for (int k = 1; k < count; k++) {
+
+		// the ideal cut is where the weight before it reaches k/count-th of the total; the prefix sums are sorted; so
+		// the first position reaching the target is found by a binary search, then the closer of that position and
+		// its predecessor is chosen
+		double target = base + ((double) total * k) / count;
+		GlobalIndex position = std::lower_bound(prefixSums.begin(), prefixSums.end(), target) - prefixSums.begin();
+		if (position > 0 && target - prefixSums[position - 1] < prefixSums[position] - target) {
+			position--;
+		}
+
+		// a very heavy index may attract several ideal cuts; the cuts are spread out so that each block still gets
+		// at least one index
+		GlobalIndex cut = std::min(position + origin, range.max + 1 - (count - k));
+		cuts[k] = std::max(cut, cuts[k - 1] + 1);
+	}
+}
+
+void PartitionWeights::getUniformCuts(Range range, int count, std::vector<GlobalIndex> &cuts) {
+	GlobalIndex length = range.max - range.min + 1;
+	GlobalIndex size = length / count;
+	cuts.resize(count + 1);
+	for (int k = 0; k < count; k++) {
+		cuts[k] = range.min + k * size;
+	}
+	cuts[count] = range.max + 1;
+}
+
+void PartitionWeights::recordFileOrigin(int envId, const char *itemName, const char *fileName) {
+	const char *key = getItemKey(envId, itemName);
+	const char *oldFileName = itemOriginMap->Lookup(key);
+	itemOriginMap->Enter(key, strdup(fileName));
+	if (oldFileName != NULL) free((char*) oldFileName);
+	free((char*) key);
+}
+
+void PartitionWeights::copyOrigin(int envId, const char *itemName, int sourceEnvId, const char *sourceItemName) {
+	const char *sourceKey = getItemKey(sourceEnvId, sourceItemName);
+	const char *fileName = itemOriginMap->Lookup(sourceKey);
+	free((char*) sourceKey);
+	if (fileName == NULL) {
+		forgetOrigin(envId, itemName);
+	} else {
+		recordFileOrigin(envId, itemName, fileName);
+	}
+}
+
+void PartitionWeights::forgetOrigin(int envId, const char *itemName) {
+	const char *key = getItemKey(envId, itemName);
+	const char *fileName = itemOriginMap->Lookup(key);
+	if (fileName != NULL) {
+		itemOriginMap->Remove(key, fileName);
+		free((char*) fileName);
+	}
+	free((char*) key);
+}
+
+void PartitionWeights::loadForInvocation(int envId, const char *arrayName, bool prefixSums, std::ofstream &logFile) {
+
+	const char *key = getItemKey(envId, arrayName);
+	const char *fileName = itemOriginMap->Lookup(key);
+	free((char*) key);
+
+	PartitionWeights *weights = NULL;
+	if (fileName != NULL) {
+		const char *fileKey = getWeightsKey(fileName, prefixSums);
+		weights = fileWeightsMap->Lookup(fileKey);
+		if (weights == NULL) {
+			// the file may be the target of an output job that has not finished yet
+			AsyncOutputWriter::waitForFile(fileName);
+			TypedInputStream<int> *stream = new TypedInputStream<int>(fileName);
+			List<Dimension*> *dimensionList = stream->getDimensionList();
+			if (dimensionList->NumElements() != 1) {
+				std::cout << "File " << fileName << " of array '" << arrayName << "' cannot be used ";
+				std::cout << "for weights as it does not hold a one dimensional array\n";
+				std::exit(EXIT_FAILURE);
+			}
+			GlobalIndex length = dimensionList->Nth(0)->length;
+			List<int> *weightList = new List<int>;
+			stream->open();
+			for (GlobalIndex i = 0; i < length; i++) {
+				weightList->Append(stream->readNextElement());
+			}
+			stream->close();
+			GlobalIndex invalidPosition = findInvalidValue(weightList, prefixSums);
+			if (invalidPosition >= 0) {
+				std::cout << "File " << fileName << " of array '" << arrayName << "' cannot be used ";
+				if (prefixSums) {
+					std::cout << "as prefix sums of weights: entry " << invalidPosition;
+					std::cout << " is smaller than the entry before it\n";
+				} else {
+					std::cout << "as weights: the weight at position " << invalidPosition;
+					std::cout << " is negative; use weighted_block_prefix if the array holds ";
+					std::cout << "the prefix sums of the weights\n";
+				}
+				std::exit(EXIT_FAILURE);
+			}
+			// offsets, e.g. the row_ptr array of a CSR matrix, given as weights are valid weights but give
+			// poor cuts; a sorted array starting from zero is likely to be such
+			if (!prefixSums && length > 2 && weightList->Nth(0) == 0 
+					&& findInvalidValue(weightList, true) < 0) {
+				logFile << "Weights for '" << arrayName << "' never decrease; if the array holds ";
+				logFile << "prefix sums of the weights, use weighted_block_prefix instead\n";
+			}
+			weights = new PartitionWeights(weightList, prefixSums);
+			delete weightList;
+			fileWeightsMap->Enter(fileKey, weights);
+			delete stream;
+		}
+		free((char*) fileKey);
+	}
+
+	const char *arrayKey = getWeightsKey(arrayName, prefixSums);
+	if (weights == NULL) {
+		logFile << "Weights for '" << arrayName << "' are unknown, using equal length blocks instead\n";
+		PartitionWeights *oldWeights = currentWeightsMap->Lookup(arrayKey);
+		if (oldWeights != NULL) {
+			currentWeightsMap->Remove(arrayKey, oldWeights);
+		}
+	} else {
+		currentWeightsMap->Enter(arrayKey, weights);
+	}
+	free((char*) arrayKey);
+}
+
+PartitionWeights *PartitionWeights::getCurrent(const char *arrayName, bool prefixSums) {
+	const char *arrayKey = getWeightsKey(arrayName, prefixSums);
+	PartitionWeights *weights = currentWeightsMap->Lookup(arrayKey);
+	free((char*) arrayKey);
+	return weights;
+}
+
+long int PartitionWeights::getPrefixSum(GlobalIndex position) {
+	GlobalIndex entries = prefixSums.size();
+	if (position <= 0) return 0;
+	if (position >= entries) return prefixSums.back();
+	return prefixSums[position];
+}
+
+const char *PartitionWeights::getItemKey(int envId, const char *itemName) {
+	std::ostringstream key;
+	key << envId << '.' << itemName;
+	return strdup(key.str().c_str());
+}
+
+const char *PartitionWeights::getWeightsKey(const char *name, bool prefixSums) {
+	std::ostringstream key;
+	key << (prefixSums ? "prefix-sums:" : "weights:") << name;
+	return strdup(key.str().c_str());
+}
+
+GlobalIndex PartitionWeights::findInvalidValue(List<int> *values, bool prefixSums) {
+	for (int i = 0; i < values->NumElements(); i++) {
+		if (prefixSums) {
+			if (i > 0 && values->Nth(i) < values->Nth(i - 1)) return i;
+		} else {
+			if (values->Nth(i) < 0) return i;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,82 @@
+#ifndef _H_partition_weights
+#define _H_partition_weights
+
+/* The 'weighted_block' partition function cuts a dimension into blocks of nearly equal total weight instead of equal
+ * length. The typical use is the row dimension of a CSR sparse matrix where the weight of a row is its number of non-
+ * zeros. Equal length blocks of rows then have very different amounts of work when the non-zeros are skewed, and the
+ * PPU getting the heaviest block decides the running time of the whole task.
+ *
+ * The weights come from a one-dimensional integer array of the task. The partition configuration of a task, however,
+ * is determined before its data parts are allocated; and, in the segmented memory model, no segment has the entire
+ * content of an array anyway. So the weights are read from the file the array has been bound to in the coordinator
+ * program. Each segment reads the same file; so all segments compute the same cuts, which is a must as the part
+ * boundaries decide what is communicated among segments. The environment instructions keep track of the file each
+ * task environment item's content has originated from, following assignments of items between environments. If the
+ * weight array of a task has not been read from a file, or has been recreated by a task since, the partition falls
+ * back to equal length blocks. The cuts only affect load balance; the result of the computation is the same for any
+ * cuts.
+ *
+ * The weight array either holds the weight of each index or, for the 'weighted_block_prefix' function, the prefix sums
+ * of the weights such as the row_ptr array of a CSR matrix has. In the latter case the weight of an index is the
+ * difference between the entry after its position and the entry at its position. A weight array with negative weights
+ * and a prefix-sum array that decreases anywhere are rejected as they cannot be what the partition function expects.
+ *
+ * Note that updates a task makes on an existing weight array are not tracked, the weights from the file are used
+ * regardless. Further, the weights are matched with the dimension position by position starting from its lower bound.
+ * */
+
+#include "../../../../common-libs/utils/hashtable.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <vector>
+#include <fstream>
+
+class PartitionWeights {
+  protected:
+	// prefix sums of the weights; entry i is the total weight of the first i positions, so there is one entry more
+	// than the number of weights
+	std::vector<long int> prefixSums;
+
+	// files the content of task environment items have been read from; keys are in the 'envId.itemName' form
+	static Hashtable<const char*> *itemOriginMap;
+	// weights loaded from files so far; the same weights file is typically used by many task invocations
+	static Hashtable<PartitionWeights*> *fileWeightsMap;
+	// weights of the task invocation in progress by the names of the weight arrays of the task
+	static Hashtable<PartitionWeights*> *currentWeightsMap;
+  public:
+	// the values are either the weights of consecutive indices or the prefix sums of those weights
+	PartitionWeights(List<int> *values, bool prefixSums);
+	int getWeightsCount() { return prefixSums.size() - 1; }
+	long int getTotalWeight() { return prefixSums.back(); }
+
+	// Determines the first index of each of 'count' consecutive blocks of the range so that the blocks have nearly
+	// equal total weight; the weight of an index is found at its position relative to the origin. The cuts vector
+	// gets count + 1 entries, the last being one past the end of the range. Each block gets at least one index; so
+	// the count should not exceed the length of the range.
+	void getCuts(Range range, GlobalIndex origin, int count, std::vector<GlobalIndex> &cuts);
+
+	// the same computation for equal length blocks that is used when there are no weights; it matches the blocks of
+	// the block-count partition function
+	static void getUniformCuts(Range range, int count, std::vector<GlobalIndex> &cuts);
+
+	// functions to be invoked by the environment instructions to track the files items have been read from
+	static void recordFileOrigin(int envId, const char *itemName, const char *fileName);
+	static void copyOrigin(int envId, const char *itemName, int sourceEnvId, const char *sourceItemName);
+	static void forgetOrigin(int envId, const char *itemName);
+
+	// Loads the weights of a weight array of the task from the file the corresponding environment item originated
+	// from and makes them the current weights for the array. If the origin is unknown, the current weights for the
+	// array become NULL and the fallback is logged. The content of the file is validated for the intended use of the
+	// array and the program is terminated with a diagnostic if it is not a valid weight or prefix-sum array.
+	static void loadForInvocation(int envId, const char *arrayName, bool prefixSums, std::ofstream &logFile);
+	static PartitionWeights *getCurrent(const char *arrayName, bool prefixSums);
+  private:
+	long int getPrefixSum(GlobalIndex position);
+	static const char *getItemKey(int envId, const char *itemName);
+	// weights are cached by file and current weights by array name; the keys distinguish the two uses of an array
+	static const char *getWeightsKey(const char *name, bool prefixSums);
+	// returns the position of the first invalid value, or -1 if the values are valid for the intended use
+	static GlobalIndex findInvalidValue(List<int> *values, bool prefixSums);
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "index_reduction.h"
+#include "reduction_barrier.h"
+#include "../../../../common-libs/domain-obj/constant.h"
+#include "../../../../common-libs/domain-obj/structure.h"
+
+#include <mpi.h>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+
+// The layout of a value and index tuple the custom MPI operators work on. In the large index mode there may be some
+// padding between the value and the index; so the tuples are packed from and unpacked to the send and receive buffers
+// where the index immediately follows the value.
+template <class Type> struct IndexedEntry {
+	Type value;
+	GlobalIndex index[MAX_INDEX_REDUCTION_DIMENSIONS];
+};
+
+static bool isIndexSmaller(const GlobalIndex *first, const GlobalIndex *second) {
+	for (int i = 0; i < MAX_INDEX_REDUCTION_DIMENSIONS; i++) {
+		if (first[i] != second[i]) return first[i] < second[i];
+	}
+	return false;
+}
+
+template <class Type, bool maximize> static void reduceIndexedEntries(void *in,
+		void *inout, int *length, MPI_Datatype *dataType) {
+
+	IndexedEntry<Type> *inEntries = (IndexedEntry<Type>*) in;
+	IndexedEntry<Type> *inoutEntries = (IndexedEntry<Type>*) inout;
+	for (int i = 0; i < *length; i++) {
+		Type inValue = inEntries[i].value;
+		Type inoutValue = inoutEntries[i].value;
+		bool better = maximize ? (inValue > inoutValue) : (inValue < inoutValue);
+		if (!better && inValue == inoutValue) {
+			better = isIndexSmaller(inEntries[i].index, inoutEntries[i].index);
+		}
+		if (better) inoutEntries[i] = inEntries[i];
+	}
+}
+
+// MPI types and operators for the value and index tuples are created the first time they are needed; different
+// reduction primitives may do that from different PPU controller threads
+static pthread_mutex_t entryTypeLock = PTHREAD_MUTEX_INITIALIZER;
+static bool entryTypesCreated = false;
+static MPI_Datatype intEntryType, floatEntryType, doubleEntryType;
+static MPI_Op maxIntEntryOp, minIntEntryOp, maxFloatEntryOp, minFloatEntryOp, maxDoubleEntryOp, minDoubleEntryOp;
+
+static void createEntryType(int size, MPI_Datatype *type) {
+	MPI_Type_contiguous(size, MPI_BYTE, type);
+	MPI_Type_commit(type);
+}
+
+template <class Type> static int allreduceIndexedEntry(char *sendBuffer, char *receiveBuffer,
+		MPI_Datatype entryType, MPI_Op entryOp, MPI_Comm mpiComm) {
+
+	int indexBytes = sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS;
+	IndexedEntry<Type> sendEntry, receiveEntry;
+	memset(&sendEntry, 0, sizeof(IndexedEntry<Type>));
+	memcpy(&sendEntry.value, sendBuffer, sizeof(Type));
+	memcpy(sendEntry.index, sendBuffer + sizeof(Type), indexBytes);
+	int status = MPI_Allreduce(&sendEntry, &receiveEntry, 1, entryType, entryOp, mpiComm);
+	memcpy(receiveBuffer, &receiveEntry.value, sizeof(Type));
+	memcpy(receiveBuffer + sizeof(Type), receiveEntry.index, indexBytes);
+	return status;
+}
+
+static void createEntryTypesAndOps() {
+	pthread_mutex_lock(&entryTypeLock);
+	if (!entryTypesCreated) {
+		createEntryType(sizeof(IndexedEntry<int>), &intEntryType);
+		createEntryType(sizeof(IndexedEntry<float>), &floatEntryType);
+		createEntryType(sizeof(IndexedEntry<double>), &doubleEntryType);
+		
+		// the tie-breaking on indexes makes the operators commutative
+		MPI_Op_create(reduceIndexedEntries<int, true>, 1, &maxIntEntryOp);
+		MPI_Op_create(reduceIndexedEntries<int, false>, 1, &minIntEntryOp);
+		MPI_Op_create(reduceIndexedEntries<float, true>, 1, &maxFloatEntryOp);
+		MPI_Op_create(reduceIndexedEntries<float, false>, 1, &minFloatEntryOp);
+		MPI_Op_create(reduceIndexedEntries<double, true>, 1, &maxDoubleEntryOp);
+		MPI_Op_create(reduceIndexedEntries<double, false>, 1, &minDoubleEntryOp);
+		entryTypesCreated = true;
+	}
+	pthread_mutex_unlock(&entryTypeLock);
+}
+
+int reduction::allreduceEntries(char *sendBuffer, char *receiveBuffer,
+		MPI_Datatype dataType,
+		ReductionOperator op,
+		int indexDimensions, MPI_Comm mpiComm) {
+
+	if (op != MAX_ENTRY && op != MIN_ENTRY) {
+		std::cout << "only maxEntry and minEntry reductions reduce indexes\n";
+		std::exit(EXIT_FAILURE);
+	}
+	if (dataType != MPI_INT && dataType != MPI_FLOAT && dataType != MPI_DOUBLE) {
+		std::cout << "Max/Min index reduction is only meaningful for numeric types\n";
+		std::exit(EXIT_FAILURE);
+	}
+	bool maximize = (op == MAX_ENTRY);
+
+	// a single index fits in MPI's own value and location pairs unless indexes are 64-bit
+	if (indexDimensions == 1 && sizeof(GlobalIndex) == sizeof(int)) {
+		MPI_Datatype pairType = MPI_2INT;
+		if (dataType == MPI_FLOAT) pairType = MPI_FLOAT_INT;
+		else if (dataType == MPI_DOUBLE) pairType = MPI_DOUBLE_INT;
+		return MPI_Allreduce(sendBuffer, receiveBuffer, 1, 
+				pairType, maximize ? MPI_MAXLOC : MPI_MINLOC, mpiComm);
+	}
+
+	createEntryTypesAndOps();
+	if (dataType == MPI_INT) {
+		return allreduceIndexedEntry<int>(sendBuffer, receiveBuffer, 
+				intEntryType, maximize ? maxIntEntryOp : minIntEntryOp, mpiComm);
+	} else if (dataType == MPI_FLOAT) {
+		return allreduceIndexedEntry<float>(sendBuffer, receiveBuffer, 
+				floatEntryType, maximize ? maxFloatEntryOp : minFloatEntryOp, mpiComm);
+	}
+	return allreduceIndexedEntry<double>(sendBuffer, receiveBuffer, 
+			doubleEntryType, maximize ? maxDoubleEntryOp : minDoubleEntryOp, mpiComm);
+}
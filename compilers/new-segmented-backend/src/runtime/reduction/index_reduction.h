@@ -0,0 +1,28 @@
+#ifndef _H_index_reduction
+#define _H_index_reduction
+
+/* An index reduction (maxEntry or minEntry) determines both the extreme value of an expression and the loop index at
+ * which the value is found. MPI has pair types and the MPI_MAXLOC/MPI_MINLOC operators for the cross-segment step of
+ * such a reduction; but they only support a single integer index. The function in this header uses them when the
+ * reducing loop has a single index and indexes are 32-bit. Otherwise it reduces value and index tuples in one
+ * collective using a custom MPI operator. Ties between equal values are resolved in favor of the lexicographically
+ * smaller index, just as MPI_MAXLOC and MPI_MINLOC do, so that all segments agree on the result.
+ */
+
+#include "../../../../common-libs/domain-obj/constant.h"
+
+#include <mpi.h>
+
+namespace reduction {
+
+	// Reduces the partial results of all segments in the communicator. The send and receive buffers hold the value
+	// of the partial result followed by its index array, as packed by the MPI reduction primitives. The data type
+	// is the MPI type of the value -- MPI_INT, MPI_FLOAT, or MPI_DOUBLE. The return value is the MPI status of the
+	// collective.
+	int allreduceEntries(char *sendBuffer, char *receiveBuffer,
+			MPI_Datatype dataType,
+			ReductionOperator op,
+			int indexDimensions, MPI_Comm mpiComm);
+}
+
+#endif
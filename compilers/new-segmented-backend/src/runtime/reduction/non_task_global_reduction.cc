@@ -18,6 +18,7 @@ NonTaskGlobalReductionPrimitive::NonTaskGlobalReductionPrimitive(int elementSize
 	
 	this->elementSize = elementSize;
 	this->op = op;
+	this->indexDimensions = 1;
 	this->logFile = NULL;
 }
 
@@ -25,8 +26,10 @@ void NonTaskGlobalReductionPrimitive::updateLocalTarget(
 		reduction::Result *finalResult, void *currLocalTarget) {
 
 	if (op == MAX_ENTRY || op == MIN_ENTRY) {
-                int *targetIndex = (int *) currLocalTarget;
-                *targetIndex = finalResult->index;
+		int *targetIndex = (int*) currLocalTarget;
+		for (int i = 0; i < indexDimensions; i++) {
+			targetIndex[i] = reduction::toIntegerIndex(finalResult->index[i]);
+		}
         } else {
                 memcpy(currLocalTarget, &(finalResult->data), elementSize);
         }
@@ -42,10 +45,11 @@ NonTaskGlobalMpiReductionPrimitive::NonTaskGlobalMpiReductionPrimitive(int eleme
 
 	this->segmentGroup = segmentGroup;
 
-	// just declare sufficiently large buffers for participating in a reduction; they don't have to be
-	// exactly as long as the data-type's size 
-	sendBuffer = (char *) malloc(sizeof(char) * 50);
-	receiveBuffer = (char *) malloc(sizeof(char) * 50);
+	// the buffers should be large enough for the data and the index of the result; MPI's value and location 
+	// pair types used for single index reductions in the default index mode fit in this size too
+	int bufferSize = elementSize + sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS;
+	sendBuffer = (char *) malloc(sizeof(char) * bufferSize);
+	receiveBuffer = (char *) malloc(sizeof(char) * bufferSize);
 }
 
 void NonTaskGlobalMpiReductionPrimitive::releaseFunction() {
@@ -56,7 +60,7 @@ void NonTaskGlobalMpiReductionPrimitive::releaseFunction() {
 		
 		// copy index next to the data
 		char *sendIndex = sendBuffer + elementSize;
-		memcpy(sendIndex, &(intermediateResult->index), sizeof(unsigned int));  
+		memcpy(sendIndex, intermediateResult->index, sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS);  
 		
 		// do MPI communication as needed
 		performCrossSegmentReduction();
@@ -66,7 +70,7 @@ void NonTaskGlobalMpiReductionPrimitive::releaseFunction() {
 
 		// copy index from next to data position of the receive buffer
 		char *receiveIndex = receiveBuffer + elementSize;
-		memcpy(&(intermediateResult->index), receiveIndex, sizeof(unsigned int));  
+		memcpy(intermediateResult->index, receiveIndex, sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS);  
 	}	
 
 	// then call super-class's release function to copy the result to the target
@@ -21,10 +21,14 @@ class NonTaskGlobalReductionPrimitive : public NonTaskGlobalReductionBarrier {
   protected:
 	int elementSize;
 	ReductionOperator op;
+	
+	// the number of meaningful entries in the index of the result of an index reduction
+	int indexDimensions;
 	std::ofstream *logFile;
   public:
 	NonTaskGlobalReductionPrimitive(int elementSize, ReductionOperator op, int localParticipants);
 	void setLogFile(std::ofstream *logFile) { this->logFile = logFile; }
+	void setIndexDimensions(int indexDimensions) { this->indexDimensions = indexDimensions; }
 
 	// Different reduction function requires different initial values for the partial result variable -- the
 	// result variable cannot be just set to all zeros. So subclasses should provide proper implementations.
@@ -50,10 +54,10 @@ class NonTaskGlobalMpiReductionPrimitive : public NonTaskGlobalReductionPrimitiv
   protected:
 	SegmentGroup *segmentGroup;
 
-	// these two buffers are used for sending local results and receiving final results respectively. Care
-	// should be taken so that the data and/or index of reduction are accessed correctly from these buffers 
-	// in the subclass. The subclass implementer should investigate the implementation of releaseFunction()
-	// function to avoid mistakes.
+	// these two buffers are used for sending local results and receiving final results respectively. Each
+	// holds the data of the result followed by its full index array. Care should be taken so that the data 
+	// and/or index of reduction are accessed correctly from these buffers in the subclass. The subclass 
+	// implementer should investigate the implementation of releaseFunction() function to avoid mistakes.
 	char *sendBuffer;
 	char *receiveBuffer;
   public:
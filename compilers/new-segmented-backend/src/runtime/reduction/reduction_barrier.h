@@ -2,12 +2,17 @@
 #define _H_reduction
 
 #include "../../../../common-libs/utils/list.h"
+#include "../../../../common-libs/domain-obj/constant.h"
+#include "../../../../common-libs/domain-obj/structure.h"
 
 #include <stdio.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include <math.h>
 #include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <climits>
 
 namespace reduction {
 
@@ -22,14 +27,30 @@ namespace reduction {
 
 	// The result of a reduction can be the data (e.g., max, sum) or the index (e.g., maxEntry, minEntry). 
 	// Since the parallel for loop holding a reduction operation may be iterating on multiple indices, the 
-	// index should be multidimensional. But the index here is a single integer -- not an array. So index 
-	// based reduction on multidimensional array will not work. We will fix this problem after reduction of
-	// data is fully functional. 
+	// index is multidimensional. Only the first as many entries of the index array as the number of indices
+	// of the loop are meaningful; the rest are kept at zero so that results can be compared and copied as a
+	// whole regardless of the loop.
 	class Result {
 	  public:   
 		reduction::Data data; 
-		unsigned int index;
+		GlobalIndex index[MAX_INDEX_REDUCTION_DIMENSIONS];
+	  public:
+		Result() { 
+			for (int i = 0; i < MAX_INDEX_REDUCTION_DIMENSIONS; i++) index[i] = 0; 
+		}
 	};
+
+	// The index found by an index reduction is stored in an integer variable of the program. In the large index
+	// mode the index may not fit in that variable; the conversion then fails instead of truncating the index.
+	inline int toIntegerIndex(GlobalIndex index) {
+#ifdef LARGE_INDEX_SPACE
+		if (index > INT_MAX || index < INT_MIN) {
+			std::cout << "index reduction result " << index << " does not fit in an integer variable\n";
+			std::exit(EXIT_FAILURE);
+		}
+#endif
+		return (int) index;
+	}
 }
 
 /* This is another extension of Profe's barrier class. It is designed for implementing task-global reductions, i.e.,
@@ -0,0 +1,265 @@
+#include <mpi.h>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "scan_primitive.h"
+#include "reduction_barrier.h"
+#include "../communication/mpi_group.h"
+
+// possible states of the check on the order of LPUs among segments
+static const int ORDER_UNKNOWN = 0;
+static const int ORDER_BY_RANK = 1;
+static const int ORDER_IRREGULAR = 2;
+
+ScanPrimitive::ScanPrimitive(int elementSize,
+		ReductionOperator op,
+		ScanMode mode,
+		int localParticipants,
+		SegmentGroup *participantGroup) {
+
+	_size = localParticipants;
+	_count = localParticipants;
+	sem_init(&mutex, 0, 1);
+	sem_init(&throttle, 0, 0);
+	sem_init(&waitq, 0, 0);
+	pthread_mutex_init(&contributionLock, NULL);
+	segmentOrderStatus = ORDER_UNKNOWN;
+
+	this->elementSize = elementSize;
+	this->op = op;
+	this->mode = mode;
+	this->crossSegment = (participantGroup != NULL && participantGroup->getParticipantsCount() > 1);
+	this->communicator = crossSegment ? participantGroup->getCommunicator() : MPI_COMM_NULL;
+	this->logFile = NULL;
+	this->intermediateResult = NULL;
+
+	sendBuffer = (char *) malloc(sizeof(char) * 50);
+	receiveBuffer = (char *) malloc(sizeof(char) * 50);
+}
+
+ScanPrimitive::~ScanPrimitive() {
+	free(sendBuffer);
+	free(receiveBuffer);
+	sem_destroy(&mutex);
+	sem_destroy(&throttle);
+	sem_destroy(&waitq);
+	pthread_mutex_destroy(&contributionLock);
+}
+
+void ScanPrimitive::recordContribution(int lpuId, reduction::Result *lpuResult) {
+	pthread_mutex_lock(&contributionLock);
+	contributions.insert(std::pair<int, reduction::Result*>(lpuId, lpuResult));
+	pthread_mutex_unlock(&contributionLock);
+}
+
+void ScanPrimitive::completeScan() {
+
+	sem_wait(&mutex);
+	_count--;
+	if (_count == 0) {
+
+		// all local contributions have been recorded by now; so the scan can be done
+		scanContributions();
+
+		for (int i = 1; i < _size; i++) {
+			sem_post(&waitq);
+			sem_wait(&throttle);
+		}
+		_count = _size;
+		sem_post(&mutex);
+	} else {
+		sem_post(&mutex);
+		sem_wait(&waitq);
+		sem_post(&throttle);
+	}
+}
+
+void ScanPrimitive::scanContributions() {
+
+	// determine what the LPUs of earlier segments sum up to, in the sense of the reduction operator; when the 
+	// LPUs of segments interleave, each run of consecutive local LPUs gets an offset of its own instead
+	reduction::Result segmentOffset;
+	resetPartialResult(&segmentOffset);
+	bool offsetPerRun = false;
+	std::map<int, reduction::Result> runOffsets;
+	if (crossSegment) {
+		if (areSegmentsInLpuOrder()) {
+			reduction::Result segmentTotal;
+			resetPartialResult(&segmentTotal);
+			intermediateResult = &segmentTotal;
+			std::map<int, reduction::Result*>::iterator it;
+			for (it = contributions.begin(); it != contributions.end(); ++it) {
+				updateIntermediateResult(it->second);
+			}
+			computeSegmentOffset(&segmentTotal, &segmentOffset);
+		} else {
+			computeRunOffsets(&runOffsets);
+			offsetPerRun = true;
+		}
+	}
+
+	// then do a sequential scan over the local LPUs starting from the segment offset; there are only as many
+	// local contributions as there are LPUs of the root LPS in the segment
+	reduction::Result runningResult = segmentOffset;
+	intermediateResult = &runningResult;
+	std::map<int, reduction::Result*>::iterator it;
+	for (it = contributions.begin(); it != contributions.end(); ++it) {
+		if (offsetPerRun) {
+			std::map<int, reduction::Result>::iterator runIt = runOffsets.find(it->first);
+			if (runIt != runOffsets.end()) runningResult = runIt->second;
+		}
+		reduction::Result *lpuResult = it->second;
+		reduction::Result contribution = *lpuResult;
+		if (mode == EXCLUSIVE_SCAN) {
+			memcpy(&(lpuResult->data), &(runningResult.data), elementSize);
+			updateIntermediateResult(&contribution);
+		} else {
+			updateIntermediateResult(&contribution);
+			memcpy(&(lpuResult->data), &(runningResult.data), elementSize);
+		}
+	}
+
+	intermediateResult = NULL;
+	contributions.clear();
+}
+
+void ScanPrimitive::computeSegmentOffset(reduction::Result *segmentTotal, reduction::Result *segmentOffset) {
+
+	int groupRank;
+	MPI_Comm_rank(communicator, &groupRank);
+	memcpy(sendBuffer, &(segmentTotal->data), elementSize);
+	performCrossSegmentExscan();
+
+	// the receive buffer is undefined for the first segment after an MPI_Exscan
+	if (groupRank > 0) {
+		memcpy(&(segmentOffset->data), receiveBuffer, elementSize);
+	}
+}
+
+void ScanPrimitive::computeRunOffsets(std::map<int, reduction::Result> *runOffsets) {
+
+	// split the local LPUs into runs of consecutive IDs and add up the contributions of each run
+	std::vector<int> runStarts;
+	std::vector<reduction::Result> runTotals;
+	int previousLpuId = 0;
+	std::map<int, reduction::Result*>::iterator it;
+	for (it = contributions.begin(); it != contributions.end(); ++it) {
+		if (runStarts.empty() || it->first != previousLpuId + 1) {
+			reduction::Result runTotal;
+			resetPartialResult(&runTotal);
+			runStarts.push_back(it->first);
+			runTotals.push_back(runTotal);
+		}
+		intermediateResult = &runTotals.back();
+		updateIntermediateResult(it->second);
+		previousLpuId = it->first;
+	}
+
+	// gather the runs of all segments as records of the first LPU ID of a run followed by the run's total
+	int groupRank, segmentCount;
+	MPI_Comm_rank(communicator, &groupRank);
+	MPI_Comm_size(communicator, &segmentCount);
+	int recordSize = sizeof(int) + elementSize;
+	int localRuns = runStarts.size();
+	int *runCounts = new int[segmentCount];
+	int status = MPI_Allgather(&localRuns, 1, MPI_INT, runCounts, 1, MPI_INT, communicator);
+	if (status != MPI_SUCCESS) {
+		std::cout << "Segment " << groupRank << ": could not gather the LPU run counts of a scan\n";
+		std::exit(EXIT_FAILURE);
+	}
+	int *byteCounts = new int[segmentCount];
+	int *displacements = new int[segmentCount];
+	int totalRuns = 0;
+	for (int s = 0; s < segmentCount; s++) {
+		byteCounts[s] = runCounts[s] * recordSize;
+		displacements[s] = totalRuns * recordSize;
+		totalRuns += runCounts[s];
+	}
+	int firstLocalRun = displacements[groupRank] / recordSize;
+	char *localRecords = (char *) malloc(recordSize * (localRuns > 0 ? localRuns : 1));
+	for (int r = 0; r < localRuns; r++) {
+		memcpy(localRecords + r * recordSize, &runStarts[r], sizeof(int));
+		memcpy(localRecords + r * recordSize + sizeof(int), &(runTotals[r].data), elementSize);
+	}
+	char *allRecords = (char *) malloc(recordSize * (totalRuns > 0 ? totalRuns : 1));
+	status = MPI_Allgatherv(localRecords, localRuns * recordSize, MPI_BYTE,
+			allRecords, byteCounts, displacements, MPI_BYTE, communicator);
+	if (status != MPI_SUCCESS) {
+		std::cout << "Segment " << groupRank << ": could not gather the LPU run totals of a scan\n";
+		std::exit(EXIT_FAILURE);
+	}
+
+	// go over the runs of all segments in the order of their LPU IDs and take the reduction of the runs preceding
+	// each local run as the offset of the latter
+	std::vector<std::pair<int, int> > runOrder;
+	for (int r = 0; r < totalRuns; r++) {
+		int runStart;
+		memcpy(&runStart, allRecords + r * recordSize, sizeof(int));
+		runOrder.push_back(std::pair<int, int>(runStart, r));
+	}
+	std::sort(runOrder.begin(), runOrder.end());
+	reduction::Result precedingTotal;
+	resetPartialResult(&precedingTotal);
+	intermediateResult = &precedingTotal;
+	for (unsigned int i = 0; i < runOrder.size(); i++) {
+		int r = runOrder[i].second;
+		if (r >= firstLocalRun && r < firstLocalRun + localRuns) {
+			runOffsets->insert(std::pair<int, reduction::Result>(runOrder[i].first, precedingTotal));
+		}
+		reduction::Result runTotal;
+		memcpy(&(runTotal.data), allRecords + r * recordSize + sizeof(int), elementSize);
+		updateIntermediateResult(&runTotal);
+	}
+
+	delete[] runCounts;
+	delete[] byteCounts;
+	delete[] displacements;
+	free(localRecords);
+	free(allRecords);
+}
+
+bool ScanPrimitive::areSegmentsInLpuOrder() {
+
+	if (segmentOrderStatus != ORDER_UNKNOWN) return segmentOrderStatus == ORDER_BY_RANK;
+
+	// a segment without LPUs sends an empty range
+	int segmentCount;
+	MPI_Comm_size(communicator, &segmentCount);
+	int lpuRange[2];
+	lpuRange[0] = contributions.empty() ? INT_MAX : contributions.begin()->first;
+	lpuRange[1] = contributions.empty() ? INT_MIN : contributions.rbegin()->first;
+	int *lpuRanges = new int[segmentCount * 2];
+	int status = MPI_Allgather(lpuRange, 2, MPI_INT, lpuRanges, 2, MPI_INT, communicator);
+	if (status != MPI_SUCCESS) {
+		std::cout << "could not gather the LPU ordering of segments for a scan\n";
+		std::exit(EXIT_FAILURE);
+	}
+
+	// the whole LPU range of a segment should come after that of every lower ranked segment; segments that have no 
+	// LPUs contribute nothing, so they do not break the order
+	segmentOrderStatus = ORDER_BY_RANK;
+	int lastLpuId = INT_MIN;
+	for (int s = 0; s < segmentCount; s++) {
+		if (lpuRanges[s * 2] == INT_MAX) continue;
+		if (lpuRanges[s * 2] <= lastLpuId) {
+			segmentOrderStatus = ORDER_IRREGULAR;
+			break;
+		}
+		lastLpuId = lpuRanges[s * 2 + 1];
+	}
+	delete[] lpuRanges;
+
+	if (segmentOrderStatus == ORDER_IRREGULAR && logFile != NULL) {
+		*logFile << "\tLPU ranges of segments interleave; scans will gather the totals of LPU runs\n";
+		logFile->flush();
+	}
+	return segmentOrderStatus == ORDER_BY_RANK;
+}
@@ -0,0 +1,100 @@
+#ifndef _H_scan_primitive
+#define _H_scan_primitive
+
+/* A scan is a reduction whose result differs from LPU to LPU of the root LPS. The result for an LPU is the reduction
+ * of the contributions of all LPUs that precede it in the LPU ID order, including itself for an inclusive scan and
+ * excluding itself for an exclusive scan. The contribution of an individual LPU is computed by the regular non-task-
+ * global reduction machinery; the primitive in this header only combines the already reduced contributions of the
+ * root LPS's LPUs once all of them are done.
+ *
+ * The combination happens in two steps. First, the contributions of the LPUs processed within the current segment
+ * are scanned locally. Then the total of the segment is combined with the totals of the earlier segments using an
+ * MPI_Exscan, and the outcome is applied on top of the local scan. The MPI_Exscan only gives the right offset if the
+ * range of LPU IDs of each segment lies entirely after the ranges of the segments of lower ranks, which is the case
+ * for the default blocked LPU distribution. The primitive verifies this the first time it does a cross-segment scan.
+ * Otherwise, as with a strided LPU distribution, each segment splits its LPUs into runs of consecutive IDs and the
+ * totals of the runs of all segments are gathered to give each run its own offset.
+ *
+ * Only the segments participating in the task take part in a scan; so the cross-segment steps use the communicator
+ * of the group of participating segments rather than that of the whole invocation.
+ */
+
+#include "reduction_barrier.h"
+#include "../communication/mpi_group.h"
+#include "../../../../common-libs/domain-obj/constant.h"
+
+#include <mpi.h>
+#include <map>
+#include <pthread.h>
+#include <semaphore.h>
+#include <fstream>
+
+class ScanPrimitive {
+  private:
+	int _size;				// How many threads need to call completeScan() before releasing all threads
+	int _count;				// Current count of waiting threads
+	sem_t mutex;  				// The mutex
+	sem_t throttle;				// Waiters signal the releaser so that there is no over-pumping
+	sem_t waitq;				// The semaphore on which the waiters wait
+
+	// the contributions of the LPUs processed in the current segment ordered by their LPU IDs; the
+	// stored result variables are updated in place with the outcome of the scan
+	std::map<int, reduction::Result*> contributions;
+	pthread_mutex_t contributionLock;
+
+	// status of the check whether LPUs are assigned to segments in the order of segment ranks
+	int segmentOrderStatus;
+  protected:
+	int elementSize;
+	ReductionOperator op;
+	ScanMode mode;
+	bool crossSegment;
+	// communicator of the segments participating in the task; it is not used when the scan is local
+	MPI_Comm communicator;
+	std::ofstream *logFile;
+
+	// the generated intermediate result update function of a subclass accumulates into this reference
+	reduction::Result *intermediateResult;
+
+	// buffers the subclass uses for the MPI_Exscan of segment totals; they are as large as the buffers of
+	// the reduction primitives
+	char *sendBuffer;
+	char *receiveBuffer;
+  public:
+	ScanPrimitive(int elementSize,
+			ReductionOperator op,
+			ScanMode mode,
+			int localParticipants,
+			SegmentGroup *participantGroup);
+	virtual ~ScanPrimitive();
+	void setLogFile(std::ofstream *logFile) { this->logFile = logFile; }
+
+	// the initial value of a partial result depends on the reduction operator; so the subclass should
+	// provide this function
+	virtual void resetPartialResult(reduction::Result *resultVar) = 0;
+
+	// A PPU controller calls this function after it finished the reduction for an LPU of the root LPS. The
+	// result variable should be the persistent result of that LPU. Multiple PPU controllers can record the
+	// same LPU; the repeated entries are ignored.
+	void recordContribution(int lpuId, reduction::Result *lpuResult);
+
+	// This is a barrier all local PPU controllers participating in the scan call after they are done with
+	// all their LPUs of the root LPS. The last one to enter does the scan of the recorded contributions.
+	void completeScan();
+  protected:
+	// applies a partial result to the intermediate result
+	virtual void updateIntermediateResult(reduction::Result *localPartialResult) = 0;
+
+	// This should do the MPI_Exscan of the data in the send buffer into the receive buffer over the
+	// communicator. The data in the receive buffer of the first segment is ignored.
+	virtual void performCrossSegmentExscan() = 0;
+  private:
+	void scanContributions();
+	void computeSegmentOffset(reduction::Result *segmentTotal, reduction::Result *segmentOffset);
+	// computes the offsets of the runs of consecutive local LPU IDs when LPUs are not ordered by segment ranks;
+	// the offsets are keyed by the first LPU ID of the runs
+	void computeRunOffsets(std::map<int, reduction::Result> *runOffsets);
+	bool areSegmentsInLpuOrder();
+};
+
+#endif
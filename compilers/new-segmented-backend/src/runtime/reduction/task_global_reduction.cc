@@ -18,6 +18,7 @@ TaskGlobalReductionPrimitive::TaskGlobalReductionPrimitive(int elementSize,
 	
 	this->elementSize = elementSize;
 	this->op = op;
+	this->indexDimensions = 1;
 	this->intermediateResult = new reduction::Result();
 	this->target = NULL;
 	this->logFile = NULL;
@@ -34,8 +35,11 @@ void TaskGlobalReductionPrimitive::initFunction(reduction::Result *localPartialR
 
 void TaskGlobalReductionPrimitive::releaseFunction() {
 	if (op == MAX_ENTRY || op == MIN_ENTRY) {
-		int *targetIndex = (int *) target;
-		*targetIndex = intermediateResult->index;
+		// the target is an integer for a single index loop and an integer array otherwise
+		int *targetIndex = (int*) target;
+		for (int i = 0; i < indexDimensions; i++) {
+			targetIndex[i] = reduction::toIntegerIndex(intermediateResult->index[i]);
+		}
 	} else {
 		memcpy(target, &(intermediateResult->data), elementSize);
 	}
@@ -51,10 +55,11 @@ TaskGlobalMpiReductionPrimitive::TaskGlobalMpiReductionPrimitive(int elementSize
 
 	this->segmentGroup = segmentGroup;
 
-	// just declare sufficiently large buffers for participating in a reduction; they don't have to be
-	// exactly as long as the data-type's size 
-	sendBuffer = (char *) malloc(sizeof(char) * 50);
-	receiveBuffer = (char *) malloc(sizeof(char) * 50);
+	// the buffers should be large enough for the data and the index of the result; MPI's value and location 
+	// pair types used for single index reductions in the default index mode fit in this size too
+	int bufferSize = elementSize + sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS;
+	sendBuffer = (char *) malloc(sizeof(char) * bufferSize);
+	receiveBuffer = (char *) malloc(sizeof(char) * bufferSize);
 }
 
 void TaskGlobalMpiReductionPrimitive::releaseFunction() {
@@ -65,7 +70,7 @@ void TaskGlobalMpiReductionPrimitive::releaseFunction() {
 		
 		// copy index next to the data
 		char *sendIndex = sendBuffer + elementSize;
-		memcpy(sendIndex, &(intermediateResult->index), sizeof(unsigned int));  
+		memcpy(sendIndex, intermediateResult->index, sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS);  
 		
 		// do MPI communication as needed
 		performCrossSegmentReduction();
@@ -75,7 +80,7 @@ void TaskGlobalMpiReductionPrimitive::releaseFunction() {
 
 		// copy index from next to data position of the receive buffer
 		char *receiveIndex = receiveBuffer + elementSize;
-		memcpy(&(intermediateResult->index), receiveIndex, sizeof(unsigned int));  
+		memcpy(intermediateResult->index, receiveIndex, sizeof(GlobalIndex) * MAX_INDEX_REDUCTION_DIMENSIONS);  
 	}	
 
 	// then call super-class's release function to copy the result to the target
@@ -0,0 +1,186 @@
+/* This program runs short micro-benchmarks that the pcubes-discover script uses to annotate the spaces of a discovered
+ * PCubeS description with measured characteristics. It supports three modes
+ *	bandwidth <bytes> <cpu>	 : read bandwidth (GB/s) of a buffer of the given size from the given processor
+ *	latency <bytes> <cpu>	 : dependent load latency (ns) within a buffer of the given size from the given processor
+ *	throughput <cpu-list>	 : relative compute throughput of the listed processors when all of them are busy
+ * The buffer size decides which level of the memory hierarchy is being measured; so the script passes a size that
+ * fits in the cache of the level under concern. The result of the first two modes is a single number on the output
+ * and that of the last mode is one number per processor in the order of the list.
+ * */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+using namespace std;
+
+// each measurement runs for roughly this many seconds after a warm up pass
+const double PROBE_DURATION = 0.2;
+
+double getTime() {
+	struct timeval time;
+	gettimeofday(&time, NULL);
+	return time.tv_sec + time.tv_usec / 1000000.0;
+}
+
+void pinToProcessor(int cpu) {
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	if (sched_setaffinity(0, sizeof(cpu_set_t), &cpus) != 0) {
+		cout << "could not pin the probe to processor " << cpu << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+double measureBandwidth(long bytes) {
+	long count = bytes / sizeof(long);
+	if (count < 1) count = 1;
+	long *buffer = new long[count];
+	for (long i = 0; i < count; i++) buffer[i] = i;
+
+	volatile long sink = 0;
+	long passes = 0;
+	double start = getTime();
+	double elapsed = 0;
+	while (elapsed < PROBE_DURATION) {
+		long sum = 0;
+		for (long i = 0; i < count; i++) sum += buffer[i];
+		sink += sum;
+		passes++;
+		elapsed = getTime() - start;
+	}
+	delete[] buffer;
+	return (passes * count * sizeof(long)) / elapsed / 1.0e9;
+}
+
+double measureLatency(long bytes) {
+
+	// each element is a cache line apart so that each load of the chase touches a different line
+	long stride = 64 / sizeof(void*);
+	long lines = bytes / 64;
+	if (lines < 2) lines = 2;
+	void **buffer = new void*[lines * stride];
+
+	// link the lines in a random cycle to defeat the hardware prefetchers
+	vector<long> order(lines);
+	for (long i = 0; i < lines; i++) order[i] = i;
+	srand(lines);
+	for (long i = lines - 1; i > 0; i--) {
+		long j = rand() % (i + 1);
+		long temp = order[i];
+		order[i] = order[j];
+		order[j] = temp;
+	}
+	for (long i = 0; i < lines; i++) {
+		buffer[order[i] * stride] = &buffer[order[(i + 1) % lines] * stride];
+	}
+
+	void **current = &buffer[order[0] * stride];
+	long loads = 0;
+	double start = getTime();
+	double elapsed = 0;
+	while (elapsed < PROBE_DURATION) {
+		for (long i = 0; i < lines; i++) current = (void**) *current;
+		loads += lines;
+		elapsed = getTime() - start;
+	}
+	if (current == NULL) cout << "";
+	delete[] buffer;
+	return elapsed * 1.0e9 / loads;
+}
+
+class ThroughputArg {
+  public:
+	int cpu;
+	volatile bool *started;
+	volatile bool *stopped;
+	double iterations;
+};
+
+void *runThroughputLoop(void *arg) {
+	ThroughputArg *throughputArg = (ThroughputArg*) arg;
+	pinToProcessor(throughputArg->cpu);
+	while (!*(throughputArg->started));
+
+	// a mix of floating point and integer work that keeps the core busy without touching memory
+	double x = 1.0, y = 0.5;
+	long k = 1;
+	double iterations = 0;
+	while (!*(throughputArg->stopped)) {
+		for (int i = 0; i < 1000; i++) {
+			x = x * 0.999999 + y;
+			y = y * 1.000001 - 0.25;
+			k = k * 1103515245 + 12345;
+		}
+		iterations += 1;
+	}
+	if (x == k) cout << "";
+	throughputArg->iterations = iterations;
+	return NULL;
+}
+
+void measureThroughput(vector<int> &cpus) {
+	volatile bool started = false;
+	volatile bool stopped = false;
+	vector<pthread_t> threads(cpus.size());
+	vector<ThroughputArg> args(cpus.size());
+	for (unsigned int i = 0; i < cpus.size(); i++) {
+		args[i].cpu = cpus[i];
+		args[i].started = &started;
+		args[i].stopped = &stopped;
+		args[i].iterations = 0;
+		if (pthread_create(&threads[i], NULL, runThroughputLoop, &args[i]) != 0) {
+			cout << "could not start a probe thread\n";
+			exit(EXIT_FAILURE);
+		}
+	}
+	started = true;
+	double start = getTime();
+	while (getTime() - start < PROBE_DURATION * 5);
+	stopped = true;
+	for (unsigned int i = 0; i < cpus.size(); i++) {
+		pthread_join(threads[i], NULL);
+		if (i > 0) cout << " ";
+		cout << (long) args[i].iterations;
+	}
+	cout << "\n";
+}
+
+int main(int argc, char *argv[]) {
+
+	if (argc < 3) {
+		cout << "usage: " << argv[0] << " bandwidth|latency <bytes> <cpu>\n";
+		cout << "       " << argv[0] << " throughput <cpu> <cpu> ...\n";
+		exit(EXIT_FAILURE);
+	}
+
+	if (strcmp(argv[1], "throughput") == 0) {
+		vector<int> cpus;
+		for (int i = 2; i < argc; i++) cpus.push_back(atoi(argv[i]));
+		measureThroughput(cpus);
+		return 0;
+	}
+
+	if (argc < 4) {
+		cout << "a buffer size and a processor number are needed for the " << argv[1] << " probe\n";
+		exit(EXIT_FAILURE);
+	}
+	long bytes = atol(argv[2]);
+	pinToProcessor(atoi(argv[3]));
+	if (strcmp(argv[1], "bandwidth") == 0) {
+		measureBandwidth(bytes);
+		cout << measureBandwidth(bytes) << "\n";
+	} else if (strcmp(argv[1], "latency") == 0) {
+		measureLatency(bytes);
+		cout << measureLatency(bytes) << "\n";
+	} else {
+		cout << "unknown probe: " << argv[1] << "\n";
+		exit(EXIT_FAILURE);
+	}
+	return 0;
+}
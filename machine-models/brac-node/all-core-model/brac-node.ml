@@ -2,9 +2,14 @@
 // processor model name    : 13th Gen Intel(R) Core(TM) i5-13600KF
 // total memory: 15 GB
 
+// The first 12 cores are the hyperthreads of the 6 performance cores and the last 8 are the
+// efficiency cores. The PPU weights after the core count give their relative throughputs so
+// that the slower efficiency cores get proportionally fewer LPUs; tune them by running the
+// benchmark suite with this model.
+
 //--------------------------------------------------------------------------------------
 //Space #Number : 	$Space-Name	(#PPU-Count)	// Comment
 //--------------------------------------------------------------------------------------
 Space 	3:  		CPU 		(1)		// 15 GB RAM in CPU			
 Space 	2: 		L3-Cache 	(1) 		// 24 MB L3 cache shared by all cores		
-Space 	1<core>: 	Core     	(20)		// 1 MB Cache per core 
+Space 	1<core>: 	Core     	(20) {5*12, 4*8}	// 1 MB Cache per core 
@@ -0,0 +1,40 @@
+# benchmark specification for block LU factorization; run it from the project root as
+#	./itbench samples/benchmarks/bluf.spec
+
+name=bluf
+
+# square matrix dimension lengths, parallelism, and the number of runs of each configuration
+sizes=512 1024 2048
+processes=1 2 4 8
+threads=1 2 4 8
+runs=3
+timeout=600
+
+# the input matrix is generated in binary for the parallel programs and converted to text for the sequential and
+# threaded references and the validator
+input.1=binary-array-generator 3 2 a ${size} ${size}
+input.2=binary-to-text a double a.txt
+
+# the IT program; the partition parameter is the block size of the factorization
+it.source=../segmented-memory/code/Block-LUF.it
+segmented.mapping=../segmented-memory/mapping/dummy-cluster/blu.map
+it.args=input_file=${data}/a output_file_1=u output_file_2=l output_file_3=p block_size=64
+
+# reference programs
+reference.seq.main=mainLUFC
+reference.seq.stdin=${data}/a.txt
+time.seq=Sequential Execution Time
+reference.mpi.main=mainMBluf
+reference.mpi.args=64 ${data}/a 0
+time.mpi=Execution time
+reference.pthread.main=mainTBluf
+reference.pthread.args=64 ${threads} brac
+reference.pthread.stdin=${data}/a.txt
+time.pthread=computation time
+
+# the validator repeats the block factorization of the input for as many iterations as there are blocks and compares
+# the result with the IT outputs; the matrix dimension length bounds the iteration count
+validator.main=mainPartLUFV
+validator.args=${size} 64
+validator.prepare=binary-to-text u double u.txt && binary-to-text l double l.txt && binary-to-text p int p.txt
+validator.stdin=${data}/a.txt|${run}/u.txt|${run}/l.txt|${run}/p.txt
@@ -0,0 +1,41 @@
+# benchmark specification for conjugate gradient over a CSR sparse matrix; run it from the project root as
+#	./itbench samples/benchmarks/cg.spec
+
+name=cg
+
+# sparse matrix dimension lengths, parallelism, and the number of runs of each configuration
+sizes=10000 20000 40000
+processes=1 2 4 8
+threads=1 2 4 8
+runs=3
+timeout=600
+
+# a 99% sparse matrix and the known and prediction vectors are generated in binary for the parallel programs and
+# converted to text for the sequential reference
+input.1=sparse-matrix-generator ${size} ${size} 99 3 1
+input.2=binary-array-generator 3 1 b ${size}
+input.3=binary-array-generator 3 1 x ${size}
+input.4=binary-to-text values double values.txt
+input.5=binary-to-text columns int columns.txt
+input.6=binary-to-text rows int rows.txt
+input.7=binary-to-text b double b.txt
+input.8=binary-to-text x double x.txt
+
+# the IT program; the partition parameter is the number of row blocks of the matrix
+it.source=../../compilers/new-segmented-backend/sample/code/CG-Single.it
+segmented.mapping=../../compilers/new-segmented-backend/sample/mapping/dummy-cluster/cg-single.map
+it.args=arg_matrix_cols=${data}/columns arg_matrix_rows=${data}/rows arg_matrix_values=${data}/values known_vector=${data}/b prediction_vector=${data}/x maxIterations=10 r=64
+
+# reference programs; all do 10 iterations without a convergence check
+reference.seq.main=mainCG
+reference.seq.args=10 0
+reference.seq.stdin=${data}/columns.txt|${data}/rows.txt|${data}/values.txt|${data}/b.txt|${data}/x.txt
+time.seq=Sequential Execution Time
+reference.mpi.main=mainMConjGrad
+reference.mpi.args=${data}/values ${data}/columns ${data}/rows ${data}/b ${data}/x 10 0
+time.mpi=Execution time
+reference.pthread.main=mainTConjGrad
+reference.pthread.args=${data}/values ${data}/columns ${data}/rows ${data}/b ${data}/x 10 ${threads} brac
+time.pthread=Execution Time
+
+# the IT program does not write the refined prediction vector, so its runs are not validated
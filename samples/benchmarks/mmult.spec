@@ -0,0 +1,42 @@
+# benchmark specification for block matrix-matrix multiplication; run it from the project root as
+#	./itbench samples/benchmarks/mmult.spec
+
+name=mmult
+
+# square matrix dimension lengths, parallelism, and the number of runs of each configuration
+sizes=512 1024 2048
+processes=1 2 4 8
+threads=1 2 4 8
+runs=3
+timeout=600
+
+# the input matrices are generated in binary for the parallel programs and converted to text for the sequential
+# reference and the validator
+input.1=binary-array-generator 3 2 a ${size} ${size}
+input.2=binary-array-generator 3 2 b ${size} ${size}
+input.3=binary-to-text a double a.txt
+input.4=binary-to-text b double b.txt
+
+# the IT program; partition parameters are the block sizes of the three matrices
+it.source=../segmented-memory/code/MM-Multiply.it
+segmented.mapping=../segmented-memory/mapping/dummy-cluster/mmm.map
+it.args=input_file_1=${data}/a input_file_2=${data}/b output_file=c k=64 l=64 q=64
+
+# reference programs
+reference.seq.main=mainBMMM
+reference.seq.args=64
+reference.seq.stdin=${data}/a.txt|${data}/b.txt
+time.seq=Sequential Execution Time
+reference.mpi.main=mainMMMult
+reference.mpi.args=64 ${data}/a ${data}/b 0
+time.mpi=Execution time
+reference.pthread.main=mainTMMM
+reference.pthread.args=a b 64 ${threads} brac
+reference.pthread.stdin=${data}/a.txt|${data}/b.txt
+time.pthread=PThreaded Execution Time
+
+# the validator recomputes the product from the inputs and compares it with the IT output
+validator.main=mainBMMMV
+validator.args=64
+validator.prepare=binary-to-text c double c.txt
+validator.stdin=${data}/a.txt|${data}/b.txt|${run}/c.txt
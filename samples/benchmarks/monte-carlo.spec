@@ -0,0 +1,30 @@
+# benchmark specification for Monte Carlo area estimation; run it from the project root as
+#	./itbench samples/benchmarks/monte-carlo.spec
+
+name=monte-carlo
+
+# grid dimension lengths in number of cells, parallelism, and the number of runs of each configuration
+sizes=256 512 1024
+processes=1 2 4 8
+threads=1 2 4 8
+runs=3
+timeout=600
+
+# the IT program; cells are 100 by 100 with 1000 sample points each and the partition parameter is the number of
+# row blocks of the grid
+it.source=../../compilers/new-segmented-backend/sample/code/Monte-Carlo-Simple.it
+segmented.mapping=../../compilers/new-segmented-backend/sample/mapping/dummy-cluster/monte-simple.map
+it.args=cell_length=100 grid_dim=${size} points_per_cell=1000 b=64
+
+# reference programs
+reference.seq.main=mainMonteCarlo
+reference.seq.args=100 ${size} 1000
+time.seq=Sequential Execution Time
+reference.mpi.main=mainMMonte
+reference.mpi.args=100 ${size} 1000
+time.mpi=Execution time
+reference.pthread.main=mainTMonteS
+reference.pthread.args=100 ${size} 1000 ${threads} brac
+time.pthread=execution time
+
+# the estimate depends on random sampling and is only printed, so the runs are not validated
@@ -0,0 +1,35 @@
+# benchmark specification for the five points stencil; run it from the project root as
+#	./itbench samples/benchmarks/stencil.spec
+
+name=stencil
+
+# square plate dimension lengths, parallelism, and the number of runs of each configuration
+sizes=512 1024 2048
+processes=1 2 4 8
+threads=1 2 4 8
+runs=3
+timeout=600
+
+# the input plate is generated in binary for the parallel programs and converted to text for the validator
+input.1=binary-array-generator 3 2 plate ${size} ${size}
+input.2=binary-to-text plate double plate.txt
+
+# the IT program; 100 refinements are done in 10 rounds of 10 iterations with the upper space padding of 10 rows
+# and the lower space padding of 5 rows and columns
+it.source=../segmented-memory/code/Stencil.it
+segmented.mapping=../segmented-memory/mapping/dummy-cluster/stencil.map
+it.args=input_file=${data}/plate output_file=plate_out iterations=100 p=8 k=2 l=2 m=10 n=5
+
+# reference programs; there is no sequential stencil reference so the stencil runs have no speedup baseline, and the
+# parallel references do padding number of iterations between synchronizations to match the IT program's 100
+reference.mpi.main=mainMStencil
+reference.mpi.args=${data}/plate 10 10 0
+time.mpi=Execution time
+reference.pthread.main=mainTStencil
+reference.pthread.args=${data}/plate 10 10 ${threads} brac
+time.pthread=Execution Time
+
+# the validator refines the initial plate sequentially and compares the result with the IT output
+validator.main=mainSV
+validator.prepare=binary-to-text plate_out double plate_out.txt
+validator.stdin=${data}/plate.txt|${run}/plate_out.txt|100
@@ -0,0 +1,19 @@
+# tuning specification for the Block LU Factorization sample; run it from the project root as
+#	./smtune samples/segmented-memory/code/Block-LUF.it samples/segmented-memory/tuning/bluf.spec
+
+# the number of MPI processes and the time limit for a single run in seconds
+processes=4
+timeout=120
+runs=2
+
+# maximum number of mapping configurations to compile and run
+max.candidates=8
+
+# estimated LPU counts of the LPSes used to prune mappings that leave PPUs idle
+lpu.hints=bluf.hints
+
+# arguments that do not change among runs; an input matrix of moderate size keeps the tuning short
+fixed.args=input_file=a output_file_1=u output_file_2=l output_file_3=p
+
+# partition arguments to be tuned
+tune.block_size=32 64 128
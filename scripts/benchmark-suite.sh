@@ -0,0 +1,378 @@
+#!/bin/bash
+
+# print the tool name and version
+echo "IT benchmark suite runner (version 1)"
+
+# keep track of the current directory
+current_dir=`pwd`
+
+# get the installer directory and associated subdirectories
+installer_dir=.
+config_dir=$installer_dir/config
+
+# the hand-written reference programs and the tools for generating their inputs
+validation_dir=$installer_dir/helper-projects/Validation
+tools_dir=$installer_dir/tools
+
+# validate that the user specified at least one benchmark specification file
+if [ "$#" -lt 1 ]; then
+	echo "Provide one or more benchmark specification files to run; optionally set the BENCHMARK_OUTPUT_DIR"
+	echo "environment variable to choose the directory for outputs and reports, the MPIRUN environment"
+	echo "variable to choose the MPI launcher, and the MPIRUN_ARGS environment variable to give the launcher"
+	echo "additional arguments (by default --oversubscribe is passed to an Open MPI launcher and nothing otherwise)"
+	echo ""
+	echo "A benchmark specification file has one 'key=value' property per line. Supported keys are"
+	echo "  name                  the name of the benchmark used in the reports"
+	echo "  sizes                 a space separated list of input sizes to run"
+	echo "  processes             a space separated list of MPI process counts (default 1)"
+	echo "  threads               a space separated list of thread counts for threaded references (default 1)"
+	echo "  runs                  the number of times each configuration should run (default 1)"
+	echo "  timeout               the maximum number of seconds a single run may take (default 300)"
+	echo "  input.<n>             commands generating the inputs of a size, run in the order of <n>"
+	echo "  it.source             the IT source code file"
+	echo "  segmented.mapping     mapping file for the segmented-memory compiler; no mapping skips the compiler"
+	echo "  segmented.threads     the number of threads each segmented-memory process runs (default 1)"
+	echo "  multicore.mapping     mapping file for the multicore compiler; no mapping skips the compiler"
+	echo "  multicore.threads     the number of threads the multicore executable runs (default 1)"
+	echo "  it.args               command line arguments of the IT executables"
+	echo "  reference.<type>.main the main function of the reference of a type (seq, mpi, pthread, openmp)"
+	echo "  reference.<type>.args command line arguments of the reference of a type"
+	echo "  reference.<type>.stdin '|' separated lines fed to the standard input of the reference of a type"
+	echo "  time.<variant>        the text on the output line reporting the running time of a variant"
+	echo "  validator.main        the main function of the validator of the benchmark"
+	echo "  validator.args        command line arguments of the validator"
+	echo "  validator.stdin       '|' separated lines fed to the standard input of the validator"
+	echo "  validator.prepare     a command run in the run directory before validation, e.g., to convert outputs"
+	echo "  validator.success     the text the validator prints on success (default 'validation successful')"
+	echo "  segmented.reference   the reference type segmented-memory runs are compared with (default mpi)"
+	echo "  multicore.reference   the reference type multicore runs are compared with (default pthread)"
+	echo ""
+	echo "In commands, arguments, and standard input lines \${size}, \${processes}, \${threads}, \${data}, and"
+	echo "\${run} are replaced with the input size, the process and thread counts, the input data directory,"
+	echo "and the run directory respectively. The tools directory is in the PATH of input generation and validation"
+	echo "preparation commands."
+	exit 1
+fi
+# MPI programs are launched with the local mpirun unless the MPIRUN environment variable names another launcher
+mpi_launcher=${MPIRUN:-mpirun}
+# process counts may exceed the core count of the machine; only Open MPI needs to be told to allow that and other
+# launchers reject its option, so the additional launcher arguments are configurable
+if [ -n "${MPIRUN_ARGS+set}" ]; then
+	mpi_launcher_args=$MPIRUN_ARGS
+elif $mpi_launcher --version 2>&1 | grep -q 'Open MPI'; then
+	mpi_launcher_args=--oversubscribe
+else
+	mpi_launcher_args=
+fi
+
+output_dir=${BENCHMARK_OUTPUT_DIR:-$current_dir/benchmark_`date +%s`}
+mkdir -p $output_dir
+output_dir=`readlink -f $output_dir`
+spec_files=()
+for spec in "$@"; do
+	if [ ! -f "$spec" ]; then
+		echo "benchmark specification '$spec' not found"
+		exit 1
+	fi
+	spec_files+=( `readlink -f $spec` )
+done
+
+# jump into the installation directory and resolve the directories the benchmarks depend on
+cd $installer_dir
+installer_dir=`pwd`
+validation_dir=`readlink -f $validation_dir`
+echo "Benchmark outputs directory: $output_dir"
+
+# the data generation and conversion tools are not kept executable in the repository; so use executable copies
+rm -rf $output_dir/tools
+cp -r $tools_dir $output_dir/tools
+chmod a+x $output_dir/tools/*
+tools_dir=$output_dir/tools
+
+# the reference programs are built in a copy of the validation project so that the source tree stays clean
+reference_dir=$output_dir/references
+rm -rf $reference_dir
+cp -r $validation_dir $reference_dir
+
+# every run is recorded in the results table; the summary tables are derived from it at the end
+results=$output_dir/results.csv
+echo "benchmark,variant,size,processes,threads,run,execution_time,validation" > $results
+
+# helper functions to read properties from the current benchmark specification file
+read_property() {
+	grep -v '^#' $spec | grep "^$1=" | head -1 | cut -d '=' -f2-
+}
+property_keys() {
+	grep -v '^#' $spec | grep "^$1" | cut -d '=' -f1 | sort -V
+}
+
+# relative paths in a specification are relative to the directory of the specification file
+resolve_path() {
+	if [ -z "$1" ]; then return; fi
+	(cd `dirname $spec` && readlink -f $1)
+}
+
+# replaces the placeholders of a command, argument list, or standard input template
+expand_template() {
+	echo "$1" | sed -e "s#\${size}#$size#g" -e "s#\${processes}#$process_count#g" \
+			-e "s#\${threads}#$thread_count#g" -e "s#\${data}#$data_dir#g" -e "s#\${run}#$run_dir#g"
+}
+
+# extracts the running time reported on the output lines having the argument text; when several processes report a
+# time the largest one is the running time of the program
+extract_time() {
+	grep "$1" $2 | sed -e "s#$1##" | while read line; do
+		echo "$line" | grep -oE '[0-9]+(\.[0-9]+)?([eE][-+]?[0-9]+)?' | head -1
+	done | sort -g | tail -1
+}
+
+# builds the reference program of a type having the argument main function into the argument executable
+build_reference() {
+	makefile=$1
+	main_function=$2
+	executable=$3
+	cd $reference_dir
+	make -f $makefile clean > /dev/null 2>&1
+	make -f $makefile MAIN=$main_function > $executable.log 2>&1
+	product=`grep '^COMPILER = ' $makefile | cut -d '=' -f2 | tr -d ' '`
+	if [ -f $product ]; then
+		mv $product $executable
+	fi
+	make -f $makefile clean > /dev/null 2>&1
+	cd $installer_dir
+}
+
+# runs the validator of the current benchmark in the current run directory and prints the validation status
+validate_run() {
+	if [ -z "$validator" ]; then
+		echo "not-validated"
+		return
+	fi
+	validator_args=`expand_template "$(read_property validator.args)"`
+	validator_stdin=`expand_template "$(read_property validator.stdin)" | tr '|' '\n'`
+	success_text=`read_property validator.success`
+	success_text=${success_text:-validation successful}
+	prepare_command=`expand_template "$(read_property validator.prepare)"`
+	if [ -n "$prepare_command" ]; then
+		( PATH=$tools_dir:$PATH eval "$prepare_command" ) > $run_dir/preparation.txt 2>&1
+	fi
+	( echo "$validator_stdin" | timeout $timeout_limit $validator $validator_args ) > $run_dir/validation.txt 2>&1
+	if grep -q "$success_text" $run_dir/validation.txt; then
+		echo "valid"
+	else
+		echo "invalid"
+	fi
+}
+
+# runs an executable for all runs of a configuration and records the outcomes in the results table
+run_variant() {
+	variant=$1
+	executable=$2
+	launcher=$3
+	arguments=$4
+	stdin_lines=$5
+	time_text=$6
+	validated=$7
+	for (( run=1; run<=runs; run++ )); do
+		run_dir=$output_dir/runs/$name/$variant/size-$size/p$process_count-t$thread_count/run-$run
+		mkdir -p $run_dir
+		cd $run_dir
+		run_args=`expand_template "$arguments"`
+		run_stdin=`expand_template "$stdin_lines" | tr '|' '\n'`
+		( echo "$run_stdin" | OMP_NUM_THREADS=$thread_count timeout $timeout_limit $launcher $executable $run_args ) \
+				> output.txt 2>&1
+		time=`extract_time "$time_text" output.txt`
+		cd $installer_dir
+		if [ -z "$time" ]; then
+			echo "$variant size $size processes $process_count threads $thread_count run $run: failed"
+			echo "$name,$variant,$size,$process_count,$thread_count,$run,failed," >> $results
+			continue
+		fi
+		validation="not-validated"
+		if [ "$validated" == "true" ]; then
+			validation=`cd $run_dir && validate_run`
+		fi
+		echo "$variant size $size processes $process_count threads $thread_count run $run: $time Seconds ($validation)"
+		echo "$name,$variant,$size,$process_count,$thread_count,$run,$time,$validation" >> $results
+	done
+}
+
+for spec in "${spec_files[@]}"; do
+	name=`read_property name`
+	name=${name:-`basename $spec .spec`}
+	sizes=`read_property sizes`
+	process_counts=`read_property processes`
+	process_counts=${process_counts:-1}
+	thread_counts=`read_property threads`
+	thread_counts=${thread_counts:-1}
+	runs=`read_property runs`
+	runs=${runs:-1}
+	timeout_limit=`read_property timeout`
+	timeout_limit=${timeout_limit:-300}
+	echo "--------------------------------------------------------------------------------------------------------"
+	echo "benchmark $name"
+	benchmark_dir=$output_dir/$name
+	mkdir -p $benchmark_dir
+
+	# build the IT executables; partition parameters are runtime arguments so a single executable serves all
+	# input sizes and, for the segmented-memory compiler, all process counts
+	it_src=`resolve_path "$(read_property it.source)"`
+	segmented_mapping=`resolve_path "$(read_property segmented.mapping)"`
+	multicore_mapping=`resolve_path "$(read_property multicore.mapping)"`
+	segmented_executable=""
+	multicore_executable=""
+	if [ -n "$segmented_mapping" ] && [ -x $installer_dir/smicc ]; then
+		segmented_executable=$benchmark_dir/segmented.o
+		$installer_dir/smicc $it_src $segmented_mapping $segmented_executable > $benchmark_dir/segmented.log 2>&1
+		[ -s $segmented_executable ] || { echo "segmented-memory compilation failed"; segmented_executable=""; }
+	fi
+	if [ -n "$multicore_mapping" ] && [ -x $installer_dir/micc ]; then
+		multicore_executable=$benchmark_dir/multicore.o
+		$installer_dir/micc $it_src $multicore_mapping $multicore_executable > $benchmark_dir/multicore.log 2>&1
+		[ -s $multicore_executable ] || { echo "multicore compilation failed"; multicore_executable=""; }
+	fi
+
+	# build the references and the validator of the benchmark
+	declare -A references=()
+	for type in seq mpi pthread openmp; do
+		main_function=`read_property reference.$type.main`
+		if [ -z "$main_function" ]; then continue; fi
+		case $type in
+			seq) makefile=Seq-Makefile;;
+			mpi) makefile=MPI-Makefile;;
+			pthread) makefile=Pthread-Makefile;;
+			openmp) makefile=OpenMP-Makefile;;
+		esac
+		build_reference $makefile $main_function $benchmark_dir/$type-ref
+		if [ -f $benchmark_dir/$type-ref ]; then
+			references[$type]=$benchmark_dir/$type-ref
+		else
+			echo "could not build the $type reference; check $benchmark_dir/$type-ref.log"
+		fi
+	done
+	validator=""
+	validator_main=`read_property validator.main`
+	if [ -n "$validator_main" ]; then
+		build_reference Validator-Makefile $validator_main $benchmark_dir/validator
+		if [ -f $benchmark_dir/validator ]; then
+			validator=$benchmark_dir/validator
+		else
+			echo "could not build the validator; check $benchmark_dir/validator.log"
+		fi
+	fi
+
+	for size in $sizes; do
+		# generate the inputs of the current size
+		data_dir=$benchmark_dir/data/size-$size
+		mkdir -p $data_dir
+		for key in `property_keys input.`; do
+			command=`expand_template "$(read_property $key)"`
+			( cd $data_dir && PATH=$tools_dir:$PATH eval "$command" ) > $data_dir/generation.log 2>&1
+		done
+
+		# the sequential reference is the baseline of speedup computation
+		process_count=1
+		thread_count=1
+		if [ -n "${references[seq]}" ]; then
+			run_variant seq ${references[seq]} "" "$(read_property reference.seq.args)" \
+					"$(read_property reference.seq.stdin)" "$(read_property time.seq)" false
+		fi
+
+		# segmented-memory IT executable and MPI reference runs over the process counts
+		for process_count in $process_counts; do
+			launcher="$mpi_launcher -n $process_count $mpi_launcher_args"
+			if [ -n "$segmented_executable" ]; then
+				thread_count=`read_property segmented.threads`
+				thread_count=${thread_count:-1}
+				time_text=`read_property time.segmented`
+				run_variant segmented $segmented_executable "$launcher" "$(read_property it.args)" "" \
+						"${time_text:-Parallel Execution Time}" true
+			fi
+			thread_count=1
+			if [ -n "${references[mpi]}" ]; then
+				run_variant mpi ${references[mpi]} "$launcher" "$(read_property reference.mpi.args)" \
+						"$(read_property reference.mpi.stdin)" "$(read_property time.mpi)" false
+			fi
+		done
+
+		# multicore IT executable runs with the thread count fixed by its mapping
+		process_count=1
+		if [ -n "$multicore_executable" ]; then
+			thread_count=`read_property multicore.threads`
+			thread_count=${thread_count:-1}
+			time_text=`read_property time.multicore`
+			run_variant multicore $multicore_executable "" "$(read_property it.args)" "" \
+					"${time_text:-Parallel Execution Time}" true
+		fi
+
+		# threaded references run over the thread counts
+		for thread_count in $thread_counts; do
+			for type in pthread openmp; do
+				if [ -z "${references[$type]}" ]; then continue; fi
+				run_variant $type ${references[$type]} "" "$(read_property reference.$type.args)" \
+						"$(read_property reference.$type.stdin)" "$(read_property time.$type)" false
+			done
+		done
+	done
+
+	# record which reference each IT variant is compared with in the summary
+	segmented_reference=`read_property segmented.reference`
+	multicore_reference=`read_property multicore.reference`
+	echo "$name,segmented,${segmented_reference:-mpi}" >> $output_dir/comparisons.csv
+	echo "$name,multicore,${multicore_reference:-pthread}" >> $output_dir/comparisons.csv
+	unset references
+done
+cd $current_dir
+
+# Summarize the runs: the average time of each configuration, the speedup over the sequential reference of the same
+# size, the parallel efficiency over all processes and threads, and the ratio of the time of the matching parallel
+# reference with the same process and thread counts to that of the IT executable (greater than 1 means IT is faster).
+summary=$output_dir/summary.csv
+touch $output_dir/comparisons.csv
+awk -F',' -v summaryFile=$summary -v jsonFile=$output_dir/summary.json '
+	FILENAME ~ /comparisons.csv$/ { compared[$1 "," $2] = $3; next }
+	FNR == 1 { next }
+	$7 != "failed" {
+		key = $1 "," $2 "," $3 "," $4 "," $5
+		if (!(key in count)) order[++keys] = key
+		total[key] += $7; count[key]++
+		if ($8 == "invalid") invalid[key] = 1
+		else if ($8 == "valid" && !(key in invalid)) valid[key] = 1
+	}
+	END {
+		print "benchmark,variant,size,processes,threads,average_time,speedup,efficiency,reference_ratio,validation" > summaryFile
+		printf "[" > jsonFile
+		for (i = 1; i <= keys; i++) {
+			key = order[i]; split(key, f, ",")
+			average = total[key] / count[key]
+			seqKey = f[1] "," "seq" "," f[3] ",1,1"
+			speedup = ""; efficiency = ""; ratio = ""
+			if (seqKey in count && average > 0) {
+				speedup = (total[seqKey] / count[seqKey]) / average
+				efficiency = speedup / (f[4] * f[5])
+			}
+			reference = compared[f[1] "," f[2]]
+			if (reference != "") {
+				referenceKey = f[1] "," reference "," f[3] "," f[4] "," f[5]
+				if (reference == "pthread" || reference == "openmp") {
+					referenceKey = f[1] "," reference "," f[3] ",1," (f[4] * f[5])
+				}
+				if (referenceKey in count && average > 0) {
+					ratio = (total[referenceKey] / count[referenceKey]) / average
+				}
+			}
+			validation = (key in invalid) ? "invalid" : ((key in valid) ? "valid" : "not-validated")
+			print key "," average "," speedup "," efficiency "," ratio "," validation > summaryFile
+			printf "%s\n  {\"benchmark\": \"%s\", \"variant\": \"%s\", \"size\": %s, \"processes\": %s, \"threads\": %s, ", \
+					(i > 1) ? "," : "", f[1], f[2], f[3], f[4], f[5] > jsonFile
+			printf "\"average_time\": %s, \"speedup\": %s, \"efficiency\": %s, \"reference_ratio\": %s, ", \
+					average, (speedup == "") ? "null" : speedup, (efficiency == "") ? "null" : efficiency, \
+					(ratio == "") ? "null" : ratio > jsonFile
+			printf "\"validation\": \"%s\"}", validation > jsonFile
+		}
+		print "\n]" > jsonFile
+	}' $output_dir/comparisons.csv $results
+
+echo "--------------------------------------------------------------------------------------------------------"
+echo "all runs are in the table: $results"
+echo "the summary of speedup and efficiency is in: $summary and $output_dir/summary.json"
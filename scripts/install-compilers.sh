@@ -33,8 +33,9 @@ cd $installer_dir
 # if multicore compiler has been installed then create a compiler script for it in the current directory
 if [ "$multicore_enabled" == "true" ]; then
 	# also set up the installer directory in the copied script as an absolute path so that the script can be run from anywhere
-	replacement_expr="s#installer_dir=.#installer_dir=$installer_dir#g"
-	cat scripts/multicore-compiler.sh  | sed -e $replacement_expr > micc
+	# (only the line that is exactly 'installer_dir=.' is replaced; scripts may reassign the variable later on)
+	replacement_expr="s#^installer_dir=\.\$#installer_dir=$installer_dir#"
+	cat scripts/multicore-compiler.sh  | sed -e "$replacement_expr" > micc
 	chmod a+x micc
 	echo "The generated IT multicore compiler is: micc"
 fi
@@ -64,9 +65,28 @@ cd $installer_dir
 # if segmented-memory compiler has been installed then create a compiler script for it in the current directory
 if [ "$segmented_enabled" == "true" ]; then
 	# also set up the installer directory in the copied script as an absolute path so that the script can be run from anywhere
-	replacement_expr="s#installer_dir=.#installer_dir=$installer_dir#g"
-	cat scripts/segmented-memory-compiler.sh  | sed -e $replacement_expr > smicc
+	replacement_expr="s#^installer_dir=\.\$#installer_dir=$installer_dir#"
+	cat scripts/segmented-memory-compiler.sh  | sed -e "$replacement_expr" > smicc
 	chmod a+x smicc
 	echo "The generated IT segmented memory compiler is: smicc"
+	# the mapping and partition autotuner uses the segmented-memory compiler; so install it alongside
+	cat scripts/segmented-memory-autotuner.sh  | sed -e "$replacement_expr" > smtune
+	chmod a+x smtune
+	echo "The generated IT segmented memory autotuner is: smtune"
 fi
 
+
+# the benchmark suite runner compares executables of whichever compilers have been installed with the hand-written
+# reference programs; so install it after the compilers
+if [ "$multicore_enabled" == "true" ] || [ "$segmented_enabled" == "true" ]; then
+	replacement_expr="s#^installer_dir=\.\$#installer_dir=$installer_dir#"
+	cat scripts/benchmark-suite.sh  | sed -e "$replacement_expr" > itbench
+	chmod a+x itbench
+	echo "The generated IT benchmark suite runner is: itbench"
+fi
+
+# the machine model discovery script does not depend on any compiler; so it is always installed
+replacement_expr="s#^installer_dir=\.\$#installer_dir=$installer_dir#"
+cat scripts/pcubes-discover.sh  | sed -e "$replacement_expr" > pcubes-discover
+chmod a+x pcubes-discover
+echo "The generated PCubeS machine model discovery script is: pcubes-discover"
@@ -0,0 +1,463 @@
+#!/bin/bash
+
+# print the tool name and version
+echo "IT PCubeS machine model discovery (version 1)"
+
+# keep track of the current directory
+current_dir=`pwd`
+
+# get the installer directory; the probe program source is kept with the other helper programs
+installer_dir=.
+probe_source=$installer_dir/helper-projects/Experiments/PCubeSProbe.cpp
+
+# read the options
+node_count=0
+run_probes=false
+probe_compiler=c++
+while getopts "n:pc:" option; do
+	case $option in
+		n) node_count=$OPTARG ;;
+		p) run_probes=true ;;
+		c) probe_compiler=$OPTARG ;;
+		*) node_count=-1 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+# validate that the user specified a name for the machine model
+if [ "$#" -lt 1 ] || [ "$node_count" -lt 0 ]; then
+	echo "The name of the machine model is mandatory to run the discovery"
+	echo "Optionally, you can specify a directory for the model files as the second parameter"
+	echo ""
+	echo "The tool writes a PCubeS description <name>.ml and a core numbering file <name>.cn for the machine"
+	echo "it is run on. Supported options are"
+	echo "  -n <nodes>     describe a cluster of that many identical nodes instead of a single machine; run"
+	echo "                 the tool on one of the nodes"
+	echo "  -p             run short bandwidth, latency, and compute throughput probes and record the results"
+	echo "                 as space attributes and PPU weights"
+	echo "  -c <compiler>  the C++ compiler used to build the probes (default c++)"
+	exit 1
+fi
+model_name=$1
+output_dir=$current_dir
+if [ "$#" -gt 1 ]; then
+	output_dir=$2
+fi
+mkdir -p $output_dir
+output_dir=`readlink -f $output_dir`
+pcubes=$output_dir/$model_name.ml
+cores=$output_dir/$model_name.cn
+work_dir=`mktemp -d`
+trap "rm -rf $work_dir" EXIT
+
+# use hwloc to identify the containers of each processor when it is present and sysfs otherwise
+cpu_dir=/sys/devices/system/cpu
+use_hwloc=false
+if command -v hwloc-calc > /dev/null 2>&1; then
+	use_hwloc=true
+	echo "reading the topology using hwloc"
+else
+	echo "reading the topology from sysfs"
+fi
+
+# a helper function to get the first processor in a sysfs processor list such as '0-3,8-11'; the first processor
+# identifies a group of processors and also orders groups the way the hardware numbers them
+first_cpu() {
+	echo ${1%%[-,]*}
+}
+
+# a helper function to read the size and processor list of the cache of a particular level of a processor
+read_cache() {
+	for cache in $cpu_dir/cpu$1/cache/index*; do
+		[ -f $cache/level ] || continue
+		[ `cat $cache/level` == "$2" ] || continue
+		[ `cat $cache/type` != "Instruction" ] || continue
+		echo "`cat $cache/size` `cat $cache/shared_cpu_list`"
+		return
+	done
+}
+
+# a helper function to get the index of the hwloc object of a type containing a processor
+hwloc_container() {
+	hwloc-calc --pi pu:$1 --intersect $2 2> /dev/null | cut -d ',' -f1
+}
+
+# gather a table having one row per online processor listing the identifiers of its package, NUMA node, L3 and L2
+# cache, and core; a '-' says the processor has no such container
+processor_table=$work_dir/processors.txt
+> $processor_table
+declare -A level_sizes
+for cpu_path in $cpu_dir/cpu[0-9]*; do
+	cpu=${cpu_path##*cpu}
+	if [ -f $cpu_path/online ] && [ `cat $cpu_path/online` == "0" ]; then continue; fi
+	[ -d $cpu_path/topology ] || continue
+
+	package=`cat $cpu_path/topology/physical_package_id`
+	core_id=`cat $cpu_path/topology/core_id`
+	if [ -f $cpu_path/topology/core_cpus_list ]; then
+		core=`first_cpu $(cat $cpu_path/topology/core_cpus_list)`
+	else
+		core=`first_cpu $(cat $cpu_path/topology/thread_siblings_list)`
+	fi
+	numa=-
+	numa_size=""
+	for node_path in $cpu_path/node[0-9]*; do
+		[ -e $node_path ] || continue
+		numa=`first_cpu $(cat $node_path/cpulist)`
+		numa_size=`grep MemTotal $node_path/meminfo | awk '{print $4}'`K
+	done
+	l3=-
+	l2=-
+	cache=`read_cache $cpu 3`
+	if [ -n "$cache" ]; then
+		l3=`first_cpu ${cache#* }`
+		l3_size=${cache%% *}
+	fi
+	cache=`read_cache $cpu 2`
+	if [ -n "$cache" ]; then
+		l2=`first_cpu ${cache#* }`
+		l2_size=${cache%% *}
+	fi
+	l1_size=""
+	cache=`read_cache $cpu 1`
+	if [ -n "$cache" ]; then
+		l1_size=${cache%% *}
+	fi
+
+	# hwloc knows about the containers sysfs may not expose properly, e.g., in virtual machines; its logical
+	# indexes follow the hardware order just like the first processor of a sysfs group does
+	if [ "$use_hwloc" == "true" ]; then
+		for container in Package NUMANode L3Cache L2Cache Core; do
+			index=`hwloc_container $cpu $container`
+			[ -n "$index" ] || continue
+			case $container in
+				Package) package=$index ;;
+				NUMANode) numa=$index ;;
+				L3Cache) l3=$index ;;
+				L2Cache) l2=$index ;;
+				Core) core=$index ;;
+			esac
+		done
+	fi
+	[ -n "$numa_size" ] && level_sizes[numa.$numa]=$numa_size
+	[ "$l3" != "-" ] && level_sizes[l3.$l3]=$l3_size
+	[ "$l2" != "-" ] && level_sizes[l2.$l2]=$l2_size
+	[ -n "$l1_size" ] && level_sizes[core.$core]=$l1_size
+	echo "$cpu $package $numa $l3 $l2 $core $core_id" >> $processor_table
+done
+if [ ! -s $processor_table ]; then
+	echo "could not read the processor topology"
+	exit 1
+fi
+
+# Determine which containers form spaces of the PCubeS hierarchy. A PCubeS description needs all PPUs of a space to
+# have the same structure below them. So a container level is kept only if its groups nest within the groups of the
+# previously kept level and all groups have the same number of processors. Further, packages and cores are kept only
+# if there are multiple of them under each parent; NUMA nodes and caches are kept even then for their memories. The
+# levels that fail the check, e.g., the core and L2 cache levels of a processor having both dual-threaded
+# performance cores and single-threaded efficiency cores, are left out and their processors become direct children
+# of the closest kept level. The processors are then listed in the order of the kept hierarchy.
+awk -v levels="Package NUMA-Node L3-Cache L2-Cache Core" '
+{
+	rows++
+	cpu[rows] = $1
+	for (l = 1; l <= 5; l++) key[rows, l] = $(l + 1)
+	parent[rows] = ""
+}
+END {
+	split(levels, names, " ")
+	for (l = 1; l <= 5; l++) {
+		delete owner; delete members; delete groups; delete groupCount
+		valid = 1
+		for (r = 1; r <= rows; r++) {
+			k = key[r, l]
+			if (k == "-") { valid = 0; break }
+			if ((k in owner) && owner[k] != parent[r]) { valid = 0; break }
+			owner[k] = parent[r]
+			members[k]++
+			if (!((parent[r], k) in groups)) {
+				groups[parent[r], k] = 1
+				groupCount[parent[r]]++
+			}
+		}
+		if (!valid) continue
+		units = -1
+		for (p in groupCount) {
+			if (units == -1) units = groupCount[p]
+			else if (groupCount[p] != units) valid = 0
+		}
+		size = -1
+		for (k in members) {
+			if (size == -1) size = members[k]
+			else if (members[k] != size) valid = 0
+		}
+		if (!valid || (units < 2 && (names[l] == "Package" || names[l] == "Core"))) continue
+		print "level", names[l], units, key[1, l] > "/dev/stderr"
+		for (r = 1; r <= rows; r++) {
+			parent[r] = parent[r] "/" key[r, l]
+			sortKey[r] = sortKey[r] sprintf("%08d", key[r, l])
+		}
+	}
+
+	# all processors should have the same number of siblings under their closest kept level
+	delete leafCount
+	for (r = 1; r <= rows; r++) leafCount[parent[r]]++
+	leaves = -1
+	for (p in leafCount) {
+		if (leaves == -1) leaves = leafCount[p]
+		else if (leafCount[p] != leaves) {
+			print "error", "the processors are not evenly distributed in the hardware hierarchy" > "/dev/stderr"
+			exit 1
+		}
+	}
+	print "leaf", leaves > "/dev/stderr"
+	for (r = 1; r <= rows; r++) {
+		printf "%s%08d%08d %s %s\n", sortKey[r], key[r, 5], cpu[r], cpu[r], parent[r]
+	}
+}' $processor_table 2> $work_dir/levels.txt | sort | awk '{print $2, $3}' > $work_dir/order.txt
+if grep -q '^error' $work_dir/levels.txt; then
+	grep '^error' $work_dir/levels.txt | cut -d ' ' -f2-
+	exit 1
+fi
+leaf_units=`grep '^leaf' $work_dir/levels.txt | awk '{print $2}'`
+ordered_cpus=`awk '{print $1}' $work_dir/order.txt`
+first_cpu=`echo $ordered_cpus | awk '{print $1}'`
+
+# the processors under the first PPU of the lowest kept level; PPU weights are determined from these processors
+first_group=`awk 'NR == 1 {group = $2} $2 == group {print $1}' $work_dir/order.txt`
+
+# a helper function to convert sizes such as '48K' or '2048K' into the attribute format used in the description
+format_size() {
+	local kilobytes=${1%K}
+	if [ $((kilobytes % (1024 * 1024))) -eq 0 ] || [ $kilobytes -ge $((16 * 1024 * 1024)) ]; then
+		echo "$(( (kilobytes + 512 * 1024) / (1024 * 1024) ))GB"
+	elif [ $((kilobytes % 1024)) -eq 0 ] || [ $kilobytes -ge $((16 * 1024)) ]; then
+		echo "$(( (kilobytes + 512) / 1024 ))MB"
+	else
+		echo "${kilobytes}KB"
+	fi
+}
+
+# build the probe program if the user wants measurements
+probe=""
+if [ "$run_probes" == "true" ]; then
+	probe=$work_dir/pcubes-probe
+	cd $current_dir && cd $installer_dir
+	$probe_compiler -O2 -pthread -o $probe $probe_source
+	cd $current_dir
+	if [ ! -x $probe ]; then
+		echo "could not build the probes; continuing without measurements"
+		probe=""
+	fi
+fi
+
+# a helper function to generate the bandwidth and latency attributes of a memory of a particular size; the probe
+# uses half of a cache so that the data stays in the cache, and a buffer several times larger than the last level
+# cache for main memory
+probe_attributes() {
+	[ -n "$probe" ] || return
+	local bytes=$(( ${1%K} * 1024 / 2 ))
+	if [ "$2" == "memory" ]; then
+		bytes=$(( 256 * 1024 * 1024 ))
+	fi
+	local bandwidth=`$probe bandwidth $bytes $first_cpu`
+	local latency=`$probe latency $bytes $first_cpu`
+	printf "<bandwidth=%.1f><latency=%.1f>" $bandwidth $latency
+}
+
+# Determine the relative weights of the processors under a lowest level PPU. The kernel reports the capacities of
+# asymmetric processors on some platforms; otherwise only the throughput probe can tell the processors apart. The
+# probe keeps all processors busy at the same time as that is how they run the threads of an IT program.
+weights=""
+declare -A capacity
+if [ -n "$probe" ]; then
+	echo "measuring the compute throughput of the processors"
+	values=( `$probe throughput $ordered_cpus` )
+	index=0
+	for cpu in $ordered_cpus; do
+		capacity[$cpu]=${values[$index]}
+		index=$((index + 1))
+	done
+elif [ -f $cpu_dir/cpu$first_cpu/cpu_capacity ]; then
+	for cpu in $ordered_cpus; do
+		capacity[$cpu]=`cat $cpu_dir/cpu$cpu/cpu_capacity`
+	done
+fi
+if [ ${#capacity[@]} -gt 0 ]; then
+	maximum=0
+	for cpu in $first_group; do
+		[ ${capacity[$cpu]} -gt $maximum ] && maximum=${capacity[$cpu]}
+	done
+	# weights are scaled to the range 1 to 10 as measurements rarely differentiate processors more finely than
+	# that; consecutive processors having the same weight are listed as a 'weight*repetition' entry
+	entries=()
+	previous=""
+	repetition=0
+	for cpu in $first_group; do
+		weight=$(( (capacity[$cpu] * 10 + maximum / 2) / maximum ))
+		[ $weight -ge 1 ] || weight=1
+		if [ "$weight" == "$previous" ]; then
+			repetition=$((repetition + 1))
+		else
+			[ -n "$previous" ] && entries+=( "$previous*$repetition" )
+			previous=$weight
+			repetition=1
+		fi
+	done
+	entries+=( "$previous*$repetition" )
+
+	# weights sharing a common factor are reduced to keep the description readable
+	divisor=0
+	for entry in "${entries[@]}"; do
+		a=${entry%\**}
+		b=$divisor
+		while [ $b -ne 0 ]; do
+			t=$((a % b))
+			a=$b
+			b=$t
+		done
+		divisor=$a
+	done
+	for (( i=0; i<${#entries[@]}; i++ )); do
+		entry=${entries[$i]}
+		entries[$i]="$(( ${entry%\**} / divisor ))*${entry#*\*}"
+	done
+	if [ ${#entries[@]} -gt 1 ]; then
+		weights="{`printf '%s, ' "${entries[@]}" | sed -e 's/, $//'`}"
+	fi
+fi
+
+# determine the spaces of the description from top to bottom
+space_names=()
+space_units=()
+space_attrs=()
+space_comments=()
+total_memory=`grep MemTotal /proc/meminfo | awk '{print $2}'`K
+if [ "$node_count" -gt 0 ]; then
+	space_names+=( "Cluster" )
+	space_units+=( 1 )
+	space_attrs+=( "" )
+	space_comments+=( "" )
+	space_names+=( "Node" )
+	space_units+=( $node_count )
+	space_attrs+=( "<unit><segment><memory=`format_size $total_memory`>`probe_attributes $total_memory memory`" )
+	space_comments+=( "`format_size $total_memory` RAM in each node" )
+else
+	space_names+=( "Node" )
+	space_units+=( 1 )
+	space_attrs+=( "<memory=`format_size $total_memory`>`probe_attributes $total_memory memory`" )
+	space_comments+=( "`format_size $total_memory` RAM" )
+fi
+core_level_kept=false
+
+# in a single machine, memory segmentation happens at the NUMA nodes if there are more than one of them
+numa_count=`awk '{print $3}' $processor_table | sort -u | wc -l`
+while read -r tag name units first; do
+	[ "$tag" == "level" ] || continue
+	attrs=""
+	comment=""
+	case $name in
+		NUMA-Node)
+			size=${level_sizes[numa.$first]}
+			[ "$node_count" -gt 0 ] || [ "$numa_count" -lt 2 ] || attrs="<segment>"
+			if [ -n "$size" ]; then
+				attrs="$attrs<memory=`format_size $size`>`probe_attributes $size memory`"
+				comment="`format_size $size` RAM per NUMA node"
+			fi ;;
+		L3-Cache)
+			size=${level_sizes[l3.$first]}
+			attrs="<memory=`format_size $size`>`probe_attributes $size cache`"
+			comment="`format_size $size` L3 cache" ;;
+		L2-Cache)
+			size=${level_sizes[l2.$first]}
+			attrs="<memory=`format_size $size`>`probe_attributes $size cache`"
+			comment="`format_size $size` L2 cache" ;;
+		Core)
+			core_level_kept=true
+			size=${level_sizes[core.$first]}
+			if [ -n "$size" ]; then
+				attrs="<memory=`format_size $size`>`probe_attributes $size cache`"
+				comment="`format_size $size` L1 data cache per core"
+			fi ;;
+	esac
+	space_names+=( "$name" )
+	space_units+=( $units )
+	space_attrs+=( "$attrs" )
+	space_comments+=( "$comment" )
+done < $work_dir/levels.txt
+
+# The processors under the lowest kept level form the core space that threads are pinned to. If the core level is
+# kept then these are hardware threads; otherwise they are called cores like in the hand-written descriptions.
+if [ "$leaf_units" -gt 1 ]; then
+	if [ "$core_level_kept" == "true" ]; then
+		space_names+=( "Hardware-Thread" )
+		space_attrs+=( "<core>" )
+		space_comments+=( "" )
+	else
+		space_names+=( "Core" )
+		size=${level_sizes[core.$(awk -v cpu=$first_cpu '$1 == cpu {print $6}' $processor_table)]}
+		if [ -n "$size" ] && [ -z "$weights" ]; then
+			space_attrs+=( "<core><memory=`format_size $size`>`probe_attributes $size cache`" )
+			space_comments+=( "`format_size $size` L1 data cache per core" )
+		elif [ -n "$weights" ]; then
+			space_attrs+=( "<core>" )
+			space_comments+=( "processors of different capabilities are weighted" )
+		else
+			space_attrs+=( "<core>" )
+			space_comments+=( "" )
+		fi
+	fi
+	space_units+=( $leaf_units )
+else
+	last=$(( ${#space_attrs[@]} - 1 ))
+	space_attrs[$last]="<core>${space_attrs[$last]}"
+fi
+if [ -z "$weights" ] || [ "$leaf_units" -le 1 ]; then
+	weights=""
+fi
+space_count=${#space_names[@]}
+if [ $space_count -gt 9 ]; then
+	echo "the hardware hierarchy is too deep for a PCubeS description"
+	exit 1
+fi
+
+# write the PCubeS description
+model=`grep "model name" /proc/cpuinfo | head -1 | cut -d ':' -f2 | sed -e 's/^ //'`
+{
+	echo "// PCubeS Description of $model"
+	echo "// total memory: `format_size $total_memory`"
+	echo "// generated by pcubes-discover on `hostname` at `date`"
+	if [ -n "$probe" ]; then
+		echo "// bandwidth attributes are in GB/s and latency attributes are in nanoseconds"
+	fi
+	echo ""
+	echo "//--------------------------------------------------------------------------------------"
+	echo "//Space #Number : 	\$Space-Name	(#PPU-Count)	// Comment"
+	echo "//--------------------------------------------------------------------------------------"
+	for (( i=0; i<space_count; i++ )); do
+		space_no=$((space_count - i))
+		ppu_count="(${space_units[$i]})"
+		if [ $i -eq $((space_count - 1)) ] && [ -n "$weights" ]; then
+			ppu_count="$ppu_count $weights"
+		fi
+		comment=""
+		[ -n "${space_comments[$i]}" ] && comment="// ${space_comments[$i]}"
+		printf "Space %d%s:\t%-16s%-24s%s\n" $space_no "${space_attrs[$i]}" "${space_names[$i]}" \
+			"$ppu_count" "$comment"
+	done
+} > $pcubes
+
+# write the core numbering file listing the processors in the order of the PPUs of the core space
+> $cores
+for cpu in $ordered_cpus; do
+	physical_id=`awk -v cpu=$cpu '$1 == cpu {print $2}' $processor_table`
+	core_id=`awk -v cpu=$cpu '$1 == cpu {print $7}' $processor_table`
+	if [ "$use_hwloc" == "true" ]; then
+		physical_id=`cat $cpu_dir/cpu$cpu/topology/physical_package_id`
+	fi
+	printf "processor\t: %d\tphysical id\t: %d\tcore id\t\t: %d\n" $cpu $physical_id $core_id >> $cores
+done
+
+echo "PCubeS description ($pcubes):"
+cat $pcubes
+echo "Core numbering file: $cores"
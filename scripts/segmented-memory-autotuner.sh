@@ -0,0 +1,195 @@
+#!/bin/bash
+
+# print the tool name and version
+echo "IT segmented-memory mapping and partition autotuner (version 1)"
+
+# keep track of the current directory
+current_dir=`pwd`
+
+# get the installer directory and associated subdirectories
+installer_dir=.
+config_dir=$installer_dir/config
+
+# segmented memory compiler directory and executable
+segmented_memory_compiler_dir=$installer_dir/compilers/new-segmented-backend/
+segmented_memory_compiler=./sicc
+
+# validate that the user specified the source program and the tuning specification file
+if [ "$#" -lt 2 ]; then
+	echo "Two arguments are mandatory to run the autotuner"
+	echo "1. the IT source code file"
+	echo "2. the tuning specification file"
+	echo "Optionally, you can specify a directory for tuning outputs as the third parameter"
+	echo ""
+	echo "The tuning specification file has one 'key=value' property per line. Supported keys are"
+	echo "  processes       the number of MPI processes to run each candidate with (default 1)"
+	echo "  mpirun.args     additional arguments of mpirun (default --oversubscribe for Open MPI, none otherwise)"
+	echo "  timeout         the maximum number of seconds a single run may take (default 300)"
+	echo "  runs            the number of times each candidate should run (default 1)"
+	echo "  max.candidates  the maximum number of mapping candidates to try (default 16)"
+	echo "  lpu.hints       a file estimating the LPU counts of LPSes or the partition argument values of"
+	echo "                  tasks for pruning and ranking mappings"
+	echo "  fixed.args      command line arguments passed unchanged to all runs; use these to"
+	echo "                  bound the iteration count of the program during tuning"
+	echo "  tune.<arg>      a space separated list of values to try for the program argument <arg>"
+	exit 1
+fi
+src_code=$1
+spec_file=$2
+output_dir=$current_dir/tuning_`date +%s`
+if [ "$#" -gt 2 ]; then
+	output_dir=$3
+fi
+if [ ! -f "$src_code" ]; then
+	echo "IT source '$src_code' not found"
+	exit 1
+fi
+if [ ! -f "$spec_file" ]; then
+	echo "Tuning specification '$spec_file' not found"
+	exit 1
+fi
+mkdir -p $output_dir
+src=`readlink -f $src_code`
+spec=`readlink -f $spec_file`
+output_dir=`readlink -f $output_dir`
+
+# a helper function to read a property from the tuning specification file
+read_property() {
+	grep -v '^#' $spec | grep "^$1=" | head -1 | cut -d '=' -f2-
+}
+processes=`read_property processes`
+processes=${processes:-1}
+timeout_limit=`read_property timeout`
+timeout_limit=${timeout_limit:-300}
+runs=`read_property runs`
+runs=${runs:-1}
+max_candidates=`read_property max.candidates`
+max_candidates=${max_candidates:-16}
+lpu_hints=`read_property lpu.hints`
+if [ -n "$lpu_hints" ]; then
+	lpu_hints=`cd $(dirname $spec) && readlink -f $lpu_hints`
+fi
+fixed_args=`read_property fixed.args`
+# the process count may exceed the core count of the machine; only Open MPI needs to be told to allow that and other
+# launchers reject its option
+if grep -v '^#' $spec | grep -q '^mpirun\.args='; then
+	mpirun_args=`read_property mpirun.args`
+elif mpirun --version 2>&1 | grep -q 'Open MPI'; then
+	mpirun_args=--oversubscribe
+else
+	mpirun_args=
+fi
+
+# generate the cartesian product of the values of all tunable program arguments; each entry in the
+# argument configurations list is a space separated set of key=value pairs
+arg_configs=( "" )
+for tunable in `grep -v '^#' $spec | grep '^tune\.' | cut -d '=' -f1`; do
+	arg_name=${tunable#tune.}
+	arg_values=`read_property $tunable`
+	extended_configs=()
+	for config in "${arg_configs[@]}"; do
+		for value in $arg_values; do
+			extended_configs+=( "$config $arg_name=$value" )
+		done
+	done
+	arg_configs=( "${extended_configs[@]}" )
+done
+
+# jump into the installation directory
+cd $installer_dir
+
+# retrieve the hardware description files' location
+machine_model_dir=`cat ${config_dir}/executable.properties | grep 'segmented.memory.machine.model.dir' | cut -d '=' -f2`
+pcubes=`readlink -f $(ls ${machine_model_dir}/*.ml)`
+cores=`readlink -f $(ls ${machine_model_dir}/*.cn)`
+echo "IT source code: $src"
+echo "PCubes description file: $pcubes"
+echo "Core numbering file: $cores"
+echo "Tuning outputs directory: $output_dir"
+
+# determine the backend C++ compiler and optimization flags just like the compiler script does
+segmented_c=`cat ${config_dir}/compiler.properties | grep 'segmented.memory.backend.c.compiler' | cut -d '=' -f2`
+c_opt_flags=`cat ${config_dir}/executable.properties | grep 'c.optimization.flags' | cut -d '=' -f2`
+
+# let the compiler enumerate valid mappings consistent with the PCubeS description and prune them
+echo "enumerating mapping candidates"
+candidates_dir=$output_dir/candidates
+cd $segmented_memory_compiler_dir
+${segmented_memory_compiler} --enumerate-mappings $src $pcubes $candidates_dir $max_candidates $lpu_hints \
+	> $output_dir/enumeration.log
+if [ ! -f $candidates_dir/candidates.txt ]; then
+	echo "mapping enumeration failed; check $output_dir/enumeration.log"
+	exit 1
+fi
+
+# the results table has one row per candidate mapping and argument configuration pair
+results=$output_dir/results.csv
+echo "mapping,estimated_cost,arguments,run,execution_time" > $results
+
+best_time=""
+best_mapping=""
+best_args=""
+while read -r candidate_line; do
+	mapping_file=`echo "$candidate_line" | cut -f1`
+	estimated_cost=`echo "$candidate_line" | cut -f2`
+	candidate=${mapping_file%.map}
+	echo "--------------------------------------------------------------------------------------------------------"
+	echo "candidate $candidate (estimated cost $estimated_cost)"
+	cat $candidates_dir/$mapping_file
+
+	# compile the candidate mapping once; partition arguments are runtime parameters so all argument
+	# configurations can use the same executable
+	build_dir=tune_`date +%s`_$candidate
+	executable=$output_dir/$candidate.o
+	${segmented_memory_compiler} $src $pcubes $cores $candidates_dir/$mapping_file $build_dir > /dev/null
+	make -f MakeFile-Executable C_COMPILER=$segmented_c EXECUTABLE=$executable \
+		BUILD_SUBDIR=$build_dir C_OPT_FLAGS="$c_opt_flags" > /dev/null 2>&1
+	make -f MakeFile-Executable BUILD_SUBDIR=$build_dir clean > /dev/null
+	if [ ! -f $executable ]; then
+		echo "could not generate an executable for $candidate; skipping it"
+		echo "$mapping_file,$estimated_cost,,,compilation-failed" >> $results
+		continue
+	fi
+
+	config_index=0
+	for config in "${arg_configs[@]}"; do
+		config_index=$((config_index + 1))
+		for (( run=1; run<=runs; run++ )); do
+			run_dir=$output_dir/runs/$candidate/config-$config_index/run-$run
+			mkdir -p $run_dir
+			cd $run_dir
+			# the executable reports its own running time that excludes process launching overhead; every process
+			# reports its time, and the slowest process decides the running time of the candidate
+			( timeout $timeout_limit mpirun -n $processes $mpirun_args $executable $fixed_args $config < /dev/null ) \
+				> output.txt 2>&1
+			time=`grep 'Parallel Execution Time' output.txt | awk '{print $4}' | sort -g | tail -1`
+			cd $current_dir && cd $installer_dir && cd $segmented_memory_compiler_dir
+			if [ -z "$time" ]; then
+				echo "run failed or timed out for arguments:$config"
+				echo "$mapping_file,$estimated_cost,$config,$run,failed" >> $results
+				continue
+			fi
+			echo "arguments:$config run $run: $time Seconds"
+			echo "$mapping_file,$estimated_cost,$config,$run,$time" >> $results
+			if [ -z "$best_time" ] || [ `echo "$time < $best_time" | bc -l` -eq 1 ]; then
+				best_time=$time
+				best_mapping=$mapping_file
+				best_args=$config
+			fi
+		done
+	done
+done < $candidates_dir/candidates.txt
+
+cd $current_dir
+echo "--------------------------------------------------------------------------------------------------------"
+if [ -z "$best_time" ]; then
+	echo "none of the candidates ran successfully; check the outputs in $output_dir/runs"
+	exit 1
+fi
+cp $candidates_dir/$best_mapping $output_dir/best.map
+echo "$best_args" | sed -e 's/^ //' > $output_dir/best.args
+echo "best execution time: $best_time Seconds"
+echo "best mapping (written in $output_dir/best.map):"
+cat $output_dir/best.map
+echo "best arguments (written in $output_dir/best.args):$best_args"
+echo "all results are in the table: $results"
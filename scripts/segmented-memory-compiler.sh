@@ -23,7 +23,7 @@ executable=$current_dir/smem.o
 if [ "$#" -lt 2 ]; then
 	echo "Two arguments are mandatory to generate an executable"
 	echo "1. the IT source code file"
-	echo "2. the mapping file"
+	echo "2. the mapping file; use 'auto' to let the compiler synthesize a mapping"
 	echo "Optionally, you can specify the intended name of the executable as the third parameter"
 	exit 1
 fi
@@ -54,7 +54,7 @@ if [ ! -f "$src_code" ]; then
 	echo "IT source '$src_code' not found"
 	exit 1
 fi 
-if [ ! -f "$mapping_file" ]; then
+if [ "$mapping_file" != "auto" ] && [ ! -f "$mapping_file" ]; then
 	echo "Mapping file '$mapping_file' not found"
 	exit 1
 fi 
@@ -71,7 +71,10 @@ fi
 src=`readlink -f $src_code`
 pcubes=`readlink -f $pcubes_file`
 cores=`readlink -f $core_numbering_file`
-mapping=`readlink -f $mapping_file`
+mapping=auto
+if [ "$mapping_file" != "auto" ]; then
+	mapping=`readlink -f $mapping_file`
+fi
 
 # print the paths of the files
 echo "IT source code: $src"
@@ -93,6 +96,11 @@ ${segmented_memory_compiler} $src $pcubes $cores $mapping $build_dir > /dev/null
 # generate the binary from the intermediate source code and delete the intermediate source code
 echo "generating an executable from the intermediate code"
 make -f MakeFile-Executable C_COMPILER=$multicore_c EXECUTABLE=$executable BUILD_SUBDIR=$build_dir C_OPT_FLAGS="$c_opt_flags" > /dev/null
+# keep the synthesized mapping beside the executable as the build directory is about to be deleted
+if [ "$mapping" = "auto" ]; then
+	cp build/$build_dir/mapping.map $executable.map
+	echo "the synthesized mapping has been written in the file: $executable.map"
+fi
 echo "cleaning up intermediate files/directories"
 make -f MakeFile-Executable BUILD_SUBDIR=$build_dir clean > /dev/null
 
@@ -28,3 +28,6 @@ rm -f config/deployment.properties
 # come back to the installer directory and delete the compiler script
 cd $installer_dir
 rm -f smicc
+rm -f smtune
+rm -f itbench
+rm -f pcubes-discover